@@ -657,6 +657,130 @@ extern DECLSPEC Uint32 SDLCALL SDL_GetQueuedAudioSize(SDL_AudioDeviceID dev);
  */
 extern DECLSPEC void SDLCALL SDL_ClearQueuedAudio(SDL_AudioDeviceID dev);
 
+/**
+ *  \name Audio mixer
+ *
+ *  An audio mixer sums any number of voices into one output format. Each
+ *  voice has its own format, channel count and rate, and is converted to
+ *  float at the mixer's channels and rate as it is mixed. Voices
+ *  are summed in float with their gain and pan applied, and the sum is
+ *  clipped once as it is converted to the output format, instead of after
+ *  every voice like repeated SDL_MixAudioFormat() calls do.
+ *
+ *  To play a mixer, open an audio device with SDL_AudioMixerCallback() as
+ *  the callback and the mixer as the userdata, without allowing any changes
+ *  to the mixer's format, channels and rate.
+ *
+ *  Gain, pan and pause can be changed from any thread without waiting for
+ *  the mixer; gain and pan changes are ramped in over the next 512 sample
+ *  frames to avoid clicks. Putting data into a voice never waits for a mix,
+ *  and a mix never waits for data being put into a voice. Adding, removing
+ *  and clearing voices waits for a mix in progress to finish.
+ */
+/* @{ */
+struct SDL_AudioMixer;
+typedef struct SDL_AudioMixer SDL_AudioMixer;
+
+struct SDL_AudioVoice;
+typedef struct SDL_AudioVoice SDL_AudioVoice;
+
+/**
+ *  Create a mixer that mixes to \c format with \c channels channels at
+ *  \c freq sample frames per second.
+ *
+ *  \return the new mixer, or NULL on error.
+ */
+extern DECLSPEC SDL_AudioMixer *SDLCALL SDL_CreateAudioMixer(SDL_AudioFormat format,
+                                                             Uint8 channels,
+                                                             int freq);
+
+/**
+ *  Free a mixer and all of its voices. The mixer must not be in use by an
+ *  audio device anymore.
+ */
+extern DECLSPEC void SDLCALL SDL_FreeAudioMixer(SDL_AudioMixer * mixer);
+
+/**
+ *  Mix the voices of a mixer into \c len bytes of \c stream, in the mixer's
+ *  output format. This replaces the contents of \c stream, and plays
+ *  silence for voices that run out of data.
+ *
+ *  \return 0 on success or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_MixAudioVoices(SDL_AudioMixer * mixer,
+                                               Uint8 * stream, int len);
+
+/**
+ *  An SDL_AudioCallback that mixes the voices of the SDL_AudioMixer passed
+ *  as \c userdata.
+ */
+extern DECLSPEC void SDLCALL SDL_AudioMixerCallback(void *userdata,
+                                                    Uint8 * stream, int len);
+
+/**
+ *  Add a voice playing audio in \c format with \c channels channels at
+ *  \c freq sample frames per second to a mixer. New voices have a gain of
+ *  1.0, are centered and are not paused.
+ *
+ *  \return the new voice, or NULL on error.
+ */
+extern DECLSPEC SDL_AudioVoice *SDLCALL SDL_AddAudioVoice(SDL_AudioMixer * mixer,
+                                                          SDL_AudioFormat format,
+                                                          Uint8 channels,
+                                                          int freq);
+
+/**
+ *  Remove a voice from its mixer and free it, dropping any data that
+ *  hasn't been mixed yet.
+ */
+extern DECLSPEC void SDLCALL SDL_RemoveAudioVoice(SDL_AudioVoice * voice);
+
+/**
+ *  Put \c len bytes of audio in the voice's format into a voice, to be mixed
+ *  after any data already put into it. \c len must be a whole number of
+ *  sample frames. The data is copied, so the buffer can be reused when this
+ *  returns.
+ *
+ *  \return 0 on success or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_PutAudioVoiceData(SDL_AudioVoice * voice,
+                                                  const void *data, int len);
+
+/**
+ *  Get the number of sample frames, at the mixer's rate, put into a voice
+ *  and not mixed yet. Data that isn't resampled yet is counted at the ratio
+ *  of the rates, so this can be off by a few frames.
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioVoiceQueuedFrames(SDL_AudioVoice * voice);
+
+/**
+ *  Drop any data put into a voice that hasn't been mixed yet.
+ */
+extern DECLSPEC void SDLCALL SDL_ClearAudioVoice(SDL_AudioVoice * voice);
+
+/**
+ *  Set the gain of a voice, 1.0 plays it at its original level.
+ */
+extern DECLSPEC void SDLCALL SDL_SetAudioVoiceGain(SDL_AudioVoice * voice,
+                                                   float gain);
+
+/**
+ *  Set the pan of a voice from -1.0 (left) to 1.0 (right). Panning
+ *  attenuates the right channels when going left and the left channels when
+ *  going right, so a centered voice plays at its full level. Mono mixers,
+ *  and the center and LFE channels of surround mixers, aren't panned.
+ */
+extern DECLSPEC void SDLCALL SDL_SetAudioVoicePan(SDL_AudioVoice * voice,
+                                                  float pan);
+
+/**
+ *  Pause or unpause a voice. A paused voice keeps its data until it is
+ *  unpaused.
+ */
+extern DECLSPEC void SDLCALL SDL_PauseAudioVoice(SDL_AudioVoice * voice,
+                                                 int pause_on);
+/* @} *//* Audio mixer */
+
 
 /**
  *  \name Audio lock functions
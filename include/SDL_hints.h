@@ -134,10 +134,14 @@ extern "C" {
  *
  *  This variable can be set to the following values:
  *    "0" or "nearest" - Nearest pixel sampling
- *    "1" or "linear"  - Linear filtering (supported by OpenGL and Direct3D)
- *    "2" or "best"    - Currently this is the same as "linear"
+ *    "1" or "linear"  - Linear filtering (supported by OpenGL, Direct3D and software)
+ *    "2" or "best"    - Currently this is the same as "linear", except that
+ *                       software scaling averages the covered pixels when shrinking
  *
  *  By default nearest pixel sampling is used
+ *
+ *  The software renderer and SDL_BlitScaled() only filter 32-bit surfaces
+ *  with 8 bits per channel that don't use a color key.
  */
 #define SDL_HINT_RENDER_SCALE_QUALITY       "SDL_RENDER_SCALE_QUALITY"
 
@@ -152,6 +156,118 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_VSYNC               "SDL_RENDER_VSYNC"
 
+/**
+ *  \brief  A variable controlling whether the 2D render API is allowed to batch up draw calls.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Draw calls are passed to the render driver immediately
+ *    "1"       - Draw calls are recorded and passed to the render driver in batches
+ *
+ *  Batching is only done by render drivers that support it (currently the
+ *  software, opengl and opengles2 drivers).  Queued commands are flushed by
+ *  SDL_RenderPresent(), SDL_RenderReadPixels(), SDL_SetRenderTarget() and
+ *  whenever a texture they use is changed.  Applications mixing their own
+ *  graphics API calls with the render API must call SDL_RenderFlush() first.
+ *
+ *  This hint is checked when a renderer is created.
+ *
+ *  By default batching is disabled.
+ */
+#define SDL_HINT_RENDER_BATCHING            "SDL_RENDER_BATCHING"
+
+/**
+ *  \brief  A variable controlling how many threads the software renderer draws with.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Use one thread per CPU core
+ *    "1"       - Draw on the thread that flushes the render commands
+ *    "N"       - Draw with N threads, including the flushing thread
+ *
+ *  When more than one thread is used, the software renderer always batches
+ *  draw calls.  Each batch is split into horizontal bands of the render
+ *  target, and the bands are drawn in parallel, with every band drawing the
+ *  commands that touch it in the order they were issued.
+ *
+ *  This hint is checked when a software renderer is created.
+ *
+ *  By default the software renderer draws on a single thread.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_THREADS    "SDL_RENDER_SOFTWARE_THREADS"
+
+/**
+ *  \brief  A variable controlling how many threads large software blits run on.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Use one thread per CPU core
+ *    "1"       - Blit on the calling thread
+ *    "N"       - Blit with N threads, including the calling thread
+ *
+ *  When more than one thread is used, unscaled blits, pixel format
+ *  conversions and SDL_FillRect() calls covering at least 128K pixels are
+ *  split into bands of rows that are processed in parallel.  Smaller blits,
+ *  and blits within a single surface where the source and destination
+ *  overlap, always run on the calling thread, as do blits started while
+ *  another thread is using the blit threads.
+ *
+ *  This hint is checked for every blit large enough to be split.
+ *
+ *  By default blits run on the calling thread.
+ */
+#define SDL_HINT_BLIT_THREADS               "SDL_BLIT_THREADS"
+
+/**
+ *  \brief  A variable controlling whether new surfaces get SIMD aligned pixels.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Only surfaces created with ::SDL_SIMD_ALIGNED are aligned
+ *    "1"       - All surfaces created by SDL are aligned
+ *
+ *  The pixels and the pitch of an aligned surface are multiples of 64 bytes,
+ *  so every row starts on a cache line.  This makes the pitch of narrow
+ *  surfaces larger than the 4-byte aligned pitch SDL uses by default.
+ *
+ *  By default only surfaces created with ::SDL_SIMD_ALIGNED are aligned.
+ */
+#define SDL_HINT_SURFACE_SIMD_ALIGNED       "SDL_SURFACE_SIMD_ALIGNED"
+
+/**
+ *  \brief  A variable controlling whether large aligned surfaces use huge pages.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Allocate surface pixels with SDL_malloc()
+ *    "1"       - Map the pixels of aligned surfaces of 4 MB or more as huge
+ *                pages where the system supports it
+ *
+ *  On Linux SDL first asks for explicit huge pages (MAP_HUGETLB), and falls
+ *  back to transparent huge pages (MADV_HUGEPAGE) if none are reserved.
+ *  Other platforms ignore this hint.
+ *
+ *  This hint is checked when a surface is created.
+ *
+ *  By default large aligned surfaces use huge pages.
+ */
+#define SDL_HINT_SURFACE_HUGE_PAGES         "SDL_SURFACE_HUGE_PAGES"
+
+/**
+ *  \brief  A variable controlling how RGB surfaces are converted to 8-bit palettes.
+ *
+ *  This variable can be set to the following values:
+ *    "0" or "none"      - Reduce colors to 3-3-2 bits and map those to the palette
+ *    "1" or "nearest"   - Map each color to the nearest palette entry
+ *    "2" or "ordered"   - Nearest palette entry after an 8x8 ordered dither
+ *    "3" or "diffusion" - Nearest palette entry with Floyd-Steinberg error
+ *                         diffusion
+ *
+ *  The nearest entry is looked up with 5 bits per channel. Only plain copies
+ *  are dithered, blits with a color key, blending or modulation are not.
+ *  Error diffusion runs on a single thread, see ::SDL_HINT_BLIT_THREADS.
+ *
+ *  This hint is checked when a blit between two surfaces is set up.
+ *
+ *  By default colors are reduced to 3-3-2 bits.
+ */
+#define SDL_HINT_SURFACE_PALETTE_DITHER     "SDL_SURFACE_PALETTE_DITHER"
+
 /**
  *  \brief  A variable controlling whether the screensaver is enabled. 
  *
@@ -831,26 +947,24 @@ extern "C" {
 /**
  *  \brief  A variable controlling speed/quality tradeoff of audio resampling.
  *
- *  If available, SDL can use libsamplerate ( http://www.mega-nerd.com/SRC/ )
- *  to handle audio resampling. There are different resampling modes available
- *  that produce different levels of quality, using more CPU.
- *
- *  If this hint isn't specified to a valid setting, or libsamplerate isn't
- *  available, SDL will use the default, internal resampling algorithm.
+ *  SDL resamples audio with a band-limited windowed-sinc filter, using a
+ *  longer filter for higher quality, which takes more CPU.
  *
- *  Note that this is currently only applicable to resampling audio that is
- *  being written to a device for playback or audio being read from a device
- *  for capture. SDL_AudioCVT always uses the default resampler (although this
- *  might change for SDL 2.1).
+ *  If available, SDL can also use libsamplerate ( http://www.mega-nerd.com/SRC/ )
+ *  to handle the resampling of audio that is being written to a device for
+ *  playback or read from a device for capture, when this hint selects one of
+ *  the non-default modes. This part is only checked at audio subsystem
+ *  initialization.
  *
- *  This hint is currently only checked at audio subsystem initialization.
+ *  The quality of SDL's own resampler is checked when an SDL_AudioCVT is
+ *  converted or an audio device is opened.
  *
  *  This variable can be set to the following values:
  *
- *    "0" or "default" - Use SDL's internal resampling (Default when not set - low quality, fast)
- *    "1" or "fast"    - Use fast, slightly higher quality resampling, if available
- *    "2" or "medium"  - Use medium quality resampling, if available
- *    "3" or "best"    - Use high quality resampling, if available
+ *    "0" or "default" - Use SDL's internal resampling (Default when not set - medium quality)
+ *    "1" or "fast"    - Use fast, lower quality resampling
+ *    "2" or "medium"  - Use medium quality resampling
+ *    "3" or "best"    - Use high quality resampling
  */
 #define SDL_HINT_AUDIO_RESAMPLING_MODE   "SDL_AUDIO_RESAMPLING_MODE"
 
@@ -885,6 +999,11 @@ typedef enum
  *  has a value.  Hints will replace existing hints of their priority and
  *  lower.  Environment variables are considered to have override priority.
  *
+ *  Setting a hint to NULL clears its value. A hint cleared with
+ *  ::SDL_HINT_OVERRIDE priority reads as NULL even if the environment
+ *  variable is set, otherwise SDL_GetHint() returns the environment
+ *  variable, or NULL if there is none.
+ *
  *  \return SDL_TRUE if the hint was set, SDL_FALSE otherwise
  */
 extern DECLSPEC SDL_bool SDLCALL SDL_SetHintWithPriority(const char *name,
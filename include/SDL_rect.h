@@ -137,6 +137,116 @@ extern DECLSPEC SDL_bool SDLCALL SDL_IntersectRectAndLine(const SDL_Rect *
                                                           int *Y1, int *X2,
                                                           int *Y2);
 
+/**
+ *  \brief A set of pixels, kept as rectangles that don't overlap.
+ *
+ *  The rectangles are sorted in bands from top to bottom, and from left to
+ *  right within a band.  All rectangles of a band have the same y and h,
+ *  neighbouring rectangles in a band don't touch, and bands that touch
+ *  don't have the same rectangles, so a region has a single representation.
+ *
+ *  \sa SDL_CreateRegion
+ *  \sa SDL_UnionRegion
+ *  \sa SDL_IntersectRegion
+ *  \sa SDL_SubtractRegion
+ *  \sa SDL_GetRegionRects
+ */
+typedef struct SDL_Region SDL_Region;
+
+/**
+ *  \brief Create an empty region.
+ *
+ *  \return The new region, or NULL if out of memory.
+ */
+extern DECLSPEC SDL_Region * SDLCALL SDL_CreateRegion(void);
+
+/**
+ *  \brief Free a region created by SDL_CreateRegion().
+ */
+extern DECLSPEC void SDLCALL SDL_FreeRegion(SDL_Region * region);
+
+/**
+ *  \brief Make a region empty.
+ */
+extern DECLSPEC void SDLCALL SDL_ClearRegion(SDL_Region * region);
+
+/**
+ *  \brief Add the pixels of another region to a region.
+ *
+ *  \return 0 on success, or -1 on error, leaving the region unchanged.
+ */
+extern DECLSPEC int SDLCALL SDL_UnionRegion(SDL_Region * region,
+                                            const SDL_Region * other);
+
+/**
+ *  \brief Add the pixels of a set of rectangles to a region.
+ *
+ *  The rectangles may overlap, empty rectangles are ignored.
+ *
+ *  \return 0 on success, or -1 on error, leaving the region unchanged.
+ */
+extern DECLSPEC int SDLCALL SDL_UnionRegionRects(SDL_Region * region,
+                                                 const SDL_Rect * rects,
+                                                 int count);
+
+/**
+ *  \brief Keep only the pixels of a region that are also in another region.
+ *
+ *  \return 0 on success, or -1 on error, leaving the region unchanged.
+ */
+extern DECLSPEC int SDLCALL SDL_IntersectRegion(SDL_Region * region,
+                                                const SDL_Region * other);
+
+/**
+ *  \brief Keep only the pixels of a region that are inside a rectangle.
+ *
+ *  \return 0 on success, or -1 on error, leaving the region unchanged.
+ */
+extern DECLSPEC int SDLCALL SDL_IntersectRegionRect(SDL_Region * region,
+                                                    const SDL_Rect * rect);
+
+/**
+ *  \brief Remove the pixels of another region from a region.
+ *
+ *  \return 0 on success, or -1 on error, leaving the region unchanged.
+ */
+extern DECLSPEC int SDLCALL SDL_SubtractRegion(SDL_Region * region,
+                                               const SDL_Region * other);
+
+/**
+ *  \brief Remove the pixels of a rectangle from a region.
+ *
+ *  \return 0 on success, or -1 on error, leaving the region unchanged.
+ */
+extern DECLSPEC int SDLCALL SDL_SubtractRegionRect(SDL_Region * region,
+                                                   const SDL_Rect * rect);
+
+/**
+ *  \brief Move a region by dx pixels to the right and dy pixels down.
+ */
+extern DECLSPEC void SDLCALL SDL_TranslateRegion(SDL_Region * region,
+                                                 int dx, int dy);
+
+/**
+ *  \brief Get the rectangles making up a region.
+ *
+ *  \param region The region to query.
+ *  \param count  Filled in with the number of rectangles.
+ *
+ *  \return The rectangles in band order, valid until the region is
+ *          changed or freed, or NULL if the region is empty.
+ */
+extern DECLSPEC const SDL_Rect * SDLCALL SDL_GetRegionRects(const SDL_Region * region,
+                                                            int *count);
+
+/**
+ *  \brief Calculate the smallest rectangle enclosing a region.
+ *
+ *  \return SDL_TRUE if the region isn't empty, SDL_FALSE otherwise.
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_GetRegionBounds(const SDL_Region * region,
+                                                     SDL_Rect * bounds);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -115,6 +115,35 @@ typedef enum
     SDL_FLIP_VERTICAL = 0x00000002     /**< flip vertically */
 } SDL_RendererFlip;
 
+/**
+ *  \brief A vertex submitted to SDL_RenderGeometry()
+ */
+typedef struct SDL_Vertex
+{
+    float x, y;         /**< Vertex position, in SDL_Renderer coordinates */
+    SDL_Color color;    /**< Vertex color */
+    float u, v;         /**< Normalized texture coordinates, if a texture is used */
+} SDL_Vertex;
+
+/**
+ *  \brief Counters describing the work done by a renderer for one frame
+ *
+ *  \sa SDL_GetRendererStats()
+ */
+typedef struct SDL_RendererStats
+{
+    Uint32 frames;              /**< The number of frames presented so far */
+    Uint32 draw_calls;          /**< Clear, draw, copy and geometry calls */
+    Uint32 primitives;          /**< Points, line segments, rectangles, copies and triangles drawn */
+    Uint32 backend_draws;       /**< Draw operations passed on to the driver, after batching */
+    Uint32 batches;             /**< Batches of queued commands run by the driver */
+    Uint32 texture_uploads;     /**< Texture updates and unlocks passed on to the driver */
+    Uint64 texture_bytes;       /**< Bytes of pixel data in those texture uploads */
+    Uint32 target_changes;      /**< Render target switches */
+    Uint32 state_changes;       /**< Changes of draw color, blend mode, viewport, clip rectangle, scale and texture modulation */
+    Uint32 present_time;        /**< CPU time spent in SDL_RenderPresent(), in microseconds */
+} SDL_RendererStats;
+
 /**
  *  \brief A structure representing rendering state
  */
@@ -835,6 +864,32 @@ extern DECLSPEC int SDLCALL SDL_RenderCopyEx(SDL_Renderer * renderer,
                                            const SDL_Point *center,
                                            const SDL_RendererFlip flip);
 
+/**
+ *  \brief Render a list of triangles, optionally using a texture and indices
+ *         into the vertex array.
+ *
+ *  \param renderer     The rendering context.
+ *  \param texture      The texture to use, or NULL to draw with the vertex
+ *                      colors only.
+ *  \param vertices     The vertices.
+ *  \param num_vertices The number of vertices.
+ *  \param indices      An array of vertex indices, 3 per triangle, or NULL to
+ *                      draw the vertices in order as a triangle list.
+ *  \param num_indices  The number of indices.
+ *
+ *  The vertex color is modulated with the texture color and alpha mod, and
+ *  the texture blend mode is used if a texture is given, otherwise the
+ *  renderer draw blend mode is used.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_RenderGeometry(SDL_Renderer * renderer,
+                                               SDL_Texture * texture,
+                                               const SDL_Vertex * vertices,
+                                               int num_vertices,
+                                               const int *indices,
+                                               int num_indices);
+
 /**
  *  \brief Read pixels from the current rendering target.
  *
@@ -842,7 +897,9 @@ extern DECLSPEC int SDLCALL SDL_RenderCopyEx(SDL_Renderer * renderer,
  *  \param rect   A pointer to the rectangle to read, or NULL for the entire
  *                render target.
  *  \param format The desired format of the pixel data, or 0 to use the format
- *                of the rendering target
+ *                of the rendering target.  YUV formats are converted as
+ *                with SDL_ConvertPixels(), and need a rectangle inside
+ *                the viewport.
  *  \param pixels A pointer to be filled in with the pixel data
  *  \param pitch  The pitch of the pixels parameter.
  *
@@ -860,6 +917,36 @@ extern DECLSPEC int SDLCALL SDL_RenderReadPixels(SDL_Renderer * renderer,
  */
 extern DECLSPEC void SDLCALL SDL_RenderPresent(SDL_Renderer * renderer);
 
+/**
+ *  \brief Force the rendering context to flush any pending commands to the
+ *         underlying rendering API.
+ *
+ *  You only need to call this if batching was enabled with
+ *  SDL_HINT_RENDER_BATCHING and you are about to make graphics API calls of
+ *  your own (OpenGL, etc.) that must be ordered after the queued rendering.
+ *
+ *  \param renderer The renderer to flush.
+ *
+ *  \return 0 on success, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_RenderFlush(SDL_Renderer * renderer);
+
+/**
+ *  \brief Get the counters of the last frame drawn by a renderer.
+ *
+ *  \param renderer The renderer to query.
+ *  \param stats    A pointer filled in with the counters of the work done
+ *                  between the two most recent calls to SDL_RenderPresent(),
+ *                  including the last present itself.
+ *
+ *  The counters are always maintained, they are all zero until the first
+ *  frame is presented.
+ *
+ *  \return 0 on success, or -1 on error
+ */
+extern DECLSPEC int SDLCALL SDL_GetRendererStats(SDL_Renderer * renderer,
+                                                 SDL_RendererStats * stats);
+
 /**
  *  \brief Destroy the specified texture.
  *
@@ -53,6 +53,8 @@ extern "C" {
 #define SDL_PREALLOC        0x00000001  /**< Surface uses preallocated memory */
 #define SDL_RLEACCEL        0x00000002  /**< Surface is RLE encoded */
 #define SDL_DONTFREE        0x00000004  /**< Surface is referenced internally */
+#define SDL_SIMD_ALIGNED    0x00000008  /**< Surface pixels and pitch are 64-byte aligned */
+#define SDL_PREMULTIPLIED   0x00000010  /**< Surface has premultiplied alpha */
 /* @} *//* Surface flags */
 
 /**
@@ -106,7 +108,8 @@ typedef int (SDLCALL *SDL_blit) (struct SDL_Surface * src, SDL_Rect * srcrect,
  *
  *  If the function runs out of memory, it will return NULL.
  *
- *  \param flags The \c flags are obsolete and should be set to 0.
+ *  \param flags 0, or ::SDL_SIMD_ALIGNED to align the pixels and pitch of
+ *               the surface to 64 bytes (see ::SDL_HINT_SURFACE_SIMD_ALIGNED).
  *  \param width The width in pixels of the surface to create.
  *  \param height The height in pixels of the surface to create.
  *  \param depth The depth in bits of the surface to create.
@@ -136,6 +139,53 @@ extern DECLSPEC SDL_Surface *SDLCALL SDL_CreateRGBSurfaceWithFormatFrom
     (void *pixels, int width, int height, int depth, int pitch, Uint32 format);
 extern DECLSPEC void SDLCALL SDL_FreeSurface(SDL_Surface * surface);
 
+/**
+ *  \brief Create a surface with its pixels in shared memory.
+ *
+ *  The pixels live in a memory file that is sealed against resizing.  Its
+ *  file descriptor, from SDL_GetSurfaceSharedFD(), can be passed to another
+ *  process, which maps the same pixels with
+ *  SDL_CreateRGBSurfaceWithFormatFromFD().  Writes made by either process
+ *  are seen by the other without copying.
+ *
+ *  \param flags 0, or ::SDL_SIMD_ALIGNED to pad the pitch to 64 bytes.
+ *  \param width The width in pixels of the surface to create.
+ *  \param height The height in pixels of the surface to create.
+ *  \param depth The depth in bits of the surface to create.
+ *  \param format The SDL_PIXELFORMAT_* format of the surface to create.
+ *
+ *  \return The new surface, or NULL if there was an error or the platform
+ *          has no shared memory files (only Linux does for now).
+ */
+extern DECLSPEC SDL_Surface *SDLCALL SDL_CreateRGBSurfaceWithFormatShared
+    (Uint32 flags, int width, int height, int depth, Uint32 format);
+
+/**
+ *  \brief Create a surface over shared memory from another process.
+ *
+ *  The surface maps the file like SDL_CreateRGBSurfaceWithFormatFrom() uses
+ *  its pixels.  It keeps its own duplicate of \c fd, so the caller can close
+ *  \c fd right away.  The file must hold at least \c height * \c pitch bytes
+ *  and be sealed against shrinking (F_SEAL_SHRINK), as the files from
+ *  SDL_CreateRGBSurfaceWithFormatShared() are.
+ *
+ *  \return The new surface, or NULL if there was an error.
+ *
+ *  \sa SDL_CreateRGBSurfaceWithFormatShared()
+ */
+extern DECLSPEC SDL_Surface *SDLCALL SDL_CreateRGBSurfaceWithFormatFromFD
+    (int fd, int width, int height, int depth, int pitch, Uint32 format);
+
+/**
+ *  \brief Get the file descriptor of the shared memory holding a surface's pixels.
+ *
+ *  The descriptor belongs to the surface and is closed with it; duplicate it
+ *  to keep it longer.
+ *
+ *  \return The file descriptor, or -1 if the surface isn't in shared memory.
+ */
+extern DECLSPEC int SDLCALL SDL_GetSurfaceSharedFD(SDL_Surface * surface);
+
 /**
  *  \brief Set the palette used by a surface.
  *
@@ -188,6 +238,31 @@ extern DECLSPEC SDL_Surface *SDLCALL SDL_LoadBMP_RW(SDL_RWops * src,
  */
 #define SDL_LoadBMP(file)   SDL_LoadBMP_RW(SDL_RWFromFile(file, "rb"), 1)
 
+/**
+ *  Load a surface from a seekable SDL data stream, in the given
+ *  SDL_PIXELFORMAT_* format.
+ *
+ *  The pixels are decoded straight into the new surface, without loading
+ *  the image in the file's format first.  Files and memory streams are
+ *  read in place rather than copied.  Passing SDL_PIXELFORMAT_UNKNOWN
+ *  keeps the file's format, like SDL_LoadBMP_RW().
+ *
+ *  If \c freesrc is non-zero, the stream will be closed after being read.
+ *
+ *  \return the new surface, or NULL if there was an error.
+ */
+extern DECLSPEC SDL_Surface *SDLCALL SDL_LoadBMPWithFormat_RW(SDL_RWops * src,
+                                                              int freesrc,
+                                                              Uint32 format);
+
+/**
+ *  Load a surface from a file, in the given SDL_PIXELFORMAT_* format.
+ *
+ *  Convenience macro.
+ */
+#define SDL_LoadBMPWithFormat(file, format) \
+        SDL_LoadBMPWithFormat_RW(SDL_RWFromFile(file, "rb"), 1, format)
+
 /**
  *  Save a surface to a seekable SDL data stream (memory or file).
  *
@@ -382,6 +457,10 @@ extern DECLSPEC SDL_Surface *SDLCALL SDL_ConvertSurfaceFormat
 /**
  * \brief Copy a block of pixels of one format to another format
  *
+ *  RGB pixels can be converted to the YUV formats, with the YUV conversion
+ *  mode for the size of the block.  The chroma planes of a YUV destination
+ *  follow the Y plane, with half the pitch for YV12 and IYUV.
+ *
  *  \return 0 on success, or -1 if there was an error
  */
 extern DECLSPEC int SDLCALL SDL_ConvertPixels(int width, int height,
@@ -390,6 +469,33 @@ extern DECLSPEC int SDLCALL SDL_ConvertPixels(int width, int height,
                                               Uint32 dst_format,
                                               void * dst, int dst_pitch);
 
+/**
+ *  \brief Copy a block of pixels of one format to another format,
+ *         multiplying the color channels by the alpha channel.
+ *
+ *  The destination format must have an alpha channel.  Images premultiplied
+ *  this way should be drawn with ::SDL_BLENDMODE_BLEND_PREMULTIPLIED.
+ *
+ *  \return 0 on success, or -1 if there was an error
+ */
+extern DECLSPEC int SDLCALL SDL_PremultiplyAlpha(int width, int height,
+                                                 Uint32 src_format,
+                                                 const void * src, int src_pitch,
+                                                 Uint32 dst_format,
+                                                 void * dst, int dst_pitch);
+
+/**
+ *  \brief Premultiply the color channels of a surface by its alpha channel.
+ *
+ *  This sets the ::SDL_PREMULTIPLIED flag on the surface, and if the surface
+ *  blend mode is ::SDL_BLENDMODE_BLEND it is changed to
+ *  ::SDL_BLENDMODE_BLEND_PREMULTIPLIED.  Calling this again on a surface
+ *  that is already premultiplied has no effect.
+ *
+ *  \return 0 on success, or -1 if there was an error
+ */
+extern DECLSPEC int SDLCALL SDL_PremultiplySurfaceAlpha(SDL_Surface * surface);
+
 /**
  *  Performs a fast fill of the given rectangle with \c color.
  *
@@ -496,6 +602,8 @@ extern DECLSPEC int SDLCALL SDL_SoftStretch(SDL_Surface * src,
 /**
  *  This is the public scaled blit function, SDL_BlitScaled(), and it performs
  *  rectangle validation and clipping before passing it to SDL_LowerBlitScaled()
+ *
+ *  The pixels are filtered as requested by SDL_HINT_RENDER_SCALE_QUALITY.
  */
 extern DECLSPEC int SDLCALL SDL_UpperBlitScaled
     (SDL_Surface * src, const SDL_Rect * srcrect,
@@ -509,6 +617,35 @@ extern DECLSPEC int SDLCALL SDL_LowerBlitScaled
     (SDL_Surface * src, SDL_Rect * srcrect,
     SDL_Surface * dst, SDL_Rect * dstrect);
 
+/**
+ *  \brief The formula used for converting between YUV and RGB
+ */
+typedef enum
+{
+    SDL_YUV_CONVERSION_JPEG,        /**< Full range BT.601, as used by JPEG (the default) */
+    SDL_YUV_CONVERSION_BT601,       /**< BT.601 */
+    SDL_YUV_CONVERSION_BT709,       /**< BT.709 */
+    SDL_YUV_CONVERSION_AUTOMATIC,   /**< BT.601 for SD content, BT.709 for HD content */
+    SDL_YUV_CONVERSION_BT709_FULL   /**< Full range BT.709 */
+} SDL_YUV_CONVERSION_MODE;
+
+/**
+ *  \brief Set the YUV conversion mode
+ *
+ *  The mode is used by the software YUV texture conversion.  Textures pick
+ *  up a new mode the next time they are converted.
+ */
+extern DECLSPEC void SDLCALL SDL_SetYUVConversionMode(SDL_YUV_CONVERSION_MODE mode);
+
+/**
+ *  \brief Get the YUV conversion mode
+ */
+extern DECLSPEC SDL_YUV_CONVERSION_MODE SDLCALL SDL_GetYUVConversionMode(void);
+
+/**
+ *  \brief Get the YUV conversion mode, returning the correct mode for the resolution when the current conversion mode is SDL_YUV_CONVERSION_AUTOMATIC
+ */
+extern DECLSPEC SDL_YUV_CONVERSION_MODE SDLCALL SDL_GetYUVConversionModeForResolution(int width, int height);
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
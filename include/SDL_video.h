@@ -828,6 +828,9 @@ extern DECLSPEC int SDLCALL SDL_UpdateWindowSurface(SDL_Window * window);
 /**
  *  \brief Copy a number of rectangles on the window surface to the screen.
  *
+ *  The rectangles may overlap, each pixel is copied once.  Parts outside
+ *  the window surface are ignored.
+ *
  *  \return 0 on success, or -1 on error.
  *
  *  \sa SDL_GetWindowSurface()
@@ -0,0 +1,168 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "./SDL_internal.h"
+#include "SDL.h"
+#include "./SDL_ringbuffer.h"
+#include "SDL_assert.h"
+
+/* The positions only ever count up, wrapping around at 2^32; the bytes in
+   the ring are writepos - readpos. Each side publishes its position after
+   it's done with the data, so the other side never sees a position for
+   bytes that aren't there (or gone) yet. The positions sit on their own
+   cache lines so the two threads don't bounce a line between them. */
+struct SDL_RingBuffer
+{
+    Uint8 *data;
+    Uint32 mask;  /* capacity - 1 */
+    char pad0[SDL_CACHELINE_SIZE];
+    SDL_atomic_t writepos;  /* only changed by the writer */
+    char pad1[SDL_CACHELINE_SIZE];
+    SDL_atomic_t readpos;  /* only changed by the reader */
+    char pad2[SDL_CACHELINE_SIZE];
+};
+
+SDL_RingBuffer *
+SDL_NewRingBuffer(const size_t capacity)
+{
+    SDL_RingBuffer *ring;
+    Uint32 size = 1;
+
+    if (capacity > 0x40000000) {
+        SDL_SetError("Ring buffer is too big");
+        return NULL;
+    }
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    ring = (SDL_RingBuffer *) SDL_calloc(1, sizeof (SDL_RingBuffer));
+    if (!ring) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    ring->data = (Uint8 *) SDL_malloc(size);
+    if (!ring->data) {
+        SDL_free(ring);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    ring->mask = size - 1;
+    SDL_AtomicSet(&ring->writepos, 0);
+    SDL_AtomicSet(&ring->readpos, 0);
+    return ring;
+}
+
+void
+SDL_FreeRingBuffer(SDL_RingBuffer *ring)
+{
+    if (ring) {
+        SDL_free(ring->data);
+        SDL_free(ring);
+    }
+}
+
+size_t
+SDL_WriteToRingBuffer(SDL_RingBuffer *ring, const void *_data, const size_t _len)
+{
+    const Uint8 *data = (const Uint8 *) _data;
+    Uint32 writepos, readpos, offset, len, first;
+
+    if (!ring) {
+        return 0;
+    }
+
+    writepos = (Uint32) SDL_AtomicGet(&ring->writepos);
+    readpos = (Uint32) SDL_AtomicGet(&ring->readpos);
+    SDL_MemoryBarrierAcquire();  /* don't write over bytes until the reader is done with them. */
+
+    len = (ring->mask + 1) - (writepos - readpos);
+    if (_len < len) {
+        len = (Uint32) _len;
+    }
+    offset = writepos & ring->mask;
+    first = SDL_min(len, (ring->mask + 1) - offset);
+    SDL_memcpy(ring->data + offset, data, first);
+    SDL_memcpy(ring->data, data + first, len - first);
+
+    SDL_MemoryBarrierRelease();  /* the bytes have to land before the reader sees them. */
+    SDL_AtomicSet(&ring->writepos, (int) (writepos + len));
+    return len;
+}
+
+size_t
+SDL_ReadFromRingBuffer(SDL_RingBuffer *ring, void *_buf, const size_t _len)
+{
+    Uint8 *buf = (Uint8 *) _buf;
+    Uint32 writepos, readpos, offset, len, first;
+
+    if (!ring) {
+        return 0;
+    }
+
+    readpos = (Uint32) SDL_AtomicGet(&ring->readpos);
+    writepos = (Uint32) SDL_AtomicGet(&ring->writepos);
+    SDL_MemoryBarrierAcquire();  /* don't read bytes before the writer is done with them. */
+
+    len = writepos - readpos;
+    if (_len < len) {
+        len = (Uint32) _len;
+    }
+    offset = readpos & ring->mask;
+    first = SDL_min(len, (ring->mask + 1) - offset);
+    SDL_memcpy(buf, ring->data + offset, first);
+    SDL_memcpy(buf + first, ring->data, len - first);
+
+    SDL_MemoryBarrierRelease();  /* finish reading before the writer can reuse the space. */
+    SDL_AtomicSet(&ring->readpos, (int) (readpos + len));
+    return len;
+}
+
+void
+SDL_ClearRingBuffer(SDL_RingBuffer *ring)
+{
+    if (ring) {
+        SDL_AtomicSet(&ring->readpos, SDL_AtomicGet(&ring->writepos));
+    }
+}
+
+size_t
+SDL_CountRingBuffer(SDL_RingBuffer *ring)
+{
+    Uint32 writepos, readpos;
+
+    if (!ring) {
+        return 0;
+    }
+
+    /* the writer may have refilled what the reader took since readpos was read. */
+    readpos = (Uint32) SDL_AtomicGet(&ring->readpos);
+    writepos = (Uint32) SDL_AtomicGet(&ring->writepos);
+    return (size_t) SDL_min(writepos - readpos, ring->mask + 1);
+}
+
+size_t
+SDL_GetRingBufferCapacity(SDL_RingBuffer *ring)
+{
+    return ring ? ((size_t) ring->mask) + 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,57 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_ringbuffer_h_
+#define SDL_ringbuffer_h_
+
+/* this is not (currently) a public API. */
+
+/* A fixed size ring of bytes that one thread can write to while another
+   reads from it, without locking. Neither side ever waits for the other:
+   writes are cut short when the ring is full and reads when it is empty.
+   Only one thread may write and one thread may read at a time; if more
+   threads need to share a side, they have to serialize among themselves. */
+
+struct SDL_RingBuffer;
+typedef struct SDL_RingBuffer SDL_RingBuffer;
+
+/* capacity is rounded up to a power of two. */
+SDL_RingBuffer *SDL_NewRingBuffer(const size_t capacity);
+void SDL_FreeRingBuffer(SDL_RingBuffer *ring);
+
+/* writer side; returns the number of bytes written, which may be short. */
+size_t SDL_WriteToRingBuffer(SDL_RingBuffer *ring, const void *data, const size_t len);
+
+/* reader side; returns the number of bytes read, which may be short. */
+size_t SDL_ReadFromRingBuffer(SDL_RingBuffer *ring, void *buf, const size_t len);
+
+/* reader side; drops everything written so far. */
+void SDL_ClearRingBuffer(SDL_RingBuffer *ring);
+
+/* bytes waiting to be read. Safe from either side, but the other side may
+   change it right after. */
+size_t SDL_CountRingBuffer(SDL_RingBuffer *ring);
+
+size_t SDL_GetRingBufferCapacity(SDL_RingBuffer *ring);
+
+#endif /* SDL_ringbuffer_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,81 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_simd_h_
+#define SDL_simd_h_
+
+/* this is not (currently) a public API. */
+
+/* Which SIMD intrinsics the SDL internals can use.
+
+   SSE and SSE2 code is only built if the compiler targets them. SSSE3 and
+   AVX2 code is built even if the compiler doesn't target them by default,
+   functions using them are declared with SDL_TARGETING_SSSE3 or
+   SDL_TARGETING_AVX2 and may only be called if the CPU supports them.
+
+   The NEON code works on pixels and samples in little endian lane order. */
+
+#include "SDL_endian.h"
+
+#if defined(__SSE__)
+#define HAVE_SSE_INTRINSICS 1
+#endif
+
+#if defined(__SSE2__)
+#define HAVE_SSE2_INTRINSICS 1
+#endif
+
+#if defined(__SSSE3__) || (defined(_MSC_VER) && (_MSC_VER >= 1500) && !defined(__clang__) && (defined(_M_IX86) || defined(_M_X64)))
+#define HAVE_SSSE3_INTRINSICS 1
+#define SDL_TARGETING_SSSE3
+#elif (defined(__i386__) || defined(__x86_64__)) && \
+      ((defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 5)) || \
+       (defined(__clang__) && !defined(__apple_build_version__) && (__clang_major__ >= 4)) || \
+       (defined(__apple_build_version__) && (__clang_major__ >= 8)))
+#define HAVE_SSSE3_INTRINSICS 1
+#define SDL_TARGETING_SSSE3 __attribute__((target("ssse3")))
+#endif
+
+#if defined(__AVX2__) || (defined(_MSC_VER) && (_MSC_VER >= 1700) && !defined(__clang__) && (defined(_M_IX86) || defined(_M_X64)))
+#define HAVE_AVX2_INTRINSICS 1
+#define SDL_TARGETING_AVX2
+#elif (defined(__i386__) || defined(__x86_64__)) && \
+      ((defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 5)) || \
+       (defined(__clang__) && !defined(__apple_build_version__) && (__clang_major__ >= 4)) || \
+       (defined(__apple_build_version__) && (__clang_major__ >= 8)))
+#define HAVE_AVX2_INTRINSICS 1
+#define SDL_TARGETING_AVX2 __attribute__((target("avx2")))
+#endif
+
+#if (defined(__ARM_NEON) || defined(__ARM_NEON__)) && (SDL_BYTEORDER == SDL_LIL_ENDIAN)
+#define HAVE_NEON_INTRINSICS 1
+#endif
+
+#if HAVE_SSE_INTRINSICS || HAVE_SSE2_INTRINSICS || HAVE_SSSE3_INTRINSICS || HAVE_AVX2_INTRINSICS
+#include <immintrin.h>
+#endif
+#if HAVE_NEON_INTRINSICS
+#include <arm_neon.h>
+#endif
+
+#endif /* SDL_simd_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -516,6 +516,25 @@ SDL_RemoveAudioDevice(const int iscapture, void *handle)
 
 /* buffer queueing support... */
 
+/* Moves as much of the playback data waiting in buffer_queue into the ring
+   as fits. Whoever calls this must hold queue_lock, which makes them the
+   ring's only writer. */
+static void
+MoveQueuedAudioToRing(SDL_AudioDevice *device)
+{
+    Uint8 buf[1024];
+    size_t space = SDL_GetRingBufferCapacity(device->buffer_ring) - SDL_CountRingBuffer(device->buffer_ring);
+
+    while (space > 0) {
+        const size_t len = SDL_ReadFromDataQueue(device->buffer_queue, buf, SDL_min(space, sizeof (buf)));
+        if (len == 0) {
+            break;
+        }
+        SDL_WriteToRingBuffer(device->buffer_ring, buf, len);
+        space -= len;
+    }
+}
+
 static void SDLCALL
 SDL_BufferQueueDrainCallback(void *userdata, Uint8 *stream, int len)
 {
@@ -527,12 +546,22 @@ SDL_BufferQueueDrainCallback(void *userdata, Uint8 *stream, int len)
     SDL_assert(!device->iscapture);  /* this shouldn't ever happen, right?! */
     SDL_assert(len >= 0);  /* this shouldn't ever happen, right?! */
 
-    dequeued = SDL_ReadFromDataQueue(device->buffer_queue, stream, len);
+    dequeued = SDL_ReadFromRingBuffer(device->buffer_ring, stream, len);
     stream += dequeued;
     len -= (int) dequeued;
 
+    /* Top the ring up from the overflow. If the app holds queue_lock, it's
+       queueing right now and will do that itself, so don't wait for it. */
+    if (SDL_TryLockMutex(device->queue_lock) == 0) {
+        MoveQueuedAudioToRing(device);
+        SDL_UnlockMutex(device->queue_lock);
+
+        dequeued = SDL_ReadFromRingBuffer(device->buffer_ring, stream, len);
+        stream += dequeued;
+        len -= (int) dequeued;
+    }
+
     if (len > 0) {  /* fill any remaining space in the stream with silence. */
-        SDL_assert(SDL_CountDataQueue(device->buffer_queue) == 0);
         SDL_memset(stream, device->spec.silence, len);
     }
 }
@@ -568,9 +597,19 @@ SDL_QueueAudio(SDL_AudioDeviceID devid, const void *data, Uint32 len)
     }
 
     if (len > 0) {
-        current_audio.impl.LockDevice(device);
-        rc = SDL_WriteToDataQueue(device->buffer_queue, data, len);
-        current_audio.impl.UnlockDevice(device);
+        /* This never takes the mixer lock: the audio thread reads the ring
+           without locking, and only tries queue_lock. */
+        SDL_LockMutex(device->queue_lock);
+        MoveQueuedAudioToRing(device);
+        if (SDL_CountDataQueue(device->buffer_queue) == 0) {  /* keep it in order. */
+            const size_t written = SDL_WriteToRingBuffer(device->buffer_ring, data, len);
+            data = ((const Uint8 *) data) + written;
+            len -= (Uint32) written;
+        }
+        if (len > 0) {
+            rc = SDL_WriteToDataQueue(device->buffer_queue, data, len);
+        }
+        SDL_UnlockMutex(device->queue_lock);
     }
 
     return rc;
@@ -607,8 +646,11 @@ SDL_GetQueuedAudioSize(SDL_AudioDeviceID devid)
 
     /* Nothing to do unless we're set up for queueing. */
     if (device->callbackspec.callback == SDL_BufferQueueDrainCallback) {
+        SDL_LockMutex(device->queue_lock);
+        retval = (Uint32) (SDL_CountRingBuffer(device->buffer_ring) + SDL_CountDataQueue(device->buffer_queue));
+        SDL_UnlockMutex(device->queue_lock);
         current_audio.impl.LockDevice(device);
-        retval = ((Uint32) SDL_CountDataQueue(device->buffer_queue)) + current_audio.impl.GetPendingBytes(device);
+        retval += current_audio.impl.GetPendingBytes(device);
         current_audio.impl.UnlockDevice(device);
     } else if (device->callbackspec.callback == SDL_BufferQueueFillCallback) {
         current_audio.impl.LockDevice(device);
@@ -630,10 +672,19 @@ SDL_ClearQueuedAudio(SDL_AudioDeviceID devid)
 
     /* Blank out the device and release the mutex. Free it afterwards. */
     current_audio.impl.LockDevice(device);
+    if (device->queue_lock) {
+        SDL_LockMutex(device->queue_lock);
+    }
+
+    /* The audio thread can't be reading the ring while we hold the mixer lock. */
+    SDL_ClearRingBuffer(device->buffer_ring);
 
     /* Keep up to two packets in the pool to reduce future malloc pressure. */
     SDL_ClearDataQueue(device->buffer_queue, SDL_AUDIOBUFFERQUEUE_PACKETLEN * 2);
 
+    if (device->queue_lock) {
+        SDL_UnlockMutex(device->queue_lock);
+    }
     current_audio.impl.UnlockDevice(device);
 }
 
@@ -1075,6 +1126,10 @@ close_audio_device(SDL_AudioDevice * device)
     }
 
     SDL_FreeDataQueue(device->buffer_queue);
+    SDL_FreeRingBuffer(device->buffer_ring);
+    if (device->queue_lock != NULL) {
+        SDL_DestroyMutex(device->queue_lock);
+    }
 
     SDL_free(device);
 }
@@ -1348,6 +1403,15 @@ open_audio_device(const char *devname, int iscapture,
             SDL_SetError("Couldn't create audio buffer queue");
             return 0;
         }
+        if (!iscapture) {
+            device->buffer_ring = SDL_NewRingBuffer(obtained->size * SDL_AUDIOBUFFERQUEUE_RINGCALLBACKS);
+            device->queue_lock = SDL_CreateMutex();
+            if (!device->buffer_ring || !device->queue_lock) {
+                close_audio_device(device);
+                SDL_SetError("Couldn't create audio buffer queue");
+                return 0;
+            }
+        }
         device->callbackspec.callback = iscapture ? SDL_BufferQueueFillCallback : SDL_BufferQueueDrainCallback;
         device->callbackspec.userdata = device;
     }
@@ -1546,6 +1610,8 @@ SDL_AudioQuit(void)
 #ifdef HAVE_LIBSAMPLERATE_H
     UnloadLibSampleRate();
 #endif
+
+    SDL_QuitAudioResampler();
 }
 
 #define NUM_FORMATS 10
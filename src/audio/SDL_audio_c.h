@@ -69,6 +69,43 @@ extern SDL_AudioFilter SDL_Convert_F32_to_S16;
 extern SDL_AudioFilter SDL_Convert_F32_to_U16;
 extern SDL_AudioFilter SDL_Convert_F32_to_S32;
 
+/* The band-limited resampler behind SDL_AudioCVT and SDL_AudioStream, working
+   on interleaved float32 frames. The quality comes from
+   SDL_HINT_AUDIO_RESAMPLING_MODE when the resampler is created. */
+typedef struct SDL_AudioResampler SDL_AudioResampler;
+
+/* create a resampler that keeps its filter history between calls */
+extern SDL_AudioResampler *SDL_NewAudioResampler(const int channels, const int src_rate, const int dst_rate);
+
+/* resample inframes of inbuf (or silence if inbuf is NULL), returns the
+   number of frames written. Output that needs input beyond the end is held
+   back until the next call. inbuf and outbuf must not overlap, except when
+   the input sits at the very end of a buffer big enough for the output. */
+extern int SDL_ResampleAudio(SDL_AudioResampler *resampler, const float *inbuf, int inframes, float *outbuf, const int outframes);
+
+/* forget any buffered input */
+extern void SDL_ResetAudioResampler(SDL_AudioResampler *resampler);
+
+extern void SDL_FreeAudioResampler(SDL_AudioResampler *resampler);
+
+/* create a resampler for SDL_AudioCVT, which only knows the ratio of the rates */
+extern SDL_AudioResampler *SDL_NewAudioResamplerForRatio(const int channels, const double rate_incr);
+
+/* the number of frames a complete buffer of inframes frames resamples to */
+extern int SDL_GetResampledFrames(SDL_AudioResampler *resampler, const int inframes);
+
+/* the most input frames one call can take without writing more than outframes */
+extern int SDL_GetResamplerMaxInput(SDL_AudioResampler *resampler, const int outframes);
+
+/* frames of silence to put through after the input to get all of it out */
+extern int SDL_GetResamplerLatency(SDL_AudioResampler *resampler);
+
+/* resample a complete buffer, returns the number of frames written or -1 */
+extern int SDL_ResampleAudioBuffer(const int channels, const double rate_incr, const float *inbuf, const int inframes, float *outbuf, const int outframes);
+
+/* free the filter tables kept for later conversions */
+extern void SDL_QuitAudioResampler(void);
+
 
 /* SDL_AudioStream is a new audio conversion interface. It
     might eventually become a public API.
@@ -78,9 +115,9 @@ extern SDL_AudioFilter SDL_Convert_F32_to_S32;
     - it can handle incoming data in any variable size.
     - You push data as you have it, and pull it when you need it
 
-    (Note that currently this converts as data is put into the stream, so
-    you need to push more than a handful of bytes if you want decent
-    resampling. This can be changed later.)
+    (Note that currently this converts as data is put into the stream, and
+    the resampler holds back the last few frames until the data after them
+    has been put into the stream.)
  */
 
 /* this is opaque to the outside world. */
@@ -134,7 +134,7 @@ SDL_ConvertQuadToStereo(SDL_AudioCVT * cvt, SDL_AudioFormat format)
         dst[1] = (src[1] + src[3]) * 0.5f; /* right */
     }
 
-    cvt->len_cvt /= 3;
+    cvt->len_cvt /= 2;
     if (cvt->filters[++cvt->filter_index]) {
         cvt->filters[cvt->filter_index] (cvt, format);
     }
@@ -370,227 +370,6 @@ SDL_Convert51To71(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 }
 
 
-static int
-SDL_ResampleAudioSimple(const int chans, const double rate_incr,
-                        float *last_sample, const float *inbuf,
-                        const int inbuflen, float *outbuf, const int outbuflen)
-{
-    const int framelen = chans * (int)sizeof (float);
-    const int total = (inbuflen / framelen);
-    const int finalpos = (total * chans) - chans;
-    const int dest_samples = (int)(((double)total) * rate_incr);
-    const double src_incr = 1.0 / rate_incr;
-    float *dst;
-    double idx;
-    int i;
-
-    SDL_assert((dest_samples * framelen) <= outbuflen);
-    SDL_assert((inbuflen % framelen) == 0);
-
-    if (rate_incr > 1.0) {  /* upsample */
-        float *target = (outbuf + chans);
-        dst = outbuf + (dest_samples * chans);
-        idx = (double) total;
-
-        if (chans == 1) {
-            const float final_sample = inbuf[finalpos];
-            float earlier_sample = inbuf[finalpos];
-            while (dst > target) {
-                const int pos = ((int) idx) * chans;
-                const float *src = &inbuf[pos];
-                const float val = *(--src);
-                SDL_assert(pos >= 0.0);
-                *(--dst) = (val + earlier_sample) * 0.5f;
-                earlier_sample = val;
-                idx -= src_incr;
-            }
-            /* do last sample, interpolated against previous run's state. */
-            *(--dst) = (inbuf[0] + last_sample[0]) * 0.5f;
-            *last_sample = final_sample;
-        } else if (chans == 2) {
-            const float final_sample2 = inbuf[finalpos+1];
-            const float final_sample1 = inbuf[finalpos];
-            float earlier_sample2 = inbuf[finalpos];
-            float earlier_sample1 = inbuf[finalpos-1];
-            while (dst > target) {
-                const int pos = ((int) idx) * chans;
-                const float *src = &inbuf[pos];
-                const float val2 = *(--src);
-                const float val1 = *(--src);
-                SDL_assert(pos >= 0.0);
-                *(--dst) = (val2 + earlier_sample2) * 0.5f;
-                *(--dst) = (val1 + earlier_sample1) * 0.5f;
-                earlier_sample2 = val2;
-                earlier_sample1 = val1;
-                idx -= src_incr;
-            }
-            /* do last sample, interpolated against previous run's state. */
-            *(--dst) = (inbuf[1] + last_sample[1]) * 0.5f;
-            *(--dst) = (inbuf[0] + last_sample[0]) * 0.5f;
-            last_sample[1] = final_sample2;
-            last_sample[0] = final_sample1;
-        } else {
-            const float *earlier_sample = &inbuf[finalpos];
-            float final_sample[8];
-            SDL_memcpy(final_sample, &inbuf[finalpos], framelen);
-            while (dst > target) {
-                const int pos = ((int) idx) * chans;
-                const float *src = &inbuf[pos];
-                SDL_assert(pos >= 0.0);
-                for (i = chans - 1; i >= 0; i--) {
-                    const float val = *(--src);
-                    *(--dst) = (val + earlier_sample[i]) * 0.5f;
-                }
-                earlier_sample = src;
-                idx -= src_incr;
-            }
-            /* do last sample, interpolated against previous run's state. */
-            for (i = chans - 1; i >= 0; i--) {
-                const float val = inbuf[i];
-                *(--dst) = (val + last_sample[i]) * 0.5f;
-            }
-            SDL_memcpy(last_sample, final_sample, framelen);
-        }
-
-        dst = (outbuf + (dest_samples * chans));
-    } else {  /* downsample */
-        float *target = (outbuf + (dest_samples * chans));
-        dst = outbuf;
-        idx = 0.0;
-        if (chans == 1) {
-            float last = *last_sample;
-            while (dst < target) {
-                const int pos = ((int) idx) * chans;
-                const float val = inbuf[pos];
-                SDL_assert(pos <= finalpos);
-                *(dst++) = (val + last) * 0.5f;
-                last = val;
-                idx += src_incr;
-            }
-            *last_sample = last;
-        } else if (chans == 2) {
-            float last1 = last_sample[0];
-            float last2 = last_sample[1];
-            while (dst < target) {
-                const int pos = ((int) idx) * chans;
-                const float val1 = inbuf[pos];
-                const float val2 = inbuf[pos+1];
-                SDL_assert(pos <= finalpos);
-                *(dst++) = (val1 + last1) * 0.5f;
-                *(dst++) = (val2 + last2) * 0.5f;
-                last1 = val1;
-                last2 = val2;
-                idx += src_incr;
-            }
-            last_sample[0] = last1;
-            last_sample[1] = last2;
-        } else {
-            while (dst < target) {
-                const int pos = ((int) idx) * chans;
-                const float *src = &inbuf[pos];
-                SDL_assert(pos <= finalpos);
-                for (i = 0; i < chans; i++) {
-                    const float val = *(src++);
-                    *(dst++) = (val + last_sample[i]) * 0.5f;
-                    last_sample[i] = val;
-                }
-                idx += src_incr;
-            }
-        }
-    }
-
-    return (int) ((dst - outbuf) * ((int) sizeof (float)));
-}
-
-/* We keep one special-case fast path around for an extremely common audio format. */
-static int
-SDL_ResampleAudioSimple_si16_c2(const double rate_incr,
-                        Sint16 *last_sample, const Sint16 *inbuf,
-                        const int inbuflen, Sint16 *outbuf, const int outbuflen)
-{
-    const int chans = 2;
-    const int framelen = 4;  /* stereo 16 bit */
-    const int total = (inbuflen / framelen);
-    const int finalpos = (total * chans) - chans;
-    const int dest_samples = (int)(((double)total) * rate_incr);
-    const double src_incr = 1.0 / rate_incr;
-    Sint16 *dst;
-    double idx;
-
-    SDL_assert((dest_samples * framelen) <= outbuflen);
-    SDL_assert((inbuflen % framelen) == 0);
-
-    if (rate_incr > 1.0) {
-        Sint16 *target = (outbuf + chans);
-        const Sint16 final_right = inbuf[finalpos+1];
-        const Sint16 final_left = inbuf[finalpos];
-        Sint16 earlier_right = inbuf[finalpos-1];
-        Sint16 earlier_left = inbuf[finalpos-2];
-        dst = outbuf + (dest_samples * chans);
-        idx = (double) total;
-
-        while (dst > target) {
-            const int pos = ((int) idx) * chans;
-            const Sint16 *src = &inbuf[pos];
-            const Sint16 right = *(--src);
-            const Sint16 left = *(--src);
-            SDL_assert(pos >= 0.0);
-            *(--dst) = (((Sint32) right) + ((Sint32) earlier_right)) >> 1;
-            *(--dst) = (((Sint32) left) + ((Sint32) earlier_left)) >> 1;
-            earlier_right = right;
-            earlier_left = left;
-            idx -= src_incr;
-        }
-
-        /* do last sample, interpolated against previous run's state. */
-        *(--dst) = (((Sint32) inbuf[1]) + ((Sint32) last_sample[1])) >> 1;
-        *(--dst) = (((Sint32) inbuf[0]) + ((Sint32) last_sample[0])) >> 1;
-        last_sample[1] = final_right;
-        last_sample[0] = final_left;
-
-        dst = (outbuf + (dest_samples * chans));
-    } else {
-        Sint16 *target = (outbuf + (dest_samples * chans));
-        dst = outbuf;
-        idx = 0.0;
-        while (dst < target) {
-            const int pos = ((int) idx) * chans;
-            const Sint16 *src = &inbuf[pos];
-            const Sint16 left = *(src++);
-            const Sint16 right = *(src++);
-            SDL_assert(pos <= finalpos);
-            *(dst++) = (((Sint32) left) + ((Sint32) last_sample[0])) >> 1;
-            *(dst++) = (((Sint32) right) + ((Sint32) last_sample[1])) >> 1;
-            last_sample[0] = left;
-            last_sample[1] = right;
-            idx += src_incr;
-        }
-    }
-
-    return (int) ((dst - outbuf) * ((int) sizeof (Sint16)));
-}
-
-static void SDLCALL
-SDL_ResampleCVT_si16_c2(SDL_AudioCVT *cvt, SDL_AudioFormat format)
-{
-    const Sint16 *src = (const Sint16 *) cvt->buf;
-    const int srclen = cvt->len_cvt;
-    Sint16 *dst = (Sint16 *) cvt->buf;
-    const int dstlen = (cvt->len * cvt->len_mult);
-    Sint16 state[2];
-
-    state[0] = src[0];
-    state[1] = src[1];
-
-    SDL_assert(format == AUDIO_S16SYS);
-
-    cvt->len_cvt = SDL_ResampleAudioSimple_si16_c2(cvt->rate_incr, state, src, srclen, dst, dstlen);
-    if (cvt->filters[++cvt->filter_index]) {
-        cvt->filters[cvt->filter_index](cvt, format);
-    }
-}
-
-
 int
 SDL_ConvertAudio(SDL_AudioCVT * cvt)
 {
@@ -758,20 +537,32 @@ SDL_BuildAudioTypeCVTFromFloat(SDL_AudioCVT *cvt, const SDL_AudioFormat dst_fmt)
     return retval;
 }
 
+/* The resampler reads its input in chunks before writing the output frames
+   that depend on it, so it can work in place if the input is moved to the end
+   of a buffer that has room for the output: the output never catches up. */
+static const float *
+MoveResamplerInput(void *buf, const int inlen, const int buflen)
+{
+    Uint8 *inbuf = ((Uint8 *) buf) + (buflen - inlen);
+    SDL_memmove(inbuf, buf, inlen);
+    return (const float *) inbuf;
+}
+
 static void
 SDL_ResampleCVT(SDL_AudioCVT *cvt, const int chans, const SDL_AudioFormat format)
 {
-    const float *src = (const float *) cvt->buf;
-    const int srclen = cvt->len_cvt;
+    const int framelen = chans * (int)sizeof (float);
+    const int srclen = cvt->len_cvt - (cvt->len_cvt % framelen);
+    const int dstlen = (cvt->len * cvt->len_mult) - ((cvt->len * cvt->len_mult) % framelen);
     float *dst = (float *) cvt->buf;
-    const int dstlen = (cvt->len * cvt->len_mult);
-    float state[8];
+    const float *src;
+    int frames;
 
     SDL_assert(format == AUDIO_F32SYS);
 
-    SDL_memcpy(state, src, chans*sizeof(*src));
-
-    cvt->len_cvt = SDL_ResampleAudioSimple(chans, cvt->rate_incr, state, src, srclen, dst, dstlen);
+    src = MoveResamplerInput(cvt->buf, srclen, dstlen);
+    frames = SDL_ResampleAudioBuffer(chans, cvt->rate_incr, src, srclen / framelen, dst, dstlen / framelen);
+    cvt->len_cvt = SDL_max(frames, 0) * framelen;  /* silence if we ran out of memory */
     if (cvt->filters[++cvt->filter_index]) {
         cvt->filters[cvt->filter_index](cvt, format);
     }
@@ -838,6 +629,484 @@ SDL_BuildAudioResampleCVT(SDL_AudioCVT * cvt, const int dst_channels,
     return 1;               /* added a converter. */
 }
 
+/* Adds the filters to remix src_channels to dst_channels. Updates (cvt). */
+static int
+SDL_BuildAudioChannelCVT(SDL_AudioCVT *cvt, int src_channels, const int dst_channels)
+{
+    if (src_channels < dst_channels) {
+        /* Upmixing */
+        /* Mono -> Stereo [-> ...] */
+        if ((src_channels == 1) && (dst_channels > 1)) {
+            if (SDL_AddAudioCVTFilter(cvt, SDL_ConvertMonoToStereo) < 0) {
+                return -1;
+            }
+            cvt->len_mult *= 2;
+            src_channels = 2;
+            cvt->len_ratio *= 2;
+        }
+        /* [Mono ->] Stereo -> 5.1 [-> 7.1] */
+        if ((src_channels == 2) && (dst_channels >= 6)) {
+            if (SDL_AddAudioCVTFilter(cvt, SDL_ConvertStereoTo51) < 0) {
+                return -1;
+            }
+            src_channels = 6;
+            cvt->len_mult *= 3;
+            cvt->len_ratio *= 3;
+        }
+        /* Quad -> 5.1 [-> 7.1] */
+        if ((src_channels == 4) && (dst_channels >= 6)) {
+            if (SDL_AddAudioCVTFilter(cvt, SDL_ConvertQuadTo51) < 0) {
+                return -1;
+            }
+            src_channels = 6;
+            cvt->len_mult = (cvt->len_mult * 3 + 1) / 2;
+            cvt->len_ratio *= 1.5;
+        }
+        /* [[Mono ->] Stereo ->] 5.1 -> 7.1 */
+        if ((src_channels == 6) && (dst_channels == 8)) {
+            if (SDL_AddAudioCVTFilter(cvt, SDL_Convert51To71) < 0) {
+                return -1;
+            }
+            src_channels = 8;
+            cvt->len_mult = (cvt->len_mult * 4 + 2) / 3;
+            /* Should be numerically exact with every valid input to this
+               function */
+            cvt->len_ratio = cvt->len_ratio * 4 / 3;
+        }
+        /* [Mono ->] Stereo -> Quad */
+        if ((src_channels == 2) && (dst_channels == 4)) {
+            if (SDL_AddAudioCVTFilter(cvt, SDL_ConvertStereoToQuad) < 0) {
+                return -1;
+            }
+            src_channels = 4;
+            cvt->len_mult *= 2;
+            cvt->len_ratio *= 2;
+        }
+    } else if (src_channels > dst_channels) {
+        /* Downmixing */
+        /* 7.1 -> 5.1 [-> Stereo [-> Mono]] */
+        /* 7.1 -> 5.1 [-> Quad] */
+        if ((src_channels == 8) && (dst_channels <= 6)) {
+            if (SDL_AddAudioCVTFilter(cvt, SDL_Convert71To51) < 0) {
+                return -1;
+            }
+            src_channels = 6;
+            cvt->len_ratio *= 0.75;
+        }
+        /* [7.1 ->] 5.1 -> Stereo [-> Mono] */
+        if ((src_channels == 6) && (dst_channels <= 2)) {
+            if (SDL_AddAudioCVTFilter(cvt, SDL_Convert51ToStereo) < 0) {
+                return -1;
+            }
+            src_channels = 2;
+            cvt->len_ratio /= 3;
+        }
+        /* 5.1 -> Quad */
+        if ((src_channels == 6) && (dst_channels == 4)) {
+            if (SDL_AddAudioCVTFilter(cvt, SDL_Convert51ToQuad) < 0) {
+                return -1;
+            }
+            src_channels = 4;
+            cvt->len_ratio = cvt->len_ratio * 2 / 3;
+        }
+        /* Quad -> Stereo [-> Mono] */
+        if ((src_channels == 4) && (dst_channels <= 2)) {
+            if (SDL_AddAudioCVTFilter(cvt, SDL_ConvertQuadToStereo) < 0) {
+                return -1;
+            }
+            src_channels = 2;
+            cvt->len_ratio /= 2;
+        }
+        /* [... ->] Stereo -> Mono */
+        if ((src_channels == 2) && (dst_channels == 1)) {
+            SDL_AudioFilter filter = NULL;
+
+            #if HAVE_SSE3_INTRINSICS
+            if (SDL_HasSSE3()) {
+                filter = SDL_ConvertStereoToMono_SSE3;
+            }
+            #endif
+
+            if (!filter) {
+                filter = SDL_ConvertStereoToMono;
+            }
+
+            if (SDL_AddAudioCVTFilter(cvt, filter) < 0) {
+                return -1;
+            }
+
+            src_channels = 1;
+            cvt->len_ratio /= 2;
+        }
+    }
+
+    if (src_channels != dst_channels) {
+        /* All combinations of supported channel counts should have been
+           handled by now, but let's be defensive */
+        return SDL_SetError("Invalid channel combination");
+    }
+
+    return 0;
+}
+
+/* When a resampling conversion needs several passes, SDL_BuildAudioCVT
+   replaces them with one that loads a block of frames into float, remixes
+   and resamples it while it is in the cache and stores it in the destination
+   format. The buffer only needs room for the final output, not for the float
+   intermediate. */
+#define FUSED_BLOCK_FRAMES 128
+#define FUSED_OUTPUT_FRAMES 256
+
+#define DIVBY128 0.0078125f
+#define DIVBY32768 0.000030517578125f
+#define DIVBY2147483648 0.00000000046566128730773926
+
+static SDL_bool
+NeedsByteswap(const SDL_AudioFormat fmt)
+{
+    return ((SDL_AUDIO_ISBIGENDIAN(fmt) != 0) == (SDL_BYTEORDER == SDL_LIL_ENDIAN));
+}
+
+/* Same math as the SDL_Convert_*_to_F32 filters. The byteswapped and
+   native loops are kept apart so both can be vectorized. */
+#define LOAD_FUSED_SAMPLES(type, swapfn, expr) { \
+        const type *samples_in = (const type *) src; \
+        if (swap) { \
+            for (i = 0; i < samples; ++i) { \
+                const type sample = swapfn(samples_in[i]); \
+                dst[i] = expr; \
+            } \
+        } else { \
+            for (i = 0; i < samples; ++i) { \
+                const type sample = samples_in[i]; \
+                dst[i] = expr; \
+            } \
+        } \
+    }
+
+static void
+LoadFusedSamples(const Uint8 *src, const SDL_AudioFormat fmt, float *dst, const int samples)
+{
+    const SDL_bool swap = NeedsByteswap(fmt);
+    int i;
+
+    switch (fmt & ~SDL_AUDIO_MASK_ENDIAN) {
+        case AUDIO_S8:
+            LOAD_FUSED_SAMPLES(Sint8, , ((float) sample) * DIVBY128);
+            break;
+
+        case AUDIO_U8:
+            LOAD_FUSED_SAMPLES(Uint8, , (((float) sample) * DIVBY128) - 1.0f);
+            break;
+
+        case AUDIO_S16:
+            LOAD_FUSED_SAMPLES(Uint16, SDL_Swap16, ((float) (Sint16) sample) * DIVBY32768);
+            break;
+
+        case AUDIO_U16:
+            LOAD_FUSED_SAMPLES(Uint16, SDL_Swap16, (((float) sample) * DIVBY32768) - 1.0f);
+            break;
+
+        case AUDIO_S32:
+            LOAD_FUSED_SAMPLES(Uint32, SDL_Swap32, (float) (((double) (Sint32) sample) * DIVBY2147483648));
+            break;
+
+        case AUDIO_F32:
+            LOAD_FUSED_SAMPLES(float, SDL_SwapFloat, sample);
+            break;
+
+        default: SDL_assert(!"Unexpected audio format!"); break;
+    }
+}
+#undef LOAD_FUSED_SAMPLES
+
+/* Same math as the SDL_Convert_F32_to_* filters, but clamped. */
+#define STORE_FUSED_SAMPLES(type, swapfn, expr) { \
+        type *samples_out = (type *) dst; \
+        if (swap) { \
+            for (i = 0; i < samples; ++i) { \
+                const float sample = SDL_min(SDL_max(src[i], -1.0f), 1.0f); \
+                samples_out[i] = swapfn((type) (expr)); \
+            } \
+        } else { \
+            for (i = 0; i < samples; ++i) { \
+                const float sample = SDL_min(SDL_max(src[i], -1.0f), 1.0f); \
+                samples_out[i] = (type) (expr); \
+            } \
+        } \
+    }
+
+static void
+StoreFusedSamples(const float *src, const SDL_AudioFormat fmt, Uint8 *dst, const int samples)
+{
+    const SDL_bool swap = NeedsByteswap(fmt);
+    int i;
+
+    switch (fmt & ~SDL_AUDIO_MASK_ENDIAN) {
+        case AUDIO_S8:
+            STORE_FUSED_SAMPLES(Sint8, , sample * 127.0f);
+            break;
+
+        case AUDIO_U8:
+            STORE_FUSED_SAMPLES(Uint8, , (sample + 1.0f) * 127.0f);
+            break;
+
+        case AUDIO_S16:
+            STORE_FUSED_SAMPLES(Uint16, SDL_Swap16, (Sint16) (sample * 32767.0f));
+            break;
+
+        case AUDIO_U16:
+            STORE_FUSED_SAMPLES(Uint16, SDL_Swap16, (sample + 1.0f) * 32767.0f);
+            break;
+
+        case AUDIO_S32:
+            STORE_FUSED_SAMPLES(Uint32, SDL_Swap32, (Sint32) (((double) sample) * 2147483647.0));
+            break;
+
+        case AUDIO_F32:  /* not clamped, like the filter chain. */
+            if (swap) {
+                for (i = 0; i < samples; ++i) {
+                    ((float *) dst)[i] = SDL_SwapFloat(src[i]);
+                }
+            } else {
+                SDL_memcpy(dst, src, samples * sizeof (float));
+            }
+            break;
+
+        default: SDL_assert(!"Unexpected audio format!"); break;
+    }
+}
+#undef STORE_FUSED_SAMPLES
+
+/* The channel filters are all linear, so run them over one frame per source
+   channel, each with only that channel set, to get how much every source
+   channel contributes to every destination channel. */
+static void
+GetChannelMatrix(const int src_channels, const int dst_channels, float *matrix)
+{
+    float frames[8 * 8];
+    SDL_AudioCVT cvt;
+    int i;
+
+    SDL_zero(cvt);
+    SDL_zero(frames);
+    for (i = 0; i < src_channels; ++i) {
+        frames[i * src_channels + i] = 1.0f;
+    }
+
+    cvt.len_mult = 1;
+    cvt.len_ratio = 1.0;
+    if (SDL_BuildAudioChannelCVT(&cvt, src_channels, dst_channels) == 0) {
+        cvt.buf = (Uint8 *) frames;
+        cvt.len = cvt.len_cvt = src_channels * src_channels * (int) sizeof (float);
+        cvt.filter_index = 0;
+        if (cvt.filters[0]) {
+            cvt.filters[0](&cvt, AUDIO_F32SYS);
+        }
+    }
+
+    SDL_memcpy(matrix, frames, src_channels * dst_channels * sizeof (float));
+}
+
+/* Remixes in place; downmixing runs forwards and upmixing backwards so a
+   frame is never overwritten before it is read. Inlined into a function per
+   channel combination so the loops over the channels unroll. */
+typedef void (*SDL_FusedRemixFunc)(float *buf, const int frames, const float *matrix);
+
+SDL_FORCE_INLINE void
+RemixFusedFrames(float *buf, const int frames, const int src_channels,
+                 const int dst_channels, const float *matrix)
+{
+    const int step = (dst_channels < src_channels) ? 1 : -1;
+    const int first = (step > 0) ? 0 : frames - 1;
+    float mixed[8];
+    int i, j, k;
+
+    for (i = 0; i < frames; ++i) {
+        const int frame = first + i * step;
+        const float *src = buf + frame * src_channels;
+        float *dst = buf + frame * dst_channels;
+        for (j = 0; j < dst_channels; ++j) {
+            float sample = 0.0f;
+            for (k = 0; k < src_channels; ++k) {
+                sample += src[k] * matrix[k * dst_channels + j];
+            }
+            mixed[j] = sample;
+        }
+        for (j = 0; j < dst_channels; ++j) {
+            dst[j] = mixed[j];
+        }
+    }
+}
+
+static void
+SDL_ConvertFused(SDL_AudioCVT *cvt, const int src_channels, const int dst_channels,
+                 const SDL_FusedRemixFunc remix)
+{
+    const SDL_AudioFormat src_fmt = cvt->src_format;
+    const SDL_AudioFormat dst_fmt = cvt->dst_format;
+    const int src_framelen = (SDL_AUDIO_BITSIZE(src_fmt) / 8) * src_channels;
+    const int dst_framelen = (SDL_AUDIO_BITSIZE(dst_fmt) / 8) * dst_channels;
+    const int buflen = cvt->len * cvt->len_mult;
+    const int inframes = cvt->len_cvt / src_framelen;
+    float matrix[8 * 8];
+    float inblock[FUSED_BLOCK_FRAMES * 8];
+    float outblock[FUSED_OUTPUT_FRAMES * 8];
+    SDL_AudioResampler *resampler = NULL;
+    const Uint8 *src = cvt->buf;
+    Uint8 *dst = cvt->buf;
+    int blockframes = FUSED_BLOCK_FRAMES;
+    int outframes = inframes;
+    int remaining = inframes;
+    int flush = 0;
+    int written = 0;
+
+    if (src_channels != dst_channels) {
+        GetChannelMatrix(src_channels, dst_channels, matrix);
+    }
+
+    if (cvt->rate_incr != 1.0) {
+        /* resample at whichever side of the remix has fewer channels. */
+        resampler = SDL_NewAudioResamplerForRatio(SDL_min(src_channels, dst_channels), cvt->rate_incr);
+        if (resampler) {
+            blockframes = SDL_min(blockframes, SDL_GetResamplerMaxInput(resampler, FUSED_OUTPUT_FRAMES));
+            outframes = SDL_min(SDL_GetResampledFrames(resampler, inframes), buflen / dst_framelen);
+            flush = SDL_GetResamplerLatency(resampler);
+        }
+        if (!resampler || blockframes <= 0) {
+            outframes = 0;  /* silence if we ran out of memory */
+        }
+    }
+
+    /* The output never gets ahead of the input by more than it grows, so
+       growing conversions read the input from the end of the buffer. */
+    if (cvt->rate_incr * dst_framelen > src_framelen) {
+        src = (const Uint8 *) MoveResamplerInput(cvt->buf, inframes * src_framelen, buflen);
+    }
+
+    while ((written < outframes) && ((remaining > 0) || (flush > 0))) {
+        float *block = inblock;
+        int frames;
+
+        if (remaining > 0) {
+            frames = SDL_min(remaining, blockframes);
+            LoadFusedSamples(src, src_fmt, inblock, frames * src_channels);
+            src += frames * src_framelen;
+            remaining -= frames;
+            if (src_channels > dst_channels) {
+                remix(inblock, frames, matrix);
+            }
+        } else {
+            frames = SDL_min(flush, blockframes);
+            flush -= frames;
+            block = NULL;  /* silence to get the resampler's tail out. */
+        }
+
+        if (resampler) {
+            frames = SDL_ResampleAudio(resampler, block, frames, outblock,
+                                       SDL_min(FUSED_OUTPUT_FRAMES, outframes - written));
+            block = outblock;
+        }
+
+        if (src_channels < dst_channels) {
+            remix(block, frames, matrix);
+        }
+
+        SDL_assert((dst + frames * dst_framelen) <= ((remaining > 0) ? src : cvt->buf + buflen));
+        StoreFusedSamples(block, dst_fmt, dst, frames * dst_channels);
+        dst += frames * dst_framelen;
+        written += frames;
+    }
+
+    SDL_FreeAudioResampler(resampler);
+
+    cvt->len_cvt = written * dst_framelen;
+    if (cvt->filters[++cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, dst_fmt);
+    }
+}
+
+/* !!! FIXME: More macro salsa, see RESAMPLER_FUNCS. */
+#define FUSED_FUNCS(src, dst) \
+    static void \
+    RemixFused_c##src##_c##dst(float *buf, const int frames, const float *matrix) { \
+        RemixFusedFrames(buf, frames, src, dst, matrix); \
+    } \
+    static void SDLCALL \
+    SDL_ConvertFused_c##src##_c##dst(SDL_AudioCVT *cvt, SDL_AudioFormat format) { \
+        SDL_ConvertFused(cvt, src, dst, RemixFused_c##src##_c##dst); \
+    }
+#define FUSED_FUNCS_FROM(src) \
+    FUSED_FUNCS(src, 1) FUSED_FUNCS(src, 2) FUSED_FUNCS(src, 4) \
+    FUSED_FUNCS(src, 6) FUSED_FUNCS(src, 8)
+FUSED_FUNCS_FROM(1)
+FUSED_FUNCS_FROM(2)
+FUSED_FUNCS_FROM(4)
+FUSED_FUNCS_FROM(6)
+FUSED_FUNCS_FROM(8)
+#undef FUSED_FUNCS_FROM
+#undef FUSED_FUNCS
+
+static int
+GetChannelCountIndex(const int channels)
+{
+    switch (channels) {
+        case 1: return 0;
+        case 2: return 1;
+        case 4: return 2;
+        case 6: return 3;
+        case 8: return 4;
+        default: break;
+    }
+
+    return -1;
+}
+
+static SDL_AudioFilter
+ChooseFusedConverter(const int src_channels, const int dst_channels)
+{
+    #define FUSED_ROW(src) { \
+        SDL_ConvertFused_c##src##_c1, SDL_ConvertFused_c##src##_c2, \
+        SDL_ConvertFused_c##src##_c4, SDL_ConvertFused_c##src##_c6, \
+        SDL_ConvertFused_c##src##_c8 \
+    }
+    static const SDL_AudioFilter converters[5][5] = {
+        FUSED_ROW(1), FUSED_ROW(2), FUSED_ROW(4), FUSED_ROW(6), FUSED_ROW(8)
+    };
+    #undef FUSED_ROW
+    const int src_index = GetChannelCountIndex(src_channels);
+    const int dst_index = GetChannelCountIndex(dst_channels);
+
+    if ((src_index < 0) || (dst_index < 0)) {
+        return NULL;
+    }
+    return converters[src_index][dst_index];
+}
+
+/* Replaces the filter chain with a single fused pass, if there is one that
+   fits. Returns 1 if it did, 0 to keep the chain. */
+static int
+SDL_BuildAudioFusedCVT(SDL_AudioCVT *cvt, const int src_channels, const int dst_channels)
+{
+    const int src_framelen = (SDL_AUDIO_BITSIZE(cvt->src_format) / 8) * src_channels;
+    const int dst_framelen = (SDL_AUDIO_BITSIZE(cvt->dst_format) / 8) * dst_channels;
+    const SDL_AudioFilter filter = ChooseFusedConverter(src_channels, dst_channels);
+
+    /* huge upsampling ratios don't fit the output block; let the chain do them. */
+    if ((filter == NULL) || (cvt->rate_incr > (FUSED_OUTPUT_FRAMES / 4))) {
+        return 0;
+    }
+
+    cvt->filter_index = 0;
+    cvt->filters[0] = NULL;
+    if (SDL_AddAudioCVTFilter(cvt, filter) < 0) {
+        return -1;
+    }
+    cvt->len_ratio = (cvt->rate_incr * dst_framelen) / src_framelen;
+    cvt->len_mult = SDL_max((int) SDL_ceil(cvt->len_ratio), 1);
+    return 1;
+}
+
 static SDL_bool
 SDL_SupportedAudioFormat(const SDL_AudioFormat fmt)
 {
@@ -930,32 +1199,6 @@ SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
     /* Make sure we've chosen audio conversion functions (MMX, scalar, etc.) */
     SDL_ChooseAudioConverters();
 
-    /* SDL now favors float32 as its preferred internal format, and considers
-       everything else to be a degenerate case that we might have to make
-       multiple passes over the data to convert to and from float32 as
-       necessary. That being said, we keep one special case around for
-       efficiency: stereo data in Sint16 format, in the native byte order,
-       that only needs resampling. This is likely to be the most popular
-       legacy format, that apps, hardware and the OS are likely to be able
-       to process directly, so we handle this one case directly without
-       unnecessary conversions. This means that apps on embedded devices
-       without floating point hardware should consider aiming for this
-       format as well. */
-    if ((src_channels == 2) && (dst_channels == 2) && (src_fmt == AUDIO_S16SYS) && (dst_fmt == AUDIO_S16SYS) && (src_rate != dst_rate)) {
-        cvt->needed = 1;
-        if (SDL_AddAudioCVTFilter(cvt, SDL_ResampleCVT_si16_c2) < 0) {
-            return -1;
-        }
-        if (src_rate < dst_rate) {
-            const double mult = ((double) dst_rate) / ((double) src_rate);
-            cvt->len_mult *= (int) SDL_ceil(mult);
-            cvt->len_ratio *= mult;
-        } else {
-            cvt->len_ratio /= ((double) src_rate) / ((double) dst_rate);
-        }
-        return 1;
-    }
-
     /* Type conversion goes like this now:
         - byteswap to CPU native format first if necessary.
         - convert to native Float32 if necessary.
@@ -968,7 +1211,12 @@ SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
        buffer is likely to be CPU cache-friendly, avoiding the
        biggest performance hit in modern times. Previously we had
        (script-generated) custom converters for every data type and
-       it was a bloat on SDL compile times and final library size. */
+       it was a bloat on SDL compile times and final library size.
+
+       When the chain resamples and takes more than one pass, it's
+       replaced with a single pass that does all of it a block at a time
+       (see SDL_ConvertFused), so the buffer is only walked once and
+       doesn't need room for the float intermediate. */
 
     /* see if we can skip float conversion entirely. */
     if (src_rate == dst_rate && src_channels == dst_channels) {
@@ -992,119 +1240,10 @@ SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
     }
 
     /* Channel conversion */
-    if (src_channels < dst_channels) {
-        /* Upmixing */
-        /* Mono -> Stereo [-> ...] */
-        if ((src_channels == 1) && (dst_channels > 1)) {
-            if (SDL_AddAudioCVTFilter(cvt, SDL_ConvertMonoToStereo) < 0) {
-                return -1;
-            }
-            cvt->len_mult *= 2;
-            src_channels = 2;
-            cvt->len_ratio *= 2;
-        }
-        /* [Mono ->] Stereo -> 5.1 [-> 7.1] */
-        if ((src_channels == 2) && (dst_channels >= 6)) {
-            if (SDL_AddAudioCVTFilter(cvt, SDL_ConvertStereoTo51) < 0) {
-                return -1;
-            }
-            src_channels = 6;
-            cvt->len_mult *= 3;
-            cvt->len_ratio *= 3;
-        }
-        /* Quad -> 5.1 [-> 7.1] */
-        if ((src_channels == 4) && (dst_channels >= 6)) {
-            if (SDL_AddAudioCVTFilter(cvt, SDL_ConvertQuadTo51) < 0) {
-                return -1;
-            }
-            src_channels = 6;
-            cvt->len_mult = (cvt->len_mult * 3 + 1) / 2;
-            cvt->len_ratio *= 1.5;
-        }
-        /* [[Mono ->] Stereo ->] 5.1 -> 7.1 */
-        if ((src_channels == 6) && (dst_channels == 8)) {
-            if (SDL_AddAudioCVTFilter(cvt, SDL_Convert51To71) < 0) {
-                return -1;
-            }
-            src_channels = 8;
-            cvt->len_mult = (cvt->len_mult * 4 + 2) / 3;
-            /* Should be numerically exact with every valid input to this
-               function */
-            cvt->len_ratio = cvt->len_ratio * 4 / 3;
-        }
-        /* [Mono ->] Stereo -> Quad */
-        if ((src_channels == 2) && (dst_channels == 4)) {
-            if (SDL_AddAudioCVTFilter(cvt, SDL_ConvertStereoToQuad) < 0) {
-                return -1;
-            }
-            src_channels = 4;
-            cvt->len_mult *= 2;
-            cvt->len_ratio *= 2;
-        }
-    } else if (src_channels > dst_channels) {
-        /* Downmixing */
-        /* 7.1 -> 5.1 [-> Stereo [-> Mono]] */
-        /* 7.1 -> 5.1 [-> Quad] */
-        if ((src_channels == 8) && (dst_channels <= 6)) {
-            if (SDL_AddAudioCVTFilter(cvt, SDL_Convert71To51) < 0) {
-                return -1;
-            }
-            src_channels = 6;
-            cvt->len_ratio *= 0.75;
-        }
-        /* [7.1 ->] 5.1 -> Stereo [-> Mono] */
-        if ((src_channels == 6) && (dst_channels <= 2)) {
-            if (SDL_AddAudioCVTFilter(cvt, SDL_Convert51ToStereo) < 0) {
-                return -1;
-            }
-            src_channels = 2;
-            cvt->len_ratio /= 3;
-        }
-        /* 5.1 -> Quad */
-        if ((src_channels == 6) && (dst_channels == 4)) {
-            if (SDL_AddAudioCVTFilter(cvt, SDL_Convert51ToQuad) < 0) {
-                return -1;
-            }
-            src_channels = 4;
-            cvt->len_ratio = cvt->len_ratio * 2 / 3;
-        }
-        /* Quad -> Stereo [-> Mono] */
-        if ((src_channels == 4) && (dst_channels <= 2)) {
-            if (SDL_AddAudioCVTFilter(cvt, SDL_ConvertQuadToStereo) < 0) {
-                return -1;
-            }
-            src_channels = 2;
-            cvt->len_ratio /= 2;
-        }
-        /* [... ->] Stereo -> Mono */
-        if ((src_channels == 2) && (dst_channels == 1)) {
-            SDL_AudioFilter filter = NULL;
-
-            #if HAVE_SSE3_INTRINSICS
-            if (SDL_HasSSE3()) {
-                filter = SDL_ConvertStereoToMono_SSE3;
-            }
-            #endif
-
-            if (!filter) {
-                filter = SDL_ConvertStereoToMono;
-            }
-
-            if (SDL_AddAudioCVTFilter(cvt, filter) < 0) {
-                return -1;
-            }
-
-            src_channels = 1;
-            cvt->len_ratio /= 2;
-        }
+    if (SDL_BuildAudioChannelCVT(cvt, src_channels, dst_channels) < 0) {
+        return -1;
     }
 
-    if (src_channels != dst_channels) {
-        /* All combinations of supported channel counts should have been
-           handled by now, but let's be defensive */
-      return SDL_SetError("Invalid channel combination");
-    }
-    
     /* Do rate conversion, if necessary. Updates (cvt). */
     if (SDL_BuildAudioResampleCVT(cvt, dst_channels, src_rate, dst_rate) < 0) {
         return -1;              /* shouldn't happen, but just in case... */
@@ -1115,6 +1254,15 @@ SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
         return -1;              /* shouldn't happen, but just in case... */
     }
 
+    /* Resampling plus anything else goes in one pass. Remixing and format
+       changes alone stay on the chain: the SIMD converters beat the fused
+       loops on anything that fits in the cache. */
+    if ((cvt->filter_index > 1) && (src_rate != dst_rate)) {
+        if (SDL_BuildAudioFusedCVT(cvt, src_channels, dst_channels) < 0) {
+            return -1;
+        }
+    }
+
     cvt->needed = (cvt->filter_index != 0);
     return (cvt->needed);
 }
@@ -1262,63 +1410,30 @@ SetupLibSampleRateResampling(SDL_AudioStream *stream)
 #endif /* HAVE_LIBSAMPLERATE_H */
 
 
-typedef struct
-{
-    SDL_bool resampler_seeded;
-    union
-    {
-        float f[8];
-        Sint16 si16[2];
-    } resampler_state;
-} SDL_AudioStreamResamplerState;
-
 static int
 SDL_ResampleAudioStream(SDL_AudioStream *stream, const void *_inbuf, const int inbuflen, void *_outbuf, const int outbuflen)
 {
+    const int framelen = sizeof(float) * stream->pre_resample_channels;
+    SDL_AudioResampler *resampler = (SDL_AudioResampler *) stream->resampler_state;
     const float *inbuf = (const float *) _inbuf;
     float *outbuf = (float *) _outbuf;
-    SDL_AudioStreamResamplerState *state = (SDL_AudioStreamResamplerState*)stream->resampler_state;
-    const int chans = (int)stream->pre_resample_channels;
-
-    SDL_assert(chans <= SDL_arraysize(state->resampler_state.f));
 
-    if (!state->resampler_seeded) {
-        SDL_memcpy(state->resampler_state.f, inbuf, chans * sizeof (float));
-        state->resampler_seeded = SDL_TRUE;
+    if (inbuf == ((const float *) outbuf)) {
+        inbuf = MoveResamplerInput(outbuf, inbuflen, outbuflen);
     }
-
-    return SDL_ResampleAudioSimple(chans, stream->rate_incr, state->resampler_state.f, inbuf, inbuflen, outbuf, outbuflen);
-}
-
-static int
-SDL_ResampleAudioStream_si16_c2(SDL_AudioStream *stream, const void *_inbuf, const int inbuflen, void *_outbuf, const int outbuflen)
-{
-    const Sint16 *inbuf = (const Sint16 *) _inbuf;
-    Sint16 *outbuf = (Sint16 *) _outbuf;
-    SDL_AudioStreamResamplerState *state = (SDL_AudioStreamResamplerState*)stream->resampler_state;
-
-    SDL_assert(((int)stream->pre_resample_channels) <= SDL_arraysize(state->resampler_state.si16));
-
-    if (!state->resampler_seeded) {
-        state->resampler_state.si16[0] = inbuf[0];
-        state->resampler_state.si16[1] = inbuf[1];
-        state->resampler_seeded = SDL_TRUE;
-    }
-
-    return SDL_ResampleAudioSimple_si16_c2(stream->rate_incr, state->resampler_state.si16, inbuf, inbuflen, outbuf, outbuflen);
+    return SDL_ResampleAudio(resampler, inbuf, inbuflen / framelen, outbuf, outbuflen / framelen) * framelen;
 }
 
 static void
 SDL_ResetAudioStreamResampler(SDL_AudioStream *stream)
 {
-    SDL_AudioStreamResamplerState *state = (SDL_AudioStreamResamplerState*)stream->resampler_state;
-    state->resampler_seeded = SDL_FALSE;
+    SDL_ResetAudioResampler((SDL_AudioResampler *) stream->resampler_state);
 }
 
 static void
 SDL_CleanupAudioStreamResampler(SDL_AudioStream *stream)
 {
-    SDL_free(stream->resampler_state);
+    SDL_FreeAudioResampler((SDL_AudioResampler *) stream->resampler_state);
 }
 
 SDL_AudioStream *
@@ -1332,9 +1447,6 @@ SDL_NewAudioStream(const SDL_AudioFormat src_format,
     const int packetlen = 4096;  /* !!! FIXME: good enough for now. */
     Uint8 pre_resample_channels;
     SDL_AudioStream *retval;
-#ifndef HAVE_LIBSAMPLERATE_H
-    const SDL_bool SRC_available = SDL_FALSE;
-#endif
 
     retval = (SDL_AudioStream *) SDL_calloc(1, sizeof (SDL_AudioStream));
     if (!retval) {
@@ -1366,18 +1478,6 @@ SDL_NewAudioStream(const SDL_AudioFormat src_format,
             SDL_FreeAudioStream(retval);
             return NULL;  /* SDL_BuildAudioCVT should have called SDL_SetError. */
         }
-    /* fast path special case for stereo Sint16 data that just needs resampling. */
-    } else if ((!SRC_available) && (src_channels == 2) && (dst_channels == 2) && (src_format == AUDIO_S16SYS) && (dst_format == AUDIO_S16SYS)) {
-        SDL_assert(src_rate != dst_rate);
-        retval->resampler_state = SDL_calloc(1, sizeof(SDL_AudioStreamResamplerState));
-        if (!retval->resampler_state) {
-            SDL_FreeAudioStream(retval);
-            SDL_OutOfMemory();
-            return NULL;
-        }
-        retval->resampler_func = SDL_ResampleAudioStream_si16_c2;
-        retval->reset_resampler_func = SDL_ResetAudioStreamResampler;
-        retval->cleanup_resampler_func = SDL_CleanupAudioStreamResampler;
     } else {
         /* Don't resample at first. Just get us to Float32 format. */
         /* !!! FIXME: convert to int32 on devices without hardware float. */
@@ -1391,11 +1491,10 @@ SDL_NewAudioStream(const SDL_AudioFormat src_format,
 #endif
 
         if (!retval->resampler_func) {
-            retval->resampler_state = SDL_calloc(1, sizeof(SDL_AudioStreamResamplerState));
+            retval->resampler_state = SDL_NewAudioResampler(pre_resample_channels, src_rate, dst_rate);
             if (!retval->resampler_state) {
                 SDL_FreeAudioStream(retval);
-                SDL_OutOfMemory();
-                return NULL;
+                return NULL;  /* SDL_NewAudioResampler should have called SDL_SetError. */
             }
             retval->resampler_func = SDL_ResampleAudioStream;
             retval->reset_resampler_func = SDL_ResetAudioStreamResampler;
@@ -0,0 +1,623 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* A mixer for any number of voices, each fed through an SDL_AudioStream.
+
+   Data put into a voice goes into a ring buffer as is, and the mix converts
+   it to float at the mixer's channels and rate through the voice's stream,
+   so mixing is a multiply-add per sample and a single clip and conversion
+   to the output format at the end.
+
+   The mixer lock guards the voice list, the mix buffers and the voice
+   streams, and is held for a whole mix. The ring buffer lets a mix read
+   what was put into a voice without locking; what doesn't fit waits in an
+   overflow queue under the voice lock, and the mix only moves it over if
+   it gets that lock without waiting, the same as the device buffer queue.
+   Gain, pan and pause are atomics, so they are never waited for. */
+
+#include "SDL_audio.h"
+#include "SDL_atomic.h"
+#include "SDL_mutex.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_assert.h"
+#include "SDL_audio_c.h"
+#include "SDL_sysaudio.h"
+#include "../SDL_simd.h"
+
+#define MIXER_CHUNK_FRAMES  512     /* frames mixed at a time, also the gain ramp length */
+#define MIXER_MAX_CHANNELS  8
+#define MIXER_MIN_VOICES    8
+#define MIXER_RING_FRACTION 4       /* voice rings hold 1/4 second of data */
+
+struct SDL_AudioVoice
+{
+    SDL_AudioMixer *mixer;
+    int framesize;                  /* in the voice's format */
+    int freq;
+    SDL_RingBuffer *ring;           /* written under the lock, read by the mix */
+    SDL_DataQueue *overflow;        /* what didn't fit in the ring */
+    SDL_mutex *lock;                /* guards the overflow and writing the ring */
+    SDL_AudioStream *stream;        /* to float at the mixer's channels and rate */
+    SDL_atomic_t stream_frames;     /* converted frames left in the stream */
+    SDL_atomic_t gain;              /* bits of a float */
+    SDL_atomic_t pan;               /* bits of a float */
+    SDL_atomic_t paused;
+
+    /* only used while mixing */
+    float mix_gains[MIXER_MAX_CHANNELS];
+    SDL_bool mixed;
+};
+
+/* mixbuf[i] += voicebuf[i] * gain */
+typedef void (*SDL_AccumulateFunc)(float *mixbuf, const float *voicebuf, const int samples, const float gain);
+
+struct SDL_AudioMixer
+{
+    SDL_AudioFormat format;
+    int channels;
+    int freq;
+    int framesize;                  /* in the output format */
+    SDL_AudioCVT cvt;               /* from float to the output format */
+    SDL_mutex *lock;
+    SDL_AudioVoice **voices;
+    int num_voices;
+    int max_voices;
+    float *mixbuf;
+    float *voicebuf;
+    Uint8 *inbuf;                   /* voice data on its way into a stream */
+    int inbuf_len;
+    SDL_AccumulateFunc accumulate;
+};
+
+static void
+SetAtomicFloat(SDL_atomic_t *a, const float value)
+{
+    union { float f; int i; } bits;
+    bits.f = value;
+    SDL_AtomicSet(a, bits.i);
+}
+
+static float
+GetAtomicFloat(SDL_atomic_t *a)
+{
+    union { float f; int i; } bits;
+    bits.i = SDL_AtomicGet(a);
+    return bits.f;
+}
+
+/* Pan the left channels (even ones) and right channels (odd ones), but not
+   center and LFE, which are channels 2 and 3 in 5.1 and 7.1 */
+static void
+GetVoiceGains(SDL_AudioVoice *voice, const int channels, float *gains)
+{
+    const float gain = GetAtomicFloat(&voice->gain);
+    const float pan = GetAtomicFloat(&voice->pan);
+    const float left = gain * SDL_min(1.0f, 1.0f - pan);
+    const float right = gain * SDL_min(1.0f, 1.0f + pan);
+    int c;
+
+    for (c = 0; c < channels; ++c) {
+        if (channels == 1 || (channels >= 6 && (c == 2 || c == 3))) {
+            gains[c] = gain;
+        } else {
+            gains[c] = (c & 1) ? right : left;
+        }
+    }
+}
+
+static void
+SDL_Accumulate_Scalar(float *mixbuf, const float *voicebuf, const int samples, const float gain)
+{
+    int i;
+
+    for (i = 0; i < samples; ++i) {
+        mixbuf[i] += voicebuf[i] * gain;
+    }
+}
+
+#if HAVE_SSE2_INTRINSICS
+static void
+SDL_Accumulate_SSE2(float *mixbuf, const float *voicebuf, const int samples, const float gain)
+{
+    const __m128 g = _mm_set1_ps(gain);
+    int i = 0;
+
+    for (; i + 8 <= samples; i += 8) {
+        _mm_storeu_ps(mixbuf + i, _mm_add_ps(_mm_loadu_ps(mixbuf + i), _mm_mul_ps(_mm_loadu_ps(voicebuf + i), g)));
+        _mm_storeu_ps(mixbuf + i + 4, _mm_add_ps(_mm_loadu_ps(mixbuf + i + 4), _mm_mul_ps(_mm_loadu_ps(voicebuf + i + 4), g)));
+    }
+    SDL_Accumulate_Scalar(mixbuf + i, voicebuf + i, samples - i, gain);
+}
+#endif
+
+#if HAVE_AVX2_INTRINSICS
+static void SDL_TARGETING_AVX2
+SDL_Accumulate_AVX2(float *mixbuf, const float *voicebuf, const int samples, const float gain)
+{
+    const __m256 g = _mm256_set1_ps(gain);
+    int i = 0;
+
+    for (; i + 16 <= samples; i += 16) {
+        _mm256_storeu_ps(mixbuf + i, _mm256_add_ps(_mm256_loadu_ps(mixbuf + i), _mm256_mul_ps(_mm256_loadu_ps(voicebuf + i), g)));
+        _mm256_storeu_ps(mixbuf + i + 8, _mm256_add_ps(_mm256_loadu_ps(mixbuf + i + 8), _mm256_mul_ps(_mm256_loadu_ps(voicebuf + i + 8), g)));
+    }
+    SDL_Accumulate_Scalar(mixbuf + i, voicebuf + i, samples - i, gain);
+}
+#endif
+
+#if HAVE_NEON_INTRINSICS
+static void
+SDL_Accumulate_NEON(float *mixbuf, const float *voicebuf, const int samples, const float gain)
+{
+    int i = 0;
+
+    for (; i + 8 <= samples; i += 8) {
+        vst1q_f32(mixbuf + i, vmlaq_n_f32(vld1q_f32(mixbuf + i), vld1q_f32(voicebuf + i), gain));
+        vst1q_f32(mixbuf + i + 4, vmlaq_n_f32(vld1q_f32(mixbuf + i + 4), vld1q_f32(voicebuf + i + 4), gain));
+    }
+    SDL_Accumulate_Scalar(mixbuf + i, voicebuf + i, samples - i, gain);
+}
+#endif
+
+static SDL_AccumulateFunc
+ChooseAccumulate(void)
+{
+#if HAVE_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return SDL_Accumulate_AVX2;
+    }
+#endif
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return SDL_Accumulate_SSE2;
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return SDL_Accumulate_NEON;
+    }
+#endif
+    return SDL_Accumulate_Scalar;
+}
+
+/* Add a voice to the mix, ramping each channel's gain from 'from' to 'to' */
+static void
+AccumulateVoice(SDL_AudioMixer *mixer, const int frames, const float *from, const float *to)
+{
+    const int channels = mixer->channels;
+    const int samples = frames * channels;
+    float *mixbuf = mixer->mixbuf;
+    const float *voicebuf = mixer->voicebuf;
+    SDL_bool constant = SDL_TRUE;
+    int c, i;
+
+    for (c = 0; c < channels; ++c) {
+        if (from[c] != to[0] || to[c] != to[0]) {
+            constant = SDL_FALSE;
+        }
+    }
+
+    if (constant) {
+        mixer->accumulate(mixbuf, voicebuf, samples, to[0]);
+    } else {
+        for (c = 0; c < channels; ++c) {
+            const float step = (to[c] - from[c]) / frames;
+            float gain = from[c];
+            for (i = c; i < samples; i += channels) {
+                gain += step;
+                mixbuf[i] += voicebuf[i] * gain;
+            }
+        }
+    }
+}
+
+/* The voice lock must be held */
+static void
+MoveOverflowToRing(SDL_AudioVoice *voice)
+{
+    Uint8 buf[1024];
+    const size_t buflen = sizeof (buf) - (sizeof (buf) % voice->framesize);
+    size_t space = SDL_GetRingBufferCapacity(voice->ring) - SDL_CountRingBuffer(voice->ring);
+
+    /* only whole frames, so the mix never reads part of one */
+    space -= space % voice->framesize;
+    while (space > 0) {
+        const size_t len = SDL_ReadFromDataQueue(voice->overflow, buf, SDL_min(space, buflen));
+        if (len == 0) {
+            break;
+        }
+        SDL_WriteToRingBuffer(voice->ring, buf, len);
+        space -= len;
+    }
+}
+
+/* Convert up to len bytes of a voice into the voice buffer, the mixer lock
+   must be held. Returns the number of bytes converted. */
+static int
+GetVoiceData(SDL_AudioMixer *mixer, SDL_AudioVoice *voice, const int len)
+{
+    const int outsize = (int) (mixer->channels * sizeof (float));
+    const int maxlen = mixer->inbuf_len - (mixer->inbuf_len % voice->framesize);
+    SDL_bool topped_up = SDL_FALSE;
+    int got;
+
+    while (SDL_AudioStreamAvailable(voice->stream) < len) {
+        /* about as many frames as are missing, the stream holds on to any extra */
+        const Sint64 missing = (len - SDL_AudioStreamAvailable(voice->stream)) / outsize;
+        const Sint64 wanted = ((missing * voice->freq + mixer->freq - 1) / mixer->freq) * voice->framesize;
+        size_t count = SDL_ReadFromRingBuffer(voice->ring, mixer->inbuf, (size_t) SDL_max(SDL_min(wanted, maxlen), voice->framesize));
+
+        if (count == 0) {
+            /* If the app holds the voice lock, it's putting data into the
+               voice right now and will move the overflow itself. */
+            if (topped_up || SDL_TryLockMutex(voice->lock) != 0) {
+                break;
+            }
+            MoveOverflowToRing(voice);
+            SDL_UnlockMutex(voice->lock);
+            topped_up = SDL_TRUE;
+            continue;
+        }
+        if (SDL_AudioStreamPut(voice->stream, mixer->inbuf, (Uint32) count) < 0) {
+            break;
+        }
+    }
+
+    got = SDL_AudioStreamGet(voice->stream, mixer->voicebuf, len);
+    SDL_AtomicSet(&voice->stream_frames, SDL_AudioStreamAvailable(voice->stream) / outsize);
+    return got;
+}
+
+static void
+FreeVoice(SDL_AudioVoice *voice)
+{
+    SDL_FreeAudioStream(voice->stream);
+    SDL_FreeRingBuffer(voice->ring);
+    SDL_FreeDataQueue(voice->overflow);
+    if (voice->lock) {
+        SDL_DestroyMutex(voice->lock);
+    }
+    SDL_free(voice);
+}
+
+SDL_AudioMixer *
+SDL_CreateAudioMixer(SDL_AudioFormat format, Uint8 channels, int freq)
+{
+    SDL_AudioMixer *mixer;
+    size_t buflen;
+
+    if (freq <= 0) {
+        SDL_InvalidParamError("freq");
+        return NULL;
+    }
+
+    mixer = (SDL_AudioMixer *) SDL_calloc(1, sizeof (SDL_AudioMixer));
+    if (!mixer) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    if (SDL_BuildAudioCVT(&mixer->cvt, AUDIO_F32SYS, channels, freq, format, channels, freq) < 0) {
+        SDL_free(mixer);
+        return NULL;  /* SDL_BuildAudioCVT should have called SDL_SetError. */
+    }
+    SDL_assert(channels <= MIXER_MAX_CHANNELS);
+
+    mixer->format = format;
+    mixer->channels = channels;
+    mixer->freq = freq;
+    mixer->framesize = (SDL_AUDIO_BITSIZE(format) / 8) * channels;
+    mixer->accumulate = ChooseAccumulate();
+
+    mixer->lock = SDL_CreateMutex();
+    if (!mixer->lock) {
+        SDL_FreeAudioMixer(mixer);
+        return NULL;  /* SDL_CreateMutex should have called SDL_SetError. */
+    }
+
+    buflen = MIXER_CHUNK_FRAMES * channels * sizeof (float);
+    mixer->mixbuf = (float *) SDL_malloc(buflen * SDL_max(mixer->cvt.len_mult, 1));
+    mixer->voicebuf = (float *) SDL_malloc(buflen);
+    mixer->inbuf_len = MIXER_CHUNK_FRAMES * MIXER_MAX_CHANNELS * sizeof (float);
+    mixer->inbuf = (Uint8 *) SDL_malloc(mixer->inbuf_len);
+    if (!mixer->mixbuf || !mixer->voicebuf || !mixer->inbuf) {
+        SDL_FreeAudioMixer(mixer);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    return mixer;
+}
+
+void
+SDL_FreeAudioMixer(SDL_AudioMixer *mixer)
+{
+    int i;
+
+    if (!mixer) {
+        return;
+    }
+
+    for (i = 0; i < mixer->num_voices; ++i) {
+        FreeVoice(mixer->voices[i]);
+    }
+    SDL_free(mixer->voices);
+    SDL_free(mixer->mixbuf);
+    SDL_free(mixer->voicebuf);
+    SDL_free(mixer->inbuf);
+    if (mixer->lock) {
+        SDL_DestroyMutex(mixer->lock);
+    }
+    SDL_free(mixer);
+}
+
+int
+SDL_MixAudioVoices(SDL_AudioMixer *mixer, Uint8 *stream, int len)
+{
+    int frames, i;
+
+    if (!mixer) {
+        return SDL_InvalidParamError("mixer");
+    } else if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (len < 0 || (len % mixer->framesize) != 0) {
+        return SDL_SetError("Can't mix partial sample frames");
+    }
+
+    SDL_LockMutex(mixer->lock);
+
+    for (frames = len / mixer->framesize; frames > 0; ) {
+        const int chunk = SDL_min(frames, MIXER_CHUNK_FRAMES);
+        const int samples = chunk * mixer->channels;
+        float *mixbuf = mixer->mixbuf;
+
+        SDL_memset(mixbuf, 0, samples * sizeof (float));
+
+        for (i = 0; i < mixer->num_voices; ++i) {
+            SDL_AudioVoice *voice = mixer->voices[i];
+            float gains[MIXER_MAX_CHANNELS];
+            int got;
+
+            if (SDL_AtomicGet(&voice->paused)) {
+                continue;
+            }
+
+            got = GetVoiceData(mixer, voice, samples * sizeof (float));
+            if (got <= 0) {
+                continue;
+            }
+
+            GetVoiceGains(voice, mixer->channels, gains);
+            if (!voice->mixed) {
+                SDL_memcpy(voice->mix_gains, gains, mixer->channels * sizeof (float));
+                voice->mixed = SDL_TRUE;
+            }
+            AccumulateVoice(mixer, got / (int) (mixer->channels * sizeof (float)), voice->mix_gains, gains);
+            SDL_memcpy(voice->mix_gains, gains, mixer->channels * sizeof (float));
+        }
+
+        /* the only clip, however many voices there are */
+        for (i = 0; i < samples; ++i) {
+            mixbuf[i] = SDL_max(-1.0f, SDL_min(1.0f, mixbuf[i]));
+        }
+
+        if (mixer->cvt.needed) {
+            mixer->cvt.buf = (Uint8 *) mixbuf;
+            mixer->cvt.len = samples * sizeof (float);
+            SDL_ConvertAudio(&mixer->cvt);
+        }
+        SDL_memcpy(stream, mixbuf, chunk * mixer->framesize);
+
+        stream += chunk * mixer->framesize;
+        frames -= chunk;
+    }
+
+    SDL_UnlockMutex(mixer->lock);
+
+    return 0;
+}
+
+void SDLCALL
+SDL_AudioMixerCallback(void *userdata, Uint8 *stream, int len)
+{
+    SDL_MixAudioVoices((SDL_AudioMixer *) userdata, stream, len);
+}
+
+SDL_AudioVoice *
+SDL_AddAudioVoice(SDL_AudioMixer *mixer, SDL_AudioFormat format, Uint8 channels, int freq)
+{
+    SDL_AudioVoice *voice;
+
+    if (!mixer) {
+        SDL_InvalidParamError("mixer");
+        return NULL;
+    } else if (freq <= 0) {
+        SDL_InvalidParamError("freq");
+        return NULL;
+    }
+
+    voice = (SDL_AudioVoice *) SDL_calloc(1, sizeof (SDL_AudioVoice));
+    if (!voice) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    voice->mixer = mixer;
+    voice->framesize = (SDL_AUDIO_BITSIZE(format) / 8) * channels;
+    voice->freq = freq;
+    SetAtomicFloat(&voice->gain, 1.0f);
+    SetAtomicFloat(&voice->pan, 0.0f);
+
+    voice->stream = SDL_NewAudioStream(format, channels, freq, AUDIO_F32SYS, (Uint8) mixer->channels, mixer->freq);
+    if (!voice->stream) {
+        FreeVoice(voice);
+        return NULL;  /* SDL_NewAudioStream should have called SDL_SetError. */
+    }
+    voice->ring = SDL_NewRingBuffer((size_t) voice->framesize * SDL_max(freq / MIXER_RING_FRACTION, MIXER_CHUNK_FRAMES));
+    if (!voice->ring) {
+        FreeVoice(voice);
+        return NULL;  /* SDL_NewRingBuffer should have called SDL_SetError. */
+    }
+    voice->overflow = SDL_NewDataQueue(SDL_AUDIOBUFFERQUEUE_PACKETLEN, 0);
+    if (!voice->overflow) {
+        FreeVoice(voice);
+        return NULL;  /* SDL_NewDataQueue should have called SDL_SetError. */
+    }
+    voice->lock = SDL_CreateMutex();
+    if (!voice->lock) {
+        FreeVoice(voice);
+        return NULL;  /* SDL_CreateMutex should have called SDL_SetError. */
+    }
+
+    SDL_LockMutex(mixer->lock);
+    if (mixer->num_voices == mixer->max_voices) {
+        const int max_voices = SDL_max(mixer->max_voices * 2, MIXER_MIN_VOICES);
+        SDL_AudioVoice **voices = (SDL_AudioVoice **) SDL_realloc(mixer->voices, max_voices * sizeof (SDL_AudioVoice *));
+        if (!voices) {
+            SDL_UnlockMutex(mixer->lock);
+            FreeVoice(voice);
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        mixer->voices = voices;
+        mixer->max_voices = max_voices;
+    }
+    mixer->voices[mixer->num_voices++] = voice;
+    SDL_UnlockMutex(mixer->lock);
+
+    return voice;
+}
+
+void
+SDL_RemoveAudioVoice(SDL_AudioVoice *voice)
+{
+    SDL_AudioMixer *mixer;
+    int i;
+
+    if (!voice) {
+        return;
+    }
+
+    mixer = voice->mixer;
+    SDL_LockMutex(mixer->lock);
+    for (i = 0; i < mixer->num_voices; ++i) {
+        if (mixer->voices[i] == voice) {
+            mixer->voices[i] = mixer->voices[--mixer->num_voices];
+            break;
+        }
+    }
+    SDL_UnlockMutex(mixer->lock);
+
+    FreeVoice(voice);
+}
+
+int
+SDL_PutAudioVoiceData(SDL_AudioVoice *voice, const void *data, int len)
+{
+    int retval = 0;
+
+    if (!voice) {
+        return SDL_InvalidParamError("voice");
+    } else if (!data) {
+        return SDL_InvalidParamError("data");
+    } else if (len < 0) {
+        return SDL_InvalidParamError("len");
+    } else if ((len % voice->framesize) != 0) {
+        return SDL_SetError("Can't add partial sample frames");
+    }
+
+    SDL_LockMutex(voice->lock);
+    MoveOverflowToRing(voice);
+    if (SDL_CountDataQueue(voice->overflow) == 0) {  /* keep it in order. */
+        size_t space = SDL_GetRingBufferCapacity(voice->ring) - SDL_CountRingBuffer(voice->ring);
+        size_t written;
+
+        space -= space % voice->framesize;
+        written = SDL_WriteToRingBuffer(voice->ring, data, SDL_min((size_t) len, space));
+        data = ((const Uint8 *) data) + written;
+        len -= (int) written;
+    }
+    if (len > 0) {
+        retval = SDL_WriteToDataQueue(voice->overflow, data, len);
+    }
+    SDL_UnlockMutex(voice->lock);
+
+    return retval;
+}
+
+int
+SDL_GetAudioVoiceQueuedFrames(SDL_AudioVoice *voice)
+{
+    Sint64 frames;
+
+    if (!voice) {
+        return 0;
+    }
+
+    SDL_LockMutex(voice->lock);
+    frames = (Sint64) (SDL_CountRingBuffer(voice->ring) + SDL_CountDataQueue(voice->overflow)) / voice->framesize;
+    SDL_UnlockMutex(voice->lock);
+
+    /* the data that isn't converted yet, at the mixer's rate */
+    frames = frames * voice->mixer->freq / voice->freq;
+    return (int) frames + SDL_AtomicGet(&voice->stream_frames);
+}
+
+void
+SDL_ClearAudioVoice(SDL_AudioVoice *voice)
+{
+    if (voice) {
+        /* The mix can't be reading the ring while we hold the mixer lock. */
+        SDL_LockMutex(voice->mixer->lock);
+        SDL_LockMutex(voice->lock);
+        SDL_ClearRingBuffer(voice->ring);
+        SDL_ClearDataQueue(voice->overflow, SDL_AUDIOBUFFERQUEUE_PACKETLEN * 2);
+        SDL_UnlockMutex(voice->lock);
+        SDL_AudioStreamClear(voice->stream);
+        SDL_AtomicSet(&voice->stream_frames, 0);
+        SDL_UnlockMutex(voice->mixer->lock);
+    }
+}
+
+void
+SDL_SetAudioVoiceGain(SDL_AudioVoice *voice, float gain)
+{
+    if (voice) {
+        SetAtomicFloat(&voice->gain, gain);
+    }
+}
+
+void
+SDL_SetAudioVoicePan(SDL_AudioVoice *voice, float pan)
+{
+    if (voice) {
+        SetAtomicFloat(&voice->pan, SDL_max(-1.0f, SDL_min(1.0f, pan)));
+    }
+}
+
+void
+SDL_PauseAudioVoice(SDL_AudioVoice *voice, int pause_on)
+{
+    if (voice) {
+        SDL_AtomicSet(&voice->paused, pause_on ? 1 : 0);
+    }
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
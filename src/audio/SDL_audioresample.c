@@ -0,0 +1,690 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "../SDL_internal.h"
+#include "SDL_audio.h"
+#include "SDL_audio_c.h"
+#include "SDL_atomic.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_hints.h"
+#include "SDL_assert.h"
+#include "../SDL_simd.h"
+
+/* Polyphase windowed-sinc resampler.
+
+   For a conversion of num output frames per den input frames, each output
+   frame lies at one of num fractional positions between two input frames.
+   The filter table has a row of Kaiser windowed sinc coefficients for each
+   of those positions, so an output frame is a single dot product of the
+   input frames around it with one row. Rates whose ratio has too many
+   positions get a table of RESAMPLER_INTERP_PHASES rows instead, and the
+   results of the two nearest rows are interpolated.
+
+   Filter tables only depend on the ratio and the quality, so they are
+   shared by every stream using the same conversion. */
+
+#define RESAMPLER_MAX_PHASES        1024  /* more positions than this are interpolated */
+#define RESAMPLER_INTERP_PHASES     512
+#define RESAMPLER_MAX_TAPS          256
+#define RESAMPLER_CHUNK_FRAMES      512
+#define RESAMPLER_MAX_IDLE_FILTERS  4
+#define RESAMPLER_MAX_CHANNELS      8
+
+/* Zero crossings of the sinc on each side, cutoff relative to the lower
+   Nyquist frequency, and Kaiser window shape for each quality level. */
+static const struct
+{
+    int zero_crossings;
+    double rolloff;
+    double beta;
+} resampler_quality[] = {
+    { 4, 0.80, 5.0 },    /* fast */
+    { 16, 0.90, 8.0 },   /* medium */
+    { 32, 0.94, 10.0 }   /* best */
+};
+
+typedef float (*SDL_ResampleDotFunc)(const float *x, const float *h, const int taps);
+
+typedef struct SDL_ResampleFilter
+{
+    int quality;
+    Uint32 num;
+    Uint32 den;
+    int taps;               /* coefficients per row, a multiple of 8 */
+    int phases;             /* rows, plus one extra if interpolating */
+    SDL_bool interpolate;
+    int refcount;
+    float *coefs;           /* 32 byte aligned rows */
+    void *coefs_base;
+    struct SDL_ResampleFilter *next;
+} SDL_ResampleFilter;
+
+struct SDL_AudioResampler
+{
+    int channels;
+    Uint32 num;             /* output frames per den input frames */
+    Uint32 den;
+    int step;               /* input frames to advance per output frame... */
+    Uint32 step_frac;       /* ...plus this many 1/num of a frame */
+    int pos;                /* first input frame used by the next output frame */
+    Uint32 frac;            /* position of the next output frame after it, in 1/num */
+    int buffered;           /* frames in each plane */
+    int capacity;
+    SDL_ResampleFilter *filter;
+    SDL_ResampleDotFunc dot;
+    float *planes[RESAMPLER_MAX_CHANNELS];
+};
+
+static SDL_SpinLock filters_lock = 0;
+static SDL_ResampleFilter *filters = NULL;
+
+static float
+SDL_ResampleDot_Scalar(const float *x, const float *h, const int taps)
+{
+    float sum0 = 0.0f, sum1 = 0.0f, sum2 = 0.0f, sum3 = 0.0f;
+    int i;
+
+    for (i = 0; i < taps; i += 4) {
+        sum0 += x[i] * h[i];
+        sum1 += x[i + 1] * h[i + 1];
+        sum2 += x[i + 2] * h[i + 2];
+        sum3 += x[i + 3] * h[i + 3];
+    }
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
+#if HAVE_SSE2_INTRINSICS
+static float
+SDL_ResampleDot_SSE2(const float *x, const float *h, const int taps)
+{
+    __m128 sum0 = _mm_setzero_ps();
+    __m128 sum1 = _mm_setzero_ps();
+    int i;
+
+    for (i = 0; i < taps; i += 8) {
+        sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(x + i), _mm_load_ps(h + i)));
+        sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(x + i + 4), _mm_load_ps(h + i + 4)));
+    }
+    sum0 = _mm_add_ps(sum0, sum1);
+    sum0 = _mm_add_ps(sum0, _mm_movehl_ps(sum0, sum0));
+    sum0 = _mm_add_ss(sum0, _mm_shuffle_ps(sum0, sum0, 1));
+    return _mm_cvtss_f32(sum0);
+}
+#endif
+
+#if HAVE_AVX2_INTRINSICS
+static float SDL_TARGETING_AVX2
+SDL_ResampleDot_AVX2(const float *x, const float *h, const int taps)
+{
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    __m128 sum;
+    int i = 0;
+
+    for (; i + 16 <= taps; i += 16) {
+        sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_loadu_ps(x + i), _mm256_load_ps(h + i)));
+        sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(_mm256_loadu_ps(x + i + 8), _mm256_load_ps(h + i + 8)));
+    }
+    if (i < taps) {
+        sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_loadu_ps(x + i), _mm256_load_ps(h + i)));
+    }
+    sum0 = _mm256_add_ps(sum0, sum1);
+    sum = _mm_add_ps(_mm256_castps256_ps128(sum0), _mm256_extractf128_ps(sum0, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+#endif
+
+#if HAVE_NEON_INTRINSICS
+static float
+SDL_ResampleDot_NEON(const float *x, const float *h, const int taps)
+{
+    float32x4_t sum0 = vdupq_n_f32(0.0f);
+    float32x4_t sum1 = vdupq_n_f32(0.0f);
+    float32x2_t sum;
+    int i;
+
+    for (i = 0; i < taps; i += 8) {
+        sum0 = vmlaq_f32(sum0, vld1q_f32(x + i), vld1q_f32(h + i));
+        sum1 = vmlaq_f32(sum1, vld1q_f32(x + i + 4), vld1q_f32(h + i + 4));
+    }
+    sum0 = vaddq_f32(sum0, sum1);
+    sum = vadd_f32(vget_low_f32(sum0), vget_high_f32(sum0));
+    return vget_lane_f32(vpadd_f32(sum, sum), 0);
+}
+#endif
+
+static SDL_ResampleDotFunc
+ChooseResampleDot(void)
+{
+#if HAVE_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return SDL_ResampleDot_AVX2;
+    }
+#endif
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return SDL_ResampleDot_SSE2;
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return SDL_ResampleDot_NEON;
+    }
+#endif
+    return SDL_ResampleDot_Scalar;
+}
+
+static int
+GetResamplerQuality(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_AUDIO_RESAMPLING_MODE);
+
+    if (hint) {
+        if (*hint == '1' || SDL_strcasecmp(hint, "fast") == 0) {
+            return 0;
+        } else if (*hint == '3' || SDL_strcasecmp(hint, "best") == 0) {
+            return 2;
+        }
+    }
+    return 1;
+}
+
+static double
+BesselI0(const double x)
+{
+    const double x2 = (x * x) / 4.0;
+    double sum = 1.0;
+    double term = 1.0;
+    int k;
+
+    for (k = 1; term > sum * 1e-12; ++k) {
+        term *= x2 / ((double) k * k);
+        sum += term;
+    }
+    return sum;
+}
+
+static void
+FillFilterRow(float *row, const int taps, const double offset,
+              const double cutoff, const double beta)
+{
+    const double half = taps / 2;
+    const double scale = 1.0 / BesselI0(beta);
+    double sum = 0.0;
+    int k;
+
+    for (k = 0; k < taps; ++k) {
+        /* Distance of this tap from the output frame, in input frames */
+        const double d = (k - (half - 1.0)) - offset;
+        const double x = d / half;
+        double value = 0.0;
+
+        if (SDL_fabs(x) < 1.0) {
+            const double window = BesselI0(beta * SDL_sqrt(1.0 - x * x)) * scale;
+            const double t = M_PI * cutoff * d;
+            value = (d == 0.0) ? cutoff : (cutoff * SDL_sin(t) / t);
+            value *= window;
+        }
+        row[k] = (float) value;
+        sum += value;
+    }
+
+    /* Make every row pass DC unchanged */
+    if (sum > 0.0) {
+        for (k = 0; k < taps; ++k) {
+            row[k] = (float) (row[k] / sum);
+        }
+    }
+}
+
+static SDL_ResampleFilter *
+CreateResampleFilter(const int quality, const Uint32 num, const Uint32 den)
+{
+    const double ratio = SDL_min(1.0, (double) num / (double) den);
+    const double cutoff = ratio * resampler_quality[quality].rolloff;
+    SDL_ResampleFilter *filter;
+    int taps, phase;
+    size_t offset;
+
+    /* Keep the same number of zero crossings when the cutoff drops below
+       the input Nyquist frequency for downsampling. */
+    taps = (int) SDL_ceil(2.0 * resampler_quality[quality].zero_crossings / ratio);
+    taps = SDL_min((taps + 7) & ~7, RESAMPLER_MAX_TAPS);
+
+    filter = (SDL_ResampleFilter *) SDL_calloc(1, sizeof (*filter));
+    if (!filter) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    filter->quality = quality;
+    filter->num = num;
+    filter->den = den;
+    filter->taps = taps;
+    filter->interpolate = (num > RESAMPLER_MAX_PHASES);
+    filter->phases = filter->interpolate ? RESAMPLER_INTERP_PHASES + 1 : (int) num;
+
+    filter->coefs_base = SDL_malloc(filter->phases * taps * sizeof (float) + 32);
+    if (!filter->coefs_base) {
+        SDL_free(filter);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    offset = ((size_t) filter->coefs_base) & 31;
+    filter->coefs = (float *) (((Uint8 *) filter->coefs_base) + (offset ? (32 - offset) : 0));
+
+    for (phase = 0; phase < filter->phases; ++phase) {
+        const double position = filter->interpolate ?
+            (double) phase / RESAMPLER_INTERP_PHASES : (double) phase / num;
+        FillFilterRow(filter->coefs + phase * taps, taps, position,
+                      cutoff, resampler_quality[quality].beta);
+    }
+    return filter;
+}
+
+static void
+FreeResampleFilter(SDL_ResampleFilter *filter)
+{
+    SDL_free(filter->coefs_base);
+    SDL_free(filter);
+}
+
+static SDL_ResampleFilter *
+AcquireResampleFilter(const int quality, const Uint32 num, const Uint32 den)
+{
+    SDL_ResampleFilter *filter;
+    SDL_ResampleFilter *created;
+
+    SDL_AtomicLock(&filters_lock);
+    for (filter = filters; filter; filter = filter->next) {
+        if (filter->quality == quality && filter->num == num && filter->den == den) {
+            ++filter->refcount;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&filters_lock);
+    if (filter) {
+        return filter;
+    }
+
+    /* Build the table without holding the lock, it takes a while */
+    created = CreateResampleFilter(quality, num, den);
+    if (!created) {
+        return NULL;
+    }
+
+    SDL_AtomicLock(&filters_lock);
+    for (filter = filters; filter; filter = filter->next) {
+        if (filter->quality == quality && filter->num == num && filter->den == den) {
+            break;
+        }
+    }
+    if (!filter) {
+        filter = created;
+        filter->next = filters;
+        filters = filter;
+        created = NULL;
+    }
+    ++filter->refcount;
+    SDL_AtomicUnlock(&filters_lock);
+
+    if (created) {
+        FreeResampleFilter(created);  /* another thread got there first */
+    }
+    return filter;
+}
+
+static void
+ReleaseResampleFilter(SDL_ResampleFilter *filter)
+{
+    SDL_ResampleFilter *unused = NULL;
+    SDL_ResampleFilter *prev = NULL;
+    SDL_ResampleFilter *entry;
+    int idle = 0;
+
+    SDL_AtomicLock(&filters_lock);
+    --filter->refcount;
+    if (filter->refcount == 0) {
+        /* Keep a few unused tables around for the next conversion */
+        for (entry = filters; entry; entry = entry->next) {
+            if (entry->refcount == 0) {
+                ++idle;
+            }
+        }
+        if (idle > RESAMPLER_MAX_IDLE_FILTERS) {
+            for (entry = filters; entry != filter; entry = entry->next) {
+                prev = entry;
+            }
+            if (prev) {
+                prev->next = filter->next;
+            } else {
+                filters = filter->next;
+            }
+            unused = filter;
+        }
+    }
+    SDL_AtomicUnlock(&filters_lock);
+
+    if (unused) {
+        FreeResampleFilter(unused);
+    }
+}
+
+static Uint32
+GreatestCommonDivisor(Uint32 a, Uint32 b)
+{
+    while (b) {
+        const Uint32 t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/* Recover the ratio of the rates from SDL_AudioCVT::rate_incr */
+static void
+GetRateRatio(const double rate_incr, Uint32 *num, Uint32 *den)
+{
+    const Uint32 limit = 1 << 20;
+    Uint32 p0 = 0, q0 = 1, p1 = 1, q1 = 0;
+    double x = rate_incr;
+    int i;
+
+    for (i = 0; i < 32; ++i) {
+        const double a = SDL_floor(x);
+        Uint32 p2, q2;
+
+        if (a > limit || (a * q1 + q0) > limit || (a * p1 + p0) > limit) {
+            break;
+        }
+        p2 = (Uint32) a * p1 + p0;
+        q2 = (Uint32) a * q1 + q0;
+        p0 = p1; q0 = q1;
+        p1 = p2; q1 = q2;
+        if (((double) p1 / (double) q1) == rate_incr || (x - a) < 1e-12) {
+            break;
+        }
+        x = 1.0 / (x - a);
+    }
+    *num = SDL_max(p1, 1);
+    *den = SDL_max(q1, 1);
+}
+
+static SDL_AudioResampler *
+CreateResampler(const int channels, const Uint32 num, const Uint32 den)
+{
+    SDL_AudioResampler *resampler;
+    float *buffer;
+    int i;
+
+    if (channels < 1 || channels > RESAMPLER_MAX_CHANNELS) {
+        SDL_SetError("Unsupported number of channels for resampling");
+        return NULL;
+    }
+
+    resampler = (SDL_AudioResampler *) SDL_calloc(1, sizeof (*resampler));
+    if (!resampler) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    resampler->filter = AcquireResampleFilter(GetResamplerQuality(), num, den);
+    if (!resampler->filter) {
+        SDL_free(resampler);
+        return NULL;
+    }
+    resampler->capacity = resampler->filter->taps + RESAMPLER_CHUNK_FRAMES;
+    buffer = (float *) SDL_malloc(channels * resampler->capacity * sizeof (float));
+    if (!buffer) {
+        ReleaseResampleFilter(resampler->filter);
+        SDL_free(resampler);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    for (i = 0; i < channels; ++i) {
+        resampler->planes[i] = buffer + i * resampler->capacity;
+    }
+
+    resampler->channels = channels;
+    resampler->num = num;
+    resampler->den = den;
+    resampler->step = (int) (den / num);
+    resampler->step_frac = den % num;
+    resampler->dot = ChooseResampleDot();
+    SDL_ResetAudioResampler(resampler);
+    return resampler;
+}
+
+SDL_AudioResampler *
+SDL_NewAudioResampler(const int channels, const int src_rate, const int dst_rate)
+{
+    Uint32 gcd;
+
+    if (src_rate <= 0 || dst_rate <= 0) {
+        SDL_SetError("Invalid rates for resampling");
+        return NULL;
+    }
+    gcd = GreatestCommonDivisor((Uint32) src_rate, (Uint32) dst_rate);
+    return CreateResampler(channels, (Uint32) dst_rate / gcd, (Uint32) src_rate / gcd);
+}
+
+void
+SDL_ResetAudioResampler(SDL_AudioResampler *resampler)
+{
+    const int lead = resampler->filter->taps / 2 - 1;
+    int i;
+
+    /* Pad with silence so the first output frame lines up with the first input frame */
+    for (i = 0; i < resampler->channels; ++i) {
+        SDL_memset(resampler->planes[i], 0, lead * sizeof (float));
+    }
+    resampler->buffered = lead;
+    resampler->pos = 0;
+    resampler->frac = 0;
+}
+
+void
+SDL_FreeAudioResampler(SDL_AudioResampler *resampler)
+{
+    if (resampler) {
+        ReleaseResampleFilter(resampler->filter);
+        SDL_free(resampler->planes[0]);
+        SDL_free(resampler);
+    }
+}
+
+/* Produce output frames until the buffered input runs out, then drop the
+   input frames no later output frame needs. */
+static int
+ResampleBuffered(SDL_AudioResampler *resampler, float *outbuf, const int outframes)
+{
+    const SDL_ResampleFilter *filter = resampler->filter;
+    const SDL_ResampleDotFunc dot = resampler->dot;
+    const int chans = resampler->channels;
+    const int taps = filter->taps;
+    int pos = resampler->pos;
+    Uint32 frac = resampler->frac;
+    int count = 0;
+    int i;
+
+    while (count < outframes && pos + taps <= resampler->buffered) {
+        if (!filter->interpolate) {
+            const float *h = filter->coefs + frac * taps;
+            for (i = 0; i < chans; ++i) {
+                outbuf[i] = dot(resampler->planes[i] + pos, h, taps);
+            }
+        } else {
+            const Uint32 phase = (Uint32) ((((Uint64) frac) * (RESAMPLER_INTERP_PHASES << 16)) / resampler->num);
+            const float *h0 = filter->coefs + (phase >> 16) * taps;
+            const float *h1 = h0 + taps;
+            const float weight = (phase & 0xFFFF) * (1.0f / 65536.0f);
+            for (i = 0; i < chans; ++i) {
+                const float a = dot(resampler->planes[i] + pos, h0, taps);
+                const float b = dot(resampler->planes[i] + pos, h1, taps);
+                outbuf[i] = a + (b - a) * weight;
+            }
+        }
+        outbuf += chans;
+        ++count;
+
+        pos += resampler->step;
+        frac += resampler->step_frac;
+        if (frac >= resampler->num) {
+            frac -= resampler->num;
+            ++pos;
+        }
+    }
+
+    if (pos > 0) {
+        const int dropped = SDL_min(pos, resampler->buffered);
+        const int kept = resampler->buffered - dropped;
+        if (kept > 0) {
+            for (i = 0; i < chans; ++i) {
+                SDL_memmove(resampler->planes[i], resampler->planes[i] + dropped, kept * sizeof (float));
+            }
+        }
+        resampler->buffered = kept;
+        pos -= dropped;
+    }
+    resampler->pos = pos;
+    resampler->frac = frac;
+    return count;
+}
+
+int
+SDL_ResampleAudio(SDL_AudioResampler *resampler, const float *inbuf, int inframes,
+                  float *outbuf, const int outframes)
+{
+    const int chans = resampler->channels;
+    int count = 0;
+    int i, j;
+
+    for (;;) {
+        int frames;
+
+        count += ResampleBuffered(resampler, outbuf + count * chans, outframes - count);
+        if (inframes == 0 || count == outframes) {
+            break;
+        }
+
+        /* Split the next chunk of input into one plane per channel */
+        frames = SDL_min(inframes, resampler->capacity - resampler->buffered);
+        SDL_assert(frames > 0);
+        if (inbuf) {
+            for (i = 0; i < chans; ++i) {
+                float *plane = resampler->planes[i] + resampler->buffered;
+                const float *src = inbuf + i;
+                for (j = 0; j < frames; ++j) {
+                    plane[j] = *src;
+                    src += chans;
+                }
+            }
+            inbuf += frames * chans;
+        } else {
+            for (i = 0; i < chans; ++i) {
+                SDL_memset(resampler->planes[i] + resampler->buffered, 0, frames * sizeof (float));
+            }
+        }
+        resampler->buffered += frames;
+        inframes -= frames;
+    }
+    return count;
+}
+
+SDL_AudioResampler *
+SDL_NewAudioResamplerForRatio(const int channels, const double rate_incr)
+{
+    Uint32 num, den;
+
+    GetRateRatio(rate_incr, &num, &den);
+    return CreateResampler(channels, num, den);
+}
+
+int
+SDL_GetResampledFrames(SDL_AudioResampler *resampler, const int inframes)
+{
+    return (int) (((Sint64) inframes * resampler->num) / resampler->den);
+}
+
+int
+SDL_GetResamplerMaxInput(SDL_AudioResampler *resampler, const int outframes)
+{
+    /* inframes input frames give at most ceil(inframes * num / den) output frames */
+    if (outframes <= 1) {
+        return 0;
+    }
+    return (int) SDL_min(((Sint64) (outframes - 1) * resampler->den) / resampler->num, 0x7FFFFFFF);
+}
+
+int
+SDL_GetResamplerLatency(SDL_AudioResampler *resampler)
+{
+    return resampler->filter->taps / 2;
+}
+
+int
+SDL_ResampleAudioBuffer(const int channels, const double rate_incr,
+                        const float *inbuf, const int inframes,
+                        float *outbuf, const int outframes)
+{
+    SDL_AudioResampler *resampler;
+    int wanted, count;
+
+    resampler = SDL_NewAudioResamplerForRatio(channels, rate_incr);
+    if (!resampler) {
+        return -1;
+    }
+
+    /* Run silence through the filter after the input to get its tail out */
+    wanted = SDL_min(SDL_GetResampledFrames(resampler, inframes), outframes);
+    count = SDL_ResampleAudio(resampler, inbuf, inframes, outbuf, wanted);
+    count += SDL_ResampleAudio(resampler, NULL, SDL_GetResamplerLatency(resampler),
+                               outbuf + count * channels, wanted - count);
+
+    SDL_FreeAudioResampler(resampler);
+    return count;
+}
+
+void
+SDL_QuitAudioResampler(void)
+{
+    SDL_ResampleFilter *filter;
+    SDL_ResampleFilter *prev = NULL;
+    SDL_ResampleFilter *next;
+
+    SDL_AtomicLock(&filters_lock);
+    for (filter = filters; filter; filter = next) {
+        next = filter->next;
+        if (filter->refcount == 0) {
+            if (prev) {
+                prev->next = next;
+            } else {
+                filters = next;
+            }
+            FreeResampleFilter(filter);
+        } else {
+            prev = filter;
+        }
+    }
+    SDL_AtomicUnlock(&filters_lock);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
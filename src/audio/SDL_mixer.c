@@ -26,6 +26,7 @@
 #include "SDL_timer.h"
 #include "SDL_audio.h"
 #include "SDL_sysaudio.h"
+#include "../SDL_simd.h"
 
 /* This table is used to add two sound values together and pin
  * the value to avoid overflow.  (used with permission from ARDI)
@@ -85,6 +86,454 @@ static const Uint8 mix8[] = {
 #define ADJUST_VOLUME(s, v) (s = (s*v)/SDL_MIX_MAXVOLUME)
 #define ADJUST_VOLUME_U8(s, v)  (s = (((s-128)*v)/SDL_MIX_MAXVOLUME)+128)
 
+#if HAVE_SSE2_INTRINSICS || HAVE_AVX2_INTRINSICS || HAVE_NEON_INTRINSICS
+
+/* The vector mixers give the same results as the loops in
+   SDL_MixAudioFormat(): the volume is applied with ADJUST_VOLUME's rounding
+   toward zero and integer sums saturate. They only handle volumes up to
+   SDL_MIX_MAXVOLUME, which is 1 << MIX_VOLUME_BITS. They mix whole vectors
+   and return the number of bytes mixed, the rest is left to the loops in
+   SDL_MixAudioFormat(). 'swap' is set for big endian samples, the vector
+   mixers are only built for little endian CPUs. */
+#define MIX_VOLUME_BITS 7
+
+typedef Uint32 (*SDL_MixVectorsFunc)(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, SDL_bool swap);
+
+typedef struct
+{
+    SDL_MixVectorsFunc S16;
+    SDL_MixVectorsFunc S32;
+    SDL_MixVectorsFunc F32;
+} SDL_MixVectorFuncs;
+
+#endif /* HAVE_SSE2_INTRINSICS || HAVE_AVX2_INTRINSICS || HAVE_NEON_INTRINSICS */
+
+#if HAVE_SSE2_INTRINSICS
+SDL_FORCE_INLINE __m128i
+SDL_MixSwap16_SSE2(const __m128i x)
+{
+    return _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+}
+
+SDL_FORCE_INLINE __m128i
+SDL_MixSwap32_SSE2(const __m128i x)
+{
+    return SDL_MixSwap16_SSE2(_mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+/* Divide 32-bit products by SDL_MIX_MAXVOLUME, rounding toward zero */
+SDL_FORCE_INLINE __m128i
+SDL_MixScaleProducts_SSE2(const __m128i p)
+{
+    const __m128i bias = _mm_and_si128(_mm_srai_epi32(p, 31), _mm_set1_epi32(SDL_MIX_MAXVOLUME - 1));
+    return _mm_srai_epi32(_mm_add_epi32(p, bias), MIX_VOLUME_BITS);
+}
+
+/* s * volume / SDL_MIX_MAXVOLUME is exact in double precision, and the
+   conversion back to integers rounds toward zero */
+SDL_FORCE_INLINE __m128i
+SDL_MixScale32_SSE2(const __m128i s, const __m128d scale)
+{
+    const __m128i lo = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtepi32_pd(s), scale));
+    const __m128i hi = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtepi32_pd(_mm_unpackhi_epi64(s, s)), scale));
+    return _mm_unpacklo_epi64(lo, hi);
+}
+
+/* SSE2 has no saturating 32-bit add: the sum overflowed if both inputs
+   have the same sign and the sum doesn't */
+SDL_FORCE_INLINE __m128i
+SDL_MixAddSaturate32_SSE2(const __m128i a, const __m128i b)
+{
+    const __m128i sum = _mm_add_epi32(a, b);
+    const __m128i overflow = _mm_srai_epi32(_mm_andnot_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, sum)), 31);
+    const __m128i limit = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(0x7FFFFFFF));
+    return _mm_or_si128(_mm_and_si128(overflow, limit), _mm_andnot_si128(overflow, sum));
+}
+
+static Uint32
+SDL_MixS16_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, SDL_bool swap)
+{
+    const __m128i vol = _mm_set1_epi16((Sint16) volume);
+    Uint32 i;
+
+    for (i = 0; i + 16 <= len; i += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i *) (src + i));
+        __m128i d = _mm_loadu_si128((const __m128i *) (dst + i));
+        if (swap) {
+            s = SDL_MixSwap16_SSE2(s);
+            d = SDL_MixSwap16_SSE2(d);
+        }
+        if (volume < SDL_MIX_MAXVOLUME) {
+            const __m128i lo = _mm_mullo_epi16(s, vol);
+            const __m128i hi = _mm_mulhi_epi16(s, vol);
+            s = _mm_packs_epi32(SDL_MixScaleProducts_SSE2(_mm_unpacklo_epi16(lo, hi)),
+                                SDL_MixScaleProducts_SSE2(_mm_unpackhi_epi16(lo, hi)));
+        }
+        d = _mm_adds_epi16(d, s);
+        if (swap) {
+            d = SDL_MixSwap16_SSE2(d);
+        }
+        _mm_storeu_si128((__m128i *) (dst + i), d);
+    }
+    return i;
+}
+
+static Uint32
+SDL_MixS32_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, SDL_bool swap)
+{
+    const __m128d scale = _mm_set1_pd((double) volume / SDL_MIX_MAXVOLUME);
+    Uint32 i;
+
+    for (i = 0; i + 16 <= len; i += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i *) (src + i));
+        __m128i d = _mm_loadu_si128((const __m128i *) (dst + i));
+        if (swap) {
+            s = SDL_MixSwap32_SSE2(s);
+            d = SDL_MixSwap32_SSE2(d);
+        }
+        if (volume < SDL_MIX_MAXVOLUME) {
+            s = SDL_MixScale32_SSE2(s, scale);
+        }
+        d = SDL_MixAddSaturate32_SSE2(d, s);
+        if (swap) {
+            d = SDL_MixSwap32_SSE2(d);
+        }
+        _mm_storeu_si128((__m128i *) (dst + i), d);
+    }
+    return i;
+}
+
+static Uint32
+SDL_MixF32_SSE2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, SDL_bool swap)
+{
+    const __m128 vol = _mm_set1_ps((float) volume / SDL_MIX_MAXVOLUME);
+    const __m128 max_audioval = _mm_set1_ps(3.402823466e+38F);
+    const __m128 min_audioval = _mm_set1_ps(-3.402823466e+38F);
+    Uint32 i;
+
+    for (i = 0; i + 16 <= len; i += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i *) (src + i));
+        __m128i d = _mm_loadu_si128((const __m128i *) (dst + i));
+        __m128 sum;
+        if (swap) {
+            s = SDL_MixSwap32_SSE2(s);
+            d = SDL_MixSwap32_SSE2(d);
+        }
+        if (volume < SDL_MIX_MAXVOLUME) {
+            sum = _mm_add_ps(_mm_castsi128_ps(d), _mm_mul_ps(_mm_castsi128_ps(s), vol));
+        } else {
+            sum = _mm_add_ps(_mm_castsi128_ps(d), _mm_castsi128_ps(s));
+        }
+        /* overflow is clamped like the scalar loop does, NaN goes through */
+        sum = _mm_max_ps(min_audioval, _mm_min_ps(max_audioval, sum));
+        d = _mm_castps_si128(sum);
+        if (swap) {
+            d = SDL_MixSwap32_SSE2(d);
+        }
+        _mm_storeu_si128((__m128i *) (dst + i), d);
+    }
+    return i;
+}
+
+static const SDL_MixVectorFuncs SDL_MixVectors_SSE2 = {
+    SDL_MixS16_SSE2, SDL_MixS32_SSE2, SDL_MixF32_SSE2
+};
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_AVX2_INTRINSICS
+SDL_FORCE_INLINE __m256i SDL_TARGETING_AVX2
+SDL_MixSwap16_AVX2(const __m256i x)
+{
+    const __m256i order = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                           1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    return _mm256_shuffle_epi8(x, order);
+}
+
+SDL_FORCE_INLINE __m256i SDL_TARGETING_AVX2
+SDL_MixSwap32_AVX2(const __m256i x)
+{
+    const __m256i order = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                           3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    return _mm256_shuffle_epi8(x, order);
+}
+
+SDL_FORCE_INLINE __m256i SDL_TARGETING_AVX2
+SDL_MixScaleProducts_AVX2(const __m256i p)
+{
+    const __m256i bias = _mm256_and_si256(_mm256_srai_epi32(p, 31), _mm256_set1_epi32(SDL_MIX_MAXVOLUME - 1));
+    return _mm256_srai_epi32(_mm256_add_epi32(p, bias), MIX_VOLUME_BITS);
+}
+
+SDL_FORCE_INLINE __m256i SDL_TARGETING_AVX2
+SDL_MixScale32_AVX2(const __m256i s, const __m256d scale)
+{
+    const __m128i lo = _mm256_cvttpd_epi32(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(s)), scale));
+    const __m128i hi = _mm256_cvttpd_epi32(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(s, 1)), scale));
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+SDL_FORCE_INLINE __m256i SDL_TARGETING_AVX2
+SDL_MixAddSaturate32_AVX2(const __m256i a, const __m256i b)
+{
+    const __m256i sum = _mm256_add_epi32(a, b);
+    const __m256i overflow = _mm256_srai_epi32(_mm256_andnot_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(a, sum)), 31);
+    const __m256i limit = _mm256_xor_si256(_mm256_srai_epi32(a, 31), _mm256_set1_epi32(0x7FFFFFFF));
+    return _mm256_blendv_epi8(sum, limit, overflow);
+}
+
+static Uint32 SDL_TARGETING_AVX2
+SDL_MixS16_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, SDL_bool swap)
+{
+    const __m256i vol = _mm256_set1_epi16((Sint16) volume);
+    Uint32 i;
+
+    for (i = 0; i + 32 <= len; i += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i *) (src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i *) (dst + i));
+        if (swap) {
+            s = SDL_MixSwap16_AVX2(s);
+            d = SDL_MixSwap16_AVX2(d);
+        }
+        if (volume < SDL_MIX_MAXVOLUME) {
+            /* the unpacks and the pack both work within 128-bit lanes, so
+               the samples come back in order */
+            const __m256i lo = _mm256_mullo_epi16(s, vol);
+            const __m256i hi = _mm256_mulhi_epi16(s, vol);
+            s = _mm256_packs_epi32(SDL_MixScaleProducts_AVX2(_mm256_unpacklo_epi16(lo, hi)),
+                                   SDL_MixScaleProducts_AVX2(_mm256_unpackhi_epi16(lo, hi)));
+        }
+        d = _mm256_adds_epi16(d, s);
+        if (swap) {
+            d = SDL_MixSwap16_AVX2(d);
+        }
+        _mm256_storeu_si256((__m256i *) (dst + i), d);
+    }
+    return i;
+}
+
+static Uint32 SDL_TARGETING_AVX2
+SDL_MixS32_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, SDL_bool swap)
+{
+    const __m256d scale = _mm256_set1_pd((double) volume / SDL_MIX_MAXVOLUME);
+    Uint32 i;
+
+    for (i = 0; i + 32 <= len; i += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i *) (src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i *) (dst + i));
+        if (swap) {
+            s = SDL_MixSwap32_AVX2(s);
+            d = SDL_MixSwap32_AVX2(d);
+        }
+        if (volume < SDL_MIX_MAXVOLUME) {
+            s = SDL_MixScale32_AVX2(s, scale);
+        }
+        d = SDL_MixAddSaturate32_AVX2(d, s);
+        if (swap) {
+            d = SDL_MixSwap32_AVX2(d);
+        }
+        _mm256_storeu_si256((__m256i *) (dst + i), d);
+    }
+    return i;
+}
+
+static Uint32 SDL_TARGETING_AVX2
+SDL_MixF32_AVX2(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, SDL_bool swap)
+{
+    const __m256 vol = _mm256_set1_ps((float) volume / SDL_MIX_MAXVOLUME);
+    const __m256 max_audioval = _mm256_set1_ps(3.402823466e+38F);
+    const __m256 min_audioval = _mm256_set1_ps(-3.402823466e+38F);
+    Uint32 i;
+
+    for (i = 0; i + 32 <= len; i += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i *) (src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i *) (dst + i));
+        __m256 sum;
+        if (swap) {
+            s = SDL_MixSwap32_AVX2(s);
+            d = SDL_MixSwap32_AVX2(d);
+        }
+        if (volume < SDL_MIX_MAXVOLUME) {
+            sum = _mm256_add_ps(_mm256_castsi256_ps(d), _mm256_mul_ps(_mm256_castsi256_ps(s), vol));
+        } else {
+            sum = _mm256_add_ps(_mm256_castsi256_ps(d), _mm256_castsi256_ps(s));
+        }
+        sum = _mm256_max_ps(min_audioval, _mm256_min_ps(max_audioval, sum));
+        d = _mm256_castps_si256(sum);
+        if (swap) {
+            d = SDL_MixSwap32_AVX2(d);
+        }
+        _mm256_storeu_si256((__m256i *) (dst + i), d);
+    }
+    return i;
+}
+
+static const SDL_MixVectorFuncs SDL_MixVectors_AVX2 = {
+    SDL_MixS16_AVX2, SDL_MixS32_AVX2, SDL_MixF32_AVX2
+};
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+static Uint32
+SDL_MixS16_NEON(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, SDL_bool swap)
+{
+    const int16x4_t vol = vdup_n_s16((int16_t) volume);
+    const int32x4_t bias = vdupq_n_s32(SDL_MIX_MAXVOLUME - 1);
+    Uint32 i;
+
+    for (i = 0; i + 16 <= len; i += 16) {
+        uint8x16_t s8 = vld1q_u8(src + i);
+        uint8x16_t d8 = vld1q_u8(dst + i);
+        int16x8_t s, d;
+        if (swap) {
+            s8 = vrev16q_u8(s8);
+            d8 = vrev16q_u8(d8);
+        }
+        s = vreinterpretq_s16_u8(s8);
+        d = vreinterpretq_s16_u8(d8);
+        if (volume < SDL_MIX_MAXVOLUME) {
+            /* divide the products rounding toward zero */
+            int32x4_t lo = vmull_s16(vget_low_s16(s), vol);
+            int32x4_t hi = vmull_s16(vget_high_s16(s), vol);
+            lo = vaddq_s32(lo, vandq_s32(vshrq_n_s32(lo, 31), bias));
+            hi = vaddq_s32(hi, vandq_s32(vshrq_n_s32(hi, 31), bias));
+            s = vcombine_s16(vshrn_n_s32(lo, MIX_VOLUME_BITS), vshrn_n_s32(hi, MIX_VOLUME_BITS));
+        }
+        d8 = vreinterpretq_u8_s16(vqaddq_s16(d, s));
+        if (swap) {
+            d8 = vrev16q_u8(d8);
+        }
+        vst1q_u8(dst + i, d8);
+    }
+    return i;
+}
+
+static Uint32
+SDL_MixS32_NEON(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, SDL_bool swap)
+{
+    const int32x2_t vol = vdup_n_s32(volume);
+    const int64x2_t bias = vdupq_n_s64(SDL_MIX_MAXVOLUME - 1);
+    Uint32 i;
+
+    for (i = 0; i + 16 <= len; i += 16) {
+        uint8x16_t s8 = vld1q_u8(src + i);
+        uint8x16_t d8 = vld1q_u8(dst + i);
+        int32x4_t s, d;
+        if (swap) {
+            s8 = vrev32q_u8(s8);
+            d8 = vrev32q_u8(d8);
+        }
+        s = vreinterpretq_s32_u8(s8);
+        d = vreinterpretq_s32_u8(d8);
+        if (volume < SDL_MIX_MAXVOLUME) {
+            int64x2_t lo = vmull_s32(vget_low_s32(s), vol);
+            int64x2_t hi = vmull_s32(vget_high_s32(s), vol);
+            lo = vaddq_s64(lo, vandq_s64(vshrq_n_s64(lo, 63), bias));
+            hi = vaddq_s64(hi, vandq_s64(vshrq_n_s64(hi, 63), bias));
+            s = vcombine_s32(vshrn_n_s64(lo, MIX_VOLUME_BITS), vshrn_n_s64(hi, MIX_VOLUME_BITS));
+        }
+        d8 = vreinterpretq_u8_s32(vqaddq_s32(d, s));
+        if (swap) {
+            d8 = vrev32q_u8(d8);
+        }
+        vst1q_u8(dst + i, d8);
+    }
+    return i;
+}
+
+static Uint32
+SDL_MixF32_NEON(Uint8 *dst, const Uint8 *src, Uint32 len, int volume, SDL_bool swap)
+{
+    const float vol = (float) volume / SDL_MIX_MAXVOLUME;
+    const float32x4_t max_audioval = vdupq_n_f32(3.402823466e+38F);
+    const float32x4_t min_audioval = vdupq_n_f32(-3.402823466e+38F);
+    Uint32 i;
+
+    for (i = 0; i + 16 <= len; i += 16) {
+        uint8x16_t s8 = vld1q_u8(src + i);
+        uint8x16_t d8 = vld1q_u8(dst + i);
+        float32x4_t s, sum;
+        if (swap) {
+            s8 = vrev32q_u8(s8);
+            d8 = vrev32q_u8(d8);
+        }
+        s = vreinterpretq_f32_u8(s8);
+        if (volume < SDL_MIX_MAXVOLUME) {
+            s = vmulq_n_f32(s, vol);
+        }
+        sum = vaddq_f32(vreinterpretq_f32_u8(d8), s);
+        sum = vmaxq_f32(min_audioval, vminq_f32(max_audioval, sum));
+        d8 = vreinterpretq_u8_f32(sum);
+        if (swap) {
+            d8 = vrev32q_u8(d8);
+        }
+        vst1q_u8(dst + i, d8);
+    }
+    return i;
+}
+
+static const SDL_MixVectorFuncs SDL_MixVectors_NEON = {
+    SDL_MixS16_NEON, SDL_MixS32_NEON, SDL_MixF32_NEON
+};
+#endif /* HAVE_NEON_INTRINSICS */
+
+#if HAVE_SSE2_INTRINSICS || HAVE_AVX2_INTRINSICS || HAVE_NEON_INTRINSICS
+static const SDL_MixVectorFuncs *
+ChooseMixVectors(void)
+{
+    static const SDL_MixVectorFuncs none = { NULL, NULL, NULL };
+
+#if HAVE_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return &SDL_MixVectors_AVX2;
+    }
+#endif
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return &SDL_MixVectors_SSE2;
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return &SDL_MixVectors_NEON;
+    }
+#endif
+    return &none;
+}
+
+/* Mix the start of the buffers with vectors, returns the number of bytes mixed */
+static Uint32
+SDL_MixVectors(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
+               Uint32 len, int volume)
+{
+    static const SDL_MixVectorFuncs *funcs = NULL;
+    const SDL_bool swap = SDL_AUDIO_ISBIGENDIAN(format) ? SDL_TRUE : SDL_FALSE;
+    SDL_MixVectorsFunc func;
+
+    if (!funcs) {
+        funcs = ChooseMixVectors();
+    }
+
+    switch (format) {
+    case AUDIO_S16LSB:
+    case AUDIO_S16MSB:
+        func = funcs->S16;
+        break;
+    case AUDIO_S32LSB:
+    case AUDIO_S32MSB:
+        func = funcs->S32;
+        break;
+    case AUDIO_F32LSB:
+    case AUDIO_F32MSB:
+        func = funcs->F32;
+        break;
+    default:
+        func = NULL;
+        break;
+    }
+    return func ? func(dst, src, len, volume, swap) : 0;
+}
+#endif /* HAVE_SSE2_INTRINSICS || HAVE_AVX2_INTRINSICS || HAVE_NEON_INTRINSICS */
+
 
 void
 SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
@@ -94,6 +543,15 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
         return;
     }
 
+#if HAVE_SSE2_INTRINSICS || HAVE_AVX2_INTRINSICS || HAVE_NEON_INTRINSICS
+    if (volume > 0 && volume <= SDL_MIX_MAXVOLUME) {
+        const Uint32 mixed = SDL_MixVectors(dst, src, format, len, volume);
+        dst += mixed;
+        src += mixed;
+        len -= mixed;
+    }
+#endif
+
     switch (format) {
 
     case AUDIO_U8:
@@ -304,8 +762,7 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
 
     case AUDIO_F32LSB:
         {
-            const float fmaxvolume = 1.0f / ((float) SDL_MIX_MAXVOLUME);
-            const float fvolume = (float) volume;
+            const float fvolume = ((float) volume) / SDL_MIX_MAXVOLUME;
             const float *src32 = (float *) src;
             float *dst32 = (float *) dst;
             float src1, src2;
@@ -316,7 +773,7 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
 
             len /= 4;
             while (len--) {
-                src1 = ((SDL_SwapFloatLE(*src32) * fvolume) * fmaxvolume);
+                src1 = SDL_SwapFloatLE(*src32) * fvolume;
                 src2 = SDL_SwapFloatLE(*dst32);
                 src32++;
 
@@ -333,8 +790,7 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
 
     case AUDIO_F32MSB:
         {
-            const float fmaxvolume = 1.0f / ((float) SDL_MIX_MAXVOLUME);
-            const float fvolume = (float) volume;
+            const float fvolume = ((float) volume) / SDL_MIX_MAXVOLUME;
             const float *src32 = (float *) src;
             float *dst32 = (float *) dst;
             float src1, src2;
@@ -345,7 +801,7 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
 
             len /= 4;
             while (len--) {
-                src1 = ((SDL_SwapFloatBE(*src32) * fvolume) * fmaxvolume);
+                src1 = SDL_SwapFloatBE(*src32) * fvolume;
                 src2 = SDL_SwapFloatBE(*dst32);
                 src32++;
 
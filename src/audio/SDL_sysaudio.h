@@ -26,6 +26,7 @@
 #include "SDL_mutex.h"
 #include "SDL_thread.h"
 #include "../SDL_dataqueue.h"
+#include "../SDL_ringbuffer.h"
 #include "./SDL_audio_c.h"
 
 /* !!! FIXME: These are wordy and unlocalized... */
@@ -62,6 +63,12 @@ extern void SDL_OpenedAudioDeviceDisconnected(SDL_AudioDevice *device);
    The system preallocates enough packets for 2 callbacks' worth of data. */
 #define SDL_AUDIOBUFFERQUEUE_PACKETLEN (8 * 1024)
 
+/* Queued playback goes through a lock-free ring that the audio thread reads
+   without taking a lock, so an app queueing audio never holds it up. The
+   ring holds this many callbacks' worth of data; anything queued beyond
+   that waits in the packet queue and moves into the ring as it drains. */
+#define SDL_AUDIOBUFFERQUEUE_RINGCALLBACKS 16
+
 typedef struct SDL_AudioDriverImpl
 {
     void (*DetectDevices) (void);
@@ -160,8 +167,12 @@ struct SDL_AudioDevice
     SDL_Thread *thread;
     SDL_threadID threadid;
 
-    /* Queued buffers (if app not using callback). */
+    /* Queued buffers (if app not using callback). For playback, the audio
+       thread reads buffer_ring, and buffer_queue holds what didn't fit in
+       it, guarded by queue_lock, which the audio thread only ever tries. */
     SDL_DataQueue *buffer_queue;
+    SDL_RingBuffer *buffer_ring;
+    SDL_mutex *queue_lock;
 
     /* * * */
     /* Data private to this driver */
@@ -635,3 +635,39 @@
 #define SDL_Vulkan_GetInstanceExtensions SDL_Vulkan_GetInstanceExtensions_REAL
 #define SDL_Vulkan_CreateSurface SDL_Vulkan_CreateSurface_REAL
 #define SDL_Vulkan_GetDrawableSize SDL_Vulkan_GetDrawableSize_REAL
+#define SDL_RenderFlush SDL_RenderFlush_REAL
+#define SDL_RenderGeometry SDL_RenderGeometry_REAL
+#define SDL_GetRendererStats SDL_GetRendererStats_REAL
+#define SDL_SetYUVConversionMode SDL_SetYUVConversionMode_REAL
+#define SDL_GetYUVConversionMode SDL_GetYUVConversionMode_REAL
+#define SDL_GetYUVConversionModeForResolution SDL_GetYUVConversionModeForResolution_REAL
+#define SDL_PremultiplyAlpha SDL_PremultiplyAlpha_REAL
+#define SDL_PremultiplySurfaceAlpha SDL_PremultiplySurfaceAlpha_REAL
+#define SDL_CreateRGBSurfaceWithFormatShared SDL_CreateRGBSurfaceWithFormatShared_REAL
+#define SDL_CreateRGBSurfaceWithFormatFromFD SDL_CreateRGBSurfaceWithFormatFromFD_REAL
+#define SDL_GetSurfaceSharedFD SDL_GetSurfaceSharedFD_REAL
+#define SDL_LoadBMPWithFormat_RW SDL_LoadBMPWithFormat_RW_REAL
+#define SDL_CreateRegion SDL_CreateRegion_REAL
+#define SDL_FreeRegion SDL_FreeRegion_REAL
+#define SDL_ClearRegion SDL_ClearRegion_REAL
+#define SDL_UnionRegion SDL_UnionRegion_REAL
+#define SDL_UnionRegionRects SDL_UnionRegionRects_REAL
+#define SDL_IntersectRegion SDL_IntersectRegion_REAL
+#define SDL_IntersectRegionRect SDL_IntersectRegionRect_REAL
+#define SDL_SubtractRegion SDL_SubtractRegion_REAL
+#define SDL_SubtractRegionRect SDL_SubtractRegionRect_REAL
+#define SDL_TranslateRegion SDL_TranslateRegion_REAL
+#define SDL_GetRegionRects SDL_GetRegionRects_REAL
+#define SDL_GetRegionBounds SDL_GetRegionBounds_REAL
+#define SDL_CreateAudioMixer SDL_CreateAudioMixer_REAL
+#define SDL_FreeAudioMixer SDL_FreeAudioMixer_REAL
+#define SDL_MixAudioVoices SDL_MixAudioVoices_REAL
+#define SDL_AudioMixerCallback SDL_AudioMixerCallback_REAL
+#define SDL_AddAudioVoice SDL_AddAudioVoice_REAL
+#define SDL_RemoveAudioVoice SDL_RemoveAudioVoice_REAL
+#define SDL_PutAudioVoiceData SDL_PutAudioVoiceData_REAL
+#define SDL_GetAudioVoiceQueuedFrames SDL_GetAudioVoiceQueuedFrames_REAL
+#define SDL_ClearAudioVoice SDL_ClearAudioVoice_REAL
+#define SDL_SetAudioVoiceGain SDL_SetAudioVoiceGain_REAL
+#define SDL_SetAudioVoicePan SDL_SetAudioVoicePan_REAL
+#define SDL_PauseAudioVoice SDL_PauseAudioVoice_REAL
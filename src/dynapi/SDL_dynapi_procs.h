@@ -669,3 +669,39 @@ SDL_DYNAPI_PROC(void,SDL_Vulkan_UnloadLibrary,(void),(),)
 SDL_DYNAPI_PROC(SDL_bool,SDL_Vulkan_GetInstanceExtensions,(SDL_Window *a, unsigned int *b, const char **c),(a,b,c),return)
 SDL_DYNAPI_PROC(SDL_bool,SDL_Vulkan_CreateSurface,(SDL_Window *a, VkInstance b, VkSurfaceKHR *c),(a,b,c),return)
 SDL_DYNAPI_PROC(void,SDL_Vulkan_GetDrawableSize,(SDL_Window *a, int *b, int *c),(a,b,c),)
+SDL_DYNAPI_PROC(int,SDL_RenderFlush,(SDL_Renderer *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_RenderGeometry,(SDL_Renderer *a, SDL_Texture *b, const SDL_Vertex *c, int d, const int *e, int f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_GetRendererStats,(SDL_Renderer *a, SDL_RendererStats *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_SetYUVConversionMode,(SDL_YUV_CONVERSION_MODE a),(a),)
+SDL_DYNAPI_PROC(SDL_YUV_CONVERSION_MODE,SDL_GetYUVConversionMode,(void),(),return)
+SDL_DYNAPI_PROC(SDL_YUV_CONVERSION_MODE,SDL_GetYUVConversionModeForResolution,(int a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_PremultiplyAlpha,(int a, int b, Uint32 c, const void *d, int e, Uint32 f, void *g, int h),(a,b,c,d,e,f,g,h),return)
+SDL_DYNAPI_PROC(int,SDL_PremultiplySurfaceAlpha,(SDL_Surface *a),(a),return)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_CreateRGBSurfaceWithFormatShared,(Uint32 a, int b, int c, int d, Uint32 e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_CreateRGBSurfaceWithFormatFromFD,(int a, int b, int c, int d, int e, Uint32 f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_GetSurfaceSharedFD,(SDL_Surface *a),(a),return)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_LoadBMPWithFormat_RW,(SDL_RWops *a, int b, Uint32 c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_Region*,SDL_CreateRegion,(void),(),return)
+SDL_DYNAPI_PROC(void,SDL_FreeRegion,(SDL_Region *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_ClearRegion,(SDL_Region *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_UnionRegion,(SDL_Region *a, const SDL_Region *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_UnionRegionRects,(SDL_Region *a, const SDL_Rect *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_IntersectRegion,(SDL_Region *a, const SDL_Region *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_IntersectRegionRect,(SDL_Region *a, const SDL_Rect *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_SubtractRegion,(SDL_Region *a, const SDL_Region *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_SubtractRegionRect,(SDL_Region *a, const SDL_Rect *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_TranslateRegion,(SDL_Region *a, int b, int c),(a,b,c),)
+SDL_DYNAPI_PROC(const SDL_Rect*,SDL_GetRegionRects,(const SDL_Region *a, int *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_GetRegionBounds,(const SDL_Region *a, SDL_Rect *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_AudioMixer*,SDL_CreateAudioMixer,(SDL_AudioFormat a, Uint8 b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_FreeAudioMixer,(SDL_AudioMixer *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_MixAudioVoices,(SDL_AudioMixer *a, Uint8 *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_AudioMixerCallback,(void *a, Uint8 *b, int c),(a,b,c),)
+SDL_DYNAPI_PROC(SDL_AudioVoice*,SDL_AddAudioVoice,(SDL_AudioMixer *a, SDL_AudioFormat b, Uint8 c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(void,SDL_RemoveAudioVoice,(SDL_AudioVoice *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_PutAudioVoiceData,(SDL_AudioVoice *a, const void *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_GetAudioVoiceQueuedFrames,(SDL_AudioVoice *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_ClearAudioVoice,(SDL_AudioVoice *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_SetAudioVoiceGain,(SDL_AudioVoice *a, float b),(a,b),)
+SDL_DYNAPI_PROC(void,SDL_SetAudioVoicePan,(SDL_AudioVoice *a, float b),(a,b),)
+SDL_DYNAPI_PROC(void,SDL_PauseAudioVoice,(SDL_AudioVoice *a, int b),(a,b),)
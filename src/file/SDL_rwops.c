@@ -40,12 +40,21 @@
 #include <limits.h>
 #endif
 
+#if defined(HAVE_STDIO_H) && \
+    (defined(__LINUX__) || defined(__MACOSX__) || defined(__FREEBSD__) || \
+     defined(__NETBSD__) || defined(__OPENBSD__))
+#define HAVE_RWOPS_MMAP 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 /* This file provides a general interface for SDL to read and write
    data sources.  It can easily be extended to files, memory, etc.
 */
 
 #include "SDL_endian.h"
 #include "SDL_rwops.h"
+#include "SDL_rwops_c.h"
 
 #ifdef __APPLE__
 #include "cocoa/SDL_rwopsbundlesupport.h"
@@ -751,6 +760,52 @@ done:
     return data;
 }
 
+/* Get the rest of a stream without copying it, only the streams made here
+   are known to hold their data in memory or in a regular file */
+int
+SDL_RWmap(SDL_RWops * context, SDL_RWmapping * map)
+{
+    SDL_zerop(map);
+
+    if (context->read == mem_read) {
+        map->data = context->hidden.mem.here;
+        map->size = (size_t) (context->hidden.mem.stop - context->hidden.mem.here);
+        return 0;
+    }
+#if HAVE_RWOPS_MMAP
+    if (context->read == stdio_read) {
+        const Sint64 offset = SDL_RWtell(context);
+        const int fd = fileno(context->hidden.stdio.fp);
+        struct stat st;
+
+        if (offset >= 0 && fd >= 0 && fstat(fd, &st) == 0 &&
+            S_ISREG(st.st_mode) && st.st_size > offset &&
+            (Uint64) st.st_size <= (Uint64) ((size_t) -1)) {
+            void *mapping = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                map->mapping = mapping;
+                map->mapping_size = (size_t) st.st_size;
+                map->data = (const Uint8 *) mapping + offset;
+                map->size = (size_t) (st.st_size - offset);
+                return 0;
+            }
+        }
+    }
+#endif
+    return -1;
+}
+
+void
+SDL_RWunmap(SDL_RWmapping * map)
+{
+#if HAVE_RWOPS_MMAP
+    if (map->mapping) {
+        munmap(map->mapping, map->mapping_size);
+    }
+#endif
+    SDL_zerop(map);
+}
+
 /* Functions for dynamically reading and writing endian-specific values */
 
 Uint8
@@ -0,0 +1,45 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#ifndef SDL_rwops_c_h_
+#define SDL_rwops_c_h_
+
+#include "SDL_rwops.h"
+
+/* The rest of a stream from its position, in memory without a copy */
+typedef struct SDL_RWmapping
+{
+    const Uint8 *data;
+    size_t size;
+    void *mapping;          /* the file mapping to release, if any */
+    size_t mapping_size;
+} SDL_RWmapping;
+
+/* Get the rest of a memory stream or of a regular file without reading it.
+   The stream position doesn't change.  Returns -1 for other streams, which
+   have to be read instead, this doesn't set an error. */
+extern int SDL_RWmap(SDL_RWops * context, SDL_RWmapping * map);
+extern void SDL_RWunmap(SDL_RWmapping * map);
+
+#endif /* SDL_rwops_c_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
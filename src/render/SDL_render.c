@@ -25,6 +25,7 @@
 #include "SDL_assert.h"
 #include "SDL_hints.h"
 #include "SDL_log.h"
+#include "SDL_timer.h"
 #include "SDL_render.h"
 #include "SDL_sysrender.h"
 #include "software/SDL_render_sw_c.h"
@@ -68,6 +69,10 @@
     SDL_COMPOSE_BLENDMODE(SDL_BLENDFACTOR_SRC_ALPHA, SDL_BLENDFACTOR_ONE, SDL_BLENDOPERATION_ADD, \
                           SDL_BLENDFACTOR_ZERO, SDL_BLENDFACTOR_ONE, SDL_BLENDOPERATION_ADD)
 
+#define SDL_BLENDMODE_BLEND_PREMULTIPLIED_FULL \
+    SDL_COMPOSE_BLENDMODE(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD, \
+                          SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD)
+
 #define SDL_BLENDMODE_MOD_FULL \
     SDL_COMPOSE_BLENDMODE(SDL_BLENDFACTOR_ZERO, SDL_BLENDFACTOR_SRC_COLOR, SDL_BLENDOPERATION_ADD, \
                           SDL_BLENDFACTOR_ZERO, SDL_BLENDFACTOR_ONE, SDL_BLENDOPERATION_ADD)
@@ -104,6 +109,419 @@ static char texture_magic;
 
 static int UpdateLogicalSize(SDL_Renderer *renderer);
 
+static void
+CountDrawCall(SDL_Renderer *renderer, int primitives)
+{
+    renderer->stats.draw_calls++;
+    renderer->stats.primitives += primitives;
+    if (!renderer->batching) {
+        renderer->stats.backend_draws++;
+    }
+}
+
+static void
+CountTextureUpload(SDL_Renderer *renderer, Uint32 format, int w, int h)
+{
+    Uint64 size;
+
+    switch (format) {
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        /* A full size Y plane and two quarter size chroma planes */
+        size = (Uint64) w * h + 2 * (Uint64) ((w + 1) / 2) * ((h + 1) / 2);
+        break;
+    default:
+        size = (Uint64) w * h * SDL_BYTESPERPIXEL(format);
+        break;
+    }
+    renderer->stats.texture_uploads++;
+    renderer->stats.texture_bytes += size;
+}
+
+static int
+FlushRenderCommands(SDL_Renderer *renderer)
+{
+    int retval;
+
+    if (renderer->num_render_commands == 0) {
+        return 0;
+    }
+
+    retval = renderer->RunCommandQueue(renderer, renderer->render_commands,
+                                       renderer->num_render_commands,
+                                       renderer->vertex_data,
+                                       renderer->vertex_data_used);
+    renderer->stats.batches++;
+
+    /* Move the whole queue to the start of the buffers for reuse */
+    renderer->num_render_commands = 0;
+    renderer->vertex_data_used = 0;
+    renderer->render_command_generation++;
+    return retval;
+}
+
+static int
+FlushRenderCommandsIfTextureNeeded(SDL_Texture *texture)
+{
+    SDL_Renderer *renderer = texture->renderer;
+    if (texture->last_command_generation == renderer->render_command_generation) {
+        /* the current command queue depends on this texture, flush the queue now before it changes */
+        return FlushRenderCommands(renderer);
+    }
+    return 0;
+}
+
+static SDL_RenderCommand *
+AllocateRenderCommand(SDL_Renderer *renderer)
+{
+    if (renderer->num_render_commands == renderer->max_render_commands) {
+        const int newmax = renderer->max_render_commands ? (renderer->max_render_commands * 2) : 64;
+        SDL_RenderCommand *ptr = (SDL_RenderCommand *) SDL_realloc(renderer->render_commands, newmax * sizeof (*ptr));
+        if (!ptr) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        renderer->render_commands = ptr;
+        renderer->max_render_commands = newmax;
+    }
+    return &renderer->render_commands[renderer->num_render_commands++];
+}
+
+static void *
+AllocateVertexData(SDL_Renderer *renderer, size_t numbytes, size_t alignment, size_t *offset)
+{
+    const size_t first = (renderer->vertex_data_used + (alignment - 1)) & ~(alignment - 1);
+    const size_t needed = first + numbytes;
+
+    if (needed > renderer->vertex_data_allocation) {
+        size_t newsize = renderer->vertex_data_allocation ? renderer->vertex_data_allocation : 1024;
+        void *ptr;
+
+        while (newsize < needed) {
+            newsize *= 2;
+        }
+        ptr = SDL_realloc(renderer->vertex_data, newsize);
+        if (!ptr) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        renderer->vertex_data = ptr;
+        renderer->vertex_data_allocation = newsize;
+    }
+
+    *offset = first;
+    renderer->vertex_data_used = needed;
+    return (Uint8 *) renderer->vertex_data + first;
+}
+
+static int
+PushViewportCommand(SDL_Renderer *renderer)
+{
+    SDL_RenderCommand *cmd = AllocateRenderCommand(renderer);
+    if (!cmd) {
+        return -1;
+    }
+    cmd->command = SDL_RENDERCMD_SETVIEWPORT;
+    cmd->data.viewport.rect = renderer->viewport;
+    return 0;
+}
+
+static int
+PushClipRectCommand(SDL_Renderer *renderer)
+{
+    SDL_RenderCommand *cmd = AllocateRenderCommand(renderer);
+    if (!cmd) {
+        return -1;
+    }
+    cmd->command = SDL_RENDERCMD_SETCLIPRECT;
+    cmd->data.cliprect.enabled = renderer->clipping_enabled;
+    cmd->data.cliprect.rect = renderer->clip_rect;
+    return 0;
+}
+
+static int
+QueueCmdSetViewport(SDL_Renderer *renderer)
+{
+    if (renderer->num_render_commands == 0) {
+        return renderer->UpdateViewport(renderer);
+    }
+    return PushViewportCommand(renderer);
+}
+
+static int
+QueueCmdSetClipRect(SDL_Renderer *renderer)
+{
+    if (renderer->num_render_commands == 0) {
+        return renderer->UpdateClipRect(renderer);
+    }
+    return PushClipRectCommand(renderer);
+}
+
+static int
+PrepareCommandQueue(SDL_Renderer *renderer)
+{
+    if (renderer->num_render_commands == 0) {
+        /* Every batch starts out with the complete drawing state, since the
+           driver state may have been changed directly while the queue was empty */
+        if (PushViewportCommand(renderer) < 0 || PushClipRectCommand(renderer) < 0) {
+            renderer->num_render_commands = 0;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void *
+QueueDrawCommand(SDL_Renderer *renderer, SDL_RenderCommandType type, SDL_Texture *texture,
+                 Uint8 r, Uint8 g, Uint8 b, Uint8 a, SDL_BlendMode blend,
+                 size_t elemsize, int count)
+{
+    SDL_RenderCommand *cmd;
+    size_t first;
+    void *data;
+
+    if (PrepareCommandQueue(renderer) < 0) {
+        return NULL;
+    }
+
+    if (texture) {
+        texture->last_command_generation = renderer->render_command_generation;
+    }
+
+    /* Append to the previous command if it draws with the same state and its
+       data is at the end of the vertex buffer. Line strips are never merged,
+       that would connect separate strips. */
+    cmd = &renderer->render_commands[renderer->num_render_commands - 1];
+    if (cmd->command == type && type != SDL_RENDERCMD_DRAW_LINES &&
+        cmd->data.draw.texture == texture && cmd->data.draw.blend == blend &&
+        cmd->data.draw.r == r && cmd->data.draw.g == g &&
+        cmd->data.draw.b == b && cmd->data.draw.a == a &&
+        cmd->data.draw.first + (cmd->data.draw.count * elemsize) == renderer->vertex_data_used) {
+        data = AllocateVertexData(renderer, count * elemsize, 1, &first);
+        if (data) {
+            cmd->data.draw.count += count;
+        }
+        return data;
+    }
+
+    cmd = AllocateRenderCommand(renderer);
+    if (!cmd) {
+        return NULL;
+    }
+    data = AllocateVertexData(renderer, count * elemsize, sizeof (double), &first);
+    if (!data) {
+        renderer->num_render_commands--;
+        return NULL;
+    }
+    renderer->stats.backend_draws++;
+    cmd->command = type;
+    cmd->data.draw.first = first;
+    cmd->data.draw.count = count;
+    cmd->data.draw.r = r;
+    cmd->data.draw.g = g;
+    cmd->data.draw.b = b;
+    cmd->data.draw.a = a;
+    cmd->data.draw.blend = blend;
+    cmd->data.draw.texture = texture;
+    return data;
+}
+
+static int
+QueueCmdClear(SDL_Renderer *renderer)
+{
+    SDL_RenderCommand *cmd;
+
+    CountDrawCall(renderer, 0);
+    if (!renderer->batching) {
+        return renderer->RenderClear(renderer);
+    }
+
+    if (PrepareCommandQueue(renderer) < 0) {
+        return -1;
+    }
+    cmd = AllocateRenderCommand(renderer);
+    if (!cmd) {
+        return -1;
+    }
+    renderer->stats.backend_draws++;
+    cmd->command = SDL_RENDERCMD_CLEAR;
+    cmd->data.color.r = renderer->r;
+    cmd->data.color.g = renderer->g;
+    cmd->data.color.b = renderer->b;
+    cmd->data.color.a = renderer->a;
+    return 0;
+}
+
+static int
+QueueCmdDrawPoints(SDL_Renderer *renderer, const SDL_FPoint *points, int count)
+{
+    SDL_FPoint *verts;
+
+    CountDrawCall(renderer, count);
+    if (!renderer->batching) {
+        return renderer->RenderDrawPoints(renderer, points, count);
+    }
+
+    verts = (SDL_FPoint *) QueueDrawCommand(renderer, SDL_RENDERCMD_DRAW_POINTS, NULL,
+                                            renderer->r, renderer->g, renderer->b, renderer->a,
+                                            renderer->blendMode, sizeof (*verts), count);
+    if (!verts) {
+        return -1;
+    }
+    SDL_memcpy(verts, points, count * sizeof (*verts));
+    return 0;
+}
+
+static int
+QueueCmdDrawLines(SDL_Renderer *renderer, const SDL_FPoint *points, int count)
+{
+    SDL_FPoint *verts;
+
+    CountDrawCall(renderer, SDL_max(count - 1, 0));
+    if (!renderer->batching) {
+        return renderer->RenderDrawLines(renderer, points, count);
+    }
+
+    verts = (SDL_FPoint *) QueueDrawCommand(renderer, SDL_RENDERCMD_DRAW_LINES, NULL,
+                                            renderer->r, renderer->g, renderer->b, renderer->a,
+                                            renderer->blendMode, sizeof (*verts), count);
+    if (!verts) {
+        return -1;
+    }
+    SDL_memcpy(verts, points, count * sizeof (*verts));
+    return 0;
+}
+
+static int
+QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, int count)
+{
+    SDL_FRect *verts;
+
+    CountDrawCall(renderer, count);
+    if (!renderer->batching) {
+        return renderer->RenderFillRects(renderer, rects, count);
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    verts = (SDL_FRect *) QueueDrawCommand(renderer, SDL_RENDERCMD_FILL_RECTS, NULL,
+                                           renderer->r, renderer->g, renderer->b, renderer->a,
+                                           renderer->blendMode, sizeof (*verts), count);
+    if (!verts) {
+        return -1;
+    }
+    SDL_memcpy(verts, rects, count * sizeof (*verts));
+    return 0;
+}
+
+static int
+QueueCmdCopy(SDL_Renderer *renderer, SDL_Texture *texture,
+             const SDL_Rect *srcrect, const SDL_FRect *dstrect)
+{
+    SDL_RenderCopyData *verts;
+
+    CountDrawCall(renderer, 1);
+    if (!renderer->batching) {
+        return renderer->RenderCopy(renderer, texture, srcrect, dstrect);
+    }
+
+    verts = (SDL_RenderCopyData *) QueueDrawCommand(renderer, SDL_RENDERCMD_COPY, texture,
+                                                    texture->r, texture->g, texture->b, texture->a,
+                                                    texture->blendMode, sizeof (*verts), 1);
+    if (!verts) {
+        return -1;
+    }
+    verts->srcrect = *srcrect;
+    verts->dstrect = *dstrect;
+    return 0;
+}
+
+static int
+QueueCmdCopyEx(SDL_Renderer *renderer, SDL_Texture *texture,
+               const SDL_Rect *srcrect, const SDL_FRect *dstrect,
+               const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip)
+{
+    SDL_RenderCopyExData *verts;
+
+    CountDrawCall(renderer, 1);
+    if (!renderer->batching) {
+        return renderer->RenderCopyEx(renderer, texture, srcrect, dstrect, angle, center, flip);
+    }
+
+    verts = (SDL_RenderCopyExData *) QueueDrawCommand(renderer, SDL_RENDERCMD_COPY_EX, texture,
+                                                      texture->r, texture->g, texture->b, texture->a,
+                                                      texture->blendMode, sizeof (*verts), 1);
+    if (!verts) {
+        return -1;
+    }
+    verts->srcrect = *srcrect;
+    verts->dstrect = *dstrect;
+    verts->angle = angle;
+    verts->center = *center;
+    verts->flip = flip;
+    return 0;
+}
+
+static int
+QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
+                 const SDL_Vertex *vertices, int num_vertices,
+                 const int *indices, int num_indices)
+{
+    const float scale_x = renderer->scale.x;
+    const float scale_y = renderer->scale.y;
+    const int count = indices ? num_indices : num_vertices;
+    SDL_Vertex *verts;
+    int i;
+
+    CountDrawCall(renderer, count / 3);
+    if (!renderer->batching) {
+        int retval;
+
+        if (scale_x == 1.0f && scale_y == 1.0f) {
+            return renderer->RenderGeometry(renderer, texture, vertices, num_vertices,
+                                            indices, num_indices);
+        }
+
+        verts = (SDL_Vertex *) SDL_malloc(num_vertices * sizeof (*verts));
+        if (!verts) {
+            return SDL_OutOfMemory();
+        }
+        for (i = 0; i < num_vertices; ++i) {
+            verts[i] = vertices[i];
+            verts[i].x *= scale_x;
+            verts[i].y *= scale_y;
+        }
+        retval = renderer->RenderGeometry(renderer, texture, verts, num_vertices,
+                                          indices, num_indices);
+        SDL_free(verts);
+        return retval;
+    }
+
+    /* The queued copy is a plain triangle list, so consecutive meshes with
+       the same texture and state end up in a single command. */
+    if (texture) {
+        verts = (SDL_Vertex *) QueueDrawCommand(renderer, SDL_RENDERCMD_GEOMETRY, texture,
+                                                texture->r, texture->g, texture->b, texture->a,
+                                                texture->blendMode, sizeof (*verts), count);
+    } else {
+        verts = (SDL_Vertex *) QueueDrawCommand(renderer, SDL_RENDERCMD_GEOMETRY, NULL,
+                                                255, 255, 255, 255,
+                                                renderer->blendMode, sizeof (*verts), count);
+    }
+    if (!verts) {
+        return -1;
+    }
+    for (i = 0; i < count; ++i, ++verts) {
+        *verts = vertices[indices ? indices[i] : i];
+        verts->x *= scale_x;
+        verts->y *= scale_y;
+    }
+    return 0;
+}
+
 int
 SDL_GetNumRenderDrivers(void)
 {
@@ -137,6 +555,11 @@ SDL_RendererEventWatch(void *userdata, SDL_Event *event)
     if (event->type == SDL_WINDOWEVENT) {
         SDL_Window *window = SDL_GetWindowFromID(event->window.windowID);
         if (window == renderer->window) {
+            if (event->window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+                /* Queued commands were recorded for the old output size */
+                FlushRenderCommands(renderer);
+            }
+
             if (renderer->WindowEvent) {
                 renderer->WindowEvent(renderer, &event->window);
             }
@@ -170,7 +593,7 @@ SDL_RendererEventWatch(void *userdata, SDL_Event *event)
                         renderer->viewport.y = 0;
                         renderer->viewport.w = w;
                         renderer->viewport.h = h;
-                        renderer->UpdateViewport(renderer);
+                        QueueCmdSetViewport(renderer);
                     }
                 }
 
@@ -335,6 +758,11 @@ SDL_CreateRenderer(SDL_Window * window, int index, Uint32 flags)
             renderer->hidden = SDL_FALSE;
         }
 
+        /* The driver may have turned batching on already if it depends on it */
+        if (renderer->RunCommandQueue && !renderer->batching) {
+            renderer->batching = SDL_GetHintBoolean(SDL_HINT_RENDER_BATCHING, SDL_FALSE);
+        }
+
         SDL_SetWindowData(window, SDL_WINDOWRENDERDATA, renderer);
 
         SDL_RenderSetViewport(renderer, NULL);
@@ -364,6 +792,11 @@ SDL_CreateSoftwareRenderer(SDL_Surface * surface)
         renderer->scale.x = 1.0f;
         renderer->scale.y = 1.0f;
 
+        /* The driver may have turned batching on already if it depends on it */
+        if (renderer->RunCommandQueue && !renderer->batching) {
+            renderer->batching = SDL_GetHintBoolean(SDL_HINT_RENDER_BATCHING, SDL_FALSE);
+        }
+
         SDL_RenderSetViewport(renderer, NULL);
     }
     return renderer;
@@ -673,6 +1106,9 @@ SDL_SetTextureColorMod(SDL_Texture * texture, Uint8 r, Uint8 g, Uint8 b)
     CHECK_TEXTURE_MAGIC(texture, -1);
 
     renderer = texture->renderer;
+    if (!texture->native && (r != texture->r || g != texture->g || b != texture->b)) {
+        renderer->stats.state_changes++;
+    }
     if (r < 255 || g < 255 || b < 255) {
         texture->modMode |= SDL_TEXTUREMODULATE_COLOR;
     } else {
@@ -716,6 +1152,9 @@ SDL_SetTextureAlphaMod(SDL_Texture * texture, Uint8 alpha)
     CHECK_TEXTURE_MAGIC(texture, -1);
 
     renderer = texture->renderer;
+    if (!texture->native && alpha != texture->a) {
+        renderer->stats.state_changes++;
+    }
     if (alpha < 255) {
         texture->modMode |= SDL_TEXTUREMODULATE_ALPHA;
     } else {
@@ -753,6 +1192,9 @@ SDL_SetTextureBlendMode(SDL_Texture * texture, SDL_BlendMode blendMode)
     if (!IsSupportedBlendMode(renderer, blendMode)) {
         return SDL_Unsupported();
     }
+    if (!texture->native && blendMode != texture->blendMode) {
+        renderer->stats.state_changes++;
+    }
     texture->blendMode = blendMode;
     if (texture->native) {
         return SDL_SetTextureBlendMode(texture->native, blendMode);
@@ -892,7 +1334,11 @@ SDL_UpdateTexture(SDL_Texture * texture, const SDL_Rect * rect,
     } else if (texture->native) {
         return SDL_UpdateTextureNative(texture, rect, pixels, pitch);
     } else {
+        if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
+            return -1;
+        }
         renderer = texture->renderer;
+        CountTextureUpload(renderer, texture->format, rect->w, rect->h);
         return renderer->UpdateTexture(renderer, texture, rect, pixels, pitch);
     }
 }
@@ -1002,6 +1448,10 @@ int SDL_UpdateYUVTexture(SDL_Texture * texture, const SDL_Rect * rect,
         renderer = texture->renderer;
         SDL_assert(renderer->UpdateTextureYUV);
         if (renderer->UpdateTextureYUV) {
+            if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
+                return -1;
+            }
+            CountTextureUpload(renderer, texture->format, rect->w, rect->h);
             return renderer->UpdateTextureYUV(renderer, texture, rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
         } else {
             return SDL_Unsupported();
@@ -1054,7 +1504,11 @@ SDL_LockTexture(SDL_Texture * texture, const SDL_Rect * rect,
     } else if (texture->native) {
         return SDL_LockTextureNative(texture, rect, pixels, pitch);
     } else {
+        if (FlushRenderCommandsIfTextureNeeded(texture) < 0) {
+            return -1;
+        }
         renderer = texture->renderer;
+        texture->locked_rect = *rect;
         return renderer->LockTexture(renderer, texture, rect, pixels, pitch);
     }
 }
@@ -1117,6 +1571,7 @@ SDL_UnlockTexture(SDL_Texture * texture)
         SDL_UnlockTextureNative(texture);
     } else {
         renderer = texture->renderer;
+        CountTextureUpload(renderer, texture->format, texture->locked_rect.w, texture->locked_rect.h);
         renderer->UnlockTexture(renderer, texture);
     }
 }
@@ -1156,6 +1611,11 @@ SDL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
         }
     }
 
+    if (FlushRenderCommands(renderer) < 0) {
+        return -1;
+    }
+    renderer->stats.target_changes++;
+
     if (texture && !renderer->target) {
         /* Make a backup of the viewport */
         renderer->viewport_backup = renderer->viewport;
@@ -1383,7 +1843,8 @@ SDL_RenderSetViewport(SDL_Renderer * renderer, const SDL_Rect * rect)
             return -1;
         }
     }
-    return renderer->UpdateViewport(renderer);
+    renderer->stats.state_changes++;
+    return QueueCmdSetViewport(renderer);
 }
 
 void
@@ -1414,7 +1875,8 @@ SDL_RenderSetClipRect(SDL_Renderer * renderer, const SDL_Rect * rect)
         renderer->clipping_enabled = SDL_FALSE;
         SDL_zero(renderer->clip_rect);
     }
-    return renderer->UpdateClipRect(renderer);
+    renderer->stats.state_changes++;
+    return QueueCmdSetClipRect(renderer);
 }
 
 void
@@ -1442,6 +1904,9 @@ SDL_RenderSetScale(SDL_Renderer * renderer, float scaleX, float scaleY)
 {
     CHECK_RENDERER_MAGIC(renderer, -1);
 
+    if (scaleX != renderer->scale.x || scaleY != renderer->scale.y) {
+        renderer->stats.state_changes++;
+    }
     renderer->scale.x = scaleX;
     renderer->scale.y = scaleY;
     return 0;
@@ -1466,6 +1931,9 @@ SDL_SetRenderDrawColor(SDL_Renderer * renderer,
 {
     CHECK_RENDERER_MAGIC(renderer, -1);
 
+    if (r != renderer->r || g != renderer->g || b != renderer->b || a != renderer->a) {
+        renderer->stats.state_changes++;
+    }
     renderer->r = r;
     renderer->g = g;
     renderer->b = b;
@@ -1502,6 +1970,9 @@ SDL_SetRenderDrawBlendMode(SDL_Renderer * renderer, SDL_BlendMode blendMode)
     if (!IsSupportedBlendMode(renderer, blendMode)) {
         return SDL_Unsupported();
     }
+    if (blendMode != renderer->blendMode) {
+        renderer->stats.state_changes++;
+    }
     renderer->blendMode = blendMode;
     return 0;
 }
@@ -1524,7 +1995,7 @@ SDL_RenderClear(SDL_Renderer * renderer)
     if (renderer->hidden) {
         return 0;
     }
-    return renderer->RenderClear(renderer);
+    return QueueCmdClear(renderer);
 }
 
 int
@@ -1556,7 +2027,7 @@ RenderDrawPointsWithRects(SDL_Renderer * renderer,
         frects[i].h = renderer->scale.y;
     }
 
-    status = renderer->RenderFillRects(renderer, frects, count);
+    status = QueueCmdFillRects(renderer, frects, count);
 
     SDL_stack_free(frects);
 
@@ -1598,7 +2069,7 @@ SDL_RenderDrawPoints(SDL_Renderer * renderer,
         fpoints[i].y = points[i].y * renderer->scale.y;
     }
 
-    status = renderer->RenderDrawPoints(renderer, fpoints, count);
+    status = QueueCmdDrawPoints(renderer, fpoints, count);
 
     SDL_stack_free(fpoints);
 
@@ -1659,11 +2130,11 @@ RenderDrawLinesWithRects(SDL_Renderer * renderer,
             fpoints[0].y = points[i].y * renderer->scale.y;
             fpoints[1].x = points[i+1].x * renderer->scale.x;
             fpoints[1].y = points[i+1].y * renderer->scale.y;
-            status += renderer->RenderDrawLines(renderer, fpoints, 2);
+            status += QueueCmdDrawLines(renderer, fpoints, 2);
         }
     }
 
-    status += renderer->RenderFillRects(renderer, frects, nrects);
+    status += QueueCmdFillRects(renderer, frects, nrects);
 
     SDL_stack_free(frects);
 
@@ -1708,7 +2179,7 @@ SDL_RenderDrawLines(SDL_Renderer * renderer,
         fpoints[i].y = points[i].y * renderer->scale.y;
     }
 
-    status = renderer->RenderDrawLines(renderer, fpoints, count);
+    status = QueueCmdDrawLines(renderer, fpoints, count);
 
     SDL_stack_free(fpoints);
 
@@ -1822,7 +2293,7 @@ SDL_RenderFillRects(SDL_Renderer * renderer,
         frects[i].h = rects[i].h * renderer->scale.y;
     }
 
-    status = renderer->RenderFillRects(renderer, frects, count);
+    status = QueueCmdFillRects(renderer, frects, count);
 
     SDL_stack_free(frects);
 
@@ -1878,7 +2349,7 @@ SDL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
     frect.w = real_dstrect.w * renderer->scale.x;
     frect.h = real_dstrect.h * renderer->scale.y;
 
-    return renderer->RenderCopy(renderer, texture, &real_srcrect, &frect);
+    return QueueCmdCopy(renderer, texture, &real_srcrect, &frect);
 }
 
 
@@ -1950,7 +2421,61 @@ SDL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
     fcenter.x = real_center.x * renderer->scale.x;
     fcenter.y = real_center.y * renderer->scale.y;
 
-    return renderer->RenderCopyEx(renderer, texture, &real_srcrect, &frect, angle, &fcenter, flip);
+    return QueueCmdCopyEx(renderer, texture, &real_srcrect, &frect, angle, &fcenter, flip);
+}
+
+int
+SDL_RenderGeometry(SDL_Renderer * renderer, SDL_Texture * texture,
+                   const SDL_Vertex * vertices, int num_vertices,
+                   const int *indices, int num_indices)
+{
+    int i;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (texture) {
+        CHECK_TEXTURE_MAGIC(texture, -1);
+
+        if (renderer != texture->renderer) {
+            return SDL_SetError("Texture was not created with this renderer");
+        }
+    }
+    if (!vertices) {
+        return SDL_InvalidParamError("vertices");
+    }
+    if (num_vertices < 0) {
+        return SDL_InvalidParamError("num_vertices");
+    }
+    if (indices) {
+        if (num_indices < 0 || (num_indices % 3) != 0) {
+            return SDL_InvalidParamError("num_indices");
+        }
+        for (i = 0; i < num_indices; ++i) {
+            if (indices[i] < 0 || indices[i] >= num_vertices) {
+                return SDL_SetError("Vertex index %d out of range", indices[i]);
+            }
+        }
+    } else if ((num_vertices % 3) != 0) {
+        return SDL_InvalidParamError("num_vertices");
+    }
+    if (!renderer->RenderGeometry) {
+        return SDL_Unsupported();
+    }
+
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+
+    if ((indices ? num_indices : num_vertices) == 0) {
+        return 0;
+    }
+
+    if (texture && texture->native) {
+        texture = texture->native;
+    }
+
+    return QueueCmdGeometry(renderer, texture, vertices, num_vertices, indices, num_indices);
 }
 
 int
@@ -1965,6 +2490,10 @@ SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
         return SDL_Unsupported();
     }
 
+    if (FlushRenderCommands(renderer) < 0) {
+        return -1;
+    }
+
     if (!format) {
         format = SDL_GetWindowPixelFormat(renderer->window);
     }
@@ -1977,6 +2506,10 @@ SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
         if (!SDL_IntersectRect(rect, &real_rect, &real_rect)) {
             return 0;
         }
+        if (SDL_ISPIXELFORMAT_FOURCC(format) && !SDL_RectEquals(rect, &real_rect)) {
+            /* The planes can't be offset to the clipped part */
+            return SDL_SetError("YUV pixels can only be read inside the viewport");
+        }
         if (real_rect.y > rect->y) {
             pixels = (Uint8 *)pixels + pitch * (real_rect.y - rect->y);
         }
@@ -1990,16 +2523,52 @@ SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                                       format, pixels, pitch);
 }
 
+static void
+FinishFrameStats(SDL_Renderer * renderer, Uint64 start)
+{
+    const Uint64 ticks = SDL_GetPerformanceCounter() - start;
+
+    renderer->stats.frames = renderer->last_stats.frames + 1;
+    renderer->stats.present_time = (Uint32) ((ticks * 1000000) / SDL_GetPerformanceFrequency());
+    renderer->last_stats = renderer->stats;
+    SDL_zero(renderer->stats);
+}
+
 void
 SDL_RenderPresent(SDL_Renderer * renderer)
 {
+    Uint64 start;
+
     CHECK_RENDERER_MAGIC(renderer, );
 
+    start = SDL_GetPerformanceCounter();
+    FlushRenderCommands(renderer);
+
     /* Don't draw while we're hidden */
-    if (renderer->hidden) {
-        return;
+    if (!renderer->hidden) {
+        renderer->RenderPresent(renderer);
+    }
+    FinishFrameStats(renderer, start);
+}
+
+int
+SDL_RenderFlush(SDL_Renderer * renderer)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    return FlushRenderCommands(renderer);
+}
+
+int
+SDL_GetRendererStats(SDL_Renderer * renderer, SDL_RendererStats * stats)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
     }
-    renderer->RenderPresent(renderer);
+    *stats = renderer->last_stats;
+    return 0;
 }
 
 void
@@ -2012,6 +2581,8 @@ SDL_DestroyTexture(SDL_Texture * texture)
     renderer = texture->renderer;
     if (texture == renderer->target) {
         SDL_SetRenderTarget(renderer, NULL);
+    } else {
+        FlushRenderCommandsIfTextureNeeded(texture);
     }
 
     texture->magic = NULL;
@@ -2044,6 +2615,11 @@ SDL_DestroyRenderer(SDL_Renderer * renderer)
 
     SDL_DelEventWatch(SDL_RendererEventWatch, renderer);
 
+    /* Anything still queued is never going to be presented */
+    renderer->num_render_commands = 0;
+    renderer->vertex_data_used = 0;
+    renderer->render_command_generation++;
+
     /* Free existing textures for this renderer */
     while (renderer->textures) {
         SDL_Texture *tex = renderer->textures; (void) tex;
@@ -2058,6 +2634,9 @@ SDL_DestroyRenderer(SDL_Renderer * renderer)
     /* It's no longer magical... */
     renderer->magic = NULL;
 
+    SDL_free(renderer->render_commands);
+    SDL_free(renderer->vertex_data);
+
     /* Free the renderer instance */
     renderer->DestroyRenderer(renderer);
 }
@@ -2071,6 +2650,7 @@ int SDL_GL_BindTexture(SDL_Texture *texture, float *texw, float *texh)
     if (texture->native) {
         return SDL_GL_BindTexture(texture->native, texw, texh);
     } else if (renderer && renderer->GL_BindTexture) {
+        FlushRenderCommands(renderer);  /* in case the app is going to mess with it. */
         return renderer->GL_BindTexture(renderer, texture, texw, texh);
     } else {
         return SDL_Unsupported();
@@ -2107,6 +2687,9 @@ SDL_GetShortBlendMode(SDL_BlendMode blendMode)
     if (blendMode == SDL_BLENDMODE_MOD_FULL) {
         return SDL_BLENDMODE_MOD;
     }
+    if (blendMode == SDL_BLENDMODE_BLEND_PREMULTIPLIED_FULL) {
+        return SDL_BLENDMODE_BLEND_PREMULTIPLIED;
+    }
     return blendMode;
 }
 
@@ -2125,6 +2708,9 @@ SDL_GetLongBlendMode(SDL_BlendMode blendMode)
     if (blendMode == SDL_BLENDMODE_MOD) {
         return SDL_BLENDMODE_MOD_FULL;
     }
+    if (blendMode == SDL_BLENDMODE_BLEND_PREMULTIPLIED) {
+        return SDL_BLENDMODE_BLEND_PREMULTIPLIED_FULL;
+    }
     return blendMode;
 }
 
@@ -45,6 +45,65 @@ typedef struct
     float h;
 } SDL_FRect;
 
+/* Commands recorded by the renderer when batching is enabled */
+typedef enum
+{
+    SDL_RENDERCMD_NO_OP,
+    SDL_RENDERCMD_SETVIEWPORT,
+    SDL_RENDERCMD_SETCLIPRECT,
+    SDL_RENDERCMD_CLEAR,
+    SDL_RENDERCMD_DRAW_POINTS,
+    SDL_RENDERCMD_DRAW_LINES,
+    SDL_RENDERCMD_FILL_RECTS,
+    SDL_RENDERCMD_COPY,
+    SDL_RENDERCMD_COPY_EX,
+    SDL_RENDERCMD_GEOMETRY
+} SDL_RenderCommandType;
+
+typedef struct SDL_RenderCommand
+{
+    SDL_RenderCommandType command;
+    union {
+        struct {
+            SDL_Rect rect;
+        } viewport;
+        struct {
+            SDL_bool enabled;
+            SDL_Rect rect;
+        } cliprect;
+        struct {
+            size_t first;               /**< Byte offset into the vertex data */
+            size_t count;               /**< Number of primitives, not bytes */
+            Uint8 r, g, b, a;           /**< Draw color, or texture modulation */
+            SDL_BlendMode blend;
+            SDL_Texture *texture;
+        } draw;
+        struct {
+            Uint8 r, g, b, a;
+        } color;
+    } data;
+} SDL_RenderCommand;
+
+/* Vertex data for SDL_RENDERCMD_COPY, one entry per copy */
+typedef struct
+{
+    SDL_Rect srcrect;
+    SDL_FRect dstrect;
+} SDL_RenderCopyData;
+
+/* Vertex data for SDL_RENDERCMD_COPY_EX, one entry per copy */
+typedef struct
+{
+    SDL_Rect srcrect;
+    SDL_FRect dstrect;
+    double angle;
+    SDL_FPoint center;
+    SDL_RendererFlip flip;
+} SDL_RenderCopyExData;
+
+/* Vertex data for SDL_RENDERCMD_GEOMETRY is a plain triangle list of
+   SDL_Vertex, already scaled and with the indices resolved. */
+
 /* Define the SDL texture structure */
 struct SDL_Texture
 {
@@ -55,6 +114,7 @@ struct SDL_Texture
     int h;                      /**< The height of the texture */
     int modMode;                /**< The texture modulation mode */
     SDL_BlendMode blendMode;    /**< The texture blend mode */
+    int scaleQuality;           /**< SDL_HINT_RENDER_SCALE_QUALITY when created, if the driver samples it itself */
     Uint8 r, g, b, a;           /**< Texture modulation values */
 
     SDL_Renderer *renderer;
@@ -66,6 +126,8 @@ struct SDL_Texture
     int pitch;
     SDL_Rect locked_rect;
 
+    Uint32 last_command_generation; /**< last command queue generation this texture was in. */
+
     void *driverdata;           /**< Driver specific texture representation */
 
     SDL_Texture *prev;
@@ -113,9 +175,14 @@ struct SDL_Renderer
     int (*RenderCopyEx) (SDL_Renderer * renderer, SDL_Texture * texture,
                        const SDL_Rect * srcquad, const SDL_FRect * dstrect,
                        const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip);
+    int (*RenderGeometry) (SDL_Renderer * renderer, SDL_Texture * texture,
+                           const SDL_Vertex * vertices, int num_vertices,
+                           const int *indices, int num_indices);
     int (*RenderReadPixels) (SDL_Renderer * renderer, const SDL_Rect * rect,
                              Uint32 format, void * pixels, int pitch);
     void (*RenderPresent) (SDL_Renderer * renderer);
+    int (*RunCommandQueue) (SDL_Renderer * renderer, const SDL_RenderCommand *cmds,
+                            int count, void *vertices, size_t vertsize);
     void (*DestroyTexture) (SDL_Renderer * renderer, SDL_Texture * texture);
 
     void (*DestroyRenderer) (SDL_Renderer * renderer);
@@ -165,6 +232,20 @@ struct SDL_Renderer
     Uint8 r, g, b, a;                   /**< Color for drawing operations values */
     SDL_BlendMode blendMode;            /**< The drawing blend mode */
 
+    /* Deferred command queue, used if the driver implements RunCommandQueue */
+    SDL_bool batching;
+    SDL_RenderCommand *render_commands;
+    int num_render_commands;
+    int max_render_commands;
+    Uint32 render_command_generation;
+    void *vertex_data;
+    size_t vertex_data_used;
+    size_t vertex_data_allocation;
+
+    /* Counters for the frame being drawn and the last presented one */
+    SDL_RendererStats stats;
+    SDL_RendererStats last_stats;
+
     void *driverdata;
 };
 
@@ -87,6 +87,7 @@
 #include "SDL_cpuinfo.h"
 #include "SDL_yuv_sw_c.h"
 #include "SDL_yuv_mmx_c.h"
+#include "../SDL_simd.h"
 
 
 /* The colorspace conversion functions */
@@ -857,6 +858,380 @@ Color32DitherYUY2Mod2X(int *colortab, Uint32 * rgb_2_pix,
     }
 }
 
+/* The conversion functions for 32-bit targets with whole byte channels.
+   They all use the same fixed point math, so the results are identical, and
+   in the JPEG mode they also match the table driven converters. */
+
+SDL_FORCE_INLINE Uint8
+ClampYUVValue(int value)
+{
+    return (Uint8) ((value < 0) ? 0 : ((value > 255) ? 255 : value));
+}
+
+/* The JPEG mode matches the tables of earlier SDL versions, which truncate
+   each chroma term towards zero.  These are their factors with 14 fractional
+   bits, rounded down, which gives the same terms for every chroma value. */
+#define JPEG_RV 22959   /* 0.419 / 0.299 */
+#define JPEG_GU 5642    /* 0.114 / 0.331 */
+#define JPEG_GV 11691   /* 0.299 / 0.419 */
+#define JPEG_BU 29055   /* 0.587 / 0.331 */
+
+SDL_FORCE_INLINE int
+TruncMulYUV(int c, int k)
+{
+    return (c < 0) ? -((-c * k) >> 14) : ((c * k) >> 14);
+}
+
+SDL_FORCE_INLINE void
+ConvertPixelYUV(int y, int cb, int cr, Uint8 *out,
+                const SDL_YUVConversion * conversion)
+{
+    const int lum = (y - conversion->y_offset) * conversion->y_mul + 4096;
+
+    cb -= 128;
+    cr -= 128;
+    if (conversion->jpeg) {
+        out[conversion->r_pos] = ClampYUVValue(y + TruncMulYUV(cr, JPEG_RV));
+        out[conversion->g_pos] = ClampYUVValue(y - TruncMulYUV(cb, JPEG_GU) - TruncMulYUV(cr, JPEG_GV));
+        out[conversion->b_pos] = ClampYUVValue(y + TruncMulYUV(cb, JPEG_BU));
+    } else {
+        out[conversion->r_pos] = ClampYUVValue((lum + cr * conversion->rv) >> 13);
+        out[conversion->g_pos] = ClampYUVValue((lum + cb * conversion->gu + cr * conversion->gv) >> 13);
+        out[conversion->b_pos] = ClampYUVValue((lum + cb * conversion->bu) >> 13);
+    }
+    out[conversion->a_pos] = conversion->a_value;
+}
+
+/* Splits a row of byte pairs into the even and the odd bytes */
+static void
+SplitBytePairs(const Uint8 *src, Uint8 *even, Uint8 *odd, int count)
+{
+    int i = 0;
+
+#if HAVE_SSE2_INTRINSICS
+    const __m128i mask = _mm_set1_epi16(0x00FF);
+
+    for (; i + 16 <= count; i += 16) {
+        const __m128i a = _mm_loadu_si128((const __m128i *) (src + i * 2));
+        const __m128i b = _mm_loadu_si128((const __m128i *) (src + i * 2 + 16));
+        _mm_storeu_si128((__m128i *) (even + i),
+                         _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask)));
+        _mm_storeu_si128((__m128i *) (odd + i),
+                         _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+    }
+#elif HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        for (; i + 16 <= count; i += 16) {
+            const uint8x16x2_t pairs = vld2q_u8(src + i * 2);
+            vst1q_u8(even + i, pairs.val[0]);
+            vst1q_u8(odd + i, pairs.val[1]);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        even[i] = src[i * 2];
+        odd[i] = src[i * 2 + 1];
+    }
+}
+
+#if HAVE_SSE2_INTRINSICS
+/* (a * k.lo + b * k.hi + extra) >> 13 for eight pixels */
+SDL_FORCE_INLINE __m128i
+MulAddYUVSSE2(__m128i a, __m128i b, __m128i k, __m128i extra_lo, __m128i extra_hi)
+{
+    __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(a, b), k);
+    __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi16(a, b), k);
+
+    lo = _mm_srai_epi32(_mm_add_epi32(lo, extra_lo), 13);
+    hi = _mm_srai_epi32(_mm_add_epi32(hi, extra_hi), 13);
+    return _mm_packs_epi32(lo, hi);
+}
+
+/* TruncMulYUV() for eight pixels */
+SDL_FORCE_INLINE __m128i
+TruncMulYUVSSE2(__m128i c, __m128i k)
+{
+    const __m128i sign = _mm_srai_epi16(c, 15);
+    const __m128i mag = _mm_sub_epi16(_mm_xor_si128(c, sign), sign);
+    const __m128i product = _mm_mulhi_epi16(_mm_slli_epi16(mag, 2), k);
+
+    return _mm_sub_epi16(_mm_xor_si128(product, sign), sign);
+}
+
+/* converts 16 pixels at a time */
+static void
+ConvertRowYUVSSE2(const Uint8 *lum, const Uint8 *cb, const Uint8 *cr,
+                  Uint8 *out, int cols, const SDL_YUVConversion * conversion)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i half = _mm_set1_epi16(128);
+    const __m128i y_offset = _mm_set1_epi16((Sint16) conversion->y_offset);
+    const __m128i round = _mm_set1_epi32(4096);
+    const __m128i r_mul = _mm_set1_epi32((Uint16) conversion->y_mul | ((Uint32) (Uint16) conversion->rv << 16));
+    const __m128i g_mul = _mm_set1_epi32((Uint16) conversion->y_mul | ((Uint32) (Uint16) conversion->gu << 16));
+    const __m128i g_mul2 = _mm_set1_epi32((Uint16) conversion->gv | ((Uint32) 4096 << 16));
+    const __m128i b_mul = _mm_set1_epi32((Uint16) conversion->y_mul | ((Uint32) (Uint16) conversion->bu << 16));
+    const __m128i jpeg_rv = _mm_set1_epi16(JPEG_RV);
+    const __m128i jpeg_gu = _mm_set1_epi16(JPEG_GU);
+    const __m128i jpeg_gv = _mm_set1_epi16(JPEG_GV);
+    const __m128i jpeg_bu = _mm_set1_epi16(JPEG_BU);
+    __m128i channels[4];
+    int x = 0;
+
+    channels[conversion->a_pos] = _mm_set1_epi8((char) conversion->a_value);
+
+    for (; x + 16 <= cols; x += 16) {
+        const __m128i y8 = _mm_loadu_si128((const __m128i *) (lum + x));
+        const __m128i u8 = _mm_loadl_epi64((const __m128i *) (cb + x / 2));
+        const __m128i v8 = _mm_loadl_epi64((const __m128i *) (cr + x / 2));
+        const __m128i y0 = _mm_sub_epi16(_mm_unpacklo_epi8(y8, zero), y_offset);
+        const __m128i y1 = _mm_sub_epi16(_mm_unpackhi_epi8(y8, zero), y_offset);
+        const __m128i u0 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_unpacklo_epi8(u8, u8), zero), half);
+        const __m128i u1 = _mm_sub_epi16(_mm_unpackhi_epi8(_mm_unpacklo_epi8(u8, u8), zero), half);
+        const __m128i v0 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_unpacklo_epi8(v8, v8), zero), half);
+        const __m128i v1 = _mm_sub_epi16(_mm_unpackhi_epi8(_mm_unpacklo_epi8(v8, v8), zero), half);
+        __m128i lo01, hi01, lo23, hi23;
+
+        if (conversion->jpeg) {
+            channels[conversion->r_pos] =
+                _mm_packus_epi16(_mm_add_epi16(y0, TruncMulYUVSSE2(v0, jpeg_rv)),
+                                 _mm_add_epi16(y1, TruncMulYUVSSE2(v1, jpeg_rv)));
+            channels[conversion->g_pos] =
+                _mm_packus_epi16(_mm_sub_epi16(_mm_sub_epi16(y0, TruncMulYUVSSE2(u0, jpeg_gu)), TruncMulYUVSSE2(v0, jpeg_gv)),
+                                 _mm_sub_epi16(_mm_sub_epi16(y1, TruncMulYUVSSE2(u1, jpeg_gu)), TruncMulYUVSSE2(v1, jpeg_gv)));
+            channels[conversion->b_pos] =
+                _mm_packus_epi16(_mm_add_epi16(y0, TruncMulYUVSSE2(u0, jpeg_bu)),
+                                 _mm_add_epi16(y1, TruncMulYUVSSE2(u1, jpeg_bu)));
+        } else {
+            channels[conversion->r_pos] =
+                _mm_packus_epi16(MulAddYUVSSE2(y0, v0, r_mul, round, round),
+                                 MulAddYUVSSE2(y1, v1, r_mul, round, round));
+            channels[conversion->g_pos] =
+                _mm_packus_epi16(MulAddYUVSSE2(y0, u0, g_mul,
+                                               _mm_madd_epi16(_mm_unpacklo_epi16(v0, one), g_mul2),
+                                               _mm_madd_epi16(_mm_unpackhi_epi16(v0, one), g_mul2)),
+                                 MulAddYUVSSE2(y1, u1, g_mul,
+                                               _mm_madd_epi16(_mm_unpacklo_epi16(v1, one), g_mul2),
+                                               _mm_madd_epi16(_mm_unpackhi_epi16(v1, one), g_mul2)));
+            channels[conversion->b_pos] =
+                _mm_packus_epi16(MulAddYUVSSE2(y0, u0, b_mul, round, round),
+                                 MulAddYUVSSE2(y1, u1, b_mul, round, round));
+        }
+
+        lo01 = _mm_unpacklo_epi8(channels[0], channels[1]);
+        hi01 = _mm_unpackhi_epi8(channels[0], channels[1]);
+        lo23 = _mm_unpacklo_epi8(channels[2], channels[3]);
+        hi23 = _mm_unpackhi_epi8(channels[2], channels[3]);
+        _mm_storeu_si128((__m128i *) (out + 0), _mm_unpacklo_epi16(lo01, lo23));
+        _mm_storeu_si128((__m128i *) (out + 16), _mm_unpackhi_epi16(lo01, lo23));
+        _mm_storeu_si128((__m128i *) (out + 32), _mm_unpacklo_epi16(hi01, hi23));
+        _mm_storeu_si128((__m128i *) (out + 48), _mm_unpackhi_epi16(hi01, hi23));
+        out += 64;
+    }
+    for (; x < cols; ++x) {
+        ConvertPixelYUV(lum[x], cb[x / 2], cr[x / 2], out, conversion);
+        out += 4;
+    }
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_AVX2_INTRINSICS
+/* (a * k.lo + b * k.hi + extra) >> 13 for sixteen pixels */
+SDL_FORCE_INLINE __m256i SDL_TARGETING_AVX2
+MulAddYUVAVX2(__m256i a, __m256i b, __m256i k, __m256i extra_lo, __m256i extra_hi)
+{
+    __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(a, b), k);
+    __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(a, b), k);
+
+    lo = _mm256_srai_epi32(_mm256_add_epi32(lo, extra_lo), 13);
+    hi = _mm256_srai_epi32(_mm256_add_epi32(hi, extra_hi), 13);
+    return _mm256_packs_epi32(lo, hi);
+}
+
+/* TruncMulYUV() for sixteen pixels */
+SDL_FORCE_INLINE __m256i SDL_TARGETING_AVX2
+TruncMulYUVAVX2(__m256i c, __m256i k)
+{
+    const __m256i sign = _mm256_srai_epi16(c, 15);
+    const __m256i mag = _mm256_sub_epi16(_mm256_xor_si256(c, sign), sign);
+    const __m256i product = _mm256_mulhi_epi16(_mm256_slli_epi16(mag, 2), k);
+
+    return _mm256_sub_epi16(_mm256_xor_si256(product, sign), sign);
+}
+
+/* converts 32 pixels at a time */
+static void SDL_TARGETING_AVX2
+ConvertRowYUVAVX2(const Uint8 *lum, const Uint8 *cb, const Uint8 *cr,
+                  Uint8 *out, int cols, const SDL_YUVConversion * conversion)
+{
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i half = _mm256_set1_epi16(128);
+    const __m256i y_offset = _mm256_set1_epi16((Sint16) conversion->y_offset);
+    const __m256i round = _mm256_set1_epi32(4096);
+    const __m256i r_mul = _mm256_set1_epi32((Uint16) conversion->y_mul | ((Uint32) (Uint16) conversion->rv << 16));
+    const __m256i g_mul = _mm256_set1_epi32((Uint16) conversion->y_mul | ((Uint32) (Uint16) conversion->gu << 16));
+    const __m256i g_mul2 = _mm256_set1_epi32((Uint16) conversion->gv | ((Uint32) 4096 << 16));
+    const __m256i b_mul = _mm256_set1_epi32((Uint16) conversion->y_mul | ((Uint32) (Uint16) conversion->bu << 16));
+    const __m256i jpeg_rv = _mm256_set1_epi16(JPEG_RV);
+    const __m256i jpeg_gu = _mm256_set1_epi16(JPEG_GU);
+    const __m256i jpeg_gv = _mm256_set1_epi16(JPEG_GV);
+    const __m256i jpeg_bu = _mm256_set1_epi16(JPEG_BU);
+    __m256i channels[4];
+    int x = 0;
+
+    channels[conversion->a_pos] = _mm256_set1_epi8((char) conversion->a_value);
+
+    for (; x + 32 <= cols; x += 32) {
+        const __m128i u8 = _mm_loadu_si128((const __m128i *) (cb + x / 2));
+        const __m128i v8 = _mm_loadu_si128((const __m128i *) (cr + x / 2));
+        const __m256i y0 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) (lum + x))), y_offset);
+        const __m256i y1 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) (lum + x + 16))), y_offset);
+        const __m256i u0 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_unpacklo_epi8(u8, u8)), half);
+        const __m256i u1 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_unpackhi_epi8(u8, u8)), half);
+        const __m256i v0 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_unpacklo_epi8(v8, v8)), half);
+        const __m256i v1 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_unpackhi_epi8(v8, v8)), half);
+        __m256i lo01, hi01, lo23, hi23, a, b;
+
+        /* The packs work within the 128-bit lanes, so the channels hold
+           pixels 0-7, 16-23 in the low lane and 8-15, 24-31 in the high one */
+        if (conversion->jpeg) {
+            channels[conversion->r_pos] =
+                _mm256_packus_epi16(_mm256_add_epi16(y0, TruncMulYUVAVX2(v0, jpeg_rv)),
+                                    _mm256_add_epi16(y1, TruncMulYUVAVX2(v1, jpeg_rv)));
+            channels[conversion->g_pos] =
+                _mm256_packus_epi16(_mm256_sub_epi16(_mm256_sub_epi16(y0, TruncMulYUVAVX2(u0, jpeg_gu)), TruncMulYUVAVX2(v0, jpeg_gv)),
+                                    _mm256_sub_epi16(_mm256_sub_epi16(y1, TruncMulYUVAVX2(u1, jpeg_gu)), TruncMulYUVAVX2(v1, jpeg_gv)));
+            channels[conversion->b_pos] =
+                _mm256_packus_epi16(_mm256_add_epi16(y0, TruncMulYUVAVX2(u0, jpeg_bu)),
+                                    _mm256_add_epi16(y1, TruncMulYUVAVX2(u1, jpeg_bu)));
+        } else {
+            channels[conversion->r_pos] =
+                _mm256_packus_epi16(MulAddYUVAVX2(y0, v0, r_mul, round, round),
+                                    MulAddYUVAVX2(y1, v1, r_mul, round, round));
+            channels[conversion->g_pos] =
+                _mm256_packus_epi16(MulAddYUVAVX2(y0, u0, g_mul,
+                                                  _mm256_madd_epi16(_mm256_unpacklo_epi16(v0, one), g_mul2),
+                                                  _mm256_madd_epi16(_mm256_unpackhi_epi16(v0, one), g_mul2)),
+                                    MulAddYUVAVX2(y1, u1, g_mul,
+                                                  _mm256_madd_epi16(_mm256_unpacklo_epi16(v1, one), g_mul2),
+                                                  _mm256_madd_epi16(_mm256_unpackhi_epi16(v1, one), g_mul2)));
+            channels[conversion->b_pos] =
+                _mm256_packus_epi16(MulAddYUVAVX2(y0, u0, b_mul, round, round),
+                                    MulAddYUVAVX2(y1, u1, b_mul, round, round));
+        }
+
+        lo01 = _mm256_unpacklo_epi8(channels[0], channels[1]);
+        hi01 = _mm256_unpackhi_epi8(channels[0], channels[1]);
+        lo23 = _mm256_unpacklo_epi8(channels[2], channels[3]);
+        hi23 = _mm256_unpackhi_epi8(channels[2], channels[3]);
+        a = _mm256_unpacklo_epi16(lo01, lo23);
+        b = _mm256_unpackhi_epi16(lo01, lo23);
+        _mm256_storeu_si256((__m256i *) (out + 0), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i *) (out + 32), _mm256_permute2x128_si256(a, b, 0x31));
+        a = _mm256_unpacklo_epi16(hi01, hi23);
+        b = _mm256_unpackhi_epi16(hi01, hi23);
+        _mm256_storeu_si256((__m256i *) (out + 64), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i *) (out + 96), _mm256_permute2x128_si256(a, b, 0x31));
+        out += 128;
+    }
+    for (; x < cols; ++x) {
+        ConvertPixelYUV(lum[x], cb[x / 2], cr[x / 2], out, conversion);
+        out += 4;
+    }
+}
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+/* TruncMulYUV() for eight pixels */
+SDL_FORCE_INLINE int16x8_t
+TruncMulYUVNEON(int16x8_t c, Sint16 k)
+{
+    const int16x8_t sign = vshrq_n_s16(c, 15);
+    const int16x8_t mag = vsubq_s16(veorq_s16(c, sign), sign);
+    const int16x8_t product = vqdmulhq_n_s16(vshlq_n_s16(mag, 1), k);
+
+    return vsubq_s16(veorq_s16(product, sign), sign);
+}
+
+/* converts 16 pixels at a time */
+static void
+ConvertRowYUVNEON(const Uint8 *lum, const Uint8 *cb, const Uint8 *cr,
+                  Uint8 *out, int cols, const SDL_YUVConversion * conversion)
+{
+    const int16x8_t y_offset = vdupq_n_s16((Sint16) conversion->y_offset);
+    const uint8x8_t half = vdup_n_u8(128);
+    uint8x16x4_t channels;
+    int x = 0;
+
+    channels.val[conversion->a_pos] = vdupq_n_u8(conversion->a_value);
+
+    for (; x + 16 <= cols; x += 16) {
+        const uint8x16_t y8 = vld1q_u8(lum + x);
+        const uint8x8x2_t u8 = vzip_u8(vld1_u8(cb + x / 2), vld1_u8(cb + x / 2));
+        const uint8x8x2_t v8 = vzip_u8(vld1_u8(cr + x / 2), vld1_u8(cr + x / 2));
+        int16x4_t y[4], u[4], v[4];
+        int32x4_t r[4], g[4], b[4];
+        int i;
+
+        y[0] = vget_low_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(y8))), y_offset));
+        y[1] = vget_high_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(y8))), y_offset));
+        y[2] = vget_low_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(y8))), y_offset));
+        y[3] = vget_high_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(y8))), y_offset));
+        if (conversion->jpeg) {
+            int16x8_t r16[2], g16[2], b16[2];
+
+            for (i = 0; i < 2; ++i) {
+                const int16x8_t y16 = vreinterpretq_s16_u16(vmovl_u8(i ? vget_high_u8(y8) : vget_low_u8(y8)));
+                const int16x8_t u16 = vreinterpretq_s16_u16(vsubl_u8(u8.val[i], half));
+                const int16x8_t v16 = vreinterpretq_s16_u16(vsubl_u8(v8.val[i], half));
+                r16[i] = vaddq_s16(y16, TruncMulYUVNEON(v16, JPEG_RV));
+                g16[i] = vsubq_s16(vsubq_s16(y16, TruncMulYUVNEON(u16, JPEG_GU)), TruncMulYUVNEON(v16, JPEG_GV));
+                b16[i] = vaddq_s16(y16, TruncMulYUVNEON(u16, JPEG_BU));
+            }
+            channels.val[conversion->r_pos] = vcombine_u8(vqmovun_s16(r16[0]), vqmovun_s16(r16[1]));
+            channels.val[conversion->g_pos] = vcombine_u8(vqmovun_s16(g16[0]), vqmovun_s16(g16[1]));
+            channels.val[conversion->b_pos] = vcombine_u8(vqmovun_s16(b16[0]), vqmovun_s16(b16[1]));
+            vst4q_u8(out, channels);
+            out += 64;
+            continue;
+        }
+
+        for (i = 0; i < 2; ++i) {
+            const int16x8_t u16 = vreinterpretq_s16_u16(vsubl_u8(u8.val[i], half));
+            const int16x8_t v16 = vreinterpretq_s16_u16(vsubl_u8(v8.val[i], half));
+            u[i * 2 + 0] = vget_low_s16(u16);
+            u[i * 2 + 1] = vget_high_s16(u16);
+            v[i * 2 + 0] = vget_low_s16(v16);
+            v[i * 2 + 1] = vget_high_s16(v16);
+        }
+        for (i = 0; i < 4; ++i) {
+            const int32x4_t l = vmull_n_s16(y[i], conversion->y_mul);
+            r[i] = vmlal_n_s16(l, v[i], conversion->rv);
+            g[i] = vmlal_n_s16(vmlal_n_s16(l, u[i], conversion->gu), v[i], conversion->gv);
+            b[i] = vmlal_n_s16(l, u[i], conversion->bu);
+        }
+
+        /* The rounding shift adds the 4096 of the other converters */
+        channels.val[conversion->r_pos] =
+            vcombine_u8(vqmovun_s16(vcombine_s16(vqrshrn_n_s32(r[0], 13), vqrshrn_n_s32(r[1], 13))),
+                        vqmovun_s16(vcombine_s16(vqrshrn_n_s32(r[2], 13), vqrshrn_n_s32(r[3], 13))));
+        channels.val[conversion->g_pos] =
+            vcombine_u8(vqmovun_s16(vcombine_s16(vqrshrn_n_s32(g[0], 13), vqrshrn_n_s32(g[1], 13))),
+                        vqmovun_s16(vcombine_s16(vqrshrn_n_s32(g[2], 13), vqrshrn_n_s32(g[3], 13))));
+        channels.val[conversion->b_pos] =
+            vcombine_u8(vqmovun_s16(vcombine_s16(vqrshrn_n_s32(b[0], 13), vqrshrn_n_s32(b[1], 13))),
+                        vqmovun_s16(vcombine_s16(vqrshrn_n_s32(b[2], 13), vqrshrn_n_s32(b[3], 13))));
+        vst4q_u8(out, channels);
+        out += 64;
+    }
+    for (; x < cols; ++x) {
+        ConvertPixelYUV(lum[x], cb[x / 2], cr[x / 2], out, conversion);
+        out += 4;
+    }
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
 /*
  * How many 1 bits are there in the Uint32.
  * Low performance, do not call often.
@@ -888,9 +1263,69 @@ free_bits_at_bottom(Uint32 a)
     return a ? free_bits_at_bottom_nonzero(a) : 32;
 }
 
+/*
+ * Byte offset of a whole byte channel in a little endian 32-bit pixel,
+ * or -1 if the channel isn't one.
+ */
+static int
+byte_position(Uint32 mask)
+{
+    int shift;
+
+    for (shift = 0; shift < 32; shift += 8) {
+        if (mask == (0xFFu << shift)) {
+            return shift / 8;
+        }
+    }
+    return -1;
+}
+
+/* Calculate the fixed point matrix for the conversion mode */
+static void
+SDL_SW_SetupYUVConversion(SDL_YUVConversion * conversion,
+                          SDL_YUV_CONVERSION_MODE mode)
+{
+    double kr, kb, kg;
+    double y_scale, c_scale;
+
+    if (mode == SDL_YUV_CONVERSION_BT709 ||
+        mode == SDL_YUV_CONVERSION_BT709_FULL) {
+        kr = 0.2126;
+        kb = 0.0722;
+    } else {
+        kr = 0.299;
+        kb = 0.114;
+    }
+    kg = 1.0 - kr - kb;
+
+    if (mode == SDL_YUV_CONVERSION_BT601 ||
+        mode == SDL_YUV_CONVERSION_BT709) {
+        /* Video range, Y is 16-235 and the chroma 16-240 */
+        conversion->y_offset = 16;
+        y_scale = 255.0 / 219.0;
+        c_scale = 255.0 / 224.0;
+    } else {
+        conversion->y_offset = 0;
+        y_scale = 1.0;
+        c_scale = 1.0;
+    }
+    conversion->y_mul = (Sint16) SDL_floor(y_scale * 8192.0 + 0.5);
+    conversion->rv = (Sint16) SDL_floor(2.0 * (1.0 - kr) * c_scale * 8192.0 + 0.5);
+    conversion->gu = (Sint16) SDL_floor(-2.0 * kb * (1.0 - kb) / kg * c_scale * 8192.0 + 0.5);
+    conversion->gv = (Sint16) SDL_floor(-2.0 * kr * (1.0 - kr) / kg * c_scale * 8192.0 + 0.5);
+    conversion->bu = (Sint16) SDL_floor(2.0 * (1.0 - kb) * c_scale * 8192.0 + 0.5);
+    conversion->jpeg = (mode == SDL_YUV_CONVERSION_JPEG) ? SDL_TRUE : SDL_FALSE;
+}
+
 static int
-SDL_SW_SetupYUVDisplay(SDL_SW_YUVTexture * swdata, Uint32 target_format)
+SDL_SW_SetupYUVDisplay(SDL_SW_YUVTexture * swdata, Uint32 target_format,
+                       SDL_YUV_CONVERSION_MODE mode)
 {
+    SDL_YUVConversion *conversion = &swdata->conversion;
+    int *Cr_r_tab;
+    int *Cr_g_tab;
+    int *Cb_g_tab;
+    int *Cb_b_tab;
     Uint32 *r_2_pix_alloc;
     Uint32 *g_2_pix_alloc;
     Uint32 *b_2_pix_alloc;
@@ -905,34 +1340,67 @@ SDL_SW_SetupYUVDisplay(SDL_SW_YUVTexture * swdata, Uint32 target_format)
     }
 
     swdata->target_format = target_format;
+    swdata->mode = mode;
+    SDL_SW_SetupYUVConversion(conversion, mode);
+
+    /* Generate the tables for the display surface.  The luminance scale
+       is applied by the rgb-to-pixel tables, so it's divided out here. */
+    Cr_r_tab = &swdata->colortab[0 * 256];
+    Cr_g_tab = &swdata->colortab[1 * 256];
+    Cb_g_tab = &swdata->colortab[2 * 256];
+    Cb_b_tab = &swdata->colortab[3 * 256];
+    for (i = 0; i < 256; i++) {
+        /* Gamma correction (luminescence table) and chroma correction
+           would be done here.  See the Berkeley mpeg_play sources.
+         */
+        const int CR = (i - 128);
+        const int CB = (i - 128);
+        if (conversion->jpeg) {
+            /* Keep the output of earlier SDL versions */
+            Cr_r_tab[i] = (int) ((0.419 / 0.299) * CR);
+            Cr_g_tab[i] = (int) (-(0.299 / 0.419) * CR);
+            Cb_g_tab[i] = (int) (-(0.114 / 0.331) * CB);
+            Cb_b_tab[i] = (int) ((0.587 / 0.331) * CB);
+        } else {
+            Cr_r_tab[i] = (conversion->rv * CR) / conversion->y_mul;
+            Cr_g_tab[i] = (conversion->gv * CR) / conversion->y_mul;
+            Cb_g_tab[i] = (conversion->gu * CB) / conversion->y_mul;
+            Cb_b_tab[i] = (conversion->bu * CB) / conversion->y_mul;
+        }
+    }
+
     r_2_pix_alloc = &swdata->rgb_2_pix[0 * 768];
     g_2_pix_alloc = &swdata->rgb_2_pix[1 * 768];
     b_2_pix_alloc = &swdata->rgb_2_pix[2 * 768];
 
     /*
-     * Set up entries 0-255 in rgb-to-pixel value tables.
+     * Set up entries 0-767 in rgb-to-pixel value tables, with the values
+     * past 0-255 clamped so that we do not need to check for overflow.
      */
-    for (i = 0; i < 256; ++i) {
-        r_2_pix_alloc[i + 256] = i >> (8 - number_of_bits_set(Rmask));
+    for (i = 0; i < 768; ++i) {
+        const int value = ClampYUVValue(((i - 256 - conversion->y_offset) *
+                                         conversion->y_mul + 4096) >> 13);
+
+        r_2_pix_alloc[i] = value >> (8 - number_of_bits_set(Rmask));
         freebits = free_bits_at_bottom(Rmask);
         if (freebits < 32) {
-            r_2_pix_alloc[i + 256] <<= freebits;
+            r_2_pix_alloc[i] <<= freebits;
         }
-        r_2_pix_alloc[i + 256] |= Amask;
+        r_2_pix_alloc[i] |= Amask;
 
-        g_2_pix_alloc[i + 256] = i >> (8 - number_of_bits_set(Gmask));
+        g_2_pix_alloc[i] = value >> (8 - number_of_bits_set(Gmask));
         freebits = free_bits_at_bottom(Gmask);
         if (freebits < 32) {
-            g_2_pix_alloc[i + 256] <<= freebits;
+            g_2_pix_alloc[i] <<= freebits;
         }
-        g_2_pix_alloc[i + 256] |= Amask;
+        g_2_pix_alloc[i] |= Amask;
 
-        b_2_pix_alloc[i + 256] = i >> (8 - number_of_bits_set(Bmask));
+        b_2_pix_alloc[i] = value >> (8 - number_of_bits_set(Bmask));
         freebits = free_bits_at_bottom(Bmask);
         if (freebits < 32) {
-            b_2_pix_alloc[i + 256] <<= freebits;
+            b_2_pix_alloc[i] <<= freebits;
         }
-        b_2_pix_alloc[i + 256] |= Amask;
+        b_2_pix_alloc[i] |= Amask;
     }
 
     /*
@@ -943,30 +1411,48 @@ SDL_SW_SetupYUVDisplay(SDL_SW_YUVTexture * swdata, Uint32 target_format)
      * through a short pointer will lose the top bits anyway.
      */
     if (SDL_BYTESPERPIXEL(target_format) == 2) {
-        for (i = 0; i < 256; ++i) {
-            r_2_pix_alloc[i + 256] |= (r_2_pix_alloc[i + 256]) << 16;
-            g_2_pix_alloc[i + 256] |= (g_2_pix_alloc[i + 256]) << 16;
-            b_2_pix_alloc[i + 256] |= (b_2_pix_alloc[i + 256]) << 16;
+        for (i = 0; i < 768; ++i) {
+            r_2_pix_alloc[i] |= (r_2_pix_alloc[i]) << 16;
+            g_2_pix_alloc[i] |= (g_2_pix_alloc[i]) << 16;
+            b_2_pix_alloc[i] |= (b_2_pix_alloc[i]) << 16;
         }
     }
 
-    /*
-     * Spread out the values we have to the rest of the array so that
-     * we do not need to check for overflow.
-     */
-    for (i = 0; i < 256; ++i) {
-        r_2_pix_alloc[i] = r_2_pix_alloc[256];
-        r_2_pix_alloc[i + 512] = r_2_pix_alloc[511];
-        g_2_pix_alloc[i] = g_2_pix_alloc[256];
-        g_2_pix_alloc[i + 512] = g_2_pix_alloc[511];
-        b_2_pix_alloc[i] = b_2_pix_alloc[256];
-        b_2_pix_alloc[i + 512] = b_2_pix_alloc[511];
+    /* Use the SIMD converters for 32-bit targets with whole byte channels */
+    swdata->ConvertRow = NULL;
+    conversion->r_pos = byte_position(Rmask);
+    conversion->g_pos = byte_position(Gmask);
+    conversion->b_pos = byte_position(Bmask);
+    conversion->a_pos = 6 - conversion->r_pos - conversion->g_pos - conversion->b_pos;
+    conversion->a_value = Amask ? 0xFF : 0x00;
+    if (SDL_BYTESPERPIXEL(target_format) == 4 &&
+        conversion->r_pos >= 0 && conversion->g_pos >= 0 &&
+        conversion->b_pos >= 0 &&
+        (!Amask || byte_position(Amask) == conversion->a_pos) &&
+        (swdata->w % 2) == 0 && (swdata->h % 2) == 0) {
+#if HAVE_AVX2_INTRINSICS
+        if (!swdata->ConvertRow && SDL_HasAVX2()) {
+            swdata->ConvertRow = ConvertRowYUVAVX2;
+        }
+#endif
+#if HAVE_SSE2_INTRINSICS
+        if (!swdata->ConvertRow && SDL_HasSSE2()) {
+            swdata->ConvertRow = ConvertRowYUVSSE2;
+        }
+#endif
+#if HAVE_NEON_INTRINSICS
+        if (!swdata->ConvertRow && SDL_HasNEON()) {
+            swdata->ConvertRow = ConvertRowYUVNEON;
+        }
+#endif
     }
 
     /* You have chosen wisely... */
     switch (swdata->format) {
     case SDL_PIXELFORMAT_YV12:
     case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
         if (SDL_BYTESPERPIXEL(target_format) == 2) {
 #ifdef USE_MMX_ASSEMBLY
             /* inline assembly functions */
@@ -1036,19 +1522,21 @@ SDL_SW_YUVTexture *
 SDL_SW_CreateYUVTexture(Uint32 format, int w, int h)
 {
     SDL_SW_YUVTexture *swdata;
-    int *Cr_r_tab;
-    int *Cr_g_tab;
-    int *Cb_g_tab;
-    int *Cb_b_tab;
-    int i;
-    int CR, CB;
+    size_t scratch_size;
 
     switch (format) {
     case SDL_PIXELFORMAT_YV12:
     case SDL_PIXELFORMAT_IYUV:
+        scratch_size = 0;
+        break;
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        scratch_size = (w / 2) * (h / 2) * 2;
+        break;
     case SDL_PIXELFORMAT_YUY2:
     case SDL_PIXELFORMAT_UYVY:
     case SDL_PIXELFORMAT_YVYU:
+        scratch_size = w * 3;
         break;
     default:
         SDL_SetError("Unsupported YUV format");
@@ -1068,28 +1556,16 @@ SDL_SW_CreateYUVTexture(Uint32 format, int w, int h)
     swdata->pixels = (Uint8 *) SDL_malloc(w * h * 2);
     swdata->colortab = (int *) SDL_malloc(4 * 256 * sizeof(int));
     swdata->rgb_2_pix = (Uint32 *) SDL_malloc(3 * 768 * sizeof(Uint32));
-    if (!swdata->pixels || !swdata->colortab || !swdata->rgb_2_pix) {
+    if (scratch_size) {
+        swdata->scratch = (Uint8 *) SDL_malloc(scratch_size);
+    }
+    if (!swdata->pixels || !swdata->colortab || !swdata->rgb_2_pix ||
+        (scratch_size && !swdata->scratch)) {
         SDL_SW_DestroyYUVTexture(swdata);
         SDL_OutOfMemory();
         return NULL;
     }
 
-    /* Generate the tables for the display surface */
-    Cr_r_tab = &swdata->colortab[0 * 256];
-    Cr_g_tab = &swdata->colortab[1 * 256];
-    Cb_g_tab = &swdata->colortab[2 * 256];
-    Cb_b_tab = &swdata->colortab[3 * 256];
-    for (i = 0; i < 256; i++) {
-        /* Gamma correction (luminescence table) and chroma correction
-           would be done here.  See the Berkeley mpeg_play sources.
-         */
-        CB = CR = (i - 128);
-        Cr_r_tab[i] = (int) ((0.419 / 0.299) * CR);
-        Cr_g_tab[i] = (int) (-(0.299 / 0.419) * CR);
-        Cb_g_tab[i] = (int) (-(0.114 / 0.331) * CB);
-        Cb_b_tab[i] = (int) ((0.587 / 0.331) * CB);
-    }
-
     /* Find the pitch and offset values for the overlay */
     switch (format) {
     case SDL_PIXELFORMAT_YV12:
@@ -1101,6 +1577,13 @@ SDL_SW_CreateYUVTexture(Uint32 format, int w, int h)
         swdata->planes[1] = swdata->planes[0] + swdata->pitches[0] * h;
         swdata->planes[2] = swdata->planes[1] + swdata->pitches[1] * h / 2;
         break;
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        swdata->pitches[0] = w;
+        swdata->pitches[1] = swdata->pitches[0];
+        swdata->planes[0] = swdata->pixels;
+        swdata->planes[1] = swdata->planes[0] + swdata->pitches[0] * h;
+        break;
     case SDL_PIXELFORMAT_YUY2:
     case SDL_PIXELFORMAT_UYVY:
     case SDL_PIXELFORMAT_YVYU:
@@ -1175,6 +1658,34 @@ SDL_SW_UpdateYUVTexture(SDL_SW_YUVTexture * swdata, const SDL_Rect * rect,
             }
         }
         break;
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        {
+            Uint8 *src, *dst;
+            int row;
+            size_t length;
+
+            /* Copy the Y plane */
+            src = (Uint8 *) pixels;
+            dst = swdata->planes[0] + rect->y * swdata->pitches[0] + rect->x;
+            length = rect->w;
+            for (row = 0; row < rect->h; ++row) {
+                SDL_memcpy(dst, src, length);
+                src += pitch;
+                dst += swdata->pitches[0];
+            }
+
+            /* Copy the interleaved chroma plane */
+            src = (Uint8 *) pixels + rect->h * pitch;
+            dst = swdata->planes[1] + rect->y/2 * swdata->pitches[1] + (rect->x/2) * 2;
+            length = (rect->w/2) * 2;
+            for (row = 0; row < rect->h/2; ++row) {
+                SDL_memcpy(dst, src, length);
+                src += pitch;
+                dst += swdata->pitches[1];
+            }
+        }
+        break;
     case SDL_PIXELFORMAT_YUY2:
     case SDL_PIXELFORMAT_UYVY:
     case SDL_PIXELFORMAT_YVYU:
@@ -1261,11 +1772,13 @@ SDL_SW_LockYUVTexture(SDL_SW_YUVTexture * swdata, const SDL_Rect * rect,
     switch (swdata->format) {
     case SDL_PIXELFORMAT_YV12:
     case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
         if (rect
             && (rect->x != 0 || rect->y != 0 || rect->w != swdata->w
                 || rect->h != swdata->h)) {
             return SDL_SetError
-                ("YV12 and IYUV textures only support full surface locks");
+                ("YV12, IYUV, NV12 and NV21 textures only support full surface locks");
         }
         break;
     }
@@ -1284,12 +1797,65 @@ SDL_SW_UnlockYUVTexture(SDL_SW_YUVTexture * swdata)
 {
 }
 
+/* Convert the texture a row at a time with the SIMD converter */
+static void
+SDL_SW_ConvertYUVRows(SDL_SW_YUVTexture * swdata, const Uint8 *lum,
+                      const Uint8 *cb, const Uint8 *cr, Uint8 *out, int pitch)
+{
+    const int w = swdata->w;
+    int y;
+
+    switch (swdata->format) {
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+        {
+            /* Take apart the packed pixels first */
+            const Uint8 *src = swdata->planes[0];
+            Uint8 *lum_row = swdata->scratch;
+            Uint8 *chroma_row = lum_row + w;
+            Uint8 *cb_row = chroma_row + w;
+            Uint8 *cr_row = cb_row + w / 2;
+
+            for (y = 0; y < swdata->h; ++y) {
+                if (swdata->format == SDL_PIXELFORMAT_UYVY) {
+                    SplitBytePairs(src, chroma_row, lum_row, w);
+                } else {
+                    SplitBytePairs(src, lum_row, chroma_row, w);
+                }
+                if (swdata->format == SDL_PIXELFORMAT_YVYU) {
+                    SplitBytePairs(chroma_row, cr_row, cb_row, w / 2);
+                } else {
+                    SplitBytePairs(chroma_row, cb_row, cr_row, w / 2);
+                }
+                swdata->ConvertRow(lum_row, cb_row, cr_row, out, w, &swdata->conversion);
+                src += swdata->pitches[0];
+                out += pitch;
+            }
+        }
+        break;
+    default:
+        /* The planar formats have a chroma row for every two rows */
+        for (y = 0; y < swdata->h; ++y) {
+            swdata->ConvertRow(lum, cb, cr, out, w, &swdata->conversion);
+            lum += w;
+            if (y & 1) {
+                cb += w / 2;
+                cr += w / 2;
+            }
+            out += pitch;
+        }
+        break;
+    }
+}
+
 int
 SDL_SW_CopyYUVToRGB(SDL_SW_YUVTexture * swdata, const SDL_Rect * srcrect,
                     Uint32 target_format, int w, int h, void *pixels,
                     int pitch)
 {
     const int targetbpp = SDL_BYTESPERPIXEL(target_format);
+    const SDL_YUV_CONVERSION_MODE mode = SDL_GetYUVConversionModeForResolution(swdata->w, swdata->h);
     int stretch;
     int scale_2x;
     Uint8 *lum, *Cr, *Cb;
@@ -1300,8 +1866,8 @@ SDL_SW_CopyYUVToRGB(SDL_SW_YUVTexture * swdata, const SDL_Rect * srcrect,
     }
 
     /* Make sure we're set up to display in the desired format */
-    if (target_format != swdata->target_format) {
-        if (SDL_SW_SetupYUVDisplay(swdata, target_format) < 0) {
+    if (target_format != swdata->target_format || mode != swdata->mode) {
+        if (SDL_SW_SetupYUVDisplay(swdata, target_format, mode) < 0) {
             return -1;
         }
     }
@@ -1368,6 +1934,26 @@ SDL_SW_CopyYUVToRGB(SDL_SW_YUVTexture * swdata, const SDL_Rect * srcrect,
         Cr = swdata->planes[2];
         Cb = swdata->planes[1];
         break;
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        {
+            /* Separate the chroma so it can be displayed like YV12 */
+            const Uint8 *src = swdata->planes[1];
+            int row;
+
+            lum = swdata->planes[0];
+            Cb = swdata->scratch;
+            Cr = Cb + (swdata->w / 2) * (swdata->h / 2);
+            for (row = 0; row < swdata->h / 2; ++row) {
+                if (swdata->format == SDL_PIXELFORMAT_NV12) {
+                    SplitBytePairs(src, Cb + row * (swdata->w / 2), Cr + row * (swdata->w / 2), swdata->w / 2);
+                } else {
+                    SplitBytePairs(src, Cr + row * (swdata->w / 2), Cb + row * (swdata->w / 2), swdata->w / 2);
+                }
+                src += swdata->pitches[1];
+            }
+        }
+        break;
     case SDL_PIXELFORMAT_YUY2:
         lum = swdata->planes[0];
         Cr = lum + 3;
@@ -1392,6 +1978,8 @@ SDL_SW_CopyYUVToRGB(SDL_SW_YUVTexture * swdata, const SDL_Rect * srcrect,
         mod -= (swdata->w * 2);
         swdata->Display2X(swdata->colortab, swdata->rgb_2_pix,
                           lum, Cr, Cb, pixels, swdata->h, swdata->w, mod);
+    } else if (swdata->ConvertRow) {
+        SDL_SW_ConvertYUVRows(swdata, lum, Cb, Cr, (Uint8 *) pixels, pitch);
     } else {
         mod -= swdata->w;
         swdata->Display1X(swdata->colortab, swdata->rgb_2_pix,
@@ -1411,6 +1999,7 @@ SDL_SW_DestroyYUVTexture(SDL_SW_YUVTexture * swdata)
         SDL_free(swdata->pixels);
         SDL_free(swdata->colortab);
         SDL_free(swdata->rgb_2_pix);
+        SDL_free(swdata->scratch);
         SDL_FreeSurface(swdata->stretch);
         SDL_FreeSurface(swdata->display);
         SDL_free(swdata);
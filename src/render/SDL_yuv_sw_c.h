@@ -24,14 +24,31 @@
 
 /* This is the software implementation of the YUV texture support */
 
+/* The YUV to RGB matrix in fixed point with 13 fractional bits, and where
+   the channels go in a 32-bit pixel with whole byte channels. */
+typedef struct
+{
+    int y_offset;
+    Sint16 y_mul;
+    Sint16 rv, gu, gv, bu;
+    SDL_bool jpeg;                      /* truncate like the legacy tables */
+    int r_pos, g_pos, b_pos, a_pos;     /* byte offsets in memory */
+    Uint8 a_value;
+} SDL_YUVConversion;
+
 struct SDL_SW_YUVTexture
 {
     Uint32 format;
     Uint32 target_format;
+    SDL_YUV_CONVERSION_MODE mode;
     int w, h;
     Uint8 *pixels;
     int *colortab;
     Uint32 *rgb_2_pix;
+    SDL_YUVConversion conversion;
+    void (*ConvertRow) (const Uint8 *lum, const Uint8 *cb, const Uint8 *cr,
+                        Uint8 *out, int cols,
+                        const SDL_YUVConversion * conversion);
     void (*Display1X) (int *colortab, Uint32 * rgb_2_pix,
                        unsigned char *lum, unsigned char *cr,
                        unsigned char *cb, unsigned char *out,
@@ -45,6 +62,10 @@ struct SDL_SW_YUVTexture
     Uint16 pitches[3];
     Uint8 *planes[3];
 
+    /* Planar chroma for NV12 and NV21, or deinterleaved rows of the packed
+       formats */
+    Uint8 *scratch;
+
     /* This is a temporary surface in case we have to stretch copy */
     SDL_Surface *stretch;
     SDL_Surface *display;
@@ -83,9 +83,14 @@ static int GL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
 static int GL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
                          const SDL_Rect * srcrect, const SDL_FRect * dstrect,
                          const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip);
+static int GL_RenderGeometry(SDL_Renderer * renderer, SDL_Texture * texture,
+                             const SDL_Vertex * vertices, int num_vertices,
+                             const int *indices, int num_indices);
 static int GL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                                Uint32 pixel_format, void * pixels, int pitch);
 static void GL_RenderPresent(SDL_Renderer * renderer);
+static int GL_RunCommandQueue(SDL_Renderer * renderer, const SDL_RenderCommand *cmd,
+                              int count, void *vertices, size_t vertsize);
 static void GL_DestroyTexture(SDL_Renderer * renderer, SDL_Texture * texture);
 static void GL_DestroyRenderer(SDL_Renderer * renderer);
 static int GL_BindTexture (SDL_Renderer * renderer, SDL_Texture *texture, float *texw, float *texh);
@@ -444,8 +449,10 @@ GL_CreateRenderer(SDL_Window * window, Uint32 flags)
     renderer->RenderFillRects = GL_RenderFillRects;
     renderer->RenderCopy = GL_RenderCopy;
     renderer->RenderCopyEx = GL_RenderCopyEx;
+    renderer->RenderGeometry = GL_RenderGeometry;
     renderer->RenderReadPixels = GL_RenderReadPixels;
     renderer->RenderPresent = GL_RenderPresent;
+    renderer->RunCommandQueue = GL_RunCommandQueue;
     renderer->DestroyTexture = GL_DestroyTexture;
     renderer->DestroyRenderer = GL_DestroyRenderer;
     renderer->GL_BindTexture = GL_BindTexture;
@@ -1072,7 +1079,7 @@ GL_SetRenderTarget(SDL_Renderer * renderer, SDL_Texture * texture)
 }
 
 static int
-GL_UpdateViewport(SDL_Renderer * renderer)
+GL_SetViewport(SDL_Renderer * renderer, const SDL_Rect * viewport)
 {
     GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
 
@@ -1082,29 +1089,29 @@ GL_UpdateViewport(SDL_Renderer * renderer)
     }
 
     if (renderer->target) {
-        data->glViewport(renderer->viewport.x, renderer->viewport.y,
-                         renderer->viewport.w, renderer->viewport.h);
+        data->glViewport(viewport->x, viewport->y,
+                         viewport->w, viewport->h);
     } else {
         int w, h;
 
         SDL_GL_GetDrawableSize(renderer->window, &w, &h);
-        data->glViewport(renderer->viewport.x, (h - renderer->viewport.y - renderer->viewport.h),
-                         renderer->viewport.w, renderer->viewport.h);
+        data->glViewport(viewport->x, (h - viewport->y - viewport->h),
+                         viewport->w, viewport->h);
     }
 
     data->glMatrixMode(GL_PROJECTION);
     data->glLoadIdentity();
-    if (renderer->viewport.w && renderer->viewport.h) {
+    if (viewport->w && viewport->h) {
         if (renderer->target) {
             data->glOrtho((GLdouble) 0,
-                          (GLdouble) renderer->viewport.w,
+                          (GLdouble) viewport->w,
                           (GLdouble) 0,
-                          (GLdouble) renderer->viewport.h,
+                          (GLdouble) viewport->h,
                            0.0, 1.0);
         } else {
             data->glOrtho((GLdouble) 0,
-                          (GLdouble) renderer->viewport.w,
-                          (GLdouble) renderer->viewport.h,
+                          (GLdouble) viewport->w,
+                          (GLdouble) viewport->h,
                           (GLdouble) 0,
                            0.0, 1.0);
         }
@@ -1115,20 +1122,26 @@ GL_UpdateViewport(SDL_Renderer * renderer)
 }
 
 static int
-GL_UpdateClipRect(SDL_Renderer * renderer)
+GL_UpdateViewport(SDL_Renderer * renderer)
+{
+    return GL_SetViewport(renderer, &renderer->viewport);
+}
+
+static int
+GL_SetClipRect(SDL_Renderer * renderer, const SDL_Rect * viewport,
+               SDL_bool clipping_enabled, const SDL_Rect * rect)
 {
     GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
 
-    if (renderer->clipping_enabled) {
-        const SDL_Rect *rect = &renderer->clip_rect;
+    if (clipping_enabled) {
         data->glEnable(GL_SCISSOR_TEST);
         if (renderer->target) {
-            data->glScissor(renderer->viewport.x + rect->x, renderer->viewport.y + rect->y, rect->w, rect->h);
+            data->glScissor(viewport->x + rect->x, viewport->y + rect->y, rect->w, rect->h);
         } else {
             int w, h;
 
             SDL_GL_GetDrawableSize(renderer->window, &w, &h);
-            data->glScissor(renderer->viewport.x + rect->x, h - renderer->viewport.y - rect->y - rect->h, rect->w, rect->h);
+            data->glScissor(viewport->x + rect->x, h - viewport->y - rect->y - rect->h, rect->w, rect->h);
         }
     } else {
         data->glDisable(GL_SCISSOR_TEST);
@@ -1136,6 +1149,13 @@ GL_UpdateClipRect(SDL_Renderer * renderer)
     return 0;
 }
 
+static int
+GL_UpdateClipRect(SDL_Renderer * renderer)
+{
+    return GL_SetClipRect(renderer, &renderer->viewport,
+                          renderer->clipping_enabled, &renderer->clip_rect);
+}
+
 static void
 GL_SetShader(GL_RenderData * data, GL_Shader shader)
 {
@@ -1194,58 +1214,69 @@ GL_SetDrawingState(SDL_Renderer * renderer)
     GL_SetShader(data, SHADER_SOLID);
 }
 
-static int
-GL_RenderClear(SDL_Renderer * renderer)
+static void
+GL_Clear(GL_RenderData * data, Uint8 r, Uint8 g, Uint8 b, Uint8 a,
+         SDL_bool clipping_enabled)
 {
-    GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
-
-    GL_ActivateRenderer(renderer);
-
-    data->glClearColor((GLfloat) renderer->r * inv255f,
-                       (GLfloat) renderer->g * inv255f,
-                       (GLfloat) renderer->b * inv255f,
-                       (GLfloat) renderer->a * inv255f);
+    data->glClearColor((GLfloat) r * inv255f,
+                       (GLfloat) g * inv255f,
+                       (GLfloat) b * inv255f,
+                       (GLfloat) a * inv255f);
 
-    if (renderer->clipping_enabled) {
+    if (clipping_enabled) {
         data->glDisable(GL_SCISSOR_TEST);
     }
 
     data->glClear(GL_COLOR_BUFFER_BIT);
 
-    if (renderer->clipping_enabled) {
+    if (clipping_enabled) {
         data->glEnable(GL_SCISSOR_TEST);
     }
-
-    return 0;
 }
 
 static int
-GL_RenderDrawPoints(SDL_Renderer * renderer, const SDL_FPoint * points,
-                    int count)
+GL_RenderClear(SDL_Renderer * renderer)
 {
     GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
-    int i;
 
-    GL_SetDrawingState(renderer);
+    GL_ActivateRenderer(renderer);
+
+    GL_Clear(data, renderer->r, renderer->g, renderer->b, renderer->a,
+             renderer->clipping_enabled);
+
+    return 0;
+}
+
+static void
+GL_DrawPoints(GL_RenderData * data, const SDL_FPoint * points, int count)
+{
+    int i;
 
     data->glBegin(GL_POINTS);
     for (i = 0; i < count; ++i) {
         data->glVertex2f(0.5f + points[i].x, 0.5f + points[i].y);
     }
     data->glEnd();
-
-    return 0;
 }
 
 static int
-GL_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
-                   int count)
+GL_RenderDrawPoints(SDL_Renderer * renderer, const SDL_FPoint * points,
+                    int count)
 {
     GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
-    int i;
 
     GL_SetDrawingState(renderer);
 
+    GL_DrawPoints(data, points, count);
+
+    return 0;
+}
+
+static void
+GL_DrawLines(GL_RenderData * data, const SDL_FPoint * points, int count)
+{
+    int i;
+
     if (count > 2 &&
         points[0].x == points[count-1].x && points[0].y == points[count-1].y) {
         data->glBegin(GL_LINE_LOOP);
@@ -1298,27 +1329,48 @@ GL_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
 #endif
         data->glEnd();
     }
-    return GL_CheckError("", renderer);
 }
 
 static int
-GL_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
+GL_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
+                   int count)
 {
     GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
-    int i;
 
     GL_SetDrawingState(renderer);
 
+    GL_DrawLines(data, points, count);
+
+    return GL_CheckError("", renderer);
+}
+
+static void
+GL_FillRects(GL_RenderData * data, const SDL_FRect * rects, int count)
+{
+    int i;
+
     for (i = 0; i < count; ++i) {
         const SDL_FRect *rect = &rects[i];
 
         data->glRectf(rect->x, rect->y, rect->x + rect->w, rect->y + rect->h);
     }
+}
+
+static int
+GL_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
+{
+    GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
+
+    GL_SetDrawingState(renderer);
+
+    GL_FillRects(data, rects, count);
+
     return GL_CheckError("", renderer);
 }
 
 static int
-GL_SetupCopy(SDL_Renderer * renderer, SDL_Texture * texture)
+GL_SetupCopy(SDL_Renderer * renderer, SDL_Texture * texture,
+             Uint8 r, Uint8 g, Uint8 b, Uint8 a, SDL_BlendMode blendMode)
 {
     GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
     GL_TextureData *texturedata = (GL_TextureData *) texture->driverdata;
@@ -1341,13 +1393,9 @@ GL_SetupCopy(SDL_Renderer * renderer, SDL_Texture * texture)
     }
     data->glBindTexture(texturedata->type, texturedata->texture);
 
-    if (texture->modMode) {
-        GL_SetColor(data, texture->r, texture->g, texture->b, texture->a);
-    } else {
-        GL_SetColor(data, 255, 255, 255, 255);
-    }
+    GL_SetColor(data, r, g, b, a);
 
-    GL_SetBlendMode(data, texture->blendMode);
+    GL_SetBlendMode(data, blendMode);
 
     if (texturedata->yuv) {
         GL_SetShader(data, SHADER_YUV);
@@ -1374,7 +1422,8 @@ GL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
 
     GL_ActivateRenderer(renderer);
 
-    if (GL_SetupCopy(renderer, texture) < 0) {
+    if (GL_SetupCopy(renderer, texture, texture->r, texture->g, texture->b,
+                     texture->a, texture->blendMode) < 0) {
         return -1;
     }
 
@@ -1421,7 +1470,8 @@ GL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
 
     GL_ActivateRenderer(renderer);
 
-    if (GL_SetupCopy(renderer, texture) < 0) {
+    if (GL_SetupCopy(renderer, texture, texture->r, texture->g, texture->b,
+                     texture->a, texture->blendMode) < 0) {
         return -1;
     }
 
@@ -1477,6 +1527,237 @@ GL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
     return GL_CheckError("", renderer);
 }
 
+static void
+GL_Geometry(SDL_Renderer * renderer, SDL_Texture * texture,
+            const SDL_Vertex * vertices, const int *indices, int count,
+            Uint8 r, Uint8 g, Uint8 b, Uint8 a, SDL_BlendMode blendMode)
+{
+    GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
+    GL_TextureData *texturedata = NULL;
+    GLfloat texw = 0.0f, texh = 0.0f;
+    int i;
+
+    if (texture) {
+        texturedata = (GL_TextureData *) texture->driverdata;
+        texw = texturedata->texw;
+        texh = texturedata->texh;
+        GL_SetupCopy(renderer, texture, r, g, b, a, blendMode);
+    } else {
+        GL_SetBlendMode(data, blendMode);
+        GL_SetShader(data, SHADER_SOLID);
+    }
+
+    data->glBegin(GL_TRIANGLES);
+    for (i = 0; i < count; ++i) {
+        const SDL_Vertex *vertex = &vertices[indices ? indices[i] : i];
+
+        /* The texture modulation is folded into the vertex color */
+        GL_SetColor(data, (Uint8) ((vertex->color.r * r) / 255),
+                          (Uint8) ((vertex->color.g * g) / 255),
+                          (Uint8) ((vertex->color.b * b) / 255),
+                          (Uint8) ((vertex->color.a * a) / 255));
+        if (texture) {
+            data->glTexCoord2f(vertex->u * texw, vertex->v * texh);
+        }
+        data->glVertex2f(vertex->x, vertex->y);
+    }
+    data->glEnd();
+
+    if (texture) {
+        data->glDisable(texturedata->type);
+    }
+}
+
+static int
+GL_RenderGeometry(SDL_Renderer * renderer, SDL_Texture * texture,
+                  const SDL_Vertex * vertices, int num_vertices,
+                  const int *indices, int num_indices)
+{
+    GL_ActivateRenderer(renderer);
+
+    if (texture) {
+        GL_Geometry(renderer, texture, vertices, indices,
+                    indices ? num_indices : num_vertices,
+                    texture->r, texture->g, texture->b, texture->a,
+                    texture->blendMode);
+    } else {
+        GL_Geometry(renderer, NULL, vertices, indices,
+                    indices ? num_indices : num_vertices,
+                    255, 255, 255, 255, renderer->blendMode);
+    }
+
+    return GL_CheckError("", renderer);
+}
+
+static void
+GL_CopyQuads(GL_RenderData * data, SDL_Texture * texture,
+             const SDL_RenderCopyData * copy, int count)
+{
+    GL_TextureData *texturedata = (GL_TextureData *) texture->driverdata;
+    const GLfloat texw = texturedata->texw / texture->w;
+    const GLfloat texh = texturedata->texh / texture->h;
+    int i;
+
+    /* One begin/end pair for the whole batch of copies from this texture */
+    data->glBegin(GL_QUADS);
+    for (i = 0; i < count; ++i, ++copy) {
+        const GLfloat minx = copy->dstrect.x;
+        const GLfloat miny = copy->dstrect.y;
+        const GLfloat maxx = copy->dstrect.x + copy->dstrect.w;
+        const GLfloat maxy = copy->dstrect.y + copy->dstrect.h;
+        const GLfloat minu = (GLfloat) copy->srcrect.x * texw;
+        const GLfloat maxu = (GLfloat) (copy->srcrect.x + copy->srcrect.w) * texw;
+        const GLfloat minv = (GLfloat) copy->srcrect.y * texh;
+        const GLfloat maxv = (GLfloat) (copy->srcrect.y + copy->srcrect.h) * texh;
+
+        data->glTexCoord2f(minu, minv);
+        data->glVertex2f(minx, miny);
+        data->glTexCoord2f(maxu, minv);
+        data->glVertex2f(maxx, miny);
+        data->glTexCoord2f(maxu, maxv);
+        data->glVertex2f(maxx, maxy);
+        data->glTexCoord2f(minu, maxv);
+        data->glVertex2f(minx, maxy);
+    }
+    data->glEnd();
+}
+
+static int
+GL_RunCommandQueue(SDL_Renderer * renderer, const SDL_RenderCommand *cmd,
+                   int count, void *vertices, size_t vertsize)
+{
+    GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
+    SDL_Rect viewport = renderer->viewport;
+    SDL_bool clipping_enabled = renderer->clipping_enabled;
+
+    if (GL_ActivateRenderer(renderer) < 0) {
+        return -1;
+    }
+
+    for (; count > 0; --count, ++cmd) {
+        const void *verts = NULL;
+        int num = 0;
+
+        if (cmd->command >= SDL_RENDERCMD_DRAW_POINTS) {
+            verts = (const Uint8 *) vertices + cmd->data.draw.first;
+            num = (int) cmd->data.draw.count;
+        }
+
+        switch (cmd->command) {
+            case SDL_RENDERCMD_SETVIEWPORT:
+                viewport = cmd->data.viewport.rect;
+                GL_SetViewport(renderer, &viewport);
+                break;
+
+            case SDL_RENDERCMD_SETCLIPRECT:
+                clipping_enabled = cmd->data.cliprect.enabled;
+                GL_SetClipRect(renderer, &viewport, clipping_enabled,
+                               &cmd->data.cliprect.rect);
+                break;
+
+            case SDL_RENDERCMD_CLEAR:
+                GL_Clear(data, cmd->data.color.r, cmd->data.color.g,
+                         cmd->data.color.b, cmd->data.color.a, clipping_enabled);
+                break;
+
+            case SDL_RENDERCMD_DRAW_POINTS:
+            case SDL_RENDERCMD_DRAW_LINES:
+            case SDL_RENDERCMD_FILL_RECTS:
+                GL_SetColor(data, cmd->data.draw.r, cmd->data.draw.g,
+                            cmd->data.draw.b, cmd->data.draw.a);
+                GL_SetBlendMode(data, cmd->data.draw.blend);
+                GL_SetShader(data, SHADER_SOLID);
+                if (cmd->command == SDL_RENDERCMD_DRAW_POINTS) {
+                    GL_DrawPoints(data, (const SDL_FPoint *) verts, num);
+                } else if (cmd->command == SDL_RENDERCMD_DRAW_LINES) {
+                    GL_DrawLines(data, (const SDL_FPoint *) verts, num);
+                } else {
+                    GL_FillRects(data, (const SDL_FRect *) verts, num);
+                }
+                break;
+
+            case SDL_RENDERCMD_COPY: {
+                SDL_Texture *texture = cmd->data.draw.texture;
+                GL_TextureData *texturedata = (GL_TextureData *) texture->driverdata;
+
+                GL_SetupCopy(renderer, texture, cmd->data.draw.r, cmd->data.draw.g,
+                             cmd->data.draw.b, cmd->data.draw.a, cmd->data.draw.blend);
+                GL_CopyQuads(data, texture, (const SDL_RenderCopyData *) verts, num);
+                data->glDisable(texturedata->type);
+                break;
+            }
+
+            case SDL_RENDERCMD_COPY_EX: {
+                SDL_Texture *texture = cmd->data.draw.texture;
+                GL_TextureData *texturedata = (GL_TextureData *) texture->driverdata;
+                const SDL_RenderCopyExData *copy = (const SDL_RenderCopyExData *) verts;
+                int i;
+
+                GL_SetupCopy(renderer, texture, cmd->data.draw.r, cmd->data.draw.g,
+                             cmd->data.draw.b, cmd->data.draw.a, cmd->data.draw.blend);
+                for (i = 0; i < num; ++i, ++copy) {
+                    GLfloat minx, miny, maxx, maxy;
+                    GLfloat minu, maxu, minv, maxv;
+                    const GLfloat centerx = copy->center.x;
+                    const GLfloat centery = copy->center.y;
+
+                    if (copy->flip & SDL_FLIP_HORIZONTAL) {
+                        minx =  copy->dstrect.w - centerx;
+                        maxx = -centerx;
+                    } else {
+                        minx = -centerx;
+                        maxx =  copy->dstrect.w - centerx;
+                    }
+
+                    if (copy->flip & SDL_FLIP_VERTICAL) {
+                        miny =  copy->dstrect.h - centery;
+                        maxy = -centery;
+                    } else {
+                        miny = -centery;
+                        maxy =  copy->dstrect.h - centery;
+                    }
+
+                    minu = (GLfloat) copy->srcrect.x / texture->w * texturedata->texw;
+                    maxu = (GLfloat) (copy->srcrect.x + copy->srcrect.w) / texture->w * texturedata->texw;
+                    minv = (GLfloat) copy->srcrect.y / texture->h * texturedata->texh;
+                    maxv = (GLfloat) (copy->srcrect.y + copy->srcrect.h) / texture->h * texturedata->texh;
+
+                    data->glPushMatrix();
+                    data->glTranslatef(copy->dstrect.x + centerx, copy->dstrect.y + centery, 0.0f);
+                    data->glRotated(copy->angle, 0.0, 0.0, 1.0);
+
+                    data->glBegin(GL_TRIANGLE_STRIP);
+                    data->glTexCoord2f(minu, minv);
+                    data->glVertex2f(minx, miny);
+                    data->glTexCoord2f(maxu, minv);
+                    data->glVertex2f(maxx, miny);
+                    data->glTexCoord2f(minu, maxv);
+                    data->glVertex2f(minx, maxy);
+                    data->glTexCoord2f(maxu, maxv);
+                    data->glVertex2f(maxx, maxy);
+                    data->glEnd();
+                    data->glPopMatrix();
+                }
+                data->glDisable(texturedata->type);
+                break;
+            }
+
+            case SDL_RENDERCMD_GEOMETRY:
+                GL_Geometry(renderer, cmd->data.draw.texture,
+                            (const SDL_Vertex *) verts, NULL, num,
+                            cmd->data.draw.r, cmd->data.draw.g,
+                            cmd->data.draw.b, cmd->data.draw.a,
+                            cmd->data.draw.blend);
+                break;
+
+            case SDL_RENDERCMD_NO_OP:
+                break;
+        }
+    }
+
+    return GL_CheckError("", renderer);
+}
+
 static int
 GL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                     Uint32 pixel_format, void * pixels, int pitch)
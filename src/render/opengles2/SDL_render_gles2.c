@@ -145,6 +145,7 @@ typedef enum
     GLES2_ATTRIBUTE_TEXCOORD = 1,
     GLES2_ATTRIBUTE_ANGLE = 2,
     GLES2_ATTRIBUTE_CENTER = 3,
+    GLES2_ATTRIBUTE_COLOR = 4,
 } GLES2_Attribute;
 
 typedef enum
@@ -193,9 +194,16 @@ typedef struct GLES2_DriverContext
     GLES2_ProgramCacheEntry *current_program;
     Uint8 clear_r, clear_g, clear_b, clear_a;
 
+    /* The viewport the current projection is built from */
+    SDL_Rect viewport;
+
+    /* Scratch space for expanding queued render commands into vertices */
+    GLfloat *batch_vertices;
+    size_t batch_vertices_allocation;
+
 #if SDL_GLES2_USE_VBOS
-    GLuint vertex_buffers[4];
-    GLsizeiptr vertex_buffer_size[4];
+    GLuint vertex_buffers[5];
+    GLsizeiptr vertex_buffer_size[5];
 #endif
 } GLES2_DriverContext;
 
@@ -435,24 +443,26 @@ GLES2_SupportsBlendMode(SDL_Renderer * renderer, SDL_BlendMode blendMode)
 }
 
 static int
-GLES2_UpdateViewport(SDL_Renderer * renderer)
+GLES2_SetViewport(SDL_Renderer * renderer, const SDL_Rect * viewport)
 {
     GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
 
+    data->viewport = *viewport;
+
     if (SDL_CurrentContext != data->context) {
         /* We'll update the viewport after we rebind the context */
         return 0;
     }
 
     if (renderer->target) {
-        data->glViewport(renderer->viewport.x, renderer->viewport.y,
-                         renderer->viewport.w, renderer->viewport.h);
+        data->glViewport(viewport->x, viewport->y,
+                         viewport->w, viewport->h);
     } else {
         int w, h;
 
         SDL_GL_GetDrawableSize(renderer->window, &w, &h);
-        data->glViewport(renderer->viewport.x, (h - renderer->viewport.y - renderer->viewport.h),
-                         renderer->viewport.w, renderer->viewport.h);
+        data->glViewport(viewport->x, (h - viewport->y - viewport->h),
+                         viewport->w, viewport->h);
     }
 
     if (data->current_program) {
@@ -462,7 +472,14 @@ GLES2_UpdateViewport(SDL_Renderer * renderer)
 }
 
 static int
-GLES2_UpdateClipRect(SDL_Renderer * renderer)
+GLES2_UpdateViewport(SDL_Renderer * renderer)
+{
+    return GLES2_SetViewport(renderer, &renderer->viewport);
+}
+
+static int
+GLES2_SetClipRect(SDL_Renderer * renderer, const SDL_Rect * viewport,
+                  SDL_bool clipping_enabled, const SDL_Rect * rect)
 {
     GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
 
@@ -471,16 +488,15 @@ GLES2_UpdateClipRect(SDL_Renderer * renderer)
         return 0;
     }
 
-    if (renderer->clipping_enabled) {
-        const SDL_Rect *rect = &renderer->clip_rect;
+    if (clipping_enabled) {
         data->glEnable(GL_SCISSOR_TEST);
         if (renderer->target) {
-            data->glScissor(renderer->viewport.x + rect->x, renderer->viewport.y + rect->y, rect->w, rect->h);
+            data->glScissor(viewport->x + rect->x, viewport->y + rect->y, rect->w, rect->h);
         } else {
             int w, h;
 
             SDL_GL_GetDrawableSize(renderer->window, &w, &h);
-            data->glScissor(renderer->viewport.x + rect->x, h - renderer->viewport.y - rect->y - rect->h, rect->w, rect->h);
+            data->glScissor(viewport->x + rect->x, h - viewport->y - rect->y - rect->h, rect->w, rect->h);
         }
     } else {
         data->glDisable(GL_SCISSOR_TEST);
@@ -488,6 +504,13 @@ GLES2_UpdateClipRect(SDL_Renderer * renderer)
     return 0;
 }
 
+static int
+GLES2_UpdateClipRect(SDL_Renderer * renderer)
+{
+    return GLES2_SetClipRect(renderer, &renderer->viewport,
+                             renderer->clipping_enabled, &renderer->clip_rect);
+}
+
 static void
 GLES2_DestroyRenderer(SDL_Renderer *renderer)
 {
@@ -530,6 +553,7 @@ GLES2_DestroyRenderer(SDL_Renderer *renderer)
             SDL_GL_DeleteContext(data->context);
         }
         SDL_free(data->shader_formats);
+        SDL_free(data->batch_vertices);
         SDL_free(data);
     }
     SDL_free(renderer);
@@ -1001,6 +1025,7 @@ GLES2_CacheProgram(SDL_Renderer *renderer, GLES2_ShaderCacheEntry *vertex,
     data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_TEXCOORD, "a_texCoord");
     data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_ANGLE, "a_angle");
     data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_CENTER, "a_center");
+    data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_COLOR, "a_color");
     data->glLinkProgram(entry->id);
     data->glGetProgramiv(entry->id, GL_LINK_STATUS, &linkSuccessful);
     if (!linkSuccessful) {
@@ -1278,22 +1303,23 @@ static int
 GLES2_SetOrthographicProjection(SDL_Renderer *renderer)
 {
     GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    const SDL_Rect *viewport = &data->viewport;
     GLfloat projection[4][4];
 
-    if (!renderer->viewport.w || !renderer->viewport.h) {
+    if (!viewport->w || !viewport->h) {
         return 0;
     }
 
     /* Prepare an orthographic projection */
-    projection[0][0] = 2.0f / renderer->viewport.w;
+    projection[0][0] = 2.0f / viewport->w;
     projection[0][1] = 0.0f;
     projection[0][2] = 0.0f;
     projection[0][3] = 0.0f;
     projection[1][0] = 0.0f;
     if (renderer->target) {
-        projection[1][1] = 2.0f / renderer->viewport.h;
+        projection[1][1] = 2.0f / viewport->h;
     } else {
-        projection[1][1] = -2.0f / renderer->viewport.h;
+        projection[1][1] = -2.0f / viewport->h;
     }
     projection[1][2] = 0.0f;
     projection[1][3] = 0.0f;
@@ -1335,9 +1361,14 @@ static int GLES2_RenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const
 static int GLES2_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
                          const SDL_Rect * srcrect, const SDL_FRect * dstrect,
                          const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip);
+static int GLES2_RenderGeometry(SDL_Renderer * renderer, SDL_Texture * texture,
+                                const SDL_Vertex * vertices, int num_vertices,
+                                const int *indices, int num_indices);
 static int GLES2_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                     Uint32 pixel_format, void * pixels, int pitch);
 static void GLES2_RenderPresent(SDL_Renderer *renderer);
+static int GLES2_RunCommandQueue(SDL_Renderer * renderer, const SDL_RenderCommand *cmd,
+                                 int count, void *vertices, size_t vertsize);
 
 static SDL_bool
 CompareColors(Uint8 r1, Uint8 g1, Uint8 b1, Uint8 a1,
@@ -1349,51 +1380,59 @@ CompareColors(Uint8 r1, Uint8 g1, Uint8 b1, Uint8 a1,
     return (Pixel1 == Pixel2);
 }
 
-static int
-GLES2_RenderClear(SDL_Renderer * renderer)
+static void
+GLES2_Clear(SDL_Renderer * renderer, Uint8 cr, Uint8 cg, Uint8 cb, Uint8 ca,
+            SDL_bool clipping_enabled)
 {
     Uint8 r, g, b, a;
 
     GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
 
-    GLES2_ActivateRenderer(renderer);
-
     if (!CompareColors(data->clear_r, data->clear_g, data->clear_b, data->clear_a,
-                        renderer->r, renderer->g, renderer->b, renderer->a)) {
+                        cr, cg, cb, ca)) {
 
        /* Select the color to clear with */
-       g = renderer->g;
-       a = renderer->a;
+       g = cg;
+       a = ca;
    
        if (renderer->target &&
             (renderer->target->format == SDL_PIXELFORMAT_ARGB8888 ||
              renderer->target->format == SDL_PIXELFORMAT_RGB888)) {
-           r = renderer->b;
-           b = renderer->r;
+           r = cb;
+           b = cr;
         } else {
-           r = renderer->r;
-           b = renderer->b;
+           r = cr;
+           b = cb;
         }
 
         data->glClearColor((GLfloat) r * inv255f,
                      (GLfloat) g * inv255f,
                      (GLfloat) b * inv255f,
                      (GLfloat) a * inv255f);
-        data->clear_r = renderer->r;
-        data->clear_g = renderer->g;
-        data->clear_b = renderer->b;
-        data->clear_a = renderer->a;
+        data->clear_r = cr;
+        data->clear_g = cg;
+        data->clear_b = cb;
+        data->clear_a = ca;
     }
 
-    if (renderer->clipping_enabled) {
+    if (clipping_enabled) {
         data->glDisable(GL_SCISSOR_TEST);
     }
 
     data->glClear(GL_COLOR_BUFFER_BIT);
 
-    if (renderer->clipping_enabled) {
+    if (clipping_enabled) {
         data->glEnable(GL_SCISSOR_TEST);
     }
+}
+
+static int
+GLES2_RenderClear(SDL_Renderer * renderer)
+{
+    GLES2_ActivateRenderer(renderer);
+
+    GLES2_Clear(renderer, renderer->r, renderer->g, renderer->b, renderer->a,
+                renderer->clipping_enabled);
 
     return 0;
 }
@@ -1431,15 +1470,14 @@ GLES2_SetTexCoords(GLES2_DriverContext * data, SDL_bool enabled)
 }
 
 static int
-GLES2_SetDrawingState(SDL_Renderer * renderer)
+GLES2_SetSolidState(SDL_Renderer * renderer, Uint8 dr, Uint8 dg, Uint8 db, Uint8 da,
+                    SDL_BlendMode blendMode)
 {
     GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
     GLES2_ProgramCacheEntry *program;
     Uint8 r, g, b, a;
 
-    GLES2_ActivateRenderer(renderer);
-
-    GLES2_SetBlendMode(data, renderer->blendMode);
+    GLES2_SetBlendMode(data, blendMode);
 
     GLES2_SetTexCoords(data, SDL_FALSE);
 
@@ -1449,17 +1487,17 @@ GLES2_SetDrawingState(SDL_Renderer * renderer)
     }
 
     /* Select the color to draw with */
-    g = renderer->g;
-    a = renderer->a;
+    g = dg;
+    a = da;
 
     if (renderer->target &&
          (renderer->target->format == SDL_PIXELFORMAT_ARGB8888 ||
          renderer->target->format == SDL_PIXELFORMAT_RGB888)) {
-        r = renderer->b;
-        b = renderer->r;
+        r = db;
+        b = dr;
      } else {
-        r = renderer->r;
-        b = renderer->b;
+        r = dr;
+        b = db;
      }
 
     program = data->current_program;
@@ -1475,14 +1513,24 @@ GLES2_SetDrawingState(SDL_Renderer * renderer)
     return 0;
 }
 
+static int
+GLES2_SetDrawingState(SDL_Renderer * renderer)
+{
+    GLES2_ActivateRenderer(renderer);
+
+    return GLES2_SetSolidState(renderer, renderer->r, renderer->g, renderer->b,
+                               renderer->a, renderer->blendMode);
+}
+
 static int
 GLES2_UpdateVertexBuffer(SDL_Renderer *renderer, GLES2_Attribute attr,
                          const void *vertexData, size_t dataSizeInBytes)
 {
     GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    const GLint size = (attr == GLES2_ATTRIBUTE_ANGLE) ? 1 : (attr == GLES2_ATTRIBUTE_COLOR) ? 4 : 2;
 
 #if !SDL_GLES2_USE_VBOS
-    data->glVertexAttribPointer(attr, attr == GLES2_ATTRIBUTE_ANGLE ? 1 : 2, GL_FLOAT, GL_FALSE, 0, vertexData);
+    data->glVertexAttribPointer(attr, size, GL_FLOAT, GL_FALSE, 0, vertexData);
 #else
     if (!data->vertex_buffers[attr]) {
         data->glGenBuffers(1, &data->vertex_buffers[attr]);
@@ -1497,7 +1545,7 @@ GLES2_UpdateVertexBuffer(SDL_Renderer *renderer, GLES2_Attribute attr,
         data->glBufferSubData(GL_ARRAY_BUFFER, 0, dataSizeInBytes, vertexData);
     }
 
-    data->glVertexAttribPointer(attr, attr == GLES2_ATTRIBUTE_ANGLE ? 1 : 2, GL_FLOAT, GL_FALSE, 0, 0);
+    data->glVertexAttribPointer(attr, size, GL_FLOAT, GL_FALSE, 0, 0);
 #endif
 
     return 0;
@@ -1600,7 +1648,8 @@ GLES2_RenderFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, int count)
 }
 
 static int
-GLES2_SetupCopy(SDL_Renderer *renderer, SDL_Texture *texture)
+GLES2_SetupCopy(SDL_Renderer *renderer, SDL_Texture *texture,
+                Uint8 mr, Uint8 mg, Uint8 mb, Uint8 ma, SDL_BlendMode blendMode)
 {
     GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
     GLES2_TextureData *tdata = (GLES2_TextureData *)texture->driverdata;
@@ -1729,17 +1778,17 @@ GLES2_SetupCopy(SDL_Renderer *renderer, SDL_Texture *texture)
     data->glBindTexture(tdata->texture_type, tdata->texture);
 
     /* Configure color modulation */
-    g = texture->g;
-    a = texture->a;
+    g = mg;
+    a = ma;
 
     if (renderer->target &&
         (renderer->target->format == SDL_PIXELFORMAT_ARGB8888 ||
          renderer->target->format == SDL_PIXELFORMAT_RGB888)) {
-        r = texture->b;
-        b = texture->r;
+        r = mb;
+        b = mr;
     } else {
-        r = texture->r;
-        b = texture->b;
+        r = mr;
+        b = mb;
     }
 
     program = data->current_program;
@@ -1753,7 +1802,7 @@ GLES2_SetupCopy(SDL_Renderer *renderer, SDL_Texture *texture)
     }
 
     /* Configure texture blending */
-    GLES2_SetBlendMode(data, texture->blendMode);
+    GLES2_SetBlendMode(data, blendMode);
 
     GLES2_SetTexCoords(data, SDL_TRUE);
     return 0;
@@ -1769,7 +1818,8 @@ GLES2_RenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *s
 
     GLES2_ActivateRenderer(renderer);
 
-    if (GLES2_SetupCopy(renderer, texture) < 0) {
+    if (GLES2_SetupCopy(renderer, texture, texture->r, texture->g, texture->b,
+                        texture->a, texture->blendMode) < 0) {
         return -1;
     }
 
@@ -1812,7 +1862,8 @@ GLES2_RenderCopyEx(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect
 
     GLES2_ActivateRenderer(renderer);
 
-    if (GLES2_SetupCopy(renderer, texture) < 0) {
+    if (GLES2_SetupCopy(renderer, texture, texture->r, texture->g, texture->b,
+                        texture->a, texture->blendMode) < 0) {
         return -1;
     }
 
@@ -1868,6 +1919,377 @@ GLES2_RenderCopyEx(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect
     return GL_CheckError("", renderer);
 }
 
+static GLfloat *
+GLES2_GetBatchVertices(GLES2_DriverContext *data, size_t count)
+{
+    if (count > data->batch_vertices_allocation) {
+        size_t newsize = data->batch_vertices_allocation ? data->batch_vertices_allocation : 1024;
+        GLfloat *ptr;
+
+        while (newsize < count) {
+            newsize *= 2;
+        }
+        ptr = (GLfloat *) SDL_realloc(data->batch_vertices, newsize * sizeof (GLfloat));
+        if (!ptr) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        data->batch_vertices = ptr;
+        data->batch_vertices_allocation = newsize;
+    }
+    return data->batch_vertices;
+}
+
+/* Write the two triangles covering a quad, corners given in strip order */
+static GLfloat *
+GLES2_EmitQuad(GLfloat *v, GLfloat x0, GLfloat y0, GLfloat x1, GLfloat y1,
+               GLfloat x2, GLfloat y2, GLfloat x3, GLfloat y3)
+{
+    *(v++) = x0; *(v++) = y0;
+    *(v++) = x1; *(v++) = y1;
+    *(v++) = x2; *(v++) = y2;
+    *(v++) = x2; *(v++) = y2;
+    *(v++) = x1; *(v++) = y1;
+    *(v++) = x3; *(v++) = y3;
+    return v;
+}
+
+static int
+GLES2_BatchPoints(SDL_Renderer *renderer, const SDL_FPoint *points, int count, GLenum mode)
+{
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    GLfloat *vertices = GLES2_GetBatchVertices(data, count * 2);
+    int idx;
+
+    if (!vertices) {
+        return -1;
+    }
+
+    for (idx = 0; idx < count; ++idx) {
+        vertices[idx * 2] = points[idx].x + 0.5f;
+        vertices[(idx * 2) + 1] = points[idx].y + 0.5f;
+    }
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_POSITION, vertices, count * 2 * sizeof(GLfloat));
+    data->glDrawArrays(mode, 0, count);
+
+    /* We need to close the endpoint of the line */
+    if (mode == GL_LINE_STRIP &&
+        (count == 2 ||
+         points[0].x != points[count-1].x || points[0].y != points[count-1].y)) {
+        data->glDrawArrays(GL_POINTS, count-1, 1);
+    }
+    return 0;
+}
+
+static int
+GLES2_BatchFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, int count)
+{
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    GLfloat *vertices = GLES2_GetBatchVertices(data, count * 12);
+    GLfloat *v = vertices;
+    int idx;
+
+    if (!vertices) {
+        return -1;
+    }
+
+    for (idx = 0; idx < count; ++idx) {
+        const SDL_FRect *rect = &rects[idx];
+        const GLfloat xMin = rect->x;
+        const GLfloat xMax = (rect->x + rect->w);
+        const GLfloat yMin = rect->y;
+        const GLfloat yMax = (rect->y + rect->h);
+
+        v = GLES2_EmitQuad(v, xMin, yMin, xMax, yMin, xMin, yMax, xMax, yMax);
+    }
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_POSITION, vertices, count * 12 * sizeof(GLfloat));
+    data->glDrawArrays(GL_TRIANGLES, 0, count * 6);
+    return 0;
+}
+
+static int
+GLES2_BatchCopy(SDL_Renderer *renderer, SDL_Texture *texture,
+                const SDL_RenderCopyData *copy, int count)
+{
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    GLfloat *vertices = GLES2_GetBatchVertices(data, count * 24);
+    GLfloat *texCoords;
+    GLfloat *v, *t;
+    int idx;
+
+    if (!vertices) {
+        return -1;
+    }
+    texCoords = vertices + count * 12;
+
+    v = vertices;
+    t = texCoords;
+    for (idx = 0; idx < count; ++idx, ++copy) {
+        const SDL_FRect *dstrect = &copy->dstrect;
+        const SDL_Rect *srcrect = &copy->srcrect;
+        const GLfloat minu = srcrect->x / (GLfloat)texture->w;
+        const GLfloat maxu = (srcrect->x + srcrect->w) / (GLfloat)texture->w;
+        const GLfloat minv = srcrect->y / (GLfloat)texture->h;
+        const GLfloat maxv = (srcrect->y + srcrect->h) / (GLfloat)texture->h;
+        const GLfloat maxx = dstrect->x + dstrect->w;
+        const GLfloat maxy = dstrect->y + dstrect->h;
+
+        v = GLES2_EmitQuad(v, dstrect->x, dstrect->y, maxx, dstrect->y, dstrect->x, maxy, maxx, maxy);
+        t = GLES2_EmitQuad(t, minu, minv, maxu, minv, minu, maxv, maxu, maxv);
+    }
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_POSITION, vertices, count * 12 * sizeof(GLfloat));
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_TEXCOORD, texCoords, count * 12 * sizeof(GLfloat));
+    data->glDrawArrays(GL_TRIANGLES, 0, count * 6);
+    return 0;
+}
+
+static int
+GLES2_BatchCopyEx(SDL_Renderer *renderer, SDL_Texture *texture,
+                  const SDL_RenderCopyExData *copy, int count)
+{
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    GLfloat *vertices = GLES2_GetBatchVertices(data, count * 42);
+    GLfloat *texCoords, *translate, *fAngle;
+    GLfloat *v, *t, *c;
+    int idx, i;
+
+    if (!vertices) {
+        return -1;
+    }
+    texCoords = vertices + count * 12;
+    translate = texCoords + count * 12;
+    fAngle = translate + count * 12;
+
+    v = vertices;
+    t = texCoords;
+    c = translate;
+    for (idx = 0; idx < count; ++idx, ++copy) {
+        const SDL_FRect *dstrect = &copy->dstrect;
+        const SDL_Rect *srcrect = &copy->srcrect;
+        const GLfloat minu = srcrect->x / (GLfloat)texture->w;
+        const GLfloat maxu = (srcrect->x + srcrect->w) / (GLfloat)texture->w;
+        const GLfloat minv = srcrect->y / (GLfloat)texture->h;
+        const GLfloat maxv = (srcrect->y + srcrect->h) / (GLfloat)texture->h;
+        const GLfloat cx = copy->center.x + dstrect->x;
+        const GLfloat cy = copy->center.y + dstrect->y;
+        GLfloat minx = dstrect->x;
+        GLfloat maxx = dstrect->x + dstrect->w;
+        GLfloat miny = dstrect->y;
+        GLfloat maxy = dstrect->y + dstrect->h;
+        GLfloat tmp;
+
+        if (copy->flip & SDL_FLIP_HORIZONTAL) {
+            tmp = minx;
+            minx = maxx;
+            maxx = tmp;
+        }
+        if (copy->flip & SDL_FLIP_VERTICAL) {
+            tmp = miny;
+            miny = maxy;
+            maxy = tmp;
+        }
+
+        v = GLES2_EmitQuad(v, minx, miny, maxx, miny, minx, maxy, maxx, maxy);
+        t = GLES2_EmitQuad(t, minu, minv, maxu, minv, minu, maxv, maxu, maxv);
+        c = GLES2_EmitQuad(c, cx, cy, cx, cy, cx, cy, cx, cy);
+        for (i = 0; i < 6; ++i) {
+            fAngle[idx * 6 + i] = (GLfloat)(360.0f - copy->angle);
+        }
+    }
+
+    data->glEnableVertexAttribArray(GLES2_ATTRIBUTE_CENTER);
+    data->glEnableVertexAttribArray(GLES2_ATTRIBUTE_ANGLE);
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_ANGLE, fAngle, count * 6 * sizeof(GLfloat));
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_CENTER, translate, count * 12 * sizeof(GLfloat));
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_POSITION, vertices, count * 12 * sizeof(GLfloat));
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_TEXCOORD, texCoords, count * 12 * sizeof(GLfloat));
+    data->glDrawArrays(GL_TRIANGLES, 0, count * 6);
+    data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_CENTER);
+    data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_ANGLE);
+    return 0;
+}
+
+static int
+GLES2_Geometry(SDL_Renderer *renderer, SDL_Texture *texture,
+               const SDL_Vertex *vertices, const int *indices, int count,
+               Uint8 r, Uint8 g, Uint8 b, Uint8 a, SDL_BlendMode blendMode)
+{
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    GLfloat *positions = GLES2_GetBatchVertices(data, count * 8);
+    GLfloat *texCoords, *colors;
+    SDL_bool swap_rb;
+    int idx;
+
+    if (!positions) {
+        return -1;
+    }
+    texCoords = positions + count * 2;
+    colors = texCoords + count * 2;
+
+    if (texture) {
+        if (GLES2_SetupCopy(renderer, texture, r, g, b, a, blendMode) < 0) {
+            return -1;
+        }
+    } else {
+        if (GLES2_SetSolidState(renderer, 255, 255, 255, 255, blendMode) < 0) {
+            return -1;
+        }
+    }
+
+    /* Vertex colors go through the same channel mapping as the color uniforms */
+    swap_rb = (renderer->target &&
+               (renderer->target->format == SDL_PIXELFORMAT_ARGB8888 ||
+                renderer->target->format == SDL_PIXELFORMAT_RGB888)) ? SDL_TRUE : SDL_FALSE;
+
+    for (idx = 0; idx < count; ++idx) {
+        const SDL_Vertex *vertex = &vertices[indices ? indices[idx] : idx];
+        const GLfloat vr = vertex->color.r * inv255f;
+        const GLfloat vb = vertex->color.b * inv255f;
+
+        positions[idx * 2] = vertex->x;
+        positions[(idx * 2) + 1] = vertex->y;
+        texCoords[idx * 2] = vertex->u;
+        texCoords[(idx * 2) + 1] = vertex->v;
+        colors[idx * 4] = swap_rb ? vb : vr;
+        colors[(idx * 4) + 1] = vertex->color.g * inv255f;
+        colors[(idx * 4) + 2] = swap_rb ? vr : vb;
+        colors[(idx * 4) + 3] = vertex->color.a * inv255f;
+    }
+
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_POSITION, positions, count * 2 * sizeof(GLfloat));
+    if (texture) {
+        GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_TEXCOORD, texCoords, count * 2 * sizeof(GLfloat));
+    }
+    data->glEnableVertexAttribArray(GLES2_ATTRIBUTE_COLOR);
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_COLOR, colors, count * 4 * sizeof(GLfloat));
+    data->glDrawArrays(GL_TRIANGLES, 0, count);
+    data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_COLOR);
+    return 0;
+}
+
+static int
+GLES2_RenderGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
+                     const SDL_Vertex *vertices, int num_vertices,
+                     const int *indices, int num_indices)
+{
+    const int count = indices ? num_indices : num_vertices;
+
+    GLES2_ActivateRenderer(renderer);
+
+    if (texture) {
+        if (GLES2_Geometry(renderer, texture, vertices, indices, count,
+                           texture->r, texture->g, texture->b, texture->a,
+                           texture->blendMode) < 0) {
+            return -1;
+        }
+    } else {
+        if (GLES2_Geometry(renderer, NULL, vertices, indices, count,
+                           255, 255, 255, 255, renderer->blendMode) < 0) {
+            return -1;
+        }
+    }
+
+    return GL_CheckError("", renderer);
+}
+
+static int
+GLES2_RunCommandQueue(SDL_Renderer * renderer, const SDL_RenderCommand *cmd,
+                      int count, void *vertices, size_t vertsize)
+{
+    SDL_Rect viewport = renderer->viewport;
+    SDL_bool clipping_enabled = renderer->clipping_enabled;
+    int retval = 0;
+
+    if (GLES2_ActivateRenderer(renderer) < 0) {
+        return -1;
+    }
+
+    for (; count > 0; --count, ++cmd) {
+        const void *verts = NULL;
+        int num = 0;
+        int status = 0;
+
+        if (cmd->command >= SDL_RENDERCMD_DRAW_POINTS) {
+            verts = (const Uint8 *) vertices + cmd->data.draw.first;
+            num = (int) cmd->data.draw.count;
+        }
+
+        switch (cmd->command) {
+            case SDL_RENDERCMD_SETVIEWPORT:
+                viewport = cmd->data.viewport.rect;
+                status = GLES2_SetViewport(renderer, &viewport);
+                break;
+
+            case SDL_RENDERCMD_SETCLIPRECT:
+                clipping_enabled = cmd->data.cliprect.enabled;
+                status = GLES2_SetClipRect(renderer, &viewport, clipping_enabled,
+                                           &cmd->data.cliprect.rect);
+                break;
+
+            case SDL_RENDERCMD_CLEAR:
+                GLES2_Clear(renderer, cmd->data.color.r, cmd->data.color.g,
+                            cmd->data.color.b, cmd->data.color.a, clipping_enabled);
+                break;
+
+            case SDL_RENDERCMD_DRAW_POINTS:
+            case SDL_RENDERCMD_DRAW_LINES:
+            case SDL_RENDERCMD_FILL_RECTS:
+                status = GLES2_SetSolidState(renderer, cmd->data.draw.r, cmd->data.draw.g,
+                                             cmd->data.draw.b, cmd->data.draw.a,
+                                             cmd->data.draw.blend);
+                if (status < 0) {
+                    break;
+                }
+                if (cmd->command == SDL_RENDERCMD_DRAW_POINTS) {
+                    status = GLES2_BatchPoints(renderer, (const SDL_FPoint *) verts, num, GL_POINTS);
+                } else if (cmd->command == SDL_RENDERCMD_DRAW_LINES) {
+                    status = GLES2_BatchPoints(renderer, (const SDL_FPoint *) verts, num, GL_LINE_STRIP);
+                } else {
+                    status = GLES2_BatchFillRects(renderer, (const SDL_FRect *) verts, num);
+                }
+                break;
+
+            case SDL_RENDERCMD_COPY:
+            case SDL_RENDERCMD_COPY_EX:
+                status = GLES2_SetupCopy(renderer, cmd->data.draw.texture,
+                                         cmd->data.draw.r, cmd->data.draw.g,
+                                         cmd->data.draw.b, cmd->data.draw.a,
+                                         cmd->data.draw.blend);
+                if (status < 0) {
+                    break;
+                }
+                if (cmd->command == SDL_RENDERCMD_COPY) {
+                    status = GLES2_BatchCopy(renderer, cmd->data.draw.texture,
+                                             (const SDL_RenderCopyData *) verts, num);
+                } else {
+                    status = GLES2_BatchCopyEx(renderer, cmd->data.draw.texture,
+                                               (const SDL_RenderCopyExData *) verts, num);
+                }
+                break;
+
+            case SDL_RENDERCMD_GEOMETRY:
+                status = GLES2_Geometry(renderer, cmd->data.draw.texture,
+                                        (const SDL_Vertex *) verts, NULL, num,
+                                        cmd->data.draw.r, cmd->data.draw.g,
+                                        cmd->data.draw.b, cmd->data.draw.a,
+                                        cmd->data.draw.blend);
+                break;
+
+            case SDL_RENDERCMD_NO_OP:
+                break;
+        }
+
+        if (status < 0) {
+            retval = -1;
+        }
+    }
+
+    if (GL_CheckError("", renderer) < 0) {
+        retval = -1;
+    }
+    return retval;
+}
+
 static int
 GLES2_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                     Uint32 pixel_format, void * pixels, int pitch)
@@ -2001,6 +2423,10 @@ GLES2_ResetState(SDL_Renderer *renderer)
     data->glEnableVertexAttribArray(GLES2_ATTRIBUTE_POSITION);
     data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_TEXCOORD);
 
+    /* Everything but geometry draws with a constant white vertex color */
+    data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_COLOR);
+    data->glVertexAttrib4f(GLES2_ATTRIBUTE_COLOR, 1.0f, 1.0f, 1.0f, 1.0f);
+
     GL_CheckError("", renderer);
 }
 
@@ -2156,8 +2582,10 @@ GLES2_CreateRenderer(SDL_Window *window, Uint32 flags)
     renderer->RenderFillRects     = GLES2_RenderFillRects;
     renderer->RenderCopy          = GLES2_RenderCopy;
     renderer->RenderCopyEx        = GLES2_RenderCopyEx;
+    renderer->RenderGeometry      = GLES2_RenderGeometry;
     renderer->RenderReadPixels    = GLES2_RenderReadPixels;
     renderer->RenderPresent       = GLES2_RenderPresent;
+    renderer->RunCommandQueue     = GLES2_RunCommandQueue;
     renderer->DestroyTexture      = GLES2_DestroyTexture;
     renderer->DestroyRenderer     = GLES2_DestroyRenderer;
     renderer->GL_BindTexture      = GLES2_BindTexture;
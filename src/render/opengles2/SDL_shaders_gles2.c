@@ -37,7 +37,9 @@ static const Uint8 GLES2_VertexSrc_Default_[] = " \
     attribute vec2 a_texCoord; \
     attribute float a_angle; \
     attribute vec2 a_center; \
+    attribute vec4 a_color; \
     varying vec2 v_texCoord; \
+    varying vec4 v_color; \
     \
     void main() \
     { \
@@ -47,6 +49,7 @@ static const Uint8 GLES2_VertexSrc_Default_[] = " \
         mat2 rotationMatrix = mat2(c, -s, s, c); \
         vec2 position = rotationMatrix * (a_position - a_center) + a_center; \
         v_texCoord = a_texCoord; \
+        v_color = a_color; \
         gl_Position = u_projection * vec4(position, 0.0, 1.0);\
         gl_PointSize = 1.0; \
     } \
@@ -54,16 +57,18 @@ static const Uint8 GLES2_VertexSrc_Default_[] = " \
 
 static const Uint8 GLES2_FragmentSrc_SolidSrc_[] = " \
     precision mediump float; \
+    varying vec4 v_color; \
     uniform vec4 u_color; \
     \
     void main() \
     { \
-        gl_FragColor = u_color; \
+        gl_FragColor = u_color * v_color; \
     } \
 ";
 
 static const Uint8 GLES2_FragmentSrc_TextureABGRSrc_[] = " \
     precision mediump float; \
+    varying vec4 v_color; \
     uniform sampler2D u_texture; \
     uniform vec4 u_modulation; \
     varying vec2 v_texCoord; \
@@ -71,13 +76,14 @@ static const Uint8 GLES2_FragmentSrc_TextureABGRSrc_[] = " \
     void main() \
     { \
         gl_FragColor = texture2D(u_texture, v_texCoord); \
-        gl_FragColor *= u_modulation; \
+        gl_FragColor *= u_modulation * v_color; \
     } \
 ";
 
 /* ARGB to ABGR conversion */
 static const Uint8 GLES2_FragmentSrc_TextureARGBSrc_[] = " \
     precision mediump float; \
+    varying vec4 v_color; \
     uniform sampler2D u_texture; \
     uniform vec4 u_modulation; \
     varying vec2 v_texCoord; \
@@ -88,13 +94,14 @@ static const Uint8 GLES2_FragmentSrc_TextureARGBSrc_[] = " \
         gl_FragColor = abgr; \
         gl_FragColor.r = abgr.b; \
         gl_FragColor.b = abgr.r; \
-        gl_FragColor *= u_modulation; \
+        gl_FragColor *= u_modulation * v_color; \
     } \
 ";
 
 /* RGB to ABGR conversion */
 static const Uint8 GLES2_FragmentSrc_TextureRGBSrc_[] = " \
     precision mediump float; \
+    varying vec4 v_color; \
     uniform sampler2D u_texture; \
     uniform vec4 u_modulation; \
     varying vec2 v_texCoord; \
@@ -106,13 +113,14 @@ static const Uint8 GLES2_FragmentSrc_TextureRGBSrc_[] = " \
         gl_FragColor.r = abgr.b; \
         gl_FragColor.b = abgr.r; \
         gl_FragColor.a = 1.0; \
-        gl_FragColor *= u_modulation; \
+        gl_FragColor *= u_modulation * v_color; \
     } \
 ";
 
 /* BGR to ABGR conversion */
 static const Uint8 GLES2_FragmentSrc_TextureBGRSrc_[] = " \
     precision mediump float; \
+    varying vec4 v_color; \
     uniform sampler2D u_texture; \
     uniform vec4 u_modulation; \
     varying vec2 v_texCoord; \
@@ -122,13 +130,14 @@ static const Uint8 GLES2_FragmentSrc_TextureBGRSrc_[] = " \
         vec4 abgr = texture2D(u_texture, v_texCoord); \
         gl_FragColor = abgr; \
         gl_FragColor.a = 1.0; \
-        gl_FragColor *= u_modulation; \
+        gl_FragColor *= u_modulation * v_color; \
     } \
 ";
 
 /* YUV to ABGR conversion */
 static const Uint8 GLES2_FragmentSrc_TextureYUVSrc_[] = " \
     precision mediump float; \
+    varying vec4 v_color; \
     uniform sampler2D u_texture; \
     uniform sampler2D u_texture_u; \
     uniform sampler2D u_texture_v; \
@@ -146,13 +155,14 @@ static const Uint8 GLES2_FragmentSrc_TextureYUVSrc_[] = " \
                     0,       -0.39465, 2.03211, \
                     1.13983, -0.58060, 0) * yuv; \
         gl_FragColor = vec4(rgb, 1); \
-        gl_FragColor *= u_modulation; \
+        gl_FragColor *= u_modulation * v_color; \
     } \
 ";
 
 /* NV12 to ABGR conversion */
 static const Uint8 GLES2_FragmentSrc_TextureNV12Src_[] = " \
     precision mediump float; \
+    varying vec4 v_color; \
     uniform sampler2D u_texture; \
     uniform sampler2D u_texture_u; \
     uniform vec4 u_modulation; \
@@ -168,13 +178,14 @@ static const Uint8 GLES2_FragmentSrc_TextureNV12Src_[] = " \
                     0,       -0.39465, 2.03211, \
                     1.13983, -0.58060, 0) * yuv; \
         gl_FragColor = vec4(rgb, 1); \
-        gl_FragColor *= u_modulation; \
+        gl_FragColor *= u_modulation * v_color; \
     } \
 ";
 
 /* NV21 to ABGR conversion */
 static const Uint8 GLES2_FragmentSrc_TextureNV21Src_[] = " \
     precision mediump float; \
+    varying vec4 v_color; \
     uniform sampler2D u_texture; \
     uniform sampler2D u_texture_u; \
     uniform vec4 u_modulation; \
@@ -190,7 +201,7 @@ static const Uint8 GLES2_FragmentSrc_TextureNV21Src_[] = " \
                     0,       -0.39465, 2.03211, \
                     1.13983, -0.58060, 0) * yuv; \
         gl_FragColor = vec4(rgb, 1); \
-        gl_FragColor *= u_modulation; \
+        gl_FragColor *= u_modulation * v_color; \
     } \
 ";
 
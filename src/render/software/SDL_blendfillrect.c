@@ -218,6 +218,7 @@ SDL_BlendFillRect(SDL_Surface * dst, const SDL_Rect * rect,
         rect = &dst->clip_rect;
     }
 
+    DRAW_UNPREMULTIPLY(blendMode, r, g, b, a);
     if (blendMode == SDL_BLENDMODE_BLEND || blendMode == SDL_BLENDMODE_ADD) {
         r = DRAW_MUL(r, a);
         g = DRAW_MUL(g, a);
@@ -278,6 +279,7 @@ SDL_BlendFillRects(SDL_Surface * dst, const SDL_Rect * rects, int count,
         return SDL_SetError("SDL_BlendFillRects(): Unsupported surface format");
     }
 
+    DRAW_UNPREMULTIPLY(blendMode, r, g, b, a);
     if (blendMode == SDL_BLENDMODE_BLEND || blendMode == SDL_BLENDMODE_ADD) {
         r = DRAW_MUL(r, a);
         g = DRAW_MUL(g, a);
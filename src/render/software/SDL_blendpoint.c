@@ -212,6 +212,7 @@ SDL_BlendPoint(SDL_Surface * dst, int x, int y, SDL_BlendMode blendMode, Uint8 r
         return 0;
     }
 
+    DRAW_UNPREMULTIPLY(blendMode, r, g, b, a);
     if (blendMode == SDL_BLENDMODE_BLEND || blendMode == SDL_BLENDMODE_ADD) {
         r = DRAW_MUL(r, a);
         g = DRAW_MUL(g, a);
@@ -274,6 +275,7 @@ SDL_BlendPoints(SDL_Surface * dst, const SDL_Point * points, int count,
         return SDL_SetError("SDL_BlendPoints(): Unsupported surface format");
     }
 
+    DRAW_UNPREMULTIPLY(blendMode, r, g, b, a);
     if (blendMode == SDL_BLENDMODE_BLEND || blendMode == SDL_BLENDMODE_ADD) {
         r = DRAW_MUL(r, a);
         g = DRAW_MUL(g, a);
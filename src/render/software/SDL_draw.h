@@ -28,6 +28,25 @@
 
 #define DRAW_MUL(_a, _b) (((unsigned)(_a)*(_b))/255)
 
+/* Premultiplied colors are drawn as straight alpha colors, rounded up so
+ * that the premultiply above gives back the original color.  A color with
+ * no alpha is simply added.
+ */
+#define DRAW_UNPREMULTIPLY(blendMode, r, g, b, a) \
+do { \
+    if (blendMode == SDL_BLENDMODE_BLEND_PREMULTIPLIED) { \
+        if (a) { \
+            r = (Uint8) ((SDL_min(r, a) * 255 + a - 1) / a); \
+            g = (Uint8) ((SDL_min(g, a) * 255 + a - 1) / a); \
+            b = (Uint8) ((SDL_min(b, a) * 255 + a - 1) / a); \
+            blendMode = SDL_BLENDMODE_BLEND; \
+        } else { \
+            a = 0xFF; \
+            blendMode = SDL_BLENDMODE_ADD; \
+        } \
+    } \
+} while (0)
+
 #define DRAW_FASTSETPIXEL(type) \
     *pixel = (type) color
 
@@ -24,7 +24,10 @@
 
 #include "../SDL_sysrender.h"
 #include "SDL_render_sw_c.h"
+#include "SDL_atomic.h"
+#include "SDL_cpuinfo.h"
 #include "SDL_hints.h"
+#include "SDL_thread.h"
 
 #include "SDL_draw.h"
 #include "SDL_blendfillrect.h"
@@ -32,7 +35,9 @@
 #include "SDL_blendpoint.h"
 #include "SDL_drawline.h"
 #include "SDL_drawpoint.h"
-#include "SDL_rotate.h"
+#include "SDL_triangle.h"
+#include "../../video/SDL_RLEaccel_c.h"
+#include "../../SDL_simd.h"
 
 /* SDL surface based renderer implementation */
 
@@ -40,6 +45,7 @@ static SDL_Renderer *SW_CreateRenderer(SDL_Window * window, Uint32 flags);
 static void SW_WindowEvent(SDL_Renderer * renderer,
                            const SDL_WindowEvent *event);
 static int SW_GetOutputSize(SDL_Renderer * renderer, int *w, int *h);
+static SDL_bool SW_SupportsBlendMode(SDL_Renderer * renderer, SDL_BlendMode blendMode);
 static int SW_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture);
 static int SW_SetTextureColorMod(SDL_Renderer * renderer,
                                  SDL_Texture * texture);
@@ -68,9 +74,14 @@ static int SW_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
 static int SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
                           const SDL_Rect * srcrect, const SDL_FRect * dstrect,
                           const double angle, const SDL_FPoint * center, const SDL_RendererFlip flip);
+static int SW_RenderGeometry(SDL_Renderer * renderer, SDL_Texture * texture,
+                             const SDL_Vertex * vertices, int num_vertices,
+                             const int *indices, int num_indices);
 static int SW_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                                Uint32 format, void * pixels, int pitch);
 static void SW_RenderPresent(SDL_Renderer * renderer);
+static int SW_RunCommandQueue(SDL_Renderer * renderer, const SDL_RenderCommand *cmd,
+                              int count, void *vertices, size_t vertsize);
 static void SW_DestroyTexture(SDL_Renderer * renderer, SDL_Texture * texture);
 static void SW_DestroyRenderer(SDL_Renderer * renderer);
 
@@ -95,12 +106,91 @@ SDL_RenderDriver SW_RenderDriver = {
      0}
 };
 
+/* Threaded drawing splits the target into bands at least this many rows high,
+   with a few bands per thread so that threads finishing early can take more */
+#define SW_MIN_BAND_HEIGHT  16
+#define SW_BANDS_PER_THREAD 4
+#define SW_MAX_THREADS      64
+
+/* The window area drawn between presents is kept exactly while it takes at
+   most this many rectangles, after that it grows to the enclosing rectangle */
+#define SW_MAX_DAMAGE_RECTS 64
+
+/* Rotated copies are sampled into this many rows at a time before blending */
+#define SW_COPYEX_BAND_ROWS 16
+
+typedef struct SW_Rasterizer SW_Rasterizer;
+
+/* What the threads know about each queued command */
+typedef struct
+{
+    int y0, y1;             /* the rows it may draw to */
+} SW_CommandInfo;
+
+/* Surfaces kept between draws for pixels that need to go somewhere first,
+   they only ever grow */
+typedef struct
+{
+    SDL_Surface *band;      /* sampled rows of a rotated copy */
+    SDL_Surface *source;    /* a rotated source converted to 32 bits */
+} SW_Scratch;
+
 typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+
+    /* The window area drawn since the last present */
+    SDL_bool damage_full;
+    SDL_Region *damage;
+
+    /* Scratch surfaces when drawing without threads */
+    SW_Scratch scratch;
+
+    /* Threaded drawing, see SDL_HINT_RENDER_SOFTWARE_THREADS */
+    int num_threads;
+    SDL_Thread **threads;
+    SW_Rasterizer *rasterizers;
+    SDL_sem *start_sem;
+    SDL_sem *done_sem;
+    SDL_bool quit;
+
+    /* The batch the threads are drawing */
+    const SDL_RenderCommand *cmds;
+    int num_cmds;
+    const void *vertices;
+    SW_CommandInfo *info;
+    int max_info;
+    SDL_Rect viewport;
+    SDL_Rect clip_rect;
+    int band_height;
+    int num_bands;
+    SDL_atomic_t next_job;
+    SDL_atomic_t status;
 } SW_RenderData;
 
+typedef struct
+{
+    SDL_Surface *texture;
+    SDL_Surface *surface;
+} SW_SourceSurface;
+
+/* Each drawing thread blits through its own surfaces sharing the pixels of the
+   target and the textures, since blit mappings and modulation are stored in
+   the surfaces */
+struct SW_Rasterizer
+{
+    SW_RenderData *data;
+    SDL_Surface *target;
+    SW_SourceSurface *sources;
+    int num_sources;
+    int max_sources;
+    SW_Scratch scratch;
+};
+
+static void SW_StartThreads(SW_RenderData * data);
+static void SW_StopThreads(SW_RenderData * data);
+
 
 static SDL_Surface *
 SW_ActivateRenderer(SDL_Renderer * renderer)
@@ -114,6 +204,7 @@ SW_ActivateRenderer(SDL_Renderer * renderer)
         SDL_Surface *surface = SDL_GetWindowSurface(renderer->window);
         if (surface) {
             data->surface = data->window = surface;
+            data->damage_full = SDL_TRUE;
 
             SW_UpdateViewport(renderer);
             SW_UpdateClipRect(renderer);
@@ -147,9 +238,13 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     }
     data->surface = surface;
     data->window = surface;
+    data->damage = SDL_CreateRegion();
+    data->damage_full = SDL_TRUE;
+    SW_StartThreads(data);
 
     renderer->WindowEvent = SW_WindowEvent;
     renderer->GetOutputSize = SW_GetOutputSize;
+    renderer->SupportsBlendMode = SW_SupportsBlendMode;
     renderer->CreateTexture = SW_CreateTexture;
     renderer->SetTextureColorMod = SW_SetTextureColorMod;
     renderer->SetTextureAlphaMod = SW_SetTextureAlphaMod;
@@ -166,13 +261,20 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     renderer->RenderFillRects = SW_RenderFillRects;
     renderer->RenderCopy = SW_RenderCopy;
     renderer->RenderCopyEx = SW_RenderCopyEx;
+    renderer->RenderGeometry = SW_RenderGeometry;
     renderer->RenderReadPixels = SW_RenderReadPixels;
     renderer->RenderPresent = SW_RenderPresent;
+    renderer->RunCommandQueue = SW_RunCommandQueue;
     renderer->DestroyTexture = SW_DestroyTexture;
     renderer->DestroyRenderer = SW_DestroyRenderer;
     renderer->info = SW_RenderDriver.info;
     renderer->driverdata = data;
 
+    /* Threaded drawing works on the command queue */
+    if (data->num_threads > 1) {
+        renderer->batching = SDL_TRUE;
+    }
+
     SW_ActivateRenderer(renderer);
 
     return renderer;
@@ -198,6 +300,8 @@ SW_WindowEvent(SDL_Renderer * renderer, const SDL_WindowEvent *event)
     if (event->event == SDL_WINDOWEVENT_SIZE_CHANGED) {
         data->surface = NULL;
         data->window = NULL;
+    } else if (event->event == SDL_WINDOWEVENT_EXPOSED) {
+        data->damage_full = SDL_TRUE;
     }
 }
 
@@ -220,9 +324,17 @@ SW_GetOutputSize(SDL_Renderer * renderer, int *w, int *h)
     }
 }
 
+static SDL_bool
+SW_SupportsBlendMode(SDL_Renderer * renderer, SDL_BlendMode blendMode)
+{
+    /* The surface blitters only know the predefined blend modes */
+    return (blendMode == SDL_BLENDMODE_BLEND_PREMULTIPLIED) ? SDL_TRUE : SDL_FALSE;
+}
+
 static int
 SW_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     int bpp;
     Uint32 Rmask, Gmask, Bmask, Amask;
 
@@ -238,11 +350,13 @@ SW_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
                            texture->b);
     SDL_SetSurfaceAlphaMod(texture->driverdata, texture->a);
     SDL_SetSurfaceBlendMode(texture->driverdata, texture->blendMode);
+    texture->scaleQuality = SDL_GetScaleQuality();
 
     /* Only RLE encode textures without an alpha channel since the RLE coder
      * discards the color values of pixels with an alpha value of zero.
+     * Threaded drawing reads the texture pixels directly, so never RLE encode then.
      */
-    if (texture->access == SDL_TEXTUREACCESS_STATIC && !Amask) {
+    if (texture->access == SDL_TEXTUREACCESS_STATIC && !Amask && data->num_threads == 1) {
         SDL_SetSurfaceRLE(texture->driverdata, 1);
     }
 
@@ -283,10 +397,11 @@ static int
 SW_SetTextureBlendMode(SDL_Renderer * renderer, SDL_Texture * texture)
 {
     SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
-    /* If add or mod blending are ever enabled, permanently disable RLE (which doesn't support
+    /* If add, mod or premultiplied blending are ever enabled, permanently disable RLE (which doesn't support
      * them) to avoid potentially frequent RLE encoding/decoding.
      */
-    if ((texture->blendMode == SDL_BLENDMODE_ADD || texture->blendMode == SDL_BLENDMODE_MOD)) {
+    if (texture->blendMode == SDL_BLENDMODE_ADD || texture->blendMode == SDL_BLENDMODE_MOD ||
+        texture->blendMode == SDL_BLENDMODE_BLEND_PREMULTIPLIED) {
         SDL_SetSurfaceRLE(surface, 0);
     }
     return SDL_SetSurfaceBlendMode(surface, texture->blendMode);
@@ -364,67 +479,310 @@ SW_UpdateViewport(SDL_Renderer * renderer)
     return 0;
 }
 
+static void
+SW_GetClip(const SDL_Rect * viewport, SDL_bool clipping_enabled, const SDL_Rect * rect,
+           SDL_Rect * clip_rect)
+{
+    if (clipping_enabled) {
+        *clip_rect = *rect;
+        clip_rect->x += viewport->x;
+        clip_rect->y += viewport->y;
+        SDL_IntersectRect(viewport, clip_rect, clip_rect);
+    } else {
+        *clip_rect = *viewport;
+    }
+}
+
+static void
+SW_SetClip(SDL_Surface * surface, const SDL_Rect * bounds, const SDL_Rect * viewport,
+           SDL_bool clipping_enabled, const SDL_Rect * rect)
+{
+    SDL_Rect clip_rect;
+
+    SW_GetClip(viewport, clipping_enabled, rect, &clip_rect);
+    if (bounds) {
+        SDL_IntersectRect(bounds, &clip_rect, &clip_rect);
+    }
+    SDL_SetClipRect(surface, &clip_rect);
+}
+
+/* The clip rect of the whole target, before it is narrowed to a band */
+static void
+SW_GetTargetClip(SDL_Surface * surface, const SDL_Rect * viewport, SDL_bool clipping_enabled,
+                 const SDL_Rect * rect, SDL_Rect * clip_rect)
+{
+    SDL_Rect full_rect;
+
+    full_rect.x = 0;
+    full_rect.y = 0;
+    full_rect.w = surface->w;
+    full_rect.h = surface->h;
+    SW_GetClip(viewport, clipping_enabled, rect, clip_rect);
+    SDL_IntersectRect(clip_rect, &full_rect, clip_rect);
+}
+
 static int
 SW_UpdateClipRect(SDL_Renderer * renderer)
 {
     SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = data->surface;
     if (surface) {
-        if (renderer->clipping_enabled) {
-            SDL_Rect clip_rect;
-            clip_rect = renderer->clip_rect;
-            clip_rect.x += renderer->viewport.x;
-            clip_rect.y += renderer->viewport.y;
-            SDL_IntersectRect(&renderer->viewport, &clip_rect, &clip_rect);
-            SDL_SetClipRect(surface, &clip_rect);
-        } else {
-            SDL_SetClipRect(surface, &renderer->viewport);
-        }
+        SW_SetClip(surface, NULL, &renderer->viewport,
+                   renderer->clipping_enabled, &renderer->clip_rect);
     }
     return 0;
 }
 
+static void
+SW_GetCopyExBounds(const SDL_Rect * viewport, const SDL_RenderCopyExData * copy, SDL_Rect * rect)
+{
+    /* The copy is rotated around its center, so it stays inside the circle
+       through the corner farthest from the center. SW_CopyEx rounds the
+       rotated corners outwards, allow a few pixels for that. */
+    const double x = (int)(viewport->x + copy->dstrect.x);
+    const double y = (int)(viewport->y + copy->dstrect.y);
+    const double w = (int)copy->dstrect.w;
+    const double h = (int)copy->dstrect.h;
+    const double cx = x + (int)copy->center.x;
+    const double cy = y + (int)copy->center.y;
+    const double dx = SDL_max(SDL_fabs(x - cx), SDL_fabs(x + w - cx));
+    const double dy = SDL_max(SDL_fabs(y - cy), SDL_fabs(y + h - cy));
+    const double radius = SDL_sqrt(dx * dx + dy * dy);
+
+    rect->x = (int)SDL_floor(cx - radius) - 2;
+    rect->y = (int)SDL_floor(cy - radius) - 2;
+    rect->w = (int)SDL_ceil(cx + radius) + 3 - rect->x;
+    rect->h = (int)SDL_ceil(cy + radius) + 3 - rect->y;
+}
+
+/* Find the area a draw command may touch, without clipping */
+static void
+SW_GetCommandBounds(const SDL_RenderCommand *cmd, const void *verts, const SDL_Rect * viewport,
+                    SDL_Rect * rect)
+{
+    const int num = (int) cmd->data.draw.count;
+    int x0 = 0x7FFFFFFF;  /* empty until the first element is seen */
+    int y0 = 0x7FFFFFFF;
+    int x1 = -0x7FFFFFFF;
+    int y1 = -0x7FFFFFFF;
+    int i;
+
+    switch (cmd->command) {
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES: {
+            const SDL_FPoint *points = (const SDL_FPoint *) verts;
+            for (i = 0; i < num; ++i) {
+                const int x = (int)(viewport->x + points[i].x);
+                const int y = (int)(viewport->y + points[i].y);
+                x0 = SDL_min(x0, x);
+                y0 = SDL_min(y0, y);
+                x1 = SDL_max(x1, x + 1);
+                y1 = SDL_max(y1, y + 1);
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_FILL_RECTS: {
+            const SDL_FRect *rects = (const SDL_FRect *) verts;
+            for (i = 0; i < num; ++i) {
+                const int x = (int)(viewport->x + rects[i].x);
+                const int y = (int)(viewport->y + rects[i].y);
+                x0 = SDL_min(x0, x);
+                y0 = SDL_min(y0, y);
+                x1 = SDL_max(x1, x + SDL_max((int)rects[i].w, 1));
+                y1 = SDL_max(y1, y + SDL_max((int)rects[i].h, 1));
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_COPY: {
+            const SDL_RenderCopyData *copy = (const SDL_RenderCopyData *) verts;
+            for (i = 0; i < num; ++i) {
+                const int x = (int)(viewport->x + copy[i].dstrect.x);
+                const int y = (int)(viewport->y + copy[i].dstrect.y);
+                x0 = SDL_min(x0, x);
+                y0 = SDL_min(y0, y);
+                x1 = SDL_max(x1, x + (int)copy[i].dstrect.w);
+                y1 = SDL_max(y1, y + (int)copy[i].dstrect.h);
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_COPY_EX: {
+            const SDL_RenderCopyExData *copy = (const SDL_RenderCopyExData *) verts;
+            for (i = 0; i < num; ++i) {
+                SDL_Rect bounds;
+                SW_GetCopyExBounds(viewport, &copy[i], &bounds);
+                x0 = SDL_min(x0, bounds.x);
+                y0 = SDL_min(y0, bounds.y);
+                x1 = SDL_max(x1, bounds.x + bounds.w);
+                y1 = SDL_max(y1, bounds.y + bounds.h);
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_GEOMETRY: {
+            const SDL_Vertex *vertex = (const SDL_Vertex *) verts;
+            for (i = 0; i < num; ++i) {
+                const int x = viewport->x + (int)SDL_floor(vertex[i].x);
+                const int y = viewport->y + (int)SDL_floor(vertex[i].y);
+                x0 = SDL_min(x0, x);
+                y0 = SDL_min(y0, y);
+                x1 = SDL_max(x1, x + 2);
+                y1 = SDL_max(y1, y + 2);
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    if (x1 <= x0 || y1 <= y0) {
+        rect->x = rect->y = rect->w = rect->h = 0;
+        return;
+    }
+    rect->x = x0;
+    rect->y = y0;
+    rect->w = x1 - x0;
+    rect->h = y1 - y0;
+}
+
+static SDL_bool
+SW_IsDrawingToWindow(SDL_Renderer * renderer)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+
+    return (renderer->window && data->surface == data->window);
+}
+
+static void
+SW_AddDamage(SW_RenderData * data, const SDL_Rect * rect)
+{
+    int count;
+
+    if (data->damage_full || SDL_RectEmpty(rect)) {
+        return;
+    }
+
+    if (!data->damage || SDL_UnionRegionRects(data->damage, rect, 1) < 0) {
+        data->damage_full = SDL_TRUE;
+        return;
+    }
+
+    /* Too scattered to update piece by piece, update all of it at once */
+    SDL_GetRegionRects(data->damage, &count);
+    if (count > SW_MAX_DAMAGE_RECTS) {
+        SDL_Rect bounds;
+
+        SDL_GetRegionBounds(data->damage, &bounds);
+        SDL_ClearRegion(data->damage);
+        if (SDL_UnionRegionRects(data->damage, &bounds, 1) < 0) {
+            data->damage_full = SDL_TRUE;
+        }
+    }
+}
+
+static void
+SW_AddCommandDamage(SDL_Renderer * renderer, const SDL_RenderCommand *cmd, const void *verts,
+                    const SDL_Rect * viewport, const SDL_Rect * clip_rect)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SDL_RenderCommand item;
+    size_t size;
+    SDL_Rect rect;
+    int i;
+
+    if (data->damage_full) {
+        return;
+    }
+
+    /* Batched rectangles and copies are often far apart, keep each one apart */
+    switch (cmd->command) {
+        case SDL_RENDERCMD_FILL_RECTS: size = sizeof (SDL_FRect); break;
+        case SDL_RENDERCMD_COPY: size = sizeof (SDL_RenderCopyData); break;
+        case SDL_RENDERCMD_COPY_EX: size = sizeof (SDL_RenderCopyExData); break;
+        default: size = 0; break;
+    }
+    if (size == 0) {
+        SW_GetCommandBounds(cmd, verts, viewport, &rect);
+        if (SDL_IntersectRect(&rect, clip_rect, &rect)) {
+            SW_AddDamage(data, &rect);
+        }
+        return;
+    }
+
+    item = *cmd;
+    item.data.draw.count = 1;
+    for (i = 0; i < (int) cmd->data.draw.count && !data->damage_full; ++i) {
+        SW_GetCommandBounds(&item, (const Uint8 *) verts + i * size, viewport, &rect);
+        if (SDL_IntersectRect(&rect, clip_rect, &rect)) {
+            SW_AddDamage(data, &rect);
+        }
+    }
+}
+
+/* Track the window damage of a draw call that isn't queued */
+static void
+SW_AddDrawDamage(SDL_Renderer * renderer, SDL_Surface * surface, SDL_RenderCommandType type,
+                 const void *verts, int count)
+{
+    SDL_RenderCommand cmd;
+
+    if (!SW_IsDrawingToWindow(renderer)) {
+        return;
+    }
+    cmd.command = type;
+    cmd.data.draw.count = count;
+    SW_AddCommandDamage(renderer, &cmd, verts, &renderer->viewport, &surface->clip_rect);
+}
+
 static int
-SW_RenderClear(SDL_Renderer * renderer)
+SW_Clear(SDL_Surface * surface, const SDL_Rect * bounds, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
-    SDL_Surface *surface = SW_ActivateRenderer(renderer);
     Uint32 color;
     SDL_Rect clip_rect;
 
-    if (!surface) {
-        return -1;
-    }
-
-    color = SDL_MapRGBA(surface->format,
-                        renderer->r, renderer->g, renderer->b, renderer->a);
+    color = SDL_MapRGBA(surface->format, r, g, b, a);
 
     /* By definition the clear ignores the clip rect */
     clip_rect = surface->clip_rect;
-    SDL_SetClipRect(surface, NULL);
+    SDL_SetClipRect(surface, bounds);
     SDL_FillRect(surface, NULL, color);
     SDL_SetClipRect(surface, &clip_rect);
     return 0;
 }
 
 static int
-SW_RenderDrawPoints(SDL_Renderer * renderer, const SDL_FPoint * points,
-                    int count)
+SW_RenderClear(SDL_Renderer * renderer)
 {
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
-    SDL_Point *final_points;
-    int i, status;
 
     if (!surface) {
         return -1;
     }
 
+    if (SW_IsDrawingToWindow(renderer)) {
+        ((SW_RenderData *) renderer->driverdata)->damage_full = SDL_TRUE;
+    }
+    return SW_Clear(surface, NULL, renderer->r, renderer->g, renderer->b, renderer->a);
+}
+
+static int
+SW_DrawPoints(SDL_Surface * surface, const SDL_Rect * viewport,
+              const SDL_FPoint * points, int count,
+              Uint8 r, Uint8 g, Uint8 b, Uint8 a, SDL_BlendMode blendMode)
+{
+    SDL_Point *final_points;
+    int i, status;
+
     final_points = SDL_stack_alloc(SDL_Point, count);
     if (!final_points) {
         return SDL_OutOfMemory();
     }
-    if (renderer->viewport.x || renderer->viewport.y) {
-        int x = renderer->viewport.x;
-        int y = renderer->viewport.y;
+    if (viewport->x || viewport->y) {
+        int x = viewport->x;
+        int y = viewport->y;
 
         for (i = 0; i < count; ++i) {
             final_points[i].x = (int)(x + points[i].x);
@@ -438,17 +796,13 @@ SW_RenderDrawPoints(SDL_Renderer * renderer, const SDL_FPoint * points,
     }
 
     /* Draw the points! */
-    if (renderer->blendMode == SDL_BLENDMODE_NONE) {
-        Uint32 color = SDL_MapRGBA(surface->format,
-                                   renderer->r, renderer->g, renderer->b,
-                                   renderer->a);
+    if (blendMode == SDL_BLENDMODE_NONE) {
+        Uint32 color = SDL_MapRGBA(surface->format, r, g, b, a);
 
         status = SDL_DrawPoints(surface, final_points, count, color);
     } else {
         status = SDL_BlendPoints(surface, final_points, count,
-                                renderer->blendMode,
-                                renderer->r, renderer->g, renderer->b,
-                                renderer->a);
+                                blendMode, r, g, b, a);
     }
     SDL_stack_free(final_points);
 
@@ -456,24 +810,129 @@ SW_RenderDrawPoints(SDL_Renderer * renderer, const SDL_FPoint * points,
 }
 
 static int
-SW_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
-                   int count)
+SW_RenderDrawPoints(SDL_Renderer * renderer, const SDL_FPoint * points,
+                    int count)
 {
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
-    SDL_Point *final_points;
-    int i, status;
 
     if (!surface) {
         return -1;
     }
 
+    SW_AddDrawDamage(renderer, surface, SDL_RENDERCMD_DRAW_POINTS, points, count);
+    return SW_DrawPoints(surface, &renderer->viewport, points, count,
+                         renderer->r, renderer->g, renderer->b, renderer->a,
+                         renderer->blendMode);
+}
+
+/* Draw the rows of the line from (x1, y1) to (x2, y2) that are within the
+   clip rect of the surface. The line is stepped from its ends the way
+   SDL_DrawLine() steps it, and drawn a row at a time. */
+static int
+SW_DrawLineRows(SDL_Surface * surface, int x1, int y1, int x2, int y2, SDL_bool draw_end,
+                Uint8 r, Uint8 g, Uint8 b, Uint8 a, SDL_BlendMode blendMode)
+{
+    const int miny = surface->clip_rect.y;
+    const int maxy = surface->clip_rect.y + surface->clip_rect.h - 1;
+    const Uint32 color = SDL_MapRGBA(surface->format, r, g, b, a);
+    int i, deltax, deltay, numpixels;
+    int d, dinc1, dinc2;
+    int x, xinc1, xinc2;
+    int y, yinc1, yinc2;
+    int run_x;
+
+    if (SDL_max(y1, y2) < miny || SDL_min(y1, y2) > maxy) {
+        return 0;
+    }
+
+    /* The same setup as BLINE() in SDL_draw.h, which also steps the
+       horizontal, vertical and diagonal lines through the same pixels */
+    deltax = ABS(x2 - x1);
+    deltay = ABS(y2 - y1);
+    if (deltax >= deltay) {
+        numpixels = deltax + 1;
+        d = (2 * deltay) - deltax;
+        dinc1 = deltay * 2;
+        dinc2 = (deltay - deltax) * 2;
+        xinc1 = 1;
+        xinc2 = 1;
+        yinc1 = 0;
+        yinc2 = 1;
+    } else {
+        numpixels = deltay + 1;
+        d = (2 * deltax) - deltay;
+        dinc1 = deltax * 2;
+        dinc2 = (deltax - deltay) * 2;
+        xinc1 = 0;
+        xinc2 = 1;
+        yinc1 = 1;
+        yinc2 = 1;
+    }
+    if (x1 > x2) {
+        xinc1 = -xinc1;
+        xinc2 = -xinc2;
+    }
+    if (y1 > y2) {
+        yinc1 = -yinc1;
+        yinc2 = -yinc2;
+    }
+    if (!draw_end) {
+        --numpixels;
+    }
+
+    x = run_x = x1;
+    y = y1;
+    for (i = 0; i < numpixels; ++i) {
+        const int last_x = x;
+        const int last_y = y;
+
+        if (d < 0) {
+            d += dinc1;
+            x += xinc1;
+            y += yinc1;
+        } else {
+            d += dinc2;
+            x += xinc2;
+            y += yinc2;
+        }
+
+        /* Draw the run of pixels of a row when the line leaves it */
+        if (y != last_y || i == numpixels - 1) {
+            if (last_y >= miny && last_y <= maxy) {
+                int status;
+                if (blendMode == SDL_BLENDMODE_NONE) {
+                    status = SDL_DrawLine(surface, run_x, last_y, last_x, last_y, color);
+                } else {
+                    status = SDL_BlendLine(surface, run_x, last_y, last_x, last_y,
+                                           blendMode, r, g, b, a);
+                }
+                if (status < 0) {
+                    return -1;
+                }
+            } else if ((y1 < y2) ? (last_y > maxy) : (last_y < miny)) {
+                break;
+            }
+            run_x = x;
+        }
+    }
+    return 0;
+}
+
+static int
+SW_DrawLines(SDL_Surface * surface, const SDL_Rect * clip_rect, const SDL_Rect * viewport,
+             const SDL_FPoint * points, int count,
+             Uint8 r, Uint8 g, Uint8 b, Uint8 a, SDL_BlendMode blendMode)
+{
+    SDL_Point *final_points;
+    int i, status;
+
     final_points = SDL_stack_alloc(SDL_Point, count);
     if (!final_points) {
         return SDL_OutOfMemory();
     }
-    if (renderer->viewport.x || renderer->viewport.y) {
-        int x = renderer->viewport.x;
-        int y = renderer->viewport.y;
+    if (viewport->x || viewport->y) {
+        int x = viewport->x;
+        int y = viewport->y;
 
         for (i = 0; i < count; ++i) {
             final_points[i].x = (int)(x + points[i].x);
@@ -487,17 +946,39 @@ SW_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
     }
 
     /* Draw the lines! */
-    if (renderer->blendMode == SDL_BLENDMODE_NONE) {
-        Uint32 color = SDL_MapRGBA(surface->format,
-                                   renderer->r, renderer->g, renderer->b,
-                                   renderer->a);
+    if (clip_rect) {
+        /* Drawing a band of rows, clip the lines as if the whole target was
+           drawn, so their pixels don't depend on where the bands are */
+        status = 0;
+        for (i = 1; i < count && status == 0; ++i) {
+            int x1 = final_points[i-1].x;
+            int y1 = final_points[i-1].y;
+            int x2 = final_points[i].x;
+            int y2 = final_points[i].y;
+
+            if (SDL_IntersectRectAndLine(clip_rect, &x1, &y1, &x2, &y2)) {
+                /* Draw the end if it was clipped, like SDL_DrawLines() */
+                const SDL_bool draw_end = (x2 != final_points[i].x || y2 != final_points[i].y);
+                status = SW_DrawLineRows(surface, x1, y1, x2, y2, draw_end, r, g, b, a, blendMode);
+            }
+        }
+        if (status == 0 && (final_points[0].x != final_points[count-1].x ||
+                            final_points[0].y != final_points[count-1].y)) {
+            if (blendMode == SDL_BLENDMODE_NONE) {
+                status = SDL_DrawPoint(surface, final_points[count-1].x, final_points[count-1].y,
+                                       SDL_MapRGBA(surface->format, r, g, b, a));
+            } else {
+                status = SDL_BlendPoint(surface, final_points[count-1].x, final_points[count-1].y,
+                                        blendMode, r, g, b, a);
+            }
+        }
+    } else if (blendMode == SDL_BLENDMODE_NONE) {
+        Uint32 color = SDL_MapRGBA(surface->format, r, g, b, a);
 
         status = SDL_DrawLines(surface, final_points, count, color);
     } else {
         status = SDL_BlendLines(surface, final_points, count,
-                                renderer->blendMode,
-                                renderer->r, renderer->g, renderer->b,
-                                renderer->a);
+                                blendMode, r, g, b, a);
     }
     SDL_stack_free(final_points);
 
@@ -505,23 +986,36 @@ SW_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
 }
 
 static int
-SW_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
+SW_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
+                   int count)
 {
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
-    SDL_Rect *final_rects;
-    int i, status;
 
     if (!surface) {
         return -1;
     }
 
+    SW_AddDrawDamage(renderer, surface, SDL_RENDERCMD_DRAW_LINES, points, count);
+    return SW_DrawLines(surface, NULL, &renderer->viewport, points, count,
+                        renderer->r, renderer->g, renderer->b, renderer->a,
+                        renderer->blendMode);
+}
+
+static int
+SW_FillRects(SDL_Surface * surface, const SDL_Rect * viewport,
+             const SDL_FRect * rects, int count,
+             Uint8 r, Uint8 g, Uint8 b, Uint8 a, SDL_BlendMode blendMode)
+{
+    SDL_Rect *final_rects;
+    int i, status;
+
     final_rects = SDL_stack_alloc(SDL_Rect, count);
     if (!final_rects) {
         return SDL_OutOfMemory();
     }
-    if (renderer->viewport.x || renderer->viewport.y) {
-        int x = renderer->viewport.x;
-        int y = renderer->viewport.y;
+    if (viewport->x || viewport->y) {
+        int x = viewport->x;
+        int y = viewport->y;
 
         for (i = 0; i < count; ++i) {
             final_rects[i].x = (int)(x + rects[i].x);
@@ -538,16 +1032,12 @@ SW_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
         }
     }
 
-    if (renderer->blendMode == SDL_BLENDMODE_NONE) {
-        Uint32 color = SDL_MapRGBA(surface->format,
-                                   renderer->r, renderer->g, renderer->b,
-                                   renderer->a);
+    if (blendMode == SDL_BLENDMODE_NONE) {
+        Uint32 color = SDL_MapRGBA(surface->format, r, g, b, a);
         status = SDL_FillRects(surface, final_rects, count, color);
     } else {
         status = SDL_BlendFillRects(surface, final_rects, count,
-                                    renderer->blendMode,
-                                    renderer->r, renderer->g, renderer->b,
-                                    renderer->a);
+                                    blendMode, r, g, b, a);
     }
     SDL_stack_free(final_rects);
 
@@ -555,20 +1045,29 @@ SW_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
 }
 
 static int
-SW_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
-              const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+SW_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
 {
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
-    SDL_Surface *src = (SDL_Surface *) texture->driverdata;
-    SDL_Rect final_rect;
 
     if (!surface) {
         return -1;
     }
 
-    if (renderer->viewport.x || renderer->viewport.y) {
-        final_rect.x = (int)(renderer->viewport.x + dstrect->x);
-        final_rect.y = (int)(renderer->viewport.y + dstrect->y);
+    SW_AddDrawDamage(renderer, surface, SDL_RENDERCMD_FILL_RECTS, rects, count);
+    return SW_FillRects(surface, &renderer->viewport, rects, count,
+                        renderer->r, renderer->g, renderer->b, renderer->a,
+                        renderer->blendMode);
+}
+
+static int
+SW_Copy(SDL_Surface * surface, const SDL_Rect * clip_rect, const SDL_Rect * viewport, SDL_Surface * src,
+        const SDL_Rect * srcrect, const SDL_FRect * dstrect, SDL_ScaleQuality quality)
+{
+    SDL_Rect final_rect;
+
+    if (viewport->x || viewport->y) {
+        final_rect.x = (int)(viewport->x + dstrect->x);
+        final_rect.y = (int)(viewport->y + dstrect->y);
     } else {
         final_rect.x = (int)dstrect->x;
         final_rect.y = (int)dstrect->y;
@@ -583,252 +1082,598 @@ SW_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
          * to avoid potentially frequent RLE encoding/decoding.
          */
         SDL_SetSurfaceRLE(surface, 0);
-        return SDL_BlitScaled(src, srcrect, surface, &final_rect);
-    }
-}
-
-static int
-GetScaleQuality(void)
-{
-    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
-
-    if (!hint || *hint == '0' || SDL_strcasecmp(hint, "nearest") == 0) {
-        return 0;
-    } else {
-        return 1;
+        if (clip_rect) {
+            /* Drawing a band of rows, scale as if the whole target was drawn */
+            return SDL_PrivateUpperBlitScaledRows(src, srcrect, surface, &final_rect, quality, clip_rect);
+        }
+        return SDL_PrivateUpperBlitScaled(src, srcrect, surface, &final_rect, quality);
     }
 }
 
 static int
-SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
-                const SDL_Rect * srcrect, const SDL_FRect * dstrect,
-                const double angle, const SDL_FPoint * center, const SDL_RendererFlip flip)
+SW_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
+              const SDL_Rect * srcrect, const SDL_FRect * dstrect)
 {
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SDL_Surface *src = (SDL_Surface *) texture->driverdata;
-    SDL_Rect final_rect, tmp_rect;
-    SDL_Surface *src_clone, *src_rotated, *src_scaled;
-    SDL_Surface *mask = NULL, *mask_rotated = NULL;
-    int retval = 0, dstwidth, dstheight, abscenterx, abscentery;
-    double cangle, sangle, px, py, p1x, p1y, p2x, p2y, p3x, p3y, p4x, p4y;
-    SDL_BlendMode blendmode;
-    Uint8 alphaMod, rMod, gMod, bMod;
-    int applyModulation = SDL_FALSE;
-    int blitRequired = SDL_FALSE;
-    int isOpaque = SDL_FALSE;
 
     if (!surface) {
         return -1;
     }
 
-    if (renderer->viewport.x || renderer->viewport.y) {
-        final_rect.x = (int)(renderer->viewport.x + dstrect->x);
-        final_rect.y = (int)(renderer->viewport.y + dstrect->y);
-    } else {
-        final_rect.x = (int)dstrect->x;
-        final_rect.y = (int)dstrect->y;
+    if (SW_IsDrawingToWindow(renderer)) {
+        SDL_RenderCopyData copy;
+        copy.srcrect = *srcrect;
+        copy.dstrect = *dstrect;
+        SW_AddDrawDamage(renderer, surface, SDL_RENDERCMD_COPY, &copy, 1);
     }
-    final_rect.w = (int)dstrect->w;
-    final_rect.h = (int)dstrect->h;
+    return SW_Copy(surface, NULL, &renderer->viewport, src, srcrect, dstrect,
+                   (SDL_ScaleQuality) texture->scaleQuality);
+}
 
-    tmp_rect = final_rect;
-    tmp_rect.x = 0;
-    tmp_rect.y = 0;
+/* Where the pixels of a rotated copy come from: the destination pixel center
+   (x, y) samples the source rectangle at (u0 + x * dudx + y * dudy,
+   v0 + x * dvdx + y * dvdy), in pixels of the source rectangle */
+typedef struct
+{
+    const Uint8 *pixels;    /* the first pixel of the source rectangle */
+    int pitch;
+    int w, h;
+    double u0, v0;
+    double dudx, dudy;
+    double dvdx, dvdy;
+    Uint32 alpha;           /* set in every sample, for sources without alpha */
+    SDL_bool bilinear;
+    SDL_bool sse2;
+    SDL_bool neon;
+} SW_Transform;
+
+/* The CPU doesn't change, so it's only asked once instead of on every copy */
+static SDL_bool
+SW_HasSSE2(void)
+{
+    static int has_sse2 = -1;
 
-    /* It is possible to encounter an RLE encoded surface here and locking it is
-     * necessary because this code is going to access the pixel buffer directly.
-     */
-    if (SDL_MUSTLOCK(src)) {
-        SDL_LockSurface(src);
+    if (has_sse2 < 0) {
+        has_sse2 = SDL_HasSSE2() ? 1 : 0;
     }
+    return has_sse2 ? SDL_TRUE : SDL_FALSE;
+}
 
-    /* Clone the source surface but use its pixel buffer directly.
-     * The original source surface must be treated as read-only.
-     */
-    src_clone = SDL_CreateRGBSurfaceFrom(src->pixels, src->w, src->h, src->format->BitsPerPixel, src->pitch,
-                                         src->format->Rmask, src->format->Gmask,
-                                         src->format->Bmask, src->format->Amask);
-    if (src_clone == NULL) {
-        if (SDL_MUSTLOCK(src)) {
-            SDL_UnlockSurface(src);
-        }
-        return -1;
+/* ARMv7 builds with NEON code can still run on CPUs without it */
+static SDL_bool
+SW_HasNEON(void)
+{
+    static int has_neon = -1;
+
+    if (has_neon < 0) {
+        has_neon = SDL_HasNEON() ? 1 : 0;
     }
+    return has_neon ? SDL_TRUE : SDL_FALSE;
+}
 
-    SDL_GetSurfaceBlendMode(src, &blendmode);
-    SDL_GetSurfaceAlphaMod(src, &alphaMod);
-    SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
+/* Convert a source position to 16.16 fixed point */
+static SDL_INLINE Sint32
+SW_ToFixed(double value)
+{
+    return (Sint32) SDL_floor(value * 65536.0 + 0.5);
+}
 
-    /* SDLgfx_rotateSurface only accepts 32-bit surfaces with a 8888 layout. Everything else has to be converted. */
-    if (src->format->BitsPerPixel != 32 || SDL_PIXELLAYOUT(src->format->format) != SDL_PACKEDLAYOUT_8888 || !src->format->Amask) {
-        blitRequired = SDL_TRUE;
-    }
+/* Get the nearest source pixel for a 16.16 position */
+static SDL_INLINE int
+SW_GetNearestTap(Sint32 pos, int len)
+{
+    const int i = (pos < 0) ? 0 : (pos >> 16);
+    return (i < len) ? i : (len - 1);
+}
 
-    /* If scaling and cropping is necessary, it has to be taken care of before the rotation. */
-    if (!(srcrect->w == final_rect.w && srcrect->h == final_rect.h && srcrect->x == 0 && srcrect->y == 0)) {
-        blitRequired = SDL_TRUE;
+/* Get the two source pixels and the 7-bit weight of the second for a 16.16
+   position, which is relative to the first pixel center */
+static SDL_INLINE void
+SW_GetBilinearTaps(Sint32 pos, int len, int *i0, int *i1, int *frac)
+{
+    if (pos < 0) {
+        *i0 = *i1 = 0;
+        *frac = 0;
+    } else if ((pos >> 16) >= len - 1) {
+        *i0 = *i1 = len - 1;
+        *frac = 0;
+    } else {
+        *i0 = pos >> 16;
+        *i1 = *i0 + 1;
+        *frac = (pos >> 9) & 0x7F;
     }
+}
 
-    /* The color and alpha modulation has to be applied before the rotation when using the NONE and MOD blend modes. */
-    if ((blendmode == SDL_BLENDMODE_NONE || blendmode == SDL_BLENDMODE_MOD) && (alphaMod & rMod & gMod & bMod) != 255) {
-        applyModulation = SDL_TRUE;
-        SDL_SetSurfaceAlphaMod(src_clone, alphaMod);
-        SDL_SetSurfaceColorMod(src_clone, rMod, gMod, bMod);
-    }
+#define SW_PIXEL(t, x, y) (*(const Uint32 *) ((t)->pixels + (y) * (t)->pitch + (x) * 4))
 
-    /* Opaque surfaces are much easier to handle with the NONE blend mode. */
-    if (blendmode == SDL_BLENDMODE_NONE && !src->format->Amask && alphaMod == 255) {
-        isOpaque = SDL_TRUE;
+static void
+SW_TransformSpanNearest(const SW_Transform * t, Uint32 * dst, int count,
+                        Sint32 u, Sint32 v, Sint32 du, Sint32 dv)
+{
+    while (count--) {
+        *dst++ = SW_PIXEL(t, SW_GetNearestTap(u, t->w), SW_GetNearestTap(v, t->h)) | t->alpha;
+        u += du;
+        v += dv;
     }
+}
 
-    /* The NONE blend mode requires a mask for non-opaque surfaces. This mask will be used
-     * to clear the pixels in the destination surface. The other steps are explained below.
-     */
-    if (blendmode == SDL_BLENDMODE_NONE && !isOpaque) {
-        mask = SDL_CreateRGBSurface(0, final_rect.w, final_rect.h, 32,
-                                    0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
-        if (mask == NULL) {
-            retval = -1;
-        } else {
-            SDL_SetSurfaceBlendMode(mask, SDL_BLENDMODE_MOD);
+static void
+SW_TransformSpanBilinear(const SW_Transform * t, Uint32 * dst, int count,
+                         Sint32 u, Sint32 v, Sint32 du, Sint32 dv)
+{
+    while (count--) {
+        int x0, x1, y0, y1, fx, fy, shift;
+        Uint32 p00, p01, p10, p11, pixel = 0;
+
+        SW_GetBilinearTaps(u, t->w, &x0, &x1, &fx);
+        SW_GetBilinearTaps(v, t->h, &y0, &y1, &fy);
+        p00 = SW_PIXEL(t, x0, y0);
+        p01 = SW_PIXEL(t, x1, y0);
+        p10 = SW_PIXEL(t, x0, y1);
+        p11 = SW_PIXEL(t, x1, y1);
+        for (shift = 0; shift < 32; shift += 8) {
+            const Uint32 top = ((p00 >> shift) & 0xFF) * (128 - fx) + ((p01 >> shift) & 0xFF) * fx;
+            const Uint32 bottom = ((p10 >> shift) & 0xFF) * (128 - fx) + ((p11 >> shift) & 0xFF) * fx;
+            pixel |= ((top * (128 - fy) + bottom * fy + 8192) >> 14) << shift;
         }
+        *dst++ = pixel | t->alpha;
+        u += du;
+        v += dv;
     }
+}
 
-    /* Create a new surface should there be a format mismatch or if scaling, cropping,
-     * or modulation is required. It's possible to use the source surface directly otherwise.
-     */
-    if (!retval && (blitRequired || applyModulation)) {
-        SDL_Rect scale_rect = tmp_rect;
-        src_scaled = SDL_CreateRGBSurface(0, final_rect.w, final_rect.h, 32,
-                                          0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
-        if (src_scaled == NULL) {
-            retval = -1;
-        } else {
-            SDL_SetSurfaceBlendMode(src_clone, SDL_BLENDMODE_NONE);
-            retval = SDL_BlitScaled(src_clone, srcrect, src_scaled, &scale_rect);
-            SDL_FreeSurface(src_clone);
-            src_clone = src_scaled;
-            src_scaled = NULL;
-        }
+#if HAVE_SSE2_INTRINSICS
+static void
+SW_TransformSpanBilinear_SSE2(const SW_Transform * t, Uint32 * dst, int count,
+                              Sint32 u, Sint32 v, Sint32 du, Sint32 dv)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi32(8192);
+    const __m128i alpha = _mm_cvtsi32_si128((int) t->alpha);
+
+    while (count--) {
+        int x0, x1, y0, y1, fx, fy;
+        __m128i left, right, rows, pixel;
+
+        SW_GetBilinearTaps(u, t->w, &x0, &x1, &fx);
+        SW_GetBilinearTaps(v, t->h, &y0, &y1, &fy);
+
+        /* Blend the columns of both rows at once, then the two rows */
+        left = _mm_unpacklo_epi32(_mm_cvtsi32_si128((int) SW_PIXEL(t, x0, y0)),
+                                  _mm_cvtsi32_si128((int) SW_PIXEL(t, x0, y1)));
+        right = _mm_unpacklo_epi32(_mm_cvtsi32_si128((int) SW_PIXEL(t, x1, y0)),
+                                   _mm_cvtsi32_si128((int) SW_PIXEL(t, x1, y1)));
+        rows = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(left, zero), _mm_set1_epi16((short) (128 - fx))),
+                             _mm_mullo_epi16(_mm_unpacklo_epi8(right, zero), _mm_set1_epi16((short) fx)));
+        pixel = _mm_madd_epi16(_mm_unpacklo_epi16(rows, _mm_srli_si128(rows, 8)),
+                               _mm_set1_epi32((128 - fy) | (fy << 16)));
+        pixel = _mm_srli_epi32(_mm_add_epi32(pixel, round), 14);
+        pixel = _mm_packus_epi16(_mm_packs_epi32(pixel, zero), zero);
+        *dst++ = (Uint32) _mm_cvtsi128_si32(_mm_or_si128(pixel, alpha));
+        u += du;
+        v += dv;
     }
+}
+#endif /* HAVE_SSE2_INTRINSICS */
 
-    /* SDLgfx_rotateSurface is going to make decisions depending on the blend mode. */
-    SDL_SetSurfaceBlendMode(src_clone, blendmode);
+#if HAVE_NEON_INTRINSICS
+static void
+SW_TransformSpanBilinear_NEON(const SW_Transform * t, Uint32 * dst, int count,
+                              Sint32 u, Sint32 v, Sint32 du, Sint32 dv)
+{
+    while (count--) {
+        int x0, x1, y0, y1, fx, fy;
+        uint32x2_t top, bottom;
+        uint16x8_t rows;
+        uint16x4_t weights;
+        uint32x4_t pixel;
+
+        SW_GetBilinearTaps(u, t->w, &x0, &x1, &fx);
+        SW_GetBilinearTaps(v, t->h, &y0, &y1, &fy);
+
+        /* Blend the columns of both rows at once, then the two rows */
+        top = vset_lane_u32(SW_PIXEL(t, x1, y0), vdup_n_u32(SW_PIXEL(t, x0, y0)), 1);
+        bottom = vset_lane_u32(SW_PIXEL(t, x1, y1), vdup_n_u32(SW_PIXEL(t, x0, y1)), 1);
+        weights = vdup_n_u16((uint16_t) (128 - fx));
+        rows = vcombine_u16(vadd_u16(vmul_u16(vget_low_u16(vmovl_u8(vreinterpret_u8_u32(top))), weights),
+                                     vmul_n_u16(vget_high_u16(vmovl_u8(vreinterpret_u8_u32(top))), (uint16_t) fx)),
+                            vadd_u16(vmul_u16(vget_low_u16(vmovl_u8(vreinterpret_u8_u32(bottom))), weights),
+                                     vmul_n_u16(vget_high_u16(vmovl_u8(vreinterpret_u8_u32(bottom))), (uint16_t) fx)));
+        pixel = vmlal_n_u16(vmull_n_u16(vget_low_u16(rows), (uint16_t) (128 - fy)), vget_high_u16(rows), (uint16_t) fy);
+        *dst++ = vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(vrshrn_n_u32(pixel, 14), vdup_n_u16(0)))), 0) | t->alpha;
+        u += du;
+        v += dv;
+    }
+}
+#endif /* HAVE_NEON_INTRINSICS */
 
-    if (!retval) {
-        SDLgfx_rotozoomSurfaceSizeTrig(tmp_rect.w, tmp_rect.h, angle, &dstwidth, &dstheight, &cangle, &sangle);
-        src_rotated = SDLgfx_rotateSurface(src_clone, angle, dstwidth/2, dstheight/2, GetScaleQuality(), flip & SDL_FLIP_HORIZONTAL, flip & SDL_FLIP_VERTICAL, dstwidth, dstheight, cangle, sangle);
-        if (src_rotated == NULL) {
-            retval = -1;
-        }
-        if (!retval && mask != NULL) {
-            /* The mask needed for the NONE blend mode gets rotated with the same parameters. */
-            mask_rotated = SDLgfx_rotateSurface(mask, angle, dstwidth/2, dstheight/2, SDL_FALSE, 0, 0, dstwidth, dstheight, cangle, sangle);
-            if (mask_rotated == NULL) {
-                retval = -1;
+/* Sample the destination pixels [x, x + count) of row y */
+static void
+SW_TransformSpan(const SW_Transform * t, Uint32 * dst, int x, int y, int count)
+{
+    const double xc = x + 0.5;
+    const double yc = y + 0.5;
+    Sint32 u = SW_ToFixed(t->u0 + xc * t->dudx + yc * t->dudy);
+    Sint32 v = SW_ToFixed(t->v0 + xc * t->dvdx + yc * t->dvdy);
+    const Sint32 du = SW_ToFixed(t->dudx);
+    const Sint32 dv = SW_ToFixed(t->dvdx);
+
+    if (!t->bilinear) {
+        SW_TransformSpanNearest(t, dst, count, u, v, du, dv);
+        return;
+    }
+
+    /* Bilinear positions are relative to the source pixel centers */
+    u -= 0x8000;
+    v -= 0x8000;
+#if HAVE_SSE2_INTRINSICS
+    if (t->sse2) {
+        SW_TransformSpanBilinear_SSE2(t, dst, count, u, v, du, dv);
+        return;
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (t->neon) {
+        SW_TransformSpanBilinear_NEON(t, dst, count, u, v, du, dv);
+        return;
+    }
+#endif
+    SW_TransformSpanBilinear(t, dst, count, u, v, du, dv);
+}
+
+/* Narrow [*lo, *hi) to the pixel centers c where 0 <= a * c + b < len */
+static void
+SW_ClipSpan(double a, double b, int len, double *lo, double *hi)
+{
+    double c0, c1;
+
+    if (a == 0.0) {
+        if (b < 0.0 || b >= len) {
+            *hi = *lo;
+        }
+        return;
+    }
+
+    c0 = -b / a;
+    c1 = (len - b) / a;
+    if (a < 0.0) {
+        const double tmp = c0;
+        c0 = c1;
+        c1 = tmp;
+    }
+    *lo = SDL_max(*lo, c0);
+    *hi = SDL_min(*hi, c1);
+}
+
+/* Find the pixels [*start, *end) of row y within [x0, x1) that sample the source */
+static void
+SW_GetTransformSpan(const SW_Transform * t, int y, int x0, int x1, int *start, int *end)
+{
+    const double yc = y + 0.5;
+    double lo = x0;
+    double hi = x1;
+
+    SW_ClipSpan(t->dudx, t->u0 + yc * t->dudy, t->w, &lo, &hi);
+    SW_ClipSpan(t->dvdx, t->v0 + yc * t->dvdy, t->h, &lo, &hi);
+    if (lo >= hi) {
+        *start = *end = x0;
+        return;
+    }
+    *start = SDL_max(x0, (int) SDL_ceil(lo - 0.5));
+    *end = SDL_min(x1, (int) SDL_ceil(hi - 0.5));
+    if (*end < *start) {
+        *end = *start;
+    }
+}
+
+static void
+SW_FillSpan(Uint32 * dst, int count, Uint32 value)
+{
+    while (count--) {
+        *dst++ = value;
+    }
+}
+
+static SDL_Surface *
+SW_GetScratchSurface(SDL_Surface ** surface, int w, int h, Uint32 format)
+{
+    SDL_Surface *scratch = *surface;
+
+    if (scratch) {
+        if (scratch->format->format == format && scratch->w >= w && scratch->h >= h) {
+            return scratch;
+        }
+        /* Grow to fit everything seen so far, so it settles at the largest size */
+        w = SDL_max(w, scratch->w);
+        h = SDL_max(h, scratch->h);
+        SDL_FreeSurface(scratch);
+    }
+    *surface = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, format);
+    return *surface;
+}
+
+static void
+SW_FreeScratch(SW_Scratch * scratch)
+{
+    SDL_FreeSurface(scratch->band);
+    SDL_FreeSurface(scratch->source);
+    SDL_zerop(scratch);
+}
+
+static int
+SW_CopyEx(SDL_Surface * surface, SW_Scratch * scratch, const SDL_Rect * viewport,
+          SDL_Surface * src, const SDL_Rect * srcrect, const SDL_FRect * dstrect,
+          const double angle, const SDL_FPoint * center, const SDL_RendererFlip flip,
+          SDL_ScaleQuality quality)
+{
+    Uint32 format = src->format->format;
+    SDL_Rect final_rect, bounds;
+    SW_Transform t;
+    SDL_Surface *band;
+    SDL_BlendMode blendMode;
+    SDL_bool spans;
+    Uint8 r, g, b, a;
+    double cx, cy, radians, cangle, sangle, scalex, scaley, fx, fy, px, py;
+    double minx, miny, maxx, maxy;
+    int i, y, band_rows, retval = 0;
+
+    if (viewport->x || viewport->y) {
+        final_rect.x = (int)(viewport->x + dstrect->x);
+        final_rect.y = (int)(viewport->y + dstrect->y);
+    } else {
+        final_rect.x = (int)dstrect->x;
+        final_rect.y = (int)dstrect->y;
+    }
+    final_rect.w = (int)dstrect->w;
+    final_rect.h = (int)dstrect->h;
+
+    if (final_rect.w <= 0 || final_rect.h <= 0 || srcrect->w <= 0 || srcrect->h <= 0) {
+        return 0;
+    }
+
+    cx = final_rect.x + (int)center->x;
+    cy = final_rect.y + (int)center->y;
+    radians = angle * (M_PI / 180.0);
+    cangle = SDL_cos(radians);
+    sangle = SDL_sin(radians);
+    /* Keep quarter turns exact, so they sample like unrotated copies */
+    if (SDL_fabs(cangle) < 1e-12) {
+        cangle = 0.0;
+        sangle = (sangle < 0.0) ? -1.0 : 1.0;
+    } else if (SDL_fabs(sangle) < 1e-12) {
+        sangle = 0.0;
+        cangle = (cangle < 0.0) ? -1.0 : 1.0;
+    }
+
+    /* The rotated corners of the destination rectangle bound the pixels drawn */
+    minx = maxx = miny = maxy = 0.0;
+    for (i = 0; i < 4; ++i) {
+        const double dx = ((i & 1) ? (final_rect.x + final_rect.w) : final_rect.x) - cx;
+        const double dy = ((i & 2) ? (final_rect.y + final_rect.h) : final_rect.y) - cy;
+        px = cx + dx * cangle - dy * sangle;
+        py = cy + dx * sangle + dy * cangle;
+        if (i == 0) {
+            minx = maxx = px;
+            miny = maxy = py;
+        }
+        minx = SDL_min(minx, px);
+        maxx = SDL_max(maxx, px);
+        miny = SDL_min(miny, py);
+        maxy = SDL_max(maxy, py);
+    }
+    bounds.x = (int)SDL_floor(minx);
+    bounds.y = (int)SDL_floor(miny);
+    bounds.w = (int)SDL_ceil(maxx) - bounds.x;
+    bounds.h = (int)SDL_ceil(maxy) - bounds.y;
+    if (!SDL_IntersectRect(&bounds, &surface->clip_rect, &bounds)) {
+        return 0;
+    }
+
+    if (src->flags & SDL_RLEACCEL) {
+        /* The pixels are read directly, so permanently disable RLE like scaling does */
+        SDL_SetSurfaceRLE(src, 0);
+        SDL_UnRLESurface(src, 1);
+    }
+
+    /* Sample 8888 sources in place and convert everything else */
+    SDL_zero(t);
+    if (SDL_PIXELTYPE(format) == SDL_PIXELTYPE_PACKED32 &&
+        SDL_PIXELLAYOUT(format) == SDL_PACKEDLAYOUT_8888) {
+        t.pixels = (const Uint8 *) src->pixels + srcrect->y * src->pitch + srcrect->x * 4;
+        t.pitch = src->pitch;
+        if (!src->format->Amask) {
+            /* Sample into the matching format with alpha, filling it in */
+            t.alpha = ~(src->format->Rmask | src->format->Gmask | src->format->Bmask);
+            switch (format) {
+            case SDL_PIXELFORMAT_RGB888:
+                format = SDL_PIXELFORMAT_ARGB8888;
+                break;
+            case SDL_PIXELFORMAT_BGR888:
+                format = SDL_PIXELFORMAT_ABGR8888;
+                break;
+            case SDL_PIXELFORMAT_RGBX8888:
+                format = SDL_PIXELFORMAT_RGBA8888;
+                break;
+            case SDL_PIXELFORMAT_BGRX8888:
+                format = SDL_PIXELFORMAT_BGRA8888;
+                break;
+            default:
+                format = SDL_MasksToPixelFormatEnum(32, src->format->Rmask, src->format->Gmask,
+                                                    src->format->Bmask, t.alpha);
+                break;
             }
         }
-        if (!retval) {
-            /* Find out where the new origin is by rotating the four final_rect points around the center and then taking the extremes */
-            abscenterx = final_rect.x + (int)center->x;
-            abscentery = final_rect.y + (int)center->y;
-            /* Compensate the angle inversion to match the behaviour of the other backends */
-            sangle = -sangle;
-
-            /* Top Left */
-            px = final_rect.x - abscenterx;
-            py = final_rect.y - abscentery;
-            p1x = px * cangle - py * sangle + abscenterx;
-            p1y = px * sangle + py * cangle + abscentery;
-
-            /* Top Right */
-            px = final_rect.x + final_rect.w - abscenterx;
-            py = final_rect.y - abscentery;
-            p2x = px * cangle - py * sangle + abscenterx;
-            p2y = px * sangle + py * cangle + abscentery;
-
-            /* Bottom Left */
-            px = final_rect.x - abscenterx;
-            py = final_rect.y + final_rect.h - abscentery;
-            p3x = px * cangle - py * sangle + abscenterx;
-            p3y = px * sangle + py * cangle + abscentery;
-
-            /* Bottom Right */
-            px = final_rect.x + final_rect.w - abscenterx;
-            py = final_rect.y + final_rect.h - abscentery;
-            p4x = px * cangle - py * sangle + abscenterx;
-            p4y = px * sangle + py * cangle + abscentery;
-
-            tmp_rect.x = (int)MIN(MIN(p1x, p2x), MIN(p3x, p4x));
-            tmp_rect.y = (int)MIN(MIN(p1y, p2y), MIN(p3y, p4y));
-            tmp_rect.w = dstwidth;
-            tmp_rect.h = dstheight;
-
-            /* The NONE blend mode needs some special care with non-opaque surfaces.
-             * Other blend modes or opaque surfaces can be blitted directly.
-             */
-            if (blendmode != SDL_BLENDMODE_NONE || isOpaque) {
-                if (applyModulation == SDL_FALSE) {
-                    /* If the modulation wasn't already applied, make it happen now. */
-                    SDL_SetSurfaceAlphaMod(src_rotated, alphaMod);
-                    SDL_SetSurfaceColorMod(src_rotated, rMod, gMod, bMod);
-                }
-                retval = SDL_BlitSurface(src_rotated, NULL, surface, &tmp_rect);
-            } else {
-                /* The NONE blend mode requires three steps to get the pixels onto the destination surface.
-                 * First, the area where the rotated pixels will be blitted to get set to zero.
-                 * This is accomplished by simply blitting a mask with the NONE blend mode.
-                 * The colorkey set by the rotate function will discard the correct pixels.
-                 */
-                SDL_Rect mask_rect = tmp_rect;
-                SDL_SetSurfaceBlendMode(mask_rotated, SDL_BLENDMODE_NONE);
-                retval = SDL_BlitSurface(mask_rotated, NULL, surface, &mask_rect);
-                if (!retval) {
-                    /* The next step copies the alpha value. This is done with the BLEND blend mode and
-                     * by modulating the source colors with 0. Since the destination is all zeros, this
-                     * will effectively set the destination alpha to the source alpha.
-                     */
-                    SDL_SetSurfaceColorMod(src_rotated, 0, 0, 0);
-                    mask_rect = tmp_rect;
-                    retval = SDL_BlitSurface(src_rotated, NULL, surface, &mask_rect);
-                    if (!retval) {
-                        /* The last step gets the color values in place. The ADD blend mode simply adds them to
-                         * the destination (where the color values are all zero). However, because the ADD blend
-                         * mode modulates the colors with the alpha channel, a surface without an alpha mask needs
-                         * to be created. This makes all source pixels opaque and the colors get copied correctly.
-                         */
-                        SDL_Surface *src_rotated_rgb;
-                        src_rotated_rgb = SDL_CreateRGBSurfaceFrom(src_rotated->pixels, src_rotated->w, src_rotated->h,
-                                                                   src_rotated->format->BitsPerPixel, src_rotated->pitch,
-                                                                   src_rotated->format->Rmask, src_rotated->format->Gmask,
-                                                                   src_rotated->format->Bmask, 0);
-                        if (src_rotated_rgb == NULL) {
-                            retval = -1;
-                        } else {
-                            SDL_SetSurfaceBlendMode(src_rotated_rgb, SDL_BLENDMODE_ADD);
-                            retval = SDL_BlitSurface(src_rotated_rgb, NULL, surface, &tmp_rect);
-                            SDL_FreeSurface(src_rotated_rgb);
-                        }
+    } else {
+        SDL_Surface *converted = SW_GetScratchSurface(&scratch->source, srcrect->w, srcrect->h,
+                                                      SDL_PIXELFORMAT_ARGB8888);
+        if (!converted) {
+            return -1;
+        }
+        if (SDL_ConvertPixels(srcrect->w, srcrect->h, format,
+                              (const Uint8 *) src->pixels + srcrect->y * src->pitch +
+                              srcrect->x * src->format->BytesPerPixel, src->pitch,
+                              SDL_PIXELFORMAT_ARGB8888, converted->pixels, converted->pitch) < 0) {
+            return -1;
+        }
+        format = SDL_PIXELFORMAT_ARGB8888;
+        t.pixels = (const Uint8 *) converted->pixels;
+        t.pitch = converted->pitch;
+    }
+    t.w = srcrect->w;
+    t.h = srcrect->h;
+
+    /* Map destination pixels back through the rotation, flips and scale:
+       a destination point p samples R^-1 (p - c) + c - origin, scaled */
+    scalex = (double) srcrect->w / final_rect.w;
+    scaley = (double) srcrect->h / final_rect.h;
+    fx = (flip & SDL_FLIP_HORIZONTAL) ? -scalex : scalex;
+    fy = (flip & SDL_FLIP_VERTICAL) ? -scaley : scaley;
+    px = cx - cx * cangle - cy * sangle - final_rect.x;
+    py = cy + cx * sangle - cy * cangle - final_rect.y;
+    t.u0 = px * fx + ((flip & SDL_FLIP_HORIZONTAL) ? srcrect->w : 0);
+    t.v0 = py * fy + ((flip & SDL_FLIP_VERTICAL) ? srcrect->h : 0);
+    t.dudx = cangle * fx;
+    t.dudy = sangle * fx;
+    t.dvdx = -sangle * fy;
+    t.dvdy = cangle * fy;
+    t.bilinear = (quality != SDL_SCALEQUALITY_NEAREST);
+    t.sse2 = SW_HasSSE2();
+    t.neon = SW_HasNEON();
+
+    /* Pixels are sampled into a band of rows and then blitted with the blend
+       mode and modulation of the source. Pixels around the copy are left
+       transparent where that doesn't change the target, otherwise only the
+       spans of each row are blitted */
+    SDL_GetSurfaceBlendMode(src, &blendMode);
+    spans = (blendMode == SDL_BLENDMODE_NONE || blendMode == SDL_BLENDMODE_MOD);
+
+    band_rows = SDL_min(bounds.h, SW_COPYEX_BAND_ROWS);
+    band = SW_GetScratchSurface(&scratch->band, bounds.w, band_rows, format);
+    if (!band) {
+        return -1;
+    }
+    SDL_GetSurfaceColorMod(src, &r, &g, &b);
+    SDL_GetSurfaceAlphaMod(src, &a);
+    SDL_SetSurfaceColorMod(band, r, g, b);
+    SDL_SetSurfaceAlphaMod(band, a);
+    SDL_SetSurfaceBlendMode(band, blendMode);
+
+    for (y = bounds.y; y < bounds.y + bounds.h; y += band_rows) {
+        const int rows = SDL_min(band_rows, bounds.y + bounds.h - y);
+        int starts[SW_COPYEX_BAND_ROWS], ends[SW_COPYEX_BAND_ROWS];
+        int left = bounds.x + bounds.w, right = bounds.x;
+        SDL_Rect srect, drect;
+
+        for (i = 0; i < rows; ++i) {
+            SW_GetTransformSpan(&t, y + i, bounds.x, bounds.x + bounds.w, &starts[i], &ends[i]);
+            if (starts[i] < ends[i]) {
+                left = SDL_min(left, starts[i]);
+                right = SDL_max(right, ends[i]);
+            }
+        }
+        if (left >= right) {
+            continue;
+        }
+
+        for (i = 0; i < rows; ++i) {
+            Uint32 *row = (Uint32 *) ((Uint8 *) band->pixels + i * band->pitch) - left;
+
+            if (starts[i] < ends[i]) {
+                SW_TransformSpan(&t, row + starts[i], starts[i], y + i, ends[i] - starts[i]);
+            }
+
+            if (spans) {
+                if (starts[i] < ends[i]) {
+                    srect.x = starts[i] - left;
+                    srect.y = i;
+                    srect.w = ends[i] - starts[i];
+                    srect.h = 1;
+                    drect.x = starts[i];
+                    drect.y = y + i;
+                    drect.w = srect.w;
+                    drect.h = srect.h;
+                    if (SDL_LowerBlit(band, &srect, surface, &drect) < 0) {
+                        retval = -1;
                     }
                 }
-                SDL_FreeSurface(mask_rotated);
+            } else if (starts[i] < ends[i]) {
+                SW_FillSpan(row + left, starts[i] - left, 0);
+                SW_FillSpan(row + ends[i], right - ends[i], 0);
+            } else {
+                SW_FillSpan(row + left, right - left, 0);
             }
-            if (src_rotated != NULL) {
-                SDL_FreeSurface(src_rotated);
+        }
+
+        if (!spans) {
+            srect.x = 0;
+            srect.y = 0;
+            srect.w = right - left;
+            srect.h = rows;
+            drect.x = left;
+            drect.y = y;
+            drect.w = srect.w;
+            drect.h = srect.h;
+            if (SDL_LowerBlit(band, &srect, surface, &drect) < 0) {
+                retval = -1;
             }
         }
     }
+    return retval;
+}
+
+static int
+SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
+                const SDL_Rect * srcrect, const SDL_FRect * dstrect,
+                const double angle, const SDL_FPoint * center, const SDL_RendererFlip flip)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+    SDL_Surface *src = (SDL_Surface *) texture->driverdata;
+
+    if (!surface) {
+        return -1;
+    }
 
-    if (SDL_MUSTLOCK(src)) {
-        SDL_UnlockSurface(src);
+    if (SW_IsDrawingToWindow(renderer)) {
+        SDL_RenderCopyExData copy;
+        copy.srcrect = *srcrect;
+        copy.dstrect = *dstrect;
+        copy.angle = angle;
+        copy.center = *center;
+        copy.flip = flip;
+        SW_AddDrawDamage(renderer, surface, SDL_RENDERCMD_COPY_EX, &copy, 1);
     }
-    if (mask != NULL) {
-        SDL_FreeSurface(mask);
+    return SW_CopyEx(surface, &data->scratch, &renderer->viewport, src, srcrect, dstrect,
+                     angle, center, flip, (SDL_ScaleQuality) texture->scaleQuality);
+}
+
+static int
+SW_RenderGeometry(SDL_Renderer * renderer, SDL_Texture * texture,
+                  const SDL_Vertex * vertices, int num_vertices,
+                  const int *indices, int num_indices)
+{
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+    const int count = indices ? num_indices : num_vertices;
+
+    if (!surface) {
+        return -1;
     }
-    if (src_clone != NULL) {
-        SDL_FreeSurface(src_clone);
+
+    /* Every vertex is covered, the indexed ones are a subset of them */
+    SW_AddDrawDamage(renderer, surface, SDL_RENDERCMD_GEOMETRY, vertices, num_vertices);
+
+    if (texture) {
+        return SDL_SW_RenderGeometry(surface, (SDL_Surface *) texture->driverdata,
+                                     vertices, indices, count,
+                                     renderer->viewport.x, renderer->viewport.y,
+                                     texture->r, texture->g, texture->b, texture->a,
+                                     texture->blendMode, (SDL_ScaleQuality) texture->scaleQuality);
     }
-    return retval;
+    return SDL_SW_RenderGeometry(surface, NULL, vertices, indices, count,
+                                 renderer->viewport.x, renderer->viewport.y,
+                                 255, 255, 255, 255, renderer->blendMode,
+                                 SDL_SCALEQUALITY_NEAREST);
 }
 
 static int
@@ -865,17 +1710,570 @@ SW_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
 static void
 SW_RenderPresent(SDL_Renderer * renderer)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Window *window = renderer->window;
 
     if (window) {
-        SDL_UpdateWindowSurface(window);
+        /* Only push the parts of the window drawn since the last present */
+        if (data->damage_full) {
+            SDL_UpdateWindowSurface(window);
+        } else if (data->damage) {
+            int count;
+            const SDL_Rect *rects = SDL_GetRegionRects(data->damage, &count);
+
+            if (count > 0) {
+                SDL_UpdateWindowSurfaceRects(window, rects, count);
+            }
+        }
+    }
+    data->damage_full = SDL_FALSE;
+    SDL_ClearRegion(data->damage);
+}
+
+static void
+SW_SetCopyState(SDL_Surface * src, const SDL_RenderCommand *cmd)
+{
+    /* The modulation is taken from the time the copy was queued */
+    SDL_SetSurfaceColorMod(src, cmd->data.draw.r, cmd->data.draw.g, cmd->data.draw.b);
+    SDL_SetSurfaceAlphaMod(src, cmd->data.draw.a);
+    SDL_SetSurfaceBlendMode(src, cmd->data.draw.blend);
+}
+
+static SDL_Surface *
+SW_CreateSurfaceAlias(SDL_Surface * surface)
+{
+    SDL_Surface *alias;
+    SDL_BlendMode blendMode;
+    Uint32 colorkey;
+    Uint8 r, g, b, a;
+
+    alias = SDL_CreateRGBSurfaceWithFormatFrom(surface->pixels, surface->w, surface->h,
+                                               surface->format->BitsPerPixel, surface->pitch,
+                                               surface->format->format);
+    if (!alias) {
+        return NULL;
+    }
+
+    if (SDL_GetColorKey(surface, &colorkey) == 0) {
+        SDL_SetColorKey(alias, SDL_TRUE, colorkey);
+    }
+    SDL_GetSurfaceColorMod(surface, &r, &g, &b);
+    SDL_SetSurfaceColorMod(alias, r, g, b);
+    SDL_GetSurfaceAlphaMod(surface, &a);
+    SDL_SetSurfaceAlphaMod(alias, a);
+    SDL_GetSurfaceBlendMode(surface, &blendMode);
+    SDL_SetSurfaceBlendMode(alias, blendMode);
+    return alias;
+}
+
+static SDL_Surface *
+SW_GetSourceSurface(SW_Rasterizer * rasterizer, SDL_Texture * texture)
+{
+    SDL_Surface *src = (SDL_Surface *) texture->driverdata;
+    SDL_Surface *surface;
+    int i;
+
+    if (!rasterizer) {
+        return src;
+    }
+
+    for (i = 0; i < rasterizer->num_sources; ++i) {
+        if (rasterizer->sources[i].texture == src) {
+            return rasterizer->sources[i].surface;
+        }
+    }
+
+    if (rasterizer->num_sources == rasterizer->max_sources) {
+        const int newmax = rasterizer->max_sources ? (rasterizer->max_sources * 2) : 8;
+        SW_SourceSurface *ptr = (SW_SourceSurface *) SDL_realloc(rasterizer->sources, newmax * sizeof (*ptr));
+        if (!ptr) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        rasterizer->sources = ptr;
+        rasterizer->max_sources = newmax;
+    }
+
+    surface = SW_CreateSurfaceAlias(src);
+    if (!surface) {
+        return NULL;
+    }
+    rasterizer->sources[rasterizer->num_sources].texture = src;
+    rasterizer->sources[rasterizer->num_sources].surface = surface;
+    rasterizer->num_sources++;
+    return surface;
+}
+
+static int
+SW_DrawCommands(SDL_Surface * surface, SW_Rasterizer * rasterizer, SW_Scratch * scratch,
+                const SDL_Rect * bounds, const SDL_Rect * viewport, const SDL_RenderCommand *cmd, int count,
+                const void *vertices)
+{
+    const SW_CommandInfo *info = rasterizer ? rasterizer->data->info : NULL;
+    SDL_Rect current_viewport = *viewport;
+    SDL_Rect clip_rect = rasterizer ? rasterizer->data->clip_rect : surface->clip_rect;
+    /* Lines and scaled copies drawn in a band are clipped to the whole target */
+    const SDL_Rect *target_clip = bounds ? &clip_rect : NULL;
+    int retval = 0;
+    int i;
+
+    for (i = 0; i < count; ++i, ++cmd) {
+        const void *verts = NULL;
+        int num = 0;
+        int status = 0;
+
+        if (cmd->command >= SDL_RENDERCMD_DRAW_POINTS) {
+            if (info && (info[i].y1 <= bounds->y || info[i].y0 >= bounds->y + bounds->h)) {
+                /* Nothing to draw in this band */
+                continue;
+            }
+            verts = (const Uint8 *) vertices + cmd->data.draw.first;
+            num = (int) cmd->data.draw.count;
+        }
+
+        switch (cmd->command) {
+            case SDL_RENDERCMD_SETVIEWPORT:
+                current_viewport = cmd->data.viewport.rect;
+                SW_SetClip(surface, bounds, &current_viewport, SDL_FALSE, NULL);
+                SW_GetTargetClip(surface, &current_viewport, SDL_FALSE, NULL, &clip_rect);
+                break;
+
+            case SDL_RENDERCMD_SETCLIPRECT:
+                SW_SetClip(surface, bounds, &current_viewport, cmd->data.cliprect.enabled,
+                           &cmd->data.cliprect.rect);
+                SW_GetTargetClip(surface, &current_viewport, cmd->data.cliprect.enabled,
+                                 &cmd->data.cliprect.rect, &clip_rect);
+                break;
+
+            case SDL_RENDERCMD_CLEAR:
+                status = SW_Clear(surface, bounds, cmd->data.color.r, cmd->data.color.g,
+                                  cmd->data.color.b, cmd->data.color.a);
+                break;
+
+            case SDL_RENDERCMD_DRAW_POINTS:
+                status = SW_DrawPoints(surface, &current_viewport, (const SDL_FPoint *) verts, num,
+                                       cmd->data.draw.r, cmd->data.draw.g, cmd->data.draw.b,
+                                       cmd->data.draw.a, cmd->data.draw.blend);
+                break;
+
+            case SDL_RENDERCMD_DRAW_LINES:
+                status = SW_DrawLines(surface, target_clip, &current_viewport, (const SDL_FPoint *) verts, num,
+                                      cmd->data.draw.r, cmd->data.draw.g, cmd->data.draw.b,
+                                      cmd->data.draw.a, cmd->data.draw.blend);
+                break;
+
+            case SDL_RENDERCMD_FILL_RECTS:
+                status = SW_FillRects(surface, &current_viewport, (const SDL_FRect *) verts, num,
+                                      cmd->data.draw.r, cmd->data.draw.g, cmd->data.draw.b,
+                                      cmd->data.draw.a, cmd->data.draw.blend);
+                break;
+
+            case SDL_RENDERCMD_COPY: {
+                SDL_Surface *src = SW_GetSourceSurface(rasterizer, cmd->data.draw.texture);
+                const SDL_RenderCopyData *copy = (const SDL_RenderCopyData *) verts;
+                int j;
+
+                if (!src) {
+                    status = -1;
+                    break;
+                }
+                SW_SetCopyState(src, cmd);
+                for (j = 0; j < num; ++j, ++copy) {
+                    status |= SW_Copy(surface, target_clip, &current_viewport, src, &copy->srcrect, &copy->dstrect,
+                                      (SDL_ScaleQuality) cmd->data.draw.texture->scaleQuality);
+                }
+                break;
+            }
+
+            case SDL_RENDERCMD_COPY_EX: {
+                SDL_Surface *src = SW_GetSourceSurface(rasterizer, cmd->data.draw.texture);
+                const SDL_RenderCopyExData *copy = (const SDL_RenderCopyExData *) verts;
+                int j;
+
+                if (!src) {
+                    status = -1;
+                    break;
+                }
+                /* Each band draws its own rows of the copies, clipped to the band */
+                SW_SetCopyState(src, cmd);
+                for (j = 0; j < num; ++j, ++copy) {
+                    status |= SW_CopyEx(surface, scratch, &current_viewport, src, &copy->srcrect,
+                                        &copy->dstrect, copy->angle, &copy->center, copy->flip,
+                                        (SDL_ScaleQuality) cmd->data.draw.texture->scaleQuality);
+                }
+                break;
+            }
+
+            case SDL_RENDERCMD_GEOMETRY: {
+                SDL_Surface *src = NULL;
+
+                if (cmd->data.draw.texture) {
+                    src = SW_GetSourceSurface(rasterizer, cmd->data.draw.texture);
+                    if (!src) {
+                        status = -1;
+                        break;
+                    }
+                }
+                status = SDL_SW_RenderGeometry(surface, src, (const SDL_Vertex *) verts, NULL, num,
+                                               current_viewport.x, current_viewport.y,
+                                               cmd->data.draw.r, cmd->data.draw.g,
+                                               cmd->data.draw.b, cmd->data.draw.a,
+                                               cmd->data.draw.blend,
+                                               cmd->data.draw.texture ?
+                                               (SDL_ScaleQuality) cmd->data.draw.texture->scaleQuality :
+                                               SDL_SCALEQUALITY_NEAREST);
+                break;
+            }
+
+            case SDL_RENDERCMD_NO_OP:
+                break;
+        }
+
+        if (status < 0) {
+            retval = -1;
+        }
+    }
+
+    return retval;
+}
+
+static void
+SW_DrawBands(SW_Rasterizer * rasterizer)
+{
+    SW_RenderData *data = rasterizer->data;
+    SDL_Surface *surface = rasterizer->target;
+    int band;
+
+    while ((band = SDL_AtomicAdd(&data->next_job, 1)) < data->num_bands) {
+        SDL_Rect bounds, clip_rect;
+
+        bounds.x = 0;
+        bounds.y = band * data->band_height;
+        bounds.w = surface->w;
+        bounds.h = SDL_min(data->band_height, surface->h - bounds.y);
+
+        SDL_IntersectRect(&data->clip_rect, &bounds, &clip_rect);
+        SDL_SetClipRect(surface, &clip_rect);
+
+        if (SW_DrawCommands(surface, rasterizer, &rasterizer->scratch, &bounds, &data->viewport,
+                            data->cmds, data->num_cmds, data->vertices) < 0) {
+            SDL_AtomicSet(&data->status, -1);
+        }
+    }
+}
+
+static int SDLCALL
+SW_RasterizerThread(void *ptr)
+{
+    SW_Rasterizer *rasterizer = (SW_Rasterizer *) ptr;
+    SW_RenderData *data = rasterizer->data;
+
+    for (;;) {
+        SDL_SemWait(data->start_sem);
+        if (data->quit) {
+            break;
+        }
+        SW_DrawBands(rasterizer);
+        SDL_SemPost(data->done_sem);
+    }
+    return 0;
+}
+
+static void
+SW_RunThreads(SW_RenderData * data)
+{
+    int i;
+
+    SDL_AtomicSet(&data->next_job, 0);
+
+    /* The thread flushing the queue works as the first rasterizer */
+    for (i = 1; i < data->num_threads; ++i) {
+        SDL_SemPost(data->start_sem);
+    }
+    SW_DrawBands(&data->rasterizers[0]);
+    for (i = 1; i < data->num_threads; ++i) {
+        SDL_SemWait(data->done_sem);
+    }
+}
+
+static void
+SW_StartThreads(SW_RenderData * data)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+    int num_threads = hint ? SDL_atoi(hint) : 1;
+    int i;
+
+    data->num_threads = 1;
+
+    if (num_threads == 0) {
+        num_threads = SDL_GetCPUCount();
+    }
+    num_threads = SDL_min(num_threads, SW_MAX_THREADS);
+    if (num_threads <= 1) {
+        return;
+    }
+
+    data->threads = (SDL_Thread **) SDL_calloc(num_threads, sizeof (*data->threads));
+    data->rasterizers = (SW_Rasterizer *) SDL_calloc(num_threads, sizeof (*data->rasterizers));
+    data->start_sem = SDL_CreateSemaphore(0);
+    data->done_sem = SDL_CreateSemaphore(0);
+    if (!data->threads || !data->rasterizers || !data->start_sem || !data->done_sem) {
+        /* Fall back to drawing on a single thread */
+        SW_StopThreads(data);
+        return;
+    }
+
+    for (i = 0; i < num_threads; ++i) {
+        data->rasterizers[i].data = data;
+    }
+
+    for (i = 1; i < num_threads; ++i) {
+        char name[32];
+
+        SDL_snprintf(name, sizeof (name), "SDLSWRender%d", i);
+        data->threads[i] = SDL_CreateThread(SW_RasterizerThread, name, &data->rasterizers[i]);
+        if (!data->threads[i]) {
+            break;
+        }
+        data->num_threads++;
+    }
+
+    if (data->num_threads == 1) {
+        SW_StopThreads(data);
+    }
+}
+
+static void
+SW_FreeRasterizer(SW_Rasterizer * rasterizer)
+{
+    int i;
+
+    for (i = 0; i < rasterizer->num_sources; ++i) {
+        SDL_FreeSurface(rasterizer->sources[i].surface);
     }
+    SDL_free(rasterizer->sources);
+    rasterizer->sources = NULL;
+    rasterizer->num_sources = 0;
+    rasterizer->max_sources = 0;
+
+    SDL_FreeSurface(rasterizer->target);
+    rasterizer->target = NULL;
+
+    SW_FreeScratch(&rasterizer->scratch);
+}
+
+static void
+SW_StopThreads(SW_RenderData * data)
+{
+    int i;
+
+    data->quit = SDL_TRUE;
+    for (i = 1; i < data->num_threads; ++i) {
+        SDL_SemPost(data->start_sem);
+    }
+    for (i = 1; i < data->num_threads; ++i) {
+        SDL_WaitThread(data->threads[i], NULL);
+    }
+
+    if (data->rasterizers) {
+        for (i = 0; i < data->num_threads; ++i) {
+            SW_FreeRasterizer(&data->rasterizers[i]);
+        }
+    }
+    if (data->start_sem) {
+        SDL_DestroySemaphore(data->start_sem);
+    }
+    if (data->done_sem) {
+        SDL_DestroySemaphore(data->done_sem);
+    }
+    SDL_free(data->threads);
+    SDL_free(data->rasterizers);
+    SDL_free(data->info);
+
+    data->threads = NULL;
+    data->rasterizers = NULL;
+    data->start_sem = NULL;
+    data->done_sem = NULL;
+    data->info = NULL;
+    data->max_info = 0;
+    data->num_threads = 1;
+}
+
+static int
+SW_PrepareRasterizers(SW_RenderData * data, SDL_Surface * surface, int count)
+{
+    int i;
+
+    for (i = 0; i < data->num_threads; ++i) {
+        SW_Rasterizer *rasterizer = &data->rasterizers[i];
+        SDL_Surface *target = rasterizer->target;
+
+        if (!target || target->pixels != surface->pixels ||
+            target->w != surface->w || target->h != surface->h ||
+            target->pitch != surface->pitch ||
+            target->format->format != surface->format->format) {
+            SDL_FreeSurface(target);
+            rasterizer->target = SDL_CreateRGBSurfaceWithFormatFrom(surface->pixels, surface->w, surface->h,
+                                                                    surface->format->BitsPerPixel, surface->pitch,
+                                                                    surface->format->format);
+            if (!rasterizer->target) {
+                return -1;
+            }
+        }
+    }
+
+    if (count > data->max_info) {
+        SW_CommandInfo *info = (SW_CommandInfo *) SDL_realloc(data->info, count * sizeof (*info));
+        if (!info) {
+            return SDL_OutOfMemory();
+        }
+        data->info = info;
+        data->max_info = count;
+    }
+    return 0;
+}
+
+static int
+SW_RunCommandQueueThreaded(SDL_Renderer * renderer, SDL_Surface * surface,
+                           const SDL_RenderCommand *cmd, int count, void *vertices)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SDL_Rect viewport = renderer->viewport;
+    int num_bands;
+    int i;
+
+    if (SW_PrepareRasterizers(data, surface, count) < 0) {
+        return -1;
+    }
+
+    /* Find the rows each command draws to, so bands can skip the rest */
+    for (i = 0; i < count; ++i) {
+        SW_CommandInfo *info = &data->info[i];
+
+        if (cmd[i].command == SDL_RENDERCMD_SETVIEWPORT) {
+            viewport = cmd[i].data.viewport.rect;
+        } else if (cmd[i].command >= SDL_RENDERCMD_DRAW_POINTS) {
+            SDL_Rect rect;
+
+            SW_GetCommandBounds(&cmd[i], (const Uint8 *) vertices + cmd[i].data.draw.first,
+                                &viewport, &rect);
+            info->y0 = rect.y;
+            info->y1 = rect.y + rect.h;
+        }
+    }
+
+    num_bands = data->num_threads * SW_BANDS_PER_THREAD;
+
+    data->cmds = cmd;
+    data->num_cmds = count;
+    data->vertices = vertices;
+    data->viewport = renderer->viewport;
+    data->clip_rect = surface->clip_rect;
+    data->band_height = SDL_max((surface->h + num_bands - 1) / num_bands, SW_MIN_BAND_HEIGHT);
+    data->num_bands = (surface->h + data->band_height - 1) / data->band_height;
+    SDL_AtomicSet(&data->status, 0);
+
+    SW_RunThreads(data);
+
+    /* Leave the target clipped the way the batch left it */
+    viewport = renderer->viewport;
+    for (i = 0; i < count; ++i) {
+        if (cmd[i].command == SDL_RENDERCMD_SETVIEWPORT) {
+            viewport = cmd[i].data.viewport.rect;
+            SDL_SetClipRect(surface, &viewport);
+        } else if (cmd[i].command == SDL_RENDERCMD_SETCLIPRECT) {
+            SW_SetClip(surface, NULL, &viewport, cmd[i].data.cliprect.enabled,
+                       &cmd[i].data.cliprect.rect);
+        }
+    }
+
+    return SDL_AtomicGet(&data->status);
+}
+
+/* Track the window damage of a batch, following its viewport and clip changes */
+static void
+SW_AddCommandQueueDamage(SDL_Renderer * renderer, SDL_Surface * surface,
+                         const SDL_RenderCommand *cmd, int count, const void *vertices)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SDL_Rect viewport = renderer->viewport;
+    SDL_Rect clip_rect = surface->clip_rect;
+    SDL_Rect bounds;
+    int i;
+
+    bounds.x = bounds.y = 0;
+    bounds.w = surface->w;
+    bounds.h = surface->h;
+
+    for (i = 0; i < count && !data->damage_full; ++i) {
+        switch (cmd[i].command) {
+            case SDL_RENDERCMD_SETVIEWPORT:
+                viewport = cmd[i].data.viewport.rect;
+                SDL_IntersectRect(&viewport, &bounds, &clip_rect);
+                break;
+
+            case SDL_RENDERCMD_SETCLIPRECT:
+                SW_GetClip(&viewport, cmd[i].data.cliprect.enabled,
+                           &cmd[i].data.cliprect.rect, &clip_rect);
+                SDL_IntersectRect(&clip_rect, &bounds, &clip_rect);
+                break;
+
+            case SDL_RENDERCMD_CLEAR:
+                data->damage_full = SDL_TRUE;
+                break;
+
+            case SDL_RENDERCMD_NO_OP:
+                break;
+
+            default:
+                SW_AddCommandDamage(renderer, &cmd[i],
+                                    (const Uint8 *) vertices + cmd[i].data.draw.first,
+                                    &viewport, &clip_rect);
+                break;
+        }
+    }
+}
+
+static int
+SW_RunCommandQueue(SDL_Renderer * renderer, const SDL_RenderCommand *cmd,
+                   int count, void *vertices, size_t vertsize)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+
+    if (!surface) {
+        return -1;
+    }
+
+    if (SW_IsDrawingToWindow(renderer)) {
+        SW_AddCommandQueueDamage(renderer, surface, cmd, count, vertices);
+    }
+
+    if (data->num_threads > 1 && surface->h >= 2 * SW_MIN_BAND_HEIGHT && !SDL_MUSTLOCK(surface)) {
+        return SW_RunCommandQueueThreaded(renderer, surface, cmd, count, vertices);
+    }
+
+    return SW_DrawCommands(surface, NULL, &data->scratch, NULL, &renderer->viewport, cmd, count, vertices);
 }
 
 static void
 SW_DestroyTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
+    int i, j;
+
+    /* Drop the surfaces the drawing threads use for this texture */
+    for (i = 0; i < data->num_threads && data->rasterizers; ++i) {
+        SW_Rasterizer *rasterizer = &data->rasterizers[i];
+        for (j = 0; j < rasterizer->num_sources; ++j) {
+            if (rasterizer->sources[j].texture == surface) {
+                SDL_FreeSurface(rasterizer->sources[j].surface);
+                rasterizer->sources[j] = rasterizer->sources[--rasterizer->num_sources];
+                break;
+            }
+        }
+    }
 
     SDL_FreeSurface(surface);
 }
@@ -885,6 +2283,11 @@ SW_DestroyRenderer(SDL_Renderer * renderer)
 {
     SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
 
+    if (data) {
+        SW_StopThreads(data);
+        SW_FreeScratch(&data->scratch);
+        SDL_FreeRegion(data->damage);
+    }
     SDL_free(data);
     SDL_free(renderer);
 }
@@ -0,0 +1,430 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+#if !SDL_RENDER_DISABLED
+
+#include "../SDL_sysrender.h"
+#include "SDL_draw.h"
+#include "SDL_blendfillrect.h"
+#include "SDL_triangle.h"
+
+/* Interpolated per-vertex attributes: r, g, b, a, u, v */
+#define NUM_ATTRS   6
+
+/* Pixel rows and columns are covered when their center is inside the
+   triangle. Pixels exactly on an edge belong to the triangle if the edge is
+   a top or a left edge, so meshes sharing edges touch each pixel only once. */
+static SDL_bool
+IsTopLeftEdge(float ex, float ey)
+{
+    return (ey < 0.0f || (ey == 0.0f && ex > 0.0f)) ? SDL_TRUE : SDL_FALSE;
+}
+
+static void
+RasterizeTriangle(SDL_Surface * dst, SDL_Surface * src,
+                  const SDL_Vertex * p0, const SDL_Vertex * p1, const SDL_Vertex * p2,
+                  int offset_x, int offset_y, const Uint8 mod[4], SDL_BlendMode blendMode)
+{
+    const SDL_PixelFormat *dstfmt = dst->format;
+    const int dstbpp = dstfmt->BytesPerPixel;
+    const SDL_Rect *clip = &dst->clip_rect;
+    const SDL_Vertex *v[3];
+    float x[3], y[3];
+    float attr[3][NUM_ATTRS];
+    float dadx[NUM_ATTRS], dady[NUM_ATTRS];
+    float area, miny, maxy;
+    int row, lastrow, i, k;
+
+    v[0] = p0;
+    v[1] = p1;
+    v[2] = p2;
+    area = (p1->x - p0->x) * (p2->y - p0->y) - (p1->y - p0->y) * (p2->x - p0->x);
+    if (area == 0.0f) {
+        return;
+    }
+    if (area < 0.0f) {
+        /* Use a consistent winding so the inside is always E >= 0 */
+        v[1] = p2;
+        v[2] = p1;
+        area = -area;
+    }
+
+    for (i = 0; i < 3; ++i) {
+        x[i] = v[i]->x + offset_x;
+        y[i] = v[i]->y + offset_y;
+        attr[i][0] = (float) DRAW_MUL(v[i]->color.r, mod[0]);
+        attr[i][1] = (float) DRAW_MUL(v[i]->color.g, mod[1]);
+        attr[i][2] = (float) DRAW_MUL(v[i]->color.b, mod[2]);
+        attr[i][3] = (float) DRAW_MUL(v[i]->color.a, mod[3]);
+        attr[i][4] = src ? v[i]->u * src->w : 0.0f;
+        attr[i][5] = src ? v[i]->v * src->h : 0.0f;
+    }
+
+    /* Plane equations for the attributes, relative to the first vertex */
+    for (k = 0; k < NUM_ATTRS; ++k) {
+        const float d1 = attr[1][k] - attr[0][k];
+        const float d2 = attr[2][k] - attr[0][k];
+        dadx[k] = (d1 * (y[2] - y[0]) - d2 * (y[1] - y[0])) / area;
+        dady[k] = (d2 * (x[1] - x[0]) - d1 * (x[2] - x[0])) / area;
+    }
+
+    miny = SDL_min(y[0], SDL_min(y[1], y[2]));
+    maxy = SDL_max(y[0], SDL_max(y[1], y[2]));
+    row = SDL_max(clip->y, (int) SDL_floor(miny));
+    lastrow = SDL_min(clip->y + clip->h - 1, (int) SDL_ceil(maxy));
+
+    for (; row <= lastrow; ++row) {
+        const float cy = row + 0.5f;
+        int xl = clip->x;
+        int xr = clip->x + clip->w - 1;
+        float a[NUM_ATTRS];
+        Uint8 *pixel;
+        int col;
+
+        /* Intersect the row with the inside half-plane of each edge */
+        for (i = 0; i < 3 && xl <= xr; ++i) {
+            const int j = (i + 1) % 3;
+            const float ex = x[j] - x[i];
+            const float ey = y[j] - y[i];
+            const SDL_bool topleft = IsTopLeftEdge(ex, ey);
+            /* E(px) = ex * (cy - y[i]) - ey * (px - x[i]) = slope * px + base */
+            const float slope = -ey;
+            const float base = ex * (cy - y[i]) + ey * x[i];
+
+            if (slope == 0.0f) {
+                if (base < 0.0f || (base == 0.0f && !topleft)) {
+                    xl = xr + 1;
+                }
+            } else {
+                const float bound = (-base / slope) - 0.5f;
+                if (slope > 0.0f) {
+                    const int lo = topleft ? (int) SDL_ceil(bound) : (int) SDL_floor(bound) + 1;
+                    xl = SDL_max(xl, lo);
+                } else {
+                    const int hi = topleft ? (int) SDL_floor(bound) : (int) SDL_ceil(bound) - 1;
+                    xr = SDL_min(xr, hi);
+                }
+            }
+        }
+        if (xl > xr) {
+            continue;
+        }
+
+        for (k = 0; k < NUM_ATTRS; ++k) {
+            a[k] = attr[0][k] + dadx[k] * (xl + 0.5f - x[0]) + dady[k] * (cy - y[0]);
+        }
+
+        pixel = (Uint8 *) dst->pixels + row * dst->pitch + xl * dstbpp;
+        for (col = xl; col <= xr; ++col, pixel += dstbpp) {
+            unsigned sr, sg, sb, sa, dr, dg, db, da;
+            Uint32 dstpixel;
+
+            sr = (unsigned) SDL_max(0.0f, SDL_min(a[0] + 0.5f, 255.0f));
+            sg = (unsigned) SDL_max(0.0f, SDL_min(a[1] + 0.5f, 255.0f));
+            sb = (unsigned) SDL_max(0.0f, SDL_min(a[2] + 0.5f, 255.0f));
+            sa = (unsigned) SDL_max(0.0f, SDL_min(a[3] + 0.5f, 255.0f));
+
+            if (src) {
+                int tu = (a[4] > 0.0f) ? (int) a[4] : 0;
+                int tv = (a[5] > 0.0f) ? (int) a[5] : 0;
+                const Uint8 *texel;
+                unsigned tr, tg, tb, ta;
+                Uint32 srcpixel;
+
+                if (tu >= src->w) {
+                    tu = src->w - 1;
+                }
+                if (tv >= src->h) {
+                    tv = src->h - 1;
+                }
+                texel = (const Uint8 *) src->pixels + tv * src->pitch + tu * src->format->BytesPerPixel;
+                DISEMBLE_RGBA(texel, src->format->BytesPerPixel, src->format, srcpixel, tr, tg, tb, ta);
+                sr = DRAW_MUL(sr, tr);
+                sg = DRAW_MUL(sg, tg);
+                sb = DRAW_MUL(sb, tb);
+                sa = DRAW_MUL(sa, ta);
+            }
+
+            switch (blendMode) {
+            case SDL_BLENDMODE_BLEND:
+                DISEMBLE_RGBA(pixel, dstbpp, dstfmt, dstpixel, dr, dg, db, da);
+                dr = DRAW_MUL(sr, sa) + DRAW_MUL(dr, 255 - sa);
+                dg = DRAW_MUL(sg, sa) + DRAW_MUL(dg, 255 - sa);
+                db = DRAW_MUL(sb, sa) + DRAW_MUL(db, 255 - sa);
+                da = sa + DRAW_MUL(da, 255 - sa);
+                break;
+            case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+                DISEMBLE_RGBA(pixel, dstbpp, dstfmt, dstpixel, dr, dg, db, da);
+                dr = SDL_min(sr + DRAW_MUL(dr, 255 - sa), 255);
+                dg = SDL_min(sg + DRAW_MUL(dg, 255 - sa), 255);
+                db = SDL_min(sb + DRAW_MUL(db, 255 - sa), 255);
+                da = sa + DRAW_MUL(da, 255 - sa);
+                break;
+            case SDL_BLENDMODE_ADD:
+                DISEMBLE_RGBA(pixel, dstbpp, dstfmt, dstpixel, dr, dg, db, da);
+                dr = SDL_min(dr + DRAW_MUL(sr, sa), 255);
+                dg = SDL_min(dg + DRAW_MUL(sg, sa), 255);
+                db = SDL_min(db + DRAW_MUL(sb, sa), 255);
+                break;
+            case SDL_BLENDMODE_MOD:
+                DISEMBLE_RGBA(pixel, dstbpp, dstfmt, dstpixel, dr, dg, db, da);
+                dr = DRAW_MUL(sr, dr);
+                dg = DRAW_MUL(sg, dg);
+                db = DRAW_MUL(sb, db);
+                break;
+            default:
+                dr = sr;
+                dg = sg;
+                db = sb;
+                da = sa;
+                break;
+            }
+            ASSEMBLE_RGBA(pixel, dstbpp, dstfmt, dr, dg, db, da);
+
+            for (k = 0; k < NUM_ATTRS; ++k) {
+                a[k] += dadx[k];
+            }
+        }
+    }
+}
+
+static SDL_bool
+IsIntegral(float value)
+{
+    return (SDL_fabs(value - SDL_floor(value + 0.5f)) < 0.001f) ? SDL_TRUE : SDL_FALSE;
+}
+
+/* Most meshes are quads made of two triangles (glyphs, sprites, particles).
+   If a pair of triangles covers an axis aligned rectangle with a solid color
+   and an unrotated, unflipped texture mapping, it can be handled by the
+   regular fill and blit code instead of the rasterizer. */
+static SDL_bool
+GetAxisAlignedQuad(const SDL_Vertex * v[6], SDL_Surface * src,
+                   SDL_FRect * rect, SDL_Rect * srcrect)
+{
+    float minx, maxx, miny, maxy;
+    float u[2] = { 0.0f, 0.0f }, tv[2] = { 0.0f, 0.0f };
+    int seen_u = 0, seen_v = 0;
+    int mask[2] = { 0, 0 };
+    int missing;
+    int i;
+
+    minx = maxx = v[0]->x;
+    miny = maxy = v[0]->y;
+    for (i = 1; i < 6; ++i) {
+        minx = SDL_min(minx, v[i]->x);
+        maxx = SDL_max(maxx, v[i]->x);
+        miny = SDL_min(miny, v[i]->y);
+        maxy = SDL_max(maxy, v[i]->y);
+    }
+    if (minx == maxx || miny == maxy) {
+        return SDL_FALSE;
+    }
+
+    for (i = 0; i < 6; ++i) {
+        const int right = (v[i]->x == maxx);
+        const int bottom = (v[i]->y == maxy);
+
+        if ((!right && v[i]->x != minx) || (!bottom && v[i]->y != miny)) {
+            return SDL_FALSE;
+        }
+        if (SDL_memcmp(&v[i]->color, &v[0]->color, sizeof (SDL_Color)) != 0) {
+            return SDL_FALSE;
+        }
+        mask[i / 3] |= 1 << (right | (bottom << 1));
+
+        if (src) {
+            /* u may only depend on x and v only on y */
+            if (seen_u & (1 << right)) {
+                if (u[right] != v[i]->u) {
+                    return SDL_FALSE;
+                }
+            } else {
+                u[right] = v[i]->u;
+                seen_u |= (1 << right);
+            }
+            if (seen_v & (1 << bottom)) {
+                if (tv[bottom] != v[i]->v) {
+                    return SDL_FALSE;
+                }
+            } else {
+                tv[bottom] = v[i]->v;
+                seen_v |= (1 << bottom);
+            }
+        }
+    }
+
+    /* Each triangle must use three corners, and the corners they leave out
+       must be opposite each other so they split the rectangle diagonally. */
+    missing = (~mask[0] & 0xF) | ((~mask[1] & 0xF) << 4);
+    if (missing != 0x81 && missing != 0x18 && missing != 0x42 && missing != 0x24) {
+        return SDL_FALSE;
+    }
+
+    rect->x = minx;
+    rect->y = miny;
+    rect->w = maxx - minx;
+    rect->h = maxy - miny;
+
+    if (src) {
+        const float sx = u[0] * src->w;
+        const float sy = tv[0] * src->h;
+        const float sw = (u[1] - u[0]) * src->w;
+        const float sh = (tv[1] - tv[0]) * src->h;
+
+        if (sw <= 0.0f || sh <= 0.0f ||
+            !IsIntegral(sx) || !IsIntegral(sy) || !IsIntegral(sw) || !IsIntegral(sh)) {
+            return SDL_FALSE;
+        }
+        srcrect->x = (int) SDL_floor(sx + 0.5f);
+        srcrect->y = (int) SDL_floor(sy + 0.5f);
+        srcrect->w = (int) SDL_floor(sw + 0.5f);
+        srcrect->h = (int) SDL_floor(sh + 0.5f);
+    }
+    return SDL_TRUE;
+}
+
+static int
+DrawQuad(SDL_Surface * dst, SDL_Surface * src, const SDL_FRect * rect,
+         SDL_Rect * srcrect, const SDL_Color * color, int offset_x, int offset_y,
+         const Uint8 mod[4], SDL_BlendMode blendMode, SDL_ScaleQuality quality)
+{
+    const Uint8 r = DRAW_MUL(color->r, mod[0]);
+    const Uint8 g = DRAW_MUL(color->g, mod[1]);
+    const Uint8 b = DRAW_MUL(color->b, mod[2]);
+    const Uint8 a = DRAW_MUL(color->a, mod[3]);
+    SDL_Rect dstrect;
+    int retval;
+
+    /* Same pixel coverage as the rasterizer */
+    dstrect.x = (int) SDL_ceil(rect->x + offset_x - 0.5f);
+    dstrect.y = (int) SDL_ceil(rect->y + offset_y - 0.5f);
+    dstrect.w = (int) SDL_ceil(rect->x + rect->w + offset_x - 0.5f) - dstrect.x;
+    dstrect.h = (int) SDL_ceil(rect->y + rect->h + offset_y - 0.5f) - dstrect.y;
+    if (dstrect.w <= 0 || dstrect.h <= 0) {
+        return 0;
+    }
+
+    if (!src) {
+        if (blendMode == SDL_BLENDMODE_NONE) {
+            return SDL_FillRect(dst, &dstrect, SDL_MapRGBA(dst->format, r, g, b, a));
+        }
+        return SDL_BlendFillRect(dst, &dstrect, blendMode, r, g, b, a);
+    } else {
+        Uint8 old_r, old_g, old_b, old_a;
+        SDL_BlendMode old_blendMode;
+
+        SDL_GetSurfaceColorMod(src, &old_r, &old_g, &old_b);
+        SDL_GetSurfaceAlphaMod(src, &old_a);
+        SDL_GetSurfaceBlendMode(src, &old_blendMode);
+
+        SDL_SetSurfaceColorMod(src, r, g, b);
+        SDL_SetSurfaceAlphaMod(src, a);
+        SDL_SetSurfaceBlendMode(src, blendMode);
+
+        if (srcrect->w == dstrect.w && srcrect->h == dstrect.h) {
+            retval = SDL_BlitSurface(src, srcrect, dst, &dstrect);
+        } else {
+            retval = SDL_PrivateUpperBlitScaled(src, srcrect, dst, &dstrect, quality);
+        }
+
+        SDL_SetSurfaceColorMod(src, old_r, old_g, old_b);
+        SDL_SetSurfaceAlphaMod(src, old_a);
+        SDL_SetSurfaceBlendMode(src, old_blendMode);
+        return retval;
+    }
+}
+
+int
+SDL_SW_RenderGeometry(SDL_Surface * dst, SDL_Surface * src,
+                      const SDL_Vertex * vertices, const int *indices, int count,
+                      int offset_x, int offset_y,
+                      Uint8 mod_r, Uint8 mod_g, Uint8 mod_b, Uint8 mod_a,
+                      SDL_BlendMode blendMode, SDL_ScaleQuality quality)
+{
+    const Uint8 mod[4] = { mod_r, mod_g, mod_b, mod_a };
+    SDL_bool locked = SDL_FALSE;
+    int retval = 0;
+    int i, k;
+
+    if (!dst) {
+        return SDL_SetError("Passed NULL destination surface");
+    }
+    if (dst->format->BytesPerPixel < 2) {
+        return SDL_SetError("SDL_SW_RenderGeometry(): Unsupported surface format");
+    }
+
+    for (i = 0; i + 3 <= count; ) {
+        const SDL_Vertex *v[6];
+        SDL_FRect rect;
+        SDL_Rect srcrect;
+
+        if (i + 6 <= count) {
+            for (k = 0; k < 6; ++k) {
+                v[k] = &vertices[indices ? indices[i + k] : (i + k)];
+            }
+            if (GetAxisAlignedQuad(v, src, &rect, &srcrect)) {
+                if (locked) {
+                    SDL_UnlockSurface(dst);
+                    if (src) {
+                        SDL_UnlockSurface(src);
+                    }
+                    locked = SDL_FALSE;
+                }
+                if (DrawQuad(dst, src, &rect, &srcrect, &v[0]->color,
+                             offset_x, offset_y, mod, blendMode, quality) < 0) {
+                    retval = -1;
+                }
+                i += 6;
+                continue;
+            }
+        }
+
+        for (k = 0; k < 3; ++k) {
+            v[k] = &vertices[indices ? indices[i + k] : (i + k)];
+        }
+        if (!locked) {
+            if (SDL_LockSurface(dst) < 0) {
+                return -1;
+            }
+            if (src && SDL_LockSurface(src) < 0) {
+                SDL_UnlockSurface(dst);
+                return -1;
+            }
+            locked = SDL_TRUE;
+        }
+        RasterizeTriangle(dst, src, v[0], v[1], v[2], offset_x, offset_y, mod, blendMode);
+        i += 3;
+    }
+
+    if (locked) {
+        SDL_UnlockSurface(dst);
+        if (src) {
+            SDL_UnlockSurface(src);
+        }
+    }
+    return retval;
+}
+
+#endif /* !SDL_RENDER_DISABLED */
+
+/* vi: set ts=4 sw=4 expandtab: */
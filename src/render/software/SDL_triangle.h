@@ -0,0 +1,32 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+#include "SDL_render.h"
+#include "../../video/SDL_blit.h"
+
+extern int SDL_SW_RenderGeometry(SDL_Surface * dst, SDL_Surface * src,
+                                 const SDL_Vertex * vertices, const int *indices, int count,
+                                 int offset_x, int offset_y,
+                                 Uint8 mod_r, Uint8 mod_g, Uint8 mod_b, Uint8 mod_a,
+                                 SDL_BlendMode blendMode, SDL_ScaleQuality quality);
+
+/* vi: set ts=4 sw=4 expandtab: */
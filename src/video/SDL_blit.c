@@ -21,6 +21,10 @@
 #include "../SDL_internal.h"
 
 #include "SDL_video.h"
+#include "SDL_atomic.h"
+#include "SDL_hints.h"
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
 #include "SDL_blit_auto.h"
@@ -29,6 +33,215 @@
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
 
+/* Threaded blitting, see SDL_HINT_BLIT_THREADS */
+#define SDL_BLIT_MAX_THREADS        64
+#define SDL_BLIT_BANDS_PER_THREAD   4
+#define SDL_BLIT_BAND_MIN_PIXELS    (64 * 1024)
+
+typedef struct
+{
+    SDL_BlitFunc func;
+    const SDL_BlitInfo *info;
+    int band_height;
+    int num_bands;
+    SDL_atomic_t next_band;
+} SDL_BlitJob;
+
+static SDL_SpinLock blit_threads_lock;
+static SDL_mutex *blit_threads_mutex;
+static SDL_Thread *blit_threads[SDL_BLIT_MAX_THREADS];
+static int blit_num_threads = 1;
+static SDL_sem *blit_start_sem;
+static SDL_sem *blit_done_sem;
+static SDL_bool blit_threads_quit;
+static SDL_BlitJob blit_job;
+
+static void
+SDL_RunBlitBands(SDL_BlitJob * job)
+{
+    int band;
+
+    while ((band = SDL_AtomicAdd(&job->next_band, 1)) < job->num_bands) {
+        SDL_BlitInfo info = *job->info;
+        int y = band * job->band_height;
+
+        if (info.src) {
+            info.src += y * info.src_pitch;
+        }
+        info.dst += y * info.dst_pitch;
+        info.src_h = info.dst_h = SDL_min(job->band_height, job->info->dst_h - y);
+        job->func(&info);
+    }
+}
+
+static int SDLCALL
+SDL_BlitThread(void *unused)
+{
+    for (;;) {
+        SDL_SemWait(blit_start_sem);
+        if (blit_threads_quit) {
+            break;
+        }
+        SDL_RunBlitBands(&blit_job);
+        SDL_SemPost(blit_done_sem);
+    }
+    return 0;
+}
+
+static void
+SDL_StopBlitThreads(void)
+{
+    int i;
+
+    blit_threads_quit = SDL_TRUE;
+    for (i = 1; i < blit_num_threads; ++i) {
+        SDL_SemPost(blit_start_sem);
+    }
+    for (i = 1; i < blit_num_threads; ++i) {
+        SDL_WaitThread(blit_threads[i], NULL);
+        blit_threads[i] = NULL;
+    }
+    blit_threads_quit = SDL_FALSE;
+    blit_num_threads = 1;
+
+    if (blit_start_sem) {
+        SDL_DestroySemaphore(blit_start_sem);
+        blit_start_sem = NULL;
+    }
+    if (blit_done_sem) {
+        SDL_DestroySemaphore(blit_done_sem);
+        blit_done_sem = NULL;
+    }
+}
+
+static void
+SDL_StartBlitThreads(int num_threads)
+{
+    int i;
+
+    blit_start_sem = SDL_CreateSemaphore(0);
+    blit_done_sem = SDL_CreateSemaphore(0);
+    if (!blit_start_sem || !blit_done_sem) {
+        /* Fall back to blitting on a single thread */
+        SDL_StopBlitThreads();
+        return;
+    }
+
+    /* The thread doing the blit works on the first band */
+    for (i = 1; i < num_threads; ++i) {
+        char name[32];
+
+        SDL_snprintf(name, sizeof (name), "SDLBlit%d", i);
+        blit_threads[i] = SDL_CreateThread(SDL_BlitThread, name, NULL);
+        if (!blit_threads[i]) {
+            break;
+        }
+        blit_num_threads++;
+    }
+
+    if (blit_num_threads == 1) {
+        SDL_StopBlitThreads();
+    }
+}
+
+/* Split a large blit into row bands and run them on the blit threads.
+   Fills pass a NULL source.
+   Returns SDL_FALSE if the blit should run on the calling thread. */
+SDL_bool
+SDL_RunBlitThreaded(SDL_BlitFunc RunBlit, const SDL_BlitInfo * info)
+{
+    const char *hint;
+    int num_threads;
+    int num_bands;
+    int i;
+
+    /* Bands have to start at the same source and destination row */
+    if (info->src_w != info->dst_w || info->src_h != info->dst_h) {
+        return SDL_FALSE;
+    }
+    num_bands = (int) (((Sint64) info->dst_w * info->dst_h) / SDL_BLIT_BAND_MIN_PIXELS);
+    if (num_bands < 2) {
+        return SDL_FALSE;
+    }
+
+    /* Error diffusion carries over from one row to the next */
+    if (info->dither == SDL_DITHER_DIFFUSION) {
+        return SDL_FALSE;
+    }
+
+    /* Overlapping blits within a surface depend on the row order */
+    if (info->src &&
+        info->src < info->dst + info->dst_h * info->dst_pitch &&
+        info->dst < info->src + info->src_h * info->src_pitch) {
+        return SDL_FALSE;
+    }
+
+    hint = SDL_GetHint(SDL_HINT_BLIT_THREADS);
+    num_threads = hint ? SDL_atoi(hint) : 1;
+    if (num_threads == 0) {
+        num_threads = SDL_GetCPUCount();
+    }
+    num_threads = SDL_min(num_threads, SDL_BLIT_MAX_THREADS);
+    if (num_threads <= 1 && blit_num_threads == 1) {
+        return SDL_FALSE;
+    }
+
+    SDL_AtomicLock(&blit_threads_lock);
+    if (!blit_threads_mutex) {
+        blit_threads_mutex = SDL_CreateMutex();
+    }
+    SDL_AtomicUnlock(&blit_threads_lock);
+
+    /* Another thread is using the blit threads, do this one directly */
+    if (!blit_threads_mutex || SDL_TryLockMutex(blit_threads_mutex) != 0) {
+        return SDL_FALSE;
+    }
+
+    if (num_threads != blit_num_threads) {
+        SDL_StopBlitThreads();
+        if (num_threads > 1) {
+            SDL_StartBlitThreads(num_threads);
+        }
+    }
+    if (blit_num_threads == 1) {
+        SDL_UnlockMutex(blit_threads_mutex);
+        return SDL_FALSE;
+    }
+
+    num_bands = SDL_min(num_bands, blit_num_threads * SDL_BLIT_BANDS_PER_THREAD);
+    num_bands = SDL_min(num_bands, info->dst_h);
+    blit_job.func = RunBlit;
+    blit_job.info = info;
+    /* Bands are whole multiples of 8 rows, so ordered dither patterns line up */
+    blit_job.band_height = (info->dst_h + num_bands - 1) / num_bands;
+    blit_job.band_height = (blit_job.band_height + 7) & ~7;
+    blit_job.num_bands = (info->dst_h + blit_job.band_height - 1) / blit_job.band_height;
+    SDL_AtomicSet(&blit_job.next_band, 0);
+
+    for (i = 1; i < blit_num_threads; ++i) {
+        SDL_SemPost(blit_start_sem);
+    }
+    SDL_RunBlitBands(&blit_job);
+    for (i = 1; i < blit_num_threads; ++i) {
+        SDL_SemWait(blit_done_sem);
+    }
+
+    SDL_UnlockMutex(blit_threads_mutex);
+    return SDL_TRUE;
+}
+
+void
+SDL_BlitThreadsQuit(void)
+{
+    if (blit_threads_mutex) {
+        SDL_LockMutex(blit_threads_mutex);
+        SDL_StopBlitThreads();
+        SDL_UnlockMutex(blit_threads_mutex);
+        SDL_DestroyMutex(blit_threads_mutex);
+        blit_threads_mutex = NULL;
+    }
+}
+
 /* The general purpose software blit routine */
 static int SDLCALL
 SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
@@ -85,7 +298,9 @@ SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
         RunBlit = (SDL_BlitFunc) src->map->data;
 
         /* Run the actual software blit */
-        RunBlit(info);
+        if (!SDL_RunBlitThreaded(RunBlit, info)) {
+            RunBlit(info);
+        }
     }
 
     /* We need to unlock the surfaces if they're locked */
@@ -129,38 +344,47 @@ SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
                    SDL_BlitFuncEntry * entries)
 {
     int i, flagcheck;
-    static Uint32 features = 0xffffffff;
+    static Uint32 cpu_features = 0xffffffff;
+    const char *override = SDL_getenv("SDL_BLIT_CPU_FEATURES");
+    Uint32 features;
 
     /* Get the available CPU features */
-    if (features == 0xffffffff) {
-        const char *override = SDL_getenv("SDL_BLIT_CPU_FEATURES");
-
+    if (cpu_features == 0xffffffff) {
         features = SDL_CPU_ANY;
-
-        /* Allow an override for testing .. */
-        if (override) {
-            SDL_sscanf(override, "%u", &features);
-        } else {
-            if (SDL_HasMMX()) {
-                features |= SDL_CPU_MMX;
-            }
-            if (SDL_Has3DNow()) {
-                features |= SDL_CPU_3DNOW;
-            }
-            if (SDL_HasSSE()) {
-                features |= SDL_CPU_SSE;
-            }
-            if (SDL_HasSSE2()) {
-                features |= SDL_CPU_SSE2;
-            }
-            if (SDL_HasAltiVec()) {
-                if (SDL_UseAltivecPrefetch()) {
-                    features |= SDL_CPU_ALTIVEC_PREFETCH;
-                } else {
-                    features |= SDL_CPU_ALTIVEC_NOPREFETCH;
-                }
+        if (SDL_HasMMX()) {
+            features |= SDL_CPU_MMX;
+        }
+        if (SDL_Has3DNow()) {
+            features |= SDL_CPU_3DNOW;
+        }
+        if (SDL_HasSSE()) {
+            features |= SDL_CPU_SSE;
+        }
+        if (SDL_HasSSE2()) {
+            features |= SDL_CPU_SSE2;
+        }
+        if (SDL_HasAVX2()) {
+            features |= SDL_CPU_AVX2;
+        }
+        if (SDL_HasNEON()) {
+            features |= SDL_CPU_NEON;
+        }
+        if (SDL_HasAltiVec()) {
+            if (SDL_UseAltivecPrefetch()) {
+                features |= SDL_CPU_ALTIVEC_PREFETCH;
+            } else {
+                features |= SDL_CPU_ALTIVEC_NOPREFETCH;
             }
         }
+        cpu_features = features;
+    }
+
+    /* Allow an override for testing, in decimal or hex. This is checked
+       every time, so tests can compare blitters for different features. */
+    if (override && *override) {
+        features = (Uint32) SDL_strtoul(override, NULL, 0);
+    } else {
+        features = cpu_features;
     }
 
     for (i = 0; entries[i].func; ++i) {
@@ -182,7 +406,7 @@ SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
         /* Check blend flags */
         flagcheck =
             (flags &
-             (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD));
+             (SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_MOD));
         if ((flagcheck & entries[i].flags) != flagcheck) {
             continue;
         }
@@ -255,7 +479,7 @@ SDL_CalculateBlit(SDL_Surface * surface)
     } else if (surface->format->BytesPerPixel == 1 &&
                SDL_ISPIXELFORMAT_INDEXED(surface->format->format)) {
         blit = SDL_CalculateBlit1(surface);
-    } else if (map->info.flags & SDL_COPY_BLEND) {
+    } else if (map->info.flags & (SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED)) {
         blit = SDL_CalculateBlitA(surface);
     } else {
         blit = SDL_CalculateBlitN(surface);
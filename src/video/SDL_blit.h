@@ -36,6 +36,7 @@ extern Uint8* SDL_expand_byte[9];
 #define SDL_COPY_BLEND              0x00000010
 #define SDL_COPY_ADD                0x00000020
 #define SDL_COPY_MOD                0x00000040
+#define SDL_COPY_BLEND_PREMULTIPLIED 0x00000080
 #define SDL_COPY_COLORKEY           0x00000100
 #define SDL_COPY_NEAREST            0x00000200
 #define SDL_COPY_RLE_DESIRED        0x00001000
@@ -51,6 +52,17 @@ extern Uint8* SDL_expand_byte[9];
 #define SDL_CPU_SSE2                0x00000008
 #define SDL_CPU_ALTIVEC_PREFETCH    0x00000010
 #define SDL_CPU_ALTIVEC_NOPREFETCH  0x00000020
+#define SDL_CPU_AVX2                0x00000040
+#define SDL_CPU_NEON                0x00000080
+
+/* Conversions to 8-bit palettes, in the order of SDL_HINT_SURFACE_PALETTE_DITHER */
+typedef enum
+{
+    SDL_DITHER_NONE,        /* 3-3-2 bits indexing table */
+    SDL_DITHER_NEAREST,     /* 5-5-5 bits indexing table */
+    SDL_DITHER_ORDERED,
+    SDL_DITHER_DIFFUSION
+} SDL_DitherMode;
 
 typedef struct
 {
@@ -68,6 +80,7 @@ typedef struct
     int flags;
     Uint32 colorkey;
     Uint8 r, g, b, a;
+    SDL_DitherMode dither;
 } SDL_BlitInfo;
 
 typedef void (*SDL_BlitFunc) (SDL_BlitInfo *info);
@@ -82,6 +95,26 @@ typedef struct
     SDL_BlitFunc func;
 } SDL_BlitFuncEntry;
 
+/* Number of mappings to other destination formats kept per source surface */
+#define SDL_BLITMAP_CACHE_SIZE  4
+
+/* A previously calculated mapping, parked while blitting elsewhere */
+typedef struct
+{
+    SDL_PixelFormat *dst_fmt;   /* holds a reference, NULL if unused */
+    SDL_Palette *dst_palette;   /* holds a reference if not NULL */
+    Uint32 dst_palette_version;
+    Uint32 src_palette_version;
+    int flags;
+    SDL_DitherMode dither;
+    int identity;
+    SDL_blit blit;
+    void *data;
+    Uint8 *table;
+    Uint8 r, g, b, a;           /* baked into palette to bitfield tables */
+    Uint32 last_used;
+} SDL_BlitMapCacheEntry;
+
 /* Blit mapping definition */
 typedef struct SDL_BlitMap
 {
@@ -95,10 +128,55 @@ typedef struct SDL_BlitMap
        an invalid mapping */
     Uint32 dst_palette_version;
     Uint32 src_palette_version;
+
+    /* mappings for other destinations, keyed by destination format,
+       palette versions and blit flags */
+    SDL_BlitMapCacheEntry cache[SDL_BLITMAP_CACHE_SIZE];
+    Uint32 cache_clock;
+
+    /* the shared memory of the surface, if its pixels are shared */
+    struct SDL_SharedPixels *shared;
+
+    /* the pixels of the surface are a huge page mapping */
+    SDL_bool mapped_pixels;
+
+    /* kept between filtered stretches from the surface */
+    void *stretch_buffer;
+    size_t stretch_buffer_len;
+    SDL_Surface *stretch_band;
 } SDL_BlitMap;
 
+/* Stretch filters, in the order of SDL_HINT_RENDER_SCALE_QUALITY */
+typedef enum
+{
+    SDL_SCALEQUALITY_NEAREST,
+    SDL_SCALEQUALITY_LINEAR,
+    SDL_SCALEQUALITY_BEST
+} SDL_ScaleQuality;
+
 /* Functions found in SDL_blit.c */
 extern int SDL_CalculateBlit(SDL_Surface * surface);
+extern SDL_bool SDL_RunBlitThreaded(SDL_BlitFunc RunBlit, const SDL_BlitInfo * info);
+extern void SDL_BlitThreadsQuit(void);
+
+/* Functions found in SDL_stretch.c */
+extern SDL_bool SDL_CanStretchFiltered(SDL_Surface * src);
+extern int SDL_SoftStretchFiltered(SDL_Surface * src, const SDL_Rect * srcrect,
+                                   SDL_Surface * dst, const SDL_Rect * dstrect,
+                                   SDL_ScaleQuality quality);
+
+/* Functions found in SDL_surface.c */
+extern SDL_ScaleQuality SDL_GetScaleQuality(void);
+extern int SDL_PrivateUpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
+                                      SDL_Surface * dst, SDL_Rect * dstrect,
+                                      SDL_ScaleQuality quality);
+extern int SDL_PrivateUpperBlitScaledRows(SDL_Surface * src, const SDL_Rect * srcrect,
+                                          SDL_Surface * dst, SDL_Rect * dstrect,
+                                          SDL_ScaleQuality quality,
+                                          const SDL_Rect * clip_rect);
+extern int SDL_PrivateLowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
+                                      SDL_Surface * dst, SDL_Rect * dstrect,
+                                      SDL_ScaleQuality quality);
 
 /* Functions found in SDL_blit_*.c */
 extern SDL_BlitFunc SDL_CalculateBlit0(SDL_Surface * surface);
@@ -460,6 +538,16 @@ do {                                                                    \
 } while(0)
 
 
+/* Blend the RGBA values of two pixels, the source having premultiplied alpha */
+#define ALPHA_BLEND_PREMULTIPLIED_RGBA(sR, sG, sB, sA, dR, dG, dB, dA)    \
+do {                                                                    \
+    dR = (Uint8)SDL_min((int)sR+dR-((int)sA*dR)/255, 255);              \
+    dG = (Uint8)SDL_min((int)sG+dG-((int)sA*dG)/255, 255);              \
+    dB = (Uint8)SDL_min((int)sB+dB-((int)sA*dB)/255, 255);              \
+    dA = (Uint8)((int)sA+dA-((int)sA*dA)/255);                          \
+} while(0)
+
+
 /* This is a very useful loop for optimizing blitters */
 #if defined(_MSC_VER) && (_MSC_VER == 1300)
 /* There's a bug in the Visual C++ 7 optimizer when compiling this code */
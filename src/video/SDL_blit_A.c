@@ -1264,6 +1264,46 @@ BlitNtoNPixelAlpha(SDL_BlitInfo * info)
     }
 }
 
+/* General (slow) N->N blending with premultiplied pixel alpha */
+static void
+BlitNtoNPixelAlphaPremultiplied(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    SDL_PixelFormat *srcfmt = info->src_fmt;
+    SDL_PixelFormat *dstfmt = info->dst_fmt;
+    int srcbpp;
+    int dstbpp;
+    Uint32 Pixel;
+    unsigned sR, sG, sB, sA;
+    unsigned dR, dG, dB, dA;
+
+    /* Set up some basic variables */
+    srcbpp = srcfmt->BytesPerPixel;
+    dstbpp = dstfmt->BytesPerPixel;
+
+    while (height--) {
+	    /* *INDENT-OFF* */
+	    DUFFS_LOOP4(
+	    {
+		DISEMBLE_RGBA(src, srcbpp, srcfmt, Pixel, sR, sG, sB, sA);
+		DISEMBLE_RGBA(dst, dstbpp, dstfmt, Pixel, dR, dG, dB, dA);
+		ALPHA_BLEND_PREMULTIPLIED_RGBA(sR, sG, sB, sA, dR, dG, dB, dA);
+		ASSEMBLE_RGBA(dst, dstbpp, dstfmt, dR, dG, dB, dA);
+		src += srcbpp;
+		dst += dstbpp;
+	    },
+	    width);
+	    /* *INDENT-ON* */
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
 
 SDL_BlitFunc
 SDL_CalculateBlitA(SDL_Surface * surface)
@@ -1321,6 +1361,14 @@ SDL_CalculateBlitA(SDL_Surface * surface)
         }
         return BlitNtoNPixelAlpha;
 
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        /* 32-bit formats have vectorized blitters in the generated table */
+        if (df->BytesPerPixel == 1 ||
+            (sf->BytesPerPixel == 4 && df->BytesPerPixel == 4)) {
+            return NULL;
+        }
+        return BlitNtoNPixelAlphaPremultiplied;
+
     case SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
         if (sf->Amask == 0) {
             /* Per-surface alpha blits */
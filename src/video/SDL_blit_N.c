@@ -24,6 +24,7 @@
 #include "SDL_endian.h"
 #include "SDL_cpuinfo.h"
 #include "SDL_blit.h"
+#include "../SDL_simd.h"
 
 #include "SDL_assert.h"
 
@@ -874,8 +875,12 @@ GetBlitFeatures(void)
 #pragma altivec_model off
 #endif
 #else
-/* Feature 1 is has-MMX */
-#define GetBlitFeatures() ((Uint32)(SDL_HasMMX() ? 1 : 0))
+/* Feature 1 is has-MMX, 8 is has-SSSE3, 16 is has-AVX2, 32 is has-NEON.
+   SDL doesn't report SSSE3 by itself, but every CPU with SSE4.1 has it. */
+#define GetBlitFeatures() ((Uint32)((SDL_HasMMX() ? 1 : 0) | \
+                                    (SDL_HasSSE41() ? 8 : 0) | \
+                                    (SDL_HasAVX2() ? 16 : 0) | \
+                                    (SDL_HasNEON() ? 32 : 0)))
 #endif
 
 /* This is now endian dependent */
@@ -2072,6 +2077,170 @@ BlitNto1(SDL_BlitInfo * info)
     }
 }
 
+/* Index of a color in the 5-5-5 bit table used by the dithering blitters */
+#define NEAREST_INDEX(r, g, b)  ((((r) >> 3) << 10) | (((g) >> 3) << 5) | ((b) >> 3))
+
+static void
+BlitNto1Nearest(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const Uint8 *map = info->table;
+    SDL_PixelFormat *srcfmt = info->src_fmt;
+    int srcbpp = srcfmt->BytesPerPixel;
+    Uint32 Pixel;
+    int sR, sG, sB;
+    int c;
+
+    while (height--) {
+        for (c = width; c; --c) {
+            DISEMBLE_RGB(src, srcbpp, srcfmt, Pixel, sR, sG, sB);
+            *dst++ = map[NEAREST_INDEX(sR, sG, sB)];
+            src += srcbpp;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+/* 8x8 Bayer threshold matrix */
+static const Uint8 bayer_matrix[64] = {
+     0, 32,  8, 40,  2, 34, 10, 42,
+    48, 16, 56, 24, 50, 18, 58, 26,
+    12, 44,  4, 36, 14, 46,  6, 38,
+    60, 28, 52, 20, 62, 30, 54, 22,
+     3, 35, 11, 43,  1, 33,  9, 41,
+    51, 19, 59, 27, 49, 17, 57, 25,
+    15, 47,  7, 39, 13, 45,  5, 37,
+    63, 31, 55, 23, 61, 29, 53, 21
+};
+
+static void
+BlitNto1Ordered(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const Uint8 *map = info->table;
+    SDL_PixelFormat *srcfmt = info->src_fmt;
+    int srcbpp = srcfmt->BytesPerPixel;
+    Uint32 Pixel;
+    int sR, sG, sB;
+    int offsets[64];
+    int levels, spread;
+    int x, y, i;
+
+    /* Spread the thresholds over about the distance between the colors
+       of a palette with as many entries evenly covering the RGB cube */
+    for (levels = 2; levels * levels * levels < info->dst_fmt->palette->ncolors; ++levels) {
+    }
+    spread = 255 / (levels - 1);
+    for (i = 0; i < 64; ++i) {
+        offsets[i] = ((2 * bayer_matrix[i] + 1) * spread) / 128 - spread / 2;
+    }
+
+    /* The pattern starts over with every blit, the blit threads split
+       the rows into bands that are multiples of 8 rows high */
+    for (y = 0; y < height; ++y) {
+        const int *row = &offsets[(y & 7) * 8];
+
+        for (x = 0; x < width; ++x) {
+            const int offset = row[x & 7];
+
+            DISEMBLE_RGB(src, srcbpp, srcfmt, Pixel, sR, sG, sB);
+            sR = SDL_max(0, SDL_min(255, sR + offset));
+            sG = SDL_max(0, SDL_min(255, sG + offset));
+            sB = SDL_max(0, SDL_min(255, sB + offset));
+            *dst++ = map[NEAREST_INDEX(sR, sG, sB)];
+            src += srcbpp;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+/* Floyd-Steinberg error diffusion, this can't be split into bands */
+static void
+BlitNto1Diffusion(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const Uint8 *map = info->table;
+    const SDL_Color *colors = info->dst_fmt->palette->colors;
+    SDL_PixelFormat *srcfmt = info->src_fmt;
+    int srcbpp = srcfmt->BytesPerPixel;
+    Uint32 Pixel;
+    int sR, sG, sB;
+    int *errors, *cur, *next;
+    int x;
+
+    /* Errors of the current and the next row, in 16ths, with a pixel of
+       room on either side */
+    errors = (int *) SDL_calloc(2 * 3 * (width + 2), sizeof(int));
+    if (!errors) {
+        BlitNto1Nearest(info);
+        return;
+    }
+    cur = errors + 3;
+    next = cur + 3 * (width + 2);
+
+    while (height--) {
+        for (x = 0; x < width; ++x) {
+            const int *err = &cur[3 * x];
+            const SDL_Color *color;
+            int eR, eG, eB;
+            Uint8 pixel;
+
+            DISEMBLE_RGB(src, srcbpp, srcfmt, Pixel, sR, sG, sB);
+            sR = SDL_max(0, SDL_min(255, sR + (err[0] + 8) / 16));
+            sG = SDL_max(0, SDL_min(255, sG + (err[1] + 8) / 16));
+            sB = SDL_max(0, SDL_min(255, sB + (err[2] + 8) / 16));
+            pixel = map[NEAREST_INDEX(sR, sG, sB)];
+            *dst++ = pixel;
+            src += srcbpp;
+
+            color = &colors[pixel];
+            eR = sR - color->r;
+            eG = sG - color->g;
+            eB = sB - color->b;
+            cur[3 * x + 3] += eR * 7;
+            cur[3 * x + 4] += eG * 7;
+            cur[3 * x + 5] += eB * 7;
+            next[3 * x - 3] += eR * 3;
+            next[3 * x - 2] += eG * 3;
+            next[3 * x - 1] += eB * 3;
+            next[3 * x + 0] += eR * 5;
+            next[3 * x + 1] += eG * 5;
+            next[3 * x + 2] += eB * 5;
+            next[3 * x + 3] += eR;
+            next[3 * x + 4] += eG;
+            next[3 * x + 5] += eB;
+        }
+        src += srcskip;
+        dst += dstskip;
+
+        /* The next row becomes the current one */
+        {
+            int *tmp = cur;
+            cur = next;
+            next = tmp;
+            SDL_memset(next - 3, 0, 3 * (width + 2) * sizeof(int));
+        }
+    }
+    SDL_free(errors);
+}
+
 /* blits 32 bit RGB<->RGBA with both surfaces having the same R,G,B fields */
 static void
 Blit4to4MaskAlpha(SDL_BlitInfo * info)
@@ -2462,10 +2631,201 @@ BlitNto2101010(SDL_BlitInfo * info)
     }
 }
 
+/* Whether a 32-bit format has every channel in a whole byte */
+static SDL_bool
+HasByteChannels32(const SDL_PixelFormat * fmt)
+{
+    if (fmt->BytesPerPixel != 4 ||
+        fmt->Rmask != (0xFFu << fmt->Rshift) || (fmt->Rshift % 8) != 0 ||
+        fmt->Gmask != (0xFFu << fmt->Gshift) || (fmt->Gshift % 8) != 0 ||
+        fmt->Bmask != (0xFFu << fmt->Bshift) || (fmt->Bshift % 8) != 0) {
+        return SDL_FALSE;
+    }
+    if (fmt->Amask &&
+        (fmt->Amask != (0xFFu << fmt->Ashift) || (fmt->Ashift % 8) != 0)) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+#if HAVE_SSSE3_INTRINSICS || HAVE_AVX2_INTRINSICS || HAVE_NEON_INTRINSICS
+
+/* Calculate the byte shuffle of a little endian 32->32 channel permutation.
+   Destination bytes with a shuffle index of 0x80 are cleared, and then
+   the alpha fill is or'ed in. */
+static void
+CalcShuffle32(const SDL_BlitInfo * info, Uint8 shuffle[16], Uint32 * fill)
+{
+    const SDL_PixelFormat *srcfmt = info->src_fmt;
+    const SDL_PixelFormat *dstfmt = info->dst_fmt;
+    int i;
+
+    SDL_memset(shuffle, 0x80, 4);
+    shuffle[dstfmt->Rshift / 8] = srcfmt->Rshift / 8;
+    shuffle[dstfmt->Gshift / 8] = srcfmt->Gshift / 8;
+    shuffle[dstfmt->Bshift / 8] = srcfmt->Bshift / 8;
+    *fill = 0;
+    if (dstfmt->Amask) {
+        if (srcfmt->Amask) {
+            /* RGBA->RGBA, COPY_ALPHA */
+            shuffle[dstfmt->Ashift / 8] = srcfmt->Ashift / 8;
+        } else {
+            /* RGB->RGBA, SET_ALPHA */
+            *fill = (Uint32) info->a << dstfmt->Ashift;
+        }
+    }
+
+    /* Repeat the pattern for the next three pixels */
+    for (i = 4; i < 16; ++i) {
+        shuffle[i] = (shuffle[i - 4] & 0x80) ? 0x80 : (shuffle[i - 4] + 4);
+    }
+}
+
+SDL_FORCE_INLINE Uint32
+Shuffle32(Uint32 pixel, const Uint8 shuffle[16], Uint32 fill)
+{
+    Uint32 result = fill;
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        if (!(shuffle[i] & 0x80)) {
+            result |= ((pixel >> (shuffle[i] * 8)) & 0xFF) << (i * 8);
+        }
+    }
+    return result;
+}
+
+#endif /* HAVE_SSSE3_INTRINSICS || HAVE_AVX2_INTRINSICS || HAVE_NEON_INTRINSICS */
+
+#if HAVE_SSSE3_INTRINSICS
+/* blits 32 bit formats with byte channels to each other, 4 pixels at a time */
+static void SDL_TARGETING_SSSE3
+Blit4to4ShuffleSSSE3(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *src = (Uint32 *) info->src;
+    int srcskip = info->src_skip;
+    Uint32 *dst = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip;
+    Uint8 shuffle[16];
+    Uint32 fill;
+    __m128i vshuffle, vfill;
+
+    CalcShuffle32(info, shuffle, &fill);
+    vshuffle = _mm_loadu_si128((const __m128i *) shuffle);
+    vfill = _mm_set1_epi32((int) fill);
+
+    while (height--) {
+        int n = width;
+
+        while (n >= 4) {
+            __m128i pixels = _mm_loadu_si128((const __m128i *) src);
+            pixels = _mm_or_si128(_mm_shuffle_epi8(pixels, vshuffle), vfill);
+            _mm_storeu_si128((__m128i *) dst, pixels);
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        while (n--) {
+            *dst++ = Shuffle32(*src++, shuffle, fill);
+        }
+        src = (Uint32 *) ((Uint8 *) src + srcskip);
+        dst = (Uint32 *) ((Uint8 *) dst + dstskip);
+    }
+}
+#endif /* HAVE_SSSE3_INTRINSICS */
+
+#if HAVE_AVX2_INTRINSICS
+/* blits 32 bit formats with byte channels to each other, 8 pixels at a time */
+static void SDL_TARGETING_AVX2
+Blit4to4ShuffleAVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *src = (Uint32 *) info->src;
+    int srcskip = info->src_skip;
+    Uint32 *dst = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip;
+    Uint8 shuffle[16];
+    Uint32 fill;
+    __m256i vshuffle, vfill;
+
+    CalcShuffle32(info, shuffle, &fill);
+    vshuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) shuffle));
+    vfill = _mm256_set1_epi32((int) fill);
+
+    while (height--) {
+        int n = width;
+
+        while (n >= 8) {
+            __m256i pixels = _mm256_loadu_si256((const __m256i *) src);
+            pixels = _mm256_or_si256(_mm256_shuffle_epi8(pixels, vshuffle), vfill);
+            _mm256_storeu_si256((__m256i *) dst, pixels);
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        while (n--) {
+            *dst++ = Shuffle32(*src++, shuffle, fill);
+        }
+        src = (Uint32 *) ((Uint8 *) src + srcskip);
+        dst = (Uint32 *) ((Uint8 *) dst + dstskip);
+    }
+}
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+/* blits 32 bit formats with byte channels to each other, 4 pixels at a time */
+static void
+Blit4to4ShuffleNEON(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *src = (Uint32 *) info->src;
+    int srcskip = info->src_skip;
+    Uint32 *dst = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip;
+    Uint8 shuffle[16];
+    Uint32 fill;
+    uint8x8_t vshuffle_lo, vshuffle_hi;
+    uint8x16_t vfill;
+
+    /* Table indices past the end read as zero, like the 0x80 ones do for pshufb */
+    CalcShuffle32(info, shuffle, &fill);
+    vshuffle_lo = vld1_u8(shuffle);
+    vshuffle_hi = vld1_u8(shuffle + 8);
+    vfill = vreinterpretq_u8_u32(vdupq_n_u32(fill));
+
+    while (height--) {
+        int n = width;
+
+        while (n >= 4) {
+            uint8x16_t pixels = vld1q_u8((const Uint8 *) src);
+            uint8x8x2_t table;
+
+            table.val[0] = vget_low_u8(pixels);
+            table.val[1] = vget_high_u8(pixels);
+            pixels = vcombine_u8(vtbl2_u8(table, vshuffle_lo), vtbl2_u8(table, vshuffle_hi));
+            vst1q_u8((Uint8 *) dst, vorrq_u8(pixels, vfill));
+            src += 4;
+            dst += 4;
+            n -= 4;
+        }
+        while (n--) {
+            *dst++ = Shuffle32(*src++, shuffle, fill);
+        }
+        src = (Uint32 *) ((Uint8 *) src + srcskip);
+        dst = (Uint32 *) ((Uint8 *) dst + dstskip);
+    }
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
 /* Normal N to N optimized blitters */
 #define NO_ALPHA   1
 #define SET_ALPHA  2
 #define COPY_ALPHA 4
+#define BYTE_CHANNELS 8  /* only for 32 bit formats with whole byte channels */
 struct blit_table
 {
     Uint32 srcR, srcG, srcB;
@@ -2473,7 +2833,7 @@ struct blit_table
     Uint32 dstR, dstG, dstB;
     Uint32 blit_features;
     SDL_BlitFunc blitfunc;
-    Uint32 alpha;  /* bitwise NO_ALPHA, SET_ALPHA, COPY_ALPHA */
+    Uint32 alpha;  /* bitwise NO_ALPHA, SET_ALPHA, COPY_ALPHA, BYTE_CHANNELS */
 };
 static const struct blit_table normal_blit_1[] = {
     /* Default for 8-bit RGB source, never optimized */
@@ -2507,6 +2867,21 @@ static const struct blit_table normal_blit_3[] = {
 };
 
 static const struct blit_table normal_blit_4[] = {
+#if HAVE_AVX2_INTRINSICS
+    /* has-AVX2 */
+    {0x00000000, 0x00000000, 0x00000000, 4, 0x00000000, 0x00000000, 0x00000000,
+     16, Blit4to4ShuffleAVX2, NO_ALPHA | COPY_ALPHA | SET_ALPHA | BYTE_CHANNELS},
+#endif
+#if HAVE_SSSE3_INTRINSICS
+    /* has-SSSE3 */
+    {0x00000000, 0x00000000, 0x00000000, 4, 0x00000000, 0x00000000, 0x00000000,
+     8, Blit4to4ShuffleSSSE3, NO_ALPHA | COPY_ALPHA | SET_ALPHA | BYTE_CHANNELS},
+#endif
+#if HAVE_NEON_INTRINSICS
+    /* has-NEON */
+    {0x00000000, 0x00000000, 0x00000000, 4, 0x00000000, 0x00000000, 0x00000000,
+     32, Blit4to4ShuffleNEON, NO_ALPHA | COPY_ALPHA | SET_ALPHA | BYTE_CHANNELS},
+#endif
 #if SDL_ALTIVEC_BLITTERS
     /* has-altivec | dont-use-prefetch */
     {0x00000000, 0x00000000, 0x00000000, 4, 0x00000000, 0x00000000, 0x00000000,
@@ -2568,6 +2943,20 @@ SDL_CalculateBlitN(SDL_Surface * surface)
             } else {
                 blitfun = BlitNto1;
             }
+            /* The palette table is 5-5-5 bits when dithering */
+            switch (surface->map->info.dither) {
+            case SDL_DITHER_NEAREST:
+                blitfun = BlitNto1Nearest;
+                break;
+            case SDL_DITHER_ORDERED:
+                blitfun = BlitNto1Ordered;
+                break;
+            case SDL_DITHER_DIFFUSION:
+                blitfun = BlitNto1Diffusion;
+                break;
+            default:
+                break;
+            }
         } else {
             /* Now the meat, choose the blitter we want */
             int a_need = NO_ALPHA;
@@ -2584,7 +2973,9 @@ SDL_CalculateBlitN(SDL_Surface * surface)
                     dstfmt->BytesPerPixel == table[which].dstbpp &&
                     (a_need & table[which].alpha) == a_need &&
                     ((table[which].blit_features & GetBlitFeatures()) ==
-                     table[which].blit_features))
+                     table[which].blit_features) &&
+                    (!(table[which].alpha & BYTE_CHANNELS) ||
+                     (HasByteChannels32(srcfmt) && HasByteChannels32(dstfmt))))
                     break;
             }
             blitfun = table[which].blitfunc;
@@ -29,7 +29,8 @@
    and save, and since PNG is so complex that it would bloat the library,
    BMP is a good alternative.
 
-   This code currently supports Win32 DIBs in uncompressed 8 and 24 bpp.
+   This code currently supports Win32 DIBs in uncompressed 1, 4, 8, 16,
+   24 and 32 bpp, with bit fields, and RLE4 and RLE8 compressed DIBs.
 */
 
 #include "SDL_hints.h"
@@ -37,6 +38,7 @@
 #include "SDL_assert.h"
 #include "SDL_endian.h"
 #include "SDL_pixels_c.h"
+#include "../file/SDL_rwops_c.h"
 
 #define SAVE_32BIT_BMP
 
@@ -54,50 +56,166 @@
 #define LCS_WINDOWS_COLOR_SPACE    0x57696E20
 #endif
 
-static void CorrectAlphaChannel(SDL_Surface *surface)
+/* The pixel data of a BMP file, mapped or read into memory in one piece */
+typedef struct
 {
-    /* Check to see if there is any alpha channel data */
-    SDL_bool hasAlpha = SDL_FALSE;
-#if SDL_BYTEORDER == SDL_BIG_ENDIAN
-    int alphaChannelOffset = 0;
-#else
-    int alphaChannelOffset = 3;
-#endif
-    Uint8 *alpha = ((Uint8*)surface->pixels) + alphaChannelOffset;
-    Uint8 *end = alpha + surface->h * surface->pitch;
+    const Uint8 *bits;
+    size_t size;
+    SDL_RWmapping map;
+    Uint8 *buffer;
+} BMPData;
+
+static int
+GetBMPData(SDL_RWops * src, BMPData * data)
+{
+    Sint64 offset, size;
+    size_t capacity;
+
+    SDL_zerop(data);
 
-    while (alpha < end) {
-        if (*alpha != 0) {
-            hasAlpha = SDL_TRUE;
+    /* Memory streams already hold the data, and files are mapped */
+    if (SDL_RWmap(src, &data->map) == 0) {
+        data->bits = data->map.data;
+        data->size = data->map.size;
+        return 0;
+    }
+
+    /* Read the rest of the stream in one piece, growing the buffer if the
+       stream doesn't know its size */
+    offset = SDL_RWtell(src);
+    size = SDL_RWsize(src);
+    if (offset >= 0 && size > offset && (Uint64) (size - offset) < (Uint64) 0x7FFFFFFF) {
+        capacity = (size_t) (size - offset) + 1;
+    } else {
+        capacity = 64 * 1024;
+    }
+    data->buffer = (Uint8 *) SDL_malloc(capacity);
+    if (!data->buffer) {
+        return SDL_OutOfMemory();
+    }
+    for (;;) {
+        size_t amount;
+
+        if (data->size == capacity) {
+            Uint8 *buffer = (Uint8 *) SDL_realloc(data->buffer, capacity * 2);
+            if (!buffer) {
+                return SDL_OutOfMemory();
+            }
+            data->buffer = buffer;
+            capacity *= 2;
+        }
+        amount = SDL_RWread(src, data->buffer + data->size, 1, capacity - data->size);
+        if (amount == 0) {
             break;
         }
-        alpha += 4;
+        data->size += amount;
     }
+    data->bits = data->buffer;
+    return 0;
+}
+
+static void
+ReleaseBMPData(BMPData * data)
+{
+    SDL_RWunmap(&data->map);
+    SDL_free(data->buffer);
+    SDL_zerop(data);
+}
 
-    if (!hasAlpha) {
-        alpha = ((Uint8*)surface->pixels) + alphaChannelOffset;
-        while (alpha < end) {
-            *alpha = SDL_ALPHA_OPAQUE;
-            alpha += 4;
+/* Decode RLE8 or RLE4 data into 8-bit pixels, returns the bytes used */
+static size_t
+DecodeRLE(Uint8 * pixels, int pitch, int width, int height, SDL_bool rle4,
+          const Uint8 * bits, size_t size)
+{
+    size_t pos = 0;
+    int x = 0;
+    int y = height - 1;     /* RLE bitmaps are always bottom-up */
+    int i;
+
+    while (pos + 2 <= size && y >= 0) {
+        Uint8 *row = pixels + (size_t) y * pitch;
+        const int count = bits[pos++];
+        const int value = bits[pos++];
+
+        if (count) {
+            /* A run of one value, or of its two nibbles in turn for RLE4 */
+            for (i = 0; i < count && x < width; ++i, ++x) {
+                if (rle4) {
+                    row[x] = (i & 1) ? (value & 0x0F) : (value >> 4);
+                } else {
+                    row[x] = value;
+                }
+            }
+        } else if (value == 0) {
+            /* End of line */
+            x = 0;
+            --y;
+        } else if (value == 1) {
+            /* End of bitmap */
+            break;
+        } else if (value == 2) {
+            /* Delta, skip right and up */
+            if (pos + 2 > size) {
+                break;
+            }
+            x += bits[pos++];
+            y -= bits[pos++];
+        } else {
+            /* Absolute mode, literal pixels padded to a 16-bit boundary */
+            const size_t length = rle4 ? (size_t) (value + 1) / 2 : (size_t) value;
+            if (pos + length > size) {
+                break;
+            }
+            for (i = 0; i < value && x < width; ++i, ++x) {
+                if (rle4) {
+                    row[x] = (i & 1) ? (bits[pos + i / 2] & 0x0F) : (bits[pos + i / 2] >> 4);
+                } else {
+                    row[x] = bits[pos + i];
+                }
+            }
+            pos += (length + 1) & ~1;
         }
     }
+    return SDL_min(pos, size);
+}
+
+/* Convert rows of the file's pixels into the surface */
+static int
+BlitBMPRows(SDL_Surface * view, const Uint8 * bits, int pitch, int h,
+            SDL_Surface * surface, int y)
+{
+    SDL_Rect srcrect, dstrect;
+
+    view->pixels = (void *) bits;
+    view->pitch = pitch;
+    view->h = h;
+    srcrect.x = 0;
+    srcrect.y = 0;
+    srcrect.w = view->w;
+    srcrect.h = h;
+    dstrect = srcrect;
+    dstrect.y = y;
+    return SDL_LowerBlit(view, &srcrect, surface, &dstrect);
 }
 
 SDL_Surface *
-SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
+SDL_LoadBMPWithFormat_RW(SDL_RWops * src, int freesrc, Uint32 format)
 {
     SDL_bool was_error;
     Sint64 fp_offset = 0;
-    int bmpPitch;
-    int i, pad;
+    Sint64 bmpPitch, bmpSize;
+    int bmpRowSize;
+    int i, y;
     SDL_Surface *surface;
+    SDL_Surface *view = NULL;
     Uint32 Rmask = 0;
     Uint32 Gmask = 0;
     Uint32 Bmask = 0;
     Uint32 Amask = 0;
-    SDL_Palette *palette;
-    Uint8 *bits;
-    Uint8 *top, *end;
+    SDL_Palette *palette = NULL;
+    BMPData data;
+    size_t used = 0;
+    Uint8 *row = NULL;
     SDL_bool topDown;
     int ExpandBMP;
     SDL_bool haveRGBMasks = SDL_FALSE;
@@ -129,6 +247,7 @@ SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
 
     /* Make sure we are passed a valid data source */
     surface = NULL;
+    SDL_zero(data);
     was_error = SDL_FALSE;
     if (src == NULL) {
         was_error = SDL_TRUE;
@@ -226,6 +345,11 @@ SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
             SDL_RWseek(src, (biSize - headerSize), RW_SEEK_CUR);
         }
     }
+    if (biHeight == -0x7FFFFFFF - 1) {
+        SDL_SetError("BMP file is too large");
+        was_error = SDL_TRUE;
+        goto done;
+    }
     if (biHeight < 0) {
         topDown = SDL_TRUE;
         biHeight = -biHeight;
@@ -251,7 +375,7 @@ SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
         break;
     }
 
-    /* We don't support any BMP compression right now */
+    /* Check the compression and the default masks */
     switch (biCompression) {
     case BI_RGB:
         /* If there are no masks, use the defaults */
@@ -292,44 +416,58 @@ SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
     case BI_BITFIELDS:
         break;  /* we handled this in the info header. */
 
+    case BI_RLE8:
+    case BI_RLE4:
+        if (biBitCount != 8 || ExpandBMP != (biCompression == BI_RLE4 ? 4 : 0)) {
+            SDL_SetError("RLE compressed BMP file has the wrong bit count");
+            was_error = SDL_TRUE;
+            goto done;
+        }
+        if (topDown) {
+            SDL_SetError("RLE compressed BMP file is top-down");
+            was_error = SDL_TRUE;
+            goto done;
+        }
+        break;
+
     default:
         SDL_SetError("Compressed BMP files not supported");
         was_error = SDL_TRUE;
         goto done;
     }
 
-    /* Create a compatible surface, note that the colors are RGB ordered */
-    surface =
-        SDL_CreateRGBSurface(0, biWidth, biHeight, biBitCount, Rmask, Gmask,
-                             Bmask, Amask);
-    if (surface == NULL) {
+    if (biWidth < 0) {
+        SDL_SetError("BMP file has a negative width");
+        was_error = SDL_TRUE;
+        goto done;
+    }
+    /* The surface has at most 4 bytes per pixel, with its pitch padded for
+       SIMD alignment, and all of it has to be addressable */
+    if ((Sint64) biWidth * 4 + SDL_SIMD_ALIGNMENT > 0x7FFFFFFF ||
+        (Uint64) biHeight * ((Uint64) biWidth * 4 + SDL_SIMD_ALIGNMENT) > (Uint64) ((size_t) -1 / 2)) {
+        SDL_SetError("BMP file is too large");
         was_error = SDL_TRUE;
         goto done;
     }
 
     /* Load the palette, if any */
-    palette = (surface->format)->palette;
-    if (palette) {
-        SDL_assert(biBitCount <= 8);
-        if (biClrUsed == 0) {
-            biClrUsed = 1 << biBitCount;
+    if (biBitCount <= 8) {
+        const int maxColors = 1 << (ExpandBMP ? ExpandBMP : biBitCount);
+        if (biClrUsed == 0 || (int) biClrUsed > maxColors) {
+            biClrUsed = maxColors;
         }
-        if ((int) biClrUsed > palette->ncolors) {
-            SDL_Color *colors;
-            int ncolors = biClrUsed;
-            colors =
-                (SDL_Color *) SDL_realloc(palette->colors,
-                                          ncolors *
-                                          sizeof(*palette->colors));
-            if (!colors) {
-                SDL_OutOfMemory();
-                was_error = SDL_TRUE;
-                goto done;
-            }
-            palette->ncolors = ncolors;
-            palette->colors = colors;
-        } else if ((int) biClrUsed < palette->ncolors) {
-            palette->ncolors = biClrUsed;
+        /* The pixels can index past the colors in the file, so the palette
+           is always full size, with the missing colors black */
+        palette = SDL_AllocPalette(maxColors);
+        if (!palette) {
+            was_error = SDL_TRUE;
+            goto done;
+        }
+        for (i = (int) biClrUsed; i < maxColors; ++i) {
+            palette->colors[i].r = 0;
+            palette->colors[i].g = 0;
+            palette->colors[i].b = 0;
+            palette->colors[i].a = SDL_ALPHA_OPAQUE;
         }
         if (biSize == 12) {
             for (i = 0; i < (int) biClrUsed; ++i) {
@@ -354,98 +492,173 @@ SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
         }
     }
 
-    /* Read the surface pixels.  Note that the bmp image is upside down */
+    /* Get the pixel data, mapped when the stream is a file */
     if (SDL_RWseek(src, fp_offset + bfOffBits, RW_SEEK_SET) < 0) {
         SDL_Error(SDL_EFSEEK);
         was_error = SDL_TRUE;
         goto done;
     }
-    top = (Uint8 *)surface->pixels;
-    end = (Uint8 *)surface->pixels+(surface->h*surface->pitch);
-    switch (ExpandBMP) {
-    case 1:
-        bmpPitch = (biWidth + 7) >> 3;
-        pad = (((bmpPitch) % 4) ? (4 - ((bmpPitch) % 4)) : 0);
-        break;
-    case 4:
-        bmpPitch = (biWidth + 1) >> 1;
-        pad = (((bmpPitch) % 4) ? (4 - ((bmpPitch) % 4)) : 0);
-        break;
-    default:
-        pad = ((surface->pitch % 4) ? (4 - (surface->pitch % 4)) : 0);
-        break;
+    if (GetBMPData(src, &data) < 0) {
+        was_error = SDL_TRUE;
+        goto done;
     }
-    if (topDown) {
-        bits = top;
-    } else {
-        bits = end - surface->pitch;
-    }
-    while (bits >= top && bits < end) {
-        switch (ExpandBMP) {
-        case 1:
-        case 4:{
-                Uint8 pixel = 0;
-                int shift = (8 - ExpandBMP);
-                for (i = 0; i < surface->w; ++i) {
-                    if (i % (8 / ExpandBMP) == 0) {
-                        if (!SDL_RWread(src, &pixel, 1, 1)) {
-                            SDL_SetError("Error reading from BMP");
-                            was_error = SDL_TRUE;
-                            goto done;
-                        }
-                    }
-                    *(bits + i) = (pixel >> shift);
-                    pixel <<= ExpandBMP;
+
+    /* Rows are padded to 4 bytes */
+    bmpRowSize = (int) (((Sint64) biWidth * (ExpandBMP ? ExpandBMP : ((biBitCount + 7) & ~7)) + 7) / 8);
+    bmpPitch = ((Sint64) bmpRowSize + 3) & ~3;
+    bmpSize = biHeight ? bmpPitch * (biHeight - 1) + bmpRowSize : 0;
+    if (biCompression != BI_RLE8 && biCompression != BI_RLE4) {
+        if (bmpPitch > 0x7FFFFFFF || (Uint64) bmpSize > (Uint64) data.size) {
+            SDL_Error(SDL_EFREAD);
+            was_error = SDL_TRUE;
+            goto done;
+        }
+        /* The padding of the last row is part of the pixel data */
+        used = (size_t) SDL_min((Uint64) bmpPitch * biHeight, (Uint64) data.size);
+    }
+
+    /* A 32-bit BMP without any alpha data is opaque */
+    if (correctAlpha) {
+        SDL_bool hasAlpha = SDL_FALSE;
+        for (y = 0; y < biHeight && !hasAlpha; ++y) {
+            const Uint8 *alpha = data.bits + y * bmpPitch + 3;
+            for (i = 0; i < biWidth; ++i, alpha += 4) {
+                if (*alpha != 0) {
+                    hasAlpha = SDL_TRUE;
+                    break;
                 }
             }
-            break;
+        }
+        if (!hasAlpha) {
+            Amask = 0;
+        }
+    }
 
-        default:
-            if (SDL_RWread(src, bits, 1, surface->pitch)
-                != surface->pitch) {
-                SDL_Error(SDL_EFREAD);
+    /* Describe the file's pixels, note that the colors are RGB ordered */
+    view = SDL_CreateRGBSurfaceFrom(NULL, biWidth, 1, biBitCount, 0, Rmask,
+                                    Gmask, Bmask, Amask);
+    if (view == NULL) {
+        was_error = SDL_TRUE;
+        goto done;
+    }
+    if (palette) {
+        SDL_SetSurfacePalette(view, palette);
+    }
+    SDL_SetSurfaceBlendMode(view, SDL_BLENDMODE_NONE);
+
+    /* Create the surface, in the file's format unless one was requested */
+    if (format == SDL_PIXELFORMAT_UNKNOWN) {
+        surface =
+            SDL_CreateRGBSurface(0, biWidth, biHeight, biBitCount, Rmask,
+                                 Gmask, Bmask, correctAlpha ? 0xFF000000 : Amask);
+    } else {
+        surface = SDL_CreateRGBSurfaceWithFormat(0, biWidth, biHeight, 0, format);
+    }
+    if (surface == NULL) {
+        was_error = SDL_TRUE;
+        goto done;
+    }
+    if (palette && surface->format->palette &&
+        surface->format->BitsPerPixel == view->format->BitsPerPixel) {
+        SDL_SetSurfacePalette(surface, palette);
+    }
+    if (biWidth == 0 || biHeight == 0) {
+        goto done;
+    }
+
+    /* Decode the pixels straight into the surface where possible, otherwise
+       through a row or an 8-bit image converted by the blitter. */
+    if (biCompression == BI_RLE8 || biCompression == BI_RLE4) {
+        const SDL_bool rle4 = (biCompression == BI_RLE4);
+        if (surface->format->format == view->format->format &&
+            surface->format->palette == palette) {
+            used = DecodeRLE((Uint8 *) surface->pixels, surface->pitch, biWidth,
+                             biHeight, rle4, data.bits, data.size);
+        } else {
+            row = (Uint8 *) SDL_calloc(biHeight, biWidth);
+            if (!row) {
+                SDL_OutOfMemory();
                 was_error = SDL_TRUE;
                 goto done;
             }
+            used = DecodeRLE(row, biWidth, biWidth, biHeight, rle4,
+                             data.bits, data.size);
+            if (BlitBMPRows(view, row, biWidth, biHeight, surface, 0) < 0) {
+                was_error = SDL_TRUE;
+                goto done;
+            }
+        }
+    } else {
+        SDL_bool swap = SDL_FALSE;
+
 #if SDL_BYTEORDER == SDL_BIG_ENDIAN
-            /* Byte-swap the pixels if needed. Note that the 24bpp
-               case has already been taken care of above. */
-            switch (biBitCount) {
-            case 15:
-            case 16:{
-                    Uint16 *pix = (Uint16 *) bits;
-                    for (i = 0; i < surface->w; i++)
-                        pix[i] = SDL_Swap16(pix[i]);
-                    break;
-                }
+        /* Byte-swap the pixels if needed. Note that the 24bpp case has
+           already been taken care of with the masks. */
+        swap = (biBitCount == 15 || biBitCount == 16 || biBitCount == 32);
+#endif
+        if (ExpandBMP || swap) {
+            row = (Uint8 *) SDL_malloc(view->format->BytesPerPixel * biWidth);
+            if (!row) {
+                SDL_OutOfMemory();
+                was_error = SDL_TRUE;
+                goto done;
+            }
+        } else if (topDown) {
+            /* The file's rows are in the surface's order, convert them all at once */
+            if (BlitBMPRows(view, data.bits, (int) bmpPitch, biHeight, surface, 0) < 0) {
+                was_error = SDL_TRUE;
+            }
+            goto done;
+        }
 
-            case 32:{
-                    Uint32 *pix = (Uint32 *) bits;
-                    for (i = 0; i < surface->w; i++)
-                        pix[i] = SDL_Swap32(pix[i]);
-                    break;
+        for (y = 0; y < biHeight; ++y) {
+            const Uint8 *bits = data.bits + y * bmpPitch;
+            const int dsty = topDown ? y : (biHeight - 1 - y);
+
+            if (ExpandBMP) {
+                /* Expand 1 and 4 bit pixels to 8 bits per pixel */
+                const int perByte = 8 / ExpandBMP;
+                for (i = 0; i < biWidth; ++i) {
+                    const int shift = 8 - ExpandBMP * (i % perByte + 1);
+                    row[i] = (bits[i / perByte] >> shift) & ((1 << ExpandBMP) - 1);
                 }
+                bits = row;
+            } else if (swap) {
+                if (biBitCount == 32) {
+                    const Uint32 *pix = (const Uint32 *) bits;
+                    for (i = 0; i < biWidth; ++i) {
+                        ((Uint32 *) row)[i] = SDL_Swap32(pix[i]);
+                    }
+                } else {
+                    const Uint16 *pix = (const Uint16 *) bits;
+                    for (i = 0; i < biWidth; ++i) {
+                        ((Uint16 *) row)[i] = SDL_Swap16(pix[i]);
+                    }
+                }
+                bits = row;
             }
-#endif
-            break;
-        }
-        /* Skip padding bytes, ugh */
-        if (pad) {
-            Uint8 padbyte;
-            for (i = 0; i < pad; ++i) {
-                SDL_RWread(src, &padbyte, 1, 1);
+            if (BlitBMPRows(view, bits, (int) bmpPitch, 1, surface, dsty) < 0) {
+                was_error = SDL_TRUE;
+                goto done;
             }
         }
-        if (topDown) {
-            bits += surface->pitch;
-        } else {
-            bits -= surface->pitch;
-        }
-    }
-    if (correctAlpha) {
-        CorrectAlphaChannel(surface);
     }
   done:
+    SDL_free(row);
+    if (view) {
+        view->pixels = NULL;
+        SDL_FreeSurface(view);
+    }
+    if (palette) {
+        SDL_FreePalette(palette);
+    }
+    if (data.bits) {
+        /* Leave the stream after the pixel data */
+        if (!was_error) {
+            SDL_RWseek(src, fp_offset + bfOffBits + used, RW_SEEK_SET);
+        }
+        ReleaseBMPData(&data);
+    }
     if (was_error) {
         if (src) {
             SDL_RWseek(src, fp_offset, RW_SEEK_SET);
@@ -459,6 +672,12 @@ SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
     return (surface);
 }
 
+SDL_Surface *
+SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
+{
+    return SDL_LoadBMPWithFormat_RW(src, freesrc, SDL_PIXELFORMAT_UNKNOWN);
+}
+
 int
 SDL_SaveBMP_RW(SDL_Surface * saveme, SDL_RWops * dst, int freedst)
 {
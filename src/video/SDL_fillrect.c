@@ -22,113 +22,171 @@
 
 #include "SDL_video.h"
 #include "SDL_blit.h"
+#include "../SDL_simd.h"
 
 
-#ifdef __SSE__
-/* *INDENT-OFF* */
-
-#ifdef _MSC_VER
-#define SSE_BEGIN \
-    __m128 c128; \
-    c128.m128_u32[0] = color; \
-    c128.m128_u32[1] = color; \
-    c128.m128_u32[2] = color; \
-    c128.m128_u32[3] = color;
-#else
-#define SSE_BEGIN \
-    __m128 c128; \
-    DECLARE_ALIGNED(Uint32, cccc[4], 16); \
-    cccc[0] = color; \
-    cccc[1] = color; \
-    cccc[2] = color; \
-    cccc[3] = color; \
-    c128 = *(__m128 *)cccc;
-#endif
+/* Fills larger than this bypass the cache with non-temporal stores, the
+   pixels wouldn't stay cached until they are drawn over or read anyway */
+#define SDL_FILLRECT_STREAM_BYTES   (4 * 1024 * 1024)
+
+#if HAVE_SSE_INTRINSICS || HAVE_AVX2_INTRINSICS || HAVE_NEON_INTRINSICS
+
+/* Fill 'n' bytes of each row with a color repeated every 4 bytes. The rows
+   start on a pixel boundary, so the color starts where the address is a
+   multiple of 4 (2 and 1 byte colors are repeated to 4 bytes). */
+typedef void (*SDL_FillRowsFunc)(Uint8 *pixels, int pitch, Uint32 color, int n, int h, SDL_bool stream);
+
+#define SDL_FILLROWS_PATTERN_SIZE   32  /* in Uint32, covers alignment and tail bytes */
+
+static void
+SDL_FillPattern(Uint32 *pattern, Uint32 color)
+{
+    int i;
 
-#define SSE_WORK \
-    for (i = n / 64; i--;) { \
-        _mm_stream_ps((float *)(p+0), c128); \
-        _mm_stream_ps((float *)(p+16), c128); \
-        _mm_stream_ps((float *)(p+32), c128); \
-        _mm_stream_ps((float *)(p+48), c128); \
-        p += 64; \
+    for (i = 0; i < SDL_FILLROWS_PATTERN_SIZE; ++i) {
+        pattern[i] = color;
     }
+}
 
-#define SSE_END
-
-#define DEFINE_SSE_FILLRECT(bpp, type) \
-static void \
-SDL_FillRect##bpp##SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
-{ \
-    int i, n; \
-    Uint8 *p = NULL; \
- \
-    SSE_BEGIN; \
- \
-    while (h--) { \
-        n = w * bpp; \
-        p = pixels; \
- \
-        if (n > 63) { \
-            int adjust = 16 - ((uintptr_t)p & 15); \
-            if (adjust < 16) { \
-                n -= adjust; \
-                adjust /= bpp; \
-                while (adjust--) { \
-                    *((type *)p) = (type)color; \
-                    p += bpp; \
-                } \
-            } \
-            SSE_WORK; \
-        } \
-        if (n & 63) { \
-            int remainder = (n & 63); \
-            remainder /= bpp; \
-            while (remainder--) { \
-                *((type *)p) = (type)color; \
-                p += bpp; \
-            } \
-        } \
-        pixels += pitch; \
-    } \
- \
-    SSE_END; \
+/* Fill up to 64 bytes unaligned from the repeated pattern */
+static SDL_INLINE void
+SDL_FillBytes(Uint8 *p, const Uint32 *pattern, int n)
+{
+    SDL_memcpy(p, (const Uint8 *) pattern + ((uintptr_t) p & 3), n);
 }
 
+#endif /* HAVE_SSE_INTRINSICS || HAVE_AVX2_INTRINSICS || HAVE_NEON_INTRINSICS */
+
+#if HAVE_SSE_INTRINSICS
 static void
-SDL_FillRect1SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+SDL_FillRowsSSE(Uint8 *pixels, int pitch, Uint32 color, int n, int h, SDL_bool stream)
 {
-    int i, n;
+    DECLARE_ALIGNED(Uint32, pattern[SDL_FILLROWS_PATTERN_SIZE], 16);
+    __m128 c128;
+    int i;
+
+    SDL_FillPattern(pattern, color);
+    c128 = _mm_load_ps((const float *) pattern);
 
-    SSE_BEGIN;
     while (h--) {
         Uint8 *p = pixels;
-        n = w;
-
-        if (n > 63) {
-            int adjust = 16 - ((uintptr_t)p & 15);
-            if (adjust) {
-                n -= adjust;
-                SDL_memset(p, color, adjust);
-                p += adjust;
+        int left = n;
+
+        if (left >= 64) {
+            const int adjust = (int) (-(intptr_t) p & 63);
+
+            /* Start on a cache line, so no line mixes regular and
+               non-temporal stores */
+            SDL_FillBytes(p, pattern, adjust);
+            p += adjust;
+            left -= adjust;
+            if (stream) {
+                for (i = left / 64; i--; p += 64) {
+                    _mm_stream_ps((float *) (p + 0), c128);
+                    _mm_stream_ps((float *) (p + 16), c128);
+                    _mm_stream_ps((float *) (p + 32), c128);
+                    _mm_stream_ps((float *) (p + 48), c128);
+                }
+            } else {
+                for (i = left / 64; i--; p += 64) {
+                    _mm_store_ps((float *) (p + 0), c128);
+                    _mm_store_ps((float *) (p + 16), c128);
+                    _mm_store_ps((float *) (p + 32), c128);
+                    _mm_store_ps((float *) (p + 48), c128);
+                }
             }
-            SSE_WORK;
+            left &= 63;
         }
-        if (n & 63) {
-            int remainder = (n & 63);
-            SDL_memset(p, color, remainder);
+        SDL_FillBytes(p, pattern, left);
+        pixels += pitch;
+    }
+
+    /* Non-temporal stores aren't ordered with the stores that follow */
+    if (stream) {
+        _mm_sfence();
+    }
+}
+#endif /* HAVE_SSE_INTRINSICS */
+
+#if HAVE_AVX2_INTRINSICS
+static void SDL_TARGETING_AVX2
+SDL_FillRowsAVX2(Uint8 *pixels, int pitch, Uint32 color, int n, int h, SDL_bool stream)
+{
+    DECLARE_ALIGNED(Uint32, pattern[SDL_FILLROWS_PATTERN_SIZE], 32);
+    __m256i c256;
+    int i;
+
+    SDL_FillPattern(pattern, color);
+    c256 = _mm256_load_si256((const __m256i *) pattern);
+
+    while (h--) {
+        Uint8 *p = pixels;
+        int left = n;
+
+        if (left >= 64) {
+            const int adjust = (int) (-(intptr_t) p & 63);
+
+            SDL_FillBytes(p, pattern, adjust);
+            p += adjust;
+            left -= adjust;
+            if (stream) {
+                for (i = left / 64; i--; p += 64) {
+                    _mm256_stream_si256((__m256i *) (p + 0), c256);
+                    _mm256_stream_si256((__m256i *) (p + 32), c256);
+                }
+            } else {
+                for (i = left / 64; i--; p += 64) {
+                    _mm256_store_si256((__m256i *) (p + 0), c256);
+                    _mm256_store_si256((__m256i *) (p + 32), c256);
+                }
+            }
+            left &= 63;
         }
+        SDL_FillBytes(p, pattern, left);
         pixels += pitch;
     }
 
-    SSE_END;
+    if (stream) {
+        _mm_sfence();
+    }
 }
-/* DEFINE_SSE_FILLRECT(1, Uint8) */
-DEFINE_SSE_FILLRECT(2, Uint16)
-DEFINE_SSE_FILLRECT(4, Uint32)
+#endif /* HAVE_AVX2_INTRINSICS */
 
-/* *INDENT-ON* */
-#endif /* __SSE__ */
+#if HAVE_NEON_INTRINSICS
+/* NEON has no non-temporal store intrinsics, 'stream' is ignored */
+static void
+SDL_FillRowsNEON(Uint8 *pixels, int pitch, Uint32 color, int n, int h, SDL_bool stream)
+{
+    Uint32 pattern[SDL_FILLROWS_PATTERN_SIZE];
+    uint8x16_t c128;
+    int i;
+
+    SDL_FillPattern(pattern, color);
+    c128 = vreinterpretq_u8_u32(vdupq_n_u32(color));
+
+    while (h--) {
+        Uint8 *p = pixels;
+        int left = n;
+
+        if (left >= 64) {
+            const int adjust = (int) (-(intptr_t) p & 63);
+
+            SDL_FillBytes(p, pattern, adjust);
+            p += adjust;
+            left -= adjust;
+            for (i = left / 64; i--; p += 64) {
+                vst1q_u8(p + 0, c128);
+                vst1q_u8(p + 16, c128);
+                vst1q_u8(p + 32, c128);
+                vst1q_u8(p + 48, c128);
+            }
+            left &= 63;
+        }
+        SDL_FillBytes(p, pattern, left);
+        pixels += pitch;
+    }
+}
+#endif /* HAVE_NEON_INTRINSICS */
 
 static void
 SDL_FillRect1(Uint8 * pixels, int pitch, Uint32 color, int w, int h)
@@ -230,6 +288,101 @@ SDL_FillRect4(Uint8 * pixels, int pitch, Uint32 color, int w, int h)
     }
 }
 
+/* Fill a clipped rectangle, 'color' is repeated to 32 bits for 1 and 2 byte pixels */
+static void
+SDL_FillRectPixels(Uint8 * pixels, int pitch, int bpp, Uint32 color, int w, int h, SDL_bool stream)
+{
+#if HAVE_SSE_INTRINSICS || HAVE_AVX2_INTRINSICS || HAVE_NEON_INTRINSICS
+    /* The vector fills need pixels on their natural alignment */
+    if (bpp != 3 && ((uintptr_t) pixels % bpp) == 0 && (pitch % bpp) == 0) {
+        SDL_FillRowsFunc func = NULL;
+
+#if HAVE_AVX2_INTRINSICS
+        if (!func && SDL_HasAVX2()) {
+            func = SDL_FillRowsAVX2;
+        }
+#endif
+#if HAVE_SSE_INTRINSICS
+        if (!func && SDL_HasSSE()) {
+            func = SDL_FillRowsSSE;
+        }
+#endif
+#if HAVE_NEON_INTRINSICS
+        if (!func && SDL_HasNEON()) {
+            func = SDL_FillRowsNEON;
+        }
+#endif
+        if (func) {
+            func(pixels, pitch, color, w * bpp, h, stream);
+            return;
+        }
+    }
+#endif
+
+    switch (bpp) {
+    case 1:
+        SDL_FillRect1(pixels, pitch, color, w, h);
+        break;
+    case 2:
+        SDL_FillRect2(pixels, pitch, color, w, h);
+        break;
+    case 3:
+        /* 24-bit RGB is a slow path, at least for now. */
+        SDL_FillRect3(pixels, pitch, color, w, h);
+        break;
+    case 4:
+        SDL_FillRect4(pixels, pitch, color, w, h);
+        break;
+    }
+}
+
+static void
+SDL_FillRectBand(SDL_BlitInfo * info)
+{
+    SDL_FillRectPixels(info->dst, info->dst_pitch, info->dst_fmt->BytesPerPixel,
+                       info->colorkey, info->dst_w, info->dst_h, SDL_FALSE);
+}
+
+static void
+SDL_FillRectBandStreaming(SDL_BlitInfo * info)
+{
+    SDL_FillRectPixels(info->dst, info->dst_pitch, info->dst_fmt->BytesPerPixel,
+                       info->colorkey, info->dst_w, info->dst_h, SDL_TRUE);
+}
+
+/* Fill a rectangle already clipped to the surface */
+static void
+SDL_FillClippedRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
+{
+    const int bpp = dst->format->BytesPerPixel;
+    SDL_bool stream;
+    SDL_BlitInfo info;
+
+    switch (bpp) {
+    case 1:
+        color |= (color << 8);
+        color |= (color << 16);
+        break;
+    case 2:
+        color |= (color << 16);
+        break;
+    }
+    stream = ((Sint64) rect->w * rect->h * bpp >= SDL_FILLRECT_STREAM_BYTES);
+
+    SDL_zero(info);
+    info.dst = (Uint8 *) dst->pixels + rect->y * dst->pitch + rect->x * bpp;
+    info.dst_w = info.src_w = rect->w;
+    info.dst_h = info.src_h = rect->h;
+    info.dst_pitch = dst->pitch;
+    info.dst_fmt = dst->format;
+    info.colorkey = color;
+
+    /* Very large fills are split over the blit threads */
+    if (!SDL_RunBlitThreaded(stream ? SDL_FillRectBandStreaming : SDL_FillRectBand, &info)) {
+        SDL_FillRectPixels(info.dst, info.dst_pitch, bpp, color, rect->w, rect->h, stream);
+    }
+}
+
 /* 
  * This function performs a fast fill of the given rectangle with 'color'
  */
@@ -237,7 +390,6 @@ int
 SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
 {
     SDL_Rect clipped;
-    Uint8 *pixels;
 
     if (!dst) {
         return SDL_SetError("Passed NULL destination surface");
@@ -268,75 +420,124 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
         return SDL_SetError("SDL_FillRect(): You must lock the surface");
     }
 
-    pixels = (Uint8 *) dst->pixels + rect->y * dst->pitch +
-                                     rect->x * dst->format->BytesPerPixel;
+    SDL_FillClippedRect(dst, rect, color);
 
-    switch (dst->format->BytesPerPixel) {
-    case 1:
-        {
-            color |= (color << 8);
-            color |= (color << 16);
-#ifdef __SSE__
-            if (SDL_HasSSE()) {
-                SDL_FillRect1SSE(pixels, dst->pitch, color, rect->w, rect->h);
-                break;
-            }
-#endif
-            SDL_FillRect1(pixels, dst->pitch, color, rect->w, rect->h);
-            break;
-        }
+    /* We're done! */
+    return 0;
+}
 
-    case 2:
-        {
-            color |= (color << 16);
-#ifdef __SSE__
-            if (SDL_HasSSE()) {
-                SDL_FillRect2SSE(pixels, dst->pitch, color, rect->w, rect->h);
-                break;
-            }
-#endif
-            SDL_FillRect2(pixels, dst->pitch, color, rect->w, rect->h);
-            break;
-        }
+/* Order rectangles by row, so rectangles side by side with the same height follow each other */
+static int
+SDL_CompareRectRows(const void *a, const void *b)
+{
+    const SDL_Rect *A = (const SDL_Rect *) a;
+    const SDL_Rect *B = (const SDL_Rect *) b;
 
-    case 3:
-        /* 24-bit RGB is a slow path, at least for now. */
-        {
-            SDL_FillRect3(pixels, dst->pitch, color, rect->w, rect->h);
-            break;
-        }
+    if (A->y != B->y) {
+        return A->y - B->y;
+    }
+    if (A->h != B->h) {
+        return A->h - B->h;
+    }
+    return A->x - B->x;
+}
 
-    case 4:
-        {
-#ifdef __SSE__
-            if (SDL_HasSSE()) {
-                SDL_FillRect4SSE(pixels, dst->pitch, color, rect->w, rect->h);
-                break;
-            }
-#endif
-            SDL_FillRect4(pixels, dst->pitch, color, rect->w, rect->h);
-            break;
+/* Order rectangles by column, so stacked rectangles with the same width follow each other */
+static int
+SDL_CompareRectColumns(const void *a, const void *b)
+{
+    const SDL_Rect *A = (const SDL_Rect *) a;
+    const SDL_Rect *B = (const SDL_Rect *) b;
+
+    if (A->x != B->x) {
+        return A->x - B->x;
+    }
+    if (A->w != B->w) {
+        return A->w - B->w;
+    }
+    return A->y - B->y;
+}
+
+/* Merge rectangles that touch or overlap into larger ones covering the same
+   pixels, returns the new number of rectangles */
+static int
+SDL_MergeFillRects(SDL_Rect * rects, int count)
+{
+    int i, n;
+
+    /* Join rectangles along rows */
+    SDL_qsort(rects, count, sizeof(*rects), SDL_CompareRectRows);
+    for (i = 1, n = 0; i < count; ++i) {
+        SDL_Rect *last = &rects[n];
+        const SDL_Rect *rect = &rects[i];
+
+        if (rect->y == last->y && rect->h == last->h && rect->x <= last->x + last->w) {
+            last->w = SDL_max(last->x + last->w, rect->x + rect->w) - last->x;
+        } else {
+            rects[++n] = *rect;
         }
     }
+    count = n + 1;
+
+    /* Join the resulting spans along columns */
+    SDL_qsort(rects, count, sizeof(*rects), SDL_CompareRectColumns);
+    for (i = 1, n = 0; i < count; ++i) {
+        SDL_Rect *last = &rects[n];
+        const SDL_Rect *rect = &rects[i];
+
+        if (rect->x == last->x && rect->w == last->w && rect->y <= last->y + last->h) {
+            last->h = SDL_max(last->y + last->h, rect->y + rect->h) - last->y;
+        } else {
+            rects[++n] = *rect;
+        }
+    }
+    count = n + 1;
 
-    /* We're done! */
-    return 0;
+    /* Fill from the top of the surface down */
+    SDL_qsort(rects, count, sizeof(*rects), SDL_CompareRectRows);
+    return count;
 }
 
 int
 SDL_FillRects(SDL_Surface * dst, const SDL_Rect * rects, int count,
               Uint32 color)
 {
-    int i;
+    SDL_Rect *clipped;
+    int i, n;
     int status = 0;
 
     if (!rects) {
         return SDL_SetError("SDL_FillRects() passed NULL rects");
     }
+    if (count <= 1 || !dst || dst->format->BitsPerPixel < 8 || !dst->pixels) {
+        for (i = 0; i < count; ++i) {
+            status += SDL_FillRect(dst, &rects[i], color);
+        }
+        return status;
+    }
 
-    for (i = 0; i < count; ++i) {
-        status += SDL_FillRect(dst, &rects[i], color);
+    clipped = (SDL_Rect *) SDL_malloc(count * sizeof(*clipped));
+    if (!clipped) {
+        /* Fill them one at a time */
+        for (i = 0; i < count; ++i) {
+            status += SDL_FillRect(dst, &rects[i], color);
+        }
+        return status;
+    }
+
+    for (i = 0, n = 0; i < count; ++i) {
+        if (SDL_IntersectRect(&rects[i], &dst->clip_rect, &clipped[n])) {
+            ++n;
+        }
     }
+    if (n > 1) {
+        n = SDL_MergeFillRects(clipped, n);
+    }
+    for (i = 0; i < n; ++i) {
+        SDL_FillClippedRect(dst, &clipped[i], color);
+    }
+    SDL_free(clipped);
+
     return status;
 }
 
@@ -23,12 +23,42 @@
 /* General (mostly internal) pixel/color manipulation routines for SDL */
 
 #include "SDL_endian.h"
+#include "SDL_atomic.h"
+#include "SDL_hints.h"
 #include "SDL_video.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
 #include "SDL_pixels_c.h"
 #include "SDL_RLEaccel_c.h"
 
+#ifdef __LINUX__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#if defined(MAP_HUGETLB) && defined(MADV_HUGEPAGE)
+#define HAVE_HUGE_PAGES 1
+#endif
+#ifdef SYS_memfd_create
+#define HAVE_SHARED_PIXELS 1
+/* Not all C libraries declare these yet */
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC         0x0001U
+#endif
+#ifndef MFD_ALLOW_SEALING
+#define MFD_ALLOW_SEALING   0x0002U
+#endif
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS         1033
+#define F_GET_SEALS         1034
+#define F_SEAL_SEAL         0x0001
+#define F_SEAL_SHRINK       0x0002
+#define F_SEAL_GROW         0x0004
+#endif
+#endif
+#endif
+
 
 /* Lookup tables to expand partial bytes to the full 0..255 range */
 
@@ -490,16 +520,21 @@ SDL_MasksToPixelFormatEnum(int bpp, Uint32 Rmask, Uint32 Gmask, Uint32 Bmask,
 }
 
 static SDL_PixelFormat *formats;
+static SDL_SpinLock formats_lock = 0;
 
 SDL_PixelFormat *
 SDL_AllocFormat(Uint32 pixel_format)
 {
     SDL_PixelFormat *format;
 
+    /* The format list is shared by surfaces created on any thread */
+    SDL_AtomicLock(&formats_lock);
+
     /* Look it up in our list of previously allocated formats */
     for (format = formats; format; format = format->next) {
         if (pixel_format == format->format) {
             ++format->refcount;
+            SDL_AtomicUnlock(&formats_lock);
             return format;
         }
     }
@@ -507,10 +542,12 @@ SDL_AllocFormat(Uint32 pixel_format)
     /* Allocate an empty pixel format structure, and initialize it */
     format = SDL_malloc(sizeof(*format));
     if (format == NULL) {
+        SDL_AtomicUnlock(&formats_lock);
         SDL_OutOfMemory();
         return NULL;
     }
     if (SDL_InitFormat(format, pixel_format) < 0) {
+        SDL_AtomicUnlock(&formats_lock);
         SDL_free(format);
         SDL_InvalidParamError("format");
         return NULL;
@@ -521,6 +558,9 @@ SDL_AllocFormat(Uint32 pixel_format)
         format->next = formats;
         formats = format;
     }
+
+    SDL_AtomicUnlock(&formats_lock);
+
     return format;
 }
 
@@ -598,7 +638,11 @@ SDL_FreeFormat(SDL_PixelFormat *format)
         SDL_InvalidParamError("format");
         return;
     }
+
+    SDL_AtomicLock(&formats_lock);
+
     if (--format->refcount > 0) {
+        SDL_AtomicUnlock(&formats_lock);
         return;
     }
 
@@ -614,15 +658,274 @@ SDL_FreeFormat(SDL_PixelFormat *format)
         }
     }
 
+    SDL_AtomicUnlock(&formats_lock);
+
     if (format->palette) {
         SDL_FreePalette(format->palette);
     }
     SDL_free(format);
 }
 
+/* Nearest color lookup, kept for palettes allocated by SDL_AllocPalette().
+   RGB space is cut into cells of 16x16x16 colors.  Each cell lists, in
+   index order, the palette entries that can be nearest to one of its
+   colors, so a search only has to look at those and still gives the same
+   answer as scanning the whole palette.  The lists are built as the cells
+   are first used.
+ */
+#define LOOKUP_CELL_SHIFT   4
+#define LOOKUP_CELL_SIZE    (1 << LOOKUP_CELL_SHIFT)
+#define LOOKUP_NUM_CELLS    (1 << (3 * (8 - LOOKUP_CELL_SHIFT)))
+
+typedef struct SDL_PaletteLookup
+{
+    /* The palette contents the cells were built for */
+    Uint32 version;
+    int ncolors;
+    SDL_Color colors[256];
+    SDL_bool usable;            /* SDL_FALSE if the alpha values differ */
+
+    /* Offsets of the cell lists, -1 if not built yet.  A list is a count
+       minus one, followed by that many palette indices */
+    Sint32 cells[LOOKUP_NUM_CELLS];
+    Uint8 *lists;
+    int lists_used;
+    int lists_size;
+} SDL_PaletteLookup;
+
+/* Palettes allocated by SDL_AllocPalette() keep their lookup and colors
+   right after the palette. Applications can build their own palettes too,
+   those are searched without a lookup. */
+#define PALETTE_MAGIC       0x50414C44  /* "PALD" */
+
+typedef struct SDL_PaletteData
+{
+    SDL_Palette palette;        /* This has to be first */
+    Uint32 magic;
+    SDL_SpinLock lock;          /* Held while the lookup is used */
+    SDL_PaletteLookup *lookup;
+    SDL_Color colors[1];        /* palette.ncolors of them */
+} SDL_PaletteData;
+
+/* Get the data of a palette allocated by SDL_AllocPalette(), or NULL.
+   The colors pointer is checked first, so nothing past the end of an
+   application's palette is read. */
+static SDL_PaletteData *
+GetPaletteData(const SDL_Palette * palette)
+{
+    SDL_PaletteData *data = (SDL_PaletteData *) palette;
+
+    if (palette->colors != data->colors || data->magic != PALETTE_MAGIC) {
+        return NULL;
+    }
+    return data;
+}
+
+/* Nearest color among count entries of the palette, taken from list if
+   it's not NULL.  The first of equally near entries wins. */
+static Uint8
+FindColorIn(const SDL_Color * colors, const Uint8 * list, int count,
+            Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    /* Do colorspace distance matching */
+    unsigned int smallest;
+    unsigned int distance;
+    int rd, gd, bd, ad;
+    int i, n;
+    Uint8 pixel = 0;
+
+    smallest = ~0;
+    for (n = 0; n < count; ++n) {
+        i = list ? list[n] : n;
+        rd = colors[i].r - r;
+        gd = colors[i].g - g;
+        bd = colors[i].b - b;
+        ad = colors[i].a - a;
+        distance = (rd * rd) + (gd * gd) + (bd * bd) + (ad * ad);
+        if (distance < smallest) {
+            pixel = i;
+            if (distance == 0) {        /* Perfect match! */
+                break;
+            }
+            smallest = distance;
+        }
+    }
+    return (pixel);
+}
+
+/* Get the palette lookup, up to date with the palette colors.
+   Returns NULL if the palette can't use one, the palette lock must be held.
+ */
+static SDL_PaletteLookup *
+GetPaletteLookup(SDL_PaletteData * data)
+{
+    const SDL_Palette *palette = &data->palette;
+    SDL_PaletteLookup *lookup;
+    int i;
+
+    if (palette->ncolors > 256) {
+        return NULL;
+    }
+
+    lookup = data->lookup;
+    if (!lookup) {
+        lookup = (SDL_PaletteLookup *) SDL_calloc(1, sizeof(*lookup));
+        if (!lookup) {
+            return NULL;
+        }
+        data->lookup = lookup;
+    }
+
+    /* The colors are compared too, they may have been changed directly */
+    if (lookup->version != palette->version ||
+        lookup->ncolors != palette->ncolors ||
+        SDL_memcmp(lookup->colors, palette->colors,
+                   palette->ncolors * sizeof(SDL_Color)) != 0) {
+        lookup->version = palette->version;
+        lookup->ncolors = palette->ncolors;
+        SDL_memcpy(lookup->colors, palette->colors,
+                   palette->ncolors * sizeof(SDL_Color));
+        SDL_memset(lookup->cells, 0xFF, sizeof(lookup->cells));
+        lookup->lists_used = 0;
+
+        /* The alpha distance has to be the same for all entries, so only
+           the RGB distance decides */
+        lookup->usable = SDL_TRUE;
+        for (i = 1; i < palette->ncolors; ++i) {
+            if (palette->colors[i].a != palette->colors[0].a) {
+                lookup->usable = SDL_FALSE;
+                break;
+            }
+        }
+    }
+    return lookup->usable ? lookup : NULL;
+}
+
+/* Squared distance from v to the nearest and farthest values of a cell */
+#define CELL_NEAR(v, lo) \
+    ((v) < (lo) ? ((lo) - (v)) * ((lo) - (v)) : \
+     (v) >= (lo) + LOOKUP_CELL_SIZE ? \
+        ((v) - (lo) - LOOKUP_CELL_SIZE + 1) * ((v) - (lo) - LOOKUP_CELL_SIZE + 1) : 0)
+#define CELL_FAR(v, lo) \
+    ((v) - (lo) < LOOKUP_CELL_SIZE / 2 ? \
+        ((lo) + LOOKUP_CELL_SIZE - 1 - (v)) * ((lo) + LOOKUP_CELL_SIZE - 1 - (v)) : \
+        ((v) - (lo)) * ((v) - (lo)))
+
+/* Get the candidate list of the cell holding a color, or NULL if out of memory */
+static const Uint8 *
+GetLookupCell(SDL_PaletteLookup * lookup, Uint8 r, Uint8 g, Uint8 b)
+{
+    const int shift = 8 - LOOKUP_CELL_SHIFT;
+    const int cell = ((r >> LOOKUP_CELL_SHIFT) << (2 * shift)) |
+                     ((g >> LOOKUP_CELL_SHIFT) << shift) |
+                     (b >> LOOKUP_CELL_SHIFT);
+
+    if (lookup->cells[cell] < 0) {
+        const int rlo = r & ~(LOOKUP_CELL_SIZE - 1);
+        const int glo = g & ~(LOOKUP_CELL_SIZE - 1);
+        const int blo = b & ~(LOOKUP_CELL_SIZE - 1);
+        Uint32 nearest[256];
+        Uint32 bound = ~0;
+        Uint8 *list;
+        int count = 0;
+        int i;
+
+        /* Every color of the cell is at most bound away from some entry,
+           so entries that are farther than that from the whole cell can
+           never be the nearest one */
+        for (i = 0; i < lookup->ncolors; ++i) {
+            const int cr = lookup->colors[i].r;
+            const int cg = lookup->colors[i].g;
+            const int cb = lookup->colors[i].b;
+            const Uint32 farthest = CELL_FAR(cr, rlo) + CELL_FAR(cg, glo) + CELL_FAR(cb, blo);
+
+            nearest[i] = CELL_NEAR(cr, rlo) + CELL_NEAR(cg, glo) + CELL_NEAR(cb, blo);
+            if (farthest < bound) {
+                bound = farthest;
+            }
+        }
+        for (i = 0; i < lookup->ncolors; ++i) {
+            if (nearest[i] <= bound) {
+                ++count;
+            }
+        }
+
+        if (lookup->lists_used + 1 + count > lookup->lists_size) {
+            int size = SDL_max(lookup->lists_size * 2, 4096);
+            Uint8 *lists = (Uint8 *) SDL_realloc(lookup->lists, size);
+            if (!lists) {
+                return NULL;
+            }
+            lookup->lists = lists;
+            lookup->lists_size = size;
+        }
+        list = &lookup->lists[lookup->lists_used];
+        *list++ = (Uint8) (count - 1);
+        for (i = 0; i < lookup->ncolors; ++i) {
+            if (nearest[i] <= bound) {
+                *list++ = (Uint8) i;
+            }
+        }
+        lookup->cells[cell] = lookup->lists_used;
+        lookup->lists_used += 1 + count;
+    }
+    return &lookup->lists[lookup->cells[cell]];
+}
+
+/* The palette lock must be held */
+static Uint8
+LookupColor(const SDL_Palette * palette, SDL_PaletteLookup * lookup,
+            Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    const Uint8 *list = lookup ? GetLookupCell(lookup, r, g, b) : NULL;
+
+    if (list) {
+        return FindColorIn(palette->colors, list + 1, list[0] + 1, r, g, b, a);
+    }
+    return FindColorIn(palette->colors, NULL, palette->ncolors, r, g, b, a);
+}
+
+/* Fill a 32K table indexed by 5-5-5 bit RGB colors with their nearest
+   opaque palette entries */
+static Uint8 *
+MapNto1Nearest(SDL_Palette * palette)
+{
+    SDL_PaletteData *data = GetPaletteData(palette);
+    SDL_PaletteLookup *lookup = NULL;
+    Uint8 *map;
+    int r, g, b;
+
+    map = (Uint8 *) SDL_malloc(1 << 15);
+    if (map == NULL) {
+        SDL_OutOfMemory();
+        return (NULL);
+    }
+
+    if (data) {
+        SDL_AtomicLock(&data->lock);
+        lookup = GetPaletteLookup(data);
+    }
+    for (r = 0; r < 32; ++r) {
+        for (g = 0; g < 32; ++g) {
+            for (b = 0; b < 32; ++b) {
+                map[(r << 10) | (g << 5) | b] =
+                    LookupColor(palette, lookup, SDL_expand_byte[3][r],
+                                SDL_expand_byte[3][g], SDL_expand_byte[3][b],
+                                SDL_ALPHA_OPAQUE);
+            }
+        }
+    }
+    if (data) {
+        SDL_AtomicUnlock(&data->lock);
+    }
+
+    return (map);
+}
+
 SDL_Palette *
 SDL_AllocPalette(int ncolors)
 {
+    SDL_PaletteData *data;
     SDL_Palette *palette;
 
     /* Input validation */
@@ -631,17 +934,15 @@ SDL_AllocPalette(int ncolors)
       return NULL;
     }
 
-    palette = (SDL_Palette *) SDL_malloc(sizeof(*palette));
-    if (!palette) {
+    data = (SDL_PaletteData *) SDL_calloc(1, sizeof(*data) +
+                                          (ncolors - 1) * sizeof(SDL_Color));
+    if (!data) {
         SDL_OutOfMemory();
         return NULL;
     }
-    palette->colors =
-        (SDL_Color *) SDL_malloc(ncolors * sizeof(*palette->colors));
-    if (!palette->colors) {
-        SDL_free(palette);
-        return NULL;
-    }
+    data->magic = PALETTE_MAGIC;
+    palette = &data->palette;
+    palette->colors = data->colors;
     palette->ncolors = ncolors;
     palette->version = 1;
     palette->refcount = 1;
@@ -709,6 +1010,8 @@ SDL_SetPaletteColors(SDL_Palette * palette, const SDL_Color * colors,
 void
 SDL_FreePalette(SDL_Palette * palette)
 {
+    SDL_PaletteData *data;
+
     if (!palette) {
         SDL_InvalidParamError("palette");
         return;
@@ -716,7 +1019,17 @@ SDL_FreePalette(SDL_Palette * palette)
     if (--palette->refcount > 0) {
         return;
     }
-    SDL_free(palette->colors);
+
+    data = GetPaletteData(palette);
+    if (data) {
+        data->magic = 0;
+        if (data->lookup) {
+            SDL_free(data->lookup->lists);
+            SDL_free(data->lookup);
+        }
+    } else {
+        SDL_free(palette->colors);
+    }
     SDL_free(palette);
 }
 
@@ -768,38 +1081,242 @@ SDL_CalculatePitch(SDL_Surface * surface)
     default:
         break;
     }
-    pitch = (pitch + 3) & ~3;   /* 4-byte aligning */
+    if (surface->flags & SDL_SIMD_ALIGNED) {
+        pitch = (pitch + SDL_SIMD_ALIGNMENT - 1) & ~(SDL_SIMD_ALIGNMENT - 1);
+    } else {
+        pitch = (pitch + 3) & ~3;   /* 4-byte aligning */
+    }
     return (pitch);
 }
 
+#if HAVE_HUGE_PAGES
+/* Aligned surfaces at least this large are mapped as huge pages */
+#define SDL_HUGE_PAGE_THRESHOLD (4 * 1024 * 1024)
+#define SDL_HUGE_PAGE_SIZE      (2 * 1024 * 1024)
+
+static size_t
+SDL_HugePageLength(const SDL_Surface * surface)
+{
+    size_t size = (size_t) surface->h * surface->pitch;
+    return (size + SDL_HUGE_PAGE_SIZE - 1) & ~(size_t) (SDL_HUGE_PAGE_SIZE - 1);
+}
+
+static void *
+SDL_MapHugePages(size_t len)
+{
+    Uint8 *map, *pixels;
+    size_t head;
+
+    map = (Uint8 *) mmap(NULL, len, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (map != (Uint8 *) MAP_FAILED) {
+        return map;
+    }
+
+    /* No huge pages reserved, map a huge page aligned range of regular pages
+       and ask for transparent huge pages instead */
+    map = (Uint8 *) mmap(NULL, len + SDL_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == (Uint8 *) MAP_FAILED) {
+        return NULL;
+    }
+    head = (size_t) (-(uintptr_t) map & (SDL_HUGE_PAGE_SIZE - 1));
+    pixels = map + head;
+    if (head) {
+        munmap(map, head);
+    }
+    munmap(pixels + len, SDL_HUGE_PAGE_SIZE - head);
+    madvise(pixels, len, MADV_HUGEPAGE);
+    return pixels;
+}
+#endif /* HAVE_HUGE_PAGES */
+
+/*
+ * Allocate zero-filled pixels for a surface with its size and pitch set
+ */
+void *
+SDL_AllocSurfacePixels(SDL_Surface * surface)
+{
+    size_t size = (size_t) surface->h * surface->pitch;
+    Uint8 *mem, *pixels;
+
+    if (!(surface->flags & SDL_SIMD_ALIGNED)) {
+        return SDL_calloc(1, size);
+    }
+
+#if HAVE_HUGE_PAGES
+    if (size >= SDL_HUGE_PAGE_THRESHOLD &&
+        SDL_GetHintBoolean(SDL_HINT_SURFACE_HUGE_PAGES, SDL_TRUE)) {
+        pixels = (Uint8 *) SDL_MapHugePages(SDL_HugePageLength(surface));
+        if (pixels) {
+            surface->map->mapped_pixels = SDL_TRUE;
+            return pixels;
+        }
+    }
+#endif
+
+    /* Keep the allocated pointer just before the aligned pixels */
+    mem = (Uint8 *) SDL_calloc(1, size + SDL_SIMD_ALIGNMENT + sizeof(void *));
+    if (!mem) {
+        return NULL;
+    }
+    pixels = (Uint8 *) (((uintptr_t) mem + sizeof(void *) + SDL_SIMD_ALIGNMENT - 1) &
+                        ~(uintptr_t) (SDL_SIMD_ALIGNMENT - 1));
+    ((void **) pixels)[-1] = mem;
+    return pixels;
+}
+
+/*
+ * Free pixels allocated with SDL_AllocSurfacePixels()
+ */
+void
+SDL_FreeSurfacePixels(SDL_Surface * surface)
+{
+    if (!surface->pixels) {
+        return;
+    }
+#if HAVE_HUGE_PAGES
+    if (surface->map && surface->map->mapped_pixels) {
+        munmap(surface->pixels, SDL_HugePageLength(surface));
+        surface->map->mapped_pixels = SDL_FALSE;
+    } else
+#endif
+    if (surface->flags & SDL_SIMD_ALIGNED) {
+        SDL_free(((void **) surface->pixels)[-1]);
+    } else {
+        SDL_free(surface->pixels);
+    }
+    surface->pixels = NULL;
+}
+
+#if HAVE_SHARED_PIXELS
+static int
+SDL_MapSharedFD(SDL_Surface * surface, int fd, size_t size)
+{
+    SDL_SharedPixels *shared;
+    void *pixels;
+
+    shared = (SDL_SharedPixels *) SDL_malloc(sizeof(*shared));
+    if (!shared) {
+        close(fd);
+        return SDL_OutOfMemory();
+    }
+    pixels = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (pixels == MAP_FAILED) {
+        SDL_free(shared);
+        close(fd);
+        return SDL_SetError("Couldn't map shared pixels");
+    }
+    shared->fd = fd;
+    shared->size = size;
+    surface->pixels = pixels;
+    surface->map->shared = shared;
+    surface->flags |= SDL_PREALLOC;
+    return 0;
+}
+#endif /* HAVE_SHARED_PIXELS */
+
+/*
+ * Allocate the pixels of a surface with its size and pitch set in a sealed
+ * memory file, which other processes can map through its file descriptor
+ */
+int
+SDL_AllocSharedPixels(SDL_Surface * surface)
+{
+#if HAVE_SHARED_PIXELS
+    const size_t size = (size_t) surface->h * surface->pitch;
+    int fd;
+
+    fd = (int) syscall(SYS_memfd_create, "SDL_Surface", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        return SDL_SetError("Couldn't create shared memory");
+    }
+    /* The file is zero-filled, and sealed so it can't be resized under the
+       processes mapping it */
+    if (ftruncate(fd, (off_t) size) < 0 ||
+        fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) < 0) {
+        close(fd);
+        return SDL_SetError("Couldn't size shared memory");
+    }
+    return SDL_MapSharedFD(surface, fd, size);
+#else
+    return SDL_Unsupported();
+#endif
+}
+
+/*
+ * Map the pixels of a surface with its size and pitch set from a file
+ * descriptor, the surface keeps its own duplicate of the descriptor
+ */
+int
+SDL_MapSharedPixels(SDL_Surface * surface, int fd)
+{
+#if HAVE_SHARED_PIXELS
+    const size_t size = (size_t) surface->h * surface->pitch;
+    struct stat st;
+    int seals;
+
+    if (fstat(fd, &st) < 0) {
+        return SDL_SetError("Invalid file descriptor");
+    }
+    if ((Uint64) st.st_size < (Uint64) size) {
+        return SDL_SetError("Shared memory is too small for the surface");
+    }
+    /* Without the seal the other process could truncate the file, and any
+       access to the pixels past its end would crash this one */
+    seals = fcntl(fd, F_GET_SEALS);
+    if (seals < 0 || !(seals & F_SEAL_SHRINK)) {
+        return SDL_SetError("Shared memory isn't sealed against shrinking");
+    }
+#ifdef F_DUPFD_CLOEXEC
+    fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+#else
+    fd = dup(fd);
+#endif
+    if (fd < 0) {
+        return SDL_SetError("Couldn't duplicate file descriptor");
+    }
+    return SDL_MapSharedFD(surface, fd, size);
+#else
+    return SDL_Unsupported();
+#endif
+}
+
+/*
+ * Unmap the pixels of a shared surface and close its file descriptor
+ */
+void
+SDL_FreeSharedPixels(SDL_Surface * surface)
+{
+#if HAVE_SHARED_PIXELS
+    SDL_SharedPixels *shared = surface->map ? surface->map->shared : NULL;
+
+    if (shared) {
+        munmap(surface->pixels, shared->size);
+        close(shared->fd);
+        SDL_free(shared);
+        surface->map->shared = NULL;
+    }
+#endif
+    surface->pixels = NULL;
+}
+
 /*
  * Match an RGB value to a particular palette index
  */
 Uint8
 SDL_FindColor(SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
-    /* Do colorspace distance matching */
-    unsigned int smallest;
-    unsigned int distance;
-    int rd, gd, bd, ad;
-    int i;
-    Uint8 pixel = 0;
+    SDL_PaletteData *data = GetPaletteData(pal);
+    Uint8 pixel;
 
-    smallest = ~0;
-    for (i = 0; i < pal->ncolors; ++i) {
-        rd = pal->colors[i].r - r;
-        gd = pal->colors[i].g - g;
-        bd = pal->colors[i].b - b;
-        ad = pal->colors[i].a - a;
-        distance = (rd * rd) + (gd * gd) + (bd * bd) + (ad * ad);
-        if (distance < smallest) {
-            pixel = i;
-            if (distance == 0) {        /* Perfect match! */
-                break;
-            }
-            smallest = distance;
-        }
+    if (!data) {
+        return LookupColor(pal, NULL, r, g, b, a);
     }
+    SDL_AtomicLock(&data->lock);
+    pixel = LookupColor(pal, GetPaletteLookup(data), r, g, b, a);
+    SDL_AtomicUnlock(&data->lock);
+
     return (pixel);
 }
 
@@ -977,12 +1494,9 @@ SDL_AllocBlitMap(void)
     return (map);
 }
 
-void
-SDL_InvalidateMap(SDL_BlitMap * map)
+static void
+ReleaseMapping(SDL_BlitMap * map)
 {
-    if (!map) {
-        return;
-    }
     if (map->dst) {
         /* Release our reference to the surface - see the note below */
         if (--map->dst->refcount <= 0) {
@@ -994,6 +1508,182 @@ SDL_InvalidateMap(SDL_BlitMap * map)
     map->dst_palette_version = 0;
     SDL_free(map->info.table);
     map->info.table = NULL;
+    map->info.dither = SDL_DITHER_NONE;
+}
+
+static void
+FreeCachedMapping(SDL_BlitMapCacheEntry * entry)
+{
+    if (entry->dst_fmt) {
+        SDL_free(entry->table);
+        if (entry->dst_palette) {
+            SDL_FreePalette(entry->dst_palette);
+        }
+        SDL_FreeFormat(entry->dst_fmt);
+    }
+    SDL_zerop(entry);
+}
+
+/* Park the current mapping so blitting back to a destination of the same
+   format doesn't have to rebuild the translation table and blitter.
+   The entry only references the destination format, not the surface.
+ */
+static void
+CacheMapping(SDL_BlitMap * map)
+{
+    SDL_BlitMapCacheEntry *entry = NULL;
+    SDL_PixelFormat *dstfmt = map->info.dst_fmt;
+    int i;
+
+    if (!map->dst || !map->data || (map->info.flags & SDL_COPY_RLE_MASK)) {
+        return;
+    }
+    if (dstfmt->palette &&
+        map->dst_palette_version != dstfmt->palette->version) {
+        return;
+    }
+
+    /* Use a free slot, or evict the least recently used one */
+    for (i = 0; i < SDL_BLITMAP_CACHE_SIZE; ++i) {
+        if (!map->cache[i].dst_fmt) {
+            entry = &map->cache[i];
+            break;
+        }
+        if (!entry || map->cache[i].last_used < entry->last_used) {
+            entry = &map->cache[i];
+        }
+    }
+    FreeCachedMapping(entry);
+
+    SDL_AtomicLock(&formats_lock);
+    ++dstfmt->refcount;
+    SDL_AtomicUnlock(&formats_lock);
+    entry->dst_fmt = dstfmt;
+    if (dstfmt->palette) {
+        entry->dst_palette = dstfmt->palette;
+        ++entry->dst_palette->refcount;
+    }
+    entry->dst_palette_version = map->dst_palette_version;
+    entry->src_palette_version = map->src_palette_version;
+    entry->flags = map->info.flags;
+    entry->dither = map->info.dither;
+    entry->identity = map->identity;
+    entry->blit = map->blit;
+    entry->data = map->data;
+    entry->table = map->info.table;
+    entry->r = map->info.r;
+    entry->g = map->info.g;
+    entry->b = map->info.b;
+    entry->a = map->info.a;
+    entry->last_used = ++map->cache_clock;
+
+    /* The cache owns the table now */
+    map->info.table = NULL;
+}
+
+/* Pick how RGB colors are reduced to an 8-bit destination palette */
+static SDL_DitherMode
+GetDitherMode(const SDL_BlitMap * map, const SDL_PixelFormat * srcfmt,
+              const SDL_PixelFormat * dstfmt)
+{
+    const char *hint;
+
+    /* Only plain copies have a dithering blitter */
+    if (SDL_ISPIXELFORMAT_INDEXED(srcfmt->format) ||
+        !SDL_ISPIXELFORMAT_INDEXED(dstfmt->format) ||
+        dstfmt->BitsPerPixel != 8 ||
+        (map->info.flags & ~SDL_COPY_RLE_MASK) != 0) {
+        return SDL_DITHER_NONE;
+    }
+
+    hint = SDL_GetHint(SDL_HINT_SURFACE_PALETTE_DITHER);
+    if (!hint || *hint == '0' || SDL_strcasecmp(hint, "none") == 0) {
+        return SDL_DITHER_NONE;
+    } else if (*hint == '1' || SDL_strcasecmp(hint, "nearest") == 0) {
+        return SDL_DITHER_NEAREST;
+    } else if (*hint == '2' || SDL_strcasecmp(hint, "ordered") == 0) {
+        return SDL_DITHER_ORDERED;
+    } else if (*hint == '3' || SDL_strcasecmp(hint, "diffusion") == 0) {
+        return SDL_DITHER_DIFFUSION;
+    }
+    return SDL_DITHER_NONE;
+}
+
+static SDL_bool
+RestoreMapping(SDL_Surface * src, SDL_Surface * dst)
+{
+    SDL_BlitMap *map = src->map;
+    SDL_PixelFormat *dstfmt = dst->format;
+    Uint32 dst_palette_version = dstfmt->palette ? dstfmt->palette->version : 0;
+    Uint32 src_palette_version = src->format->palette ? src->format->palette->version : 0;
+    SDL_DitherMode dither = GetDitherMode(map, src->format, dstfmt);
+    SDL_bool modulated_table = SDL_FALSE;
+    int i;
+
+    if (SDL_ISPIXELFORMAT_INDEXED(src->format->format) &&
+        !SDL_ISPIXELFORMAT_INDEXED(dstfmt->format)) {
+        modulated_table = SDL_TRUE;
+    }
+
+    for (i = 0; i < SDL_BLITMAP_CACHE_SIZE; ++i) {
+        SDL_BlitMapCacheEntry *entry = &map->cache[i];
+
+        if (entry->dst_fmt == dstfmt &&
+            entry->dst_palette == dstfmt->palette &&
+            entry->dst_palette_version == dst_palette_version &&
+            entry->src_palette_version == src_palette_version &&
+            entry->flags == map->info.flags &&
+            entry->dither == dither &&
+            (!modulated_table ||
+             (entry->r == map->info.r && entry->g == map->info.g &&
+              entry->b == map->info.b && entry->a == map->info.a))) {
+            map->dst = dst;
+            ++dst->refcount;
+            map->identity = entry->identity;
+            map->blit = entry->blit;
+            map->data = entry->data;
+            map->info.table = entry->table;
+            map->info.dither = entry->dither;
+            map->info.src_fmt = src->format;
+            map->info.dst_fmt = dstfmt;
+            map->dst_palette_version = dst_palette_version;
+            map->src_palette_version = src_palette_version;
+
+            /* The table moved back to the map, the destination surface
+               keeps the format alive while it is mapped */
+            entry->table = NULL;
+            FreeCachedMapping(entry);
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
+void
+SDL_InvalidateMap(SDL_BlitMap * map)
+{
+    int i;
+
+    if (!map) {
+        return;
+    }
+    ReleaseMapping(map);
+
+    /* The source surface changed, none of the cached mappings apply */
+    for (i = 0; i < SDL_BLITMAP_CACHE_SIZE; ++i) {
+        FreeCachedMapping(&map->cache[i]);
+    }
+}
+
+/* Drop the reference to the destination surface, keeping the mapping
+   cached for the next blit to the same format */
+void
+SDL_ReleaseMap(SDL_BlitMap * map)
+{
+    if (map) {
+        CacheMapping(map);
+        ReleaseMapping(map);
+    }
 }
 
 int
@@ -1003,17 +1693,24 @@ SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst)
     SDL_PixelFormat *dstfmt;
     SDL_BlitMap *map;
 
-    /* Clear out any previous mapping */
+    /* Clear out any previous mapping, keeping it around for later */
     map = src->map;
     if ((src->flags & SDL_RLEACCEL) == SDL_RLEACCEL) {
         SDL_UnRLESurface(src, 1);
     }
-    SDL_InvalidateMap(map);
+    CacheMapping(map);
+    ReleaseMapping(map);
+
+    /* See if we've mapped to this destination format before */
+    if (RestoreMapping(src, dst)) {
+        return 0;
+    }
 
     /* Figure out what kind of mapping we're doing */
     map->identity = 0;
     srcfmt = src->format;
     dstfmt = dst->format;
+    map->info.dither = GetDitherMode(map, srcfmt, dstfmt);
     if (SDL_ISPIXELFORMAT_INDEXED(srcfmt->format)) {
         if (SDL_ISPIXELFORMAT_INDEXED(dstfmt->format)) {
             /* Palette --> Palette */
@@ -1038,7 +1735,11 @@ SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst)
     } else {
         if (SDL_ISPIXELFORMAT_INDEXED(dstfmt->format)) {
             /* BitField --> Palette */
-            map->info.table = MapNto1(srcfmt, dstfmt, &map->identity);
+            if (map->info.dither != SDL_DITHER_NONE) {
+                map->info.table = MapNto1Nearest(dstfmt->palette);
+            } else {
+                map->info.table = MapNto1(srcfmt, dstfmt, &map->identity);
+            }
             if (!map->identity) {
                 if (map->info.table == NULL) {
                     return (-1);
@@ -1087,6 +1788,8 @@ SDL_FreeBlitMap(SDL_BlitMap * map)
 {
     if (map) {
         SDL_InvalidateMap(map);
+        SDL_free(map->stretch_buffer);
+        SDL_FreeSurface(map->stretch_band);
         SDL_free(map);
     }
 }
@@ -24,17 +24,33 @@
 
 #include "SDL_blit.h"
 
+/* The alignment of the pixels and pitch of SDL_SIMD_ALIGNED surfaces */
+#define SDL_SIMD_ALIGNMENT  64
+
+/* The shared memory of a surface, kept in the surface's blit map */
+typedef struct SDL_SharedPixels
+{
+    int fd;
+    size_t size;
+} SDL_SharedPixels;
+
 /* Pixel format functions */
 extern int SDL_InitFormat(SDL_PixelFormat * format, Uint32 pixel_format);
 
 /* Blit mapping functions */
 extern SDL_BlitMap *SDL_AllocBlitMap(void);
 extern void SDL_InvalidateMap(SDL_BlitMap * map);
+extern void SDL_ReleaseMap(SDL_BlitMap * map);
 extern int SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst);
 extern void SDL_FreeBlitMap(SDL_BlitMap * map);
 
 /* Miscellaneous functions */
 extern int SDL_CalculatePitch(SDL_Surface * surface);
+extern void *SDL_AllocSurfacePixels(SDL_Surface * surface);
+extern void SDL_FreeSurfacePixels(SDL_Surface * surface);
+extern int SDL_AllocSharedPixels(SDL_Surface * surface);
+extern int SDL_MapSharedPixels(SDL_Surface * surface, int fd);
+extern void SDL_FreeSharedPixels(SDL_Surface * surface);
 extern void SDL_DitherColors(SDL_Color * colors, int bpp);
 extern Uint8 SDL_FindColor(SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
 
@@ -0,0 +1,441 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#include "SDL_rect.h"
+
+/* Regions are y-x banded rectangles, like X11 and pixman regions.
+   Every operation walks the bands of both operands from top to bottom,
+   combines the spans of each run of rows where neither operand starts or
+   ends a band, and merges the result with the band above when they match.
+ */
+
+struct SDL_Region
+{
+    int count;
+    int capacity;
+    SDL_Rect *rects;
+};
+
+typedef enum
+{
+    SDL_REGION_UNION,
+    SDL_REGION_INTERSECT,
+    SDL_REGION_SUBTRACT
+} SDL_RegionOp;
+
+#define REGION_END  0x7FFFFFFF
+
+static SDL_bool
+GrowRegion(SDL_Region * region, int count)
+{
+    if (region->count + count > region->capacity) {
+        int capacity = SDL_max(region->capacity * 2, region->count + count);
+        SDL_Rect *rects;
+
+        capacity = SDL_max(capacity, 8);
+        rects = (SDL_Rect *) SDL_realloc(region->rects, capacity * sizeof(*rects));
+        if (!rects) {
+            return SDL_FALSE;
+        }
+        region->rects = rects;
+        region->capacity = capacity;
+    }
+    return SDL_TRUE;
+}
+
+/* The index after the band starting at rects[i] */
+static int
+BandEnd(const SDL_Rect * rects, int count, int i)
+{
+    const int y = (i < count) ? rects[i].y : 0;
+
+    while (i < count && rects[i].y == y) {
+        ++i;
+    }
+    return i;
+}
+
+static SDL_bool
+InResult(SDL_RegionOp op, SDL_bool in_a, SDL_bool in_b)
+{
+    switch (op) {
+    case SDL_REGION_UNION:
+        return (in_a || in_b);
+    case SDL_REGION_INTERSECT:
+        return (in_a && in_b);
+    default:
+        return (in_a && !in_b);
+    }
+}
+
+/* Combine the spans of two bands into a band of rows y to y + h */
+static SDL_bool
+AddBand(SDL_Region * out, int *prev_band, SDL_RegionOp op, int y, int h,
+        const SDL_Rect * a, int na, const SDL_Rect * b, int nb)
+{
+    const int band = out->count;
+    SDL_bool in_a = SDL_FALSE;
+    SDL_bool in_b = SDL_FALSE;
+    int i = 0, j = 0;
+    int start = 0;
+    int n;
+
+    /* Walk the span edges of both bands from left to right */
+    while (i < 2 * na || j < 2 * nb) {
+        const int xa = (i < 2 * na) ? a[i / 2].x + ((i & 1) ? a[i / 2].w : 0) : REGION_END;
+        const int xb = (j < 2 * nb) ? b[j / 2].x + ((j & 1) ? b[j / 2].w : 0) : REGION_END;
+        const int x = SDL_min(xa, xb);
+        const SDL_bool was_in = InResult(op, in_a, in_b);
+        SDL_bool is_in;
+
+        if (xa == x) {
+            in_a = !in_a;
+            ++i;
+        }
+        if (xb == x) {
+            in_b = !in_b;
+            ++j;
+        }
+        is_in = InResult(op, in_a, in_b);
+
+        if (!was_in && is_in) {
+            start = x;
+        } else if (was_in && !is_in) {
+            SDL_Rect *rect;
+
+            if (!GrowRegion(out, 1)) {
+                return SDL_FALSE;
+            }
+            rect = &out->rects[out->count++];
+            rect->x = start;
+            rect->y = y;
+            rect->w = x - start;
+            rect->h = h;
+        }
+    }
+
+    /* Extend the band above instead if it has the same spans */
+    n = out->count - band;
+    if (n == 0) {
+        return SDL_TRUE;
+    }
+    if (*prev_band >= 0 && band - *prev_band == n &&
+        out->rects[*prev_band].y + out->rects[*prev_band].h == y) {
+        for (i = 0; i < n; ++i) {
+            const SDL_Rect *above = &out->rects[*prev_band + i];
+            const SDL_Rect *rect = &out->rects[band + i];
+            if (above->x != rect->x || above->w != rect->w) {
+                break;
+            }
+        }
+        if (i == n) {
+            for (i = 0; i < n; ++i) {
+                out->rects[*prev_band + i].h += h;
+            }
+            out->count = band;
+            return SDL_TRUE;
+        }
+    }
+    *prev_band = band;
+    return SDL_TRUE;
+}
+
+/* Replace the region with the result of combining two sets of banded rectangles */
+static int
+RegionOp(SDL_Region * region, SDL_RegionOp op,
+         const SDL_Rect * a, int na, const SDL_Rect * b, int nb)
+{
+    SDL_Region out;
+    int prev_band = -1;
+    int ia = 0, ib = 0;
+    int y;
+
+    SDL_zero(out);
+    y = SDL_min(na > 0 ? a[0].y : REGION_END, nb > 0 ? b[0].y : REGION_END);
+
+    while (ia < na || ib < nb) {
+        const int ea = BandEnd(a, na, ia);
+        const int eb = BandEnd(b, nb, ib);
+        const SDL_bool has_a = (ia < na && a[ia].y <= y);
+        const SDL_bool has_b = (ib < nb && b[ib].y <= y);
+        int next = REGION_END;
+
+        /* Nothing more can come out of these once an operand runs out */
+        if ((op == SDL_REGION_INTERSECT && (ia == na || ib == nb)) ||
+            (op == SDL_REGION_SUBTRACT && ia == na)) {
+            break;
+        }
+
+        /* The rows until either operand starts or ends a band */
+        if (ia < na) {
+            next = SDL_min(next, has_a ? a[ia].y + a[ia].h : a[ia].y);
+        }
+        if (ib < nb) {
+            next = SDL_min(next, has_b ? b[ib].y + b[ib].h : b[ib].y);
+        }
+
+        if ((has_a || has_b) &&
+            !AddBand(&out, &prev_band, op, y, next - y,
+                     &a[ia], has_a ? ea - ia : 0, &b[ib], has_b ? eb - ib : 0)) {
+            SDL_free(out.rects);
+            return SDL_OutOfMemory();
+        }
+
+        y = next;
+        if (has_a && a[ia].y + a[ia].h == y) {
+            ia = ea;
+        }
+        if (has_b && b[ib].y + b[ib].h == y) {
+            ib = eb;
+        }
+    }
+
+    SDL_free(region->rects);
+    *region = out;
+    return 0;
+}
+
+/* Build the union of a set of rectangles, merging halves of similar size */
+static int
+BuildRegion(SDL_Region * region, const SDL_Rect * rects, int count)
+{
+    SDL_Region half;
+    int status;
+
+    if (count == 1) {
+        if (SDL_RectEmpty(rects)) {
+            region->count = 0;
+            return 0;
+        }
+        if (!GrowRegion(region, 1)) {
+            return SDL_OutOfMemory();
+        }
+        region->rects[0] = rects[0];
+        region->count = 1;
+        return 0;
+    }
+
+    SDL_zero(half);
+    status = BuildRegion(region, rects, count / 2);
+    if (status == 0) {
+        status = BuildRegion(&half, rects + count / 2, count - count / 2);
+    }
+    if (status == 0) {
+        status = RegionOp(region, SDL_REGION_UNION, region->rects, region->count,
+                          half.rects, half.count);
+    }
+    SDL_free(half.rects);
+    return status;
+}
+
+SDL_Region *
+SDL_CreateRegion(void)
+{
+    SDL_Region *region = (SDL_Region *) SDL_calloc(1, sizeof(*region));
+
+    if (!region) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    return region;
+}
+
+void
+SDL_FreeRegion(SDL_Region * region)
+{
+    if (region) {
+        SDL_free(region->rects);
+        SDL_free(region);
+    }
+}
+
+void
+SDL_ClearRegion(SDL_Region * region)
+{
+    if (region) {
+        region->count = 0;
+    }
+}
+
+int
+SDL_UnionRegion(SDL_Region * region, const SDL_Region * other)
+{
+    if (!region) {
+        return SDL_InvalidParamError("region");
+    }
+    if (!other) {
+        return SDL_InvalidParamError("other");
+    }
+    if (other->count == 0) {
+        return 0;
+    }
+    return RegionOp(region, SDL_REGION_UNION, region->rects, region->count,
+                    other->rects, other->count);
+}
+
+int
+SDL_UnionRegionRects(SDL_Region * region, const SDL_Rect * rects, int count)
+{
+    SDL_Region added;
+    int status;
+
+    if (!region) {
+        return SDL_InvalidParamError("region");
+    }
+    if (count <= 0) {
+        return 0;
+    }
+    if (!rects) {
+        return SDL_InvalidParamError("rects");
+    }
+
+    SDL_zero(added);
+    status = BuildRegion(&added, rects, count);
+    if (status == 0 && added.count > 0) {
+        status = RegionOp(region, SDL_REGION_UNION, region->rects, region->count,
+                          added.rects, added.count);
+    }
+    SDL_free(added.rects);
+    return status;
+}
+
+int
+SDL_IntersectRegion(SDL_Region * region, const SDL_Region * other)
+{
+    if (!region) {
+        return SDL_InvalidParamError("region");
+    }
+    if (!other) {
+        return SDL_InvalidParamError("other");
+    }
+    return RegionOp(region, SDL_REGION_INTERSECT, region->rects, region->count,
+                    other->rects, other->count);
+}
+
+int
+SDL_IntersectRegionRect(SDL_Region * region, const SDL_Rect * rect)
+{
+    if (!region) {
+        return SDL_InvalidParamError("region");
+    }
+    if (!rect) {
+        return SDL_InvalidParamError("rect");
+    }
+    if (SDL_RectEmpty(rect)) {
+        region->count = 0;
+        return 0;
+    }
+    return RegionOp(region, SDL_REGION_INTERSECT, region->rects, region->count,
+                    rect, 1);
+}
+
+int
+SDL_SubtractRegion(SDL_Region * region, const SDL_Region * other)
+{
+    if (!region) {
+        return SDL_InvalidParamError("region");
+    }
+    if (!other) {
+        return SDL_InvalidParamError("other");
+    }
+    if (other->count == 0) {
+        return 0;
+    }
+    return RegionOp(region, SDL_REGION_SUBTRACT, region->rects, region->count,
+                    other->rects, other->count);
+}
+
+int
+SDL_SubtractRegionRect(SDL_Region * region, const SDL_Rect * rect)
+{
+    if (!region) {
+        return SDL_InvalidParamError("region");
+    }
+    if (!rect) {
+        return SDL_InvalidParamError("rect");
+    }
+    if (SDL_RectEmpty(rect)) {
+        return 0;
+    }
+    return RegionOp(region, SDL_REGION_SUBTRACT, region->rects, region->count,
+                    rect, 1);
+}
+
+void
+SDL_TranslateRegion(SDL_Region * region, int dx, int dy)
+{
+    int i;
+
+    if (!region) {
+        return;
+    }
+    for (i = 0; i < region->count; ++i) {
+        region->rects[i].x += dx;
+        region->rects[i].y += dy;
+    }
+}
+
+const SDL_Rect *
+SDL_GetRegionRects(const SDL_Region * region, int *count)
+{
+    if (!region) {
+        SDL_InvalidParamError("region");
+        if (count) {
+            *count = 0;
+        }
+        return NULL;
+    }
+    if (count) {
+        *count = region->count;
+    }
+    return (region->count > 0) ? region->rects : NULL;
+}
+
+SDL_bool
+SDL_GetRegionBounds(const SDL_Region * region, SDL_Rect * bounds)
+{
+    const SDL_Rect *last;
+    int x0, x1;
+    int i;
+
+    if (!region || region->count == 0) {
+        return SDL_FALSE;
+    }
+
+    /* The first and last bands give the rows, every band has its own columns */
+    last = &region->rects[region->count - 1];
+    x0 = region->rects[0].x;
+    x1 = region->rects[0].x + region->rects[0].w;
+    for (i = 1; i < region->count; ++i) {
+        x0 = SDL_min(x0, region->rects[i].x);
+        x1 = SDL_max(x1, region->rects[i].x + region->rects[i].w);
+    }
+    if (bounds) {
+        bounds->x = x0;
+        bounds->y = region->rects[0].y;
+        bounds->w = x1 - x0;
+        bounds->h = last->y + last->h - bounds->y;
+    }
+    return SDL_TRUE;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -27,7 +27,10 @@
 */
 
 #include "SDL_video.h"
+#include "SDL_cpuinfo.h"
 #include "SDL_blit.h"
+#include "SDL_pixels_c.h"
+#include "../SDL_simd.h"
 
 /* This isn't ready for general consumption yet - it should be folded
    into the general blitting mechanism.
@@ -350,4 +353,777 @@ SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
     return (0);
 }
 
+/* Filtered stretching of 32-bit surfaces with 8 bits per channel.
+
+   Linear filtering scales the source rows horizontally into 16-bit values
+   (channel * 256), keeps the last two of them and blends them vertically.
+   Box filtering, used by "best" quality when shrinking, adds up the source
+   rows covered by each destination row with 12-bit weights into 15-bit
+   values (channel * 128), and then the covered columns the same way.
+
+   The sampling positions are always those of the whole destination
+   rectangle, so clipping it doesn't change the pixels that are drawn.
+*/
+
+#define STRETCH_BOX_BITS    12
+
+/* Rows converted at a time when the stretched pixels have to be blitted */
+#define STRETCH_BAND_ROWS   16
+
+typedef void (*SDL_StretchHLinearFunc) (const Uint8 *src, Uint16 *dst, const int *x0, const int *x1,
+                                        const Uint16 *weights, int width);
+typedef void (*SDL_StretchVLinearFunc) (const Uint16 *src0, const Uint16 *src1, Uint8 *dst,
+                                        int count, int weight);
+typedef void (*SDL_StretchVBoxFunc) (const Uint8 **rows, const Uint16 *weights, int num_rows,
+                                     Uint16 *dst, int count);
+typedef void (*SDL_StretchHBoxFunc) (const Uint16 *src, Uint8 *dst, const int *first, const int *num_taps,
+                                     const Uint16 *weights, int max_taps, int width);
+
+typedef struct
+{
+    SDL_bool box;
+    int width;                  /* clipped destination width */
+    const Uint8 *pixels;        /* first pixel of the source rectangle */
+    int pitch;
+    int src_w, src_h;
+    int dst_w, dst_h;
+    int dst_x;                  /* first clipped column, relative to the rectangle */
+
+    /* Linear filtering */
+    int *x0, *x1;               /* byte offsets of the two source pixels */
+    Uint16 *xweights;           /* weight of the second one, for each channel */
+    Uint16 *rows[2];            /* horizontally scaled source rows */
+    int row_y[2];               /* which source rows those are, -1 if none */
+    SDL_StretchHLinearFunc HLinear;
+    SDL_StretchVLinearFunc VLinear;
+
+    /* Box filtering */
+    int *first, *num_taps;      /* covered columns, relative to sum_x */
+    int max_taps;
+    int sum_x, sum_w;           /* source columns added up for each row */
+    Uint16 *sum;
+    const Uint8 **src_rows;
+    Uint16 *yweights;
+    SDL_StretchVBoxFunc VBox;
+    SDL_StretchHBoxFunc HBox;
+} SDL_StretchFilter;
+
+/* Get the source pixels and weight of the second one for a linear sample */
+static void
+GetLinearSample(int i, int src_len, int dst_len, int *p0, int *p1, int *weight)
+{
+    Sint64 pos = ((Sint64) (2 * i + 1) * src_len * 0x10000) / (2 * dst_len) - 0x8000;
+
+    if (pos < 0) {
+        pos = 0;
+    }
+    *p0 = (int) (pos >> 16);
+    *weight = (int) ((pos >> 8) & 0xFF);
+    if (*p0 >= src_len - 1) {
+        *p0 = src_len - 1;
+        *p1 = *p0;
+        *weight = 0;
+    } else {
+        *p1 = *p0 + 1;
+    }
+}
+
+/* Get the source pixels covered by a box sample, the weights add up to
+   1 << STRETCH_BOX_BITS */
+static int
+GetBoxSample(int i, int src_len, int dst_len, int *first, Uint16 *weights)
+{
+    const Sint64 start = (Sint64) i * src_len;
+    const Sint64 end = start + src_len;
+    int j = (int) (start / dst_len);
+    const int last = (int) ((end - 1) / dst_len);
+    int count = 0, sum = 0, max_tap = 0;
+
+    *first = j;
+    for (; j <= last; ++j) {
+        const Sint64 lo = SDL_max(start, (Sint64) j * dst_len);
+        const Sint64 hi = SDL_min(end, (Sint64) (j + 1) * dst_len);
+        const int weight = (int) (((hi - lo) << STRETCH_BOX_BITS) / src_len);
+
+        weights[count] = (Uint16) weight;
+        if (weight > weights[max_tap]) {
+            max_tap = count;
+        }
+        sum += weight;
+        ++count;
+    }
+    weights[max_tap] += (Uint16) ((1 << STRETCH_BOX_BITS) - sum);
+    return count;
+}
+
+static void
+StretchHLinear(const Uint8 *src, Uint16 *dst, const int *x0, const int *x1,
+               const Uint16 *weights, int width)
+{
+    int i, c;
+
+    for (i = 0; i < width; ++i) {
+        const Uint8 *p0 = src + x0[i];
+        const Uint8 *p1 = src + x1[i];
+        const int w1 = weights[i * 4];
+        const int w0 = 256 - w1;
+
+        for (c = 0; c < 4; ++c) {
+            *dst++ = (Uint16) (p0[c] * w0 + p1[c] * w1);
+        }
+    }
+}
+
+static void
+StretchVLinear(const Uint16 *src0, const Uint16 *src1, Uint8 *dst, int count, int weight)
+{
+    const int w0 = 256 - weight;
+    int i;
+
+    if (weight == 0) {
+        for (i = 0; i < count; ++i) {
+            dst[i] = (Uint8) ((src0[i] + 128) >> 8);
+        }
+    } else {
+        for (i = 0; i < count; ++i) {
+            dst[i] = (Uint8) ((((src0[i] * w0) >> 8) + ((src1[i] * weight) >> 8) + 128) >> 8);
+        }
+    }
+}
+
+static void
+StretchVBoxRange(const Uint8 **rows, const Uint16 *weights, int num_rows, Uint16 *dst, int i, int count)
+{
+    int r;
+
+    for (; i < count; ++i) {
+        Uint32 sum = 0;
+        for (r = 0; r < num_rows; ++r) {
+            sum += rows[r][i] * weights[r];
+        }
+        dst[i] = (Uint16) ((sum + 16) >> 5);
+    }
+}
+
+static void
+StretchVBox(const Uint8 **rows, const Uint16 *weights, int num_rows, Uint16 *dst, int count)
+{
+    StretchVBoxRange(rows, weights, num_rows, dst, 0, count);
+}
+
+static void
+StretchHBox(const Uint16 *src, Uint8 *dst, const int *first, const int *num_taps,
+            const Uint16 *weights, int max_taps, int width)
+{
+    int i, t, c;
+
+    for (i = 0; i < width; ++i, weights += max_taps) {
+        const Uint16 *p = src + first[i] * 4;
+        Uint32 sum[4] = { 0, 0, 0, 0 };
+
+        for (t = 0; t < num_taps[i]; ++t, p += 4) {
+            for (c = 0; c < 4; ++c) {
+                sum[c] += p[c] * weights[t];
+            }
+        }
+        for (c = 0; c < 4; ++c) {
+            *dst++ = (Uint8) ((sum[c] + (1 << 18)) >> 19);
+        }
+    }
+}
+
+#if HAVE_SSE2_INTRINSICS
+static void
+StretchHLinearSSE2(const Uint8 *src, Uint16 *dst, const int *x0, const int *x1,
+                   const Uint16 *weights, int width)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(256);
+    int i;
+
+    for (i = 0; i + 2 <= width; i += 2) {
+        __m128i p0 = _mm_unpacklo_epi32(_mm_cvtsi32_si128(*(const int *) (src + x0[i])),
+                                        _mm_cvtsi32_si128(*(const int *) (src + x0[i + 1])));
+        __m128i p1 = _mm_unpacklo_epi32(_mm_cvtsi32_si128(*(const int *) (src + x1[i])),
+                                        _mm_cvtsi32_si128(*(const int *) (src + x1[i + 1])));
+        const __m128i w1 = _mm_loadu_si128((const __m128i *) (weights + i * 4));
+        const __m128i w0 = _mm_sub_epi16(one, w1);
+
+        p0 = _mm_mullo_epi16(_mm_unpacklo_epi8(p0, zero), w0);
+        p1 = _mm_mullo_epi16(_mm_unpacklo_epi8(p1, zero), w1);
+        _mm_storeu_si128((__m128i *) (dst + i * 4), _mm_add_epi16(p0, p1));
+    }
+    if (i < width) {
+        StretchHLinear(src, dst + i * 4, x0 + i, x1 + i, weights + i * 4, width - i);
+    }
+}
+
+static void
+StretchVLinearSSE2(const Uint16 *src0, const Uint16 *src1, Uint8 *dst, int count, int weight)
+{
+    const __m128i round = _mm_set1_epi16(128);
+    const __m128i m0 = _mm_set1_epi16((short) ((256 - weight) << 8));
+    const __m128i m1 = _mm_set1_epi16((short) (weight << 8));
+    int i;
+
+    if (weight == 0) {
+        for (i = 0; i + 16 <= count; i += 16) {
+            __m128i a = _mm_loadu_si128((const __m128i *) (src0 + i));
+            __m128i b = _mm_loadu_si128((const __m128i *) (src0 + i + 8));
+            a = _mm_srli_epi16(_mm_add_epi16(a, round), 8);
+            b = _mm_srli_epi16(_mm_add_epi16(b, round), 8);
+            _mm_storeu_si128((__m128i *) (dst + i), _mm_packus_epi16(a, b));
+        }
+    } else {
+        for (i = 0; i + 16 <= count; i += 16) {
+            __m128i a = _mm_add_epi16(_mm_mulhi_epu16(_mm_loadu_si128((const __m128i *) (src0 + i)), m0),
+                                      _mm_mulhi_epu16(_mm_loadu_si128((const __m128i *) (src1 + i)), m1));
+            __m128i b = _mm_add_epi16(_mm_mulhi_epu16(_mm_loadu_si128((const __m128i *) (src0 + i + 8)), m0),
+                                      _mm_mulhi_epu16(_mm_loadu_si128((const __m128i *) (src1 + i + 8)), m1));
+            a = _mm_srli_epi16(_mm_add_epi16(a, round), 8);
+            b = _mm_srli_epi16(_mm_add_epi16(b, round), 8);
+            _mm_storeu_si128((__m128i *) (dst + i), _mm_packus_epi16(a, b));
+        }
+    }
+    if (i < count) {
+        StretchVLinear(src0 + i, src1 + i, dst + i, count - i, weight);
+    }
+}
+
+static void
+StretchVBoxSSE2(const Uint8 **rows, const Uint16 *weights, int num_rows, Uint16 *dst, int count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi32(16);
+    int i, r;
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        __m128i sum0 = round, sum1 = round, sum2 = round, sum3 = round;
+
+        /* Add up two rows at a time, interleaved for the multiply-add */
+        for (r = 0; r < num_rows; r += 2) {
+            const int r1 = (r + 1 < num_rows) ? r + 1 : r;
+            const int w1 = (r + 1 < num_rows) ? weights[r + 1] : 0;
+            const __m128i w = _mm_set1_epi32(weights[r] | (w1 << 16));
+            const __m128i a = _mm_loadu_si128((const __m128i *) (rows[r] + i));
+            const __m128i b = _mm_loadu_si128((const __m128i *) (rows[r1] + i));
+            const __m128i lo = _mm_unpacklo_epi8(a, b);
+            const __m128i hi = _mm_unpackhi_epi8(a, b);
+
+            sum0 = _mm_add_epi32(sum0, _mm_madd_epi16(_mm_unpacklo_epi8(lo, zero), w));
+            sum1 = _mm_add_epi32(sum1, _mm_madd_epi16(_mm_unpackhi_epi8(lo, zero), w));
+            sum2 = _mm_add_epi32(sum2, _mm_madd_epi16(_mm_unpacklo_epi8(hi, zero), w));
+            sum3 = _mm_add_epi32(sum3, _mm_madd_epi16(_mm_unpackhi_epi8(hi, zero), w));
+        }
+        sum0 = _mm_packs_epi32(_mm_srli_epi32(sum0, 5), _mm_srli_epi32(sum1, 5));
+        sum2 = _mm_packs_epi32(_mm_srli_epi32(sum2, 5), _mm_srli_epi32(sum3, 5));
+        _mm_storeu_si128((__m128i *) (dst + i), sum0);
+        _mm_storeu_si128((__m128i *) (dst + i + 8), sum2);
+    }
+    StretchVBoxRange(rows, weights, num_rows, dst, i, count);
+}
+
+static void
+StretchHBoxSSE2(const Uint16 *src, Uint8 *dst, const int *first, const int *num_taps,
+                const Uint16 *weights, int max_taps, int width)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi32(1 << 18);
+    int i, t;
+
+    for (i = 0; i < width; ++i, weights += max_taps) {
+        const Uint16 *p = src + first[i] * 4;
+        __m128i sum = round;
+
+        for (t = 0; t < num_taps[i]; ++t, p += 4) {
+            const __m128i v = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *) p), zero);
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(v, _mm_set1_epi32(weights[t])));
+        }
+        sum = _mm_srli_epi32(sum, 19);
+        sum = _mm_packs_epi32(sum, sum);
+        *(Uint32 *) (dst + i * 4) = (Uint32) _mm_cvtsi128_si32(_mm_packus_epi16(sum, sum));
+    }
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_AVX2_INTRINSICS
+static void SDL_TARGETING_AVX2
+StretchHLinearAVX2(const Uint8 *src, Uint16 *dst, const int *x0, const int *x1,
+                   const Uint16 *weights, int width)
+{
+    const __m256i one = _mm256_set1_epi16(256);
+    int i;
+
+    for (i = 0; i + 4 <= width; i += 4) {
+        const __m128i a = _mm_set_epi32(*(const int *) (src + x0[i + 3]), *(const int *) (src + x0[i + 2]),
+                                        *(const int *) (src + x0[i + 1]), *(const int *) (src + x0[i]));
+        const __m128i b = _mm_set_epi32(*(const int *) (src + x1[i + 3]), *(const int *) (src + x1[i + 2]),
+                                        *(const int *) (src + x1[i + 1]), *(const int *) (src + x1[i]));
+        const __m256i w1 = _mm256_loadu_si256((const __m256i *) (weights + i * 4));
+        const __m256i w0 = _mm256_sub_epi16(one, w1);
+        const __m256i p0 = _mm256_mullo_epi16(_mm256_cvtepu8_epi16(a), w0);
+        const __m256i p1 = _mm256_mullo_epi16(_mm256_cvtepu8_epi16(b), w1);
+
+        _mm256_storeu_si256((__m256i *) (dst + i * 4), _mm256_add_epi16(p0, p1));
+    }
+    if (i < width) {
+        StretchHLinear(src, dst + i * 4, x0 + i, x1 + i, weights + i * 4, width - i);
+    }
+}
+
+static void SDL_TARGETING_AVX2
+StretchVLinearAVX2(const Uint16 *src0, const Uint16 *src1, Uint8 *dst, int count, int weight)
+{
+    const __m256i round = _mm256_set1_epi16(128);
+    const __m256i m0 = _mm256_set1_epi16((short) ((256 - weight) << 8));
+    const __m256i m1 = _mm256_set1_epi16((short) (weight << 8));
+    int i;
+
+    if (weight == 0) {
+        for (i = 0; i + 32 <= count; i += 32) {
+            __m256i a = _mm256_loadu_si256((const __m256i *) (src0 + i));
+            __m256i b = _mm256_loadu_si256((const __m256i *) (src0 + i + 16));
+            a = _mm256_srli_epi16(_mm256_add_epi16(a, round), 8);
+            b = _mm256_srli_epi16(_mm256_add_epi16(b, round), 8);
+            /* The pack works within the 128-bit lanes, put them back in order */
+            _mm256_storeu_si256((__m256i *) (dst + i),
+                                _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8));
+        }
+    } else {
+        for (i = 0; i + 32 <= count; i += 32) {
+            __m256i a = _mm256_add_epi16(_mm256_mulhi_epu16(_mm256_loadu_si256((const __m256i *) (src0 + i)), m0),
+                                         _mm256_mulhi_epu16(_mm256_loadu_si256((const __m256i *) (src1 + i)), m1));
+            __m256i b = _mm256_add_epi16(_mm256_mulhi_epu16(_mm256_loadu_si256((const __m256i *) (src0 + i + 16)), m0),
+                                         _mm256_mulhi_epu16(_mm256_loadu_si256((const __m256i *) (src1 + i + 16)), m1));
+            a = _mm256_srli_epi16(_mm256_add_epi16(a, round), 8);
+            b = _mm256_srli_epi16(_mm256_add_epi16(b, round), 8);
+            _mm256_storeu_si256((__m256i *) (dst + i),
+                                _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8));
+        }
+    }
+    if (i < count) {
+        StretchVLinear(src0 + i, src1 + i, dst + i, count - i, weight);
+    }
+}
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+static void
+StretchHLinearNEON(const Uint8 *src, Uint16 *dst, const int *x0, const int *x1,
+                   const Uint16 *weights, int width)
+{
+    const uint16x8_t one = vdupq_n_u16(256);
+    int i;
+
+    for (i = 0; i + 2 <= width; i += 2) {
+        uint32x2_t a = vdup_n_u32(*(const Uint32 *) (src + x0[i]));
+        uint32x2_t b = vdup_n_u32(*(const Uint32 *) (src + x1[i]));
+        const uint16x8_t w1 = vld1q_u16(weights + i * 4);
+        const uint16x8_t w0 = vsubq_u16(one, w1);
+        uint16x8_t h;
+
+        a = vset_lane_u32(*(const Uint32 *) (src + x0[i + 1]), a, 1);
+        b = vset_lane_u32(*(const Uint32 *) (src + x1[i + 1]), b, 1);
+        h = vmulq_u16(vmovl_u8(vreinterpret_u8_u32(a)), w0);
+        h = vmlaq_u16(h, vmovl_u8(vreinterpret_u8_u32(b)), w1);
+        vst1q_u16(dst + i * 4, h);
+    }
+    if (i < width) {
+        StretchHLinear(src, dst + i * 4, x0 + i, x1 + i, weights + i * 4, width - i);
+    }
+}
+
+static void
+StretchVLinearNEON(const Uint16 *src0, const Uint16 *src1, Uint8 *dst, int count, int weight)
+{
+    const uint16_t w0 = (uint16_t) (256 - weight);
+    const uint16_t w1 = (uint16_t) weight;
+    int i;
+
+    if (weight == 0) {
+        for (i = 0; i + 16 <= count; i += 16) {
+            const uint8x8_t a = vrshrn_n_u16(vld1q_u16(src0 + i), 8);
+            const uint8x8_t b = vrshrn_n_u16(vld1q_u16(src0 + i + 8), 8);
+            vst1q_u8(dst + i, vcombine_u8(a, b));
+        }
+    } else {
+        for (i = 0; i + 16 <= count; i += 16) {
+            const uint16x8_t a0 = vld1q_u16(src0 + i), a1 = vld1q_u16(src1 + i);
+            const uint16x8_t b0 = vld1q_u16(src0 + i + 8), b1 = vld1q_u16(src1 + i + 8);
+            uint16x8_t a, b;
+
+            a = vaddq_u16(vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(a0), w0), 8),
+                                       vshrn_n_u32(vmull_n_u16(vget_high_u16(a0), w0), 8)),
+                          vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(a1), w1), 8),
+                                       vshrn_n_u32(vmull_n_u16(vget_high_u16(a1), w1), 8)));
+            b = vaddq_u16(vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(b0), w0), 8),
+                                       vshrn_n_u32(vmull_n_u16(vget_high_u16(b0), w0), 8)),
+                          vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(b1), w1), 8),
+                                       vshrn_n_u32(vmull_n_u16(vget_high_u16(b1), w1), 8)));
+            vst1q_u8(dst + i, vcombine_u8(vrshrn_n_u16(a, 8), vrshrn_n_u16(b, 8)));
+        }
+    }
+    if (i < count) {
+        StretchVLinear(src0 + i, src1 + i, dst + i, count - i, weight);
+    }
+}
+
+static void
+StretchVBoxNEON(const Uint8 **rows, const Uint16 *weights, int num_rows, Uint16 *dst, int count)
+{
+    int i, r;
+
+    for (i = 0; i + 8 <= count; i += 8) {
+        uint32x4_t sum0 = vdupq_n_u32(0), sum1 = vdupq_n_u32(0);
+
+        for (r = 0; r < num_rows; ++r) {
+            const uint16x8_t v = vmovl_u8(vld1_u8(rows[r] + i));
+            sum0 = vmlal_n_u16(sum0, vget_low_u16(v), weights[r]);
+            sum1 = vmlal_n_u16(sum1, vget_high_u16(v), weights[r]);
+        }
+        vst1q_u16(dst + i, vcombine_u16(vrshrn_n_u32(sum0, 5), vrshrn_n_u32(sum1, 5)));
+    }
+    StretchVBoxRange(rows, weights, num_rows, dst, i, count);
+}
+
+static void
+StretchHBoxNEON(const Uint16 *src, Uint8 *dst, const int *first, const int *num_taps,
+                const Uint16 *weights, int max_taps, int width)
+{
+    int i, t;
+
+    for (i = 0; i < width; ++i, weights += max_taps) {
+        const Uint16 *p = src + first[i] * 4;
+        uint32x4_t sum = vdupq_n_u32(0);
+        uint16x4_t v;
+
+        for (t = 0; t < num_taps[i]; ++t, p += 4) {
+            sum = vmlal_n_u16(sum, vld1_u16(p), weights[t]);
+        }
+        v = vmovn_u32(vrshrq_n_u32(sum, 19));
+        vst1_lane_u32((uint32_t *) (dst + i * 4), vreinterpret_u32_u8(vmovn_u16(vcombine_u16(v, v))), 0);
+    }
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
+/* Get at least len bytes of scratch memory, kept on the source surface's
+   blit map so repeated stretches don't allocate */
+static void *
+GetStretchBuffer(SDL_Surface * src, size_t len)
+{
+    SDL_BlitMap *map = src->map;
+
+    if (len > map->stretch_buffer_len) {
+        SDL_free(map->stretch_buffer);
+        map->stretch_buffer_len = 0;
+        map->stretch_buffer = SDL_malloc(len);
+        if (!map->stretch_buffer) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        map->stretch_buffer_len = len;
+    }
+    return map->stretch_buffer;
+}
+
+/* Get a surface of the source format for stretching bands of rows into,
+   kept on the source surface's blit map */
+static SDL_Surface *
+GetStretchBand(SDL_Surface * src, int w, int h)
+{
+    SDL_BlitMap *map = src->map;
+    SDL_Surface *band = map->stretch_band;
+
+    if (!band || band->format->format != src->format->format || band->w < w || band->h < h) {
+        if (band) {
+            w = SDL_max(w, band->w);
+            h = SDL_max(h, band->h);
+            SDL_FreeSurface(band);
+        }
+        band = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, src->format->format);
+        map->stretch_band = band;
+    }
+    return band;
+}
+
+static int
+SetupStretchFilter(SDL_StretchFilter * filter, SDL_Surface * src, const SDL_Rect * srcrect,
+                   const SDL_Rect * dstrect, int dst_x, int width, SDL_ScaleQuality quality)
+{
+    int i;
+
+    SDL_zerop(filter);
+    filter->box = (quality == SDL_SCALEQUALITY_BEST &&
+                   dstrect->w <= srcrect->w && dstrect->h <= srcrect->h);
+    filter->width = width;
+    filter->pixels = (const Uint8 *) src->pixels + srcrect->y * src->pitch + srcrect->x * 4;
+    filter->pitch = src->pitch;
+    filter->src_w = srcrect->w;
+    filter->src_h = srcrect->h;
+    filter->dst_w = dstrect->w;
+    filter->dst_h = dstrect->h;
+    filter->dst_x = dst_x;
+
+    if (!filter->box) {
+        const size_t row_size = width * 4 * sizeof(Uint16);
+
+        filter->x0 = (int *) GetStretchBuffer(src, width * 2 * sizeof(int) + row_size * 3);
+        if (!filter->x0) {
+            return -1;
+        }
+        filter->x1 = filter->x0 + width;
+        filter->xweights = (Uint16 *) (filter->x1 + width);
+        filter->rows[0] = filter->xweights + width * 4;
+        filter->rows[1] = filter->rows[0] + width * 4;
+        filter->row_y[0] = filter->row_y[1] = -1;
+
+        for (i = 0; i < width; ++i) {
+            int p0, p1, weight;
+
+            GetLinearSample(dst_x + i, filter->src_w, filter->dst_w, &p0, &p1, &weight);
+            filter->x0[i] = p0 * 4;
+            filter->x1[i] = p1 * 4;
+            filter->xweights[i * 4 + 0] = filter->xweights[i * 4 + 1] =
+                filter->xweights[i * 4 + 2] = filter->xweights[i * 4 + 3] = (Uint16) weight;
+        }
+
+        filter->HLinear = StretchHLinear;
+        filter->VLinear = StretchVLinear;
+#if HAVE_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            filter->HLinear = StretchHLinearSSE2;
+            filter->VLinear = StretchVLinearSSE2;
+        }
+#endif
+#if HAVE_AVX2_INTRINSICS
+        if (SDL_HasAVX2()) {
+            filter->HLinear = StretchHLinearAVX2;
+            filter->VLinear = StretchVLinearAVX2;
+        }
+#endif
+#if HAVE_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            filter->HLinear = StretchHLinearNEON;
+            filter->VLinear = StretchVLinearNEON;
+        }
+#endif
+    } else {
+        const int max_xtaps = (filter->src_w + filter->dst_w - 1) / filter->dst_w + 1;
+        const int max_ytaps = (filter->src_h + filter->dst_h - 1) / filter->dst_h + 1;
+        int last;
+
+        filter->max_taps = max_xtaps;
+        /* The column sums go last, there are at most as many as source columns */
+        filter->x0 = (int *) GetStretchBuffer(src, width * 2 * sizeof(int) + max_ytaps * sizeof(Uint8 *) +
+                                              (width * max_xtaps + max_ytaps + filter->src_w * 4) * sizeof(Uint16));
+        if (!filter->x0) {
+            return -1;
+        }
+        filter->first = filter->x0;
+        filter->num_taps = filter->first + width;
+        filter->src_rows = (const Uint8 **) (filter->num_taps + width);
+        filter->xweights = (Uint16 *) (filter->src_rows + max_ytaps);
+        filter->yweights = filter->xweights + width * max_xtaps;
+
+        for (i = 0; i < width; ++i) {
+            filter->num_taps[i] = GetBoxSample(dst_x + i, filter->src_w, filter->dst_w,
+                                               &filter->first[i], filter->xweights + i * max_xtaps);
+        }
+
+        /* Only add up the source columns used by the clipped rectangle */
+        filter->sum_x = filter->first[0];
+        last = filter->first[width - 1] + filter->num_taps[width - 1];
+        filter->sum_w = last - filter->sum_x;
+        for (i = 0; i < width; ++i) {
+            filter->first[i] -= filter->sum_x;
+        }
+        filter->sum = filter->yweights + max_ytaps;
+
+        filter->VBox = StretchVBox;
+        filter->HBox = StretchHBox;
+#if HAVE_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            filter->VBox = StretchVBoxSSE2;
+            filter->HBox = StretchHBoxSSE2;
+        }
+#endif
+#if HAVE_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            filter->VBox = StretchVBoxNEON;
+            filter->HBox = StretchHBoxNEON;
+        }
+#endif
+    }
+    return 0;
+}
+
+/* Get the horizontally scaled source row, reusing the ones kept if possible */
+static const Uint16 *
+GetLinearRow(SDL_StretchFilter * filter, int y, int slot)
+{
+    if (filter->row_y[slot] != y) {
+        if (filter->row_y[!slot] == y) {
+            Uint16 *row = filter->rows[slot];
+            filter->rows[slot] = filter->rows[!slot];
+            filter->rows[!slot] = row;
+            filter->row_y[!slot] = filter->row_y[slot];
+        } else {
+            filter->HLinear(filter->pixels + y * filter->pitch, filter->rows[slot],
+                            filter->x0, filter->x1, filter->xweights, filter->width);
+        }
+        filter->row_y[slot] = y;
+    }
+    return filter->rows[slot];
+}
+
+/* Calculate one row of the stretched rectangle, relative to its top */
+static void
+StretchFilterRow(SDL_StretchFilter * filter, int y, Uint8 *dst)
+{
+    if (!filter->box) {
+        const Uint16 *row0, *row1;
+        int y0, y1, weight;
+
+        GetLinearSample(y, filter->src_h, filter->dst_h, &y0, &y1, &weight);
+        row0 = GetLinearRow(filter, y0, 0);
+        row1 = weight ? GetLinearRow(filter, y1, 1) : row0;
+        filter->VLinear(row0, row1, dst, filter->width * 4, weight);
+    } else {
+        int first, r, num_rows;
+
+        num_rows = GetBoxSample(y, filter->src_h, filter->dst_h, &first, filter->yweights);
+        for (r = 0; r < num_rows; ++r) {
+            filter->src_rows[r] = filter->pixels + (first + r) * filter->pitch + filter->sum_x * 4;
+        }
+        filter->VBox(filter->src_rows, filter->yweights, num_rows, filter->sum, filter->sum_w * 4);
+        filter->HBox(filter->sum, dst, filter->first, filter->num_taps, filter->xweights,
+                     filter->max_taps, filter->width);
+    }
+}
+
+/* Return whether the filtered stretch can read the pixels of this surface */
+SDL_bool
+SDL_CanStretchFiltered(SDL_Surface * src)
+{
+    const Uint32 format = src->format->format;
+
+    return (SDL_PIXELTYPE(format) == SDL_PIXELTYPE_PACKED32 &&
+            SDL_PIXELLAYOUT(format) == SDL_PACKEDLAYOUT_8888 &&
+            !(src->map->info.flags & SDL_COPY_COLORKEY));
+}
+
+/* Perform a filtered stretch blit of a 32-bit surface with 8-bit channels.
+   The destination rectangle isn't clipped before sampling, only the pixels
+   inside the destination clip rectangle are written.  If the formats differ
+   or blending or modulation are enabled the stretched pixels are blitted a
+   band of rows at a time.
+*/
+int
+SDL_SoftStretchFiltered(SDL_Surface * src, const SDL_Rect * srcrect,
+                        SDL_Surface * dst, const SDL_Rect * dstrect,
+                        SDL_ScaleQuality quality)
+{
+    static const Uint32 complex_copy_flags = (
+        SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA |
+        SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_MOD |
+        SDL_COPY_COLORKEY
+    );
+    SDL_StretchFilter filter;
+    SDL_Surface *band = NULL;
+    SDL_Rect clip;
+    int src_locked = 0;
+    int dst_locked = 0;
+    int y, retval = 0;
+
+    if (!SDL_CanStretchFiltered(src)) {
+        return SDL_SetError("Filtered stretching needs 32-bit surfaces with 8-bit channels");
+    }
+    if ((srcrect->x < 0) || (srcrect->y < 0) || (srcrect->w <= 0) || (srcrect->h <= 0) ||
+        ((srcrect->x + srcrect->w) > src->w) ||
+        ((srcrect->y + srcrect->h) > src->h)) {
+        return SDL_SetError("Invalid source blit rectangle");
+    }
+    if (!SDL_IntersectRect(dstrect, &dst->clip_rect, &clip)) {
+        return 0;
+    }
+
+    if (src->format->format != dst->format->format ||
+        (src->map->info.flags & complex_copy_flags)) {
+        Uint8 r, g, b, a;
+        SDL_BlendMode blendMode;
+
+        band = GetStretchBand(src, clip.w, SDL_min(clip.h, STRETCH_BAND_ROWS));
+        if (!band) {
+            return -1;
+        }
+        SDL_GetSurfaceColorMod(src, &r, &g, &b);
+        SDL_SetSurfaceColorMod(band, r, g, b);
+        SDL_GetSurfaceAlphaMod(src, &a);
+        SDL_SetSurfaceAlphaMod(band, a);
+        SDL_GetSurfaceBlendMode(src, &blendMode);
+        SDL_SetSurfaceBlendMode(band, blendMode);
+    }
+
+    if (SetupStretchFilter(&filter, src, srcrect, dstrect, clip.x - dstrect->x, clip.w, quality) < 0) {
+        return -1;
+    }
+
+    /* Lock the destination if it's in hardware */
+    if (!band && SDL_MUSTLOCK(dst)) {
+        if (SDL_LockSurface(dst) < 0) {
+            retval = SDL_SetError("Unable to lock destination surface");
+            goto done;
+        }
+        dst_locked = 1;
+    }
+    /* Lock the source if it's in hardware */
+    if (SDL_MUSTLOCK(src)) {
+        if (SDL_LockSurface(src) < 0) {
+            retval = SDL_SetError("Unable to lock source surface");
+            goto done;
+        }
+        src_locked = 1;
+    }
+    /* The source pointer could have changed when locking it */
+    filter.pixels = (const Uint8 *) src->pixels + srcrect->y * src->pitch + srcrect->x * 4;
+
+    if (band) {
+        for (y = 0; y < clip.h && retval == 0; y += band->h) {
+            SDL_Rect band_rect, dst_rect;
+            int i;
+
+            band_rect.x = 0;
+            band_rect.y = 0;
+            band_rect.w = clip.w;
+            band_rect.h = SDL_min(band->h, clip.h - y);
+            for (i = 0; i < band_rect.h; ++i) {
+                StretchFilterRow(&filter, clip.y - dstrect->y + y + i,
+                                 (Uint8 *) band->pixels + i * band->pitch);
+            }
+            dst_rect.x = clip.x;
+            dst_rect.y = clip.y + y;
+            dst_rect.w = band_rect.w;
+            dst_rect.h = band_rect.h;
+            retval = SDL_LowerBlit(band, &band_rect, dst, &dst_rect);
+        }
+        /* The band is kept, it mustn't keep the destination alive */
+        SDL_ReleaseMap(band->map);
+    } else {
+        for (y = 0; y < clip.h; ++y) {
+            StretchFilterRow(&filter, clip.y - dstrect->y + y,
+                             (Uint8 *) dst->pixels + (clip.y + y) * dst->pitch + clip.x * 4);
+        }
+    }
+
+done:
+    /* We need to unlock the surfaces if they're locked */
+    if (dst_locked) {
+        SDL_UnlockSurface(dst);
+    }
+    if (src_locked) {
+        SDL_UnlockSurface(src);
+    }
+    return retval;
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
@@ -21,10 +21,14 @@
 #include "../SDL_internal.h"
 
 #include "SDL_video.h"
+#include "SDL_hints.h"
+#include "SDL_cpuinfo.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
+#include "SDL_yuv_c.h"
+#include "../SDL_simd.h"
 
 /* Public routines */
 
@@ -38,8 +42,10 @@ SDL_CreateRGBSurfaceWithFormat(Uint32 flags, int width, int height, int depth,
 {
     SDL_Surface *surface;
 
-    /* The flags are no longer used, make the compiler happy */
-    (void)flags;
+    /* SDL_SIMD_ALIGNED is the only flag still used at creation */
+    if (SDL_GetHintBoolean(SDL_HINT_SURFACE_SIMD_ALIGNED, SDL_FALSE)) {
+        flags |= SDL_SIMD_ALIGNED;
+    }
 
     /* Allocate the surface */
     surface = (SDL_Surface *) SDL_calloc(1, sizeof(*surface));
@@ -53,6 +59,7 @@ SDL_CreateRGBSurfaceWithFormat(Uint32 flags, int width, int height, int depth,
         SDL_FreeSurface(surface);
         return NULL;
     }
+    surface->flags = (flags & SDL_SIMD_ALIGNED);
     surface->w = width;
     surface->h = height;
     surface->pitch = SDL_CalculatePitch(surface);
@@ -78,23 +85,22 @@ SDL_CreateRGBSurfaceWithFormat(Uint32 flags, int width, int height, int depth,
         SDL_FreePalette(palette);
     }
 
+    /* Allocate an empty mapping, it tells how the pixels were allocated */
+    surface->map = SDL_AllocBlitMap();
+    if (!surface->map) {
+        SDL_FreeSurface(surface);
+        return NULL;
+    }
+
     /* Get the pixels */
     if (surface->w && surface->h) {
-        surface->pixels = SDL_malloc(surface->h * surface->pitch);
+        /* The pixels are zeroed, this is important for bitmaps */
+        surface->pixels = SDL_AllocSurfacePixels(surface);
         if (!surface->pixels) {
             SDL_FreeSurface(surface);
             SDL_OutOfMemory();
             return NULL;
         }
-        /* This is important for bitmaps */
-        SDL_memset(surface->pixels, 0, surface->h * surface->pitch);
-    }
-
-    /* Allocate an empty mapping */
-    surface->map = SDL_AllocBlitMap();
-    if (!surface->map) {
-        SDL_FreeSurface(surface);
-        return NULL;
     }
 
     /* By default surface with an alpha mask are set up for blending */
@@ -140,6 +146,7 @@ SDL_CreateRGBSurfaceFrom(void *pixels,
 
     surface = SDL_CreateRGBSurface(0, 0, 0, depth, Rmask, Gmask, Bmask, Amask);
     if (surface != NULL) {
+        surface->flags &= ~SDL_SIMD_ALIGNED;
         surface->flags |= SDL_PREALLOC;
         surface->pixels = pixels;
         surface->w = width;
@@ -163,6 +170,7 @@ SDL_CreateRGBSurfaceWithFormatFrom(void *pixels,
 
     surface = SDL_CreateRGBSurfaceWithFormat(0, 0, 0, depth, format);
     if (surface != NULL) {
+        surface->flags &= ~SDL_SIMD_ALIGNED;
         surface->flags |= SDL_PREALLOC;
         surface->pixels = pixels;
         surface->w = width;
@@ -173,6 +181,76 @@ SDL_CreateRGBSurfaceWithFormatFrom(void *pixels,
     return surface;
 }
 
+/*
+ * Create an RGB surface with its pixels in shared memory
+ */
+SDL_Surface *
+SDL_CreateRGBSurfaceWithFormatShared(Uint32 flags, int width, int height,
+                                     int depth, Uint32 format)
+{
+    SDL_Surface *surface;
+
+    if (width <= 0 || height <= 0) {
+        SDL_InvalidParamError(width <= 0 ? "width" : "height");
+        return NULL;
+    }
+
+    surface = SDL_CreateRGBSurfaceWithFormat(flags, 0, 0, depth, format);
+    if (surface != NULL) {
+        surface->w = width;
+        surface->h = height;
+        surface->pitch = SDL_CalculatePitch(surface);
+        SDL_SetClipRect(surface, NULL);
+        if (SDL_AllocSharedPixels(surface) < 0) {
+            SDL_FreeSurface(surface);
+            return NULL;
+        }
+    }
+    return surface;
+}
+
+/*
+ * Create an RGB surface from shared memory exported by another surface
+ */
+SDL_Surface *
+SDL_CreateRGBSurfaceWithFormatFromFD(int fd,
+                         int width, int height, int depth, int pitch,
+                         Uint32 format)
+{
+    SDL_Surface *surface;
+
+    if (width <= 0 || height <= 0) {
+        SDL_InvalidParamError(width <= 0 ? "width" : "height");
+        return NULL;
+    }
+
+    surface = SDL_CreateRGBSurfaceWithFormatFrom(NULL, width, height, depth, pitch, format);
+    if (surface != NULL) {
+        if (pitch < (int) (((Sint64) width * surface->format->BitsPerPixel + 7) / 8)) {
+            SDL_InvalidParamError("pitch");
+            SDL_FreeSurface(surface);
+            return NULL;
+        }
+        if (SDL_MapSharedPixels(surface, fd) < 0) {
+            SDL_FreeSurface(surface);
+            return NULL;
+        }
+    }
+    return surface;
+}
+
+int
+SDL_GetSurfaceSharedFD(SDL_Surface * surface)
+{
+    if (!surface) {
+        return SDL_InvalidParamError("surface");
+    }
+    if (!surface->map || !surface->map->shared) {
+        return SDL_SetError("Surface pixels are not in shared memory");
+    }
+    return surface->map->shared->fd;
+}
+
 int
 SDL_SetSurfacePalette(SDL_Surface * surface, SDL_Palette * palette)
 {
@@ -434,13 +512,16 @@ SDL_SetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode blendMode)
     status = 0;
     flags = surface->map->info.flags;
     surface->map->info.flags &=
-        ~(SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD);
+        ~(SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_MOD);
     switch (blendMode) {
     case SDL_BLENDMODE_NONE:
         break;
     case SDL_BLENDMODE_BLEND:
         surface->map->info.flags |= SDL_COPY_BLEND;
         break;
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        surface->map->info.flags |= SDL_COPY_BLEND_PREMULTIPLIED;
+        break;
     case SDL_BLENDMODE_ADD:
         surface->map->info.flags |= SDL_COPY_ADD;
         break;
@@ -471,10 +552,13 @@ SDL_GetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode *blendMode)
     }
 
     switch (surface->map->
-            info.flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD)) {
+            info.flags & (SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_MOD)) {
     case SDL_COPY_BLEND:
         *blendMode = SDL_BLENDMODE_BLEND;
         break;
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        *blendMode = SDL_BLENDMODE_BLEND_PREMULTIPLIED;
+        break;
     case SDL_COPY_ADD:
         *blendMode = SDL_BLENDMODE_ADD;
         break;
@@ -653,9 +737,48 @@ SDL_UpperBlit(SDL_Surface * src, const SDL_Rect * srcrect,
     return 0;
 }
 
+/* Get the filter SDL_HINT_RENDER_SCALE_QUALITY asks for */
+SDL_ScaleQuality
+SDL_GetScaleQuality(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
+
+    if (!hint || *hint == '0' || SDL_strcasecmp(hint, "nearest") == 0) {
+        return SDL_SCALEQUALITY_NEAREST;
+    } else if (*hint == '2' || SDL_strcasecmp(hint, "best") == 0) {
+        return SDL_SCALEQUALITY_BEST;
+    } else /* if (*hint == '1' || SDL_strcasecmp(hint, "linear") == 0) */ {
+        return SDL_SCALEQUALITY_LINEAR;
+    }
+}
+
 int
 SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
               SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    return SDL_PrivateUpperBlitScaled(src, srcrect, dst, dstrect, SDL_GetScaleQuality());
+}
+
+int
+SDL_PrivateUpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
+              SDL_Surface * dst, SDL_Rect * dstrect, SDL_ScaleQuality quality)
+{
+    if (!src || !dst) {
+        return SDL_SetError("SDL_UpperBlitScaled: passed a NULL surface");
+    }
+    return SDL_PrivateUpperBlitScaledRows(src, srcrect, dst, dstrect, quality, &dst->clip_rect);
+}
+
+/*
+ * Scaled blit clipped to clip_rect, which only draws the rows within the clip
+ * rectangle of dst, a band of the rows of clip_rect. Every row samples the
+ * same source row as in the whole blit, so a target can be drawn in bands
+ * with the same result.
+ */
+int
+SDL_PrivateUpperBlitScaledRows(SDL_Surface * src, const SDL_Rect * srcrect,
+              SDL_Surface * dst, SDL_Rect * dstrect, SDL_ScaleQuality quality,
+              const SDL_Rect * clip_rect)
 {
     double src_x0, src_y0, src_x1, src_y1;
     double dst_x0, dst_y0, dst_x1, dst_y1;
@@ -663,6 +786,7 @@ SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
     double scaling_w, scaling_h;
     int src_w, src_h;
     int dst_w, dst_h;
+    int y, y0, y1, inc;
 
     /* Make sure the surfaces aren't locked */
     if (!src || !dst) {
@@ -742,22 +866,48 @@ SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
         }
     }
 
+    if (quality != SDL_SCALEQUALITY_NEAREST && SDL_CanStretchFiltered(src)) {
+        /* Sample the whole destination rectangle and only draw the clipped
+           part of it, so the filtering doesn't shift with the clipping */
+        final_src.x = (int)SDL_floor(src_x0 + 0.5);
+        final_src.y = (int)SDL_floor(src_y0 + 0.5);
+        final_src.w = (int)SDL_floor(src_x1 + 1 + 0.5) - final_src.x;
+        final_src.h = (int)SDL_floor(src_y1 + 1 + 0.5) - final_src.y;
+
+        final_dst.x = (int)SDL_floor(dst_x0 + 0.5);
+        final_dst.y = (int)SDL_floor(dst_y0 + 0.5);
+        final_dst.w = (int)SDL_floor(dst_x1 - dst_x0 + 1.5);
+        final_dst.h = (int)SDL_floor(dst_y1 - dst_y0 + 1.5);
+
+        if (final_dst.w <= 0 || final_dst.h <= 0 ||
+            final_src.w <= 0 || final_src.h <= 0) {
+            if (dstrect) {
+                dstrect->w = dstrect->h = 0;
+            }
+            return 0;
+        }
+        if (dstrect && !SDL_IntersectRect(&final_dst, &dst->clip_rect, dstrect)) {
+            dstrect->w = dstrect->h = 0;
+        }
+        return SDL_SoftStretchFiltered(src, &final_src, dst, &final_dst, quality);
+    }
+
     /* Clip destination rectangle to the clip rectangle */
 
     /* Translate to clip space for easier calculations */
-    dst_x0 -= dst->clip_rect.x;
-    dst_x1 -= dst->clip_rect.x;
-    dst_y0 -= dst->clip_rect.y;
-    dst_y1 -= dst->clip_rect.y;
+    dst_x0 -= clip_rect->x;
+    dst_x1 -= clip_rect->x;
+    dst_y0 -= clip_rect->y;
+    dst_y1 -= clip_rect->y;
 
     if (dst_x0 < 0) {
         src_x0 -= dst_x0 / scaling_w;
         dst_x0 = 0;
     }
 
-    if (dst_x1 >= dst->clip_rect.w) {
-        src_x1 -= (dst_x1 - dst->clip_rect.w + 1) / scaling_w;
-        dst_x1 = dst->clip_rect.w - 1;
+    if (dst_x1 >= clip_rect->w) {
+        src_x1 -= (dst_x1 - clip_rect->w + 1) / scaling_w;
+        dst_x1 = clip_rect->w - 1;
     }
 
     if (dst_y0 < 0) {
@@ -765,16 +915,16 @@ SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
         dst_y0 = 0;
     }
 
-    if (dst_y1 >= dst->clip_rect.h) {
-        src_y1 -= (dst_y1 - dst->clip_rect.h + 1) / scaling_h;
-        dst_y1 = dst->clip_rect.h - 1;
+    if (dst_y1 >= clip_rect->h) {
+        src_y1 -= (dst_y1 - clip_rect->h + 1) / scaling_h;
+        dst_y1 = clip_rect->h - 1;
     }
 
     /* Translate back to surface coordinates */
-    dst_x0 += dst->clip_rect.x;
-    dst_x1 += dst->clip_rect.x;
-    dst_y0 += dst->clip_rect.y;
-    dst_y1 += dst->clip_rect.y;
+    dst_x0 += clip_rect->x;
+    dst_x1 += clip_rect->x;
+    dst_y0 += clip_rect->y;
+    dst_y1 += clip_rect->y;
 
     final_src.x = (int)SDL_floor(src_x0 + 0.5);
     final_src.y = (int)SDL_floor(src_y0 + 0.5);
@@ -800,7 +950,28 @@ SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
         return 0;
     }
 
-    return SDL_LowerBlitScaled(src, &final_src, dst, &final_dst);
+    y0 = SDL_max(final_dst.y, dst->clip_rect.y);
+    y1 = SDL_min(final_dst.y + final_dst.h, dst->clip_rect.y + dst->clip_rect.h);
+    if (y0 == final_dst.y && y1 == final_dst.y + final_dst.h) {
+        return SDL_PrivateLowerBlitScaled(src, &final_src, dst, &final_dst, quality);
+    }
+
+    /* Blit the rows one at a time from the source rows the nearest scaling
+       steps to over the whole blit */
+    inc = (final_src.h << 16) / final_dst.h;
+    for (y = y0; y < y1; ++y) {
+        SDL_Rect row_src = final_src;
+        SDL_Rect row_dst = final_dst;
+
+        row_src.y += (int) (((Sint64) (y - final_dst.y) * inc) >> 16);
+        row_src.h = 1;
+        row_dst.y = y;
+        row_dst.h = 1;
+        if (SDL_PrivateLowerBlitScaled(src, &row_src, dst, &row_dst, quality) < 0) {
+            return -1;
+        }
+    }
+    return 0;
 }
 
 /**
@@ -810,13 +981,24 @@ SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
 int
 SDL_LowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
                 SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    return SDL_PrivateLowerBlitScaled(src, srcrect, dst, dstrect, SDL_GetScaleQuality());
+}
+
+int
+SDL_PrivateLowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
+                SDL_Surface * dst, SDL_Rect * dstrect, SDL_ScaleQuality quality)
 {
     static const Uint32 complex_copy_flags = (
         SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA |
-        SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD |
+        SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_MOD |
         SDL_COPY_COLORKEY
     );
 
+    if (quality != SDL_SCALEQUALITY_NEAREST && SDL_CanStretchFiltered(src)) {
+        return SDL_SoftStretchFiltered(src, srcrect, dst, dstrect, quality);
+    }
+
     if (!(src->map->info.flags & SDL_COPY_NEAREST)) {
         src->map->info.flags |= SDL_COPY_NEAREST;
         SDL_InvalidateMap(src->map);
@@ -916,6 +1098,8 @@ SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
     }
 
     /* Create a new surface with the desired format */
+    /* Aligned surfaces convert to aligned surfaces */
+    flags |= (surface->flags & SDL_SIMD_ALIGNED);
     convert = SDL_CreateRGBSurface(flags, surface->w, surface->h,
                                    format->BitsPerPixel, format->Rmask,
                                    format->Gmask, format->Bmask,
@@ -959,7 +1143,7 @@ SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
     convert->map->info.a = copy_color.a;
     convert->map->info.flags =
         (copy_flags &
-         ~(SDL_COPY_COLORKEY | SDL_COPY_BLEND
+         ~(SDL_COPY_COLORKEY | SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED
            | SDL_COPY_RLE_DESIRED | SDL_COPY_RLE_COLORKEY |
            SDL_COPY_RLE_ALPHAKEY));
     surface->map->info.r = copy_color.r;
@@ -1025,9 +1209,16 @@ SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
     }
     SDL_SetClipRect(convert, &surface->clip_rect);
 
+    /* The alpha is copied as is, so premultiplied pixels stay premultiplied */
+    if ((surface->flags & SDL_PREMULTIPLIED) && format->Amask) {
+        convert->flags |= SDL_PREMULTIPLIED;
+    }
+
     /* Enable alpha blending by default if the new surface has an
      * alpha channel or alpha modulation */
-    if ((surface->format->Amask && format->Amask) ||
+    if (convert->flags & SDL_PREMULTIPLIED) {
+        SDL_SetSurfaceBlendMode(convert, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    } else if ((surface->format->Amask && format->Amask) ||
         (copy_flags & SDL_COPY_MODULATE_ALPHA)) {
         SDL_SetSurfaceBlendMode(convert, SDL_BLENDMODE_BLEND);
     }
@@ -1054,6 +1245,34 @@ SDL_ConvertSurfaceFormat(SDL_Surface * surface, Uint32 pixel_format,
     return convert;
 }
 
+static SDL_YUV_CONVERSION_MODE SDL_YUV_ConversionMode = SDL_YUV_CONVERSION_JPEG;
+
+void
+SDL_SetYUVConversionMode(SDL_YUV_CONVERSION_MODE mode)
+{
+    SDL_YUV_ConversionMode = mode;
+}
+
+SDL_YUV_CONVERSION_MODE
+SDL_GetYUVConversionMode()
+{
+    return SDL_YUV_ConversionMode;
+}
+
+SDL_YUV_CONVERSION_MODE
+SDL_GetYUVConversionModeForResolution(int width, int height)
+{
+    SDL_YUV_CONVERSION_MODE mode = SDL_GetYUVConversionMode();
+    if (mode == SDL_YUV_CONVERSION_AUTOMATIC) {
+        if (height <= 576) {
+            mode = SDL_YUV_CONVERSION_BT601;
+        } else {
+            mode = SDL_YUV_CONVERSION_BT709;
+        }
+    }
+    return mode;
+}
+
 /*
  * Create a surface on the stack for quick blit operations
  */
@@ -1168,6 +1387,10 @@ int SDL_ConvertPixels(int width, int height,
         return 0;
     }
 
+    if (SDL_ISPIXELFORMAT_FOURCC(dst_format) && !SDL_ISPIXELFORMAT_FOURCC(src_format)) {
+        return SDL_ConvertPixels_RGB_to_YUV(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch);
+    }
+
     if (!SDL_CreateSurfaceOnStack(width, height, src_format, nonconst_src,
                                   src_pitch,
                                   &src_surface, &src_fmt, &src_blitmap)) {
@@ -1186,6 +1409,268 @@ int SDL_ConvertPixels(int width, int height,
     return SDL_LowerBlit(&src_surface, &rect, &dst_surface, &rect);
 }
 
+/*
+ * Premultiply a row of 32-bit pixels with 8-bit channels, the alpha being
+ * at bit 'ashift'.  Each channel is rounded to nearest:
+ *   t = c * a + 128, c = (t + (t >> 8)) >> 8
+ * which is exact for all 8-bit values and works on two channels at once.
+ */
+#define PREMULTIPLY_PAIR(c, a) \
+    (((((c) * (a) + 0x00800080) + ((((c) * (a) + 0x00800080) >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF)
+
+typedef void (*SDL_PremultiplyRowFunc)(Uint32 *pixels, int width, int ashift);
+
+static void
+SDL_PremultiplyRow(Uint32 *pixels, int width, int ashift)
+{
+    const Uint32 amask = 0xFFu << ashift;
+    int i;
+
+    for (i = 0; i < width; ++i) {
+        const Uint32 pixel = pixels[i];
+        const Uint32 a = (pixel >> ashift) & 0xFF;
+
+        if (a != 0xFF) {
+            const Uint32 lo = PREMULTIPLY_PAIR(pixel & 0x00FF00FF, a);
+            const Uint32 hi = PREMULTIPLY_PAIR((pixel >> 8) & 0x00FF00FF, a);
+            pixels[i] = ((lo | (hi << 8)) & ~amask) | (pixel & amask);
+        }
+    }
+}
+
+#if HAVE_SSE2_INTRINSICS
+static __m128i
+SDL_PremultiplyHalfSSE2(__m128i c, __m128i a)
+{
+    const __m128i t = _mm_add_epi16(_mm_mullo_epi16(c, a), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+static void
+SDL_PremultiplyRowSSE2(Uint32 *pixels, int width, int ashift)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i byte = _mm_set1_epi32(0xFF);
+    const __m128i amask = _mm_set1_epi32((int) (0xFFu << ashift));
+    const __m128i shift = _mm_cvtsi32_si128(ashift);
+    int i;
+
+    for (i = 0; i + 4 <= width; i += 4) {
+        const __m128i v = _mm_loadu_si128((const __m128i *) &pixels[i]);
+        __m128i a, lo, hi;
+
+        /* Spread the alpha over the color bytes, the alpha byte is kept */
+        a = _mm_and_si128(_mm_srl_epi32(v, shift), byte);
+        a = _mm_or_si128(a, _mm_slli_epi32(a, 8));
+        a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+        a = _mm_or_si128(a, amask);
+
+        lo = SDL_PremultiplyHalfSSE2(_mm_unpacklo_epi8(v, zero), _mm_unpacklo_epi8(a, zero));
+        hi = SDL_PremultiplyHalfSSE2(_mm_unpackhi_epi8(v, zero), _mm_unpackhi_epi8(a, zero));
+        _mm_storeu_si128((__m128i *) &pixels[i], _mm_packus_epi16(lo, hi));
+    }
+    SDL_PremultiplyRow(pixels + i, width - i, ashift);
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_AVX2_INTRINSICS
+static __m256i SDL_TARGETING_AVX2
+SDL_PremultiplyHalfAVX2(__m256i c, __m256i a)
+{
+    const __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(c, a), _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+static void SDL_TARGETING_AVX2
+SDL_PremultiplyRowAVX2(Uint32 *pixels, int width, int ashift)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i byte = _mm256_set1_epi32(0xFF);
+    const __m256i amask = _mm256_set1_epi32((int) (0xFFu << ashift));
+    const __m128i shift = _mm_cvtsi32_si128(ashift);
+    int i;
+
+    for (i = 0; i + 8 <= width; i += 8) {
+        const __m256i v = _mm256_loadu_si256((const __m256i *) &pixels[i]);
+        __m256i a, lo, hi;
+
+        a = _mm256_and_si256(_mm256_srl_epi32(v, shift), byte);
+        a = _mm256_or_si256(a, _mm256_slli_epi32(a, 8));
+        a = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+        a = _mm256_or_si256(a, amask);
+
+        /* The unpacks and the pack work within 128-bit lanes, so the pixel order is kept */
+        lo = SDL_PremultiplyHalfAVX2(_mm256_unpacklo_epi8(v, zero), _mm256_unpacklo_epi8(a, zero));
+        hi = SDL_PremultiplyHalfAVX2(_mm256_unpackhi_epi8(v, zero), _mm256_unpackhi_epi8(a, zero));
+        _mm256_storeu_si256((__m256i *) &pixels[i], _mm256_packus_epi16(lo, hi));
+    }
+    SDL_PremultiplyRow(pixels + i, width - i, ashift);
+}
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+static void
+SDL_PremultiplyRowNEON(Uint32 *pixels, int width, int ashift)
+{
+    const uint32x4_t byte = vdupq_n_u32(0xFF);
+    const uint32x4_t amask = vdupq_n_u32(0xFFu << ashift);
+    const int32x4_t shift = vdupq_n_s32(-ashift);
+    int i;
+
+    for (i = 0; i + 4 <= width; i += 4) {
+        const uint32x4_t v = vld1q_u32(&pixels[i]);
+        uint32x4_t a;
+        uint8x16_t vb, ab;
+        uint16x8_t lo, hi;
+
+        a = vandq_u32(vshlq_u32(v, shift), byte);
+        a = vorrq_u32(a, vshlq_n_u32(a, 8));
+        a = vorrq_u32(a, vshlq_n_u32(a, 16));
+        a = vorrq_u32(a, amask);
+
+        /* (t + ((t + 128) >> 8) + 128) >> 8 is the same rounding as above */
+        vb = vreinterpretq_u8_u32(v);
+        ab = vreinterpretq_u8_u32(a);
+        lo = vmull_u8(vget_low_u8(vb), vget_low_u8(ab));
+        hi = vmull_u8(vget_high_u8(vb), vget_high_u8(ab));
+        vst1q_u32(&pixels[i], vreinterpretq_u32_u8(vcombine_u8(vraddhn_u16(lo, vrshrq_n_u16(lo, 8)),
+                                                             vraddhn_u16(hi, vrshrq_n_u16(hi, 8)))));
+    }
+    SDL_PremultiplyRow(pixels + i, width - i, ashift);
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
+static SDL_PremultiplyRowFunc
+SDL_GetPremultiplyRowFunc(void)
+{
+#if HAVE_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return SDL_PremultiplyRowAVX2;
+    }
+#endif
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return SDL_PremultiplyRowSSE2;
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return SDL_PremultiplyRowNEON;
+    }
+#endif
+    return SDL_PremultiplyRow;
+}
+
+/*
+ * Premultiply the alpha of pixels in place
+ */
+static int
+SDL_PremultiplyPixels(int width, int height, Uint32 format, void *pixels, int pitch)
+{
+    SDL_PixelFormat *fmt;
+    Uint8 *row = (Uint8 *) pixels;
+    int x, y;
+
+    if (!SDL_ISPIXELFORMAT_ALPHA(format) || SDL_ISPIXELFORMAT_INDEXED(format)) {
+        return SDL_SetError("Premultiplied alpha needs a packed format with alpha");
+    }
+
+    fmt = SDL_AllocFormat(format);
+    if (!fmt) {
+        return -1;
+    }
+
+    if (fmt->BytesPerPixel == 4 && fmt->Aloss == 0 && fmt->Rloss == 0 &&
+        (fmt->Amask == 0xFF000000 || fmt->Amask == 0x000000FF)) {
+        /* 8888 formats, the alpha is either the low or the high byte */
+        const SDL_PremultiplyRowFunc func = SDL_GetPremultiplyRowFunc();
+
+        for (y = 0; y < height; ++y) {
+            func((Uint32 *) row, width, fmt->Ashift);
+            row += pitch;
+        }
+    } else {
+        for (y = 0; y < height; ++y) {
+            Uint8 *pixel = row;
+
+            for (x = 0; x < width; ++x) {
+                Uint32 value = 0;
+                Uint8 r, g, b, a;
+
+                SDL_memcpy(&value, pixel, fmt->BytesPerPixel);
+                SDL_GetRGBA(value, fmt, &r, &g, &b, &a);
+                r = (Uint8) ((r * a + 127) / 255);
+                g = (Uint8) ((g * a + 127) / 255);
+                b = (Uint8) ((b * a + 127) / 255);
+                value = SDL_MapRGBA(fmt, r, g, b, a);
+                SDL_memcpy(pixel, &value, fmt->BytesPerPixel);
+                pixel += fmt->BytesPerPixel;
+            }
+            row += pitch;
+        }
+    }
+    SDL_FreeFormat(fmt);
+    return 0;
+}
+
+int
+SDL_PremultiplyAlpha(int width, int height,
+                     Uint32 src_format, const void * src, int src_pitch,
+                     Uint32 dst_format, void * dst, int dst_pitch)
+{
+    if (!src) {
+        return SDL_InvalidParamError("src");
+    }
+    if (!src_pitch) {
+        return SDL_InvalidParamError("src_pitch");
+    }
+    if (!dst) {
+        return SDL_InvalidParamError("dst");
+    }
+    if (!dst_pitch) {
+        return SDL_InvalidParamError("dst_pitch");
+    }
+
+    /* Convert into the destination unless the pixels are premultiplied in place */
+    if (src != dst || src_format != dst_format || src_pitch != dst_pitch) {
+        if (SDL_ConvertPixels(width, height, src_format, src, src_pitch,
+                              dst_format, dst, dst_pitch) < 0) {
+            return -1;
+        }
+    }
+    return SDL_PremultiplyPixels(width, height, dst_format, dst, dst_pitch);
+}
+
+int
+SDL_PremultiplySurfaceAlpha(SDL_Surface * surface)
+{
+    SDL_BlendMode blendMode;
+    int status;
+
+    if (!surface) {
+        return SDL_InvalidParamError("surface");
+    }
+    if (surface->flags & SDL_PREMULTIPLIED) {
+        return 0;
+    }
+
+    if (SDL_LockSurface(surface) < 0) {
+        return -1;
+    }
+    status = SDL_PremultiplyPixels(surface->w, surface->h, surface->format->format,
+                                   surface->pixels, surface->pitch);
+    SDL_UnlockSurface(surface);
+    if (status < 0) {
+        return -1;
+    }
+
+    surface->flags |= SDL_PREMULTIPLIED;
+    if (SDL_GetSurfaceBlendMode(surface, &blendMode) == 0 && blendMode == SDL_BLENDMODE_BLEND) {
+        SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    }
+    return 0;
+}
+
 /*
  * Free a surface created by the above function.
  */
@@ -1198,10 +1683,8 @@ SDL_FreeSurface(SDL_Surface * surface)
     if (surface->flags & SDL_DONTFREE) {
         return;
     }
-    if (surface->map != NULL) {
-        SDL_FreeBlitMap(surface->map);
-        surface->map = NULL;
-    }
+    SDL_InvalidateMap(surface->map);
+
     if (--surface->refcount > 0) {
         return;
     }
@@ -1211,14 +1694,21 @@ SDL_FreeSurface(SDL_Surface * surface)
     if (surface->flags & SDL_RLEACCEL) {
         SDL_UnRLESurface(surface, 0);
     }
+    /* The shared memory is described in the blit map, so this goes first */
+    if (surface->map && surface->map->shared) {
+        SDL_FreeSharedPixels(surface);
+    } else if (!(surface->flags & SDL_PREALLOC)) {
+        SDL_FreeSurfacePixels(surface);
+    }
+    if (surface->map != NULL) {
+        SDL_FreeBlitMap(surface->map);
+        surface->map = NULL;
+    }
     if (surface->format) {
         SDL_SetSurfacePalette(surface, NULL);
         SDL_FreeFormat(surface->format);
         surface->format = NULL;
     }
-    if (!(surface->flags & SDL_PREALLOC)) {
-        SDL_free(surface->pixels);
-    }
     SDL_free(surface);
 }
 
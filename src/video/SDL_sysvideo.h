@@ -96,6 +96,7 @@ struct SDL_Window
 
     SDL_Surface *surface;
     SDL_bool surface_valid;
+    SDL_Region *surface_update;     /* scratch for SDL_UpdateWindowSurfaceRects() */
 
     SDL_bool is_hiding;
     SDL_bool is_destroying;
@@ -2252,12 +2252,36 @@ int
 SDL_UpdateWindowSurfaceRects(SDL_Window * window, const SDL_Rect * rects,
                              int numrects)
 {
+    SDL_Rect bounds;
+
     CHECK_WINDOW_MAGIC(window, -1);
 
     if (!window->surface_valid) {
         return SDL_SetError("Window surface is invalid, please call SDL_GetWindowSurface() to get a new surface");
     }
 
+    /* Drivers copy every rectangle, pass them on clipped to the surface
+       and without overlaps */
+    if (!window->surface_update) {
+        window->surface_update = SDL_CreateRegion();
+        if (!window->surface_update) {
+            return -1;
+        }
+    }
+    bounds.x = 0;
+    bounds.y = 0;
+    bounds.w = window->surface->w;
+    bounds.h = window->surface->h;
+    SDL_ClearRegion(window->surface_update);
+    if (SDL_UnionRegionRects(window->surface_update, rects, numrects) < 0 ||
+        SDL_IntersectRegionRect(window->surface_update, &bounds) < 0) {
+        return -1;
+    }
+
+    rects = SDL_GetRegionRects(window->surface_update, &numrects);
+    if (numrects == 0) {
+        return 0;
+    }
     return _this->UpdateWindowFramebuffer(_this, window, rects, numrects);
 }
 
@@ -2640,6 +2664,7 @@ SDL_DestroyWindow(SDL_Window * window)
         window->surface->flags &= ~SDL_DONTFREE;
         SDL_FreeSurface(window->surface);
     }
+    SDL_FreeRegion(window->surface_update);
     if (_this->DestroyWindowFramebuffer) {
         _this->DestroyWindowFramebuffer(_this, window);
     }
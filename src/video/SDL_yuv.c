@@ -0,0 +1,502 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#include "SDL_video.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_yuv_c.h"
+#include "../SDL_simd.h"
+
+/* The RGB to YUV matrix in fixed point with 14 fractional bits.  The offsets
+   are kept as 2 * offset + 1, which multiplied by 8192 is the offset plus
+   the rounding. */
+typedef struct
+{
+    Sint16 y[3], u[3], v[3];    /* R, G, B factors */
+    Sint16 y_offset;
+    Sint16 c_offset;
+    int r_pos, g_pos, b_pos;    /* byte offsets in the 32-bit source pixels */
+} SDL_RGBToYUV;
+
+typedef void (*SDL_RGBToYUVFunc) (const Uint8 *src0, const Uint8 *src1,
+                                  Uint8 *y0, Uint8 *y1, Uint8 *u, Uint8 *v,
+                                  int width, const SDL_RGBToYUV * m);
+
+#define YUV_FIXED(x)   ((Sint16) SDL_floor((x) * 16384.0 + 0.5))
+
+/* Rows of other RGB formats converted to ARGB8888 at a time, even */
+#define YUV_RGB_BAND_ROWS  16
+
+static void
+SDL_SetupRGBToYUV(SDL_RGBToYUV * m, SDL_YUV_CONVERSION_MODE mode)
+{
+    double kr, kb, kg;
+    double y_scale, c_scale;
+    int offset;
+
+    if (mode == SDL_YUV_CONVERSION_BT709 ||
+        mode == SDL_YUV_CONVERSION_BT709_FULL) {
+        kr = 0.2126;
+        kb = 0.0722;
+    } else {
+        kr = 0.299;
+        kb = 0.114;
+    }
+    kg = 1.0 - kr - kb;
+
+    if (mode == SDL_YUV_CONVERSION_BT601 ||
+        mode == SDL_YUV_CONVERSION_BT709) {
+        /* Video range, Y is 16-235 and the chroma 16-240 */
+        offset = 16;
+        y_scale = 219.0 / 255.0;
+        c_scale = 224.0 / 255.0;
+    } else {
+        offset = 0;
+        y_scale = 1.0;
+        c_scale = 1.0;
+    }
+
+    m->y[0] = YUV_FIXED(kr * y_scale);
+    m->y[1] = YUV_FIXED(kg * y_scale);
+    m->y[2] = YUV_FIXED(kb * y_scale);
+    m->u[0] = YUV_FIXED(-kr / (2.0 * (1.0 - kb)) * c_scale);
+    m->u[1] = YUV_FIXED(-kg / (2.0 * (1.0 - kb)) * c_scale);
+    m->u[2] = YUV_FIXED(0.5 * c_scale);
+    m->v[0] = YUV_FIXED(0.5 * c_scale);
+    m->v[1] = YUV_FIXED(-kg / (2.0 * (1.0 - kr)) * c_scale);
+    m->v[2] = YUV_FIXED(-kb / (2.0 * (1.0 - kr)) * c_scale);
+    m->y_offset = 2 * offset + 1;
+    m->c_offset = 2 * 128 + 1;
+}
+
+/* Find the bytes of a 32-bit format with whole byte channels */
+static SDL_bool
+SDL_GetBytePositions32(Uint32 format, int *r_pos, int *g_pos, int *b_pos)
+{
+    const Uint32 *masks[3];
+    int *positions[3];
+    Uint32 Rmask, Gmask, Bmask, Amask;
+    int bpp, i, shift;
+
+    if (SDL_ISPIXELFORMAT_FOURCC(format) || SDL_BYTESPERPIXEL(format) != 4 ||
+        !SDL_PixelFormatEnumToMasks(format, &bpp, &Rmask, &Gmask, &Bmask, &Amask)) {
+        return SDL_FALSE;
+    }
+
+    masks[0] = &Rmask;
+    masks[1] = &Gmask;
+    masks[2] = &Bmask;
+    positions[0] = r_pos;
+    positions[1] = g_pos;
+    positions[2] = b_pos;
+    for (i = 0; i < 3; ++i) {
+        for (shift = 0; shift < 32; shift += 8) {
+            if (*masks[i] == (0xFFu << shift)) {
+                break;
+            }
+        }
+        if (shift == 32) {
+            return SDL_FALSE;
+        }
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        *positions[i] = shift / 8;
+#else
+        *positions[i] = 3 - shift / 8;
+#endif
+    }
+    return SDL_TRUE;
+}
+
+SDL_FORCE_INLINE Uint8
+ClampYUV(int value)
+{
+    return (Uint8) ((value < 0) ? 0 : ((value > 255) ? 255 : value));
+}
+
+SDL_FORCE_INLINE Uint8
+RGBToLuma(const Uint8 *p, const SDL_RGBToYUV * m)
+{
+    return ClampYUV((p[m->r_pos] * m->y[0] + p[m->g_pos] * m->y[1] +
+                     p[m->b_pos] * m->y[2] + m->y_offset * 8192) >> 14);
+}
+
+/* Converts the pixels from x on of two rows, with the chroma of each 2x2
+   block averaged.  A single row is passed as both rows and no second luma
+   row, the chroma is then the average of each pair of pixels. */
+SDL_FORCE_INLINE void
+RGBToYUVTail(const Uint8 *src0, const Uint8 *src1,
+             Uint8 *y0, Uint8 *y1, Uint8 *u, Uint8 *v,
+             int x, int width, const SDL_RGBToYUV * m)
+{
+    for (; x < width; x += 2) {
+        const int x1 = (x + 1 < width) ? x + 1 : x;
+        const Uint8 *a = src0 + x * 4;
+        const Uint8 *b = src0 + x1 * 4;
+        const Uint8 *c = src1 + x * 4;
+        const Uint8 *d = src1 + x1 * 4;
+        const int r = (a[m->r_pos] + b[m->r_pos] + c[m->r_pos] + d[m->r_pos] + 2) >> 2;
+        const int g = (a[m->g_pos] + b[m->g_pos] + c[m->g_pos] + d[m->g_pos] + 2) >> 2;
+        const int bl = (a[m->b_pos] + b[m->b_pos] + c[m->b_pos] + d[m->b_pos] + 2) >> 2;
+
+        y0[x] = RGBToLuma(a, m);
+        y0[x1] = RGBToLuma(b, m);
+        if (y1) {
+            y1[x] = RGBToLuma(c, m);
+            y1[x1] = RGBToLuma(d, m);
+        }
+        u[x / 2] = ClampYUV((r * m->u[0] + g * m->u[1] + bl * m->u[2] + m->c_offset * 8192) >> 14);
+        v[x / 2] = ClampYUV((r * m->v[0] + g * m->v[1] + bl * m->v[2] + m->c_offset * 8192) >> 14);
+    }
+}
+
+static void
+RGBToYUVRows(const Uint8 *src0, const Uint8 *src1,
+             Uint8 *y0, Uint8 *y1, Uint8 *u, Uint8 *v,
+             int width, const SDL_RGBToYUV * m)
+{
+    RGBToYUVTail(src0, src1, y0, y1, u, v, 0, width, m);
+}
+
+#if HAVE_SSE2_INTRINSICS
+/* Pairs of 16-bit factors for _mm_madd_epi16() */
+#define YUV_PAIR(a, b)  _mm_set1_epi32((Uint16) (a) | ((Uint32) (Uint16) (b) << 16))
+
+/* (a * k.lo + b * k.hi + c * l.lo + d * l.hi) >> 14 for four values */
+SDL_FORCE_INLINE __m128i
+MulAdd4SSE2(__m128i ab, __m128i k, __m128i cd, __m128i l)
+{
+    return _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(ab, k), _mm_madd_epi16(cd, l)), 14);
+}
+
+/* Splits eight pixels into 16-bit R, G and B */
+SDL_FORCE_INLINE void
+LoadRGBSSE2(const Uint8 *src, const __m128i shifts[3], __m128i rgb[3])
+{
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    const __m128i p0 = _mm_loadu_si128((const __m128i *) src);
+    const __m128i p1 = _mm_loadu_si128((const __m128i *) (src + 16));
+    int i;
+
+    for (i = 0; i < 3; ++i) {
+        rgb[i] = _mm_packs_epi32(_mm_and_si128(_mm_srl_epi32(p0, shifts[i]), mask),
+                                 _mm_and_si128(_mm_srl_epi32(p1, shifts[i]), mask));
+    }
+}
+
+SDL_FORCE_INLINE __m128i
+LumaSSE2(const __m128i rgb[3], __m128i rg_mul, __m128i b_mul, __m128i offset)
+{
+    const __m128i lo = MulAdd4SSE2(_mm_unpacklo_epi16(rgb[0], rgb[1]), rg_mul,
+                                   _mm_unpacklo_epi16(rgb[2], offset), b_mul);
+    const __m128i hi = MulAdd4SSE2(_mm_unpackhi_epi16(rgb[0], rgb[1]), rg_mul,
+                                   _mm_unpackhi_epi16(rgb[2], offset), b_mul);
+    return _mm_packus_epi16(_mm_packs_epi32(lo, hi), _mm_setzero_si128());
+}
+
+/* converts 8 pixels of each row at a time */
+static void
+RGBToYUVRowsSSE2(const Uint8 *src0, const Uint8 *src1,
+                 Uint8 *y0, Uint8 *y1, Uint8 *u, Uint8 *v,
+                 int width, const SDL_RGBToYUV * m)
+{
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i two = _mm_set1_epi32(2);
+    const __m128i y_rg = YUV_PAIR(m->y[0], m->y[1]);
+    const __m128i y_b = YUV_PAIR(m->y[2], 8192);
+    const __m128i u_rg = YUV_PAIR(m->u[0], m->u[1]);
+    const __m128i u_b = YUV_PAIR(m->u[2], 8192);
+    const __m128i v_rg = YUV_PAIR(m->v[0], m->v[1]);
+    const __m128i v_b = YUV_PAIR(m->v[2], 8192);
+    const __m128i y_offset = _mm_set1_epi16(m->y_offset);
+    const __m128i c_offset = _mm_set1_epi16(m->c_offset);
+    __m128i shifts[3];
+    int x = 0;
+
+    shifts[0] = _mm_cvtsi32_si128(m->r_pos * 8);
+    shifts[1] = _mm_cvtsi32_si128(m->g_pos * 8);
+    shifts[2] = _mm_cvtsi32_si128(m->b_pos * 8);
+
+    for (; x + 8 <= width; x += 8) {
+        __m128i rgb0[3], rgb1[3], avg[3], chroma;
+        Uint32 packed;
+        int i;
+
+        LoadRGBSSE2(src0 + x * 4, shifts, rgb0);
+        LoadRGBSSE2(src1 + x * 4, shifts, rgb1);
+        _mm_storel_epi64((__m128i *) (y0 + x), LumaSSE2(rgb0, y_rg, y_b, y_offset));
+        if (y1) {
+            _mm_storel_epi64((__m128i *) (y1 + x), LumaSSE2(rgb1, y_rg, y_b, y_offset));
+        }
+
+        /* Average each 2x2 block, with rounding */
+        for (i = 0; i < 3; ++i) {
+            avg[i] = _mm_madd_epi16(_mm_add_epi16(rgb0[i], rgb1[i]), one);
+            avg[i] = _mm_srli_epi32(_mm_add_epi32(avg[i], two), 2);
+            avg[i] = _mm_packs_epi32(avg[i], avg[i]);
+        }
+
+        chroma = MulAdd4SSE2(_mm_unpacklo_epi16(avg[0], avg[1]), u_rg,
+                             _mm_unpacklo_epi16(avg[2], c_offset), u_b);
+        chroma = _mm_packus_epi16(_mm_packs_epi32(chroma, chroma), chroma);
+        packed = (Uint32) _mm_cvtsi128_si32(chroma);
+        SDL_memcpy(u + x / 2, &packed, sizeof(packed));
+
+        chroma = MulAdd4SSE2(_mm_unpacklo_epi16(avg[0], avg[1]), v_rg,
+                             _mm_unpacklo_epi16(avg[2], c_offset), v_b);
+        chroma = _mm_packus_epi16(_mm_packs_epi32(chroma, chroma), chroma);
+        packed = (Uint32) _mm_cvtsi128_si32(chroma);
+        SDL_memcpy(v + x / 2, &packed, sizeof(packed));
+    }
+    RGBToYUVTail(src0, src1, y0, y1, u, v, x, width, m);
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_NEON_INTRINSICS
+/* (r * k[0] + g * k[1] + b * k[2] + offset) >> 14 for eight values */
+SDL_FORCE_INLINE int16x8_t
+MulAdd8NEON(int16x8_t r, int16x8_t g, int16x8_t b, const Sint16 k[3], int32x4_t offset)
+{
+    int32x4_t lo = vmlal_n_s16(offset, vget_low_s16(r), k[0]);
+    int32x4_t hi = vmlal_n_s16(offset, vget_high_s16(r), k[0]);
+
+    lo = vmlal_n_s16(lo, vget_low_s16(g), k[1]);
+    hi = vmlal_n_s16(hi, vget_high_s16(g), k[1]);
+    lo = vmlal_n_s16(lo, vget_low_s16(b), k[2]);
+    hi = vmlal_n_s16(hi, vget_high_s16(b), k[2]);
+    return vcombine_s16(vqshrn_n_s32(lo, 14), vqshrn_n_s32(hi, 14));
+}
+
+SDL_FORCE_INLINE uint8x16_t
+LumaNEON(uint8x16x4_t pixels, const SDL_RGBToYUV * m, int32x4_t offset)
+{
+    const uint8x16_t r = pixels.val[m->r_pos];
+    const uint8x16_t g = pixels.val[m->g_pos];
+    const uint8x16_t b = pixels.val[m->b_pos];
+    const int16x8_t lo = MulAdd8NEON(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(r))),
+                                     vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(g))),
+                                     vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(b))),
+                                     m->y, offset);
+    const int16x8_t hi = MulAdd8NEON(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(r))),
+                                     vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(g))),
+                                     vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(b))),
+                                     m->y, offset);
+    return vcombine_u8(vqmovun_s16(lo), vqmovun_s16(hi));
+}
+
+/* converts 16 pixels of each row at a time */
+static void
+RGBToYUVRowsNEON(const Uint8 *src0, const Uint8 *src1,
+                 Uint8 *y0, Uint8 *y1, Uint8 *u, Uint8 *v,
+                 int width, const SDL_RGBToYUV * m)
+{
+    const int32x4_t y_offset = vdupq_n_s32(m->y_offset * 8192);
+    const int32x4_t c_offset = vdupq_n_s32(m->c_offset * 8192);
+    int x = 0;
+
+    for (; x + 16 <= width; x += 16) {
+        const uint8x16x4_t p0 = vld4q_u8(src0 + x * 4);
+        const uint8x16x4_t p1 = vld4q_u8(src1 + x * 4);
+        int16x8_t r, g, b;
+
+        vst1q_u8(y0 + x, LumaNEON(p0, m, y_offset));
+        if (y1) {
+            vst1q_u8(y1 + x, LumaNEON(p1, m, y_offset));
+        }
+
+        /* Average each 2x2 block, with rounding */
+        r = vreinterpretq_s16_u16(vrshrq_n_u16(vpadalq_u8(vpaddlq_u8(p0.val[m->r_pos]), p1.val[m->r_pos]), 2));
+        g = vreinterpretq_s16_u16(vrshrq_n_u16(vpadalq_u8(vpaddlq_u8(p0.val[m->g_pos]), p1.val[m->g_pos]), 2));
+        b = vreinterpretq_s16_u16(vrshrq_n_u16(vpadalq_u8(vpaddlq_u8(p0.val[m->b_pos]), p1.val[m->b_pos]), 2));
+        vst1_u8(u + x / 2, vqmovun_s16(MulAdd8NEON(r, g, b, m->u, c_offset)));
+        vst1_u8(v + x / 2, vqmovun_s16(MulAdd8NEON(r, g, b, m->v, c_offset)));
+    }
+    RGBToYUVTail(src0, src1, y0, y1, u, v, x, width, m);
+}
+#endif /* HAVE_NEON_INTRINSICS */
+
+/* Interleaves two rows of bytes, a0 b0 a1 b1 ... */
+static void
+InterleaveBytes(const Uint8 *a, const Uint8 *b, Uint8 *dst, int count)
+{
+    int i = 0;
+
+#if HAVE_SSE2_INTRINSICS
+    for (; i + 16 <= count; i += 16) {
+        const __m128i va = _mm_loadu_si128((const __m128i *) (a + i));
+        const __m128i vb = _mm_loadu_si128((const __m128i *) (b + i));
+        _mm_storeu_si128((__m128i *) (dst + i * 2), _mm_unpacklo_epi8(va, vb));
+        _mm_storeu_si128((__m128i *) (dst + i * 2 + 16), _mm_unpackhi_epi8(va, vb));
+    }
+#elif HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        for (; i + 16 <= count; i += 16) {
+            uint8x16x2_t pairs;
+            pairs.val[0] = vld1q_u8(a + i);
+            pairs.val[1] = vld1q_u8(b + i);
+            vst2q_u8(dst + i * 2, pairs);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i * 2] = a[i];
+        dst[i * 2 + 1] = b[i];
+    }
+}
+
+int
+SDL_ConvertPixels_RGB_to_YUV(int width, int height,
+                             Uint32 src_format, const void *src, int src_pitch,
+                             Uint32 dst_format, void *dst, int dst_pitch)
+{
+    const int chroma_width = (width + 1) / 2;
+    const int chroma_height = (height + 1) / 2;
+    SDL_RGBToYUV m;
+    SDL_RGBToYUVFunc ConvertRows = RGBToYUVRows;
+    SDL_bool planar, packed, direct;
+    Uint8 *u_plane = NULL, *v_plane = NULL;
+    int chroma_pitch = 0;
+    Uint8 *scratch = NULL;
+    Uint8 *rgb_rows = NULL, *y_row = NULL, *u_row = NULL, *v_row = NULL, *c_row = NULL;
+    int row;
+
+    switch (dst_format) {
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+        /* The U and V planes follow the Y plane, with half the pitch */
+        chroma_pitch = (dst_pitch + 1) / 2;
+        u_plane = (Uint8 *) dst + height * dst_pitch;
+        v_plane = u_plane + chroma_height * chroma_pitch;
+        if (dst_format == SDL_PIXELFORMAT_YV12) {
+            Uint8 *tmp = u_plane;
+            u_plane = v_plane;
+            v_plane = tmp;
+        }
+        planar = SDL_TRUE;
+        packed = SDL_FALSE;
+        break;
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        /* The interleaved chroma plane follows the Y plane */
+        chroma_pitch = ((dst_pitch + 1) / 2) * 2;
+        u_plane = (Uint8 *) dst + height * dst_pitch;
+        planar = SDL_FALSE;
+        packed = SDL_FALSE;
+        break;
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+        planar = SDL_FALSE;
+        packed = SDL_TRUE;
+        break;
+    default:
+        return SDL_SetError("Unsupported YUV destination format: %s", SDL_GetPixelFormatName(dst_format));
+    }
+
+    SDL_SetupRGBToYUV(&m, SDL_GetYUVConversionModeForResolution(width, height));
+
+    /* Other formats are converted to ARGB8888 a band of rows at a time */
+    direct = SDL_GetBytePositions32(src_format, &m.r_pos, &m.g_pos, &m.b_pos);
+    if (!direct) {
+        SDL_GetBytePositions32(SDL_PIXELFORMAT_ARGB8888, &m.r_pos, &m.g_pos, &m.b_pos);
+    }
+
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        ConvertRows = RGBToYUVRowsSSE2;
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        ConvertRows = RGBToYUVRowsNEON;
+    }
+#endif
+
+    if (!direct || !planar) {
+        scratch = (Uint8 *) SDL_malloc(width * 4 * YUV_RGB_BAND_ROWS + width + chroma_width * 4);
+        if (!scratch) {
+            return SDL_OutOfMemory();
+        }
+        rgb_rows = scratch;
+        y_row = rgb_rows + width * 4 * YUV_RGB_BAND_ROWS;
+        u_row = y_row + width;
+        v_row = u_row + chroma_width;
+        c_row = v_row + chroma_width;
+    }
+
+    for (row = 0; row < height; row += packed ? 1 : 2) {
+        const int rows = (!packed && row + 1 < height) ? 2 : 1;
+        const Uint8 *src0 = (const Uint8 *) src + row * src_pitch;
+        const Uint8 *src1 = src0 + (rows - 1) * src_pitch;
+        Uint8 *y0 = (Uint8 *) dst + row * dst_pitch;
+        Uint8 *y1 = (rows == 2) ? y0 + dst_pitch : NULL;
+
+        if (!direct) {
+            const int band_row = row % YUV_RGB_BAND_ROWS;
+
+            if (band_row == 0 &&
+                SDL_ConvertPixels(width, SDL_min(height - row, YUV_RGB_BAND_ROWS),
+                                  src_format, src0, src_pitch,
+                                  SDL_PIXELFORMAT_ARGB8888, rgb_rows, width * 4) < 0) {
+                SDL_free(scratch);
+                return -1;
+            }
+            src0 = rgb_rows + band_row * width * 4;
+            src1 = src0 + (rows - 1) * width * 4;
+        }
+
+        if (planar) {
+            ConvertRows(src0, src1, y0, y1,
+                        u_plane + (row / 2) * chroma_pitch,
+                        v_plane + (row / 2) * chroma_pitch, width, &m);
+        } else if (!packed) {
+            Uint8 *uv = u_plane + (row / 2) * chroma_pitch;
+
+            ConvertRows(src0, src1, y0, y1, u_row, v_row, width, &m);
+            if (dst_format == SDL_PIXELFORMAT_NV12) {
+                InterleaveBytes(u_row, v_row, uv, chroma_width);
+            } else {
+                InterleaveBytes(v_row, u_row, uv, chroma_width);
+            }
+        } else {
+            /* Each row has its own chroma, as Y0 U Y1 V in some order */
+            ConvertRows(src0, src0, y_row, NULL, u_row, v_row, width, &m);
+            switch (dst_format) {
+            case SDL_PIXELFORMAT_YUY2:
+                InterleaveBytes(u_row, v_row, c_row, chroma_width);
+                InterleaveBytes(y_row, c_row, y0, width);
+                break;
+            case SDL_PIXELFORMAT_UYVY:
+                InterleaveBytes(u_row, v_row, c_row, chroma_width);
+                InterleaveBytes(c_row, y_row, y0, width);
+                break;
+            case SDL_PIXELFORMAT_YVYU:
+                InterleaveBytes(v_row, u_row, c_row, chroma_width);
+                InterleaveBytes(y_row, c_row, y0, width);
+                break;
+            }
+        }
+    }
+
+    SDL_free(scratch);
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -44,7 +44,29 @@ Arcan_UpdateWindowFramebuffer(_THIS, SDL_Window* sdl_window,
                             const SDL_Rect* rects, int numrects)
 {
 	Arcan_WindowData* data = (Arcan_WindowData*) sdl_window->driverdata;
-	arcan_shmif_signal(data->con, SHMIF_SIGVID);
+	struct arcan_shmif_cont* con = data->con;
+	SDL_Rect dirty;
+	int i;
+
+/* the window is set up with a subregion hint, so only the dirty area of
+ * the segment gets synched, which is the union of the updated rects */
+	dirty.x = dirty.y = 0;
+	dirty.w = con->w;
+	dirty.h = con->h;
+	if (numrects > 0){
+		SDL_Rect bounds = dirty;
+		dirty = rects[0];
+		for (i = 1; i < numrects; i++)
+			SDL_UnionRect(&dirty, &rects[i], &dirty);
+		if (!SDL_IntersectRect(&dirty, &bounds, &dirty))
+			return 0;
+	}
+
+	con->dirty.x1 = dirty.x;
+	con->dirty.y1 = dirty.y;
+	con->dirty.x2 = dirty.x + dirty.w;
+	con->dirty.y2 = dirty.y + dirty.h;
+	arcan_shmif_signal(con, SHMIF_SIGVID);
 	return 0;
 }
 
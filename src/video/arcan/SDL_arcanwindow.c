@@ -108,7 +108,7 @@ Arcan_CreateWindow(_THIS, SDL_Window* window)
         arcan_shmifext_setup(data->con, Arcan_GL_cfg(_this, window));
     }
     else{
-        data->con->hints = 0;
+        data->con->hints = SHMIF_RHINT_SUBREGION;
         arcan_shmifext_drop(data->con);
         arcan_shmif_resize(data->con, window->w, window->h);
     }
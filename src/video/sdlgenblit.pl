@@ -261,7 +261,7 @@ __EOF__
                     ${s}B = (${s}B * ${s}A) / 255;
                 }
             }
-            switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD)) {
+            switch (flags & (SDL_COPY_BLEND|SDL_COPY_BLEND_PREMULTIPLIED|SDL_COPY_ADD|SDL_COPY_MOD)) {
             case SDL_COPY_BLEND:
                 ${d}R = ${s}R + ((255 - ${s}A) * ${d}R) / 255;
                 ${d}G = ${s}G + ((255 - ${s}A) * ${d}G) / 255;
@@ -274,6 +274,20 @@ __EOF__
 __EOF__
         }
 
+        print FILE <<__EOF__;
+                break;
+            case SDL_COPY_BLEND_PREMULTIPLIED:
+                ${d}R = ${s}R + ((255 - ${s}A) * ${d}R) / 255; if (${d}R > 255) ${d}R = 255;
+                ${d}G = ${s}G + ((255 - ${s}A) * ${d}G) / 255; if (${d}G > 255) ${d}G = 255;
+                ${d}B = ${s}B + ((255 - ${s}A) * ${d}B) / 255; if (${d}B > 255) ${d}B = 255;
+__EOF__
+
+        if ( $dst_has_alpha ) {
+            print FILE <<__EOF__;
+                ${d}A = ${s}A + ((255 - ${s}A) * ${d}A) / 255;
+__EOF__
+        }
+
         print FILE <<__EOF__;
                 break;
             case SDL_COPY_ADD:
@@ -436,15 +450,484 @@ sub output_copyinc
 #include "SDL_video.h"
 #include "SDL_blit.h"
 #include "SDL_blit_auto.h"
+#include "../SDL_simd.h"
+
+__EOF__
+}
+
+# The SIMD blitters handle every combination of the 8888 formats and copy
+# flags in one function per instruction set. They work on 16-bit channels
+# in the destination byte order, and round exactly like the scalar code.
+my $simd_x86_template = <<'__EOF__';
+SDL_FORCE_INLINE VEC TARGET
+SDL_Blit_Div255_ISA(VEC x)
+{
+    /* x / 255, exact for the product of two bytes */
+    return MM_srli_epi16(MM_add_epi16(MM_add_epi16(x, MM_set1_epi16(1)), MM_srli_epi16(x, 8)), 8);
+}
+
+SDL_FORCE_INLINE VEC TARGET
+SDL_Blit_SpreadAlpha_ISA(VEC x, __m128i up)
+{
+    /* Copy the alpha of each pixel to all four of its channels */
+    x = MM_srli_epi64(MM_sll_epi64(x, up), 48);
+    x = MM_or_si256(x, MM_slli_epi64(x, 16));
+    return MM_or_si256(x, MM_slli_epi64(x, 32));
+}
+
+static void TARGET
+SDL_Blit_8888_ISA(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const int blend = flags & (SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_MOD);
+    const VEC zero = MM_setzero_si256();
+    const VEC byte = MM_set1_epi32(0xFF);
+    const VEC opaque = MM_set1_epi16(255);
+    SDL_BlitSIMDSetup setup;
+    __m128i src_shift[4], dst_shift[4], alpha_up, modulate4;
+    VEC keep, fill, mask, dst_alpha, alpha_lanes, modulate;
+    Uint32 buffer[WIDTH];
+    int srcy = 0, posy = 0, incy = 0, incx = 0;
+    int i;
+
+    SDL_Blit_SetupSIMD(info, &setup);
+    for (i = 0; i < 4; ++i) {
+        src_shift[i] = _mm_cvtsi32_si128(setup.src_shift[i]);
+        dst_shift[i] = _mm_cvtsi32_si128(setup.dst_shift[i]);
+    }
+    alpha_up = _mm_cvtsi32_si128(48 - 2 * setup.dst_shift[3]);
+    keep = MM_set1_epi32((int)setup.src_keep);
+    fill = MM_set1_epi32((int)setup.src_fill);
+    mask = MM_set1_epi32((int)setup.dst_mask);
+    dst_alpha = MM_set1_epi32((int)(0xFFu << setup.dst_shift[3]));
+    alpha_lanes = MM_unpacklo_epi8(dst_alpha, zero);
+    modulate4 = _mm_set_epi16(setup.modulate[3], setup.modulate[2], setup.modulate[1], setup.modulate[0],
+                              setup.modulate[3], setup.modulate[2], setup.modulate[1], setup.modulate[0]);
+    modulate = BROADCAST(modulate4);
+
+    if (flags & SDL_COPY_NEAREST) {
+        incy = (info->src_h << 16) / info->dst_h;
+        incx = (info->src_w << 16) / info->dst_w;
+    }
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int srcx = -1;
+        int posx = 0x10000L;
+
+        if (flags & SDL_COPY_NEAREST) {
+            while (posy >= 0x10000L) {
+                ++srcy;
+                posy -= 0x10000L;
+            }
+            src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        }
+        while (n > 0) {
+            const int count = SDL_min(n, WIDTH);
+            VEC pixels, lo, hi;
+
+            if (count < WIDTH) {
+                SDL_zero(buffer);
+            }
+            if (flags & SDL_COPY_NEAREST) {
+                for (i = 0; i < count; ++i) {
+                    while (posx >= 0x10000L) {
+                        ++srcx;
+                        posx -= 0x10000L;
+                    }
+                    buffer[i] = src[srcx];
+                    posx += incx;
+                }
+                pixels = MM_loadu_si256((const VEC *)buffer);
+            } else if (count < WIDTH) {
+                SDL_memcpy(buffer, src, count * sizeof (Uint32));
+                pixels = MM_loadu_si256((const VEC *)buffer);
+                src += count;
+            } else {
+                pixels = MM_loadu_si256((const VEC *)src);
+                src += count;
+            }
+
+            /* Move the channels to the destination byte order */
+            if (setup.identity) {
+                pixels = MM_or_si256(MM_and_si256(pixels, keep), fill);
+            } else {
+                VEC converted = fill;
+                for (i = 0; i < setup.src_channels; ++i) {
+                    converted = MM_or_si256(converted, MM_sll_epi32(MM_and_si256(MM_srl_epi32(pixels, src_shift[i]), byte), dst_shift[i]));
+                }
+                pixels = converted;
+            }
+
+            lo = MM_unpacklo_epi8(pixels, zero);
+            hi = MM_unpackhi_epi8(pixels, zero);
+            if (flags & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA)) {
+                lo = SDL_Blit_Div255_ISA(MM_mullo_epi16(lo, modulate));
+                hi = SDL_Blit_Div255_ISA(MM_mullo_epi16(hi, modulate));
+            }
+
+            if (blend) {
+                VEC dstpixels, dlo, dhi, alo = zero, ahi = zero;
+
+                if (count < WIDTH) {
+                    SDL_memcpy(buffer, dst, count * sizeof (Uint32));
+                    dstpixels = MM_loadu_si256((const VEC *)buffer);
+                } else {
+                    dstpixels = MM_loadu_si256((const VEC *)dst);
+                }
+                dlo = MM_unpacklo_epi8(dstpixels, zero);
+                dhi = MM_unpackhi_epi8(dstpixels, zero);
+
+                if (blend & (SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD)) {
+                    alo = SDL_Blit_SpreadAlpha_ISA(lo, alpha_up);
+                    ahi = SDL_Blit_SpreadAlpha_ISA(hi, alpha_up);
+                }
+                if (blend & (SDL_COPY_BLEND | SDL_COPY_ADD)) {
+                    lo = SDL_Blit_Div255_ISA(MM_mullo_epi16(lo, MM_or_si256(alo, alpha_lanes)));
+                    hi = SDL_Blit_Div255_ISA(MM_mullo_epi16(hi, MM_or_si256(ahi, alpha_lanes)));
+                }
+                switch (blend) {
+                case SDL_COPY_BLEND:
+                case SDL_COPY_BLEND_PREMULTIPLIED:
+                    lo = MM_add_epi16(lo, SDL_Blit_Div255_ISA(MM_mullo_epi16(MM_sub_epi16(opaque, alo), dlo)));
+                    hi = MM_add_epi16(hi, SDL_Blit_Div255_ISA(MM_mullo_epi16(MM_sub_epi16(opaque, ahi), dhi)));
+                    pixels = MM_packus_epi16(lo, hi);
+                    break;
+                case SDL_COPY_ADD:
+                    pixels = MM_adds_epu8(MM_packus_epi16(lo, hi), dstpixels);
+                    pixels = MM_or_si256(MM_andnot_si256(dst_alpha, pixels), MM_and_si256(dst_alpha, dstpixels));
+                    break;
+                case SDL_COPY_MOD:
+                    lo = SDL_Blit_Div255_ISA(MM_mullo_epi16(lo, dlo));
+                    hi = SDL_Blit_Div255_ISA(MM_mullo_epi16(hi, dhi));
+                    pixels = MM_packus_epi16(lo, hi);
+                    pixels = MM_or_si256(MM_andnot_si256(dst_alpha, pixels), MM_and_si256(dst_alpha, dstpixels));
+                    break;
+                default:
+                    pixels = dstpixels;
+                    break;
+                }
+            } else {
+                pixels = MM_packus_epi16(lo, hi);
+            }
+            pixels = MM_and_si256(pixels, mask);
+
+            if (count < WIDTH) {
+                MM_storeu_si256((VEC *)buffer, pixels);
+                SDL_memcpy(dst, buffer, count * sizeof (Uint32));
+            } else {
+                MM_storeu_si256((VEC *)dst, pixels);
+            }
+            dst += count;
+            n -= count;
+        }
+        if (flags & SDL_COPY_NEAREST) {
+            posy += incy;
+        } else {
+            info->src += info->src_pitch;
+        }
+        info->dst += info->dst_pitch;
+    }
+}
+__EOF__
+
+sub output_simdfunc_x86
+{
+    my $isa = shift;
+    my $code = $simd_x86_template;
+
+    if ( $isa eq "SSE2" ) {
+        $code =~ s/MM_(\w+)_si256/_mm_$1_si128/g;
+        $code =~ s/MM_/_mm_/g;
+        $code =~ s/VEC/__m128i/g;
+        $code =~ s/WIDTH/4/g;
+        $code =~ s/ TARGET//g;
+        $code =~ s/BROADCAST\((\w+)\)/$1/g;
+    } else {
+        $code =~ s/MM_/_mm256_/g;
+        $code =~ s/VEC/__m256i/g;
+        $code =~ s/WIDTH/8/g;
+        $code =~ s/TARGET/SDL_TARGETING_AVX2/g;
+        $code =~ s/BROADCAST\((\w+)\)/_mm256_inserti128_si256(_mm256_castsi128_si256($1), $1, 1)/g;
+    }
+    $code =~ s/ISA/$isa/g;
+
+    print FILE "#if HAVE_${isa}_INTRINSICS\n";
+    print FILE $code;
+    print FILE "#endif /* HAVE_${isa}_INTRINSICS */\n\n";
+}
+
+sub output_simdsetup
+{
+    print FILE <<'__EOF__';
+#if HAVE_SSE2_INTRINSICS || HAVE_AVX2_INTRINSICS || HAVE_NEON_INTRINSICS
+
+/* Channel positions of the 8888 pixels as bit shifts, in R, G, B, A order.
+   A format without alpha has it in the unused byte. */
+typedef struct
+{
+    int src_shift[4];
+    int dst_shift[4];
+    int src_channels;       /* 3 if the source has no alpha */
+    Uint32 src_keep;        /* source bits used if the channels don't move */
+    Uint32 src_fill;        /* opaque alpha for a source without alpha */
+    Uint32 dst_mask;        /* destination bits written, the unused byte stays zero */
+    SDL_bool identity;      /* whether the channels are in the same place */
+    Uint16 modulate[4];     /* modulation of each destination byte */
+} SDL_BlitSIMDSetup;
+
+static void
+SDL_Blit_SetupSIMD(const SDL_BlitInfo *info, SDL_BlitSIMDSetup *setup)
+{
+    const SDL_PixelFormat *src = info->src_fmt;
+    const SDL_PixelFormat *dst = info->dst_fmt;
+    const int flags = info->flags;
+    int i;
+
+    setup->src_shift[0] = src->Rshift;
+    setup->src_shift[1] = src->Gshift;
+    setup->src_shift[2] = src->Bshift;
+    setup->src_shift[3] = src->Amask ? src->Ashift : (48 - src->Rshift - src->Gshift - src->Bshift);
+    setup->dst_shift[0] = dst->Rshift;
+    setup->dst_shift[1] = dst->Gshift;
+    setup->dst_shift[2] = dst->Bshift;
+    setup->dst_shift[3] = dst->Amask ? dst->Ashift : (48 - dst->Rshift - dst->Gshift - dst->Bshift);
+
+    setup->src_channels = src->Amask ? 4 : 3;
+    setup->src_keep = src->Amask ? 0xFFFFFFFF : ~(0xFFu << setup->src_shift[3]);
+    setup->src_fill = src->Amask ? 0 : (0xFFu << setup->dst_shift[3]);
+    setup->dst_mask = dst->Amask ? 0xFFFFFFFF : ~(0xFFu << setup->dst_shift[3]);
+    setup->identity = SDL_TRUE;
+    for (i = 0; i < 4; ++i) {
+        if (setup->src_shift[i] != setup->dst_shift[i]) {
+            setup->identity = SDL_FALSE;
+        }
+    }
+
+    setup->modulate[setup->dst_shift[0] / 8] = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    setup->modulate[setup->dst_shift[1] / 8] = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    setup->modulate[setup->dst_shift[2] / 8] = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    setup->modulate[setup->dst_shift[3] / 8] = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+}
+
+#endif
+
+__EOF__
+}
+
+sub output_simdfunc_neon
+{
+    print FILE <<'__EOF__';
+#if HAVE_NEON_INTRINSICS
+SDL_FORCE_INLINE uint16x8_t
+SDL_Blit_Div255_NEON(uint16x8_t x)
+{
+    /* x / 255, exact for the product of two bytes */
+    return vshrq_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8);
+}
+
+SDL_FORCE_INLINE uint16x8_t
+SDL_Blit_SpreadAlpha_NEON(uint16x8_t x, int64x2_t up)
+{
+    /* Copy the alpha of each pixel to all four of its channels */
+    uint64x2_t a = vshrq_n_u64(vshlq_u64(vreinterpretq_u64_u16(x), up), 48);
+    a = vorrq_u64(a, vshlq_n_u64(a, 16));
+    return vreinterpretq_u16_u64(vorrq_u64(a, vshlq_n_u64(a, 32)));
+}
+
+SDL_FORCE_INLINE uint32x4_t
+SDL_Blit_Pack_NEON(uint16x8_t lo, uint16x8_t hi)
+{
+    return vreinterpretq_u32_u8(vcombine_u8(vqmovn_u16(lo), vqmovn_u16(hi)));
+}
+
+static void
+SDL_Blit_8888_NEON(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const int blend = flags & (SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_MOD);
+    const uint32x4_t byte = vdupq_n_u32(0xFF);
+    const uint16x8_t opaque = vdupq_n_u16(255);
+    SDL_BlitSIMDSetup setup;
+    int32x4_t src_shift[4], dst_shift[4];
+    int64x2_t alpha_up;
+    uint32x4_t keep, fill, mask, dst_alpha;
+    uint16x8_t alpha_lanes, modulate;
+    Uint16 modulate8[8];
+    Uint32 buffer[4];
+    int srcy = 0, posy = 0, incy = 0, incx = 0;
+    int i;
+
+    SDL_Blit_SetupSIMD(info, &setup);
+    for (i = 0; i < 4; ++i) {
+        src_shift[i] = vdupq_n_s32(-setup.src_shift[i]);
+        dst_shift[i] = vdupq_n_s32(setup.dst_shift[i]);
+        modulate8[i] = modulate8[i + 4] = setup.modulate[i];
+    }
+    alpha_up = vdupq_n_s64(48 - 2 * setup.dst_shift[3]);
+    keep = vdupq_n_u32(setup.src_keep);
+    fill = vdupq_n_u32(setup.src_fill);
+    mask = vdupq_n_u32(setup.dst_mask);
+    dst_alpha = vdupq_n_u32(0xFFu << setup.dst_shift[3]);
+    alpha_lanes = vmovl_u8(vget_low_u8(vreinterpretq_u8_u32(dst_alpha)));
+    modulate = vld1q_u16(modulate8);
+
+    if (flags & SDL_COPY_NEAREST) {
+        incy = (info->src_h << 16) / info->dst_h;
+        incx = (info->src_w << 16) / info->dst_w;
+    }
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int srcx = -1;
+        int posx = 0x10000L;
+
+        if (flags & SDL_COPY_NEAREST) {
+            while (posy >= 0x10000L) {
+                ++srcy;
+                posy -= 0x10000L;
+            }
+            src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        }
+        while (n > 0) {
+            const int count = SDL_min(n, 4);
+            uint32x4_t pixels;
+            uint16x8_t lo, hi;
+
+            if (count < 4) {
+                SDL_zero(buffer);
+            }
+            if (flags & SDL_COPY_NEAREST) {
+                for (i = 0; i < count; ++i) {
+                    while (posx >= 0x10000L) {
+                        ++srcx;
+                        posx -= 0x10000L;
+                    }
+                    buffer[i] = src[srcx];
+                    posx += incx;
+                }
+                pixels = vld1q_u32(buffer);
+            } else if (count < 4) {
+                SDL_memcpy(buffer, src, count * sizeof (Uint32));
+                pixels = vld1q_u32(buffer);
+                src += count;
+            } else {
+                pixels = vld1q_u32(src);
+                src += count;
+            }
+
+            /* Move the channels to the destination byte order */
+            if (setup.identity) {
+                pixels = vorrq_u32(vandq_u32(pixels, keep), fill);
+            } else {
+                uint32x4_t converted = fill;
+                for (i = 0; i < setup.src_channels; ++i) {
+                    converted = vorrq_u32(converted, vshlq_u32(vandq_u32(vshlq_u32(pixels, src_shift[i]), byte), dst_shift[i]));
+                }
+                pixels = converted;
+            }
+
+            lo = vmovl_u8(vget_low_u8(vreinterpretq_u8_u32(pixels)));
+            hi = vmovl_u8(vget_high_u8(vreinterpretq_u8_u32(pixels)));
+            if (flags & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA)) {
+                lo = SDL_Blit_Div255_NEON(vmulq_u16(lo, modulate));
+                hi = SDL_Blit_Div255_NEON(vmulq_u16(hi, modulate));
+            }
+
+            if (blend) {
+                uint32x4_t dstpixels;
+                uint16x8_t dlo, dhi, alo = vdupq_n_u16(0), ahi = vdupq_n_u16(0);
+
+                if (count < 4) {
+                    SDL_memcpy(buffer, dst, count * sizeof (Uint32));
+                    dstpixels = vld1q_u32(buffer);
+                } else {
+                    dstpixels = vld1q_u32(dst);
+                }
+                dlo = vmovl_u8(vget_low_u8(vreinterpretq_u8_u32(dstpixels)));
+                dhi = vmovl_u8(vget_high_u8(vreinterpretq_u8_u32(dstpixels)));
+
+                if (blend & (SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD)) {
+                    alo = SDL_Blit_SpreadAlpha_NEON(lo, alpha_up);
+                    ahi = SDL_Blit_SpreadAlpha_NEON(hi, alpha_up);
+                }
+                if (blend & (SDL_COPY_BLEND | SDL_COPY_ADD)) {
+                    lo = SDL_Blit_Div255_NEON(vmulq_u16(lo, vorrq_u16(alo, alpha_lanes)));
+                    hi = SDL_Blit_Div255_NEON(vmulq_u16(hi, vorrq_u16(ahi, alpha_lanes)));
+                }
+                switch (blend) {
+                case SDL_COPY_BLEND:
+                case SDL_COPY_BLEND_PREMULTIPLIED:
+                    lo = vaddq_u16(lo, SDL_Blit_Div255_NEON(vmulq_u16(vsubq_u16(opaque, alo), dlo)));
+                    hi = vaddq_u16(hi, SDL_Blit_Div255_NEON(vmulq_u16(vsubq_u16(opaque, ahi), dhi)));
+                    pixels = SDL_Blit_Pack_NEON(lo, hi);
+                    break;
+                case SDL_COPY_ADD:
+                    pixels = vreinterpretq_u32_u8(vqaddq_u8(vreinterpretq_u8_u32(SDL_Blit_Pack_NEON(lo, hi)), vreinterpretq_u8_u32(dstpixels)));
+                    pixels = vbslq_u32(dst_alpha, dstpixels, pixels);
+                    break;
+                case SDL_COPY_MOD:
+                    lo = SDL_Blit_Div255_NEON(vmulq_u16(lo, dlo));
+                    hi = SDL_Blit_Div255_NEON(vmulq_u16(hi, dhi));
+                    pixels = vbslq_u32(dst_alpha, dstpixels, SDL_Blit_Pack_NEON(lo, hi));
+                    break;
+                default:
+                    pixels = dstpixels;
+                    break;
+                }
+            } else {
+                pixels = SDL_Blit_Pack_NEON(lo, hi);
+            }
+            pixels = vandq_u32(pixels, mask);
+
+            if (count < 4) {
+                vst1q_u32(buffer, pixels);
+                SDL_memcpy(dst, buffer, count * sizeof (Uint32));
+            } else {
+                vst1q_u32(dst, pixels);
+            }
+            dst += count;
+            n -= count;
+        }
+        if (flags & SDL_COPY_NEAREST) {
+            posy += incy;
+        } else {
+            info->src += info->src_pitch;
+        }
+        info->dst += info->dst_pitch;
+    }
+}
+#endif /* HAVE_NEON_INTRINSICS */
 
 __EOF__
 }
 
+sub output_simdfunctable
+{
+    my $isa = shift;
+    my $cpu = shift;
+
+    print FILE "#if HAVE_${isa}_INTRINSICS\n";
+    for (my $i = 0; $i <= $#src_formats; ++$i) {
+        for (my $j = 0; $j <= $#dst_formats; ++$j) {
+            print FILE "    { SDL_PIXELFORMAT_$src_formats[$i], SDL_PIXELFORMAT_$dst_formats[$j], (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), $cpu, SDL_Blit_8888_${isa} },\n";
+        }
+    }
+    print FILE "#endif\n";
+}
+
 sub output_copyfunctable
 {
     print FILE <<__EOF__;
 SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
 __EOF__
+    output_simdfunctable("AVX2", "SDL_CPU_AVX2");
+    output_simdfunctable("SSE2", "SDL_CPU_SSE2");
+    output_simdfunctable("NEON", "SDL_CPU_NEON");
     for (my $i = 0; $i <= $#src_formats; ++$i) {
         my $src = $src_formats[$i];
         for (my $j = 0; $j <= $#dst_formats; ++$j) {
@@ -465,7 +948,7 @@ __EOF__
                                 }
                             }
                             if ( $blend ) {
-                                $flag = "SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD";
+                                $flag = "SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_ADD | SDL_COPY_MOD";
                                 if ( $flags eq "" ) {
                                     $flags = $flag;
                                 } else {
@@ -531,5 +1014,9 @@ for (my $i = 0; $i <= $#src_formats; ++$i) {
         output_copyfunc_c($src_formats[$i], $dst_formats[$j]);
     }
 }
+output_simdsetup();
+output_simdfunc_x86("SSE2");
+output_simdfunc_x86("AVX2");
+output_simdfunc_neon();
 output_copyfunctable();
 close_file("SDL_blit_auto.c");
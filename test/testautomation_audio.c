@@ -967,8 +967,624 @@ int audio_openCloseAudioDeviceConnected()
    return TEST_COMPLETED;
 }
 
+/**
+ * \brief Checks that resampling a sine wave keeps it intact and filters out tones above the new Nyquist frequency.
+ *
+ * \sa https://wiki.libsdl.org/SDL_BuildAudioCVT
+ * \sa https://wiki.libsdl.org/SDL_ConvertAudio
+ */
+int audio_resampleLoss()
+{
+  /* Source rate, destination rate, tone frequency, whether the tone should survive */
+  const struct {
+      int src_rate;
+      int dst_rate;
+      double frequency;
+      SDL_bool passes;
+  } test_specs[] = {
+      { 44100, 48000, 1000.0, SDL_TRUE },
+      { 44100, 48000, 15000.0, SDL_TRUE },
+      { 48000, 44100, 5000.0, SDL_TRUE },
+      { 22050, 96000, 3000.0, SDL_TRUE },
+      { 96000, 8000, 500.0, SDL_TRUE },
+      { 48000, 22050, 15000.0, SDL_FALSE },
+  };
+  int spec_idx;
+
+  for (spec_idx = 0; spec_idx < SDL_arraysize(test_specs); ++spec_idx) {
+    const int frames = test_specs[spec_idx].src_rate / 4;
+    const double amplitude = 0.5;
+    SDL_AudioCVT cvt;
+    float *buf;
+    int ret, i, skip, output_frames, expected_frames;
+    double sum_squared_error = 0.0, sum_squared_value = 0.0;
+
+    SDLTest_AssertPass("Test resampling of %.0f Hz tone from %i to %i Hz", test_specs[spec_idx].frequency,
+                       test_specs[spec_idx].src_rate, test_specs[spec_idx].dst_rate);
+
+    ret = SDL_BuildAudioCVT(&cvt, AUDIO_F32SYS, 1, test_specs[spec_idx].src_rate,
+                            AUDIO_F32SYS, 1, test_specs[spec_idx].dst_rate);
+    SDLTest_AssertPass("Call to SDL_BuildAudioCVT(&cvt, AUDIO_F32SYS, 1, %i, AUDIO_F32SYS, 1, %i)",
+                       test_specs[spec_idx].src_rate, test_specs[spec_idx].dst_rate);
+    SDLTest_AssertCheck(ret == 1, "Verify result value; expected: 1; got: %i", ret);
+    if (ret != 1) {
+      return TEST_ABORTED;
+    }
+
+    cvt.len = frames * sizeof(float);
+    buf = (float *)SDL_malloc(cvt.len * cvt.len_mult);
+    SDLTest_AssertCheck(buf != NULL, "Check data buffer to convert is not NULL");
+    if (buf == NULL) {
+      return TEST_ABORTED;
+    }
+    for (i = 0; i < frames; ++i) {
+      buf[i] = (float)(amplitude * SDL_sin(2.0 * M_PI * test_specs[spec_idx].frequency * i / test_specs[spec_idx].src_rate));
+    }
+
+    cvt.buf = (Uint8 *)buf;
+    ret = SDL_ConvertAudio(&cvt);
+    SDLTest_AssertPass("Call to SDL_ConvertAudio(&cvt)");
+    SDLTest_AssertCheck(ret == 0, "Verify result value; expected: 0; got: %i", ret);
+
+    output_frames = cvt.len_cvt / sizeof(float);
+    expected_frames = (int)(((Sint64)frames * test_specs[spec_idx].dst_rate) / test_specs[spec_idx].src_rate);
+    SDLTest_AssertCheck(output_frames == expected_frames, "Verify output length; expected: %i; got: %i",
+                        expected_frames, output_frames);
+
+    /* Skip the edges, where the filter runs into the silence around the buffer */
+    skip = test_specs[spec_idx].dst_rate / 100;
+    for (i = skip; i < output_frames - skip; ++i) {
+      const double expected = test_specs[spec_idx].passes ?
+          amplitude * SDL_sin(2.0 * M_PI * test_specs[spec_idx].frequency * i / test_specs[spec_idx].dst_rate) : 0.0;
+      const double error = buf[i] - expected;
+      sum_squared_error += error * error;
+      sum_squared_value += expected * expected;
+    }
+    if (test_specs[spec_idx].passes) {
+      /* At least 50 dB signal to noise */
+      SDLTest_AssertCheck(sum_squared_error * 100000.0 < sum_squared_value,
+                          "Verify signal to noise ratio; error energy %f, signal energy %f", sum_squared_error, sum_squared_value);
+    } else {
+      /* At least 50 dB of attenuation */
+      const double input_energy = (output_frames - 2 * skip) * amplitude * amplitude / 2.0;
+      SDLTest_AssertCheck(sum_squared_error * 100000.0 < input_energy,
+                          "Verify the tone was filtered out; remaining energy %f, input energy %f", sum_squared_error, input_energy);
+    }
+
+    SDL_free(buf);
+  }
+
+  return TEST_COMPLETED;
+}
+
+
+/**
+ * \brief Checks conversions that remix or resample together with a format change against doing each step on its own.
+ *
+ * \sa https://wiki.libsdl.org/SDL_BuildAudioCVT
+ * \sa https://wiki.libsdl.org/SDL_ConvertAudio
+ */
+int audio_convertFused()
+{
+  const int frames = 4410;
+  const int dst_frames = (int)(((Sint64)frames * 48000) / 44100);
+  SDL_AudioCVT cvt, ref_cvt;
+  float *signal, *expected;
+  Uint8 *buf;
+  int ret, i, errors;
+
+  signal = (float *)SDL_malloc(frames * 4 * sizeof(float));
+  expected = (float *)SDL_malloc(dst_frames * 2 * sizeof(float));
+  buf = (Uint8 *)SDL_malloc(frames * 8 * 4);
+  SDLTest_AssertCheck(signal != NULL && expected != NULL && buf != NULL, "Check data buffers are not NULL");
+  if (signal == NULL || expected == NULL || buf == NULL) {
+    SDL_free(signal);
+    SDL_free(expected);
+    SDL_free(buf);
+    return TEST_ABORTED;
+  }
+
+  /* Big endian S16 stereo at 44100 Hz to float mono at 48000 Hz */
+  for (i = 0; i < frames; ++i) {
+    const Sint16 left = (Sint16)(16000.0 * SDL_sin(2.0 * M_PI * 440.0 * i / 44100));
+    const Sint16 right = (Sint16)(8000.0 * SDL_sin(2.0 * M_PI * 1000.0 * i / 44100));
+    ((Uint16 *)buf)[i * 2] = SDL_SwapBE16((Uint16)left);
+    ((Uint16 *)buf)[i * 2 + 1] = SDL_SwapBE16((Uint16)right);
+    expected[i] = ((left / 32768.0f) + (right / 32768.0f)) * 0.5f;
+  }
+  ret = SDL_BuildAudioCVT(&ref_cvt, AUDIO_F32SYS, 1, 44100, AUDIO_F32SYS, 1, 48000);
+  SDLTest_AssertCheck(ret == 1, "Verify reference SDL_BuildAudioCVT result; expected: 1; got: %i", ret);
+  ref_cvt.buf = (Uint8 *)expected;
+  ref_cvt.len = frames * sizeof(float);
+  SDLTest_AssertCheck(ref_cvt.len * ref_cvt.len_mult <= dst_frames * 2 * (int)sizeof(float), "Check reference buffer is big enough");
+  ret = SDL_ConvertAudio(&ref_cvt);
+  SDLTest_AssertCheck(ret == 0, "Verify reference SDL_ConvertAudio result; expected: 0; got: %i", ret);
+
+  ret = SDL_BuildAudioCVT(&cvt, AUDIO_S16MSB, 2, 44100, AUDIO_F32SYS, 1, 48000);
+  SDLTest_AssertPass("Call to SDL_BuildAudioCVT(&cvt, AUDIO_S16MSB, 2, 44100, AUDIO_F32SYS, 1, 48000)");
+  SDLTest_AssertCheck(ret == 1, "Verify result value; expected: 1; got: %i", ret);
+  cvt.buf = buf;
+  cvt.len = frames * 2 * sizeof(Sint16);
+  SDLTest_AssertCheck(cvt.len * cvt.len_mult <= frames * 8 * 4, "Check buffer is big enough; len_mult %i", cvt.len_mult);
+  ret = SDL_ConvertAudio(&cvt);
+  SDLTest_AssertCheck(ret == 0, "Verify result value; expected: 0; got: %i", ret);
+  SDLTest_AssertCheck(cvt.len_cvt == ref_cvt.len_cvt, "Verify output length; expected: %i; got: %i", ref_cvt.len_cvt, cvt.len_cvt);
+  for (i = 0, errors = 0; i < SDL_min(cvt.len_cvt, ref_cvt.len_cvt) / (int)sizeof(float); ++i) {
+    if (SDL_fabs(((float *)buf)[i] - expected[i]) > 0.0001) {
+      errors++;
+    }
+  }
+  SDLTest_AssertCheck(errors == 0, "Verify samples match converting step by step; %i differ", errors);
+
+  /* U8 mono at 44100 Hz to S16 stereo at 48000 Hz */
+  for (i = 0; i < frames; ++i) {
+    buf[i] = (Uint8)(128.0 + 100.0 * SDL_sin(2.0 * M_PI * 440.0 * i / 44100));
+    signal[i] = (buf[i] / 128.0f) - 1.0f;
+  }
+  ref_cvt.buf = (Uint8 *)signal;
+  ref_cvt.len = frames * sizeof(float);
+  ret = SDL_ConvertAudio(&ref_cvt);
+  SDLTest_AssertCheck(ret == 0, "Verify reference SDL_ConvertAudio result; expected: 0; got: %i", ret);
+
+  ret = SDL_BuildAudioCVT(&cvt, AUDIO_U8, 1, 44100, AUDIO_S16SYS, 2, 48000);
+  SDLTest_AssertPass("Call to SDL_BuildAudioCVT(&cvt, AUDIO_U8, 1, 44100, AUDIO_S16SYS, 2, 48000)");
+  SDLTest_AssertCheck(ret == 1, "Verify result value; expected: 1; got: %i", ret);
+  cvt.buf = buf;
+  cvt.len = frames;
+  SDLTest_AssertCheck(cvt.len * cvt.len_mult <= frames * 8 * 4, "Check buffer is big enough; len_mult %i", cvt.len_mult);
+  ret = SDL_ConvertAudio(&cvt);
+  SDLTest_AssertCheck(ret == 0, "Verify result value; expected: 0; got: %i", ret);
+  SDLTest_AssertCheck(cvt.len_cvt == ref_cvt.len_cvt, "Verify output length; expected: %i; got: %i", ref_cvt.len_cvt, cvt.len_cvt);
+  for (i = 0, errors = 0; i < SDL_min(cvt.len_cvt / 4, ref_cvt.len_cvt / (int)sizeof(float)); ++i) {
+    const int sample = (Sint16)(signal[i] * 32767.0f);
+    if (SDL_abs(((Sint16 *)buf)[i * 2] - sample) > 1 || ((Sint16 *)buf)[i * 2 + 1] != ((Sint16 *)buf)[i * 2]) {
+      errors++;
+    }
+  }
+  SDLTest_AssertCheck(errors == 0, "Verify samples match converting step by step; %i differ", errors);
+
+  /* S32 quad to S16 mono averages all four channels */
+  for (i = 0; i < frames * 4; ++i) {
+    ((Sint32 *)buf)[i] = (Sint32)(((i % 4) - 1.5) * 0x10000000);
+    signal[i] = (float)((((i % 4) - 1.5) * 0x10000000) / 2147483648.0);
+  }
+  ret = SDL_BuildAudioCVT(&cvt, AUDIO_S32SYS, 4, 44100, AUDIO_S16SYS, 1, 44100);
+  SDLTest_AssertPass("Call to SDL_BuildAudioCVT(&cvt, AUDIO_S32SYS, 4, 44100, AUDIO_S16SYS, 1, 44100)");
+  SDLTest_AssertCheck(ret == 1, "Verify result value; expected: 1; got: %i", ret);
+  cvt.buf = buf;
+  cvt.len = frames * 4 * sizeof(Sint32);
+  ret = SDL_ConvertAudio(&cvt);
+  SDLTest_AssertCheck(ret == 0, "Verify result value; expected: 0; got: %i", ret);
+  SDLTest_AssertCheck(cvt.len_cvt == frames * (int)sizeof(Sint16), "Verify output length; expected: %i; got: %i",
+                      frames * (int)sizeof(Sint16), cvt.len_cvt);
+  for (i = 0, errors = 0; i < cvt.len_cvt / (int)sizeof(Sint16); ++i) {
+    const float mixed = ((signal[i * 4] + signal[i * 4 + 2]) * 0.5f + (signal[i * 4 + 1] + signal[i * 4 + 3]) * 0.5f) * 0.5f;
+    if (SDL_abs(((Sint16 *)buf)[i] - (Sint16)(mixed * 32767.0f)) > 1) {
+      errors++;
+    }
+  }
+  SDLTest_AssertCheck(errors == 0, "Verify samples are the average of the four channels; %i differ", errors);
+
+  SDL_free(signal);
+  SDL_free(expected);
+  SDL_free(buf);
+  return TEST_COMPLETED;
+}
+
+
+/**
+ * \brief Queues more audio than fits in a callback's worth of buffering and checks it is all accounted for, cleared and played.
+ *
+ * \sa https://wiki.libsdl.org/SDL_QueueAudio
+ * \sa https://wiki.libsdl.org/SDL_GetQueuedAudioSize
+ * \sa https://wiki.libsdl.org/SDL_ClearQueuedAudio
+ */
+int audio_queueAudio()
+{
+   SDL_AudioDeviceID id;
+   SDL_AudioSpec desired, obtained;
+   Uint8 data[1000];
+   Uint8 *big;
+   Uint32 queued, total, expected;
+   Uint32 start;
+   int result;
+   SDL_bool started = SDL_FALSE;
+
+   /* Earlier tests quit the audio driver behind the subsystem's back */
+   if (SDL_GetCurrentAudioDriver() == NULL) {
+     result = SDL_AudioInit(NULL);
+     SDLTest_AssertPass("Call to SDL_AudioInit(NULL)");
+     if (result != 0) {
+       SDLTest_Log("No audio driver to test with");
+       return TEST_COMPLETED;
+     }
+     started = SDL_TRUE;
+   }
+
+   /* Two seconds of audio goes well past what the audio thread buffers itself */
+   desired.freq=22050;
+   desired.format=AUDIO_S16SYS;
+   desired.channels=2;
+   desired.samples=1024;
+   desired.callback=NULL;
+   desired.userdata=NULL;
+   id = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, 0);
+   SDLTest_AssertPass("Call to SDL_OpenAudioDevice(NULL, 0, ...) with no callback");
+   if (id == 0) {
+     SDLTest_Log("No device to test with");
+     if (started) {
+       SDL_AudioQuit();
+     }
+     return TEST_COMPLETED;
+   }
+   total = obtained.freq * obtained.channels * 2 * 2;
+
+   SDL_memset(data, 0, sizeof(data));
+   for (queued = 0; queued < total; queued += sizeof(data)) {
+     result = SDL_QueueAudio(id, data, sizeof(data));
+     if (result != 0) {
+       break;
+     }
+   }
+   SDLTest_AssertPass("Call to SDL_QueueAudio(id, data, %i) until %i bytes are queued", (int)sizeof(data), (int)queued);
+   SDLTest_AssertCheck(result == 0, "Verify result value; expected: 0; got: %i", result);
+   expected = SDL_GetQueuedAudioSize(id);
+   SDLTest_AssertPass("Call to SDL_GetQueuedAudioSize(id)");
+   SDLTest_AssertCheck(expected == queued, "Verify queued size while paused; expected: %i; got: %i", (int)queued, (int)expected);
+
+   SDL_ClearQueuedAudio(id);
+   SDLTest_AssertPass("Call to SDL_ClearQueuedAudio(id)");
+   expected = SDL_GetQueuedAudioSize(id);
+   SDLTest_AssertCheck(expected == 0, "Verify queued size after clearing; expected: 0; got: %i", (int)expected);
+
+   /* A quarter second in one call, then let it play out */
+   queued = total / 8;
+   result = SDL_QueueAudio(id, NULL, 0);
+   SDLTest_AssertCheck(result == 0, "Verify queueing nothing succeeds; got: %i", result);
+   big = (Uint8 *)SDL_calloc(1, queued);
+   SDLTest_AssertCheck(big != NULL, "Check data buffer to queue is not NULL");
+   if (big == NULL) {
+     SDL_CloseAudioDevice(id);
+     if (started) {
+       SDL_AudioQuit();
+     }
+     return TEST_ABORTED;
+   }
+   result = SDL_QueueAudio(id, big, queued);
+   SDL_free(big);
+   SDLTest_AssertCheck(result == 0, "Verify result value; expected: 0; got: %i", result);
+   expected = SDL_GetQueuedAudioSize(id);
+   SDLTest_AssertCheck(expected == queued, "Verify queued size; expected: %i; got: %i", (int)queued, (int)expected);
+
+   SDL_PauseAudioDevice(id, 0);
+   SDLTest_AssertPass("Call to SDL_PauseAudioDevice(id, 0)");
+   start = SDL_GetTicks();
+   while ((SDL_GetQueuedAudioSize(id) > 0) && !SDL_TICKS_PASSED(SDL_GetTicks(), start + 3000)) {
+     SDL_Delay(10);
+   }
+   expected = SDL_GetQueuedAudioSize(id);
+   SDLTest_AssertCheck(expected < queued, "Verify the queued audio is being played; %i of %i bytes left", (int)expected, (int)queued);
+
+   SDL_CloseAudioDevice(id);
+   SDLTest_AssertPass("Call to SDL_CloseAudioDevice(id)");
+   if (started) {
+     SDL_AudioQuit();
+   }
+
+   return TEST_COMPLETED;
+}
 
 
+/**
+ * \brief Mixes every sample format at several volumes and checks each sample against the documented clipping and volume scaling.
+ *
+ * \sa https://wiki.libsdl.org/SDL_MixAudioFormat
+ */
+int audio_mixAudioFormat()
+{
+  const SDL_AudioFormat formats[] = { AUDIO_S16LSB, AUDIO_S16MSB, AUDIO_S32LSB, AUDIO_S32MSB, AUDIO_F32LSB, AUDIO_F32MSB };
+  const int volumes[] = { 1, 37, 100, SDL_MIX_MAXVOLUME };
+  const int samples = 1003;  /* not a multiple of any vector size */
+  const Sint32 max_s32 = 0x7FFFFFFF;
+  const Sint32 min_s32 = -max_s32 - 1;
+  Uint32 *src, *dst, *expected;
+  int i, j, k, errors;
+
+  src = (Uint32 *)SDL_malloc(samples * sizeof(Uint32));
+  dst = (Uint32 *)SDL_malloc((samples + 1) * sizeof(Uint32));
+  expected = (Uint32 *)SDL_malloc(samples * sizeof(Uint32));
+  SDLTest_AssertCheck(src != NULL && dst != NULL && expected != NULL, "Check data buffers are not NULL");
+  if (src == NULL || dst == NULL || expected == NULL) {
+    SDL_free(src);
+    SDL_free(dst);
+    SDL_free(expected);
+    return TEST_ABORTED;
+  }
+
+  for (i = 0; i < SDL_arraysize(formats); ++i) {
+    const SDL_AudioFormat format = formats[i];
+    const int bits = SDL_AUDIO_BITSIZE(format);
+    const int n = samples * 32 / bits;
+
+    for (j = 0; j < SDL_arraysize(volumes); ++j) {
+      const int volume = volumes[j];
+
+      /* Random samples, with runs at the limits to check saturation */
+      for (k = 0; k < n; ++k) {
+        Sint32 s, d;
+        if (bits == 16) {
+          s = SDLTest_RandomSint16();
+          d = SDLTest_RandomSint16();
+          if ((k % 7) == 0) {
+            s = (k % 2) ? 32767 : -32768;
+            d = s;
+          }
+          ((Uint16 *)src)[k] = SDL_AUDIO_ISBIGENDIAN(format) ? SDL_SwapBE16((Uint16)s) : SDL_SwapLE16((Uint16)s);
+          ((Uint16 *)dst)[k] = SDL_AUDIO_ISBIGENDIAN(format) ? SDL_SwapBE16((Uint16)d) : SDL_SwapLE16((Uint16)d);
+          s = (s * volume) / SDL_MIX_MAXVOLUME;
+          ((Sint16 *)expected)[k] = (Sint16)SDL_max(-32768, SDL_min(32767, s + d));
+        } else if (SDL_AUDIO_ISFLOAT(format)) {
+          float fs = SDLTest_RandomUnitFloat() * 3.0f - 1.5f;
+          float fd = SDLTest_RandomUnitFloat() * 3.0f - 1.5f;
+          double sum;
+          if ((k % 7) == 0) {
+            fs = (k % 2) ? 3.0e+38f : -3.0e+38f;
+            fd = fs;
+          }
+          ((float *)src)[k] = SDL_AUDIO_ISBIGENDIAN(format) ? SDL_SwapFloatBE(fs) : SDL_SwapFloatLE(fs);
+          ((float *)dst)[k] = SDL_AUDIO_ISBIGENDIAN(format) ? SDL_SwapFloatBE(fd) : SDL_SwapFloatLE(fd);
+          sum = (double)(fs * ((float)volume / SDL_MIX_MAXVOLUME)) + fd;
+          ((float *)expected)[k] = (float)SDL_max(-3.402823466e+38, SDL_min(3.402823466e+38, sum));
+        } else {
+          Sint64 s64;
+          s = SDLTest_RandomSint32();
+          d = SDLTest_RandomSint32();
+          if ((k % 7) == 0) {
+            s = (k % 2) ? max_s32 : min_s32;
+            d = s;
+          }
+          src[k] = SDL_AUDIO_ISBIGENDIAN(format) ? SDL_SwapBE32((Uint32)s) : SDL_SwapLE32((Uint32)s);
+          dst[k] = SDL_AUDIO_ISBIGENDIAN(format) ? SDL_SwapBE32((Uint32)d) : SDL_SwapLE32((Uint32)d);
+          s64 = (((Sint64)s) * volume) / SDL_MIX_MAXVOLUME + d;
+          ((Sint32 *)expected)[k] = (Sint32)SDL_max(min_s32, SDL_min(max_s32, s64));
+        }
+      }
+      dst[samples] = 0xDEADBEEF;
+
+      SDL_MixAudioFormat((Uint8 *)dst, (const Uint8 *)src, format, samples * sizeof(Uint32), volume);
+      SDLTest_AssertPass("Call to SDL_MixAudioFormat(dst, src, 0x%.4x, %i, %i)", format, samples * (int)sizeof(Uint32), volume);
+
+      for (k = 0, errors = 0; k < n; ++k) {
+        if (bits == 16) {
+          const Uint16 sample = ((Uint16 *)dst)[k];
+          if ((Sint16)(SDL_AUDIO_ISBIGENDIAN(format) ? SDL_SwapBE16(sample) : SDL_SwapLE16(sample)) != ((Sint16 *)expected)[k]) {
+            errors++;
+          }
+        } else if (SDL_AUDIO_ISFLOAT(format)) {
+          const float sample = ((float *)dst)[k];
+          if ((SDL_AUDIO_ISBIGENDIAN(format) ? SDL_SwapFloatBE(sample) : SDL_SwapFloatLE(sample)) != ((float *)expected)[k]) {
+            errors++;
+          }
+        } else {
+          const Uint32 sample = dst[k];
+          if ((Sint32)(SDL_AUDIO_ISBIGENDIAN(format) ? SDL_SwapBE32(sample) : SDL_SwapLE32(sample)) != ((Sint32 *)expected)[k]) {
+            errors++;
+          }
+        }
+      }
+      SDLTest_AssertCheck(errors == 0, "Verify mixed samples; %i of %i differ", errors, n);
+      SDLTest_AssertCheck(dst[samples] == 0xDEADBEEF, "Verify the sample after the buffer is untouched");
+    }
+  }
+
+  SDL_free(src);
+  SDL_free(dst);
+  SDL_free(expected);
+
+  return TEST_COMPLETED;
+}
+
+/**
+ * \brief Mixes voices of different formats with gain, pan and pause, and plays a mixer on a device.
+ *
+ * \sa https://wiki.libsdl.org/SDL_CreateAudioMixer
+ * \sa https://wiki.libsdl.org/SDL_AddAudioVoice
+ * \sa https://wiki.libsdl.org/SDL_MixAudioVoices
+ */
+int audio_audioMixer()
+{
+  const int frames = 1024;
+  SDL_AudioMixer *mixer;
+  SDL_AudioVoice *voice1, *voice2, *voice3;
+  SDL_AudioDeviceID id;
+  SDL_AudioSpec desired;
+  float mono[1024];
+  Sint16 stereo[1024 * 2];
+  Sint16 out[1024 * 2];
+  Sint8 slow[512];
+  int i, j, result, queued, errors;
+  Uint32 start;
+  SDL_bool started = SDL_FALSE;
+
+  /* Negative cases */
+  mixer = SDL_CreateAudioMixer(0x1234, 2, 48000);
+  SDLTest_AssertCheck(mixer == NULL, "Verify SDL_CreateAudioMixer fails for an invalid format");
+  mixer = SDL_CreateAudioMixer(AUDIO_S16SYS, 3, 48000);
+  SDLTest_AssertCheck(mixer == NULL, "Verify SDL_CreateAudioMixer fails for 3 channels");
+  mixer = SDL_CreateAudioMixer(AUDIO_S16SYS, 2, 0);
+  SDLTest_AssertCheck(mixer == NULL, "Verify SDL_CreateAudioMixer fails for a rate of 0");
+
+  mixer = SDL_CreateAudioMixer(AUDIO_S16SYS, 2, 48000);
+  SDLTest_AssertPass("Call to SDL_CreateAudioMixer(AUDIO_S16SYS, 2, 48000)");
+  SDLTest_AssertCheck(mixer != NULL, "Verify mixer is not NULL");
+  if (mixer == NULL) {
+    return TEST_ABORTED;
+  }
+  result = SDL_MixAudioVoices(mixer, (Uint8 *)out, 3);
+  SDLTest_AssertCheck(result == -1, "Verify mixing a partial frame fails; got: %i", result);
+
+  /* No voices mix to silence */
+  SDL_memset(out, 0x55, sizeof(out));
+  result = SDL_MixAudioVoices(mixer, (Uint8 *)out, sizeof(out));
+  SDLTest_AssertCheck(result == 0, "Verify result value; expected: 0; got: %i", result);
+  for (i = 0, errors = 0; i < frames * 2; ++i) {
+    if (out[i] != 0) {
+      errors++;
+    }
+  }
+  SDLTest_AssertCheck(errors == 0, "Verify an empty mixer mixes silence; %i samples differ", errors);
+
+  /* 0.75 + 0.75 - 0.75 clips only at the end, so it mixes to 0.75 */
+  voice1 = SDL_AddAudioVoice(mixer, AUDIO_F32SYS, 1, 48000);
+  voice2 = SDL_AddAudioVoice(mixer, AUDIO_S16SYS, 2, 48000);
+  voice3 = SDL_AddAudioVoice(mixer, AUDIO_S16SYS, 2, 48000);
+  SDLTest_AssertPass("Call to SDL_AddAudioVoice() for three voices");
+  SDLTest_AssertCheck(voice1 != NULL && voice2 != NULL && voice3 != NULL, "Verify voices are not NULL");
+  if (voice1 == NULL || voice2 == NULL || voice3 == NULL) {
+    SDL_FreeAudioMixer(mixer);
+    return TEST_ABORTED;
+  }
+  for (i = 0; i < frames; ++i) {
+    mono[i] = 0.75f;
+    stereo[i * 2] = stereo[i * 2 + 1] = 24576;
+  }
+  result = SDL_PutAudioVoiceData(voice1, mono, sizeof(mono));
+  SDLTest_AssertCheck(result == 0, "Verify SDL_PutAudioVoiceData result; expected: 0; got: %i", result);
+  result = SDL_PutAudioVoiceData(voice2, stereo, sizeof(stereo));
+  SDLTest_AssertCheck(result == 0, "Verify SDL_PutAudioVoiceData result; expected: 0; got: %i", result);
+  for (i = 0; i < frames * 2; ++i) {
+    stereo[i] = -24576;
+  }
+  result = SDL_PutAudioVoiceData(voice3, stereo, sizeof(stereo));
+  SDLTest_AssertCheck(result == 0, "Verify SDL_PutAudioVoiceData result; expected: 0; got: %i", result);
+  result = SDL_PutAudioVoiceData(voice3, stereo, 3);
+  SDLTest_AssertCheck(result == -1, "Verify putting a partial frame fails; got: %i", result);
+  queued = SDL_GetAudioVoiceQueuedFrames(voice1);
+  SDLTest_AssertCheck(queued == frames, "Verify queued frames; expected: %i; got: %i", frames, queued);
+
+  result = SDL_MixAudioVoices(mixer, (Uint8 *)out, sizeof(out) / 2);
+  SDLTest_AssertCheck(result == 0, "Verify result value; expected: 0; got: %i", result);
+  for (i = 0, errors = 0; i < frames; ++i) {
+    if (SDL_abs(out[i] - 24575) > 1) {
+      errors++;
+    }
+  }
+  SDLTest_AssertCheck(errors == 0, "Verify voices are summed before clipping; %i samples differ, first is %i", errors, out[0]);
+  queued = SDL_GetAudioVoiceQueuedFrames(voice1);
+  SDLTest_AssertCheck(queued == frames / 2, "Verify queued frames after mixing; expected: %i; got: %i", frames / 2, queued);
+
+  /* Pause the negative voice, pan the mono one left and halve the other */
+  SDL_PauseAudioVoice(voice3, 1);
+  SDL_SetAudioVoicePan(voice1, -1.0f);
+  SDL_SetAudioVoiceGain(voice2, 0.5f);
+  SDLTest_AssertPass("Call to SDL_PauseAudioVoice, SDL_SetAudioVoicePan and SDL_SetAudioVoiceGain");
+  result = SDL_MixAudioVoices(mixer, (Uint8 *)out, sizeof(out) / 2);
+  SDLTest_AssertCheck(result == 0, "Verify result value; expected: 0; got: %i", result);
+  SDLTest_AssertCheck(SDL_abs(out[frames - 2] - 32767) <= 1 && SDL_abs(out[frames - 1] - 12288) <= 1,
+                      "Verify gain and pan after ramping; expected: 32767, 12288; got: %i, %i", out[frames - 2], out[frames - 1]);
+  SDLTest_AssertCheck(out[frames / 2 + 1] > 12289 && out[frames / 2 + 1] < 32767,
+                      "Verify the change is ramped in; right channel halfway: %i", out[frames / 2 + 1]);
+  queued = SDL_GetAudioVoiceQueuedFrames(voice3);
+  SDLTest_AssertCheck(queued == frames / 2, "Verify a paused voice keeps its data; expected: %i; got: %i", frames / 2, queued);
+
+  /* Voices that run out of data play silence */
+  SDL_RemoveAudioVoice(voice3);
+  SDL_ClearAudioVoice(voice1);
+  SDLTest_AssertPass("Call to SDL_RemoveAudioVoice and SDL_ClearAudioVoice");
+  result = SDL_MixAudioVoices(mixer, (Uint8 *)out, sizeof(out));
+  SDLTest_AssertCheck(result == 0, "Verify result value; expected: 0; got: %i", result);
+  for (i = 0, errors = 0; i < frames * 2; ++i) {
+    if (out[i] != 0) {
+      errors++;
+    }
+  }
+  SDLTest_AssertCheck(errors == 0, "Verify drained voices mix silence; %i samples differ", errors);
+
+  /* A second of data is more than a voice buffers up front, the rest is still mixed in order */
+  voice3 = SDL_AddAudioVoice(mixer, AUDIO_S16SYS, 1, 48000);
+  SDLTest_AssertCheck(voice3 != NULL, "Verify S16 mono voice is not NULL");
+  if (voice3 == NULL) {
+    SDL_FreeAudioMixer(mixer);
+    return TEST_ABORTED;
+  }
+  for (i = 0, errors = 0; i < 47; ++i) {
+    for (j = 0; j < frames; ++j) {
+      stereo[j] = (Sint16)((i + 1) * 256);
+    }
+    if (SDL_PutAudioVoiceData(voice3, stereo, frames * sizeof(Sint16)) < 0) {
+      errors++;
+    }
+  }
+  SDLTest_AssertCheck(errors == 0, "Verify SDL_PutAudioVoiceData succeeds for a second of data; %i calls failed", errors);
+  queued = SDL_GetAudioVoiceQueuedFrames(voice3);
+  SDLTest_AssertCheck(queued == 47 * frames, "Verify queued frames; expected: %i; got: %i", 47 * frames, queued);
+  for (i = 0, errors = 0; i < 47; ++i) {
+    SDL_MixAudioVoices(mixer, (Uint8 *)out, sizeof(out));
+    for (j = 0; j < frames * 2; ++j) {
+      if (SDL_abs(out[j] - (i + 1) * 256) > 1) {
+        errors++;
+      }
+    }
+  }
+  SDLTest_AssertCheck(errors == 0, "Verify all of the data is mixed in order; %i samples differ", errors);
+  queued = SDL_GetAudioVoiceQueuedFrames(voice3);
+  SDLTest_AssertCheck(queued == 0, "Verify nothing is left queued; got: %i", queued);
+  SDL_RemoveAudioVoice(voice3);
+
+  /* A voice at another rate and format is resampled to the mixer's */
+  SDL_RemoveAudioVoice(voice1);
+  voice1 = SDL_AddAudioVoice(mixer, AUDIO_S8, 1, 22050);
+  SDLTest_AssertCheck(voice1 != NULL, "Verify S8 mono 22050 Hz voice is not NULL");
+  if (voice1 == NULL) {
+    SDL_FreeAudioMixer(mixer);
+    return TEST_ABORTED;
+  }
+  for (i = 0; i < SDL_arraysize(slow); ++i) {
+    slow[i] = (Sint8)(100.0 * SDL_sin(2.0 * M_PI * 440.0 * i / 22050));
+  }
+  result = SDL_PutAudioVoiceData(voice1, slow, sizeof(slow));
+  SDLTest_AssertCheck(result == 0, "Verify SDL_PutAudioVoiceData result; expected: 0; got: %i", result);
+  queued = SDL_GetAudioVoiceQueuedFrames(voice1);
+  SDLTest_AssertCheck(queued > 1000 && queued <= 1115, "Verify resampled frames queued; expected: about 1114; got: %i", queued);
+
+  /* Play it on a device */
+  if (SDL_GetCurrentAudioDriver() == NULL) {
+    result = SDL_AudioInit(NULL);
+    SDLTest_AssertPass("Call to SDL_AudioInit(NULL)");
+    started = (result == 0) ? SDL_TRUE : SDL_FALSE;
+  }
+  SDL_zero(desired);
+  desired.freq = 48000;
+  desired.format = AUDIO_S16SYS;
+  desired.channels = 2;
+  desired.samples = 512;
+  desired.callback = SDL_AudioMixerCallback;
+  desired.userdata = mixer;
+  id = SDL_GetCurrentAudioDriver() ? SDL_OpenAudioDevice(NULL, 0, &desired, NULL, 0) : 0;
+  if (id == 0) {
+    SDLTest_Log("No device to test with");
+  } else {
+    SDLTest_AssertPass("Call to SDL_OpenAudioDevice(NULL, 0, ...) with SDL_AudioMixerCallback");
+    SDL_PauseAudioDevice(id, 0);
+    start = SDL_GetTicks();
+    while ((SDL_GetAudioVoiceQueuedFrames(voice1) > 0) && !SDL_TICKS_PASSED(SDL_GetTicks(), start + 3000)) {
+      SDL_Delay(10);
+    }
+    result = SDL_GetAudioVoiceQueuedFrames(voice1);
+    SDLTest_AssertCheck(result < queued, "Verify the voice is being played; %i of %i frames left", result, queued);
+    SDL_CloseAudioDevice(id);
+    SDLTest_AssertPass("Call to SDL_CloseAudioDevice(id)");
+  }
+  if (started) {
+    SDL_AudioQuit();
+  }
+
+  SDL_FreeAudioMixer(mixer);
+  SDLTest_AssertPass("Call to SDL_FreeAudioMixer(mixer)");
+
+  return TEST_COMPLETED;
+}
+
 /* ================= Test Case References ================== */
 
 /* Audio test cases */
@@ -1022,11 +1638,27 @@ static const SDLTest_TestCaseReference audioTest14 =
 static const SDLTest_TestCaseReference audioTest15 =
         { (SDLTest_TestCaseFp)audio_pauseUnpauseAudio, "audio_pauseUnpauseAudio", "Pause and Unpause audio for various audio specs while testing callback.", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference audioTest16 =
+        { (SDLTest_TestCaseFp)audio_resampleLoss, "audio_resampleLoss", "Check signal loss and filtering when resampling.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest17 =
+        { (SDLTest_TestCaseFp)audio_convertFused, "audio_convertFused", "Check conversions done in a single pass against converting step by step.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest18 =
+        { (SDLTest_TestCaseFp)audio_queueAudio, "audio_queueAudio", "Queue, count, clear and play audio without a callback.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest19 =
+        { (SDLTest_TestCaseFp)audio_mixAudioFormat, "audio_mixAudioFormat", "Mix samples with volume scaling and clipping in every vectorized format.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest20 =
+        { (SDLTest_TestCaseFp)audio_audioMixer, "audio_audioMixer", "Mix voices with gain, pan and pause, and play a mixer.", TEST_ENABLED };
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] =  {
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
-    &audioTest12, &audioTest13, &audioTest14, &audioTest15, NULL
+    &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16,
+    &audioTest17, &audioTest18, &audioTest19, &audioTest20, NULL
 };
 
 /* Audio test suite (global) */
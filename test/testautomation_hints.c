@@ -97,6 +97,15 @@ hints_getHint(void *arg)
 /**
  * @brief Call to SDL_SetHint
  */
+static const char *_TestHintName = "SDL_TEST_HINT_CALLBACKS";
+
+static void SDLCALL
+_hintCallback(void *userdata, const char *name, const char *oldValue, const char *newValue)
+{
+  int *callbacks = (int *)userdata;
+  ++*callbacks;
+}
+
 int
 hints_setHint(void *arg)
 {
@@ -104,6 +113,7 @@ hints_setHint(void *arg)
   char *value;
   char *testValue;
   SDL_bool result;
+  int callbacks = 0;
   int i, j;
 
   /* Create random values to set */                    
@@ -141,7 +151,19 @@ hints_setHint(void *arg)
   }
   
   SDL_free(value);
-  
+
+  /* Clearing a hint notifies its watchers once, clearing it again doesn't */
+  SDL_SetHint(_TestHintName, "1");
+  SDL_AddHintCallback(_TestHintName, _hintCallback, &callbacks);
+  callbacks = 0;
+  result = SDL_SetHint(_TestHintName, NULL);
+  SDLTest_AssertCheck(result == SDL_TRUE, "Verify SDL_SetHint(%s, NULL) succeeds, got: %i", _TestHintName, (int)result);
+  testValue = (char *)SDL_GetHint(_TestHintName);
+  SDLTest_AssertCheck(testValue == NULL, "Verify the cleared hint is NULL, got: '%s'", (testValue == NULL) ? "null" : testValue);
+  SDL_SetHint(_TestHintName, NULL);
+  SDLTest_AssertCheck(callbacks == 1, "Verify the hint callback was called once, got: %i", callbacks);
+  SDL_DelHintCallback(_TestHintName, _hintCallback, &callbacks);
+
   return TEST_COMPLETED;
 }
 
@@ -1574,6 +1574,137 @@ int rect_testRectEqualsParam(void *arg)
     return TEST_COMPLETED;
 }
 
+/* Helper to check that the rects of a region are banded, don't overlap and cover the expected area */
+void _validateRegion(const SDL_Region *region, int expectedArea)
+{
+    const SDL_Rect *rects;
+    int count, i, j, area = 0;
+
+    rects = SDL_GetRegionRects(region, &count);
+    SDLTest_AssertCheck((count == 0) == (rects == NULL), "Check that rects are NULL only for an empty region, count: %i", count);
+    for (i = 0; i < count; ++i) {
+        SDLTest_AssertCheck(!SDL_RectEmpty(&rects[i]), "Check that rect %i is not empty", i);
+        if (i > 0) {
+            const SDL_Rect *prev = &rects[i - 1];
+            SDLTest_AssertCheck(rects[i].y > prev->y || (rects[i].y == prev->y && rects[i].h == prev->h && rects[i].x > prev->x + prev->w),
+                "Check that rect %i follows rect %i in band order", i, i - 1);
+        }
+        for (j = 0; j < i; ++j) {
+            SDLTest_AssertCheck(!SDL_HasIntersection(&rects[i], &rects[j]), "Check that rect %i doesn't overlap rect %i", i, j);
+        }
+        area += rects[i].w * rects[i].h;
+    }
+    SDLTest_AssertCheck(area == expectedArea, "Check region area, expected: %i, got: %i", expectedArea, area);
+}
+
+/* !
+ * \brief Tests SDL_Region operations
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_UnionRegionRects
+ * http://wiki.libsdl.org/moin.cgi/SDL_SubtractRegionRect
+ */
+int rect_testRegion(void *arg)
+{
+    const SDL_Rect overlapping[3] = { { 0, 0, 10, 10 }, { 5, 5, 10, 10 }, { 20, 0, 0, 5 } };
+    const SDL_Rect hole = { 2, 2, 4, 4 };
+    const SDL_Rect clip = { 0, 0, 8, 8 };
+    SDL_Region *region, *other;
+    const SDL_Rect *rects;
+    SDL_Rect bounds;
+    int count, result;
+
+    region = SDL_CreateRegion();
+    SDLTest_AssertCheck(region != NULL, "Check that SDL_CreateRegion() returns a region");
+    if (region == NULL) {
+        return TEST_ABORTED;
+    }
+    other = SDL_CreateRegion();
+    SDLTest_AssertCheck(other != NULL, "Check that SDL_CreateRegion() returns a region");
+    if (other == NULL) {
+        SDL_FreeRegion(region);
+        return TEST_ABORTED;
+    }
+
+    /* An empty region */
+    rects = SDL_GetRegionRects(region, &count);
+    SDLTest_AssertCheck(rects == NULL && count == 0, "Check that a new region is empty");
+    SDLTest_AssertCheck(SDL_GetRegionBounds(region, &bounds) == SDL_FALSE, "Check that an empty region has no bounds");
+
+    /* Overlapping rects are counted once, empty rects are ignored */
+    result = SDL_UnionRegionRects(region, overlapping, SDL_arraysize(overlapping));
+    SDLTest_AssertPass("Call to SDL_UnionRegionRects()");
+    SDLTest_AssertCheck(result == 0, "Check return value, expected: 0, got: %i", result);
+    _validateRegion(region, 175);
+    SDLTest_AssertCheck(SDL_GetRegionBounds(region, &bounds) == SDL_TRUE, "Check that the region has bounds");
+    SDLTest_AssertCheck(bounds.x == 0 && bounds.y == 0 && bounds.w == 15 && bounds.h == 15,
+        "Check bounds, expected: 0,0 15x15, got: %i,%i %ix%i", bounds.x, bounds.y, bounds.w, bounds.h);
+
+    /* Adding the same rects again doesn't change the region */
+    result = SDL_UnionRegionRects(region, overlapping, SDL_arraysize(overlapping));
+    SDLTest_AssertCheck(result == 0, "Check return value, expected: 0, got: %i", result);
+    _validateRegion(region, 175);
+
+    /* Subtracting a hole splits the bands around it */
+    result = SDL_SubtractRegionRect(region, &hole);
+    SDLTest_AssertPass("Call to SDL_SubtractRegionRect()");
+    SDLTest_AssertCheck(result == 0, "Check return value, expected: 0, got: %i", result);
+    _validateRegion(region, 159);
+
+    /* Intersecting with a rect clips the region */
+    result = SDL_IntersectRegionRect(region, &clip);
+    SDLTest_AssertPass("Call to SDL_IntersectRegionRect()");
+    SDLTest_AssertCheck(result == 0, "Check return value, expected: 0, got: %i", result);
+    _validateRegion(region, 48);
+
+    /* Region to region operations */
+    result = SDL_UnionRegionRects(other, &hole, 1);
+    SDLTest_AssertCheck(result == 0, "Check return value, expected: 0, got: %i", result);
+    result = SDL_UnionRegion(region, other);
+    SDLTest_AssertPass("Call to SDL_UnionRegion()");
+    SDLTest_AssertCheck(result == 0, "Check return value, expected: 0, got: %i", result);
+    _validateRegion(region, 64);
+    rects = SDL_GetRegionRects(region, &count);
+    SDLTest_AssertCheck(count == 1 && rects && SDL_RectEquals(&rects[0], &clip), "Check that filling the hole merges the bands back into a single rect, got %i rects", count);
+    result = SDL_IntersectRegion(region, other);
+    SDLTest_AssertPass("Call to SDL_IntersectRegion()");
+    SDLTest_AssertCheck(result == 0, "Check return value, expected: 0, got: %i", result);
+    _validateRegion(region, 16);
+    result = SDL_SubtractRegion(region, other);
+    SDLTest_AssertPass("Call to SDL_SubtractRegion()");
+    SDLTest_AssertCheck(result == 0, "Check return value, expected: 0, got: %i", result);
+    _validateRegion(region, 0);
+
+    /* Translation */
+    SDL_TranslateRegion(other, -10, 20);
+    SDLTest_AssertPass("Call to SDL_TranslateRegion()");
+    SDLTest_AssertCheck(SDL_GetRegionBounds(other, &bounds) == SDL_TRUE, "Check that the region has bounds");
+    SDLTest_AssertCheck(bounds.x == -8 && bounds.y == 22 && bounds.w == 4 && bounds.h == 4,
+        "Check bounds, expected: -8,22 4x4, got: %i,%i %ix%i", bounds.x, bounds.y, bounds.w, bounds.h);
+
+    SDL_ClearRegion(other);
+    SDLTest_AssertPass("Call to SDL_ClearRegion()");
+    _validateRegion(other, 0);
+
+    /* Invalid parameters */
+    result = SDL_UnionRegionRects(NULL, &hole, 1);
+    SDLTest_AssertCheck(result == -1, "Check that SDL_UnionRegionRects() fails for a NULL region, got: %i", result);
+    result = SDL_UnionRegionRects(region, NULL, 1);
+    SDLTest_AssertCheck(result == -1, "Check that SDL_UnionRegionRects() fails for NULL rects, got: %i", result);
+    result = SDL_IntersectRegion(region, NULL);
+    SDLTest_AssertCheck(result == -1, "Check that SDL_IntersectRegion() fails for a NULL region, got: %i", result);
+    result = SDL_SubtractRegionRect(region, NULL);
+    SDLTest_AssertCheck(result == -1, "Check that SDL_SubtractRegionRect() fails for a NULL rect, got: %i", result);
+    SDL_ClearError();
+
+    SDL_FreeRegion(other);
+    SDL_FreeRegion(region);
+    SDL_FreeRegion(NULL);
+    SDLTest_AssertPass("Call to SDL_FreeRegion()");
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Rect test cases */
@@ -1673,6 +1804,11 @@ static const SDLTest_TestCaseReference rectTest28 =
 static const SDLTest_TestCaseReference rectTest29 =
         { (SDLTest_TestCaseFp)rect_testRectEqualsParam, "rect_testRectEqualsParam", "Negative tests against SDL_RectEquals with invalid parameters", TEST_ENABLED };
 
+/* SDL_Region */
+
+static const SDLTest_TestCaseReference rectTest30 =
+        { (SDLTest_TestCaseFp)rect_testRegion, "rect_testRegion", "Tests SDL_Region union, intersection and subtraction", TEST_ENABLED };
+
 
 /* !
  * \brief Sequence of Rect test cases; functions that handle simple rectangles including overlaps and merges.
@@ -1683,7 +1819,7 @@ static const SDLTest_TestCaseReference rectTest29 =
 static const SDLTest_TestCaseReference *rectTests[] =  {
     &rectTest1, &rectTest2, &rectTest3, &rectTest4, &rectTest5, &rectTest6, &rectTest7, &rectTest8, &rectTest9, &rectTest10, &rectTest11, &rectTest12, &rectTest13, &rectTest14,
     &rectTest15, &rectTest16, &rectTest17, &rectTest18, &rectTest19, &rectTest20, &rectTest21, &rectTest22, &rectTest23, &rectTest24, &rectTest25, &rectTest26, &rectTest27,
-    &rectTest28, &rectTest29, NULL
+    &rectTest28, &rectTest29, &rectTest30, NULL
 };
 
 
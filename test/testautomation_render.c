@@ -420,6 +420,565 @@ render_testBlit(void *arg)
 }
 
 
+/**
+ * @brief Tests drawing textured quads with SDL_RenderGeometry.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderGeometry
+ */
+int
+render_testGeometry(void *arg)
+{
+   int ret;
+   SDL_Texture *tface;
+   SDL_Surface *referenceSurface = NULL;
+   SDL_Vertex *vertices;
+   int *indices;
+   Uint32 tformat;
+   int taccess, tw, th;
+   int i, j, k, ni, nj, nquads;
+
+   /* Clear surface. */
+   _clearScreen();
+
+   /* Create face surface. */
+   tface = _loadTestFace();
+   SDLTest_AssertCheck(tface != NULL,  "Verify _loadTestFace() result");
+   if (tface == NULL) {
+       return TEST_ABORTED;
+   }
+
+   /* Constant values. */
+   ret = SDL_QueryTexture(tface, &tformat, &taccess, &tw, &th);
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_QueryTexture, expected 0, got %i", ret);
+   ni     = TESTRENDER_SCREEN_W - tw;
+   nj     = TESTRENDER_SCREEN_H - th;
+   nquads = ((ni / 4) + 1) * ((nj / 4) + 1);
+
+   vertices = (SDL_Vertex *)SDL_malloc(nquads * 4 * sizeof(SDL_Vertex));
+   indices = (int *)SDL_malloc(nquads * 6 * sizeof(int));
+   SDLTest_AssertCheck(vertices != NULL && indices != NULL, "Validate allocated vertex and index buffers");
+   if (vertices == NULL || indices == NULL) {
+       SDL_free(vertices);
+       SDL_free(indices);
+       SDL_DestroyTexture(tface);
+       return TEST_ABORTED;
+   }
+
+   /* Same layout as render_testBlit, submitted as one mesh. */
+   k = 0;
+   for (j=0; j <= nj; j+=4) {
+      for (i=0; i <= ni; i+=4) {
+         SDL_Vertex *v = &vertices[k * 4];
+         int c;
+         for (c = 0; c < 4; c++) {
+            v[c].x = (float)(i + ((c & 1) ? tw : 0));
+            v[c].y = (float)(j + ((c & 2) ? th : 0));
+            v[c].u = (c & 1) ? 1.0f : 0.0f;
+            v[c].v = (c & 2) ? 1.0f : 0.0f;
+            v[c].color.r = v[c].color.g = v[c].color.b = v[c].color.a = 255;
+         }
+         indices[k * 6 + 0] = k * 4 + 0;
+         indices[k * 6 + 1] = k * 4 + 1;
+         indices[k * 6 + 2] = k * 4 + 2;
+         indices[k * 6 + 3] = k * 4 + 2;
+         indices[k * 6 + 4] = k * 4 + 1;
+         indices[k * 6 + 5] = k * 4 + 3;
+         k++;
+      }
+   }
+
+   ret = SDL_RenderGeometry(renderer, tface, vertices, nquads * 4, indices, nquads * 6);
+   if (!_isSupported(ret)) {
+      SDL_free(vertices);
+      SDL_free(indices);
+      SDL_DestroyTexture(tface);
+      return TEST_SKIPPED;
+   }
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGeometry, expected: 0, got: %i", ret);
+
+   /* Out of range indices must be rejected. */
+   indices[0] = nquads * 4;
+   ret = SDL_RenderGeometry(renderer, tface, vertices, nquads * 4, indices, nquads * 6);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_RenderGeometry with bad index, expected: -1, got: %i", ret);
+
+   /* Make current */
+   SDL_RenderPresent(renderer);
+
+   /* See if it's the same */
+   referenceSurface = SDLTest_ImageBlit();
+   _compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE );
+
+   /* Clean up. */
+   SDL_free(vertices);
+   SDL_free(indices);
+   SDL_DestroyTexture( tface );
+   SDL_FreeSurface(referenceSurface);
+   referenceSurface = NULL;
+
+   return TEST_COMPLETED;
+}
+
+
+/**
+ * @brief Tests the frame counters of the renderer.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_GetRendererStats
+ */
+int
+render_testStats(void *arg)
+{
+   int ret;
+   SDL_RendererStats stats, next;
+   SDL_Texture *tface;
+   SDL_Rect rect;
+   Uint32 pixels[16 * 16];
+   Uint32 frames;
+
+   /* Invalid parameters. */
+   ret = SDL_GetRendererStats(renderer, NULL);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_GetRendererStats(renderer, NULL), expected: -1, got: %i", ret);
+   ret = SDL_GetRendererStats(NULL, &stats);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_GetRendererStats(NULL, stats), expected: -1, got: %i", ret);
+
+   tface = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 16, 16);
+   SDLTest_AssertCheck(tface != NULL, "Verify SDL_CreateTexture() result");
+   if (tface == NULL) {
+       return TEST_ABORTED;
+   }
+
+   /* Start from a fresh frame. */
+   SDL_RenderPresent(renderer);
+   ret = SDL_GetRendererStats(renderer, &stats);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRendererStats, expected: 0, got: %i", ret);
+   frames = stats.frames;
+   SDLTest_AssertCheck(frames > 0, "Validate frame count after a present, got: %u", frames);
+
+   SDL_memset(pixels, 0xFF, sizeof(pixels));
+   ret = SDL_UpdateTexture(tface, NULL, pixels, 16 * sizeof(Uint32));
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTexture, expected: 0, got: %i", ret);
+   SDL_SetRenderDrawColor(renderer, 1, 2, 3, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(renderer);
+   rect.x = rect.y = 0;
+   rect.w = rect.h = 16;
+   SDL_RenderFillRect(renderer, &rect);
+   SDL_RenderDrawLine(renderer, 0, 0, 10, 10);
+   SDL_RenderCopy(renderer, tface, NULL, &rect);
+   SDL_RenderCopy(renderer, tface, NULL, &rect);
+   SDL_RenderPresent(renderer);
+
+   ret = SDL_GetRendererStats(renderer, &stats);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRendererStats, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(stats.frames == frames + 1, "Validate frame count, expected: %u, got: %u", frames + 1, stats.frames);
+   SDLTest_AssertCheck(stats.draw_calls == 5, "Validate draw calls, expected: 5, got: %u", stats.draw_calls);
+   SDLTest_AssertCheck(stats.primitives == 4, "Validate primitives, expected: 4, got: %u", stats.primitives);
+   SDLTest_AssertCheck(stats.backend_draws >= 1 && stats.backend_draws <= 5, "Validate backend draws, expected: 1 to 5, got: %u", stats.backend_draws);
+   SDLTest_AssertCheck(stats.texture_uploads == 1, "Validate texture uploads, expected: 1, got: %u", stats.texture_uploads);
+   SDLTest_AssertCheck(stats.texture_bytes == sizeof(pixels), "Validate texture bytes, expected: %u, got: %u", (unsigned int)sizeof(pixels), (unsigned int)stats.texture_bytes);
+   SDLTest_AssertCheck(stats.state_changes >= 1, "Validate state changes, expected at least 1, got: %u", stats.state_changes);
+
+   /* Counters start over with every frame. */
+   SDL_RenderPresent(renderer);
+   ret = SDL_GetRendererStats(renderer, &next);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRendererStats, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(next.frames == frames + 2, "Validate frame count, expected: %u, got: %u", frames + 2, next.frames);
+   SDLTest_AssertCheck(next.draw_calls == 0 && next.primitives == 0 && next.texture_uploads == 0,
+                       "Validate an empty frame has no draw calls, primitives or uploads");
+
+   SDL_DestroyTexture(tface);
+
+   return TEST_COMPLETED;
+}
+
+
+/* Fills a YUV image with a single color */
+static void
+_fillYUV(Uint32 format, Uint8 *pixels, int w, int h, Uint8 y, Uint8 u, Uint8 v)
+{
+   int i;
+
+   switch (format) {
+   case SDL_PIXELFORMAT_YV12:
+   case SDL_PIXELFORMAT_IYUV:
+      SDL_memset(pixels, y, w * h);
+      SDL_memset(pixels + w * h, (format == SDL_PIXELFORMAT_YV12) ? v : u, (w / 2) * (h / 2));
+      SDL_memset(pixels + w * h + (w / 2) * (h / 2), (format == SDL_PIXELFORMAT_YV12) ? u : v, (w / 2) * (h / 2));
+      break;
+   case SDL_PIXELFORMAT_NV12:
+   case SDL_PIXELFORMAT_NV21:
+      SDL_memset(pixels, y, w * h);
+      for (i = 0; i < (w / 2) * (h / 2); ++i) {
+         pixels[w * h + i * 2 + 0] = (format == SDL_PIXELFORMAT_NV12) ? u : v;
+         pixels[w * h + i * 2 + 1] = (format == SDL_PIXELFORMAT_NV12) ? v : u;
+      }
+      break;
+   case SDL_PIXELFORMAT_YUY2:
+   case SDL_PIXELFORMAT_UYVY:
+   case SDL_PIXELFORMAT_YVYU:
+      for (i = 0; i < (w / 2) * h; ++i) {
+         Uint8 *quad = pixels + i * 4;
+         if (format == SDL_PIXELFORMAT_YUY2) {
+            quad[0] = y; quad[1] = u; quad[2] = y; quad[3] = v;
+         } else if (format == SDL_PIXELFORMAT_UYVY) {
+            quad[0] = u; quad[1] = y; quad[2] = v; quad[3] = y;
+         } else {
+            quad[0] = y; quad[1] = v; quad[2] = y; quad[3] = u;
+         }
+      }
+      break;
+   }
+}
+
+/**
+ * @brief Tests rendering YUV textures with the YUV conversion modes.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_SetYUVConversionMode
+ * http://wiki.libsdl.org/moin.cgi/SDL_UpdateTexture
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderCopy
+ */
+int
+render_testYUVConversion(void *arg)
+{
+   static const Uint32 formats[] = {
+      SDL_PIXELFORMAT_YV12, SDL_PIXELFORMAT_IYUV, SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_NV21,
+      SDL_PIXELFORMAT_YUY2, SDL_PIXELFORMAT_UYVY, SDL_PIXELFORMAT_YVYU
+   };
+   /* Y, U, V, mode and the expected R, G, B */
+   static const struct {
+      Uint8 y, u, v;
+      SDL_YUV_CONVERSION_MODE mode;
+      Uint8 r, g, b;
+   } colors[] = {
+      { 235, 128, 128, SDL_YUV_CONVERSION_JPEG, 235, 235, 235 },
+      { 235, 128, 128, SDL_YUV_CONVERSION_BT601, 255, 255, 255 },
+      { 16, 128, 128, SDL_YUV_CONVERSION_BT709, 0, 0, 0 },
+      { 76, 85, 255, SDL_YUV_CONVERSION_JPEG, 253, 0, 0 },
+      { 82, 90, 240, SDL_YUV_CONVERSION_BT601, 255, 1, 0 },
+      { 63, 102, 240, SDL_YUV_CONVERSION_BT709, 255, 1, 0 },
+      { 54, 99, 255, SDL_YUV_CONVERSION_BT709_FULL, 254, 0, 0 },
+   };
+   const int w = 64, h = 32;
+   SDL_YUV_CONVERSION_MODE mode;
+   SDL_Surface *target;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture;
+   SDL_Rect rect;
+   Uint8 *yuv;
+   Uint32 pixels[64 * 32];
+   int i, j, k, ret;
+
+   /* The automatic mode depends on the resolution. */
+   mode = SDL_GetYUVConversionMode();
+   SDLTest_AssertCheck(mode == SDL_YUV_CONVERSION_JPEG, "Validate default YUV conversion mode, expected: %i, got: %i", SDL_YUV_CONVERSION_JPEG, mode);
+   SDL_SetYUVConversionMode(SDL_YUV_CONVERSION_AUTOMATIC);
+   mode = SDL_GetYUVConversionModeForResolution(720, 576);
+   SDLTest_AssertCheck(mode == SDL_YUV_CONVERSION_BT601, "Validate SD YUV conversion mode, expected: %i, got: %i", SDL_YUV_CONVERSION_BT601, mode);
+   mode = SDL_GetYUVConversionModeForResolution(1280, 720);
+   SDLTest_AssertCheck(mode == SDL_YUV_CONVERSION_BT709, "Validate HD YUV conversion mode, expected: %i, got: %i", SDL_YUV_CONVERSION_BT709, mode);
+
+   /* Use the software renderer, hardware ones may convert YUV themselves. */
+   target = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(target != NULL, "Verify SDL_CreateRGBSurfaceWithFormat() result");
+   swrenderer = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify SDL_CreateSoftwareRenderer() result");
+   yuv = (Uint8 *)SDL_malloc(w * h * 2);
+   SDLTest_AssertCheck(yuv != NULL, "Verify YUV buffer allocation");
+   if (target == NULL || swrenderer == NULL || yuv == NULL) {
+      SDL_free(yuv);
+      if (swrenderer) {
+         SDL_DestroyRenderer(swrenderer);
+      }
+      SDL_FreeSurface(target);
+      SDL_SetYUVConversionMode(SDL_YUV_CONVERSION_JPEG);
+      return TEST_ABORTED;
+   }
+
+   rect.x = rect.y = 0;
+   rect.w = w;
+   rect.h = h;
+   for (i = 0; i < SDL_arraysize(formats); ++i) {
+      texture = SDL_CreateTexture(swrenderer, formats[i], SDL_TEXTUREACCESS_STREAMING, w, h);
+      SDLTest_AssertCheck(texture != NULL, "Verify SDL_CreateTexture(%s) result", SDL_GetPixelFormatName(formats[i]));
+      if (texture == NULL) {
+         continue;
+      }
+      for (j = 0; j < SDL_arraysize(colors); ++j) {
+         int pitch = (formats[i] == SDL_PIXELFORMAT_YUY2 || formats[i] == SDL_PIXELFORMAT_UYVY || formats[i] == SDL_PIXELFORMAT_YVYU) ? w * 2 : w;
+         int diff = 0;
+
+         SDL_SetYUVConversionMode(colors[j].mode);
+         _fillYUV(formats[i], yuv, w, h, colors[j].y, colors[j].u, colors[j].v);
+         ret = SDL_UpdateTexture(texture, NULL, yuv, pitch);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTexture, expected: 0, got: %i", ret);
+         SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+         ret = SDL_RenderReadPixels(swrenderer, &rect, SDL_PIXELFORMAT_ARGB8888, pixels, w * sizeof(Uint32));
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+         for (k = 0; k < w * h; ++k) {
+            diff = SDL_max(diff, SDL_abs((int)((pixels[k] >> 16) & 0xFF) - colors[j].r));
+            diff = SDL_max(diff, SDL_abs((int)((pixels[k] >> 8) & 0xFF) - colors[j].g));
+            diff = SDL_max(diff, SDL_abs((int)(pixels[k] & 0xFF) - colors[j].b));
+         }
+         SDLTest_AssertCheck(diff <= 2, "Validate %s color %i in mode %i, expected difference at most 2, got: %i",
+                             SDL_GetPixelFormatName(formats[i]), j, colors[j].mode, diff);
+      }
+      SDL_DestroyTexture(texture);
+   }
+
+   /* The JPEG mode has to match the tables of earlier SDL versions exactly.
+      The width is not a multiple of the SIMD block size, so the scalar tail
+      is covered too, and the chroma planes hold every value. */
+   SDL_SetYUVConversionMode(SDL_YUV_CONVERSION_JPEG);
+   rect.w = w - 2;
+   texture = SDL_CreateTexture(swrenderer, SDL_PIXELFORMAT_IYUV, SDL_TEXTUREACCESS_STREAMING, rect.w, h);
+   SDLTest_AssertCheck(texture != NULL, "Verify SDL_CreateTexture(IYUV) result");
+   if (texture != NULL) {
+      const int cw = rect.w / 2, ch = h / 2;
+      Uint8 *u = yuv + rect.w * h;
+      Uint8 *v = u + cw * ch;
+      int mismatches = 0;
+
+      for (k = 0; k < rect.w * h; ++k) {
+         yuv[k] = (Uint8)(k * 37);
+      }
+      for (k = 0; k < cw * ch; ++k) {
+         u[k] = (Uint8)k;
+         v[k] = (Uint8)(k * 7 + 3);
+      }
+      ret = SDL_UpdateTexture(texture, NULL, yuv, rect.w);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTexture, expected: 0, got: %i", ret);
+      SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+      ret = SDL_RenderReadPixels(swrenderer, &rect, SDL_PIXELFORMAT_ARGB8888, pixels, rect.w * sizeof(Uint32));
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+      for (k = 0; k < rect.w * h; ++k) {
+         const int c = (k / rect.w / 2) * cw + (k % rect.w) / 2;
+         const int Y = yuv[k], CB = u[c] - 128, CR = v[c] - 128;
+         const int r = SDL_max(0, SDL_min(255, Y + (int)((0.419 / 0.299) * CR)));
+         const int g = SDL_max(0, SDL_min(255, Y + (int)(-(0.299 / 0.419) * CR) + (int)(-(0.114 / 0.331) * CB)));
+         const int b = SDL_max(0, SDL_min(255, Y + (int)((0.587 / 0.331) * CB)));
+         if (pixels[k] != (0xFF000000 | (Uint32)(r << 16) | (Uint32)(g << 8) | (Uint32)b)) {
+            ++mismatches;
+         }
+      }
+      SDLTest_AssertCheck(mismatches == 0, "Validate JPEG conversion against the legacy tables, expected: 0 mismatches, got: %i", mismatches);
+      SDL_DestroyTexture(texture);
+   }
+
+   SDL_free(yuv);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(target);
+   SDL_SetYUVConversionMode(SDL_YUV_CONVERSION_JPEG);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests rotated and flipped copies of the software renderer.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderCopyEx
+ */
+int
+render_testCopyEx(void *arg)
+{
+   static const Uint32 source[2][4] = {
+      { 0xFF100000, 0xFF200000, 0xFF300000, 0xFF400000 },
+      { 0xFF001000, 0xFF002000, 0xFF003000, 0xFF004000 }
+   };
+   SDL_Surface *target;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture;
+   SDL_Rect rect;
+   Uint32 pixels[16 * 16];
+   int i, x, y, ret;
+
+   target = SDL_CreateRGBSurfaceWithFormat(0, 16, 16, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(target != NULL, "Verify SDL_CreateRGBSurfaceWithFormat() result");
+   swrenderer = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify SDL_CreateSoftwareRenderer() result");
+   texture = swrenderer ? SDL_CreateTexture(swrenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 4, 2) : NULL;
+   SDLTest_AssertCheck(texture != NULL, "Verify SDL_CreateTexture() result");
+   if (texture == NULL) {
+      if (swrenderer) {
+         SDL_DestroyRenderer(swrenderer);
+      }
+      SDL_FreeSurface(target);
+      return TEST_ABORTED;
+   }
+   SDL_UpdateTexture(texture, NULL, source, sizeof(source[0]));
+
+   /* A quarter turn around the center, then a half turn with a horizontal flip */
+   for (i = 0; i < 2; ++i) {
+      int drawn = 0, wrong = 0;
+
+      SDL_SetRenderDrawColor(swrenderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+      SDL_RenderClear(swrenderer);
+      rect.x = 4;
+      rect.y = 4;
+      rect.w = 4;
+      rect.h = 2;
+      if (i == 0) {
+         ret = SDL_RenderCopyEx(swrenderer, texture, NULL, &rect, 90.0, NULL, SDL_FLIP_NONE);
+      } else {
+         ret = SDL_RenderCopyEx(swrenderer, texture, NULL, &rect, 180.0, NULL, SDL_FLIP_HORIZONTAL);
+      }
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopyEx, expected: 0, got: %i", ret);
+      ret = SDL_RenderReadPixels(swrenderer, NULL, SDL_PIXELFORMAT_ARGB8888, pixels, 16 * sizeof(Uint32));
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+
+      for (y = 0; y < 16; ++y) {
+         for (x = 0; x < 16; ++x) {
+            Uint32 expected = 0xFF000000;
+            if (i == 0 && x >= 5 && x < 7 && y >= 3 && y < 7) {
+               expected = source[6 - x][y - 3];
+            } else if (i == 1 && x >= 4 && x < 8 && y >= 4 && y < 6) {
+               expected = source[5 - y][x - 4];
+            }
+            if (expected != 0xFF000000) {
+               ++drawn;
+            }
+            if (pixels[y * 16 + x] != expected) {
+               ++wrong;
+            }
+         }
+      }
+      SDLTest_AssertCheck(drawn == 8, "Validate copy %i covers 8 pixels, got: %i", i, drawn);
+      SDLTest_AssertCheck(wrong == 0, "Validate copy %i pixels, expected 0 wrong, got: %i", i, wrong);
+   }
+
+   SDL_DestroyTexture(texture);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(target);
+
+   return TEST_COMPLETED;
+}
+
+
+/* Draws lines and nearest scaled copies across the whole target with the software renderer */
+static int
+_drawSoftwareScene(const char *threads, Uint32 *pixels, int w, int h)
+{
+   SDL_Surface *target;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture;
+   Uint32 source[23][37];
+   SDL_Point points[5];
+   SDL_Rect rect;
+   int i, x, y, ret;
+
+   SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, threads);
+   SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "nearest");
+   target = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+   swrenderer = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+   texture = swrenderer ? SDL_CreateTexture(swrenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 37, 23) : NULL;
+   if (texture == NULL) {
+      if (swrenderer) {
+         SDL_DestroyRenderer(swrenderer);
+      }
+      SDL_FreeSurface(target);
+      return -1;
+   }
+   for (y = 0; y < 23; ++y) {
+      for (x = 0; x < 37; ++x) {
+         source[y][x] = 0x80000000 | (x * 0x060000) | (y * 0x000A00) | ((x * y) & 0xFF);
+      }
+   }
+   SDL_UpdateTexture(texture, NULL, source, sizeof(source[0]));
+   SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+   SDL_SetRenderDrawColor(swrenderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+   ret = SDL_RenderClear(swrenderer);
+   for (i = 0; i < 12; ++i) {
+      /* Steep and shallow polylines, opaque and blended, half of them clipped */
+      if (i == 6) {
+         rect.x = 10;
+         rect.y = 21;
+         rect.w = w - 30;
+         rect.h = h - 45;
+         ret |= SDL_RenderSetClipRect(swrenderer, &rect);
+      }
+      points[0].x = 3 + i * 7;
+      points[0].y = -5;
+      points[1].x = w - 20 - i * 11;
+      points[1].y = h + 3;
+      points[2].x = w + 7;
+      points[2].y = 13 + i * 17;
+      points[3].x = -9;
+      points[3].y = 40 + i * 13;
+      points[4] = points[0];
+      SDL_SetRenderDrawBlendMode(swrenderer, (i & 1) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+      SDL_SetRenderDrawColor(swrenderer, 40 + i * 15, 200 - i * 9, 90, 160);
+      ret |= SDL_RenderDrawLines(swrenderer, points, SDL_arraysize(points));
+   }
+   ret |= SDL_RenderSetClipRect(swrenderer, NULL);
+   for (i = 0; i < 10; ++i) {
+      /* Magnified and minified copies */
+      rect.x = i * 23 - 11;
+      rect.y = i * 19 - 17;
+      rect.w = (i & 1) ? 101 : 19;
+      rect.h = (i & 1) ? 67 : 15 + i * 11;
+      ret |= SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+   }
+   ret |= SDL_RenderReadPixels(swrenderer, NULL, SDL_PIXELFORMAT_ARGB8888, pixels, w * sizeof(Uint32));
+
+   SDL_DestroyTexture(texture);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(target);
+   return ret;
+}
+
+/**
+ * @brief Tests that the software renderer draws the same with several threads as with one.
+ */
+int
+render_testSoftwareThreads(void *arg)
+{
+   const int w = 256, h = 256;
+   const char *hint;
+   char *threads_hint, *quality_hint;
+   Uint32 *single, *threaded;
+   int i, ret, drawn = 0, wrong = 0;
+
+   single = (Uint32 *) SDL_malloc(w * h * sizeof(Uint32));
+   threaded = (Uint32 *) SDL_malloc(w * h * sizeof(Uint32));
+   if (single == NULL || threaded == NULL) {
+      SDL_free(single);
+      SDL_free(threaded);
+      return TEST_ABORTED;
+   }
+   hint = SDL_GetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+   threads_hint = hint ? SDL_strdup(hint) : NULL;
+   hint = SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
+   quality_hint = hint ? SDL_strdup(hint) : NULL;
+
+   ret = _drawSoftwareScene("1", single, w, h);
+   SDLTest_AssertCheck(ret == 0, "Validate drawing with 1 thread, expected: 0, got: %i", ret);
+   ret = _drawSoftwareScene("4", threaded, w, h);
+   SDLTest_AssertCheck(ret == 0, "Validate drawing with 4 threads, expected: 0, got: %i", ret);
+
+   for (i = 0; i < w * h; ++i) {
+      if (single[i] != 0xFF000000) {
+         ++drawn;
+      }
+      if (threaded[i] != single[i]) {
+         ++wrong;
+      }
+   }
+   SDLTest_AssertCheck(drawn > w * h / 4, "Validate the scene was drawn, got: %i pixels", drawn);
+   SDLTest_AssertCheck(wrong == 0, "Validate pixels drawn with 4 threads, expected 0 differing from 1 thread, got: %i", wrong);
+
+   SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, threads_hint);
+   SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, quality_hint);
+   SDL_free(threads_hint);
+   SDL_free(quality_hint);
+   SDL_free(single);
+   SDL_free(threaded);
+
+   return TEST_COMPLETED;
+}
+
+
 /**
  * @brief Blits doing color tests.
  *
@@ -1085,9 +1644,25 @@ static const SDLTest_TestCaseReference renderTest6 =
 static const SDLTest_TestCaseReference renderTest7 =
         {  (SDLTest_TestCaseFp)render_testBlitBlend, "render_testBlitBlend", "Tests blitting with blending", TEST_DISABLED };
 
+static const SDLTest_TestCaseReference renderTest8 =
+        { (SDLTest_TestCaseFp)render_testGeometry, "render_testGeometry", "Tests rendering textured quads with SDL_RenderGeometry", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest9 =
+        { (SDLTest_TestCaseFp)render_testStats, "render_testStats", "Tests the renderer frame counters", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest10 =
+        { (SDLTest_TestCaseFp)render_testYUVConversion, "render_testYUVConversion", "Tests rendering YUV textures with the conversion modes", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest11 =
+        { (SDLTest_TestCaseFp)render_testCopyEx, "render_testCopyEx", "Tests rotated and flipped software renderer copies", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest12 =
+        { (SDLTest_TestCaseFp)render_testSoftwareThreads, "render_testSoftwareThreads", "Tests that software renderer threads don't change what is drawn", TEST_ENABLED };
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] =  {
-    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, NULL
+    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, &renderTest8, &renderTest9,
+    &renderTest10, &renderTest11, &renderTest12, NULL
 };
 
 /* Render test suite (global) */
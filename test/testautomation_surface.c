@@ -259,6 +259,115 @@ surface_testSaveLoadBitmap(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * @brief Tests loading bitmaps straight into a pixel format
+ */
+int
+surface_testLoadBitmapWithFormat(void *arg)
+{
+    /* A 4x3 RLE8 bitmap with a run, a literal run and a delta:
+         0 0 1 1
+         1 0 1 0
+         1 1 1 1 */
+    static const Uint8 rle8[] = {
+        'B', 'M', 82, 0, 0, 0, 0, 0, 0, 0, 62, 0, 0, 0,
+        40, 0, 0, 0, 4, 0, 0, 0, 3, 0, 0, 0, 1, 0, 8, 0, 1, 0, 0, 0,
+        20, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 255, 0,
+        4, 1, 0, 0, 0, 3, 1, 0, 1, 0, 0, 0, 0, 2, 2, 0, 2, 1, 0, 1
+    };
+    static const Uint8 rle8Pixels[] = {
+        0, 0, 1, 1,
+        1, 0, 1, 0,
+        1, 1, 1, 1
+    };
+    const Uint32 formats[] = { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB565 };
+    const char *sampleFilename = "testLoadBitmapWithFormat.bmp";
+    SDL_Surface *face, *loaded, *converted;
+    Uint8 indexed[sizeof(rle8)];
+    Uint32 pixel;
+    int i, ret;
+
+    /* Create sample surface */
+    face = SDLTest_ImageFace();
+    SDLTest_AssertCheck(face != NULL, "Verify face surface is not NULL");
+    if (face == NULL) return TEST_ABORTED;
+
+    /* Delete test file; ignore errors */
+    unlink(sampleFilename);
+
+    ret = SDL_SaveBMP(face, sampleFilename);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_SaveBMP, expected: 0, got: %i", ret);
+
+    /* Loading in a format matches loading and converting */
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        loaded = SDL_LoadBMPWithFormat(sampleFilename, formats[i]);
+        SDLTest_AssertPass("Call to SDL_LoadBMPWithFormat(%s)", SDL_GetPixelFormatName(formats[i]));
+        SDLTest_AssertCheck(loaded != NULL && loaded->format->format == formats[i], "Verify surface has the requested format");
+        converted = SDL_LoadBMP(sampleFilename);
+        SDLTest_AssertCheck(converted != NULL, "Verify result from SDL_LoadBMP is not NULL");
+        if (loaded != NULL && converted != NULL) {
+            SDL_Surface *reference = SDL_ConvertSurfaceFormat(converted, formats[i], 0);
+            ret = SDLTest_CompareSurfaces(loaded, reference, 0);
+            SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+            SDL_FreeSurface(reference);
+        }
+        SDL_FreeSurface(loaded);
+        SDL_FreeSurface(converted);
+    }
+
+    /* Delete test file; ignore errors */
+    unlink(sampleFilename);
+    SDL_FreeSurface(face);
+
+    /* RLE8 decodes into the file's format */
+    loaded = SDL_LoadBMP_RW(SDL_RWFromConstMem(rle8, sizeof(rle8)), 1);
+    SDLTest_AssertCheck(loaded != NULL && loaded->format->format == SDL_PIXELFORMAT_INDEX8, "Verify RLE8 bitmap loads as SDL_PIXELFORMAT_INDEX8");
+    if (loaded != NULL) {
+        ret = 0;
+        for (i = 0; i < SDL_arraysize(rle8Pixels); ++i) {
+            if (((Uint8 *) loaded->pixels)[(i / 4) * loaded->pitch + (i % 4)] != rle8Pixels[i]) {
+                ++ret;
+            }
+        }
+        SDLTest_AssertCheck(ret == 0, "Verify RLE8 pixels, expected: 0 differences, got: %i", ret);
+        SDL_FreeSurface(loaded);
+    }
+
+    /* ...and into a requested format */
+    loaded = SDL_LoadBMPWithFormat_RW(SDL_RWFromConstMem(rle8, sizeof(rle8)), 1, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(loaded != NULL, "Verify RLE8 bitmap loads as SDL_PIXELFORMAT_ARGB8888");
+    if (loaded != NULL) {
+        ret = 0;
+        for (i = 0; i < SDL_arraysize(rle8Pixels); ++i) {
+            pixel = *(Uint32 *) ((Uint8 *) loaded->pixels + (i / 4) * loaded->pitch + (i % 4) * 4);
+            if (pixel != (rle8Pixels[i] ? 0xFFFF0000 : 0xFF000000)) {
+                ++ret;
+            }
+        }
+        SDLTest_AssertCheck(ret == 0, "Verify RLE8 pixels, expected: 0 differences, got: %i", ret);
+        SDL_FreeSurface(loaded);
+    }
+
+    /* Indices past the colors in the file are black */
+    SDL_memcpy(indexed, rle8, sizeof(rle8));
+    indexed[63] = 5;
+    loaded = SDL_LoadBMPWithFormat_RW(SDL_RWFromConstMem(indexed, sizeof(indexed)), 1, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(loaded != NULL, "Verify RLE8 bitmap with indices past its colors loads");
+    if (loaded != NULL) {
+        pixel = *(Uint32 *) ((Uint8 *) loaded->pixels + 2 * loaded->pitch);
+        SDLTest_AssertCheck(pixel == 0xFF000000, "Verify pixel past the colors, expected: 0xff000000, got: 0x%.8x", pixel);
+        SDL_FreeSurface(loaded);
+    }
+
+    /* RLE data that stops early leaves the remaining pixels at index 0 */
+    loaded = SDL_LoadBMP_RW(SDL_RWFromConstMem(rle8, 62), 1);
+    SDLTest_AssertCheck(loaded != NULL && ((Uint8 *) loaded->pixels)[2 * loaded->pitch] == 0, "Verify RLE8 bitmap without pixel data loads");
+    SDL_FreeSurface(loaded);
+
+    return TEST_COMPLETED;
+}
+
 /* !
  *  Tests surface conversion.
  */
@@ -588,6 +697,1067 @@ surface_testBlitBlendLoop(void *arg) {
 
 }
 
+/**
+ * @brief Tests blitting one surface alternately into targets of different formats
+ */
+int
+surface_testBlitMultipleTargets(void *arg)
+{
+    SDL_Surface *face, *indexed, *targets[2], *references[2];
+    SDL_Color colors[2] = { { 0xFF, 0x00, 0x00, 0xFF }, { 0x00, 0x00, 0xFF, 0xFF } };
+    SDL_Color green = { 0x00, 0xFF, 0x00, 0xFF };
+    Uint32 formats[2] = { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565 };
+    Uint32 pixel;
+    int i, j, ret;
+
+    face = SDLTest_ImageFace();
+    SDLTest_AssertCheck(face != NULL, "Verify face surface is not NULL");
+    if (face == NULL) {
+        return TEST_ABORTED;
+    }
+    SDL_SetSurfaceBlendMode(face, SDL_BLENDMODE_NONE);
+
+    for (i = 0; i < 2; ++i) {
+        targets[i] = SDL_CreateRGBSurfaceWithFormat(0, face->w, face->h, 0, formats[i]);
+        SDLTest_AssertCheck(targets[i] != NULL, "Verify target surface %d is not NULL", i);
+        references[i] = SDL_ConvertSurfaceFormat(face, formats[i], 0);
+        SDLTest_AssertCheck(references[i] != NULL, "Verify reference surface %d is not NULL", i);
+        if (targets[i] == NULL || references[i] == NULL) {
+            return TEST_ABORTED;
+        }
+    }
+
+    /* Ping-pong between the targets, switching the blit mapping each time */
+    for (j = 0; j < 3; ++j) {
+        for (i = 0; i < 2; ++i) {
+            ret = SDL_BlitSurface(face, NULL, targets[i], NULL);
+            SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+        }
+    }
+    for (i = 0; i < 2; ++i) {
+        ret = SDLTest_CompareSurfaces(targets[i], references[i], 0);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+    }
+
+    /* Palette changes must still be picked up when going back to a target */
+    indexed = SDL_CreateRGBSurfaceWithFormat(0, 1, 1, 8, SDL_PIXELFORMAT_INDEX8);
+    SDLTest_AssertCheck(indexed != NULL, "Verify indexed surface is not NULL");
+    if (indexed == NULL) {
+        return TEST_ABORTED;
+    }
+    SDL_SetPaletteColors(indexed->format->palette, colors, 0, 2);
+    *(Uint8 *)indexed->pixels = 1;
+    for (j = 0; j < 3; ++j) {
+        for (i = 0; i < 2; ++i) {
+            SDL_BlitSurface(indexed, NULL, targets[i], NULL);
+        }
+        if (j == 1) {
+            SDL_SetPaletteColors(indexed->format->palette, &green, 1, 1);
+        }
+    }
+    pixel = *(Uint32 *)targets[0]->pixels;
+    SDLTest_AssertCheck(pixel == SDL_MapRGB(targets[0]->format, 0x00, 0xFF, 0x00), "Verify ARGB8888 target pixel, expected: 0x%.8x, got: 0x%.8x", SDL_MapRGB(targets[0]->format, 0x00, 0xFF, 0x00), pixel);
+    pixel = *(Uint16 *)targets[1]->pixels;
+    SDLTest_AssertCheck(pixel == SDL_MapRGB(targets[1]->format, 0x00, 0xFF, 0x00), "Verify RGB565 target pixel, expected: 0x%.4x, got: 0x%.4x", SDL_MapRGB(targets[1]->format, 0x00, 0xFF, 0x00), pixel);
+
+    /* Clean up. */
+    SDL_FreeSurface(indexed);
+    for (i = 0; i < 2; ++i) {
+        SDL_FreeSurface(targets[i]);
+        SDL_FreeSurface(references[i]);
+    }
+    SDL_FreeSurface(face);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests conversion between the 32 bit formats with 8 bit channels
+ */
+int
+surface_testConvert8888Formats(void *arg)
+{
+    const Uint32 formats[] = {
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGRA8888,
+        SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888,
+        SDL_PIXELFORMAT_RGBX8888, SDL_PIXELFORMAT_BGRX8888
+    };
+    Uint32 src[37], dst[37];
+    int i, j, x, ret, errors;
+
+    /* An odd width to cover the pixels left over by vector loops */
+    for (x = 0; x < SDL_arraysize(src); ++x) {
+        src[x] = SDLTest_RandomUint32();
+    }
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        for (j = 0; j < SDL_arraysize(formats); ++j) {
+            SDL_PixelFormat *src_fmt, *dst_fmt;
+
+            if (i == j) {
+                continue;
+            }
+            src_fmt = SDL_AllocFormat(formats[i]);
+            dst_fmt = SDL_AllocFormat(formats[j]);
+            ret = SDL_ConvertPixels(SDL_arraysize(src), 1, formats[i], src, sizeof(src),
+                                    formats[j], dst, sizeof(dst));
+            SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %i", ret);
+
+            errors = 0;
+            for (x = 0; x < SDL_arraysize(src); ++x) {
+                Uint8 r, g, b, a;
+                Uint32 expected;
+
+                SDL_GetRGBA(src[x], src_fmt, &r, &g, &b, &a);
+                expected = SDL_MapRGBA(dst_fmt, r, g, b, a);
+                if (!dst_fmt->Amask) {
+                    expected &= (dst_fmt->Rmask | dst_fmt->Gmask | dst_fmt->Bmask);
+                }
+                if (dst[x] != expected) {
+                    ++errors;
+                }
+            }
+            SDLTest_AssertCheck(errors == 0, "Validate %s -> %s conversion, expected: 0 errors, got: %i",
+                                SDL_GetPixelFormatName(formats[i]), SDL_GetPixelFormatName(formats[j]), errors);
+
+            SDL_FreeFormat(src_fmt);
+            SDL_FreeFormat(dst_fmt);
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests conversion of RGB pixels to the YUV formats
+ */
+int
+surface_testConvertPixelsYUV(void *arg)
+{
+    const Uint32 formats[] = {
+        SDL_PIXELFORMAT_IYUV, SDL_PIXELFORMAT_YV12, SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_NV21,
+        SDL_PIXELFORMAT_YUY2, SDL_PIXELFORMAT_UYVY, SDL_PIXELFORMAT_YVYU
+    };
+    /* R, G, B and the expected Y, U, V with full range BT.601 and video range BT.709 */
+    const Uint8 colors[][9] = {
+        { 255, 255, 255, 255, 128, 128, 235, 128, 128 },
+        { 0, 0, 0, 0, 128, 128, 16, 128, 128 },
+        { 255, 0, 0, 76, 85, 255, 63, 102, 240 },
+        { 0, 0, 255, 29, 255, 107, 32, 240, 118 },
+    };
+    /* Odd sizes to cover the partial chroma blocks and the vector loop tails */
+    const int w = 37, h = 5;
+    const int cw = (w + 1) / 2, ch = (h + 1) / 2;
+    Uint32 argb[37 * 5];
+    Uint16 rgb565[37 * 5];
+    Uint32 expanded[37 * 5];
+    Uint8 yuv[37 * 5 * 2 + 38 * 2];
+    Uint8 reference[37 * 5 * 2 + 38 * 2];
+    int i, j, k, x, y, ret, errors;
+
+    for (i = 0; i < SDL_arraysize(colors); ++i) {
+        const Uint8 *color = colors[i];
+
+        for (x = 0; x < w * h; ++x) {
+            argb[x] = 0xFF000000 | (color[0] << 16) | (color[1] << 8) | color[2];
+            rgb565[x] = ((color[0] >> 3) << 11) | ((color[1] >> 2) << 5) | (color[2] >> 3);
+        }
+
+        for (j = 0; j < SDL_arraysize(formats); ++j) {
+            const SDL_bool packed = (formats[j] == SDL_PIXELFORMAT_YUY2 ||
+                                     formats[j] == SDL_PIXELFORMAT_UYVY ||
+                                     formats[j] == SDL_PIXELFORMAT_YVYU);
+            const int pitch = packed ? w * 2 : w;
+
+            for (k = 0; k < 2; ++k) {
+                const SDL_YUV_CONVERSION_MODE mode = k ? SDL_YUV_CONVERSION_BT709 : SDL_YUV_CONVERSION_JPEG;
+                const Uint8 *expected = color + (k ? 6 : 3);
+                Uint8 *chroma = yuv + h * pitch;
+
+                SDL_SetYUVConversionMode(mode);
+                SDL_memset(yuv, 0xAA, sizeof(yuv));
+                ret = SDL_ConvertPixels(w, h, SDL_PIXELFORMAT_ARGB8888, argb, w * sizeof(Uint32),
+                                        formats[j], yuv, pitch);
+                SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %i", ret);
+
+                errors = 0;
+                for (y = 0; y < h; ++y) {
+                    for (x = 0; x < w; ++x) {
+                        const Uint8 *p = yuv + y * pitch;
+                        Uint8 Y, U, V;
+
+                        switch (formats[j]) {
+                        case SDL_PIXELFORMAT_YUY2:
+                            Y = p[x * 2];
+                            U = p[(x / 2) * 4 + 1];
+                            V = (x / 2) * 2 + 1 < w ? p[(x / 2) * 4 + 3] : expected[2];
+                            break;
+                        case SDL_PIXELFORMAT_UYVY:
+                            Y = p[x * 2 + 1];
+                            U = p[(x / 2) * 4];
+                            V = (x / 2) * 2 + 1 < w ? p[(x / 2) * 4 + 2] : expected[2];
+                            break;
+                        case SDL_PIXELFORMAT_YVYU:
+                            Y = p[x * 2];
+                            V = p[(x / 2) * 4 + 1];
+                            U = (x / 2) * 2 + 1 < w ? p[(x / 2) * 4 + 3] : expected[1];
+                            break;
+                        case SDL_PIXELFORMAT_IYUV:
+                            Y = p[x];
+                            U = chroma[(y / 2) * ((pitch + 1) / 2) + x / 2];
+                            V = chroma[(ch + y / 2) * ((pitch + 1) / 2) + x / 2];
+                            break;
+                        case SDL_PIXELFORMAT_YV12:
+                            Y = p[x];
+                            V = chroma[(y / 2) * ((pitch + 1) / 2) + x / 2];
+                            U = chroma[(ch + y / 2) * ((pitch + 1) / 2) + x / 2];
+                            break;
+                        default:
+                            Y = p[x];
+                            U = chroma[(y / 2) * cw * 2 + (x / 2) * 2 + (formats[j] == SDL_PIXELFORMAT_NV21)];
+                            V = chroma[(y / 2) * cw * 2 + (x / 2) * 2 + (formats[j] == SDL_PIXELFORMAT_NV12)];
+                            break;
+                        }
+                        if (Y != expected[0] || U != expected[1] || V != expected[2]) {
+                            ++errors;
+                        }
+                    }
+                }
+                SDLTest_AssertCheck(errors == 0, "Validate color %i to %s in mode %i, expected: 0 errors, got: %i",
+                                    i, SDL_GetPixelFormatName(formats[j]), mode, errors);
+
+                /* Other formats must match their ARGB8888 expansion exactly */
+                SDL_memset(reference, 0xAA, sizeof(reference));
+                ret = SDL_ConvertPixels(w, h, SDL_PIXELFORMAT_RGB565, rgb565, w * sizeof(Uint16),
+                                        SDL_PIXELFORMAT_ARGB8888, expanded, w * sizeof(Uint32));
+                SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %i", ret);
+                ret = SDL_ConvertPixels(w, h, SDL_PIXELFORMAT_ARGB8888, expanded, w * sizeof(Uint32),
+                                        formats[j], reference, pitch);
+                SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %i", ret);
+                SDL_memset(yuv, 0xAA, sizeof(yuv));
+                ret = SDL_ConvertPixels(w, h, SDL_PIXELFORMAT_RGB565, rgb565, w * sizeof(Uint16),
+                                        formats[j], yuv, pitch);
+                SDLTest_AssertCheck(ret == 0, "Verify result from SDL_ConvertPixels, expected: 0, got: %i", ret);
+                SDLTest_AssertCheck(SDL_memcmp(yuv, reference, sizeof(yuv)) == 0,
+                                    "Validate RGB565 color %i to %s in mode %i", i, SDL_GetPixelFormatName(formats[j]), mode);
+            }
+        }
+    }
+    SDL_SetYUVConversionMode(SDL_YUV_CONVERSION_JPEG);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests the filtering of scaled blits
+ */
+int
+surface_testBlitScaledFiltered(void *arg)
+{
+    const struct {
+        const char *quality;
+        int src_w, dst_w;
+        Uint8 src[4];
+        Uint8 expected[4];
+    } cases[] = {
+        { "nearest", 2, 4, { 0, 255 }, { 0, 0, 255, 255 } },
+        { "linear", 2, 4, { 0, 255 }, { 0, 64, 191, 255 } },
+        { "best", 2, 4, { 0, 255 }, { 0, 64, 191, 255 } },
+        { "best", 4, 2, { 0, 255, 255, 255 }, { 128, 255 } },
+    };
+    SDL_Surface *src, *dst;
+    SDL_Rect clip;
+    Uint32 *pixels;
+    char *original;
+    int i, x, ret;
+
+    /* Capture the current value, it is restored at the end */
+    original = (char *)SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
+    if (original) {
+        original = SDL_strdup(original);
+    }
+
+    for (i = 0; i < SDL_arraysize(cases); ++i) {
+        SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, cases[i].quality);
+
+        src = SDL_CreateRGBSurfaceWithFormat(0, cases[i].src_w, 1, 32, SDL_PIXELFORMAT_ARGB8888);
+        dst = SDL_CreateRGBSurfaceWithFormat(0, cases[i].dst_w, 1, 32, SDL_PIXELFORMAT_ARGB8888);
+        SDLTest_AssertCheck(src != NULL && dst != NULL, "Verify surfaces are not NULL");
+        if (src == NULL || dst == NULL) {
+            SDL_FreeSurface(src);
+            SDL_FreeSurface(dst);
+            continue;
+        }
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+        pixels = (Uint32 *) src->pixels;
+        for (x = 0; x < cases[i].src_w; ++x) {
+            pixels[x] = 0xFF000000 | (cases[i].src[x] * 0x010101);
+        }
+
+        ret = SDL_BlitScaled(src, NULL, dst, NULL);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitScaled, expected: 0, got: %i", ret);
+        pixels = (Uint32 *) dst->pixels;
+        for (x = 0; x < cases[i].dst_w; ++x) {
+            const Uint32 expected = 0xFF000000 | (cases[i].expected[x] * 0x010101);
+            SDLTest_AssertCheck(pixels[x] == expected, "Validate %s pixel %i, expected: 0x%.8x, got: 0x%.8x",
+                                cases[i].quality, x, expected, pixels[x]);
+        }
+
+        /* Clipping mustn't move the filtered samples */
+        if (SDL_strcmp(cases[i].quality, "nearest") != 0) {
+            SDL_FillRect(dst, NULL, 0x12345678);
+            clip.x = 1;
+            clip.y = 0;
+            clip.w = 1;
+            clip.h = 1;
+            SDL_SetClipRect(dst, &clip);
+            ret = SDL_BlitScaled(src, NULL, dst, NULL);
+            SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitScaled, expected: 0, got: %i", ret);
+            SDLTest_AssertCheck(pixels[0] == 0x12345678 && pixels[1] == (0xFF000000 | (cases[i].expected[1] * 0x010101)),
+                                "Validate clipped %s blit, got: 0x%.8x 0x%.8x", cases[i].quality, pixels[0], pixels[1]);
+        }
+
+        SDL_FreeSurface(src);
+        SDL_FreeSurface(dst);
+    }
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, original);
+    SDL_free(original);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests premultiplying alpha and blitting with premultiplied alpha
+ */
+int
+surface_testPremultipliedAlpha(void *arg)
+{
+    const Uint32 formats[] = {
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGRA8888,
+        SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB565
+    };
+    SDL_Surface *src, *dst, *convert;
+    SDL_PixelFormat *src_fmt;
+    SDL_BlendMode blendMode;
+    SDL_Rect rect;
+    Uint32 pixels[37], original[37], premultiplied[37];
+    int i, x, ret, errors;
+
+    /* An odd width to cover the pixels left over by vector loops */
+    for (x = 0; x < SDL_arraysize(pixels); ++x) {
+        pixels[x] = SDLTest_RandomUint32();
+    }
+    pixels[0] |= 0xFF000000;
+    pixels[1] &= 0x00FFFFFF;
+
+    /* Premultiply into each of the 8888 formats with alpha */
+    src_fmt = SDL_AllocFormat(SDL_PIXELFORMAT_ARGB8888);
+    for (i = 0; i < 4; ++i) {
+        SDL_PixelFormat *dst_fmt = SDL_AllocFormat(formats[i]);
+
+        ret = SDL_PremultiplyAlpha(SDL_arraysize(pixels), 1, SDL_PIXELFORMAT_ARGB8888, pixels, sizeof(pixels),
+                                   formats[i], premultiplied, sizeof(premultiplied));
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_PremultiplyAlpha, expected: 0, got: %i", ret);
+
+        errors = 0;
+        for (x = 0; x < SDL_arraysize(pixels); ++x) {
+            Uint8 r, g, b, a;
+
+            SDL_GetRGBA(pixels[x], src_fmt, &r, &g, &b, &a);
+            r = (Uint8) ((r * a + 127) / 255);
+            g = (Uint8) ((g * a + 127) / 255);
+            b = (Uint8) ((b * a + 127) / 255);
+            if (premultiplied[x] != SDL_MapRGBA(dst_fmt, r, g, b, a)) {
+                ++errors;
+            }
+        }
+        SDLTest_AssertCheck(errors == 0, "Validate premultiplied %s pixels, expected: 0 errors, got: %i",
+                            SDL_GetPixelFormatName(formats[i]), errors);
+        SDL_FreeFormat(dst_fmt);
+    }
+
+    ret = SDL_PremultiplyAlpha(1, 1, SDL_PIXELFORMAT_ARGB8888, pixels, sizeof(pixels),
+                               SDL_PIXELFORMAT_RGB888, premultiplied, sizeof(premultiplied));
+    SDLTest_AssertCheck(ret == -1, "Verify SDL_PremultiplyAlpha needs alpha in the destination, expected: -1, got: %i", ret);
+
+    /* Premultiply a surface in place */
+    src = SDL_CreateRGBSurfaceWithFormat(0, SDL_arraysize(pixels), 1, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(src != NULL, "Verify source surface is not NULL");
+    if (src == NULL) {
+        SDL_FreeFormat(src_fmt);
+        return TEST_ABORTED;
+    }
+    SDL_memcpy(src->pixels, pixels, sizeof(pixels));
+    SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+    ret = SDL_PremultiplySurfaceAlpha(src);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_PremultiplySurfaceAlpha, expected: 0, got: %i", ret);
+    ret = SDL_PremultiplySurfaceAlpha(src);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_PremultiplySurfaceAlpha again, expected: 0, got: %i", ret);
+    SDLTest_AssertCheck((src->flags & SDL_PREMULTIPLIED) != 0, "Verify the surface is flagged as premultiplied");
+    SDL_GetSurfaceBlendMode(src, &blendMode);
+    SDLTest_AssertCheck(blendMode == SDL_BLENDMODE_BLEND_PREMULTIPLIED, "Verify the blend mode is premultiplied, got: %i", blendMode);
+    SDL_PremultiplyAlpha(SDL_arraysize(pixels), 1, SDL_PIXELFORMAT_ARGB8888, pixels, sizeof(pixels),
+                         SDL_PIXELFORMAT_ARGB8888, premultiplied, sizeof(premultiplied));
+    ret = SDL_memcmp(src->pixels, premultiplied, sizeof(premultiplied));
+    SDLTest_AssertCheck(ret == 0, "Validate the surface was premultiplied once, expected: 0, got: %i", ret);
+
+    /* Conversion keeps the premultiplied alpha */
+    convert = SDL_ConvertSurfaceFormat(src, SDL_PIXELFORMAT_ABGR8888, 0);
+    SDLTest_AssertCheck(convert != NULL, "Verify converted surface is not NULL");
+    if (convert) {
+        SDLTest_AssertCheck((convert->flags & SDL_PREMULTIPLIED) != 0, "Verify the converted surface is flagged as premultiplied");
+        SDL_GetSurfaceBlendMode(convert, &blendMode);
+        SDLTest_AssertCheck(blendMode == SDL_BLENDMODE_BLEND_PREMULTIPLIED, "Verify the converted blend mode is premultiplied, got: %i", blendMode);
+        SDL_FreeSurface(convert);
+    }
+
+    /* Blend onto each destination format */
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        const int tolerance = SDL_BITSPERPIXEL(formats[i]) < 24 ? 8 : 1;
+
+        dst = SDL_CreateRGBSurfaceWithFormat(0, SDL_arraysize(pixels), 1, 32, formats[i]);
+        SDLTest_AssertCheck(dst != NULL, "Verify destination surface is not NULL");
+        if (dst == NULL) {
+            continue;
+        }
+        rect.x = 0;
+        rect.y = 0;
+        rect.w = 1;
+        rect.h = 1;
+        for (x = 0; x < SDL_arraysize(pixels); ++x) {
+            original[x] = SDL_MapRGBA(dst->format, SDLTest_RandomUint8(), SDLTest_RandomUint8(),
+                                      SDLTest_RandomUint8(), SDLTest_RandomUint8());
+            SDL_FillRect(dst, &rect, original[x]);
+            ++rect.x;
+        }
+
+        ret = SDL_BlitSurface(src, NULL, dst, NULL);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+
+        errors = 0;
+        for (x = 0; x < SDL_arraysize(pixels); ++x) {
+            Uint8 sr, sg, sb, sa, dr, dg, db, da, r, g, b, a;
+            Uint32 pixel = 0;
+
+            SDL_GetRGBA(premultiplied[x], src_fmt, &sr, &sg, &sb, &sa);
+            SDL_GetRGBA(original[x], dst->format, &dr, &dg, &db, &da);
+            SDL_memcpy(&pixel, (Uint8 *) dst->pixels + x * dst->format->BytesPerPixel, dst->format->BytesPerPixel);
+            SDL_GetRGBA(pixel, dst->format, &r, &g, &b, &a);
+            if (SDL_abs(r - (sr + dr * (255 - sa) / 255)) > tolerance ||
+                SDL_abs(g - (sg + dg * (255 - sa) / 255)) > tolerance ||
+                SDL_abs(b - (sb + db * (255 - sa) / 255)) > tolerance ||
+                (dst->format->Amask && SDL_abs(a - (sa + da * (255 - sa) / 255)) > tolerance)) {
+                ++errors;
+            }
+        }
+        SDLTest_AssertCheck(errors == 0, "Validate premultiplied blending onto %s, expected: 0 errors, got: %i",
+                            SDL_GetPixelFormatName(formats[i]), errors);
+        SDL_FreeSurface(dst);
+    }
+
+    SDL_FreeSurface(src);
+    SDL_FreeFormat(src_fmt);
+
+    return TEST_COMPLETED;
+}
+
+/* Fills rect of a surface cleared to 0x5A bytes, and returns the number of rows that differ from a pixel by pixel fill */
+static int
+_fillLargeSurface(SDL_Surface *surface, const SDL_Rect *rect, Uint32 color)
+{
+    const int bpp = surface->format->BytesPerPixel;
+    Uint8 *row = (Uint8 *) SDL_malloc(surface->w * bpp);
+    Uint8 *pixel;
+    int x, y, errors = 0;
+
+    if (row == NULL) {
+        return -1;
+    }
+    SDL_memset(surface->pixels, 0x5A, surface->h * surface->pitch);
+    if (SDL_FillRect(surface, rect, color) < 0) {
+        SDL_free(row);
+        return -1;
+    }
+
+    SDL_memset(row, 0x5A, surface->w * bpp);
+    for (x = rect->x; x < rect->x + rect->w; ++x) {
+        pixel = row + x * bpp;
+        switch (bpp) {
+        case 2:
+            *(Uint16 *) pixel = (Uint16) color;
+            break;
+        case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            pixel[0] = (Uint8) color;
+            pixel[1] = (Uint8) (color >> 8);
+            pixel[2] = (Uint8) (color >> 16);
+#else
+            pixel[0] = (Uint8) (color >> 16);
+            pixel[1] = (Uint8) (color >> 8);
+            pixel[2] = (Uint8) color;
+#endif
+            break;
+        case 4:
+            *(Uint32 *) pixel = color;
+            break;
+        }
+    }
+    for (y = 0; y < surface->h; ++y) {
+        const Uint8 *actual = (const Uint8 *) surface->pixels + y * surface->pitch;
+        if (y < rect->y || y >= rect->y + rect->h) {
+            for (x = 0; x < surface->w * bpp; ++x) {
+                if (actual[x] != 0x5A) {
+                    ++errors;
+                    break;
+                }
+            }
+        } else if (SDL_memcmp(actual, row, surface->w * bpp) != 0) {
+            ++errors;
+        }
+    }
+    SDL_free(row);
+    return errors;
+}
+
+/**
+ * @brief Tests that filling several rectangles at once matches filling them one by one
+ */
+int
+surface_testFillRects(void *arg)
+{
+    const Uint32 formats[] = {
+        SDL_PIXELFORMAT_INDEX8, SDL_PIXELFORMAT_RGB565,
+        SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ARGB8888
+    };
+    /* Over 4 MB of pixels even at 2 bytes per pixel, so the fills are
+       streamed past the cache, and split into bands with several threads */
+    const SDL_Rect large = { 5, 3, 1589, 1393 };
+    const char *threads[] = { "1", "4" };
+    char *hint;
+    SDL_Rect rects[24];
+    SDL_Rect clip;
+    int i, j, ret;
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        SDL_Surface *merged = SDL_CreateRGBSurfaceWithFormat(0, 333, 101, 0, formats[i]);
+        SDL_Surface *single = SDL_CreateRGBSurfaceWithFormat(0, 333, 101, 0, formats[i]);
+        const Uint32 color = SDLTest_RandomUint32() & (Uint32) ((((Uint64) 1) << (SDL_BYTESPERPIXEL(formats[i]) * 8)) - 1);
+
+        SDLTest_AssertCheck(merged != NULL && single != NULL, "Verify surfaces are not NULL");
+        if (merged == NULL || single == NULL) {
+            SDL_FreeSurface(merged);
+            SDL_FreeSurface(single);
+            return TEST_ABORTED;
+        }
+
+        /* A grid of touching tiles, partially outside the clip rect, plus overlapping rects */
+        for (j = 0; j < 16; ++j) {
+            rects[j].x = (j % 4) * 90 - 5;
+            rects[j].y = (j / 4) * 27;
+            rects[j].w = 90;
+            rects[j].h = 27;
+        }
+        for (; j < SDL_arraysize(rects); ++j) {
+            rects[j].x = SDLTest_RandomIntegerInRange(-20, 332);
+            rects[j].y = SDLTest_RandomIntegerInRange(-20, 100);
+            rects[j].w = SDLTest_RandomIntegerInRange(0, 200);
+            rects[j].h = SDLTest_RandomIntegerInRange(0, 50);
+        }
+        clip.x = 3;
+        clip.y = 1;
+        clip.w = 320;
+        clip.h = 99;
+
+        SDL_FillRect(merged, NULL, 0);
+        SDL_FillRect(single, NULL, 0);
+        SDL_SetClipRect(merged, &clip);
+        SDL_SetClipRect(single, &clip);
+
+        /* The tiles alone, then everything */
+        ret = SDL_FillRects(merged, rects, 16, color);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_FillRects, expected: 0, got: %i", ret);
+        ret = SDL_FillRects(merged, rects, SDL_arraysize(rects), color ^ 0x5A5A5A5A);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_FillRects, expected: 0, got: %i", ret);
+        for (j = 0; j < 16; ++j) {
+            SDL_FillRect(single, &rects[j], color);
+        }
+        for (j = 0; j < SDL_arraysize(rects); ++j) {
+            SDL_FillRect(single, &rects[j], color ^ 0x5A5A5A5A);
+        }
+
+        /* Compare the raw pixels, as the palette of the indexed surfaces is all white */
+        ret = 0;
+        for (j = 0; j < merged->h; ++j) {
+            if (SDL_memcmp((Uint8 *) merged->pixels + j * merged->pitch,
+                           (Uint8 *) single->pixels + j * single->pitch,
+                           merged->w * merged->format->BytesPerPixel) != 0) {
+                ++ret;
+            }
+        }
+        SDLTest_AssertCheck(ret == 0, "Validate %s fill, expected: 0 differing rows, got: %i", SDL_GetPixelFormatName(formats[i]), ret);
+
+        SDL_FreeSurface(merged);
+        SDL_FreeSurface(single);
+    }
+
+    /* Large fills, on the calling thread and on the blit threads */
+    hint = SDL_GetHint(SDL_HINT_BLIT_THREADS) ? SDL_strdup(SDL_GetHint(SDL_HINT_BLIT_THREADS)) : NULL;
+    for (i = 1; i < SDL_arraysize(formats); ++i) {
+        SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, 1600, 1400, 0, formats[i]);
+        const Uint32 color = 0x89ABCDEF & (Uint32) ((((Uint64) 1) << (SDL_BYTESPERPIXEL(formats[i]) * 8)) - 1);
+
+        SDLTest_AssertCheck(surface != NULL, "Verify large surface is not NULL");
+        if (surface == NULL) {
+            break;
+        }
+        for (j = 0; j < SDL_arraysize(threads); ++j) {
+            SDL_SetHint(SDL_HINT_BLIT_THREADS, threads[j]);
+            ret = _fillLargeSurface(surface, &large, color);
+            SDLTest_AssertCheck(ret == 0, "Validate large %s fill with %s thread(s), expected: 0 differing rows, got: %i",
+                                SDL_GetPixelFormatName(formats[i]), threads[j], ret);
+        }
+        SDL_FreeSurface(surface);
+    }
+    SDL_SetHint(SDL_HINT_BLIT_THREADS, hint);
+    SDL_free(hint);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests creating SIMD aligned surfaces
+ */
+int
+surface_testSIMDAlignedSurface(void *arg)
+{
+    /* The large surface is 4 MB, enough to be mapped as huge pages */
+    const int sizes[][2] = { { 1, 1 }, { 33, 7 }, { 1024, 1024 } };
+    SDL_Surface *surface, *copy, *from;
+    SDL_Rect rect;
+    Uint32 pixel;
+    char *original;
+    int i, y;
+
+    for (i = 0; i < SDL_arraysize(sizes); ++i) {
+        surface = SDL_CreateRGBSurfaceWithFormat(SDL_SIMD_ALIGNED, sizes[i][0], sizes[i][1], 0, SDL_PIXELFORMAT_ARGB8888);
+        SDLTest_AssertCheck(surface != NULL, "Verify %ix%i surface is not NULL", sizes[i][0], sizes[i][1]);
+        if (surface == NULL) {
+            return TEST_ABORTED;
+        }
+        SDLTest_AssertCheck(surface->flags == SDL_SIMD_ALIGNED, "Verify surface flags, expected: 0x%.8x, got: 0x%.8x", SDL_SIMD_ALIGNED, surface->flags);
+        SDLTest_AssertCheck(((uintptr_t) surface->pixels & 63) == 0, "Verify pixels are 64-byte aligned");
+        SDLTest_AssertCheck((surface->pitch & 63) == 0 && surface->pitch >= surface->w * 4, "Verify pitch is 64-byte aligned, got: %i", surface->pitch);
+
+        /* The pixels start out cleared, and the padding is usable */
+        pixel = 0;
+        for (y = 0; y < surface->h; ++y) {
+            const Uint8 *row = (const Uint8 *) surface->pixels + y * surface->pitch;
+            int x;
+            for (x = 0; x < surface->pitch; ++x) {
+                pixel |= row[x];
+            }
+        }
+        SDLTest_AssertCheck(pixel == 0, "Verify pixels are cleared");
+        SDL_memset(surface->pixels, 0x80, surface->h * surface->pitch);
+
+        rect.x = surface->w / 2;
+        rect.y = surface->h / 2;
+        rect.w = 1;
+        rect.h = 1;
+        SDL_FillRect(surface, &rect, 0x12345678);
+
+        /* Duplicates and conversions stay aligned */
+        copy = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ABGR8888, 0);
+        SDLTest_AssertCheck(copy != NULL, "Verify converted surface is not NULL");
+        if (copy != NULL) {
+            SDLTest_AssertCheck((copy->flags & SDL_SIMD_ALIGNED) != 0 && ((uintptr_t) copy->pixels & 63) == 0, "Verify converted surface is aligned");
+            pixel = *(Uint32 *) ((Uint8 *) copy->pixels + rect.y * copy->pitch + rect.x * 4);
+            SDLTest_AssertCheck(pixel == 0x12785634, "Verify converted pixel, expected: 0x12785634, got: 0x%.8x", pixel);
+            SDL_FreeSurface(copy);
+        }
+
+        /* RLE encoding releases and reallocates the pixels */
+        SDL_SetColorKey(surface, SDL_TRUE | SDL_RLEACCEL, 0x80808080);
+        copy = SDL_CreateRGBSurfaceWithFormat(0, surface->w, surface->h, 0, SDL_PIXELFORMAT_ARGB8888);
+        SDLTest_AssertCheck(copy != NULL, "Verify blit target is not NULL");
+        if (copy != NULL) {
+            SDL_BlitSurface(surface, NULL, copy, NULL);
+            SDL_FreeSurface(copy);
+        }
+        SDL_LockSurface(surface);
+        SDLTest_AssertCheck(((uintptr_t) surface->pixels & 63) == 0, "Verify decoded pixels are aligned");
+        pixel = *(Uint32 *) ((Uint8 *) surface->pixels + rect.y * surface->pitch + rect.x * 4);
+        SDLTest_AssertCheck(pixel == 0x12345678, "Verify decoded pixel, expected: 0x12345678, got: 0x%.8x", pixel);
+        SDL_UnlockSurface(surface);
+
+        SDL_FreeSurface(surface);
+    }
+
+    /* The hint aligns surfaces created without the flag, but not preallocated ones */
+    original = (char *)SDL_GetHint(SDL_HINT_SURFACE_SIMD_ALIGNED);
+    if (original) {
+        original = SDL_strdup(original);
+    }
+    SDL_SetHint(SDL_HINT_SURFACE_SIMD_ALIGNED, "1");
+    surface = SDL_CreateRGBSurfaceWithFormat(0, 5, 5, 0, SDL_PIXELFORMAT_RGB24);
+    SDLTest_AssertCheck(surface != NULL && (surface->flags & SDL_SIMD_ALIGNED) != 0 && surface->pitch == 64, "Verify hint aligns new surfaces");
+    if (surface != NULL) {
+        from = SDL_CreateRGBSurfaceWithFormatFrom(surface->pixels, 5, 5, 0, 16, SDL_PIXELFORMAT_RGB24);
+        SDLTest_AssertCheck(from != NULL && (from->flags & SDL_SIMD_ALIGNED) == 0 && from->pitch == 16, "Verify preallocated surface is not aligned");
+        SDL_FreeSurface(from);
+        SDL_FreeSurface(surface);
+    }
+    SDL_SetHint(SDL_HINT_SURFACE_SIMD_ALIGNED, original);
+    SDL_free(original);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests sharing surface pixels through a file descriptor
+ */
+int
+surface_testSharedSurface(void *arg)
+{
+    SDL_Surface *shared, *imported;
+    SDL_Rect rect;
+    Uint32 pixel;
+    int fd, pitch;
+
+    shared = SDL_CreateRGBSurfaceWithFormatShared(0, 100, 30, 0, SDL_PIXELFORMAT_ARGB8888);
+    if (shared == NULL) {
+        SDLTest_Log("Shared surfaces are not supported: %s", SDL_GetError());
+        return TEST_SKIPPED;
+    }
+    SDLTest_AssertPass("Call to SDL_CreateRGBSurfaceWithFormatShared()");
+    /* SDL_HINT_SURFACE_SIMD_ALIGNED can make the pitch larger */
+    pitch = shared->pitch;
+    SDLTest_AssertCheck(pitch >= 400, "Verify pitch, expected: at least 400, got: %i", pitch);
+
+    fd = SDL_GetSurfaceSharedFD(shared);
+    SDLTest_AssertCheck(fd >= 0, "Verify shared surface has a file descriptor, got: %i", fd);
+    SDLTest_AssertCheck((shared->flags & ~(SDL_PREALLOC | SDL_SIMD_ALIGNED)) == 0, "Verify surface flags, got: 0x%.8x", shared->flags);
+
+    /* Invalid imports */
+    imported = SDL_CreateRGBSurfaceWithFormatFromFD(fd, 100, 31, 0, pitch, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(imported == NULL, "Verify import larger than the shared memory fails");
+    imported = SDL_CreateRGBSurfaceWithFormatFromFD(fd, 100, 30, 0, 396, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(imported == NULL, "Verify import with a short pitch fails");
+    imported = SDL_CreateRGBSurfaceWithFormatFromFD(-1, 100, 30, 0, pitch, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(imported == NULL, "Verify import of an invalid file descriptor fails");
+#ifdef __LINUX__
+    {
+        /* A plain file can be truncated under the mapping */
+        FILE *file = tmpfile();
+        if (file != NULL) {
+            fseek(file, 30 * pitch - 1, SEEK_SET);
+            fputc(0, file);
+            fflush(file);
+            imported = SDL_CreateRGBSurfaceWithFormatFromFD(fileno(file), 100, 30, 0, pitch, SDL_PIXELFORMAT_ARGB8888);
+            SDLTest_AssertCheck(imported == NULL, "Verify import of unsealed memory fails");
+            SDL_FreeSurface(imported);
+            fclose(file);
+        }
+    }
+#endif
+
+    /* Both surfaces see each other's writes */
+    imported = SDL_CreateRGBSurfaceWithFormatFromFD(fd, 100, 30, 0, pitch, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(imported != NULL, "Verify imported surface is not NULL");
+    if (imported == NULL) {
+        SDL_FreeSurface(shared);
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(SDL_GetSurfaceSharedFD(imported) >= 0 && SDL_GetSurfaceSharedFD(imported) != fd, "Verify imported surface has its own file descriptor");
+
+    rect.x = 10;
+    rect.y = 20;
+    rect.w = 1;
+    rect.h = 1;
+    SDL_FillRect(shared, &rect, 0x11223344);
+    pixel = *(Uint32 *) ((Uint8 *) imported->pixels + 20 * imported->pitch + 10 * 4);
+    SDLTest_AssertCheck(pixel == 0x11223344, "Verify imported pixel, expected: 0x11223344, got: 0x%.8x", pixel);
+    SDL_FillRect(imported, &rect, 0x55667788);
+    pixel = *(Uint32 *) ((Uint8 *) shared->pixels + 20 * shared->pitch + 10 * 4);
+    SDLTest_AssertCheck(pixel == 0x55667788, "Verify shared pixel, expected: 0x55667788, got: 0x%.8x", pixel);
+
+    /* The imported surface outlives the exporting one */
+    SDL_FreeSurface(shared);
+    pixel = *(Uint32 *) ((Uint8 *) imported->pixels + 20 * imported->pitch + 10 * 4);
+    SDLTest_AssertCheck(pixel == 0x55667788, "Verify pixel after freeing the shared surface, got: 0x%.8x", pixel);
+    SDL_FreeSurface(imported);
+
+    SDLTest_AssertCheck(SDL_GetSurfaceSharedFD(NULL) == -1, "Verify SDL_GetSurfaceSharedFD(NULL) fails");
+
+    return TEST_COMPLETED;
+}
+
+/* Nearest palette entry, the way SDL_FindColor() scans the palette */
+static Uint8
+_nearestPaletteColor(const SDL_Palette *palette, Uint8 r, Uint8 g, Uint8 b)
+{
+    unsigned int smallest = ~0;
+    Uint8 pixel = 0;
+    int i;
+
+    for (i = 0; i < palette->ncolors; ++i) {
+        const int rd = palette->colors[i].r - r;
+        const int gd = palette->colors[i].g - g;
+        const int bd = palette->colors[i].b - b;
+        const unsigned int distance = rd * rd + gd * gd + bd * bd;
+        if (distance < smallest) {
+            smallest = distance;
+            pixel = (Uint8) i;
+        }
+    }
+    return pixel;
+}
+
+/**
+ * @brief Tests mapping colors to palettes, with and without dithering
+ */
+int
+surface_testPaletteLookup(void *arg)
+{
+    const char *modes[] = { "none", "nearest", "ordered", "diffusion" };
+    SDL_Surface *indexed, *source, *converted;
+    SDL_PixelFormat *format;
+    SDL_Palette *palette;
+    SDL_Color colors[200];
+    Uint32 pixel;
+    int mismatches;
+    int i, x, y, r, g, b;
+
+    indexed = SDL_CreateRGBSurfaceWithFormat(0, 1, 1, 8, SDL_PIXELFORMAT_INDEX8);
+    SDLTest_AssertCheck(indexed != NULL, "Verify indexed surface is not NULL");
+    if (indexed == NULL) return TEST_ABORTED;
+    palette = indexed->format->palette;
+
+    /* Random colors, with a few duplicates so the first entry has to win */
+    for (i = 0; i < SDL_arraysize(colors); ++i) {
+        colors[i].r = (Uint8) SDLTest_RandomIntegerInRange(0, 255);
+        colors[i].g = (Uint8) SDLTest_RandomIntegerInRange(0, 255);
+        colors[i].b = (Uint8) SDLTest_RandomIntegerInRange(0, 255);
+        colors[i].a = SDL_ALPHA_OPAQUE;
+    }
+    colors[150] = colors[10];
+    colors[199] = colors[42];
+    SDL_SetPaletteColors(palette, colors, 0, SDL_arraysize(colors));
+
+    mismatches = 0;
+    for (r = 0; r < 256; r += 5) {
+        for (g = 0; g < 256; g += 3) {
+            for (b = 0; b < 256; b += 7) {
+                if (SDL_MapRGB(indexed->format, r, g, b) != _nearestPaletteColor(palette, r, g, b)) {
+                    ++mismatches;
+                }
+            }
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Verify SDL_MapRGB() finds the nearest palette entry, %d mismatches", mismatches);
+
+    /* Changed colors are picked up */
+    colors[0].r = 1;
+    colors[0].g = 2;
+    colors[0].b = 3;
+    SDL_SetPaletteColors(palette, colors, 0, 1);
+    pixel = SDL_MapRGB(indexed->format, 1, 2, 3);
+    SDLTest_AssertCheck(pixel == 0, "Verify SDL_MapRGB() after SDL_SetPaletteColors(), expected: 0, got: %d", (int) pixel);
+    palette->colors[1].r = 4;
+    palette->colors[1].g = 5;
+    palette->colors[1].b = 6;
+    pixel = SDL_MapRGB(indexed->format, 4, 5, 6);
+    SDLTest_AssertCheck(pixel == 1, "Verify SDL_MapRGB() after changing the colors directly, expected: 1, got: %d", (int) pixel);
+
+    /* A palette the application built itself works too */
+    format = SDL_AllocFormat(SDL_PIXELFORMAT_INDEX8);
+    SDLTest_AssertCheck(format != NULL, "Verify indexed format is not NULL");
+    if (format != NULL) {
+        SDL_Palette *allocated = format->palette;
+        SDL_Palette own;
+
+        SDL_zero(own);
+        own.ncolors = 4;
+        own.colors = colors + 40;
+        own.version = 1;
+        own.refcount = 1;
+        format->palette = &own;
+        pixel = SDL_MapRGB(format, colors[42].r, colors[42].g, colors[42].b);
+        SDLTest_AssertCheck(pixel == 2, "Verify SDL_MapRGB() with an application palette, expected: 2, got: %d", (int) pixel);
+        format->palette = allocated;
+        SDL_FreeFormat(format);
+    }
+
+    /* Convert a gradient with each conversion */
+    source = SDL_CreateRGBSurfaceWithFormat(0, 96, 64, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(source != NULL, "Verify source surface is not NULL");
+    if (source == NULL) {
+        SDL_FreeSurface(indexed);
+        return TEST_ABORTED;
+    }
+    for (y = 0; y < source->h; ++y) {
+        Uint32 *row = (Uint32 *) ((Uint8 *) source->pixels + y * source->pitch);
+        for (x = 0; x < source->w; ++x) {
+            row[x] = 0xFF000000 | ((x * 255 / 95) << 16) | ((y * 255 / 63) << 8) | ((x * y) & 0xFF);
+        }
+    }
+
+    for (i = 0; i < SDL_arraysize(modes); ++i) {
+        SDL_SetHint(SDL_HINT_SURFACE_PALETTE_DITHER, modes[i]);
+        converted = SDL_ConvertSurface(source, indexed->format, 0);
+        SDLTest_AssertPass("Call to SDL_ConvertSurface() with %s dithering", modes[i]);
+        SDLTest_AssertCheck(converted != NULL, "Verify converted surface is not NULL");
+        if (converted == NULL) {
+            continue;
+        }
+
+        mismatches = 0;
+        for (y = 0; y < converted->h; ++y) {
+            const Uint32 *src = (const Uint32 *) ((Uint8 *) source->pixels + y * source->pitch);
+            const Uint8 *dst = (const Uint8 *) converted->pixels + y * converted->pitch;
+            for (x = 0; x < converted->w; ++x) {
+                if (dst[x] >= palette->ncolors) {
+                    ++mismatches;
+                } else if (SDL_strcmp(modes[i], "nearest") == 0) {
+                    /* Colors are looked up with 5 bits per channel */
+                    r = ((src[x] >> 19) & 0x1F) * 255 / 31;
+                    g = ((src[x] >> 11) & 0x1F) * 255 / 31;
+                    b = ((src[x] >> 3) & 0x1F) * 255 / 31;
+                    if (dst[x] != _nearestPaletteColor(palette, r, g, b)) {
+                        ++mismatches;
+                    }
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify converted pixels with %s dithering, %d mismatches", modes[i], mismatches);
+        SDL_FreeSurface(converted);
+    }
+    SDL_SetHint(SDL_HINT_SURFACE_PALETTE_DITHER, "0");
+
+    SDL_FreeSurface(source);
+    SDL_FreeSurface(indexed);
+
+    return TEST_COMPLETED;
+}
+
+/* Blits src over a copy of dst in result, using the blitters chosen for the given CPU features */
+static int
+_blitWithFeatures(Uint32 features, Uint32 src_format, Uint32 dst_format,
+                  Uint32 *src, const Uint32 *dst, Uint32 *result, int w, int h,
+                  SDL_BlendMode mode, const Uint8 mod[4], SDL_bool scaled)
+{
+    SDL_Surface *src_surface, *dst_surface;
+    SDL_Rect srcrect;
+    char value[16];
+    int ret;
+
+    SDL_snprintf(value, sizeof(value), "%u", (unsigned int) features);
+    SDL_setenv("SDL_BLIT_CPU_FEATURES", value, 1);
+
+    SDL_memcpy(result, dst, w * h * sizeof(Uint32));
+    src_surface = SDL_CreateRGBSurfaceWithFormatFrom(src, w, h, 32, w * sizeof(Uint32), src_format);
+    dst_surface = SDL_CreateRGBSurfaceWithFormatFrom(result, w, h, 32, w * sizeof(Uint32), dst_format);
+    if (src_surface == NULL || dst_surface == NULL) {
+        SDL_FreeSurface(src_surface);
+        SDL_FreeSurface(dst_surface);
+        return -1;
+    }
+    SDL_SetSurfaceBlendMode(src_surface, mode);
+    SDL_SetSurfaceColorMod(src_surface, mod[0], mod[1], mod[2]);
+    SDL_SetSurfaceAlphaMod(src_surface, mod[3]);
+    if (scaled) {
+        srcrect.x = 1;
+        srcrect.y = 1;
+        srcrect.w = w / 2;
+        srcrect.h = h - 2;
+        ret = SDL_BlitScaled(src_surface, &srcrect, dst_surface, NULL);
+    } else {
+        ret = SDL_BlitSurface(src_surface, NULL, dst_surface, NULL);
+    }
+    SDL_FreeSurface(src_surface);
+    SDL_FreeSurface(dst_surface);
+    return ret;
+}
+
+/**
+ * @brief Tests that the SIMD blitters for the 8888 formats match the scalar ones
+ */
+int
+surface_testBlitSIMD(void *arg)
+{
+    const Uint32 formats[] = {
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGRA8888,
+        SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888
+    };
+    const SDL_BlendMode modes[] = {
+        SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_BLEND_PREMULTIPLIED,
+        SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD
+    };
+    const Uint8 mods[][4] = {
+        { 255, 255, 255, 255 }, { 200, 100, 50, 255 }, { 255, 255, 255, 128 }, { 200, 100, 50, 128 }
+    };
+    /* SSE2, SSE2 and AVX2, and everything, each compared to the scalar blitters */
+    const Uint32 features[] = { 0x08, 0x48, 0xc8 };
+    const int w = 37, h = 5;   /* an odd width covers the pixels left over by vector loops */
+    Uint32 src[37 * 5], dst[37 * 5], expected[37 * 5], result[37 * 5];
+    Uint32 available = 0;
+    char *original;
+    int f, i, j, m, k, scaled, ret, errors;
+
+    /* Never pick blitters for instructions this CPU doesn't have */
+    if (SDL_HasSSE2()) {
+        available |= 0x08;
+    }
+    if (SDL_HasAVX2()) {
+        available |= 0x40;
+    }
+    if (SDL_HasNEON()) {
+        available |= 0x80;
+    }
+
+    original = SDL_getenv("SDL_BLIT_CPU_FEATURES");
+    if (original) {
+        original = SDL_strdup(original);
+    }
+
+    for (k = 0; k < SDL_arraysize(src); ++k) {
+        src[k] = SDLTest_RandomUint32();
+        dst[k] = SDLTest_RandomUint32();
+    }
+
+    for (f = 0; f < SDL_arraysize(features); ++f) {
+        for (i = 0; i < SDL_arraysize(formats); ++i) {
+            for (j = 0; j < SDL_arraysize(formats); ++j) {
+                errors = 0;
+                for (m = 0; m < SDL_arraysize(modes); ++m) {
+                    for (k = 0; k < SDL_arraysize(mods); ++k) {
+                        for (scaled = 0; scaled <= 1; ++scaled) {
+                            ret = _blitWithFeatures(0, formats[i], formats[j], src, dst, expected, w, h,
+                                                    modes[m], mods[k], (SDL_bool) scaled);
+                            ret |= _blitWithFeatures(features[f] & available, formats[i], formats[j], src, dst, result, w, h,
+                                                     modes[m], mods[k], (SDL_bool) scaled);
+                            if (ret < 0 || SDL_memcmp(expected, result, sizeof(result)) != 0) {
+                                ++errors;
+                            }
+                        }
+                    }
+                }
+                SDLTest_AssertCheck(errors == 0, "Validate %s -> %s blits with features 0x%x, expected: 0 errors, got: %i",
+                                    SDL_GetPixelFormatName(formats[i]), SDL_GetPixelFormatName(formats[j]),
+                                    (unsigned int) (features[f] & available), errors);
+            }
+        }
+    }
+
+    SDL_setenv("SDL_BLIT_CPU_FEATURES", original ? original : "", 1);
+    SDL_free(original);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Surface test cases */
@@ -630,11 +1800,47 @@ static const SDLTest_TestCaseReference surfaceTest11 =
 static const SDLTest_TestCaseReference surfaceTest12 =
         { (SDLTest_TestCaseFp)surface_testBlitBlendMod, "surface_testBlitBlendMod", "Tests blitting routines with mod blending mode.", TEST_ENABLED};
 
+static const SDLTest_TestCaseReference surfaceTest13 =
+        { (SDLTest_TestCaseFp)surface_testBlitMultipleTargets, "surface_testBlitMultipleTargets", "Tests blitting one surface into several targets.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest14 =
+        { (SDLTest_TestCaseFp)surface_testConvert8888Formats, "surface_testConvert8888Formats", "Tests conversion between the 8888 formats.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest15 =
+        { (SDLTest_TestCaseFp)surface_testConvertPixelsYUV, "surface_testConvertPixelsYUV", "Tests conversion of RGB pixels to the YUV formats.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest16 =
+        { (SDLTest_TestCaseFp)surface_testBlitScaledFiltered, "surface_testBlitScaledFiltered", "Tests the filtering of scaled blits.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest17 =
+        { (SDLTest_TestCaseFp)surface_testPremultipliedAlpha, "surface_testPremultipliedAlpha", "Tests premultiplying alpha and premultiplied blending.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest18 =
+        { (SDLTest_TestCaseFp)surface_testFillRects, "surface_testFillRects", "Tests filling several rectangles at once.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest19 =
+        { (SDLTest_TestCaseFp)surface_testSIMDAlignedSurface, "surface_testSIMDAlignedSurface", "Tests creating SIMD aligned surfaces.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest20 =
+        { (SDLTest_TestCaseFp)surface_testSharedSurface, "surface_testSharedSurface", "Tests sharing surface pixels through a file descriptor.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest21 =
+        { (SDLTest_TestCaseFp)surface_testLoadBitmapWithFormat, "surface_testLoadBitmapWithFormat", "Tests loading bitmaps straight into a pixel format.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest22 =
+        { (SDLTest_TestCaseFp)surface_testPaletteLookup, "surface_testPaletteLookup", "Tests mapping colors to palettes, with and without dithering.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest23 =
+        { (SDLTest_TestCaseFp)surface_testBlitSIMD, "surface_testBlitSIMD", "Tests that the SIMD blitters match the scalar ones.", TEST_ENABLED};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] =  {
     &surfaceTest1, &surfaceTest2, &surfaceTest3, &surfaceTest4, &surfaceTest5,
     &surfaceTest6, &surfaceTest7, &surfaceTest8, &surfaceTest9, &surfaceTest10,
-    &surfaceTest11, &surfaceTest12, NULL
+    &surfaceTest11, &surfaceTest12, &surfaceTest13,
+    &surfaceTest14, &surfaceTest15, &surfaceTest16, &surfaceTest17,
+    &surfaceTest18, &surfaceTest19, &surfaceTest20, &surfaceTest21,
+    &surfaceTest22, &surfaceTest23, NULL
 };
 
 /* Surface test suite (global) */
@@ -0,0 +1,197 @@
+/*
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+/* Benchmark:  Convert and blit large frames between pixel formats, once for
+   every number of blit threads */
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "SDL_test.h"
+
+#define NUM_ITERATIONS  20
+
+typedef struct
+{
+    const char *name;
+    Uint32 src_format;
+    Uint32 dst_format;
+    SDL_BlendMode blendMode;
+    SDL_bool convert;
+} BlitCase;
+
+static const BlitCase cases[] = {
+    { "convert ARGB8888 -> ABGR8888", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_BLENDMODE_NONE, SDL_TRUE },
+    { "convert RGB565 -> ARGB8888", SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_NONE, SDL_TRUE },
+    { "convert ARGB8888 -> RGB24", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB24, SDL_BLENDMODE_NONE, SDL_TRUE },
+    { "blit ARGB8888 -> RGB888", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, SDL_BLENDMODE_NONE, SDL_FALSE },
+    { "blend ABGR8888 -> ARGB8888", SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_BLEND, SDL_FALSE },
+    { "premultiplied blend ABGR8888 -> ARGB8888", SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_BLEND_PREMULTIPLIED, SDL_FALSE },
+};
+
+static int num_iterations = NUM_ITERATIONS;
+static int frame_w = 3840;
+static int frame_h = 2160;
+
+static SDL_Surface *
+CreateFrame(Uint32 format)
+{
+    SDL_Surface *surface;
+    int x, y;
+
+    surface = SDL_CreateRGBSurfaceWithFormat(0, frame_w, frame_h, 0, format);
+    if (!surface) {
+        return NULL;
+    }
+
+    /* Fill in a deterministic pattern with varying alpha */
+    SDLTest_FuzzerInit(format);
+    for (y = 0; y < surface->h; ++y) {
+        Uint8 *row = (Uint8 *) surface->pixels + y * surface->pitch;
+        for (x = 0; x < surface->pitch; ++x) {
+            row[x] = (Uint8) SDLTest_RandomUint8();
+        }
+    }
+    return surface;
+}
+
+static int
+RunBenchmark(const BlitCase * blit, int num_threads, double *ms_per_frame, CrcUint32 *crc)
+{
+    char value[16];
+    SDL_Surface *src, *dst;
+    SDLTest_Crc32Context context;
+    Uint64 start, end;
+    int i, result = 0;
+
+    SDL_snprintf(value, sizeof(value), "%d", num_threads);
+    SDL_SetHint(SDL_HINT_BLIT_THREADS, value);
+
+    src = CreateFrame(blit->src_format);
+    dst = CreateFrame(blit->dst_format);
+    if (!src || !dst) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create frames: %s\n", SDL_GetError());
+        SDL_FreeSurface(src);
+        SDL_FreeSurface(dst);
+        return (-1);
+    }
+    SDL_SetSurfaceBlendMode(src, blit->blendMode);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_iterations && result == 0; ++i) {
+        if (blit->convert) {
+            result = SDL_ConvertPixels(frame_w, frame_h, blit->src_format, src->pixels, src->pitch,
+                                       blit->dst_format, dst->pixels, dst->pitch);
+        } else {
+            result = SDL_BlitSurface(src, NULL, dst, NULL);
+        }
+    }
+    end = SDL_GetPerformanceCounter();
+    if (result < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't blit: %s\n", SDL_GetError());
+        SDL_FreeSurface(src);
+        SDL_FreeSurface(dst);
+        return (-1);
+    }
+
+    *ms_per_frame = (double) (end - start) * 1000.0 / SDL_GetPerformanceFrequency() / num_iterations;
+
+    SDLTest_Crc32Init(&context);
+    SDLTest_Crc32CalcStart(&context, crc);
+    SDLTest_Crc32CalcBuffer(&context, (CrcUint8 *) dst->pixels, dst->pitch * dst->h, crc);
+    SDLTest_Crc32CalcEnd(&context, crc);
+    SDLTest_Crc32Done(&context);
+
+    SDL_FreeSurface(src);
+    SDL_FreeSurface(dst);
+    return (0);
+}
+
+int
+main(int argc, char *argv[])
+{
+    int i, c;
+    int max_threads;
+    int num_threads;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    max_threads = SDL_GetCPUCount();
+
+    for (i = 1; i < argc;) {
+        int consumed = -1;
+
+        if (SDL_strcasecmp(argv[i], "--size") == 0) {
+            if (argv[i + 1] && SDL_sscanf(argv[i + 1], "%dx%d", &frame_w, &frame_h) == 2) {
+                consumed = 2;
+            }
+        } else if (SDL_strcasecmp(argv[i], "--iterations") == 0) {
+            if (argv[i + 1]) {
+                num_iterations = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            }
+        } else if (SDL_strcasecmp(argv[i], "--threads") == 0) {
+            if (argv[i + 1]) {
+                max_threads = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed < 0 || num_iterations <= 0 || max_threads <= 0 || frame_w <= 0 || frame_h <= 0) {
+            SDL_Log("Usage: %s [--size WxH] [--iterations N] [--threads N]\n", argv[0]);
+            return (1);
+        }
+        i += consumed;
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return (1);
+    }
+
+    SDL_Log("%dx%d frames, %d iterations\n", frame_w, frame_h, num_iterations);
+
+    for (c = 0; c < SDL_arraysize(cases); ++c) {
+        double ms_single = 0.0;
+        CrcUint32 crc_single = 0;
+
+        SDL_Log("%s\n", cases[c].name);
+
+        /* Double the number of threads until the maximum is reached */
+        for (num_threads = 1; ; num_threads = SDL_min(num_threads * 2, max_threads)) {
+            double ms_per_frame;
+            double mpixels;
+            CrcUint32 crc;
+
+            if (RunBenchmark(&cases[c], num_threads, &ms_per_frame, &crc) < 0) {
+                SDL_Quit();
+                return (2);
+            }
+            if (num_threads == 1) {
+                ms_single = ms_per_frame;
+                crc_single = crc;
+            }
+            mpixels = (double) frame_w * frame_h / 1000.0 / ms_per_frame;
+            SDL_Log("%2d threads: %8.3f ms per frame, %8.1f Mpixels per second, %5.2fx%s\n",
+                    num_threads, ms_per_frame, mpixels, ms_single / ms_per_frame,
+                    (crc == crc_single) ? "" : " (output differs from 1 thread)");
+
+            if (num_threads >= max_threads) {
+                break;
+            }
+        }
+    }
+
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
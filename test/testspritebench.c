@@ -0,0 +1,355 @@
+/*
+  Copyright (C) 1997-2017 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+/* Benchmark:  Move N sprites around an offscreen surface with the software
+   renderer, once for every number of drawing threads */
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "SDL_test.h"
+
+#define NUM_SPRITES    1000
+#define NUM_FRAMES     200
+#define MAX_SPEED      1
+
+static int num_sprites = NUM_SPRITES;
+static int num_frames = NUM_FRAMES;
+static int target_w = 1920;
+static int target_h = 1080;
+static SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+static SDL_bool rotate = SDL_FALSE;
+static SDL_Surface *sprite_image;
+static SDL_Rect *positions;
+static SDL_Rect *velocities;
+static int sprite_w, sprite_h;
+
+/* Call this instead of exit(), so we can clean up SDL: atexit() is evil. */
+static void
+quit(int rc)
+{
+    SDL_FreeSurface(sprite_image);
+    SDL_free(positions);
+    SDL_free(velocities);
+    SDL_Quit();
+    exit(rc);
+}
+
+static int
+LoadSprite(const char *file)
+{
+    /* Load the sprite image */
+    sprite_image = SDL_LoadBMP(file);
+    if (sprite_image == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load %s: %s", file, SDL_GetError());
+        return (-1);
+    }
+    sprite_w = sprite_image->w;
+    sprite_h = sprite_image->h;
+
+    /* Set transparent pixel as the pixel at (0,0) */
+    if (sprite_image->format->palette) {
+        SDL_SetColorKey(sprite_image, 1, *(Uint8 *) sprite_image->pixels);
+    } else {
+        switch (sprite_image->format->BitsPerPixel) {
+        case 15:
+            SDL_SetColorKey(sprite_image, 1, (*(Uint16 *) sprite_image->pixels) & 0x00007FFF);
+            break;
+        case 16:
+            SDL_SetColorKey(sprite_image, 1, *(Uint16 *) sprite_image->pixels);
+            break;
+        case 24:
+            SDL_SetColorKey(sprite_image, 1, (*(Uint32 *) sprite_image->pixels) & 0x00FFFFFF);
+            break;
+        case 32:
+            SDL_SetColorKey(sprite_image, 1, *(Uint32 *) sprite_image->pixels);
+            break;
+        }
+    }
+    return (0);
+}
+
+static void
+PositionSprites(void)
+{
+    int i;
+
+    /* Use the same deterministic moves for every run, so the output can be compared */
+    SDLTest_FuzzerInit(num_sprites);
+    for (i = 0; i < num_sprites; ++i) {
+        positions[i].x = SDLTest_RandomIntegerInRange(0, target_w - sprite_w);
+        positions[i].y = SDLTest_RandomIntegerInRange(0, target_h - sprite_h);
+        positions[i].w = sprite_w;
+        positions[i].h = sprite_h;
+        velocities[i].x = 0;
+        velocities[i].y = 0;
+        while (!velocities[i].x && !velocities[i].y) {
+            velocities[i].x = SDLTest_RandomIntegerInRange(-MAX_SPEED, MAX_SPEED);
+            velocities[i].y = SDLTest_RandomIntegerInRange(-MAX_SPEED, MAX_SPEED);
+        }
+    }
+}
+
+static void
+MoveSprites(SDL_Renderer * renderer, SDL_Texture * sprite, int frame)
+{
+    int i;
+    SDL_Rect viewport, temp;
+    SDL_Rect *position, *velocity;
+
+    /* Query the sizes */
+    SDL_RenderGetViewport(renderer, &viewport);
+
+    /* Draw a gray background */
+    SDL_SetRenderDrawColor(renderer, 0xA0, 0xA0, 0xA0, 0xFF);
+    SDL_RenderClear(renderer);
+
+    /* Test points */
+    SDL_SetRenderDrawColor(renderer, 0xFF, 0x00, 0x00, 0xFF);
+    SDL_RenderDrawPoint(renderer, 0, 0);
+    SDL_RenderDrawPoint(renderer, viewport.w-1, 0);
+    SDL_RenderDrawPoint(renderer, 0, viewport.h-1);
+    SDL_RenderDrawPoint(renderer, viewport.w-1, viewport.h-1);
+
+    /* Test horizontal and vertical lines */
+    SDL_SetRenderDrawColor(renderer, 0x00, 0xFF, 0x00, 0xFF);
+    SDL_RenderDrawLine(renderer, 1, 0, viewport.w-2, 0);
+    SDL_RenderDrawLine(renderer, 1, viewport.h-1, viewport.w-2, viewport.h-1);
+    SDL_RenderDrawLine(renderer, 0, 1, 0, viewport.h-2);
+    SDL_RenderDrawLine(renderer, viewport.w-1, 1, viewport.w-1, viewport.h-2);
+
+    /* Test fill and copy */
+    SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+    temp.x = 1;
+    temp.y = 1;
+    temp.w = sprite_w;
+    temp.h = sprite_h;
+    SDL_RenderFillRect(renderer, &temp);
+    SDL_RenderCopy(renderer, sprite, NULL, &temp);
+    temp.x = viewport.w-sprite_w-1;
+    temp.y = 1;
+    temp.w = sprite_w;
+    temp.h = sprite_h;
+    SDL_RenderFillRect(renderer, &temp);
+    SDL_RenderCopy(renderer, sprite, NULL, &temp);
+    temp.x = 1;
+    temp.y = viewport.h-sprite_h-1;
+    temp.w = sprite_w;
+    temp.h = sprite_h;
+    SDL_RenderFillRect(renderer, &temp);
+    SDL_RenderCopy(renderer, sprite, NULL, &temp);
+    temp.x = viewport.w-sprite_w-1;
+    temp.y = viewport.h-sprite_h-1;
+    temp.w = sprite_w;
+    temp.h = sprite_h;
+    SDL_RenderFillRect(renderer, &temp);
+    SDL_RenderCopy(renderer, sprite, NULL, &temp);
+
+    /* Move the sprites, bounce at the wall */
+    for (i = 0; i < num_sprites; ++i) {
+        position = &positions[i];
+        velocity = &velocities[i];
+        position->x += velocity->x;
+        if ((position->x < 0) || (position->x >= (viewport.w - sprite_w))) {
+            velocity->x = -velocity->x;
+            position->x += velocity->x;
+        }
+        position->y += velocity->y;
+        if ((position->y < 0) || (position->y >= (viewport.h - sprite_h))) {
+            velocity->y = -velocity->y;
+            position->y += velocity->y;
+        }
+    }
+
+    /* Draw sprites */
+    for (i = 0; i < num_sprites; ++i) {
+        position = &positions[i];
+
+        /* Blit the sprite onto the screen */
+        if (rotate) {
+            SDL_RenderCopyEx(renderer, sprite, NULL, position,
+                             (double) ((frame * 3 + i) % 360), NULL, SDL_FLIP_NONE);
+        } else {
+            SDL_RenderCopy(renderer, sprite, NULL, position);
+        }
+    }
+
+    /* Flush the frame, there is no window to update */
+    SDL_RenderPresent(renderer);
+}
+
+static int
+RunBenchmark(int num_threads, double *ms_per_frame, CrcUint32 *crc)
+{
+    char value[16];
+    SDL_Surface *target;
+    SDL_Renderer *renderer;
+    SDL_Texture *sprite;
+    SDLTest_Crc32Context context;
+    Uint64 start, end;
+    int frame;
+
+    SDL_snprintf(value, sizeof(value), "%d", num_threads);
+    SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, value);
+
+    target = SDL_CreateRGBSurfaceWithFormat(0, target_w, target_h, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!target) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create target surface: %s\n", SDL_GetError());
+        return (-1);
+    }
+    renderer = SDL_CreateSoftwareRenderer(target);
+    if (!renderer) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create renderer: %s\n", SDL_GetError());
+        SDL_FreeSurface(target);
+        return (-1);
+    }
+    sprite = SDL_CreateTextureFromSurface(renderer, sprite_image);
+    if (!sprite || SDL_SetTextureBlendMode(sprite, blendMode) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create texture: %s\n", SDL_GetError());
+        SDL_DestroyRenderer(renderer);
+        SDL_FreeSurface(target);
+        return (-1);
+    }
+
+    PositionSprites();
+
+    start = SDL_GetPerformanceCounter();
+    for (frame = 0; frame < num_frames; ++frame) {
+        MoveSprites(renderer, sprite, frame);
+    }
+    end = SDL_GetPerformanceCounter();
+
+    *ms_per_frame = (double) (end - start) * 1000.0 / SDL_GetPerformanceFrequency() / num_frames;
+
+    SDLTest_Crc32Init(&context);
+    SDLTest_Crc32CalcStart(&context, crc);
+    SDLTest_Crc32CalcBuffer(&context, (CrcUint8 *) target->pixels, target->pitch * target->h, crc);
+    SDLTest_Crc32CalcEnd(&context, crc);
+    SDLTest_Crc32Done(&context);
+
+    SDL_DestroyTexture(sprite);
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(target);
+    return (0);
+}
+
+int
+main(int argc, char *argv[])
+{
+    int i;
+    int max_threads;
+    int num_threads;
+    double ms_single = 0.0;
+    CrcUint32 crc_single = 0;
+    const char *icon = "icon.bmp";
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    max_threads = SDL_GetCPUCount();
+
+    for (i = 1; i < argc;) {
+        int consumed = -1;
+
+        if (SDL_strcasecmp(argv[i], "--blend") == 0) {
+            if (argv[i + 1]) {
+                if (SDL_strcasecmp(argv[i + 1], "none") == 0) {
+                    blendMode = SDL_BLENDMODE_NONE;
+                    consumed = 2;
+                } else if (SDL_strcasecmp(argv[i + 1], "blend") == 0) {
+                    blendMode = SDL_BLENDMODE_BLEND;
+                    consumed = 2;
+                } else if (SDL_strcasecmp(argv[i + 1], "add") == 0) {
+                    blendMode = SDL_BLENDMODE_ADD;
+                    consumed = 2;
+                } else if (SDL_strcasecmp(argv[i + 1], "mod") == 0) {
+                    blendMode = SDL_BLENDMODE_MOD;
+                    consumed = 2;
+                }
+            }
+        } else if (SDL_strcasecmp(argv[i], "--size") == 0) {
+            if (argv[i + 1] && SDL_sscanf(argv[i + 1], "%dx%d", &target_w, &target_h) == 2) {
+                consumed = 2;
+            }
+        } else if (SDL_strcasecmp(argv[i], "--frames") == 0) {
+            if (argv[i + 1]) {
+                num_frames = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            }
+        } else if (SDL_strcasecmp(argv[i], "--threads") == 0) {
+            if (argv[i + 1]) {
+                max_threads = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            }
+        } else if (SDL_strcasecmp(argv[i], "--rotate") == 0) {
+            rotate = SDL_TRUE;
+            consumed = 1;
+        } else if (SDL_isdigit(*argv[i])) {
+            num_sprites = SDL_atoi(argv[i]);
+            consumed = 1;
+        } else if (argv[i][0] != '-') {
+            icon = argv[i];
+            consumed = 1;
+        }
+        if (consumed < 0 || num_frames <= 0 || max_threads <= 0 || target_w <= 0 || target_h <= 0) {
+            SDL_Log("Usage: %s [--blend none|blend|add|mod] [--size WxH] [--frames N] [--threads N] [--rotate] [num_sprites] [icon.bmp]\n",
+                    argv[0]);
+            quit(1);
+        }
+        i += consumed;
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return (1);
+    }
+
+    if (LoadSprite(icon) < 0) {
+        quit(2);
+    }
+
+    /* Allocate memory for the sprite info */
+    positions = (SDL_Rect *) SDL_malloc(num_sprites * sizeof(SDL_Rect));
+    velocities = (SDL_Rect *) SDL_malloc(num_sprites * sizeof(SDL_Rect));
+    if (!positions || !velocities) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory!\n");
+        quit(2);
+    }
+
+    SDL_Log("%d sprites, %dx%d target, %d frames%s\n", num_sprites, target_w, target_h,
+            num_frames, rotate ? ", rotated" : "");
+
+    /* Double the number of threads until the maximum is reached */
+    for (num_threads = 1; ; num_threads = SDL_min(num_threads * 2, max_threads)) {
+        double ms_per_frame;
+        CrcUint32 crc;
+
+        if (RunBenchmark(num_threads, &ms_per_frame, &crc) < 0) {
+            quit(2);
+        }
+        if (num_threads == 1) {
+            ms_single = ms_per_frame;
+            crc_single = crc;
+        }
+        SDL_Log("%2d threads: %8.3f ms per frame, %8.2f frames per second, %5.2fx%s\n",
+                num_threads, ms_per_frame, 1000.0 / ms_per_frame, ms_single / ms_per_frame,
+                (crc == crc_single) ? "" : " (output differs from 1 thread)");
+
+        if (num_threads >= max_threads) {
+            break;
+        }
+    }
+
+    quit(0);
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */